@@ -67,6 +67,12 @@ qt_feature("linguist" PRIVATE
     LABEL "Qt Linguist"
     PURPOSE "Qt Linguist can be used by translator to translate text in Qt applications."
 )
+qt_feature("linguist_inprocess_projects" PRIVATE
+    LABEL "In-process qmake project evaluation"
+    PURPOSE "Lets lupdate and lrelease evaluate .pro files themselves instead of running lprodump."
+    AUTODETECT OFF
+    CONDITION QT_FEATURE_linguist
+)
 qt_feature("pixeltool" PRIVATE
     LABEL "pixeltool"
     PURPOSE "The Qt Pixel Zooming Tool is a graphical application that magnifies the screen around the mouse pointer so you can look more closely at individual pixels."
@@ -104,6 +110,7 @@ qt_configure_add_summary_entry(ARGS "designer")
 qt_configure_add_summary_entry(ARGS "distancefieldgenerator")
 #qt_configure_add_summary_entry(ARGS "kmap2qmap")
 qt_configure_add_summary_entry(ARGS "linguist")
+qt_configure_add_summary_entry(ARGS "linguist_inprocess_projects")
 qt_configure_add_summary_entry(ARGS "pixeltool")
 qt_configure_add_summary_entry(ARGS "qdbus")
 #qt_configure_add_summary_entry(ARGS "qev")
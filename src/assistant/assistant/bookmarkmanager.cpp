@@ -131,7 +131,10 @@ void BookmarkManager::setBookmarksMenu(QMenu* menu)
 {
     TRACE_OBJ
     bookmarkMenu = menu;
-    refreshBookmarkMenu();
+    connect(bookmarkMenu, &QMenu::aboutToShow,
+            this, &BookmarkManager::updateBookmarkMenu);
+    bookmarkMenuOutdated = true;
+    updateBookmarkMenu();
 }
 
 void BookmarkManager::setBookmarksToolbar(QToolBar *toolBar)
@@ -295,10 +298,8 @@ void BookmarkManager::buildBookmarksMenu(const QModelIndex &index, QMenu* menu)
     const QString &text = index.data().toString();
     const QIcon &icon = qvariant_cast<QIcon>(index.data(Qt::DecorationRole));
     if (index.data(UserRoleFolder).toBool()) {
-        if (QMenu* subMenu = menu->addMenu(icon, text)) {
-            for (int i = 0; i < bookmarkModel->rowCount(index); ++i)
-                buildBookmarksMenu(bookmarkModel->index(i, 0, index), subMenu);
-        }
+        if (QMenu* subMenu = menu->addMenu(icon, text))
+            buildBookmarksMenuOnShow(index, subMenu);
     } else {
         QAction *action = menu->addAction(icon, text);
         action->setData(index.data(UserRoleUrl).toString());
@@ -307,6 +308,19 @@ void BookmarkManager::buildBookmarksMenu(const QModelIndex &index, QMenu* menu)
     }
 }
 
+void BookmarkManager::buildBookmarksMenuOnShow(const QModelIndex &index, QMenu *menu)
+{
+    TRACE_OBJ
+    // the entries of a folder are only created once its menu is opened
+    const QPersistentModelIndex folder(index);
+    connect(menu, &QMenu::aboutToShow, this, [this, folder, menu]() {
+        if (!menu->isEmpty() || !folder.isValid())
+            return;
+        for (int i = 0; i < bookmarkModel->rowCount(folder); ++i)
+            buildBookmarksMenu(bookmarkModel->index(i, 0, folder), menu);
+    });
+}
+
 void BookmarkManager::showBookmarkDialog(const QString &name, const QString &url)
 {
     TRACE_OBJ
@@ -377,10 +391,19 @@ void BookmarkManager::manageBookmarks()
 void BookmarkManager::refreshBookmarkMenu()
 {
     TRACE_OBJ
-    if (!bookmarkMenu)
+    // rebuilt when the menu is shown next
+    bookmarkMenuOutdated = true;
+}
+
+void BookmarkManager::updateBookmarkMenu()
+{
+    TRACE_OBJ
+    if (!bookmarkMenu || !bookmarkMenuOutdated)
         return;
+    bookmarkMenuOutdated = false;
 
     bookmarkMenu->clear();
+    qDeleteAll(bookmarkMenu->findChildren<QMenu *>(QString(), Qt::FindDirectChildrenOnly));
 
     bookmarkMenu->addAction(tr("Manage Bookmarks..."), this,
                             &BookmarkManager::manageBookmarks);
@@ -417,8 +440,7 @@ void BookmarkManager::refreshBookmarkToolBar()
             button->setPopupMode(QToolButton::InstantPopup);
             button->setText(index.data().toString());
             QMenu *menu = new QMenu(button);
-            for (int j = 0; j < bookmarkModel->rowCount(index); ++j)
-                buildBookmarksMenu(bookmarkModel->index(j, 0, index), menu);
+            buildBookmarksMenuOnShow(index, menu);
             button->setMenu(menu);
             button->setToolButtonStyle(Qt::ToolButtonTextBesideIcon);
             button->setIcon(qvariant_cast<QIcon>(index.data(Qt::DecorationRole)));
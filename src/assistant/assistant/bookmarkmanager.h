@@ -73,6 +73,7 @@ private:
     void removeItem(const QModelIndex &index);
     bool eventFilter(QObject *object, QEvent *event) override;
     void buildBookmarksMenu(const QModelIndex &index, QMenu *menu);
+    void buildBookmarksMenuOnShow(const QModelIndex &index, QMenu *menu);
     void showBookmarkDialog(const QString &name, const QString &url);
 
 private slots:
@@ -83,6 +84,7 @@ private slots:
     void removeBookmarkActivated();
     void manageBookmarks();
     void refreshBookmarkMenu();
+    void updateBookmarkMenu();
     void refreshBookmarkToolBar();
     void renameBookmark(const QModelIndex &index);
 
@@ -101,6 +103,7 @@ private:
     static BookmarkManager *bookmarkManager;
 
     QMenu *bookmarkMenu = nullptr;
+    bool bookmarkMenuOutdated = false;
     QToolBar *m_toolBar = nullptr;
 
     BookmarkModel *bookmarkModel;
@@ -128,8 +128,11 @@ BookmarkModel::setItemsEditable(bool editable)
 void
 BookmarkModel::expandFoldersIfNeeeded(QTreeView *treeView)
 {
-    for (QModelIndex index : qAsConst(cache))
-        treeView->setExpanded(index, index.data(UserRoleExpanded).toBool());
+    // called right after a reset, when all folders are collapsed
+    for (QModelIndex index : qAsConst(cache)) {
+        if (index.data(UserRoleExpanded).toBool())
+            treeView->setExpanded(index, true);
+    }
 }
 
 QModelIndex
@@ -144,6 +147,28 @@ BookmarkModel::addItem(const QModelIndex &parent, bool isFolder)
     return next;
 }
 
+// Takes ownership of item and inserts it with all its children as one row.
+QModelIndex
+BookmarkModel::appendItem(BookmarkItem *item, const QModelIndex &parent)
+{
+    if (parent.isValid() && !parent.data(UserRoleFolder).toBool())
+        return QModelIndex();
+
+    BookmarkItem *parentItem = itemFromIndex(parent);
+    if (!parentItem)
+        return QModelIndex();
+
+    const int row = parentItem->childCount();
+    beginInsertRows(parent, row, row);
+    parentItem->addChild(item);
+    endInsertRows();
+
+    const QModelIndex &current = index(row, 0, parent);
+    cache.insert(item, current);
+    setupCache(current);
+    return current;
+}
+
 bool
 BookmarkModel::removeItem(const QModelIndex &index)
 {
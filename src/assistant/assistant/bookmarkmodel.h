@@ -54,6 +54,7 @@ public:
     void expandFoldersIfNeeeded(QTreeView *treeView);
 
     QModelIndex addItem(const QModelIndex &parent, bool isFolder = false);
+    QModelIndex appendItem(BookmarkItem *item, const QModelIndex &parent = QModelIndex());
     bool removeItem(const QModelIndex &index);
 
     int rowCount(const QModelIndex &index = QModelIndex()) const override;
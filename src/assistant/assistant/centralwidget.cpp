@@ -213,17 +213,20 @@ CentralWidget::~CentralWidget()
     TRACE_OBJ
     QStringList zoomFactors;
     QStringList currentPages;
+    QStringList titles;
     for (int i = 0; i < m_stackedWidget->count(); ++i) {
         const HelpViewer * const viewer = viewerAt(i);
         const QUrl &source = viewer->source();
         if (source.isValid()) {
             currentPages << source.toString();
             zoomFactors << QString::number(viewer->scale());
+            titles << viewer->title();
         }
     }
 
     HelpEngineWrapper &helpEngine = HelpEngineWrapper::instance();
     helpEngine.setLastShownPages(currentPages);
+    helpEngine.setLastShownPageTitles(titles);
     helpEngine.setLastZoomFactors(zoomFactors);
     helpEngine.setLastTabPage(m_stackedWidget->currentIndex());
 
@@ -43,6 +43,10 @@ static const char helpMessage[] = QT_TRANSLATE_NOOP("CmdLineParser",
         "                           url.\n"
         "-enableRemoteControl       Enables Assistant to be\n"
         "                           remotely controlled.\n"
+        "-remoteControlSocket name  Also accepts remote control\n"
+        "                           commands on the local socket\n"
+        "                           with the given name. Implies\n"
+        "                           -enableRemoteControl.\n"
         "-show widget               Shows the specified dockwidget\n"
         "                           which can be \"contents\", \"index\",\n"
         "                           \"bookmarks\" or \"search\".\n"
@@ -103,6 +107,8 @@ CmdLineParser::Result CmdLineParser::parse()
             handleShowUrlOption();
         else if (arg == QLatin1String("-enableremotecontrol"))
             m_enableRemoteControl = true;
+        else if (arg == QLatin1String("-remotecontrolsocket"))
+            handleRemoteControlSocketOption();
         else if (arg == QLatin1String("-show"))
             handleShowOption();
         else if (arg == QLatin1String("-hide"))
@@ -251,6 +257,17 @@ void CmdLineParser::handleSetCurrentFilterOption()
         m_error = tr("Missing filter argument.");
 }
 
+void CmdLineParser::handleRemoteControlSocketOption()
+{
+    TRACE_OBJ
+    if (hasMoreArgs()) {
+        m_remoteControlSocket = nextArg();
+        m_enableRemoteControl = true;
+    } else {
+        m_error = tr("Missing socket name argument.");
+    }
+}
+
 QString CmdLineParser::getFileName(const QString &fileName)
 {
     TRACE_OBJ
@@ -307,6 +324,12 @@ bool CmdLineParser::enableRemoteControl() const
     return m_enableRemoteControl;
 }
 
+QString CmdLineParser::remoteControlSocket() const
+{
+    TRACE_OBJ
+    return m_remoteControlSocket;
+}
+
 CmdLineParser::ShowState CmdLineParser::contents() const
 {
     TRACE_OBJ
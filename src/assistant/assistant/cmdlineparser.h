@@ -52,6 +52,7 @@ public:
     QString cloneFile() const;
     QUrl url() const;
     bool enableRemoteControl() const;
+    QString remoteControlSocket() const;
     ShowState contents() const;
     ShowState index() const;
     ShowState bookmarks() const;
@@ -78,6 +79,7 @@ private:
     void handleUnregisterOption();
     void handleRegisterOrUnregisterOption(RegisterState state);
     void handleSetCurrentFilterOption();
+    void handleRemoteControlSocketOption();
 
     QStringList m_arguments;
     int m_pos;
@@ -86,6 +88,7 @@ private:
     QString m_helpFile;
     QUrl m_url;
     bool m_enableRemoteControl;
+    QString m_remoteControlSocket;
 
     ShowState m_contents;
     ShowState m_index;
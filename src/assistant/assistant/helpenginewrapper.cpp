@@ -232,6 +232,20 @@ bool HelpEngineWrapper::registerDocumentation(const QString &docFile)
     return true;
 }
 
+bool HelpEngineWrapper::registerDocumentations(const QStringList &docFiles)
+{
+    TRACE_OBJ
+    d->checkDocFilesWatched();
+    const bool success = d->m_helpEngine->registerDocumentations(docFiles);
+    for (const QString &ns : d->m_helpEngine->registeredDocumentations()) {
+        const QString &file = d->m_helpEngine->documentationFileName(ns);
+        if (docFiles.contains(file))
+            d->m_qchWatcher->addPath(file);
+    }
+    d->checkDocFilesWatched();
+    return success;
+}
+
 bool HelpEngineWrapper::unregisterDocumentation(const QString &namespaceName)
 {
     TRACE_OBJ
@@ -306,6 +320,18 @@ void HelpEngineWrapper::setLastShownPages(const QStringList &lastShownPages)
     CollectionConfiguration::setLastShownPages(*d->m_helpEngine, lastShownPages);
 }
 
+const QStringList HelpEngineWrapper::lastShownPageTitles() const
+{
+    TRACE_OBJ
+    return CollectionConfiguration::lastShownPageTitles(*d->m_helpEngine);
+}
+
+void HelpEngineWrapper::setLastShownPageTitles(const QStringList &titles)
+{
+    TRACE_OBJ
+    CollectionConfiguration::setLastShownPageTitles(*d->m_helpEngine, titles);
+}
+
 const QStringList HelpEngineWrapper::lastZoomFactors() const
 {
     TRACE_OBJ
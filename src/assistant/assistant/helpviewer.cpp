@@ -130,6 +130,9 @@ public:
     QLiteHtmlWidget *m_viewer = nullptr;
     std::vector<HistoryItem> m_backItems;
     std::vector<HistoryItem> m_forwardItems;
+    // restored page that is not loaded before the viewer is shown
+    QUrl m_pendingUrl;
+    QString m_pendingTitle;
     int m_fontZoom = 100; // zoom percentage
 };
 
@@ -250,16 +253,23 @@ qreal HelpViewer::scale() const
 
 QString HelpViewer::title() const
 {
+    if (d->m_pendingUrl.isValid())
+        return d->m_pendingTitle.isEmpty() ? d->m_pendingUrl.fileName() : d->m_pendingTitle;
     return d->m_viewer->title();
 }
 
 QUrl HelpViewer::source() const
 {
+    if (d->m_pendingUrl.isValid())
+        return d->m_pendingUrl;
     return d->m_viewer->url();
 }
 
 void HelpViewer::reload()
 {
+    // a pending page gets the current data anyway once it is loaded
+    if (d->m_pendingUrl.isValid())
+        return;
     doSetSource(source(), true);
 }
 
@@ -268,11 +278,34 @@ void HelpViewer::setSource(const QUrl &url)
     doSetSource(url, false);
 }
 
+void HelpViewer::setPendingSource(const QUrl &url, const QString &title)
+{
+    d->m_pendingUrl = url;
+    d->m_pendingTitle = title;
+    if (isVisible())
+        loadPendingSource();
+    else
+        emit titleChanged();
+}
+
+void HelpViewer::loadPendingSource()
+{
+    if (!d->m_pendingUrl.isValid())
+        return;
+    const QUrl url = d->m_pendingUrl;
+    d->m_pendingUrl = QUrl();
+    d->m_pendingTitle.clear();
+    d->setSourceInternal(url);
+}
+
 void HelpViewer::doSetSource(const QUrl &url, bool reload)
 {
     if (launchWithExternalApp(url))
         return;
 
+    d->m_pendingUrl = QUrl();
+    d->m_pendingTitle.clear();
+
     d->m_forwardItems.clear();
     emit forwardAvailable(false);
     if (d->m_viewer->url().isValid()) {
@@ -377,6 +410,12 @@ bool HelpViewer::eventFilter(QObject *src, QEvent *event)
     return QWidget::eventFilter(src, event);
 }
 
+void HelpViewer::showEvent(QShowEvent *event)
+{
+    loadPendingSource();
+    QWidget::showEvent(event);
+}
+
 bool HelpViewer::isLocalUrl(const QUrl &url)
 {
     TRACE_OBJ
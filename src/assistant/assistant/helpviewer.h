@@ -68,6 +68,8 @@ public:
     QUrl source() const;
     void reload();
     void setSource(const QUrl &url);
+    void setPendingSource(const QUrl &url, const QString &title);
+    void loadPendingSource();
 
     void print(QPagedPaintDevice *printer);
 
@@ -86,6 +88,9 @@ public:
     // implementation detail, not a part of the interface
     bool eventFilter(QObject *src, QEvent *event) override;
 
+protected:
+    void showEvent(QShowEvent *event) override;
+
 public slots:
 #if QT_CONFIG(clipboard)
     void copy();
@@ -124,6 +124,8 @@ private:
     bool eventFilter(QObject *obj, QEvent *event) override;
     void contextMenuEvent(QContextMenuEvent *event) override;
     QVariant loadResource(int type, const QUrl &name) TEXTBROWSER_OVERRIDE;
+    void prefetchResources(const QUrl &url, const QByteArray &html);
+    void resourceFetched(const QUrl &url, const QByteArray &data);
     bool handleForwardBackwardMouseButtons(QMouseEvent *e);
     void scrollToTextPosition(int position);
 
@@ -35,6 +35,9 @@
 
 #include <QtCore/QObject>
 #if defined(BROWSER_QTEXTBROWSER)
+#  include <QtCore/QMultiHash>
+#  include <QtCore/QTimer>
+#  include <QtCore/QUrl>
 #  include <QtWidgets/QTextBrowser>
 #elif defined(BROWSER_QTWEBKIT)
 #  include <QtGui/QGuiApplication>
@@ -97,6 +100,10 @@ public:
     QString lastAnchor;
     int zoomCount;
     bool forceFont = false;
+    // images of the current page that are being fetched in the
+    // background, by the file they resolve to
+    QMultiHash<QUrl, QUrl> pendingResources;
+    QTimer *relayoutTimer = nullptr;
 
 private:
 
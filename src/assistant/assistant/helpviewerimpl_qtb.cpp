@@ -34,7 +34,9 @@
 #include "openpagesmanager.h"
 #include "tracer.h"
 
+#include <QtCore/QRegularExpression>
 #include <QtCore/QStringBuilder>
+#include <QtCore/QThread>
 
 #include <QtGui/QContextMenuEvent>
 #include <QtWidgets/QMenu>
@@ -44,8 +46,109 @@
 #endif
 #include <QtWidgets/QApplication>
 
+#include <QtHelp/QHelpEngineCore>
+
 QT_BEGIN_NAMESPACE
 
+// Reads files from the help collection on a thread of its own, through a
+// help engine that is only used by that thread.
+class HelpResourceFetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit HelpResourceFetcher(const QString &collectionFile)
+        : m_collectionFile(collectionFile)
+    { }
+
+    ~HelpResourceFetcher() override
+    {
+        delete m_helpEngine;
+    }
+
+public slots:
+    void fetch(const QUrl &url)
+    {
+        if (!m_helpEngine) {
+            m_helpEngine = new QHelpEngineCore(m_collectionFile);
+            m_helpEngine->setReadOnly(true);
+            m_helpEngine->setupData();
+        }
+        emit fetched(url, m_helpEngine->fileData(url));
+    }
+
+    void reset()
+    {
+        // documentation was (un)registered, drop all cached readers and data
+        delete m_helpEngine;
+        m_helpEngine = nullptr;
+    }
+
+signals:
+    void fetched(const QUrl &url, const QByteArray &data);
+
+private:
+    const QString m_collectionFile;
+    QHelpEngineCore *m_helpEngine = nullptr;
+};
+
+// Distributes the files referenced by the pages shown over a few fetcher
+// threads that are shared by all viewers.
+class HelpResourceLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    static HelpResourceLoader *instance()
+    {
+        static HelpResourceLoader *loader = new HelpResourceLoader(qApp);
+        return loader;
+    }
+
+    ~HelpResourceLoader() override
+    {
+        for (QThread *thread : qAsConst(m_threads)) {
+            thread->quit();
+            thread->wait();
+        }
+    }
+
+    void fetch(const QUrl &url)
+    {
+        HelpResourceFetcher *fetcher = m_fetchers.at(m_nextFetcher);
+        m_nextFetcher = (m_nextFetcher + 1) % m_fetchers.count();
+        QMetaObject::invokeMethod(fetcher, [fetcher, url]() { fetcher->fetch(url); },
+                                  Qt::QueuedConnection);
+    }
+
+signals:
+    void fetched(const QUrl &url, const QByteArray &data);
+
+private:
+    explicit HelpResourceLoader(QObject *parent)
+        : QObject(parent)
+    {
+        const QString &collectionFile = HelpEngineWrapper::instance().collectionFile();
+        const int threadCount = qBound(1, QThread::idealThreadCount(), 4);
+        for (int i = 0; i < threadCount; ++i) {
+            QThread *thread = new QThread(this);
+            HelpResourceFetcher *fetcher = new HelpResourceFetcher(collectionFile);
+            fetcher->moveToThread(thread);
+            connect(thread, &QThread::finished, fetcher, &QObject::deleteLater);
+            connect(fetcher, &HelpResourceFetcher::fetched, this, &HelpResourceLoader::fetched);
+            connect(&HelpEngineWrapper::instance(), &HelpEngineWrapper::setupFinished,
+                    fetcher, &HelpResourceFetcher::reset);
+            thread->start(QThread::LowPriority);
+            m_threads.append(thread);
+            m_fetchers.append(fetcher);
+        }
+    }
+
+    QList<QThread *> m_threads;
+    QList<HelpResourceFetcher *> m_fetchers;
+    int m_nextFetcher = 0;
+};
+
 HelpViewerImpl::HelpViewerImpl(qreal zoom, QWidget *parent)
     : QTextBrowser(parent)
     , d(new HelpViewerImplPrivate(zoom))
@@ -67,6 +170,16 @@ HelpViewerImpl::HelpViewerImpl(qreal zoom, QWidget *parent)
 
     connect(this, &QTextBrowser::sourceChanged, this, &HelpViewerImpl::titleChanged);
     connect(this, &HelpViewerImpl::loadFinished, this, &HelpViewerImpl::setLoadFinished);
+
+    // Relayout once for a burst of images arriving, not for each of them.
+    d->relayoutTimer = new QTimer(this);
+    d->relayoutTimer->setSingleShot(true);
+    d->relayoutTimer->setInterval(50);
+    connect(d->relayoutTimer, &QTimer::timeout, this, [this]() {
+        document()->markContentsDirty(0, document()->characterCount());
+    });
+    connect(HelpResourceLoader::instance(), &HelpResourceLoader::fetched,
+            this, &HelpViewerImpl::resourceFetched);
 }
 
 QFont HelpViewerImpl::viewerFont() const
@@ -148,6 +261,8 @@ void HelpViewerImpl::doSetSource(const QUrl &url, QTextDocument::ResourceType ty
     bool helpOrAbout = (url.toString() == QLatin1String("help"));
     const QUrl resolvedUrl = (helpOrAbout ? LocalHelpFile : HelpEngineWrapper::instance().findFile(url));
 
+    // images still on their way belong to the previous page
+    d->pendingResources.clear();
     QTextBrowser::doSetSource(resolvedUrl, type);
 
     if (!resolvedUrl.isValid()) {
@@ -372,7 +487,12 @@ QVariant HelpViewerImpl::loadResource(int type, const QUrl &name)
     QByteArray ba;
     if (type < 4) {
         const QUrl url = HelpEngineWrapper::instance().findFile(name);
+        // Until a prefetched image arrives, the page is laid out without it.
+        if (type == QTextDocument::ImageResource && d->pendingResources.contains(url))
+            return QVariant();
         ba = HelpEngineWrapper::instance().fileData(url);
+        if (type == QTextDocument::HtmlResource)
+            prefetchResources(name, ba);
         if (url.toString().endsWith(QLatin1String(".svg"), Qt::CaseInsensitive)) {
             QImage image;
             image.loadFromData(ba, "svg");
@@ -383,6 +503,53 @@ QVariant HelpViewerImpl::loadResource(int type, const QUrl &name)
     return ba;
 }
 
+/*
+    Starts fetching the images referenced by the page \a html, located at
+    \a url, in the background, so that showing the page does not wait for
+    each of them in turn.
+*/
+void HelpViewerImpl::prefetchResources(const QUrl &url, const QByteArray &html)
+{
+    TRACE_OBJ
+    static const QRegularExpression imagePattern(
+                QLatin1String("<img[^>]+src\\s*=\\s*\"([^\">]+)\""),
+                QRegularExpression::CaseInsensitiveOption);
+
+    HelpEngineWrapper &helpEngine = HelpEngineWrapper::instance();
+    const QString content = QString::fromLatin1(html);
+    for (auto it = imagePattern.globalMatch(content); it.hasNext(); ) {
+        const QUrl name = url.resolved(QUrl(it.next().captured(1)));
+        if (name.scheme() != QLatin1String("qthelp"))
+            continue;
+        const QUrl fileUrl = helpEngine.findFile(name);
+        if (!fileUrl.isValid())
+            continue;
+        const bool fetching = d->pendingResources.contains(fileUrl);
+        d->pendingResources.insert(fileUrl, name);
+        if (!fetching)
+            HelpResourceLoader::instance()->fetch(fileUrl);
+    }
+}
+
+void HelpViewerImpl::resourceFetched(const QUrl &url, const QByteArray &data)
+{
+    TRACE_OBJ
+    const QList<QUrl> names = d->pendingResources.values(url);
+    if (names.isEmpty())
+        return;
+    d->pendingResources.remove(url);
+
+    QVariant resource = data;
+    if (url.toString().endsWith(QLatin1String(".svg"), Qt::CaseInsensitive)) {
+        QImage image;
+        image.loadFromData(data, "svg");
+        if (!image.isNull())
+            resource = image;
+    }
+    for (const QUrl &name : names)
+        document()->addResource(QTextDocument::ImageResource, name, resource);
+    d->relayoutTimer->start();
+}
 
 void HelpViewerImpl::scrollToTextPosition(int position)
 {
@@ -396,3 +563,5 @@ void HelpViewerImpl::scrollToTextPosition(int position)
 }
 
 QT_END_NAMESPACE
+
+#include "helpviewerimpl_qtb.moc"
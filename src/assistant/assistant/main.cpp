@@ -70,10 +70,14 @@ updateLastPagesOnUnregister(QHelpEngineCore& helpEngine, const QString& nsName)
         QStringList zoomList = CollectionConfiguration::lastZoomFactors(helpEngine);
         while (zoomList.count() < currentPages.count())
             zoomList.append(CollectionConfiguration::DefaultZoomFactor);
+        QStringList titles = CollectionConfiguration::lastShownPageTitles(helpEngine);
+        while (titles.count() < currentPages.count())
+            titles.append(QString());
 
         for (int i = currentPages.count(); --i >= 0;) {
             if (QUrl(currentPages.at(i)).host() == nsName) {
                 zoomList.removeAt(i);
+                titles.removeAt(i);
                 currentPages.removeAt(i);
                 lastPage = (lastPage == (i + 1)) ? 1 : lastPage;
             }
@@ -82,6 +86,7 @@ updateLastPagesOnUnregister(QHelpEngineCore& helpEngine, const QString& nsName)
         CollectionConfiguration::setLastShownPages(helpEngine, currentPages);
         CollectionConfiguration::setLastTabPage(helpEngine, lastPage);
         CollectionConfiguration::setLastZoomFactors(helpEngine, zoomList);
+        CollectionConfiguration::setLastShownPageTitles(helpEngine, titles);
     }
 }
 
@@ -239,7 +239,7 @@ MainWindow::MainWindow(CmdLineParser *cmdLine, QWidget *parent)
 
     QTimer::singleShot(0, this, &MainWindow::insertLastPages);
     if (m_cmdLine->enableRemoteControl())
-        (void)new RemoteControl(this);
+        (void)new RemoteControl(this, m_cmdLine->remoteControlSocket());
 
     if (m_cmdLine->contents() == CmdLineParser::Show)
         showContents();
@@ -421,8 +421,8 @@ void MainWindow::lookForNewQtDocumentation()
             this, &MainWindow::qtDocumentationInstalled);
     connect(m_qtDocInstaller, &QtDocInstaller::qchFileNotFound,
             this, &MainWindow::resetQtDocInfo);
-    connect(m_qtDocInstaller, &QtDocInstaller::registerDocumentation,
-            this, &MainWindow::registerDocumentation);
+    connect(m_qtDocInstaller, &QtDocInstaller::registerDocumentations,
+            this, &MainWindow::registerDocumentations);
     if (helpEngine.qtDocInfo(QLatin1String("qt")).count() != 2)
         statusBar()->showMessage(tr("Looking for Qt Documentation..."));
     m_qtDocInstaller->installDocs();
@@ -1147,26 +1147,45 @@ void MainWindow::resetQtDocInfo(const QString &component)
         QStringList(QDateTime().toString(Qt::ISODate)));
 }
 
-void MainWindow::registerDocumentation(const QString &component,
-                                       const QString &absFileName)
+void MainWindow::registerDocumentations(const QStringList &components,
+                                        const QStringList &absFileNames)
 {
     TRACE_OBJ
-    QString ns = QHelpEngineCore::namespaceName(absFileName);
-    if (ns.isEmpty())
+    HelpEngineWrapper &helpEngine = HelpEngineWrapper::instance();
+    const QStringList &registeredDocs = helpEngine.registeredDocumentations();
+
+    QStringList namespaces;
+    QStringList fileNames;
+    for (const QString &absFileName : absFileNames) {
+        const QString ns = QHelpEngineCore::namespaceName(absFileName);
+        if (registeredDocs.contains(ns))
+            helpEngine.unregisterDocumentation(ns);
+        namespaces.append(ns);
+        if (!ns.isEmpty())
+            fileNames.append(absFileName);
+    }
+
+    if (fileNames.isEmpty())
         return;
 
-    HelpEngineWrapper &helpEngine = HelpEngineWrapper::instance();
-    if (helpEngine.registeredDocumentations().contains(ns))
-        helpEngine.unregisterDocumentation(ns);
-    if (!helpEngine.registerDocumentation(absFileName)) {
-        QMessageBox::warning(this, tr("Qt Assistant"),
-            tr("Could not register file '%1': %2").
-            arg(absFileName).arg(helpEngine.error()));
-    } else {
+    helpEngine.registerDocumentations(fileNames);
+    const QString error = helpEngine.error();
+    const QStringList &newRegisteredDocs = helpEngine.registeredDocumentations();
+    for (int i = 0; i < absFileNames.count(); ++i) {
+        const QString &ns = namespaces.at(i);
+        if (ns.isEmpty())
+            continue;
+        const QString &absFileName = absFileNames.at(i);
+        if (!newRegisteredDocs.contains(ns)) {
+            QMessageBox::warning(this, tr("Qt Assistant"),
+                tr("Could not register file '%1': %2").
+                arg(absFileName).arg(error));
+            continue;
+        }
         QStringList docInfo;
         docInfo << QFileInfo(absFileName).lastModified().toString(Qt::ISODate)
                 << absFileName;
-        helpEngine.setQtDocInfo(component, docInfo);
+        helpEngine.setQtDocInfo(components.at(i), docInfo);
     }
 }
 
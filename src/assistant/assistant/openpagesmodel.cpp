@@ -65,6 +65,23 @@ QVariant OpenPagesModel::data(const QModelIndex &index, int role) const
 }
 
 HelpViewer *OpenPagesModel::addPage(const QUrl &url, qreal zoom)
+{
+    TRACE_OBJ
+    HelpViewer *page = appendViewer(zoom);
+    page->setSource(url);
+    return page;
+}
+
+// the page is only loaded once it is shown
+HelpViewer *OpenPagesModel::addPendingPage(const QUrl &url, const QString &title, qreal zoom)
+{
+    TRACE_OBJ
+    HelpViewer *page = appendViewer(zoom);
+    page->setPendingSource(url, title);
+    return page;
+}
+
+HelpViewer *OpenPagesModel::appendViewer(qreal zoom)
 {
     TRACE_OBJ
     beginInsertRows(QModelIndex(), rowCount(), rowCount());
@@ -73,7 +90,6 @@ HelpViewer *OpenPagesModel::addPage(const QUrl &url, qreal zoom)
             this, &OpenPagesModel::handleTitleChanged);
     m_pages << page;
     endInsertRows();
-    page->setSource(url);
     return page;
 }
 
@@ -49,6 +49,7 @@ public:
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
 
     HelpViewer *addPage(const QUrl &url, qreal zoom = 0);
+    HelpViewer *addPendingPage(const QUrl &url, const QString &title, qreal zoom = 0);
     void removePage(int index);
     HelpViewer *pageAt(int index) const;
 
@@ -57,6 +58,7 @@ private slots:
 
 private:
     OpenPagesModel(QObject *parent);
+    HelpViewer *appendViewer(qreal zoom);
 
 private:
     QList<HelpViewer *> m_pages;
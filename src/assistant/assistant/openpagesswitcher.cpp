@@ -29,6 +29,7 @@
 #include "openpagesswitcher.h"
 
 #include "centralwidget.h"
+#include "helpviewer.h"
 #include "openpagesmodel.h"
 #include "openpageswidget.h"
 #include "tracer.h"
@@ -70,6 +71,11 @@ OpenPagesSwitcher::OpenPagesSwitcher(OpenPagesModel *model)
             this, &OpenPagesSwitcher::closePage);
     connect(m_openPagesWidget, &OpenPagesWidget::setCurrentPage,
             this, &OpenPagesSwitcher::setCurrentPage);
+
+    // load restored pages as soon as they are hovered
+    m_openPagesWidget->setMouseTracking(true);
+    connect(m_openPagesWidget, &QAbstractItemView::entered,
+            this, &OpenPagesSwitcher::loadPage);
 }
 
 OpenPagesSwitcher::~OpenPagesSwitcher()
@@ -175,7 +181,15 @@ void OpenPagesSwitcher::selectPageUpDown(int summand)
     if (index.isValid()) {
         m_openPagesWidget->setCurrentIndex(index);
         m_openPagesWidget->scrollTo(index, QAbstractItemView::PositionAtCenter);
+        loadPage(index);
     }
 }
 
+void OpenPagesSwitcher::loadPage(const QModelIndex &index)
+{
+    TRACE_OBJ
+    if (index.isValid())
+        m_openPagesModel->pageAt(index.row())->loadPendingSource();
+}
+
 QT_END_NAMESPACE
@@ -61,6 +61,7 @@ signals:
 
 private:
     void selectPageUpDown(int summand);
+    void loadPage(const QModelIndex &index);
 
 private:
     OpenPagesModel *m_openPagesModel;
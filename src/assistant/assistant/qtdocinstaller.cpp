@@ -76,6 +76,10 @@ void QtDocInstaller::run()
         }
         m_mutex.unlock();
     }
+    // Hand all new files over at once, so that they can be registered
+    // in a single batch.
+    if (!m_absFileNames.isEmpty())
+        emit registerDocumentations(m_components, m_absFileNames);
     emit docsInstalled(changes);
 }
 
@@ -102,7 +106,8 @@ bool QtDocInstaller::installDoc(const DocInfo &docInfo)
             if (dt.isValid() && fi.lastModified().toSecsSinceEpoch() == dt.toSecsSinceEpoch()
                 && qchFile == fi.absoluteFilePath())
                 return false;
-            emit registerDocumentation(component, fi.absoluteFilePath());
+            m_components.append(component);
+            m_absFileNames.append(fi.absoluteFilePath());
             return true;
         }
     }
@@ -51,8 +51,8 @@ public:
 
 signals:
     void qchFileNotFound(const QString &component);
-    void registerDocumentation(const QString &component,
-                               const QString &absFileName);
+    void registerDocumentations(const QStringList &components,
+                                const QStringList &absFileNames);
     void docsInstalled(bool newDocsInstalled);
 
 private:
@@ -64,6 +64,8 @@ private:
     QStringList m_qchFiles;
     QDir m_qchDir;
     QList<DocInfo> m_docInfos;
+    QStringList m_components;
+    QStringList m_absFileNames;
 };
 
 QT_END_NAMESPACE
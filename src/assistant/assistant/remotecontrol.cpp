@@ -38,6 +38,9 @@
 #include <QtCore/QFileSystemWatcher>
 #include <QtCore/QTextStream>
 
+#include <QtNetwork/QLocalServer>
+#include <QtNetwork/QLocalSocket>
+
 #include <QtWidgets/QMessageBox>
 #include <QtWidgets/QApplication>
 
@@ -55,7 +58,37 @@
 
 QT_BEGIN_NAMESPACE
 
-RemoteControl::RemoteControl(MainWindow *mainWindow)
+// Commands arriving within this many milliseconds of each other are
+// treated as one burst, of which only the last navigation is executed.
+static const int CommandCoalesceInterval = 20;
+
+// Upper bound for the number of memorized identifier lookups.
+static const int IdentifierCacheSize = 256;
+
+static bool isKnownCommand(const QString &cmd)
+{
+    static const char *const commands[] = {
+        "debug", "show", "hide", "setsource", "synccontents",
+        "activatekeyword", "activateidentifier", "expandtoc",
+        "setcurrentfilter", "register", "unregister"
+    };
+    for (const char *command : commands) {
+        if (cmd == QLatin1String(command))
+            return true;
+    }
+    return false;
+}
+
+// Navigation commands replace the current page, so within a burst only
+// the last one has a visible effect.
+static bool isNavigationCommand(const QString &cmd)
+{
+    return cmd == QLatin1String("setsource")
+        || cmd == QLatin1String("activatekeyword")
+        || cmd == QLatin1String("activateidentifier");
+}
+
+RemoteControl::RemoteControl(MainWindow *mainWindow, const QString &socketName)
     : QObject(mainWindow)
     , m_mainWindow(mainWindow)
     , helpEngine(HelpEngineWrapper::instance())
@@ -64,10 +97,81 @@ RemoteControl::RemoteControl(MainWindow *mainWindow)
     connect(m_mainWindow, &MainWindow::initDone,
             this, &RemoteControl::applyCache);
 
+    m_commandTimer.setSingleShot(true);
+    m_commandTimer.setInterval(CommandCoalesceInterval);
+    connect(&m_commandTimer, &QTimer::timeout,
+            this, &RemoteControl::processPendingCommands);
+
+    connect(&helpEngine, &HelpEngineWrapper::setupFinished,
+            this, &RemoteControl::clearIdentifierCache);
+    connect(&helpEngine, &HelpEngineWrapper::documentationRemoved,
+            this, &RemoteControl::clearIdentifierCache);
+    connect(&helpEngine, &HelpEngineWrapper::documentationUpdated,
+            this, &RemoteControl::clearIdentifierCache);
+    connect(helpEngine.filterEngine(), &QHelpFilterEngine::filterActivated,
+            this, &RemoteControl::clearIdentifierCache);
+
     StdInListener *l = new StdInListener(this);
     connect(l, &StdInListener::receivedCommand,
             this, &RemoteControl::handleCommandString);
     l->start();
+
+    if (!socketName.isEmpty())
+        listen(socketName);
+}
+
+void RemoteControl::listen(const QString &socketName)
+{
+    TRACE_OBJ
+    m_server = new QLocalServer(this);
+    if (!m_server->listen(socketName)) {
+        // A previous instance that crashed may have left a stale socket.
+        QLocalServer::removeServer(socketName);
+        if (!m_server->listen(socketName)) {
+            qWarning("Cannot listen for remote control commands on '%s': %s",
+                     qPrintable(socketName),
+                     qPrintable(m_server->errorString()));
+            return;
+        }
+    }
+    connect(m_server, &QLocalServer::newConnection,
+            this, &RemoteControl::handleNewConnection);
+}
+
+void RemoteControl::handleNewConnection()
+{
+    TRACE_OBJ
+    while (QLocalSocket *socket = m_server->nextPendingConnection()) {
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket] {
+            readFromSocket(socket);
+        });
+        connect(socket, &QLocalSocket::disconnected, this, [this, socket] {
+            readFromSocket(socket);
+            m_socketBuffers.remove(socket);
+            socket->deleteLater();
+        });
+        readFromSocket(socket);
+    }
+}
+
+void RemoteControl::readFromSocket(QLocalSocket *socket)
+{
+    TRACE_OBJ
+    // Commands are terminated by a newline or a null character, just as
+    // on stdin, but all complete commands are taken at once.
+    QByteArray &buffer = m_socketBuffers[socket];
+    buffer.append(socket->readAll());
+    qsizetype start = 0;
+    for (qsizetype i = 0; i < buffer.size(); ++i) {
+        const char c = buffer.at(i);
+        if (c != '\n' && c != '\0')
+            continue;
+        const QByteArray command = buffer.mid(start, i - start);
+        start = i + 1;
+        if (!command.trimmed().isEmpty())
+            handleCommandString(QString::fromLocal8Bit(command));
+    }
+    buffer.remove(0, start);
 }
 
 void RemoteControl::handleCommandString(const QString &cmdString)
@@ -82,35 +186,93 @@ void RemoteControl::handleCommandString(const QString &cmdString)
             QMessageBox::information(nullptr, tr("Debugging Remote Control"),
                 tr("Received Command: %1 %2").arg(cmd).arg(arg));
 
-        if (cmd == QLatin1String("debug"))
-            handleDebugCommand(arg);
-         else if (cmd == QLatin1String("show"))
-            handleShowOrHideCommand(arg, true);
-         else if (cmd == QLatin1String("hide"))
-            handleShowOrHideCommand(arg, false);
-         else if (cmd == QLatin1String("setsource"))
-            handleSetSourceCommand(arg);
-         else if (cmd == QLatin1String("synccontents"))
-            handleSyncContentsCommand();
-         else if (cmd == QLatin1String("activatekeyword"))
-            handleActivateKeywordCommand(arg);
-         else if (cmd == QLatin1String("activateidentifier"))
-            handleActivateIdentifierCommand(arg);
-         else if (cmd == QLatin1String("expandtoc"))
-            handleExpandTocCommand(arg);
-         else if (cmd == QLatin1String("setcurrentfilter"))
-            handleSetCurrentFilterCommand(arg);
-         else if (cmd == QLatin1String("register"))
-            handleRegisterCommand(arg);
-         else if (cmd == QLatin1String("unregister"))
-            handleUnregisterCommand(arg);
-         else
+        if (!isKnownCommand(cmd))
             break;
+
+        if (m_caching)
+            executeCommand(cmd, arg);
+        else
+            m_pendingCommands.append(qMakePair(cmd, arg));
+    }
+
+    if (m_caching) {
+        m_mainWindow->raise();
+        m_mainWindow->activateWindow();
+    } else if (!m_pendingCommands.isEmpty()) {
+        m_commandTimer.start();
+    }
+}
+
+void RemoteControl::processPendingCommands()
+{
+    TRACE_OBJ
+    const QList<QPair<QString, QString>> commands = m_pendingCommands;
+    m_pendingCommands.clear();
+
+    qsizetype lastNavigation = -1;
+    for (qsizetype i = 0; i < commands.size(); ++i) {
+        if (isNavigationCommand(commands.at(i).first))
+            lastNavigation = i;
     }
+
+    for (qsizetype i = 0; i < commands.size(); ++i) {
+        const QPair<QString, QString> &command = commands.at(i);
+        if (i != lastNavigation && isNavigationCommand(command.first))
+            continue;
+        executeCommand(command.first, command.second);
+    }
+
     m_mainWindow->raise();
     m_mainWindow->activateWindow();
 }
 
+void RemoteControl::executeCommand(const QString &cmd, const QString &arg)
+{
+    TRACE_OBJ
+    if (cmd == QLatin1String("debug"))
+        handleDebugCommand(arg);
+    else if (cmd == QLatin1String("show"))
+        handleShowOrHideCommand(arg, true);
+    else if (cmd == QLatin1String("hide"))
+        handleShowOrHideCommand(arg, false);
+    else if (cmd == QLatin1String("setsource"))
+        handleSetSourceCommand(arg);
+    else if (cmd == QLatin1String("synccontents"))
+        handleSyncContentsCommand();
+    else if (cmd == QLatin1String("activatekeyword"))
+        handleActivateKeywordCommand(arg);
+    else if (cmd == QLatin1String("activateidentifier"))
+        handleActivateIdentifierCommand(arg);
+    else if (cmd == QLatin1String("expandtoc"))
+        handleExpandTocCommand(arg);
+    else if (cmd == QLatin1String("setcurrentfilter"))
+        handleSetCurrentFilterCommand(arg);
+    else if (cmd == QLatin1String("register"))
+        handleRegisterCommand(arg);
+    else if (cmd == QLatin1String("unregister"))
+        handleUnregisterCommand(arg);
+}
+
+QList<QHelpLink> RemoteControl::documentsForIdentifier(const QString &id)
+{
+    TRACE_OBJ
+    const auto it = m_identifierCache.constFind(id);
+    if (it != m_identifierCache.constEnd())
+        return it.value();
+
+    if (m_identifierCache.size() >= IdentifierCacheSize)
+        m_identifierCache.clear();
+    const QList<QHelpLink> docs = helpEngine.documentsForIdentifier(id);
+    m_identifierCache.insert(id, docs);
+    return docs;
+}
+
+void RemoteControl::clearIdentifierCache()
+{
+    TRACE_OBJ
+    m_identifierCache.clear();
+}
+
 void RemoteControl::splitInputString(const QString &input, QString &cmd,
                                      QString &arg)
 {
@@ -200,7 +362,7 @@ void RemoteControl::handleActivateIdentifierCommand(const QString &arg)
         clearCache();
         m_activateIdentifier = arg;
     } else {
-        const auto docs = helpEngine.documentsForIdentifier(arg);
+        const auto docs = documentsForIdentifier(arg);
         if (!docs.isEmpty())
             CentralWidget::instance()->setSource(docs.first().url);
     }
@@ -267,8 +429,7 @@ void RemoteControl::applyCache()
         m_mainWindow->setIndexString(m_activateKeyword);
         helpEngine.indexWidget()->activateCurrentItem();
     } else if (!m_activateIdentifier.isEmpty()) {
-        const auto docs =
-            helpEngine.documentsForIdentifier(m_activateIdentifier);
+        const auto docs = documentsForIdentifier(m_activateIdentifier);
         if (!docs.isEmpty())
             CentralWidget::instance()->setSource(docs.first().url);
     } else if (!m_currentFilter.isEmpty()) {
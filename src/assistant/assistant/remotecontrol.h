@@ -29,28 +29,44 @@
 #ifndef REMOTECONTROL_H
 #define REMOTECONTROL_H
 
+#include <QtCore/QHash>
+#include <QtCore/QList>
 #include <QtCore/QObject>
+#include <QtCore/QPair>
 #include <QtCore/QString>
+#include <QtCore/QTimer>
 #include <QtCore/QUrl>
 
+#include <QtHelp/QHelpLink>
+
 QT_BEGIN_NAMESPACE
 
 class HelpEngineWrapper;
 class MainWindow;
+class QLocalServer;
+class QLocalSocket;
 
 class RemoteControl : public QObject
 {
     Q_OBJECT
 
 public:
-    RemoteControl(MainWindow *mainWindow);
+    RemoteControl(MainWindow *mainWindow,
+                  const QString &socketName = QString());
 
 private slots:
     void handleCommandString(const QString &cmdString);
+    void processPendingCommands();
     void applyCache();
+    void clearIdentifierCache();
+    void handleNewConnection();
+    void readFromSocket(QLocalSocket *socket);
 
 private:
+    void listen(const QString &socketName);
     void clearCache();
+    void executeCommand(const QString &cmd, const QString &arg);
+    QList<QHelpLink> documentsForIdentifier(const QString &id);
     void splitInputString(const QString &input, QString &cmd, QString &arg);
     void handleDebugCommand(const QString &arg);
     void handleShowOrHideCommand(const QString &arg, bool show);
@@ -75,6 +91,12 @@ private:
 
     bool m_caching = true;
     bool m_syncContents = false;
+
+    QList<QPair<QString, QString>> m_pendingCommands;
+    QTimer m_commandTimer;
+    QHash<QString, QList<QHelpLink>> m_identifierCache;
+    QLocalServer *m_server = nullptr;
+    QHash<QLocalSocket *, QByteArray> m_socketBuffers;
 };
 
 QT_END_NAMESPACE
@@ -32,6 +32,7 @@
 #include "bookmarkitem.h"
 #include "bookmarkmodel.h"
 
+#include <QtCore/QCoreApplication>
 #include <QtCore/QDate>
 #include <QtCore/QModelIndex>
 
@@ -115,11 +116,14 @@ bool XbelReader::readFromFile(QIODevice *device)
             if (name() == QLatin1String("xbel")
                 && attributes().value(QLatin1String("version"))
                     == QLatin1String("1.0")) {
-                const QModelIndex root;
-                parents.append(bookmarkModel->addItem(root, true));
+                // build the imported tree first and add it to the model in one go
+                BookmarkItem *folder = new BookmarkItem(DataVector()
+                    << QDate::currentDate().toString(Qt::ISODate)
+                    << QLatin1String("Folder") << false);
+                parents.append(folder);
                 readXBEL();
-                bookmarkModel->setData(parents.first(),
-                    QDate::currentDate().toString(Qt::ISODate), Qt::EditRole);
+                parents.clear();
+                bookmarkModel->appendItem(folder);
             } else {
                 raiseError(QLatin1String("The file is not an XBEL version 1.0 file."));
             }
@@ -152,10 +156,12 @@ void XbelReader::readXBEL()
 void XbelReader::readFolder()
 {
     TRACE_OBJ
-    parents.append(bookmarkModel->addItem(parents.last(), true));
-    bookmarkModel->setData(parents.last(),
-        attributes().value(QLatin1String("folded")) == QLatin1String("no"),
-        UserRoleExpanded);
+    BookmarkItem *folder = new BookmarkItem(DataVector()
+        << QCoreApplication::translate("BookmarkItem", "New Folder")
+        << QLatin1String("Folder")
+        << (attributes().value(QLatin1String("folded")) == QLatin1String("no")));
+    parents.last()->addChild(folder);
+    parents.append(folder);
 
     while (!atEnd()) {
         readNext();
@@ -165,8 +171,7 @@ void XbelReader::readFolder()
 
         if (isStartElement()) {
             if (name() == QLatin1String("title")) {
-                bookmarkModel->setData(parents.last(), readElementText(),
-                    Qt::EditRole);
+                folder->setData(0, readElementText());
             } else if (name() == QLatin1String("folder"))
                 readFolder();
             else if (name() == QLatin1String("bookmark"))
@@ -182,11 +187,10 @@ void XbelReader::readFolder()
 void XbelReader::readBookmark()
 {
     TRACE_OBJ
-    const QModelIndex &index = bookmarkModel->addItem(parents.last(), false);
-    if (BookmarkItem* item = bookmarkModel->itemFromIndex(index)) {
-        item->setData(UserRoleUrl, attributes().value(QLatin1String("href"))
-            .toString());
-    }
+    BookmarkItem *item = new BookmarkItem(DataVector()
+        << QCoreApplication::translate("BookmarkItem", "Untitled")
+        << attributes().value(QLatin1String("href")).toString() << false);
+    parents.last()->addChild(item);
 
     while (!atEnd()) {
         readNext();
@@ -196,7 +200,7 @@ void XbelReader::readBookmark()
 
         if (isStartElement()) {
             if (name() == QLatin1String("title"))
-                bookmarkModel->setData(index, readElementText(), Qt::EditRole);
+                item->setData(0, readElementText());
             else
                 readUnknownElement();
         }
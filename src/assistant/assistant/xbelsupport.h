@@ -30,13 +30,13 @@
 #define XBELSUPPORT_H
 
 #include <QtCore/QXmlStreamReader>
-#include <QtCore/QPersistentModelIndex>
 
 QT_FORWARD_DECLARE_CLASS(QIODevice)
 QT_FORWARD_DECLARE_CLASS(QModelIndex)
 
 QT_BEGIN_NAMESPACE
 
+class BookmarkItem;
 class BookmarkModel;
 
 class XbelWriter : public QXmlStreamWriter
@@ -66,7 +66,7 @@ private:
 
 private:
     BookmarkModel *bookmarkModel;
-    QList<QPersistentModelIndex> parents;
+    QList<BookmarkItem *> parents;
 };
 
 QT_END_NAMESPACE
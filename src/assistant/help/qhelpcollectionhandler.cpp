@@ -42,12 +42,16 @@
 #include "qhelpdbreader_p.h"
 #include "qhelpfilterdata.h"
 
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QDataStream>
 #include <QtCore/QDateTime>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QList>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
 #include <QtCore/QTimer>
 #include <QtCore/QVersionNumber>
 
@@ -55,6 +59,11 @@
 
 #include <QtSql/QSqlError>
 #include <QtSql/QSqlDriver>
+#include <QtSql/QSqlRecord>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -89,9 +98,83 @@ private:
     bool m_inTransaction;
 };
 
+/*
+  Prepared statements and lookups used when reading from one database
+  connection. Each thread reading through the handler has its own, since
+  a connection may only be used by the thread that created it.
+ */
+struct QHelpCollectionHandler::ReadCache
+{
+    ~ReadCache()
+    {
+        clearQueries();
+        clearFileData();
+    }
+
+    void clearQueries()
+    {
+        qDeleteAll(preparedQueries);
+        preparedQueries.clear();
+        filterNamespaceQueries.clear();
+    }
+
+    void clearFileData()
+    {
+        qDeleteAll(fileDataReaders);
+        fileDataReaders.clear();
+        fileDataNamespaces.clear();
+    }
+
+    QString connectionName;
+    quint64 revision = 0;
+    QHash<QString, QHelpSqlQuery *> preparedQueries;
+    QHash<QString, QString> filterNamespaceQueries;
+    QHash<QString, QString> fileDataNamespaces;
+    QHash<QString, QHelpDBReader *> fileDataReaders;
+};
+
+/*
+  The read caches of the threads other than the one the handler lives in,
+  by thread token. Each thread deletes its cache and closes its connection
+  itself when it finishes, as the connection must not be touched by any
+  other thread. The connections to QThread::finished share ownership of
+  this, so that it outlives the handler if a reading thread does.
+ */
+struct QHelpCollectionHandler::ThreadReadCaches
+{
+    // The read cache the calling thread used last. Handlers are told apart
+    // by serial rather than by address, which may be reused by a later one.
+    struct LastUsed
+    {
+        quint64 serial = 0;
+        ReadCache *cache = nullptr;
+    };
+    static inline thread_local LastUsed lastUsed;
+
+    QMutex mutex;
+    QHash<quint64, ReadCache *> caches;
+};
+
+static std::atomic<quint64> nextHandlerSerial{1};
+
+/*
+  Returns a token only ever handed out to the calling thread. Unlike the
+  QThread pointer, it is not reused by threads started after this one has
+  finished.
+ */
+static quint64 currentThreadToken()
+{
+    static std::atomic<quint64> nextToken{1};
+    static thread_local const quint64 token = nextToken.fetch_add(1, std::memory_order_relaxed);
+    return token;
+}
+
 QHelpCollectionHandler::QHelpCollectionHandler(const QString &collectionFile, QObject *parent)
     : QObject(parent)
     , m_collectionFile(collectionFile)
+    , m_readCache(new ReadCache)
+    , m_threadReadCaches(std::make_shared<ThreadReadCaches>())
+    , m_serial(nextHandlerSerial.fetch_add(1, std::memory_order_relaxed))
 {
     const QFileInfo fi(m_collectionFile);
     if (!fi.isAbsolute())
@@ -100,7 +183,10 @@ QHelpCollectionHandler::QHelpCollectionHandler(const QString &collectionFile, QO
 
 QHelpCollectionHandler::~QHelpCollectionHandler()
 {
+    // The caches of other threads are left to those threads, which close
+    // them when they finish.
     closeDB();
+    delete m_readCache;
 }
 
 bool QHelpCollectionHandler::isDBOpened() const
@@ -117,10 +203,73 @@ void QHelpCollectionHandler::closeDB()
     if (!m_query)
         return;
 
+    clearFileDataCache();
+    clearFilterCache();
+    ++m_dataRevision;
     delete m_query;
     m_query = nullptr;
     QSqlDatabase::removeDatabase(m_connectionName);
     m_connectionName = QString();
+    m_readCache->connectionName = QString();
+}
+
+/*
+  Returns the read cache of the calling thread. Threads other than the
+  one the handler lives in get a read-only connection to the collection
+  file of their own, so that fileData(), documentsForIdentifier() and
+  documentsForKeyword() can serve them at the same time. Their caches
+  are cleared whenever the data revision changes, and deleted by the
+  thread itself when it finishes.
+ */
+QHelpCollectionHandler::ReadCache *QHelpCollectionHandler::readCache() const
+{
+    QThread *currentThread = QThread::currentThread();
+    if (currentThread == thread())
+        return m_readCache;
+
+    ThreadReadCaches::LastUsed &last = ThreadReadCaches::lastUsed;
+    ReadCache *cache = last.cache;
+    if (last.serial != m_serial) {
+        const quint64 token = currentThreadToken();
+        QMutexLocker locker(&m_threadReadCaches->mutex);
+        cache = m_threadReadCaches->caches.value(token);
+        if (!cache) {
+            cache = new ReadCache;
+            cache->connectionName = QHelpGlobal::uniquifyConnectionName(
+                        QLatin1String("QHelpCollectionHandlerReader"), currentThread);
+            QSqlDatabase db = QSqlDatabase::addDatabase(QLatin1String("QSQLITE"),
+                                                        cache->connectionName);
+            db.setConnectOptions(QLatin1String("QSQLITE_OPEN_READONLY"));
+            db.setDatabaseName(collectionFile());
+            db.open();
+            m_threadReadCaches->caches.insert(token, cache);
+            // Emitted from the finishing thread, before it is gone.
+            connect(currentThread, &QThread::finished, currentThread,
+                    [caches = m_threadReadCaches, token] {
+                        ReadCache *cache;
+                        {
+                            QMutexLocker locker(&caches->mutex);
+                            cache = caches->caches.take(token);
+                        }
+                        if (cache) {
+                            const QString connectionName = cache->connectionName;
+                            delete cache;
+                            QSqlDatabase::removeDatabase(connectionName);
+                        }
+                        ThreadReadCaches::lastUsed = ThreadReadCaches::LastUsed();
+                    }, Qt::DirectConnection);
+        }
+        last.serial = m_serial;
+        last.cache = cache;
+    }
+
+    const quint64 revision = dataRevision();
+    if (cache->revision != revision) {
+        cache->clearQueries();
+        cache->clearFileData();
+        cache->revision = revision;
+    }
+    return cache;
 }
 
 QString QHelpCollectionHandler::collectionFile() const
@@ -128,6 +277,37 @@ QString QHelpCollectionHandler::collectionFile() const
     return m_collectionFile;
 }
 
+// Hashes everything that the contents and the index shown for a filter
+// depend on: the registered documentation, including the size and time
+// stamp of each file, and the filter definitions. Settings are left out,
+// as they change all the time without affecting either.
+QByteArray QHelpCollectionHandler::stateHash() const
+{
+    if (!isDBOpened())
+        return QByteArray();
+
+    static const char *const tables[] = {
+        "NamespaceTable", "FolderTable", "VersionTable", "TimeStampTable",
+        "FilterAttributeTable", "FilterNameTable", "FilterTable", "OptimizedFilterTable",
+        "Filter", "ComponentTable", "ComponentMapping", "ComponentFilter", "VersionFilter"
+    };
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (const char *table : tables) {
+        hash.addData(table, qstrlen(table));
+        if (!m_query->exec(QLatin1String("SELECT * FROM ") + QLatin1String(table)))
+            continue;
+        while (m_query->next()) {
+            const int count = m_query->record().count();
+            for (int i = 0; i < count; ++i) {
+                hash.addData(m_query->value(i).toString().toUtf8());
+                hash.addData("", 1);
+            }
+        }
+    }
+    return hash.result();
+}
+
 bool QHelpCollectionHandler::openCollectionFile()
 {
     if (m_query)
@@ -146,7 +326,8 @@ bool QHelpCollectionHandler::openCollectionFile()
 
         db.setDatabaseName(collectionFile());
         if (db.open())
-            m_query = new QSqlQuery(db);
+            m_query = new QHelpSqlQuery(db, &m_queryStatistics);
+        m_readCache->connectionName = m_connectionName;
 
         if (!m_query) {
             QSqlDatabase::removeDatabase(m_connectionName);
@@ -337,6 +518,8 @@ void QHelpCollectionHandler::execVacuum()
     if (!m_query)
         return;
 
+    // VACUUM fails while any statement is still active.
+    clearFilterCache();
     m_query->exec(QLatin1String("VACUUM"));
     m_vacuumScheduled = false;
 }
@@ -361,14 +544,14 @@ bool QHelpCollectionHandler::copyCollectionFile(const QString &fileName)
     const QString &colFile = fi.absoluteFilePath();
     const QString &connectionName = QHelpGlobal::uniquifyConnectionName(
                 QLatin1String("QHelpCollectionHandlerCopy"), this);
-    QSqlQuery *copyQuery = nullptr;
+    QHelpSqlQuery *copyQuery = nullptr;
     bool openingOk = true;
     {
         QSqlDatabase db = QSqlDatabase::addDatabase(QLatin1String("QSQLITE"), connectionName);
         db.setDatabaseName(colFile);
         openingOk = db.open();
         if (openingOk)
-            copyQuery = new QSqlQuery(db);
+            copyQuery = new QHelpSqlQuery(db, &m_queryStatistics);
     }
 
     if (!openingOk) {
@@ -444,7 +627,7 @@ bool QHelpCollectionHandler::copyCollectionFile(const QString &fileName)
     return true;
 }
 
-bool QHelpCollectionHandler::createTables(QSqlQuery *query)
+bool QHelpCollectionHandler::createTables(QHelpSqlQuery *query)
 {
     const QStringList tables = QStringList()
             << QLatin1String("CREATE TABLE NamespaceTable ("
@@ -475,7 +658,7 @@ bool QHelpCollectionHandler::createTables(QSqlQuery *query)
     return true;
 }
 
-bool QHelpCollectionHandler::recreateIndexAndNamespaceFilterTables(QSqlQuery *query)
+bool QHelpCollectionHandler::recreateIndexAndNamespaceFilterTables(QHelpSqlQuery *query)
 {
     const QStringList tables = QStringList()
             << QLatin1String("DROP TABLE IF EXISTS FileNameTable")
@@ -673,6 +856,8 @@ QHelpFilterData QHelpCollectionHandler::filterData(const QString &filterName) co
 bool QHelpCollectionHandler::setFilterData(const QString &filterName,
                                            const QHelpFilterData &filterData)
 {
+    clearFilterCache();
+    ++m_dataRevision;
     if (!removeFilter(filterName))
         return false;
 
@@ -718,6 +903,8 @@ bool QHelpCollectionHandler::setFilterData(const QString &filterName,
 
 bool QHelpCollectionHandler::removeFilter(const QString &filterName)
 {
+    clearFilterCache();
+    ++m_dataRevision;
     m_query->prepare(QLatin1String("SELECT FilterId "
                                    "FROM Filter "
                                    "WHERE Name = ?"));
@@ -844,24 +1031,24 @@ QHelpCollectionHandler::FileInfo QHelpCollectionHandler::registeredDocumentation
     if (!m_query)
         return fileInfo;
 
-    m_query->prepare(QLatin1String("SELECT "
-                                       "NamespaceTable.Name, "
-                                       "NamespaceTable.FilePath, "
-                                       "FolderTable.Name "
-                                   "FROM "
-                                       "NamespaceTable, "
-                                       "FolderTable "
-                                   "WHERE NamespaceTable.Id = FolderTable.NamespaceId "
-                                   "AND NamespaceTable.Name = ? LIMIT 1"));
-    m_query->bindValue(0, namespaceName);
-    if (!m_query->exec() || !m_query->next())
+    QHelpSqlQuery *query = preparedQuery(QLatin1String("SELECT "
+                                                           "NamespaceTable.Name, "
+                                                           "NamespaceTable.FilePath, "
+                                                           "FolderTable.Name "
+                                                       "FROM "
+                                                           "NamespaceTable, "
+                                                           "FolderTable "
+                                                       "WHERE NamespaceTable.Id = FolderTable.NamespaceId "
+                                                       "AND NamespaceTable.Name = ? LIMIT 1"));
+    query->bindValue(0, namespaceName);
+    if (!query->exec() || !query->next())
         return fileInfo;
 
-    fileInfo.namespaceName = m_query->value(0).toString();
-    fileInfo.fileName = m_query->value(1).toString();
-    fileInfo.folderName = m_query->value(2).toString();
+    fileInfo.namespaceName = query->value(0).toString();
+    fileInfo.fileName = query->value(1).toString();
+    fileInfo.folderName = query->value(2).toString();
 
-    m_query->clear();
+    query->finish();
 
     return fileInfo;
 }
@@ -892,38 +1079,132 @@ QHelpCollectionHandler::FileInfoList QHelpCollectionHandler::registeredDocumenta
     return list;
 }
 
+struct QHelpCollectionHandler::DocumentationData
+{
+    QString fileName;
+    bool opened = false;
+    QString namespaceName;
+    QString virtualFolder;
+    QString version;
+    QList<QStringList> filterAttributeSets;
+    QList<QPair<QString, QStringList>> customFilters;
+    QHelpDBReader::IndexTable indexTable;
+};
+
+// Reads everything registerDocumentation() needs from the .qch file. This
+// does not touch the collection, so it may run on any thread.
+void QHelpCollectionHandler::readDocumentation(DocumentationData *data,
+                                               const QString &connectionName)
+{
+    QHelpDBReader reader(data->fileName, connectionName, nullptr);
+    data->opened = reader.init();
+    if (!data->opened)
+        return;
+
+    data->namespaceName = reader.namespaceName();
+    if (data->namespaceName.isEmpty())
+        return;
+
+    data->virtualFolder = reader.virtualFolder();
+    data->version = reader.version();
+    data->filterAttributeSets = reader.filterAttributeSets();
+    for (const QString &filterName : reader.customFilters())
+        data->customFilters.append(qMakePair(filterName, reader.filterAttributes(filterName)));
+    data->indexTable = reader.indexTable();
+}
+
 bool QHelpCollectionHandler::registerDocumentation(const QString &fileName)
 {
     if (!isDBOpened())
         return false;
 
-    QHelpDBReader reader(fileName, QHelpGlobal::uniquifyConnectionName(
-        QLatin1String("QHelpCollectionHandler"), this), nullptr);
-    if (!reader.init()) {
-        emit error(tr("Cannot open documentation file %1.").arg(fileName));
+    DocumentationData data;
+    data.fileName = fileName;
+    readDocumentation(&data, QHelpGlobal::uniquifyConnectionName(
+        QLatin1String("QHelpCollectionHandler"), this));
+    return registerDocumentation(data);
+}
+
+bool QHelpCollectionHandler::registerDocumentations(const QStringList &fileNames)
+{
+    if (!isDBOpened())
+        return false;
+
+    if (fileNames.isEmpty())
+        return true;
+
+    // The .qch files are read in parallel, one batch at a time, so that only
+    // a bounded number of index tables is in memory. All of them are
+    // inserted into the collection within a single transaction; a savepoint
+    // per file keeps a broken file from leaving half of its data behind.
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const size_t threadCount = size_t(std::max(1, pool->maxThreadCount()));
+    Transaction transaction(m_connectionName);
+    bool ok = true;
+
+    const size_t fileCount = size_t(fileNames.size());
+    for (size_t batchStart = 0; batchStart < fileCount; batchStart += threadCount) {
+        const size_t batchSize = std::min(threadCount, fileCount - batchStart);
+        std::vector<DocumentationData> batch(batchSize);
+        for (size_t i = 0; i < batchSize; ++i)
+            batch[i].fileName = fileNames.at(qsizetype(batchStart + i));
+
+        QSemaphore done;
+        for (size_t i = 0; i < batchSize; ++i) {
+            pool->start([this, &batch, &done, i]() {
+                readDocumentation(&batch[i], QHelpGlobal::uniquifyConnectionName(
+                    QLatin1String("QHelpCollectionHandler"), this));
+                done.release();
+            });
+        }
+        done.acquire(int(batchSize));
+
+        for (const DocumentationData &data : batch) {
+            m_query->exec(QLatin1String("SAVEPOINT registerDocumentation"));
+            if (!registerDocumentation(data)) {
+                m_query->exec(QLatin1String("ROLLBACK TO registerDocumentation"));
+                clearFilterCache();
+                ok = false;
+            }
+            m_query->exec(QLatin1String("RELEASE registerDocumentation"));
+        }
+    }
+
+    transaction.commit();
+    return ok;
+}
+
+bool QHelpCollectionHandler::registerDocumentation(const DocumentationData &data)
+{
+    clearFileDataCache();
+    clearFilterCache();
+    ++m_dataRevision;
+
+    if (!data.opened) {
+        emit error(tr("Cannot open documentation file %1.").arg(data.fileName));
         return false;
     }
 
-    const QString &ns = reader.namespaceName();
+    const QString &ns = data.namespaceName;
     if (ns.isEmpty()) {
-        emit error(tr("Invalid documentation file \"%1\".").arg(fileName));
+        emit error(tr("Invalid documentation file \"%1\".").arg(data.fileName));
         return false;
     }
 
-    const int nsId = registerNamespace(ns, fileName);
+    const int nsId = registerNamespace(ns, data.fileName);
     if (nsId < 1)
         return false;
 
-    const int vfId = registerVirtualFolder(reader.virtualFolder(), nsId);
+    const int vfId = registerVirtualFolder(data.virtualFolder, nsId);
     if (vfId < 1)
         return false;
 
-    registerVersion(reader.version(), nsId);
-    registerFilterAttributes(reader.filterAttributeSets(), nsId); // qset, what happens when removing documentation?
-    for (const QString &filterName : reader.customFilters())
-        addCustomFilter(filterName, reader.filterAttributes(filterName));
+    registerVersion(data.version, nsId);
+    registerFilterAttributes(data.filterAttributeSets, nsId); // qset, what happens when removing documentation?
+    for (const auto &customFilter : data.customFilters)
+        addCustomFilter(customFilter.first, customFilter.second);
 
-    if (!registerIndexTable(reader.indexTable(), nsId, vfId, registeredDocumentation(ns).fileName))
+    if (!registerIndexTable(data.indexTable, nsId, vfId, registeredDocumentation(ns).fileName))
         return false;
 
     return true;
@@ -934,6 +1215,10 @@ bool QHelpCollectionHandler::unregisterDocumentation(const QString &namespaceNam
     if (!isDBOpened())
         return false;
 
+    clearFileDataCache();
+    clearFilterCache();
+    ++m_dataRevision;
+
     m_query->prepare(QLatin1String("SELECT Id FROM NamespaceTable WHERE Name = ?"));
     m_query->bindValue(0, namespaceName);
     m_query->exec();
@@ -1090,6 +1375,61 @@ static void bindFilterQuery(QSqlQuery *query, int bindStart, const QString &filt
     query->bindValue(bindStart + 4, filterName);
 }
 
+/*
+  Resolves the namespaces passing the filter once and returns a
+  condition on their ids, instead of repeating the component and
+  version joins of prepareFilterQuery() in every query.
+ */
+QString QHelpCollectionHandler::filterNamespaceQuery(const QString &filterName) const
+{
+    if (filterName.isEmpty())
+        return QString();
+
+    ReadCache *cache = readCache();
+    auto it = cache->filterNamespaceQueries.constFind(filterName);
+    if (it != cache->filterNamespaceQueries.constEnd())
+        return it.value();
+
+    QHelpSqlQuery query(QSqlDatabase::database(cache->connectionName), &m_queryStatistics);
+    query.prepare(QLatin1String("SELECT NamespaceTable.Id FROM NamespaceTable WHERE TRUE")
+                  + prepareFilterQuery(filterName));
+    bindFilterQuery(&query, 0, filterName);
+
+    QStringList ids;
+    if (query.exec()) {
+        while (query.next())
+            ids.append(query.value(0).toString());
+    }
+
+    const QString condition = ids.isEmpty()
+            ? QString::fromLatin1(" AND FALSE")
+            : QLatin1String(" AND NamespaceTable.Id IN (")
+              + ids.join(QLatin1Char(',')) + QLatin1Char(')');
+    cache->filterNamespaceQueries.insert(filterName, condition);
+    return condition;
+}
+
+QHelpSqlQuery *QHelpCollectionHandler::preparedQuery(const QString &queryString) const
+{
+    ReadCache *cache = readCache();
+    if (QHelpSqlQuery *query = cache->preparedQueries.value(queryString))
+        return query;
+
+    if (cache->preparedQueries.size() >= 32)
+        cache->clearQueries();
+
+    QHelpSqlQuery *query = new QHelpSqlQuery(QSqlDatabase::database(cache->connectionName),
+                                             &m_queryStatistics);
+    query->prepare(queryString);
+    cache->preparedQueries.insert(queryString, query);
+    return query;
+}
+
+void QHelpCollectionHandler::clearFilterCache() const
+{
+    m_readCache->clearQueries();
+}
+
 static QString prepareFilterQuery(int attributesCount,
                                   const QString &idTableName,
                                   const QString &idColumnName,
@@ -1225,19 +1565,18 @@ QString QHelpCollectionHandler::namespaceForFile(const QUrl &url,
                 "AND FolderTable.NamespaceId = NamespaceTable.Id");
 
     const QString filterQuery = filterlessQuery
-            + prepareFilterQuery(filterName);
+            + filterNamespaceQuery(filterName);
 
-    m_query->prepare(filterQuery);
-    m_query->bindValue(0, fileInfo.folderName);
-    m_query->bindValue(1, fileInfo.fileName);
-    bindFilterQuery(m_query, 2, filterName);
+    QHelpSqlQuery *query = preparedQuery(filterQuery);
+    query->bindValue(0, fileInfo.folderName);
+    query->bindValue(1, fileInfo.fileName);
 
-    if (!m_query->exec())
+    if (!query->exec())
         return QString();
 
     QList<QString> namespaceList;
-    while (m_query->next())
-        namespaceList.append(m_query->value(0).toString());
+    while (query->next())
+        namespaceList.append(query->value(0).toString());
 
     if (namespaceList.isEmpty())
         return QString();
@@ -1329,26 +1668,21 @@ QStringList QHelpCollectionHandler::files(const QString &namespaceName,
                 "AND NamespaceTable.Name = ?") + extensionQuery;
 
     const QString filterQuery = filterlessQuery
-            + prepareFilterQuery(filterName);
+            + filterNamespaceQuery(filterName);
 
-    m_query->prepare(filterQuery);
-    m_query->bindValue(0, namespaceName);
-    int bindCount = 1;
-    if (!extensionFilter.isEmpty()) {
-        m_query->bindValue(bindCount, QString::fromLatin1("%.%1").arg(extensionFilter));
-        ++bindCount;
-    }
-
-    bindFilterQuery(m_query, bindCount, filterName);
+    QHelpSqlQuery *query = preparedQuery(filterQuery);
+    query->bindValue(0, namespaceName);
+    if (!extensionFilter.isEmpty())
+        query->bindValue(1, QString::fromLatin1("%.%1").arg(extensionFilter));
 
-    if (!m_query->exec())
+    if (!query->exec())
         return QStringList();
 
     QStringList fileNames;
-    while (m_query->next()) {
-        fileNames.append(m_query->value(0).toString()
+    while (query->next()) {
+        fileNames.append(query->value(0).toString()
                          + QLatin1Char('/')
-                         + m_query->value(1).toString());
+                         + query->value(1).toString());
     }
 
     return fileNames;
@@ -1387,21 +1721,58 @@ QByteArray QHelpCollectionHandler::fileData(const QUrl &url) const
     if (!isDBOpened())
         return QByteArray();
 
-    const QString namespaceName = namespaceForFile(url, QString());
+    const FileInfo fileInfo = extractFileInfo(url);
+    if (fileInfo.namespaceName.isEmpty())
+        return QByteArray();
+
+    // The namespace a file resolves to only changes when documentation
+    // gets (un)registered, which clears this cache.
+    const QString key = fileInfo.namespaceName + QLatin1Char('/')
+            + fileInfo.folderName + QLatin1Char('/') + fileInfo.fileName;
+    QHash<QString, QString> &fileDataNamespaces = readCache()->fileDataNamespaces;
+    auto it = fileDataNamespaces.constFind(key);
+    if (it == fileDataNamespaces.constEnd()) {
+        if (fileDataNamespaces.size() >= 4096)
+            fileDataNamespaces.clear();
+        it = fileDataNamespaces.insert(key, namespaceForFile(url, QString()));
+    }
+    const QString &namespaceName = it.value();
     if (namespaceName.isEmpty())
         return QByteArray();
 
-    const FileInfo fileInfo = extractFileInfo(url);
+    QHelpDBReader *reader = fileDataReader(namespaceName);
+    if (!reader)
+        return QByteArray();
+
+    return reader->fileData(fileInfo.folderName, fileInfo.fileName);
+}
+
+QHelpDBReader *QHelpCollectionHandler::fileDataReader(const QString &namespaceName) const
+{
+    ReadCache *cache = readCache();
+    if (QHelpDBReader *reader = cache->fileDataReaders.value(namespaceName))
+        return reader;
 
     const FileInfo docInfo = registeredDocumentation(namespaceName);
-    const QString absFileName = absoluteDocPath(docInfo.fileName);
+    if (docInfo.fileName.isEmpty())
+        return nullptr;
 
-    QHelpDBReader reader(absFileName, QHelpGlobal::uniquifyConnectionName(
-                             docInfo.fileName, const_cast<QHelpCollectionHandler *>(this)), nullptr);
-    if (!reader.init())
-        return QByteArray();
+    // Without a parent, as the reader may belong to another thread.
+    QHelpDBReader *reader = new QHelpDBReader(absoluteDocPath(docInfo.fileName),
+            QHelpGlobal::uniquifyConnectionName(docInfo.fileName, cache), nullptr);
+    reader->setQueryStatistics(&m_queryStatistics);
+    if (!reader->init()) {
+        delete reader;
+        return nullptr;
+    }
 
-    return reader.fileData(fileInfo.folderName, fileInfo.fileName);
+    cache->fileDataReaders.insert(namespaceName, reader);
+    return reader;
+}
+
+void QHelpCollectionHandler::clearFileDataCache() const
+{
+    m_readCache->clearFileData();
 }
 
 QStringList QHelpCollectionHandler::indicesForFilter(const QStringList &filterAttributes) const
@@ -1464,16 +1835,15 @@ QStringList QHelpCollectionHandler::indicesForFilter(const QString &filterName)
                 "AND IndexTable.NamespaceId = NamespaceTable.Id");
 
     const QString filterQuery = filterlessQuery
-            + prepareFilterQuery(filterName)
+            + filterNamespaceQuery(filterName)
             + QLatin1String(" ORDER BY LOWER(IndexTable.Name), IndexTable.Name");
 
-    m_query->prepare(filterQuery);
-    bindFilterQuery(m_query, 0, filterName);
+    QHelpSqlQuery *query = preparedQuery(filterQuery);
 
-    m_query->exec();
+    query->exec();
 
-    while (m_query->next())
-        indices.append(m_query->value(0).toString());
+    while (query->next())
+        indices.append(query->value(0).toString());
 
     return indices;
 }
@@ -1581,26 +1951,25 @@ QList<QHelpCollectionHandler::ContentsData> QHelpCollectionHandler::contentsForF
                 "AND VersionTable.NamespaceId = NamespaceTable.Id");
 
     const QString filterQuery = filterlessQuery
-            + prepareFilterQuery(filterName);
+            + filterNamespaceQuery(filterName);
 
-    m_query->prepare(filterQuery);
-    bindFilterQuery(m_query, 0, filterName);
+    QHelpSqlQuery *query = preparedQuery(filterQuery);
 
-    m_query->exec();
+    query->exec();
 
     QMap<QString, QMap<QVersionNumber, ContentsData>> contentsMap;
 
-    while (m_query->next()) {
-        const QString namespaceName = m_query->value(0).toString();
-        const QByteArray contents = m_query->value(2).toByteArray();
-        const QString versionString = m_query->value(3).toString();
+    while (query->next()) {
+        const QString namespaceName = query->value(0).toString();
+        const QByteArray contents = query->value(2).toByteArray();
+        const QString versionString = query->value(3).toString();
 
         const QString title = getTitle(contents);
         const QVersionNumber version = QVersionNumber::fromString(versionString);
         // get existing or insert a new one otherwise
         ContentsData &contentsData = contentsMap[title][version];
         contentsData.namespaceName = namespaceName;
-        contentsData.folderName = m_query->value(1).toString();
+        contentsData.folderName = query->value(1).toString();
         contentsData.contentsList.append(contents);
     }
 
@@ -1817,19 +2186,19 @@ QString QHelpCollectionHandler::namespaceVersion(const QString &namespaceName) c
     if (!m_query)
         return QString();
 
-    m_query->prepare(QLatin1String("SELECT "
-                                       "VersionTable.Version "
-                                   "FROM "
-                                       "NamespaceTable, "
-                                       "VersionTable "
-                                   "WHERE NamespaceTable.Name = ? "
-                                   "AND NamespaceTable.Id = VersionTable.NamespaceId"));
-    m_query->bindValue(0, namespaceName);
-    if (!m_query->exec() || !m_query->next())
+    QHelpSqlQuery *query = preparedQuery(QLatin1String("SELECT "
+                                                           "VersionTable.Version "
+                                                       "FROM "
+                                                           "NamespaceTable, "
+                                                           "VersionTable "
+                                                       "WHERE NamespaceTable.Name = ? "
+                                                       "AND NamespaceTable.Id = VersionTable.NamespaceId"));
+    query->bindValue(0, namespaceName);
+    if (!query->exec() || !query->next())
         return QString();
 
-    const QString ret = m_query->value(0).toString();
-    m_query->clear();
+    const QString ret = query->value(0).toString();
+    query->finish();
 
     return ret;
 }
@@ -1840,6 +2209,8 @@ int QHelpCollectionHandler::registerNamespace(const QString &nspace, const QStri
     if (!m_query)
         return errorValue;
 
+    clearFilterCache();
+
     m_query->prepare(QLatin1String("SELECT COUNT(Id) FROM NamespaceTable WHERE Name=?"));
     m_query->bindValue(0, nspace);
     m_query->exec();
@@ -1893,6 +2264,7 @@ int QHelpCollectionHandler::registerVirtualFolder(const QString &folderName, int
 
 int QHelpCollectionHandler::registerComponent(const QString &componentName, int namespaceId)
 {
+    clearFilterCache();
     m_query->prepare(QLatin1String("SELECT ComponentId FROM ComponentTable WHERE Name = ?"));
     m_query->bindValue(0, componentName);
     if (!m_query->exec())
@@ -1926,6 +2298,8 @@ bool QHelpCollectionHandler::registerVersion(const QString &version, int namespa
     if (!m_query)
         return false;
 
+    clearFilterCache();
+
     m_query->prepare(QLatin1String("INSERT INTO VersionTable "
                                    "(NamespaceId, Version) "
                                    "VALUES(?, ?)"));
@@ -2473,24 +2847,23 @@ QList<QHelpLink> QHelpCollectionHandler::documentsForField(
                 "AND IndexTable.%1 = ?").arg(fieldName);
 
     const QString filterQuery = filterlessQuery
-            + prepareFilterQuery(filterName)
+            + filterNamespaceQuery(filterName)
             + QLatin1String(" ORDER BY LOWER(FileNameTable.Title), FileNameTable.Title");
 
-    m_query->prepare(filterQuery);
-    m_query->bindValue(0, fieldValue);
-    bindFilterQuery(m_query, 1, filterName);
+    QHelpSqlQuery *query = preparedQuery(filterQuery);
+    query->bindValue(0, fieldValue);
 
-    m_query->exec();
+    query->exec();
 
-    while (m_query->next()) {
-        QString title = m_query->value(0).toString();
+    while (query->next()) {
+        QString title = query->value(0).toString();
         if (title.isEmpty()) // generate a title + corresponding path
-            title = fieldValue + QLatin1String(" : ") + m_query->value(3).toString();
+            title = fieldValue + QLatin1String(" : ") + query->value(3).toString();
 
-        const QUrl url = buildQUrl(m_query->value(1).toString(),
-                                   m_query->value(2).toString(),
-                                   m_query->value(3).toString(),
-                                   m_query->value(4).toString());
+        const QUrl url = buildQUrl(query->value(1).toString(),
+                                   query->value(2).toString(),
+                                   query->value(3).toString(),
+                                   query->value(4).toString());
         docList.append(QHelpLink {url, title});
     }
     return docList;
@@ -2511,15 +2884,14 @@ QStringList QHelpCollectionHandler::namespacesForFilter(const QString &filterNam
                 "WHERE TRUE");
 
     const QString filterQuery = filterlessQuery
-            + prepareFilterQuery(filterName);
+            + filterNamespaceQuery(filterName);
 
-    m_query->prepare(filterQuery);
-    bindFilterQuery(m_query, 0, filterName);
+    QHelpSqlQuery *query = preparedQuery(filterQuery);
 
-    m_query->exec();
+    query->exec();
 
-    while (m_query->next())
-        namespaceList.append(m_query->value(0).toString());
+    while (query->next())
+        namespaceList.append(query->value(0).toString());
 
     return namespaceList;
 }
@@ -51,7 +51,9 @@
 // We mean it.
 //
 
+#include <QtCore/QHash>
 #include <QtCore/QList>
+#include <QtCore/QMutex>
 #include <QtCore/QString>
 #include <QtCore/QObject>
 #include <QtCore/QVariant>
@@ -61,9 +63,14 @@
 
 #include "qhelpdbreader_p.h"
 #include "qhelplink.h"
+#include "qhelpsqlquery_p.h"
+
+#include <atomic>
+#include <memory>
 
 QT_BEGIN_NAMESPACE
 
+class QThread;
 class QVersionNumber;
 class QHelpFilterData;
 
@@ -101,6 +108,7 @@ public:
     ~QHelpCollectionHandler();
 
     QString collectionFile() const;
+    QByteArray stateHash() const;
 
     bool openCollectionFile();
     bool copyCollectionFile(const QString &fileName);
@@ -176,6 +184,7 @@ public:
     FileInfo registeredDocumentation(const QString &namespaceName) const;
     FileInfoList registeredDocumentations() const;
     bool registerDocumentation(const QString &fileName);
+    bool registerDocumentations(const QStringList &fileNames);
     bool unregisterDocumentation(const QString &namespaceName);
 
 
@@ -216,10 +225,20 @@ public:
 
     void setReadOnly(bool readOnly);
 
+    // Bumped whenever filters or registered documentation change.
+    quint64 dataRevision() const { return m_dataRevision.load(std::memory_order_acquire); }
+
+    const QHelpQueryStatistics &queryStatistics() const { return m_queryStatistics; }
+    void resetQueryStatistics() { m_queryStatistics.reset(); }
+
 signals:
     void error(const QString &msg) const;
 
 private:
+    struct DocumentationData;
+    struct ReadCache;
+    struct ThreadReadCaches;
+
     // legacy stuff
     QMultiMap<QString, QUrl> linksForField(const QString &fieldName,
                                            const QString &fieldValue,
@@ -236,9 +255,9 @@ private:
                                        const QString &filterName) const;
 
     bool isDBOpened() const;
-    bool createTables(QSqlQuery *query);
+    bool createTables(QHelpSqlQuery *query);
     void closeDB();
-    bool recreateIndexAndNamespaceFilterTables(QSqlQuery *query);
+    bool recreateIndexAndNamespaceFilterTables(QHelpSqlQuery *query);
     bool registerIndexAndNamespaceFilterTables(const QString &nameSpace,
                                                bool createDefaultVersionFilter = false);
     void createVersionFilter(const QString &version);
@@ -247,15 +266,30 @@ private:
     bool registerIndexTable(const QHelpDBReader::IndexTable &indexTable,
                             int nsId, int vfId, const QString &fileName);
     bool unregisterIndexTable(int nsId, int vfId);
+    static void readDocumentation(DocumentationData *data, const QString &connectionName);
+    bool registerDocumentation(const DocumentationData &data);
     QString absoluteDocPath(const QString &fileName) const;
     bool isTimeStampCorrect(const TimeStamp &timeStamp) const;
     bool hasTimeStampInfo(const QString &nameSpace) const;
     void scheduleVacuum();
     void execVacuum();
+    QHelpDBReader *fileDataReader(const QString &namespaceName) const;
+    void clearFileDataCache() const;
+    QString filterNamespaceQuery(const QString &filterName) const;
+    QHelpSqlQuery *preparedQuery(const QString &queryString) const;
+    void clearFilterCache() const;
+    ReadCache *readCache() const;
 
     QString m_collectionFile;
     QString m_connectionName;
-    QSqlQuery *m_query = nullptr;
+    QHelpSqlQuery *m_query = nullptr;
+    // Cache of the thread the handler lives in; other threads reading
+    // through the thread-safe functions get one of their own.
+    ReadCache *m_readCache;
+    const std::shared_ptr<ThreadReadCaches> m_threadReadCaches;
+    const quint64 m_serial;
+    mutable QHelpQueryStatistics m_queryStatistics;
+    std::atomic<quint64> m_dataRevision{0};
     bool m_vacuumScheduled = false;
     bool m_readOnly = true;
 };
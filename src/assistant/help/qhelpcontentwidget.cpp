@@ -43,6 +43,9 @@
 #include "qhelpcollectionhandler_p.h"
 
 #include <QDir>
+#include <QtCore/QDataStream>
+#include <QtCore/QHash>
+#include <QtCore/QSharedPointer>
 #include <QtCore/QStack>
 #include <QtCore/QThread>
 #include <QtCore/QMutex>
@@ -50,22 +53,66 @@
 
 QT_BEGIN_NAMESPACE
 
-class QHelpContentItemPrivate
+// The decoded contents of all namespaces in one flat array. Items are
+// only created for nodes whose parent has been asked for its children.
+class QHelpContentsTree
 {
 public:
-    QHelpContentItemPrivate(const QString &t, const QUrl &l, QHelpContentItem *p)
-        : parent(p),
-          title(t),
-          link(l)
+    struct Node
+    {
+        QString title;
+        QString link;
+        int source = -1;
+        int firstChild = -1;
+        int lastChild = -1;
+        int nextSibling = -1;
+        int childCount = 0;
+    };
+
+    QHelpContentsTree() { nodes.append(Node()); }
+
+    int appendNode(int parent, const QString &title, const QString &link, int source)
     {
+        const int index = nodes.count();
+        Node node;
+        node.title = title;
+        node.link = link;
+        node.source = source;
+        nodes.append(node);
+
+        Node &parentNode = nodes[parent];
+        if (parentNode.lastChild < 0)
+            parentNode.firstChild = index;
+        else
+            nodes[parentNode.lastChild].nextSibling = index;
+        parentNode.lastChild = index;
+        ++parentNode.childCount;
+        return index;
     }
 
-    void appendChild(QHelpContentItem *item) { childItems.append(item); }
+    QUrl url(int node) const;
+
+    void write(QDataStream &s) const;
+    bool read(QDataStream &s);
+
+    // namespace and folder name of each contents source
+    QList<QPair<QString, QString>> sources;
+    QList<Node> nodes; // the first node is the root
+};
+
+class QHelpContentItemPrivate
+{
+public:
+    QHelpContentItemPrivate(QHelpContentItem *p)
+        : parent(p)
+    {
+    }
 
     QList<QHelpContentItem*> childItems;
     QHelpContentItem *parent;
-    QString title;
-    QUrl link;
+    QSharedPointer<const QHelpContentsTree> tree;
+    int node = 0;
+    bool childItemsCreated = false;
 };
 
 class QHelpContentProvider : public QThread
@@ -89,6 +136,11 @@ private:
     QMutex m_mutex;
     bool m_usesFilterEngine = false;
     bool m_abort = false;
+
+    // Contents already built for a filter, valid as long as the
+    // collection state is unchanged.
+    QHash<QString, QSharedPointer<const QHelpContentsTree>> m_treeCache;
+    QByteArray m_treeCacheState;
 };
 
 class QHelpContentModelPrivate
@@ -109,7 +161,9 @@ public:
 
 QHelpContentItem::QHelpContentItem(const QString &name, const QUrl &link, QHelpContentItem *parent)
 {
-    d = new QHelpContentItemPrivate(name, link, parent);
+    Q_UNUSED(name);
+    Q_UNUSED(link);
+    d = new QHelpContentItemPrivate(parent);
 }
 
 /*!
@@ -128,6 +182,18 @@ QHelpContentItem::~QHelpContentItem()
 */
 QHelpContentItem *QHelpContentItem::child(int row) const
 {
+    if (!d->childItemsCreated && d->tree) {
+        d->childItemsCreated = true;
+        const QHelpContentsTree::Node &node = d->tree->nodes.at(d->node);
+        d->childItems.reserve(node.childCount);
+        for (int i = node.firstChild; i >= 0; i = d->tree->nodes.at(i).nextSibling) {
+            QHelpContentItem *item = new QHelpContentItem(QString(), QUrl(),
+                                                          const_cast<QHelpContentItem *>(this));
+            item->d->tree = d->tree;
+            item->d->node = i;
+            d->childItems.append(item);
+        }
+    }
     return d->childItems.value(row);
 }
 
@@ -136,7 +202,9 @@ QHelpContentItem *QHelpContentItem::child(int row) const
 */
 int QHelpContentItem::childCount() const
 {
-    return d->childItems.count();
+    if (!d->tree)
+        return d->childItems.count();
+    return d->tree->nodes.at(d->node).childCount;
 }
 
 /*!
@@ -145,7 +213,7 @@ int QHelpContentItem::childCount() const
 int QHelpContentItem::row() const
 {
     if (d->parent)
-        return d->parent->d->childItems.indexOf(const_cast<QHelpContentItem*>(this));
+        return d->parent->childPosition(const_cast<QHelpContentItem*>(this));
     return 0;
 }
 
@@ -154,7 +222,9 @@ int QHelpContentItem::row() const
 */
 QString QHelpContentItem::title() const
 {
-    return d->title;
+    if (!d->tree)
+        return QString();
+    return d->tree->nodes.at(d->node).title;
 }
 
 /*!
@@ -162,7 +232,9 @@ QString QHelpContentItem::title() const
 */
 QUrl QHelpContentItem::url() const
 {
-    return d->link;
+    if (!d->tree || d->node == 0)
+        return QUrl();
+    return d->tree->url(d->node);
 }
 
 /*!
@@ -178,6 +250,8 @@ QHelpContentItem *QHelpContentItem::parent() const
 */
 int QHelpContentItem::childPosition(QHelpContentItem *child) const
 {
+    // Only items that exist can be asked for, so the child items of
+    // this one have been created already.
     return d->childItems.indexOf(child);
 }
 
@@ -255,6 +329,63 @@ static QUrl constructUrl(const QString &namespaceName,
     return buildQUrl(namespaceName, folderName, rp, anchor);
 }
 
+QUrl QHelpContentsTree::url(int node) const
+{
+    const Node &n = nodes.at(node);
+    const QPair<QString, QString> &source = sources.at(n.source);
+    return constructUrl(source.first, source.second, n.link);
+}
+
+void QHelpContentsTree::write(QDataStream &s) const
+{
+    s << qint32(sources.count());
+    for (const auto &source : sources)
+        s << source.first << source.second;
+    s << qint32(nodes.count());
+    for (const Node &node : nodes) {
+        s << node.title << node.link << qint32(node.source) << qint32(node.firstChild)
+          << qint32(node.lastChild) << qint32(node.nextSibling) << qint32(node.childCount);
+    }
+}
+
+bool QHelpContentsTree::read(QDataStream &s)
+{
+    qint32 count = 0;
+    s >> count;
+    if (count < 0 || s.status() != QDataStream::Ok)
+        return false;
+    sources.clear();
+    sources.reserve(count);
+    for (qint32 i = 0; i < count; ++i) {
+        QPair<QString, QString> source;
+        s >> source.first >> source.second;
+        sources.append(source);
+    }
+
+    s >> count;
+    if (count < 1 || s.status() != QDataStream::Ok)
+        return false;
+    nodes.clear();
+    nodes.reserve(count);
+    for (qint32 i = 0; i < count && s.status() == QDataStream::Ok; ++i) {
+        Node node;
+        qint32 source, firstChild, lastChild, nextSibling, childCount;
+        s >> node.title >> node.link >> source >> firstChild >> lastChild
+          >> nextSibling >> childCount;
+        if (source >= sources.count() || firstChild >= count || lastChild >= count
+                || nextSibling >= count) {
+            return false;
+        }
+        node.source = source;
+        node.firstChild = firstChild;
+        node.lastChild = lastChild;
+        node.nextSibling = nextSibling;
+        node.childCount = childCount;
+        nodes.append(node);
+    }
+    return s.status() == QDataStream::Ok;
+}
+
 void QHelpContentProvider::run()
 {
     m_mutex.lock();
@@ -273,11 +404,51 @@ void QHelpContentProvider::run()
     if (!collectionHandler.openCollectionFile())
         return;
 
+    // A tree built before, in this session or stored in a snapshot by an
+    // earlier one, is valid as long as the registered documentation and
+    // the filters are unchanged.
+    const QString cacheKey = usesFilterEngine
+            ? QLatin1String("contents-filter:") + currentFilter
+            : QLatin1String("contents-attributes:") + attributes.join(QLatin1Char('|'));
+    const QByteArray state = collectionHandler.stateHash();
+
+    m_mutex.lock();
+    if (state != m_treeCacheState) {
+        m_treeCache.clear();
+        m_treeCacheState = state;
+    }
+    QSharedPointer<const QHelpContentsTree> cachedTree = m_treeCache.value(cacheKey);
+    m_mutex.unlock();
+
+    if (!cachedTree) {
+        const QSharedPointer<QHelpContentsTree> snapshot(new QHelpContentsTree);
+        if (QHelpEnginePrivate::readViewSnapshot(collectionFile, cacheKey, state,
+                                                 [&snapshot](QDataStream &s) {
+                                                     return snapshot->read(s);
+                                                 })) {
+            cachedTree = snapshot;
+            m_mutex.lock();
+            m_treeCache.insert(cacheKey, cachedTree);
+            m_mutex.unlock();
+        }
+    }
+
+    if (cachedTree) {
+        QHelpContentItem * const rootItem = new QHelpContentItem(QString(), QString(), nullptr);
+        rootItem->d->tree = cachedTree;
+
+        m_mutex.lock();
+        m_rootItem = rootItem;
+        m_abort = false;
+        m_mutex.unlock();
+        return;
+    }
+
     QString title;
     QString link;
     int depth = 0;
-    QHelpContentItem *item = nullptr;
-    QHelpContentItem * const rootItem = new QHelpContentItem(QString(), QString(), nullptr);
+    int item = 0;
+    const QSharedPointer<QHelpContentsTree> tree(new QHelpContentsTree);
 
     const QList<QHelpCollectionHandler::ContentsData> result = usesFilterEngine
             ? collectionHandler.contentsForFilter(currentFilter)
@@ -286,22 +457,21 @@ void QHelpContentProvider::run()
     for (const auto &contentsData : result) {
         m_mutex.lock();
         if (m_abort) {
-            delete rootItem;
             m_abort = false;
             m_mutex.unlock();
             return;
         }
         m_mutex.unlock();
 
-        const QString namespaceName = contentsData.namespaceName;
-        const QString folderName = contentsData.folderName;
+        const int source = tree->sources.count();
+        tree->sources.append(qMakePair(contentsData.namespaceName, contentsData.folderName));
         for (const QByteArray &contents : contentsData.contentsList)  {
             if (contents.size() < 1)
                 continue;
 
             int _depth = 0;
             bool _root = false;
-            QStack<QHelpContentItem*> stack;
+            QStack<int> stack;
 
             QDataStream s(contents);
             for (;;) {
@@ -310,13 +480,9 @@ void QHelpContentProvider::run()
                 s >> title;
                 if (title.isEmpty())
                     break;
-                const QUrl url = constructUrl(namespaceName, folderName, link);
 CHECK_DEPTH:
                 if (depth == 0) {
-                    m_mutex.lock();
-                    item = new QHelpContentItem(title, url, rootItem);
-                    rootItem->d->appendChild(item);
-                    m_mutex.unlock();
+                    item = tree->appendNode(0, title, link, source);
                     stack.push(item);
                     _depth = 1;
                     _root = true;
@@ -326,8 +492,7 @@ CHECK_DEPTH:
                         stack.push(item);
                     }
                     if (depth == _depth) {
-                        item = new QHelpContentItem(title, url, stack.top());
-                        stack.top()->d->appendChild(item);
+                        item = tree->appendNode(stack.top(), title, link, source);
                     } else if (depth < _depth) {
                         stack.pop();
                         --_depth;
@@ -338,10 +503,19 @@ CHECK_DEPTH:
         }
     }
 
+    QHelpContentItem * const rootItem = new QHelpContentItem(QString(), QString(), nullptr);
+    rootItem->d->tree = tree;
+
     m_mutex.lock();
+    if (m_treeCache.size() >= 8)
+        m_treeCache.clear();
+    m_treeCache.insert(cacheKey, tree);
     m_rootItem = rootItem;
     m_abort = false;
     m_mutex.unlock();
+
+    QHelpEnginePrivate::writeViewSnapshot(collectionFile, cacheKey, state,
+                                          [&tree](QDataStream &s) { tree->write(s); });
 }
 
 /*!
@@ -39,12 +39,12 @@
 
 #include "qhelpdbreader_p.h"
 #include "qhelp_global.h"
+#include "qhelpsqlquery_p.h"
 
 #include <QtCore/QFile>
 #include <QtCore/QList>
 #include <QtCore/QVariant>
 #include <QtSql/QSqlError>
-#include <QtSql/QSqlQuery>
 
 QT_BEGIN_NAMESPACE
 
@@ -67,6 +67,8 @@ QHelpDBReader::QHelpDBReader(const QString &dbName, const QString &uniqueId,
 QHelpDBReader::~QHelpDBReader()
 {
     if (m_initDone) {
+        delete m_fileDataQuery;
+        delete m_filesDataQuery;
         delete m_query;
         QSqlDatabase::removeDatabase(m_uniqueId);
     }
@@ -86,11 +88,20 @@ bool QHelpDBReader::init()
     }
 
     m_initDone = true;
-    m_query = new QSqlQuery(QSqlDatabase::database(m_uniqueId));
+    m_query = new QHelpSqlQuery(QSqlDatabase::database(m_uniqueId), m_queryStatistics);
 
     return true;
 }
 
+/*
+  Makes the queries of this reader count towards \a statistics.
+  Has to be called before init().
+ */
+void QHelpDBReader::setQueryStatistics(QHelpQueryStatistics *statistics)
+{
+    m_queryStatistics = statistics;
+}
+
 bool QHelpDBReader::initDB()
 {
     QSqlDatabase db = QSqlDatabase::addDatabase(QLatin1String("QSQLITE"), m_uniqueId);
@@ -190,7 +201,7 @@ QString QHelpDBReader::qtVersionHeuristic() const
     return tail;
 }
 
-static bool isAttributeUsed(QSqlQuery *query, const QString &tableName, int attributeId)
+static bool isAttributeUsed(QHelpSqlQuery *query, const QString &tableName, int attributeId)
 {
     query->prepare(QString::fromLatin1("SELECT FilterAttributeId "
                      "FROM %1 "
@@ -201,7 +212,7 @@ static bool isAttributeUsed(QSqlQuery *query, const QString &tableName, int attr
     return query->next(); // if we got a result it means it was used
 }
 
-static int filterDataCount(QSqlQuery *query, const QString &tableName)
+static int filterDataCount(QHelpSqlQuery *query, const QString &tableName)
 {
     query->exec(QString::fromLatin1("SELECT COUNT(*) FROM"
               "(SELECT DISTINCT * FROM %1)").arg(tableName));
@@ -419,8 +430,12 @@ QByteArray QHelpDBReader::fileData(const QString &virtualFolder,
     if (virtualFolder.isEmpty() || filePath.isEmpty() || !m_query)
         return ba;
 
-    namespaceName();
-    m_query->prepare(QLatin1String(
+    // Pages pull in many images and style sheets, so keep the statement
+    // prepared instead of compiling it again for every file.
+    if (!m_fileDataQuery) {
+        m_fileDataQuery = new QHelpSqlQuery(QSqlDatabase::database(m_uniqueId),
+                                            m_queryStatistics);
+        m_fileDataQuery->prepare(QLatin1String(
                     "SELECT "
                         "FileDataTable.Data "
                     "FROM "
@@ -434,13 +449,15 @@ QByteArray QHelpDBReader::fileData(const QString &virtualFolder,
                     "AND FolderTable.Name = ? "
                     "AND FolderTable.NamespaceId = NamespaceTable.Id "
                     "AND NamespaceTable.Name = ?"));
-    m_query->bindValue(0, filePath);
-    m_query->bindValue(1, QString(QLatin1String("./") + filePath));
-    m_query->bindValue(2, virtualFolder);
-    m_query->bindValue(3, m_namespace);
-    m_query->exec();
-    if (m_query->next() && m_query->isValid())
-        ba = qUncompress(m_query->value(0).toByteArray());
+    }
+    m_fileDataQuery->bindValue(0, filePath);
+    m_fileDataQuery->bindValue(1, QString(QLatin1String("./") + filePath));
+    m_fileDataQuery->bindValue(2, virtualFolder);
+    m_fileDataQuery->bindValue(3, namespaceName());
+    m_fileDataQuery->exec();
+    if (m_fileDataQuery->next() && m_fileDataQuery->isValid())
+        ba = qUncompress(m_fileDataQuery->value(0).toByteArray());
+    m_fileDataQuery->finish();
     return ba;
 }
 
@@ -485,15 +502,40 @@ QMultiMap<QString, QByteArray> QHelpDBReader::filesData(const QStringList &filte
                                                         const QString &extensionFilter) const
 {
     QMultiMap<QString, QByteArray> result;
-    if (!m_query)
+    const QStringList extensionFilters = extensionFilter.isEmpty()
+            ? QStringList() : QStringList(extensionFilter);
+    if (!startFilesData(filterAttributes, extensionFilters))
         return result;
 
-    QString query;
+    QString name;
+    QByteArray data;
+    while (nextFileData(&name, &data))
+        result.insert(name, data);
+
+    return result;
+}
+
+/*
+  Starts iterating over the files matching all filter attributes and
+  any of the extensions. nextFileData() then returns them one by one,
+  so only one decompressed file needs to be held at a time.
+ */
+bool QHelpDBReader::startFilesData(const QStringList &filterAttributes,
+                                   const QStringList &extensionFilters) const
+{
+    if (!m_query)
+        return false;
+
     QString extension;
-    if (!extensionFilter.isEmpty())
-        extension = QString(QLatin1String("AND FileNameTable.Name "
-                                          "LIKE \'%.%1\'")).arg(extensionFilter);
+    for (int i = 0; i < extensionFilters.count(); ++i) {
+        extension.append(QLatin1String(i == 0 ? "AND (" : " OR "));
+        extension.append(QString(QLatin1String("FileNameTable.Name LIKE \'%.%1\'"))
+                         .arg(quote(extensionFilters.at(i))));
+    }
+    if (!extension.isEmpty())
+        extension.append(QLatin1Char(')'));
 
+    QString query;
     if (filterAttributes.isEmpty()) {
         query = QString(QLatin1String("SELECT "
                                           "FileNameTable.Name, "
@@ -528,11 +570,28 @@ QMultiMap<QString, QByteArray> QHelpDBReader::filesData(const QStringList &filte
                          .arg(extension));
         }
     }
-    m_query->exec(query);
-    while (m_query->next())
-        result.insert(m_query->value(0).toString(), qUncompress(m_query->value(1).toByteArray()));
 
-    return result;
+    if (!m_filesDataQuery) {
+        m_filesDataQuery = new QHelpSqlQuery(QSqlDatabase::database(m_uniqueId),
+                                             m_queryStatistics);
+        m_filesDataQuery->setForwardOnly(true);
+    }
+    return m_filesDataQuery->exec(query);
+}
+
+bool QHelpDBReader::nextFileData(QString *name, QByteArray *data) const
+{
+    if (!m_filesDataQuery || !m_filesDataQuery->isActive())
+        return false;
+
+    if (!m_filesDataQuery->next()) {
+        m_filesDataQuery->finish();
+        return false;
+    }
+
+    *name = m_filesDataQuery->value(0).toString();
+    *data = qUncompress(m_filesDataQuery->value(1).toByteArray());
+    return true;
 }
 
 QVariant QHelpDBReader::metaData(const QString &name) const
@@ -59,7 +59,8 @@
 
 QT_BEGIN_NAMESPACE
 
-class QSqlQuery;
+class QHelpQueryStatistics;
+class QHelpSqlQuery;
 
 class QHelpDBReader : public QObject
 {
@@ -109,6 +110,7 @@ public:
     ~QHelpDBReader();
 
     bool init();
+    void setQueryStatistics(QHelpQueryStatistics *statistics);
 
     QString namespaceName() const;
     QString virtualFolder() const;
@@ -117,6 +119,9 @@ public:
     QList<QStringList> filterAttributeSets() const;
     QMultiMap<QString, QByteArray> filesData(const QStringList &filterAttributes,
                                              const QString &extensionFilter = QString()) const;
+    bool startFilesData(const QStringList &filterAttributes,
+                        const QStringList &extensionFilters) const;
+    bool nextFileData(QString *name, QByteArray *data) const;
     QByteArray fileData(const QString &virtualFolder,
         const QString &filePath) const;
 
@@ -134,7 +139,10 @@ private:
     QString m_dbName;
     QString m_uniqueId;
     QString m_error;
-    QSqlQuery *m_query = nullptr;
+    QHelpQueryStatistics *m_queryStatistics = nullptr;
+    QHelpSqlQuery *m_query = nullptr;
+    mutable QHelpSqlQuery *m_fileDataQuery = nullptr;
+    mutable QHelpSqlQuery *m_filesDataQuery = nullptr;
     mutable QString m_namespace;
 };
 
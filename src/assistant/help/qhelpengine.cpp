@@ -46,9 +46,13 @@
 #include "qhelpcollectionhandler_p.h"
 #include "qhelpfilterengine.h"
 
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
+#include <QtCore/QFileInfo>
 #include <QtCore/QPluginLoader>
+#include <QtCore/QSaveFile>
 #include <QtCore/QTimer>
 #include <QtWidgets/QApplication>
 #include <QtSql/QSqlQuery>
@@ -73,6 +77,84 @@ void QHelpEnginePrivate::init(const QString &collectionFile,
             this, &QHelpEnginePrivate::scheduleApplyCurrentFilter);
 }
 
+static const quint32 ViewSnapshotMagic = 0x51484356; // "QHCV"
+static const quint32 ViewSnapshotVersion = 1;
+
+// The snapshots live in the same folder as the full text search index.
+static QString viewSnapshotFileName(const QString &collectionFile, const QString &name)
+{
+    const QFileInfo fi(collectionFile);
+    const QString folder = fi.absolutePath() + QDir::separator() + QLatin1Char('.')
+            + fi.fileName().left(fi.fileName().lastIndexOf(QLatin1String(".qhc")));
+    const QByteArray id = QCryptographicHash::hash(name.toUtf8(), QCryptographicHash::Sha1);
+    return folder + QDir::separator() + QLatin1String("view-")
+            + QString::fromLatin1(id.toHex().left(16)) + QLatin1String(".cache");
+}
+
+/*
+    Reads the snapshot stored as \a name for \a collectionFile by calling
+    \a read on it, if it was written for the collection \a state. The
+    file is memory-mapped, so it does not have to be read as a whole
+    before \a read can start.
+*/
+bool QHelpEnginePrivate::readViewSnapshot(const QString &collectionFile, const QString &name,
+                                          const QByteArray &state,
+                                          const std::function<bool(QDataStream &)> &read)
+{
+    if (collectionFile.isEmpty() || state.isEmpty())
+        return false;
+
+    QFile file(viewSnapshotFileName(collectionFile, name));
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QByteArray data;
+    if (const uchar *mapped = file.size() > 0 ? file.map(0, file.size()) : nullptr)
+        data = QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), file.size());
+    else
+        data = file.readAll();
+
+    QDataStream s(data);
+    s.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString storedName;
+    QByteArray storedState;
+    s >> magic >> version;
+    if (magic != ViewSnapshotMagic || version != ViewSnapshotVersion)
+        return false;
+    s >> storedName >> storedState;
+    if (storedName != name || storedState != state)
+        return false;
+    return read(s) && s.status() == QDataStream::Ok;
+}
+
+/*
+    Stores what \a write puts into the stream as the snapshot \a name
+    for \a collectionFile in the collection \a state. Failures are
+    ignored; the data is built from the collection again next time.
+*/
+void QHelpEnginePrivate::writeViewSnapshot(const QString &collectionFile, const QString &name,
+                                           const QByteArray &state,
+                                           const std::function<void(QDataStream &)> &write)
+{
+    if (collectionFile.isEmpty() || state.isEmpty())
+        return;
+
+    const QString fileName = viewSnapshotFileName(collectionFile, name);
+    QDir().mkpath(QFileInfo(fileName).absolutePath());
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream s(&file);
+    s.setVersion(QDataStream::Qt_6_0);
+    s << ViewSnapshotMagic << ViewSnapshotVersion << name << state;
+    write(s);
+    if (s.status() == QDataStream::Ok)
+        file.commit();
+}
+
 void QHelpEnginePrivate::scheduleApplyCurrentFilter()
 {
     if (!error.isEmpty())
@@ -51,13 +51,19 @@
 // We mean it.
 //
 
+#include <QtCore/QCache>
 #include <QtCore/QHash>
 #include <QtCore/QMap>
+#include <QtCore/QMutex>
 #include <QtCore/QStringList>
+#include <QtCore/QUrl>
 #include <QtCore/QObject>
 
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 
+class QDataStream;
 class QSqlQuery;
 
 class QHelpEngineCore;
@@ -81,6 +87,7 @@ public:
         QHelpEngineCore *helpEngineCore);
 
     bool setup();
+    void clearFileDataCache();
 
     QHelpCollectionHandler *collectionHandler = nullptr;
     QHelpFilterEngine *filterEngine = nullptr;
@@ -91,6 +98,13 @@ public:
     bool usesFilterEngine = false;
     bool readOnly = true;
 
+    // Decompressed file data, with the size in bytes as the cost.
+    // Guarded by the mutex, as fileData() may be called from any thread.
+    QMutex fileDataCacheMutex;
+    QCache<QUrl, QByteArray> fileDataCache{32 * 1024 * 1024};
+    qint64 fileDataCacheHits = 0;
+    qint64 fileDataCacheMisses = 0;
+
 protected:
     QHelpEngineCore *q;
 
@@ -114,6 +128,15 @@ public:
 
     QHelpSearchEngine *searchEngine = nullptr;
 
+    // Snapshots of the contents and index built for a filter, so that
+    // they are available right away when the collection is opened again.
+    static bool readViewSnapshot(const QString &collectionFile, const QString &name,
+                                 const QByteArray &state,
+                                 const std::function<bool(QDataStream &)> &read);
+    static void writeViewSnapshot(const QString &collectionFile, const QString &name,
+                                  const QByteArray &state,
+                                  const std::function<void(QDataStream &)> &write);
+
     friend class QHelpContentProvider;
     friend class QHelpContentModel;
     friend class QHelpIndexProvider;
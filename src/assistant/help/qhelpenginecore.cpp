@@ -72,6 +72,10 @@ QHelpEngineCorePrivate::~QHelpEngineCorePrivate()
 
 bool QHelpEngineCorePrivate::setup()
 {
+    // Other threads may only read from an engine that is set up already.
+    if (QThread::currentThread() != q->thread())
+        return !needsSetup;
+
     error.clear();
     if (!needsSetup)
         return true;
@@ -79,19 +83,30 @@ bool QHelpEngineCorePrivate::setup()
     needsSetup = false;
     emit q->setupStarted();
 
+    clearFileDataCache();
+
     const QVariant readOnlyVariant = q->property("_q_readonly");
     const bool readOnly = readOnlyVariant.isValid()
             ? readOnlyVariant.toBool() : q->isReadOnly();
     collectionHandler->setReadOnly(readOnly);
     const bool opened = collectionHandler->openCollectionFile();
-    if (opened)
+    if (opened) {
         q->currentFilter();
+        if (usesFilterEngine)
+            filterEngine->activeFilter();
+    }
 
     emit q->setupFinished();
 
     return opened;
 }
 
+void QHelpEngineCorePrivate::clearFileDataCache()
+{
+    QMutexLocker locker(&fileDataCacheMutex);
+    fileDataCache.clear();
+}
+
 void QHelpEngineCorePrivate::errorReceived(const QString &msg)
 {
     error = msg;
@@ -144,6 +159,16 @@ void QHelpEngineCorePrivate::errorReceived(const QString &msg)
     This class does not offer any GUI components or functionality for
     indices or contents. If you need one of those use QHelpEngine
     instead.
+
+    \section1 Thread-Safe Read Access
+
+    Once setupData() has been called and the filter engine is in use,
+    fileData(), documentsForIdentifier() and documentsForKeyword() can be
+    called from several threads at the same time. Every thread reads
+    through a read-only connection of its own to the collection file.
+    All other functions must only be called from the thread the help
+    engine lives in, and the collection must not be changed while other
+    threads are reading from it.
 */
 
 /*!
@@ -336,15 +361,40 @@ QString QHelpEngineCore::namespaceName(const QString &documentationFileName)
     True is returned if the registration was successful, otherwise
     false.
 
-    \sa unregisterDocumentation(), error()
+    \sa unregisterDocumentation(), registerDocumentations(), error()
 */
 bool QHelpEngineCore::registerDocumentation(const QString &documentationFileName)
 {
     d->error.clear();
     d->needsSetup = true;
+    d->clearFileDataCache();
     return d->collectionHandler->registerDocumentation(documentationFileName);
 }
 
+/*!
+    \since 6.3
+
+    Registers all Qt compressed help files (.qch) in
+    \a documentationFileNames. This is equivalent to calling
+    registerDocumentation() for each of them, but the files are read in
+    parallel and their contents are inserted into the help collection
+    within a single transaction, which is considerably faster when
+    registering many files at once.
+
+    True is returned if all files were registered successfully. Otherwise
+    false is returned, error() describes the last failure, and the
+    remaining files are still registered.
+
+    \sa registerDocumentation(), error()
+*/
+bool QHelpEngineCore::registerDocumentations(const QStringList &documentationFileNames)
+{
+    d->error.clear();
+    d->needsSetup = true;
+    d->clearFileDataCache();
+    return d->collectionHandler->registerDocumentations(documentationFileNames);
+}
+
 /*!
     Unregisters the Qt compressed help file (.qch) identified by its
     \a namespaceName from the help collection. Returns true
@@ -356,6 +406,7 @@ bool QHelpEngineCore::unregisterDocumentation(const QString &namespaceName)
 {
     d->error.clear();
     d->needsSetup = true;
+    d->clearFileDataCache();
     return d->collectionHandler->unregisterDocumentation(namespaceName);
 }
 
@@ -631,6 +682,9 @@ QUrl QHelpEngineCore::findFile(const QUrl &url) const
     Returns the data of the file specified by \a url. If the
     file does not exist, an empty QByteArray is returned.
 
+    \note This function can be called from any thread once setupData()
+    has been called, see \l{Thread-Safe Read Access}.
+
     \sa findFile()
 */
 QByteArray QHelpEngineCore::fileData(const QUrl &url) const
@@ -638,7 +692,118 @@ QByteArray QHelpEngineCore::fileData(const QUrl &url) const
     if (!d->setup())
         return QByteArray();
 
-    return d->collectionHandler->fileData(url);
+    {
+        QMutexLocker locker(&d->fileDataCacheMutex);
+        if (const QByteArray *data = d->fileDataCache.object(url)) {
+            ++d->fileDataCacheHits;
+            return *data;
+        }
+        ++d->fileDataCacheMisses;
+    }
+
+    const QByteArray data = d->collectionHandler->fileData(url);
+    if (!data.isEmpty()) {
+        QMutexLocker locker(&d->fileDataCacheMutex);
+        d->fileDataCache.insert(url, new QByteArray(data), data.size());
+    }
+    return data;
+}
+
+/*!
+    \since 6.3
+
+    Returns the maximum number of bytes of decompressed file data that
+    fileData() keeps in memory. The default is 32 MB.
+
+    \sa setFileDataCacheLimit()
+*/
+qint64 QHelpEngineCore::fileDataCacheLimit() const
+{
+    return d->fileDataCache.maxCost();
+}
+
+/*!
+    \since 6.3
+
+    Sets the maximum number of bytes of decompressed file data that
+    fileData() keeps in memory to \a bytes. The least recently used
+    files are dropped first. A limit of 0 disables the cache.
+
+    The cache is cleared whenever documentation is registered or
+    unregistered, and when the help data is set up again.
+
+    \sa fileDataCacheLimit(), fileDataCacheHits(), fileDataCacheMisses()
+*/
+void QHelpEngineCore::setFileDataCacheLimit(qint64 bytes)
+{
+    QMutexLocker locker(&d->fileDataCacheMutex);
+    d->fileDataCache.setMaxCost(qMax<qint64>(bytes, 0));
+}
+
+/*!
+    \since 6.3
+
+    Returns how many times fileData() was served from the cache.
+
+    \sa fileDataCacheMisses(), setFileDataCacheLimit()
+*/
+qint64 QHelpEngineCore::fileDataCacheHits() const
+{
+    QMutexLocker locker(&d->fileDataCacheMutex);
+    return d->fileDataCacheHits;
+}
+
+/*!
+    \since 6.3
+
+    Returns how many times fileData() had to read and decompress
+    the file from the documentation.
+
+    \sa fileDataCacheHits(), setFileDataCacheLimit()
+*/
+qint64 QHelpEngineCore::fileDataCacheMisses() const
+{
+    QMutexLocker locker(&d->fileDataCacheMutex);
+    return d->fileDataCacheMisses;
+}
+
+/*!
+    \since 6.3
+
+    Returns how many SQL queries the help engine has run on the
+    collection file and on the documentation files it reads pages
+    from, since the collection file was set or resetQueryStatistics()
+    was called.
+
+    \sa queryTime()
+*/
+qint64 QHelpEngineCore::queryCount() const
+{
+    return d->collectionHandler ? d->collectionHandler->queryStatistics().count() : 0;
+}
+
+/*!
+    \since 6.3
+
+    Returns the time in nanoseconds that the queries counted by
+    queryCount() took to run.
+
+    \sa queryCount(), resetQueryStatistics()
+*/
+qint64 QHelpEngineCore::queryTime() const
+{
+    return d->collectionHandler ? d->collectionHandler->queryStatistics().time() : 0;
+}
+
+/*!
+    \since 6.3
+
+    Sets queryCount() and queryTime() back to 0.
+*/
+void QHelpEngineCore::resetQueryStatistics()
+{
+    if (d->collectionHandler)
+        d->collectionHandler->resetQueryStatistics();
 }
 
 /*!
@@ -662,6 +827,10 @@ QList<QHelpLink> QHelpEngineCore::documentsForIdentifier(const QString &id) cons
     The returned list contents depend on the passed filter, and therefore only the keywords
     registered for this filter will be returned. If you want to get all results unfiltered,
     pass empty string as \a filterName.
+
+    \note With the filter engine in use, this function can be called from
+    any thread once setupData() has been called, see
+    \l{Thread-Safe Read Access}.
 */
 QList<QHelpLink> QHelpEngineCore::documentsForIdentifier(const QString &id, const QString &filterName) const
 {
@@ -695,6 +864,10 @@ QList<QHelpLink> QHelpEngineCore::documentsForKeyword(const QString &keyword) co
     The returned list contents depend on the passed filter, and therefore only the keywords
     registered for this filter will be returned. If you want to get all results unfiltered,
     pass empty string as \a filterName.
+
+    \note With the filter engine in use, this function can be called from
+    any thread once setupData() has been called, see
+    \l{Thread-Safe Read Access}.
 */
 QList<QHelpLink> QHelpEngineCore::documentsForKeyword(const QString &keyword, const QString &filterName) const
 {
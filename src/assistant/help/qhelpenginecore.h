@@ -81,11 +81,21 @@ public:
 
     static QString namespaceName(const QString &documentationFileName);
     bool registerDocumentation(const QString &documentationFileName);
+    bool registerDocumentations(const QStringList &documentationFileNames);
     bool unregisterDocumentation(const QString &namespaceName);
     QString documentationFileName(const QString &namespaceName);
     QStringList registeredDocumentations() const;
     QByteArray fileData(const QUrl &url) const;
 
+    qint64 fileDataCacheLimit() const;
+    void setFileDataCacheLimit(qint64 bytes);
+    qint64 fileDataCacheHits() const;
+    qint64 fileDataCacheMisses() const;
+
+    qint64 queryCount() const;
+    qint64 queryTime() const;
+    void resetQueryStatistics();
+
 #if QT_DEPRECATED_SINCE(5,13)
     QStringList customFilters() const;
     bool removeCustomFilter(const QString &filterName);
@@ -43,9 +43,12 @@
 #include "qhelpdbreader_p.h"
 #include "qhelpcollectionhandler_p.h"
 
+#include <QtCore/QHash>
 #include <QtCore/QThread>
 #include <QtCore/QVersionNumber>
 
+#include <optional>
+
 QT_BEGIN_NAMESPACE
 
 static const char ActiveFilter[] = "activeFilter";
@@ -53,15 +56,40 @@ static const char ActiveFilter[] = "activeFilter";
 class QHelpFilterEnginePrivate
 {
 public:
+    // In-memory copy of the collection's filter data, so that switching
+    // filters does not query the database again and again.
+    struct Snapshot
+    {
+        quint64 revision = 0;
+        std::optional<QMap<QString, QString>> namespaceToComponent;
+        std::optional<QMap<QString, QVersionNumber>> namespaceToVersion;
+        std::optional<QStringList> filters;
+        std::optional<QStringList> availableComponents;
+        std::optional<QList<QVersionNumber>> availableVersions;
+        QHash<QString, QHelpFilterData> filterData;
+        QHash<QString, QStringList> namespacesForFilter;
+    };
+
     bool setup();
+    Snapshot &snapshot();
+    void clearSnapshot() { m_snapshot = Snapshot(); }
 
     QHelpFilterEngine *q = nullptr;
     QHelpEngineCore *m_helpEngine = nullptr;
     QHelpCollectionHandler *m_collectionHandler = nullptr;
     QString m_currentFilter;
+    Snapshot m_snapshot;
     bool m_needsSetup = true;
 };
 
+template <typename T, typename Query>
+static const T &cachedValue(std::optional<T> &value, Query query)
+{
+    if (!value)
+        value = query();
+    return *value;
+}
+
 bool QHelpFilterEnginePrivate::setup()
 {
     if (!m_collectionHandler)
@@ -70,11 +98,15 @@ bool QHelpFilterEnginePrivate::setup()
     if (!m_needsSetup)
         return true;
 
+    if (QThread::currentThread() != q->thread())
+        return false;
+
     // Prevent endless loop when connected to setupFinished() signal
     // and using from there QHelpFilterEngine, causing setup() to be
     // called in turn.
     m_needsSetup = false;
 
+    clearSnapshot();
     if (!m_helpEngine->setupData()) {
         m_needsSetup = true;
         return false;
@@ -82,13 +114,23 @@ bool QHelpFilterEnginePrivate::setup()
 
     const QString filter = m_collectionHandler->customValue(
                 QLatin1String(ActiveFilter), QString()).toString();
-    if (!filter.isEmpty() && m_collectionHandler->filters().contains(filter))
+    if (!filter.isEmpty() && q->filters().contains(filter))
         m_currentFilter = filter;
 
     emit q->filterActivated(m_currentFilter);
     return true;
 }
 
+QHelpFilterEnginePrivate::Snapshot &QHelpFilterEnginePrivate::snapshot()
+{
+    const quint64 revision = m_collectionHandler->dataRevision();
+    if (m_snapshot.revision != revision) {
+        clearSnapshot();
+        m_snapshot.revision = revision;
+    }
+    return m_snapshot;
+}
+
 //////////////
 
 /*!
@@ -161,6 +203,7 @@ void QHelpFilterEngine::setCollectionHandler(QHelpCollectionHandler *collectionH
 {
     d->m_collectionHandler = collectionHandler;
     d->m_currentFilter = QString();
+    d->clearSnapshot();
     d->m_needsSetup = true;
 }
 
@@ -172,7 +215,9 @@ QMap<QString, QString> QHelpFilterEngine::namespaceToComponent() const
 {
     if (!d->setup())
         return QMap<QString, QString>();
-    return d->m_collectionHandler->namespaceToComponent();
+    return cachedValue(d->snapshot().namespaceToComponent, [this] {
+        return d->m_collectionHandler->namespaceToComponent();
+    });
 }
 
 /*!
@@ -184,7 +229,9 @@ QMap<QString, QVersionNumber> QHelpFilterEngine::namespaceToVersion() const
     if (!d->setup())
         return QMap<QString, QVersionNumber>();
 
-    return d->m_collectionHandler->namespaceToVersion();
+    return cachedValue(d->snapshot().namespaceToVersion, [this] {
+        return d->m_collectionHandler->namespaceToVersion();
+    });
 }
 
 /*!
@@ -194,7 +241,9 @@ QStringList QHelpFilterEngine::filters() const
 {
     if (!d->setup())
         return QStringList();
-    return d->m_collectionHandler->filters();
+    return cachedValue(d->snapshot().filters, [this] {
+        return d->m_collectionHandler->filters();
+    });
 }
 
 /*!
@@ -205,7 +254,9 @@ QStringList QHelpFilterEngine::availableComponents() const
 {
     if (!d->setup())
         return QStringList();
-    return d->m_collectionHandler->availableComponents();
+    return cachedValue(d->snapshot().availableComponents, [this] {
+        return d->m_collectionHandler->availableComponents();
+    });
 }
 
 /*!
@@ -218,7 +269,9 @@ QList<QVersionNumber> QHelpFilterEngine::availableVersions() const
 {
     if (!d->setup())
         return QList<QVersionNumber>();
-    return d->m_collectionHandler->availableVersions();
+    return cachedValue(d->snapshot().availableVersions, [this] {
+        return d->m_collectionHandler->availableVersions();
+    });
 }
 
 /*!
@@ -228,7 +281,12 @@ QHelpFilterData QHelpFilterEngine::filterData(const QString &filterName) const
 {
     if (!d->setup())
         return QHelpFilterData();
-    return d->m_collectionHandler->filterData(filterName);
+
+    QHash<QString, QHelpFilterData> &cache = d->snapshot().filterData;
+    auto it = cache.constFind(filterName);
+    if (it == cache.constEnd())
+        it = cache.insert(filterName, d->m_collectionHandler->filterData(filterName));
+    return it.value();
 }
 
 /*!
@@ -282,7 +340,7 @@ bool QHelpFilterEngine::setActiveFilter(const QString &filterName)
     if (filterName == d->m_currentFilter)
         return true;
 
-    if (!filterName.isEmpty() && !d->m_collectionHandler->filters().contains(filterName))
+    if (!filterName.isEmpty() && !filters().contains(filterName))
         return false;
 
     d->m_currentFilter = filterName;
@@ -302,7 +360,12 @@ QStringList QHelpFilterEngine::namespacesForFilter(const QString &filterName) co
 {
     if (!d->setup())
         return QStringList();
-    return  d->m_collectionHandler->namespacesForFilter(filterName);
+
+    QHash<QString, QStringList> &cache = d->snapshot().namespacesForFilter;
+    auto it = cache.constFind(filterName);
+    if (it == cache.constEnd())
+        it = cache.insert(filterName, d->m_collectionHandler->namespacesForFilter(filterName));
+    return it.value();
 }
 
 /*!
@@ -43,6 +43,8 @@
 #include "qhelpdbreader_p.h"
 #include "qhelpcollectionhandler_p.h"
 
+#include <QtCore/QDataStream>
+#include <QtCore/QHash>
 #include <QtCore/QThread>
 #include <QtCore/QMutex>
 #include <QtHelp/QHelpLink>
@@ -50,6 +52,7 @@
 #include <QtWidgets/QHeaderView>
 
 #include <algorithm>
+#include <numeric>
 
 QT_BEGIN_NAMESPACE
 
@@ -81,11 +84,84 @@ public:
     {
     }
 
+    void setIndices(const QStringList &newIndices);
+    QList<int> matches(const QString &foldedFilter);
+
     QHelpEnginePrivate *helpEngine;
     QHelpIndexProvider *indexProvider;
     QStringList indices;
+
+    // Case folded keywords and an index of their trigrams, built on
+    // first use, so that a keystroke only verifies likely candidates.
+    QStringList foldedIndices;
+    QHash<quint64, QList<int>> trigramIndex;
+    bool searchIndexOk = false;
+
+    // Typing usually extends the previous filter, whose matches are
+    // then the only candidates left.
+    QString lastFoldedFilter;
+    QList<int> lastMatches;
 };
 
+static quint64 trigramKey(const QChar *c)
+{
+    return quint64(c[0].unicode()) << 32 | quint64(c[1].unicode()) << 16 | c[2].unicode();
+}
+
+void QHelpIndexModelPrivate::setIndices(const QStringList &newIndices)
+{
+    indices = newIndices;
+    foldedIndices.clear();
+    trigramIndex.clear();
+    searchIndexOk = false;
+    lastFoldedFilter.clear();
+    lastMatches.clear();
+}
+
+QList<int> QHelpIndexModelPrivate::matches(const QString &foldedFilter)
+{
+    if (!searchIndexOk) {
+        foldedIndices.reserve(indices.count());
+        for (int i = 0; i < indices.count(); ++i) {
+            const QString folded = indices.at(i).toCaseFolded();
+            for (qsizetype j = 0; j + 3 <= folded.size(); ++j) {
+                QList<int> &postings = trigramIndex[trigramKey(folded.constData() + j)];
+                if (postings.isEmpty() || postings.constLast() != i)
+                    postings.append(i);
+            }
+            foldedIndices.append(folded);
+        }
+        searchIndexOk = true;
+    }
+
+    const QList<int> *candidates = nullptr;
+    QList<int> allIndices;
+    if (!lastFoldedFilter.isEmpty() && foldedFilter.contains(lastFoldedFilter))
+        candidates = &lastMatches;
+    for (qsizetype j = 0; j + 3 <= foldedFilter.size(); ++j) {
+        const auto it = trigramIndex.constFind(trigramKey(foldedFilter.constData() + j));
+        if (it == trigramIndex.constEnd())
+            return QList<int>();
+        if (!candidates || it->count() < candidates->count())
+            candidates = &it.value();
+    }
+    if (!candidates) {
+        allIndices.resize(foldedIndices.count());
+        std::iota(allIndices.begin(), allIndices.end(), 0);
+        candidates = &allIndices;
+    }
+
+    QList<int> result;
+    for (int i : *candidates) {
+        if (foldedIndices.at(i).contains(foldedFilter))
+            result.append(i);
+    }
+
+    lastFoldedFilter = foldedFilter;
+    lastMatches = result;
+    return result;
+}
+
 QHelpIndexProvider::QHelpIndexProvider(QHelpEnginePrivate *helpEngine)
     : QThread(helpEngine),
       m_helpEngine(helpEngine)
@@ -138,9 +214,24 @@ void QHelpIndexProvider::run()
     if (!collectionHandler.openCollectionFile())
         return;
 
-    const QStringList result = m_helpEngine->usesFilterEngine
-            ? collectionHandler.indicesForFilter(currentFilter)
-            : collectionHandler.indicesForFilter(attributes);
+    // Reuse the keywords stored by an earlier session, as long as the
+    // registered documentation and the filters are unchanged.
+    const QString snapshotName = m_helpEngine->usesFilterEngine
+            ? QLatin1String("index-filter:") + currentFilter
+            : QLatin1String("index-attributes:") + attributes.join(QLatin1Char('|'));
+    const QByteArray state = collectionHandler.stateHash();
+    QStringList result;
+    if (!QHelpEnginePrivate::readViewSnapshot(collectionFile, snapshotName, state,
+                                              [&result](QDataStream &s) {
+                                                  s >> result;
+                                                  return true;
+                                              })) {
+        result = m_helpEngine->usesFilterEngine
+                ? collectionHandler.indicesForFilter(currentFilter)
+                : collectionHandler.indicesForFilter(attributes);
+        QHelpEnginePrivate::writeViewSnapshot(collectionFile, snapshotName, state,
+                                              [&result](QDataStream &s) { s << result; });
+    }
 
     m_mutex.lock();
     m_indices = result;
@@ -198,7 +289,7 @@ void QHelpIndexModel::createIndex(const QString &customFilterName)
     if (running)
         return;
 
-    d->indices = QStringList();
+    d->setIndices(QStringList());
     filter(QString());
     emit indexCreationStarted();
 }
@@ -208,7 +299,7 @@ void QHelpIndexModel::insertIndices()
     if (d->indexProvider->isRunning())
         return;
 
-    d->indices = d->indexProvider->indices();
+    d->setIndices(d->indexProvider->indices());
     filter(QString());
     emit indexCreated();
 }
@@ -272,21 +363,21 @@ QModelIndex QHelpIndexModel::filter(const QString &filter, const QString &wildca
             }
         }
     } else {
-        for (const QString &index : qAsConst(d->indices)) {
-            if (index.contains(filter, Qt::CaseInsensitive)) {
-                lst.append(index);
-                if (perfectMatch == -1 && index.startsWith(filter, Qt::CaseInsensitive)) {
-                    if (goodMatch == -1)
-                        goodMatch = lst.count() - 1;
-                    if (filter.length() == index.length()){
-                        perfectMatch = lst.count() - 1;
-                    }
-                } else if (perfectMatch > -1 && index == filter) {
+        const QList<int> matches = d->matches(filter.toCaseFolded());
+        lst.reserve(matches.count());
+        for (int i : matches) {
+            const QString &index = d->indices.at(i);
+            lst.append(index);
+            if (perfectMatch == -1 && index.startsWith(filter, Qt::CaseInsensitive)) {
+                if (goodMatch == -1)
+                    goodMatch = lst.count() - 1;
+                if (filter.length() == index.length()){
                     perfectMatch = lst.count() - 1;
                 }
+            } else if (perfectMatch > -1 && index == filter) {
+                perfectMatch = lst.count() - 1;
             }
         }
-
     }
 
     if (perfectMatch == -1)
@@ -41,6 +41,7 @@
 #include "qhelpfilterengine.h"
 #include "qhelpsearchindexreader_default_p.h"
 
+#include <QtCore/QFileInfo>
 #include <QtCore/QSet>
 #include <QtSql/QSqlDatabase>
 #include <QtSql/QSqlQuery>
@@ -135,16 +136,30 @@ static void bindNamespacesAndAttributes(QSqlQuery *query, const QStringList &nam
         query->addBindValue(ns);
 }
 
-QList<QHelpSearchResult> Reader::queryTable(const QSqlDatabase &db,
-                                         const QString &tableName,
-                                         const QString &searchInput) const
+QString Reader::filterKey() const
+{
+    if (m_useFilterEngine)
+        return m_filterEngineNamespaceList.join(QLatin1Char('\n'));
+
+    QString key;
+    for (auto it = m_namespaceAttributes.cbegin(), end = m_namespaceAttributes.cend();
+         it != end; ++it) {
+        key += it.key() + QLatin1Char('|') + it.value().join(QLatin1Char('|'))
+                + QLatin1Char('\n');
+    }
+    return key;
+}
+
+QList<Reader::Hit> Reader::queryTable(const QSqlDatabase &db,
+                                      const QString &tableName,
+                                      const QString &searchInput) const
 {
     const QString nsPlaceholders = m_useFilterEngine
             ? namespacePlaceholders(m_filterEngineNamespaceList)
             : namespacePlaceholders(m_namespaceAttributes);
     QSqlQuery query(db);
-    query.prepare(QLatin1String("SELECT url, title, snippet(") + tableName +
-                  QLatin1String(", -1, '<b>', '</b>', '...', '10') FROM ") + tableName +
+    query.setForwardOnly(true);
+    query.prepare(QLatin1String("SELECT rowid, url, title FROM ") + tableName +
                   QLatin1String(" WHERE (") + nsPlaceholders +
                   QLatin1String(") AND ") + tableName +
                   QLatin1String(" MATCH ? ORDER BY rank"));
@@ -154,16 +169,38 @@ QList<QHelpSearchResult> Reader::queryTable(const QSqlDatabase &db,
     query.addBindValue(searchInput);
     query.exec();
 
-    QList<QHelpSearchResult> results;
+    QList<Hit> hits;
 
+    const bool inTitles = tableName == QLatin1String("titles");
     while (query.next()) {
-        const QString &url = query.value(QLatin1String("url")).toString();
-        const QString &title = query.value(QLatin1String("title")).toString();
-        const QString &snippet = query.value(2).toString();
-        results.append(QHelpSearchResult(url, title, snippet));
+        Hit hit;
+        hit.inTitles = inTitles;
+        hit.rowId = query.value(0).toLongLong();
+        hit.url = QUrl(query.value(1).toString());
+        hit.title = query.value(2).toString();
+        hits.append(hit);
     }
 
-    return results;
+    return hits;
+}
+
+QHelpSearchResult Reader::searchResult(const QSqlDatabase &db, const Hit &hit,
+                                       const QString &term)
+{
+    const QString tableName = QLatin1String(hit.inTitles ? "titles" : "contents");
+    QSqlQuery query(db);
+    query.prepare(QLatin1String("SELECT snippet(") + tableName +
+                  QLatin1String(", -1, '<b>', '</b>', '...', '10') FROM ") + tableName +
+                  QLatin1String(" WHERE rowid = ? AND ") + tableName +
+                  QLatin1String(" MATCH ?"));
+    query.addBindValue(hit.rowId);
+    query.addBindValue(term);
+
+    QString snippet;
+    if (query.exec() && query.next())
+        snippet = query.value(0).toString();
+
+    return QHelpSearchResult(hit.url, hit.title, snippet);
 }
 
 void Reader::searchInDB(const QString &searchInput)
@@ -175,29 +212,27 @@ void Reader::searchInDB(const QString &searchInput)
         db.setDatabaseName(m_indexPath + QLatin1String("/fts"));
 
         if (db.open()) {
-            const QList<QHelpSearchResult> titleResults = queryTable(db,
+            const QList<Hit> titleHits = queryTable(db,
                                              QLatin1String("titles"), searchInput);
-            const QList<QHelpSearchResult> contentResults = queryTable(db,
+            const QList<Hit> contentHits = queryTable(db,
                                              QLatin1String("contents"), searchInput);
 
             // merge results form title and contents searches
-            m_searchResults = QList<QHelpSearchResult>();
+            m_hits = QList<Hit>();
 
             QSet<QUrl> urls;
 
-            for (const QHelpSearchResult &result : titleResults) {
-                const QUrl &url = result.url();
-                if (!urls.contains(url)) {
-                    urls.insert(url);
-                    m_searchResults.append(result);
+            for (const Hit &hit : titleHits) {
+                if (!urls.contains(hit.url)) {
+                    urls.insert(hit.url);
+                    m_hits.append(hit);
                 }
             }
 
-            for (const QHelpSearchResult &result : contentResults) {
-                const QUrl &url = result.url();
-                if (!urls.contains(url)) {
-                    urls.insert(url);
-                    m_searchResults.append(result);
+            for (const Hit &hit : contentHits) {
+                if (!urls.contains(hit.url)) {
+                    urls.insert(hit.url);
+                    m_hits.append(hit);
                 }
             }
         }
@@ -205,9 +240,91 @@ void Reader::searchInDB(const QString &searchInput)
     QSqlDatabase::removeDatabase(uniqueId);
 }
 
-QList<QHelpSearchResult> Reader::searchResults() const
+QList<Reader::Hit> Reader::hits() const
+{
+    return m_hits;
+}
+
+QHelpSearchIndexReaderDefault::~QHelpSearchIndexReaderDefault()
+{
+    cancelSearching();
+    wait();
+    closeResultDatabase();
+}
+
+int QHelpSearchIndexReaderDefault::searchResultCount() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_hits.count();
+}
+
+/*
+  Snippets are computed only for the requested range, on a read
+  connection kept open for the thread asking, and remembered for
+  paging back and forth through the same results.
+ */
+QList<QHelpSearchResult> QHelpSearchIndexReaderDefault::searchResults(int start, int end) const
+{
+    QMutexLocker lock(&m_mutex);
+
+    start = qBound(0, start, int(m_hits.count()));
+    end = qBound(start, end, int(m_hits.count()));
+
+    QList<QHelpSearchResult> results;
+    results.reserve(end - start);
+    for (int i = start; i < end; ++i) {
+        auto it = m_resultCache.constFind(i);
+        if (it == m_resultCache.constEnd()) {
+            const Reader::Hit &hit = m_hits.at(i);
+            const QHelpSearchResult result = openResultDatabase()
+                    ? Reader::searchResult(QSqlDatabase::database(m_resultConnectionName, false),
+                                           hit, m_hitsInput)
+                    : QHelpSearchResult(hit.url, hit.title, QString());
+            it = m_resultCache.insert(i, result);
+        }
+        results.append(it.value());
+    }
+    return results;
+}
+
+bool QHelpSearchIndexReaderDefault::openResultDatabase() const
+{
+    if (!m_resultConnectionName.isEmpty()) {
+        if (m_resultConnectionThread == QThread::currentThread()
+                && m_resultConnectionPath == m_hitsIndexPath) {
+            return true;
+        }
+        closeResultDatabase();
+    }
+
+    const QString uniqueId = QHelpGlobal::uniquifyConnectionName(
+                QLatin1String("QHelpResultReader"), const_cast<QHelpSearchIndexReaderDefault *>(this));
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase(QLatin1String("QSQLITE"), uniqueId);
+        db.setConnectOptions(QLatin1String("QSQLITE_OPEN_READONLY"));
+        db.setDatabaseName(m_hitsIndexPath + QLatin1String("/fts"));
+        if (!db.open()) {
+            db = QSqlDatabase();
+            QSqlDatabase::removeDatabase(uniqueId);
+            return false;
+        }
+    }
+
+    m_resultConnectionName = uniqueId;
+    m_resultConnectionPath = m_hitsIndexPath;
+    m_resultConnectionThread = QThread::currentThread();
+    return true;
+}
+
+void QHelpSearchIndexReaderDefault::closeResultDatabase() const
 {
-    return m_searchResults;
+    if (m_resultConnectionName.isEmpty())
+        return;
+
+    QSqlDatabase::removeDatabase(m_resultConnectionName);
+    m_resultConnectionName.clear();
+    m_resultConnectionPath.clear();
+    m_resultConnectionThread = nullptr;
 }
 
 static bool attributesMatchFilter(const QStringList &attributes,
@@ -228,6 +345,9 @@ void QHelpSearchIndexReaderDefault::run()
     if (m_cancel)
         return;
 
+    m_hits.clear();
+    m_resultCache.clear();
+
     const QString searchInput = m_searchInput;
     const QString collectionFile = m_collectionFile;
     const QString indexPath = m_indexFilesFolder;
@@ -271,14 +391,33 @@ void QHelpSearchIndexReaderDefault::run()
     }
     lock.unlock();
 
-    m_searchResults.clear();
-    m_reader.searchInDB(searchInput);    // TODO: should this be interruptible as well ???
+    // Searching the same terms again, e.g. when going back to an earlier
+    // query, is answered from the cache until the index file changes.
+    const QString cacheKey = indexPath + QLatin1Char('\n')
+            + QFileInfo(indexPath + QLatin1String("/fts")).lastModified().toString(Qt::ISODateWithMs)
+            + QLatin1Char('\n') + m_reader.filterKey() + QLatin1Char('\n') + searchInput;
+
+    lock.relock();
+    const QList<Reader::Hit> *cachedHits = m_queryCache.object(cacheKey);
+    QList<Reader::Hit> hits = cachedHits ? *cachedHits : QList<Reader::Hit>();
+    lock.unlock();
+
+    if (!cachedHits) {
+        m_reader.searchInDB(searchInput);    // TODO: should this be interruptible as well ???
+        hits = m_reader.hits();
+    }
 
     lock.relock();
-    m_searchResults = m_reader.searchResults();
+    if (!cachedHits)
+        m_queryCache.insert(cacheKey, new QList<Reader::Hit>(hits));
+    m_hits = hits;
+    m_hitsInput = searchInput;
+    m_hitsIndexPath = indexPath;
+    m_resultCache.clear();
+    const int count = m_hits.count();
     lock.unlock();
 
-    emit searchingFinished(m_searchResults.count());
+    emit searchingFinished(count);
 }
 
 }   // namespace std
@@ -53,6 +53,9 @@
 
 #include "qhelpsearchindexreader_p.h"
 
+#include <QtCore/QCache>
+#include <QtCore/QHash>
+
 QT_FORWARD_DECLARE_CLASS(QSqlDatabase)
 
 QT_BEGIN_NAMESPACE
@@ -63,21 +66,35 @@ namespace qt {
 class Reader
 {
 public:
+    // A match without its snippet, which is only computed once
+    // the result gets shown.
+    struct Hit
+    {
+        bool inTitles = false;
+        qint64 rowId = 0;
+        QUrl url;
+        QString title;
+    };
+
     void setIndexPath(const QString &path);
     void addNamespaceAttributes(const QString &namespaceName, const QStringList &attributes);
     void setFilterEngineNamespaceList(const QStringList &namespaceList);
+    QString filterKey() const;
 
     void searchInDB(const QString &term);
-    QList<QHelpSearchResult> searchResults() const;
+    QList<Hit> hits() const;
+
+    static QHelpSearchResult searchResult(const QSqlDatabase &db, const Hit &hit,
+                                          const QString &term);
 
 private:
-    QList<QHelpSearchResult> queryTable(const QSqlDatabase &db,
-                                          const QString &tableName,
-                                          const QString &searchInput) const;
+    QList<Hit> queryTable(const QSqlDatabase &db,
+                          const QString &tableName,
+                          const QString &searchInput) const;
 
     QMultiMap<QString, QStringList> m_namespaceAttributes;
     QStringList m_filterEngineNamespaceList;
-    QList<QHelpSearchResult> m_searchResults;
+    QList<Hit> m_hits;
     QString m_indexPath;
     bool m_useFilterEngine = false;
 };
@@ -87,11 +104,29 @@ class QHelpSearchIndexReaderDefault : public QHelpSearchIndexReader
 {
     Q_OBJECT
 
+public:
+    ~QHelpSearchIndexReaderDefault() override;
+
+    int searchResultCount() const override;
+    QList<QHelpSearchResult> searchResults(int start, int end) const override;
+
 private:
     void run() override;
+    bool openResultDatabase() const;
+    void closeResultDatabase() const;
 
 private:
     Reader m_reader;
+
+    // Guarded by m_mutex.
+    QCache<QString, QList<Reader::Hit>> m_queryCache{16};
+    QList<Reader::Hit> m_hits;
+    QString m_hitsInput;
+    QString m_hitsIndexPath;
+    mutable QHash<int, QHelpSearchResult> m_resultCache;
+    mutable QString m_resultConnectionName;
+    mutable QString m_resultConnectionPath;
+    mutable QThread *m_resultConnectionThread = nullptr;
 };
 
 }   // namespace std
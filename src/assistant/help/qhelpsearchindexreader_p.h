@@ -75,8 +75,8 @@ public:
                 const QString &indexFilesFolder,
                 const QString &searchInput,
                 bool usesFilterEngine = false);
-    int searchResultCount() const;
-    QList<QHelpSearchResult> searchResults(int start, int end) const;
+    virtual int searchResultCount() const;
+    virtual QList<QHelpSearchResult> searchResults(int start, int end) const;
 
 signals:
     void searchingStarted();
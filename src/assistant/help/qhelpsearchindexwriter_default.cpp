@@ -42,11 +42,14 @@
 #include "qhelpenginecore.h"
 #include "qhelpdbreader_p.h"
 
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QDataStream>
 #include <QtCore/QDateTime>
 #include <QtCore/QDir>
+#include <QtCore/QSemaphore>
 #include <QtCore/QStringDecoder>
 #include <QtCore/QTextStream>
+#include <QtCore/QThreadPool>
 #include <QtCore/QSet>
 #include <QtCore/QUrl>
 #include <QtCore/QVariant>
@@ -55,7 +58,9 @@
 #include <QtSql/QSqlError>
 #include <QtSql/QSqlQuery>
 
-#include <QTextDocument>
+#include <algorithm>
+#include <atomic>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -119,6 +124,12 @@ bool Writer::hasDB()
     return query.next();
 }
 
+bool Writer::hasDocumentHashes()
+{
+    QSqlQuery query(*m_db);
+    return query.exec(QLatin1String("SELECT hash FROM info LIMIT 1"));
+}
+
 void Writer::clearLegacyIndex()
 {
     // Clear old legacy clucene index.
@@ -142,6 +153,11 @@ void Writer::init(bool reindex)
 
     QSqlQuery query(*m_db);
 
+    // Indexes written before the documents carried a content hash cannot
+    // be updated incrementally, so they are built again.
+    if (hasDB() && !hasDocumentHashes())
+        reindex = true;
+
     if (reindex && hasDB()) {
         m_needOptimize = true;
 
@@ -150,16 +166,12 @@ void Writer::init(bool reindex)
         query.exec(QLatin1String("DROP TABLE info;"));
     }
 
-    query.exec(QLatin1String("CREATE TABLE info (id INTEGER PRIMARY KEY, namespace, attributes, url, title, data);"));
+    query.exec(QLatin1String("CREATE TABLE info (id INTEGER PRIMARY KEY, namespace, attributes, url, title, data, hash);"));
 
     query.exec(QLatin1String("CREATE VIRTUAL TABLE titles USING fts5("
                              "namespace UNINDEXED, attributes UNINDEXED, "
                              "url UNINDEXED, title, "
                              "tokenize = 'porter unicode61', content = 'info', content_rowid='id');"));
-    query.exec(QLatin1String("CREATE TRIGGER titles_insert AFTER INSERT ON info BEGIN "
-                             "INSERT INTO titles(rowid, namespace, attributes, url, title) "
-                             "VALUES(new.id, new.namespace, new.attributes, new.url, new.title); "
-                             "END;"));
     query.exec(QLatin1String("CREATE TRIGGER titles_delete AFTER DELETE ON info BEGIN "
                              "INSERT INTO titles(titles, rowid, namespace, attributes, url, title) "
                              "VALUES('delete', old.id, old.namespace, old.attributes, old.url, old.title); "
@@ -175,10 +187,6 @@ void Writer::init(bool reindex)
                              "namespace UNINDEXED, attributes UNINDEXED, "
                              "url UNINDEXED, title, data, "
                              "tokenize = 'porter unicode61', content = 'info', content_rowid='id');"));
-    query.exec(QLatin1String("CREATE TRIGGER contents_insert AFTER INSERT ON info BEGIN "
-                             "INSERT INTO contents(rowid, namespace, attributes, url, title, data) "
-                             "VALUES(new.id, new.namespace, new.attributes, new.url, new.title, new.data); "
-                             "END;"));
     query.exec(QLatin1String("CREATE TRIGGER contents_delete AFTER DELETE ON info BEGIN "
                              "INSERT INTO contents(contents, rowid, namespace, attributes, url, title, data) "
                              "VALUES('delete', old.id, old.namespace, old.attributes, old.url, old.title, old.data); "
@@ -189,10 +197,46 @@ void Writer::init(bool reindex)
                              "INSERT INTO contents(rowid, namespace, attributes, url, title, data) "
                              "VALUES(new.id, new.namespace, new.attributes, new.url, new.title, new.data); "
                              "END;"));
+
+    // Building the index from scratch: feed the full text tables with a
+    // single 'rebuild' in endTransaction() instead of one trigger run per
+    // row. The pragmas only last as long as this connection, and a broken
+    // index is simply built again.
+    m_bulkIndex = !hasDB();
+    if (m_bulkIndex) {
+        query.exec(QLatin1String("DROP TRIGGER IF EXISTS titles_insert;"));
+        query.exec(QLatin1String("DROP TRIGGER IF EXISTS contents_insert;"));
+
+        if (m_db->driver()->hasFeature(QSqlDriver::Transactions)) {
+            // journal_mode cannot be changed within a transaction
+            m_db->commit();
+            query.exec(QLatin1String("PRAGMA journal_mode=MEMORY;"));
+            query.exec(QLatin1String("PRAGMA synchronous=OFF;"));
+            query.exec(QLatin1String("PRAGMA cache_size=-65536;"));
+            m_db->transaction();
+        }
+    } else {
+        createInsertTriggers();
+    }
+}
+
+void Writer::createInsertTriggers()
+{
+    QSqlQuery query(*m_db);
+
+    query.exec(QLatin1String("CREATE TRIGGER titles_insert AFTER INSERT ON info BEGIN "
+                             "INSERT INTO titles(rowid, namespace, attributes, url, title) "
+                             "VALUES(new.id, new.namespace, new.attributes, new.url, new.title); "
+                             "END;"));
+    query.exec(QLatin1String("CREATE TRIGGER contents_insert AFTER INSERT ON info BEGIN "
+                             "INSERT INTO contents(rowid, namespace, attributes, url, title, data) "
+                             "VALUES(new.id, new.namespace, new.attributes, new.url, new.title, new.data); "
+                             "END;"));
 }
 
 Writer::~Writer()
 {
+    delete m_insertQuery;
     if (m_db) {
         m_db->close();
         delete m_db;
@@ -204,24 +248,27 @@ Writer::~Writer()
 
 void Writer::flush()
 {
-    if (!m_db)
+    if (!m_db || m_namespaces.isEmpty())
         return;
 
-    QSqlQuery query(*m_db);
-
-    query.prepare(QLatin1String("INSERT INTO info (namespace, attributes, url, title, data) VALUES (?, ?, ?, ?, ?)"));
-    query.addBindValue(m_namespaces);
-    query.addBindValue(m_attributes);
-    query.addBindValue(m_urls);
-    query.addBindValue(m_titles);
-    query.addBindValue(m_contents);
-    query.execBatch();
+    if (!m_insertQuery) {
+        m_insertQuery = new QSqlQuery(*m_db);
+        m_insertQuery->prepare(QLatin1String("INSERT INTO info (namespace, attributes, url, title, data, hash) VALUES (?, ?, ?, ?, ?, ?)"));
+    }
+    m_insertQuery->addBindValue(m_namespaces);
+    m_insertQuery->addBindValue(m_attributes);
+    m_insertQuery->addBindValue(m_urls);
+    m_insertQuery->addBindValue(m_titles);
+    m_insertQuery->addBindValue(m_contents);
+    m_insertQuery->addBindValue(m_hashes);
+    m_insertQuery->execBatch();
 
     m_namespaces = QVariantList();
     m_attributes = QVariantList();
     m_urls = QVariantList();
     m_titles = QVariantList();
     m_contents = QVariantList();
+    m_hashes = QVariantList();
 }
 
 void Writer::removeNamespace(const QString &namespaceName)
@@ -255,17 +302,52 @@ bool Writer::hasNamespace(const QString &namespaceName)
     return query.next();
 }
 
+Writer::IndexedDocuments Writer::indexedDocuments(const QString &namespaceName)
+{
+    IndexedDocuments documents;
+    if (!m_db)
+        return documents;
+
+    QSqlQuery query(*m_db);
+
+    query.prepare(QLatin1String("SELECT id, attributes, url, hash FROM info WHERE namespace = ?"));
+    query.addBindValue(namespaceName);
+    query.exec();
+
+    while (query.next()) {
+        IndexedDocument &document = documents[qMakePair(query.value(1).toString(),
+                                                        query.value(2).toString())];
+        document.id = query.value(0).toLongLong();
+        document.hash = query.value(3).toByteArray();
+    }
+    return documents;
+}
+
+void Writer::removeDocuments(const QVariantList &ids)
+{
+    if (!m_db || ids.isEmpty())
+        return;
+
+    QSqlQuery query(*m_db);
+
+    query.prepare(QLatin1String("DELETE FROM info WHERE id = ?"));
+    query.addBindValue(ids);
+    query.execBatch();
+}
+
 void Writer::insertDoc(const QString &namespaceName,
                        const QString &attributes,
                        const QString &url,
                        const QString &title,
-                       const QString &contents)
+                       const QString &contents,
+                       const QByteArray &hash)
 {
     m_namespaces.append(namespaceName);
     m_attributes.append(attributes);
     m_urls.append(url);
     m_titles.append(title);
     m_contents.append(contents);
+    m_hashes.append(hash);
 }
 
 void Writer::startTransaction()
@@ -285,11 +367,16 @@ void Writer::endTransaction()
 
     QSqlQuery query(*m_db);
 
-    if (m_needOptimize) {
+    if (m_needOptimize || m_bulkIndex) {
         query.exec(QLatin1String("INSERT INTO titles(titles) VALUES('rebuild')"));
         query.exec(QLatin1String("INSERT INTO contents(contents) VALUES('rebuild')"));
     }
 
+    if (m_bulkIndex) {
+        createInsertTriggers();
+        m_bulkIndex = false;
+    }
+
     if (m_db && m_db->driver()->hasFeature(QSqlDriver::Transactions))
         m_db->commit();
 
@@ -363,6 +450,274 @@ static bool clearIndexMap(QHelpEngineCore *engine)
     return engine->removeCustomValue(QLatin1String(IndexedNamespacesKey));
 }
 
+static QString decodeEntity(QStringView entity)
+{
+    if (entity.startsWith(QLatin1Char('#'))) {
+        bool ok = false;
+        const uint code = entity.size() > 1 && (entity.at(1) == QLatin1Char('x')
+                                                || entity.at(1) == QLatin1Char('X'))
+                ? entity.mid(2).toUInt(&ok, 16) : entity.mid(1).toUInt(&ok, 10);
+        if (!ok || code == 0 || code > 0x10ffff)
+            return QString();
+        const char32_t ch = code;
+        return QString::fromUcs4(&ch, 1);
+    }
+
+    // The HTML 4 entities plus &apos;, sorted by name in byte order
+    static const struct Entity {
+        const char *name;
+        char16_t ch;
+    } entities[] = {
+        { "AElig", 0x00c6 }, { "Aacute", 0x00c1 }, { "Acirc", 0x00c2 }, { "Agrave", 0x00c0 },
+        { "Alpha", 0x0391 }, { "Aring", 0x00c5 }, { "Atilde", 0x00c3 }, { "Auml", 0x00c4 },
+        { "Beta", 0x0392 }, { "Ccedil", 0x00c7 }, { "Chi", 0x03a7 }, { "Dagger", 0x2021 },
+        { "Delta", 0x0394 }, { "ETH", 0x00d0 }, { "Eacute", 0x00c9 }, { "Ecirc", 0x00ca },
+        { "Egrave", 0x00c8 }, { "Epsilon", 0x0395 }, { "Eta", 0x0397 }, { "Euml", 0x00cb },
+        { "Gamma", 0x0393 }, { "Iacute", 0x00cd }, { "Icirc", 0x00ce }, { "Igrave", 0x00cc },
+        { "Iota", 0x0399 }, { "Iuml", 0x00cf }, { "Kappa", 0x039a }, { "Lambda", 0x039b },
+        { "Mu", 0x039c }, { "Ntilde", 0x00d1 }, { "Nu", 0x039d }, { "OElig", 0x0152 },
+        { "Oacute", 0x00d3 }, { "Ocirc", 0x00d4 }, { "Ograve", 0x00d2 }, { "Omega", 0x03a9 },
+        { "Omicron", 0x039f }, { "Oslash", 0x00d8 }, { "Otilde", 0x00d5 }, { "Ouml", 0x00d6 },
+        { "Phi", 0x03a6 }, { "Pi", 0x03a0 }, { "Prime", 0x2033 }, { "Psi", 0x03a8 },
+        { "Rho", 0x03a1 }, { "Scaron", 0x0160 }, { "Sigma", 0x03a3 }, { "THORN", 0x00de },
+        { "Tau", 0x03a4 }, { "Theta", 0x0398 }, { "Uacute", 0x00da }, { "Ucirc", 0x00db },
+        { "Ugrave", 0x00d9 }, { "Upsilon", 0x03a5 }, { "Uuml", 0x00dc }, { "Xi", 0x039e },
+        { "Yacute", 0x00dd }, { "Yuml", 0x0178 }, { "Zeta", 0x0396 }, { "aacute", 0x00e1 },
+        { "acirc", 0x00e2 }, { "acute", 0x00b4 }, { "aelig", 0x00e6 }, { "agrave", 0x00e0 },
+        { "alefsym", 0x2135 }, { "alpha", 0x03b1 }, { "amp", 0x0026 }, { "and", 0x2227 },
+        { "ang", 0x2220 }, { "apos", 0x0027 }, { "aring", 0x00e5 }, { "asymp", 0x2248 },
+        { "atilde", 0x00e3 }, { "auml", 0x00e4 }, { "bdquo", 0x201e }, { "beta", 0x03b2 },
+        { "brvbar", 0x00a6 }, { "bull", 0x2022 }, { "cap", 0x2229 }, { "ccedil", 0x00e7 },
+        { "cedil", 0x00b8 }, { "cent", 0x00a2 }, { "chi", 0x03c7 }, { "circ", 0x02c6 },
+        { "clubs", 0x2663 }, { "cong", 0x2245 }, { "copy", 0x00a9 }, { "crarr", 0x21b5 },
+        { "cup", 0x222a }, { "curren", 0x00a4 }, { "dArr", 0x21d3 }, { "dagger", 0x2020 },
+        { "darr", 0x2193 }, { "deg", 0x00b0 }, { "delta", 0x03b4 }, { "diams", 0x2666 },
+        { "divide", 0x00f7 }, { "eacute", 0x00e9 }, { "ecirc", 0x00ea }, { "egrave", 0x00e8 },
+        { "empty", 0x2205 }, { "emsp", 0x2003 }, { "ensp", 0x2002 }, { "epsilon", 0x03b5 },
+        { "equiv", 0x2261 }, { "eta", 0x03b7 }, { "eth", 0x00f0 }, { "euml", 0x00eb },
+        { "euro", 0x20ac }, { "exist", 0x2203 }, { "fnof", 0x0192 }, { "forall", 0x2200 },
+        { "frac12", 0x00bd }, { "frac14", 0x00bc }, { "frac34", 0x00be }, { "frasl", 0x2044 },
+        { "gamma", 0x03b3 }, { "ge", 0x2265 }, { "gt", 0x003e }, { "hArr", 0x21d4 },
+        { "harr", 0x2194 }, { "hearts", 0x2665 }, { "hellip", 0x2026 }, { "iacute", 0x00ed },
+        { "icirc", 0x00ee }, { "iexcl", 0x00a1 }, { "igrave", 0x00ec }, { "image", 0x2111 },
+        { "infin", 0x221e }, { "int", 0x222b }, { "iota", 0x03b9 }, { "iquest", 0x00bf },
+        { "isin", 0x2208 }, { "iuml", 0x00ef }, { "kappa", 0x03ba }, { "lArr", 0x21d0 },
+        { "lambda", 0x03bb }, { "lang", 0x2329 }, { "laquo", 0x00ab }, { "larr", 0x2190 },
+        { "lceil", 0x2308 }, { "ldquo", 0x201c }, { "le", 0x2264 }, { "lfloor", 0x230a },
+        { "lowast", 0x2217 }, { "loz", 0x25ca }, { "lrm", 0x200e }, { "lsaquo", 0x2039 },
+        { "lsquo", 0x2018 }, { "lt", 0x003c }, { "macr", 0x00af }, { "mdash", 0x2014 },
+        { "micro", 0x00b5 }, { "middot", 0x00b7 }, { "minus", 0x2212 }, { "mu", 0x03bc },
+        { "nabla", 0x2207 }, { "nbsp", 0x00a0 }, { "ndash", 0x2013 }, { "ne", 0x2260 },
+        { "ni", 0x220b }, { "not", 0x00ac }, { "notin", 0x2209 }, { "nsub", 0x2284 },
+        { "ntilde", 0x00f1 }, { "nu", 0x03bd }, { "oacute", 0x00f3 }, { "ocirc", 0x00f4 },
+        { "oelig", 0x0153 }, { "ograve", 0x00f2 }, { "oline", 0x203e }, { "omega", 0x03c9 },
+        { "omicron", 0x03bf }, { "oplus", 0x2295 }, { "or", 0x2228 }, { "ordf", 0x00aa },
+        { "ordm", 0x00ba }, { "oslash", 0x00f8 }, { "otilde", 0x00f5 }, { "otimes", 0x2297 },
+        { "ouml", 0x00f6 }, { "para", 0x00b6 }, { "part", 0x2202 }, { "permil", 0x2030 },
+        { "perp", 0x22a5 }, { "phi", 0x03c6 }, { "pi", 0x03c0 }, { "piv", 0x03d6 },
+        { "plusmn", 0x00b1 }, { "pound", 0x00a3 }, { "prime", 0x2032 }, { "prod", 0x220f },
+        { "prop", 0x221d }, { "psi", 0x03c8 }, { "quot", 0x0022 }, { "rArr", 0x21d2 },
+        { "radic", 0x221a }, { "rang", 0x232a }, { "raquo", 0x00bb }, { "rarr", 0x2192 },
+        { "rceil", 0x2309 }, { "rdquo", 0x201d }, { "real", 0x211c }, { "reg", 0x00ae },
+        { "rfloor", 0x230b }, { "rho", 0x03c1 }, { "rlm", 0x200f }, { "rsaquo", 0x203a },
+        { "rsquo", 0x2019 }, { "sbquo", 0x201a }, { "scaron", 0x0161 }, { "sdot", 0x22c5 },
+        { "sect", 0x00a7 }, { "shy", 0x00ad }, { "sigma", 0x03c3 }, { "sigmaf", 0x03c2 },
+        { "sim", 0x223c }, { "spades", 0x2660 }, { "sub", 0x2282 }, { "sube", 0x2286 },
+        { "sum", 0x2211 }, { "sup", 0x2283 }, { "sup1", 0x00b9 }, { "sup2", 0x00b2 },
+        { "sup3", 0x00b3 }, { "supe", 0x2287 }, { "szlig", 0x00df }, { "tau", 0x03c4 },
+        { "there4", 0x2234 }, { "theta", 0x03b8 }, { "thetasym", 0x03d1 }, { "thinsp", 0x2009 },
+        { "thorn", 0x00fe }, { "tilde", 0x02dc }, { "times", 0x00d7 }, { "trade", 0x2122 },
+        { "uArr", 0x21d1 }, { "uacute", 0x00fa }, { "uarr", 0x2191 }, { "ucirc", 0x00fb },
+        { "ugrave", 0x00f9 }, { "uml", 0x00a8 }, { "upsih", 0x03d2 }, { "upsilon", 0x03c5 },
+        { "uuml", 0x00fc }, { "weierp", 0x2118 }, { "xi", 0x03be }, { "yacute", 0x00fd },
+        { "yen", 0x00a5 }, { "yuml", 0x00ff }, { "zeta", 0x03b6 }, { "zwj", 0x200d },
+        { "zwnj", 0x200c }
+    };
+    const QByteArray name = entity.toLatin1();
+    const auto it = std::lower_bound(std::begin(entities), std::end(entities), name,
+                                     [](const Entity &e, const QByteArray &name) {
+                                         return qstrcmp(e.name, name.constData()) < 0;
+                                     });
+    if (it != std::end(entities) && name == it->name)
+        return QString(QChar(it->ch));
+    return QString();
+}
+
+static bool isBlockElement(QStringView name)
+{
+    static const char *const blockElements[] = {
+        "address", "article", "aside", "blockquote", "body", "br", "dd", "div", "dl",
+        "dt", "footer", "h1", "h2", "h3", "h4", "h5", "h6", "header", "hr", "li",
+        "nav", "ol", "p", "pre", "section", "table", "td", "th", "tr", "ul"
+    };
+    for (const char *element : blockElements) {
+        if (name.compare(QLatin1String(element), Qt::CaseInsensitive) == 0)
+            return true;
+    }
+    return false;
+}
+
+/*
+  Extracts the title and the plain text of an HTML page, roughly what
+  QTextDocument::toPlainText() returns, without laying out a document:
+  tags are dropped, block elements start a new line, runs of white
+  space collapse and character references are decoded. The contents
+  of script and style elements are skipped.
+ */
+static void extractHtmlText(const QString &html, QString *title, QString *contents)
+{
+    QString text;
+    text.reserve(html.size() / 2);
+    QString titleText;
+    QString *out = &text;
+    bool pendingSpace = false;
+
+    const auto appendChar = [&](QChar c) {
+        if (c.isSpace()) {
+            pendingSpace = true;
+            return;
+        }
+        if (pendingSpace && !out->isEmpty() && !out->endsWith(QLatin1Char('\n')))
+            out->append(QLatin1Char(' '));
+        pendingSpace = false;
+        out->append(c);
+    };
+
+    const QChar *p = html.constData();
+    const QChar *end = p + html.size();
+    while (p < end) {
+        if (*p == QLatin1Char('&')) {
+            const QChar *semicolon = p + 1;
+            while (semicolon < end && semicolon - p <= 10 && *semicolon != QLatin1Char(';'))
+                ++semicolon;
+            if (semicolon < end && *semicolon == QLatin1Char(';')) {
+                const QString decoded = decodeEntity(QStringView(p + 1, semicolon));
+                if (!decoded.isEmpty()) {
+                    for (QChar c : decoded)
+                        appendChar(c);
+                    p = semicolon + 1;
+                    continue;
+                }
+            }
+            appendChar(*p++);
+            continue;
+        }
+
+        if (*p != QLatin1Char('<')) {
+            appendChar(*p++);
+            continue;
+        }
+
+        const QStringView rest(p, end);
+        if (rest.startsWith(QLatin1String("<!--"))) {
+            const qsizetype commentEnd = rest.indexOf(QLatin1String("-->"), 4);
+            if (commentEnd < 0)
+                break;
+            p += commentEnd + 3;
+            continue;
+        }
+
+        const QChar *tagEnd = p + 1;
+        QChar quote;
+        for (; tagEnd < end; ++tagEnd) {
+            if (!quote.isNull()) {
+                if (*tagEnd == quote)
+                    quote = QChar();
+            } else if (*tagEnd == QLatin1Char('"') || *tagEnd == QLatin1Char('\'')) {
+                quote = *tagEnd;
+            } else if (*tagEnd == QLatin1Char('>')) {
+                break;
+            }
+        }
+        if (tagEnd == end)
+            break;
+
+        const QChar *nameStart = p + 1;
+        const bool closing = nameStart < tagEnd && *nameStart == QLatin1Char('/');
+        if (closing)
+            ++nameStart;
+        const QChar *nameEnd = nameStart;
+        while (nameEnd < tagEnd && nameEnd->isLetterOrNumber())
+            ++nameEnd;
+        const QStringView name(nameStart, nameEnd);
+        p = tagEnd + 1;
+
+        if (!closing && (name.compare(QLatin1String("script"), Qt::CaseInsensitive) == 0
+                         || name.compare(QLatin1String("style"), Qt::CaseInsensitive) == 0)) {
+            const QString endTag = QLatin1String("</") + name.toString();
+            const qsizetype skipped = QStringView(p, end).indexOf(endTag, 0, Qt::CaseInsensitive);
+            if (skipped < 0)
+                break;
+            p += skipped;
+        } else if (name.compare(QLatin1String("title"), Qt::CaseInsensitive) == 0) {
+            out = closing ? &text : &titleText;
+            pendingSpace = false;
+        } else if (isBlockElement(name)) {
+            pendingSpace = false;
+            if (!text.isEmpty() && !text.endsWith(QLatin1Char('\n')))
+                text.append(QLatin1Char('\n'));
+        }
+    }
+
+    *title = titleText.simplified();
+    *contents = text;
+}
+
+namespace {
+struct Document
+{
+    QString url;
+    QByteArray data;
+    QByteArray hash;
+    Writer::IndexedDocument previous;
+    QString title;
+    QString contents;
+    bool indexed = false;
+};
+}
+
+// Bump whenever the text extraction changes, so that pages indexed by
+// an older version do not count as unchanged.
+static const char TextExtractionVersion[] = "1";
+
+static QByteArray documentHash(const QByteArray &data)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(TextExtractionVersion, sizeof(TextExtractionVersion));
+    hash.addData(data.constData(), data.size());
+    return hash.result();
+}
+
+static void extractDocument(Document *document)
+{
+    document->hash = documentHash(document->data);
+    if (document->hash == document->previous.hash) {
+        // Unchanged since it was indexed, keep the existing row.
+        document->data = QByteArray();
+        return;
+    }
+
+    QTextStream s(document->data);
+    auto encoding = QStringDecoder::encodingForHtml(document->data);
+    if (encoding)
+        s.setEncoding(*encoding);
+
+    const QString &text = s.readAll();
+    if (text.isEmpty())
+        return;
+
+    if (document->url.endsWith(QLatin1String(".txt"))) {
+        document->title = document->url.mid(document->url.lastIndexOf(QLatin1Char('/')) + 1);
+        document->contents = text.toHtmlEscaped();
+    } else {
+        extractHtmlText(text, &document->title, &document->contents);
+        document->title = document->title.toHtmlEscaped();
+        document->contents = document->contents.toHtmlEscaped();
+    }
+    document->data = QByteArray();
+    document->indexed = true;
+}
+
 void QHelpSearchIndexWriter::run()
 {
     QMutexLocker lock(&m_mutex);
@@ -398,9 +753,8 @@ void QHelpSearchIndexWriter::run()
             if (indexMap.contains(namespaceName)) {
                 const QString path = engine.documentationFileName(namespaceName);
                 if (indexMap.value(namespaceName) < QFileInfo(path).lastModified()) {
-                    // Remove some outdated indexed stuff
+                    // Outdated, the changed pages are reindexed below
                     indexMap.remove(namespaceName);
-                    writer.removeNamespace(namespaceName);
                 } else if (!writer.hasNamespace(namespaceName)) {
                     // No data in fts db for namespace.
                     // The namespace could have been removed from fts db
@@ -408,13 +762,11 @@ void QHelpSearchIndexWriter::run()
                     // without removing it from indexMap.
                     indexMap.remove(namespaceName);
                 }
-            } else {
-                // Needed in case namespaceName was removed from indexMap
-                // without removing it from fts db.
-                // May happen when e.g. qch file was removed manually
-                // without removing fts db.
-                writer.removeNamespace(namespaceName);
             }
+            // Otherwise namespaceName may have been removed from indexMap
+            // without removing it from fts db, e.g. when the qch file was
+            // removed manually. Whatever data is left there is compared
+            // against the pages below, like for an outdated namespace.
         // TODO: we may also detect if there are any other data
         // and remove it
         }
@@ -452,81 +804,115 @@ void QHelpSearchIndexWriter::run()
 
         const QString virtualFolder = reader.virtualFolder();
 
+        // Pages that are still indexed from an earlier run; whatever is
+        // left in here after all attribute sets have been read is gone.
+        Writer::IndexedDocuments indexedDocuments = writer.indexedDocuments(namespaceName);
+
         const QList<QStringList> &attributeSets =
             engine.filterAttributeSets(namespaceName);
 
         for (const QStringList &attributes : attributeSets) {
             const QString &attributesString = attributes.join(QLatin1Char('|'));
 
-            const QMultiMap<QString, QByteArray> htmlFiles =
-                    reader.filesData(attributes, QLatin1String("html"));
-            const QMultiMap<QString, QByteArray> htmFiles =
-                    reader.filesData(attributes, QLatin1String("htm"));
-            const QMultiMap<QString, QByteArray> txtFiles =
-                    reader.filesData(attributes, QLatin1String("txt"));
+            if (!reader.startFilesData(attributes, QStringList()
+                                       << QLatin1String("html") << QLatin1String("htm")
+                                       << QLatin1String("txt"))) {
+                continue;
+            }
 
-            QMultiMap<QString, QByteArray> files = htmlFiles;
-            files.unite(htmFiles);
-            files.unite(txtFiles);
+            // Read the files in batches, so that only a bounded number of
+            // decompressed pages is in memory while the text is extracted.
+            QThreadPool *pool = QThreadPool::globalInstance();
+            const size_t batchSize = 64 * size_t(std::max(1, pool->maxThreadCount()));
+            std::vector<Document> documents;
+            QString file;
+            QByteArray data;
+            bool atEnd = false;
+            while (!atEnd) {
+                documents.clear();
+                while (documents.size() < batchSize) {
+                    if (!reader.nextFileData(&file, &data)) {
+                        atEnd = true;
+                        break;
+                    }
+
+                    if (data.isEmpty())
+                        continue;
+
+                    QUrl url;
+                    url.setScheme(QLatin1String("qthelp"));
+                    url.setAuthority(namespaceName);
+                    url.setPath(QLatin1Char('/') + virtualFolder + QLatin1Char('/') + file);
+
+                    if (url.hasFragment())
+                        url.setFragment(QString());
+
+                    const QString &fullFileName = url.toString();
+                    if (!fullFileName.endsWith(QLatin1String(".html"))
+                            && !fullFileName.endsWith(QLatin1String(".htm"))
+                            && !fullFileName.endsWith(QLatin1String(".txt"))) {
+                        continue;
+                    }
+
+                    Document document;
+                    document.url = fullFileName;
+                    document.data = data;
+                    const auto it = indexedDocuments.constFind(
+                                qMakePair(attributesString, fullFileName));
+                    if (it != indexedDocuments.constEnd()) {
+                        document.previous = it.value();
+                        indexedDocuments.erase(it);
+                    }
+                    documents.push_back(std::move(document));
+                }
 
-            for (auto it = files.cbegin(), end = files.cend(); it != end ; ++it) {
-                lock.relock();
-                if (m_cancel) {
+                // Extracting the text dominates indexing, so spread it over
+                // all cores; the documents are still written in order below.
+                std::atomic<bool> canceled(false);
+                QSemaphore done;
+                for (size_t i = 0; i < documents.size(); ++i) {
+                    pool->start([this, &documents, &canceled, &done, i]() {
+                        if (!canceled && i % 64 == 0) {
+                            QMutexLocker locker(&m_mutex);
+                            if (m_cancel)
+                                canceled = true;
+                        }
+                        if (!canceled)
+                            extractDocument(&documents[i]);
+                        done.release();
+                    });
+                }
+                done.acquire(int(documents.size()));
+
+                if (canceled) {
                     // store what we have done so far
                     writeIndexMap(&engine, indexMap);
                     writer.endTransaction();
                     emit indexingFinished();
                     return;
                 }
-                lock.unlock();
-
-                const QString &file = it.key();
-                const QByteArray &data = it.value();
-
-                if (data.isEmpty())
-                    continue;
 
-                QUrl url;
-                url.setScheme(QLatin1String("qthelp"));
-                url.setAuthority(namespaceName);
-                url.setPath(QLatin1Char('/') + virtualFolder + QLatin1Char('/') + file);
-
-                if (url.hasFragment())
-                    url.setFragment(QString());
-
-                const QString &fullFileName = url.toString();
-                if (!fullFileName.endsWith(QLatin1String(".html"))
-                        && !fullFileName.endsWith(QLatin1String(".htm"))
-                        && !fullFileName.endsWith(QLatin1String(".txt"))) {
-                    continue;
+                QVariantList changedIds;
+                for (const Document &document : documents) {
+                    if (document.hash == document.previous.hash)
+                        continue;
+                    if (document.previous.id >= 0)
+                        changedIds.append(document.previous.id);
+                    if (document.indexed) {
+                        writer.insertDoc(namespaceName, attributesString, document.url,
+                                         document.title, document.contents, document.hash);
+                    }
                 }
-
-                QTextStream s(data);
-                auto encoding = QStringDecoder::encodingForHtml(data);
-                if (encoding)
-                    s.setEncoding(*encoding);
-
-                const QString &text = s.readAll();
-                if (text.isEmpty())
-                    continue;
-
-                QString title;
-                QString contents;
-                if (fullFileName.endsWith(QLatin1String(".txt"))) {
-                    title = fullFileName.mid(fullFileName.lastIndexOf(QLatin1Char('/')) + 1);
-                    contents = text.toHtmlEscaped();
-                } else {
-                    QTextDocument doc;
-                    doc.setHtml(text);
-
-                    title = doc.metaInformation(QTextDocument::DocumentTitle).toHtmlEscaped();
-                    contents = doc.toPlainText().toHtmlEscaped();
-                }
-
-                writer.insertDoc(namespaceName, attributesString, fullFileName, title, contents);
+                writer.removeDocuments(changedIds);
+                writer.flush();
             }
         }
-        writer.flush();
+
+        QVariantList removedIds;
+        for (const Writer::IndexedDocument &document : qAsConst(indexedDocuments))
+            removedIds.append(document.id);
+        writer.removeDocuments(removedIds);
+
         const QString &path = engine.documentationFileName(namespaceName);
         indexMap.insert(namespaceName, QFileInfo(path).lastModified());
     }
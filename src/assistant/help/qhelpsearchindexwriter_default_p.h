@@ -51,10 +51,13 @@
 // We mean it.
 //
 
+#include <QtCore/QHash>
 #include <QtCore/QMutex>
+#include <QtCore/QPair>
 #include <QtCore/QThread>
 
 QT_FORWARD_DECLARE_CLASS(QSqlDatabase)
+QT_FORWARD_DECLARE_CLASS(QSqlQuery)
 
 QT_BEGIN_NAMESPACE
 
@@ -64,6 +67,14 @@ namespace qt {
 class Writer
 {
 public:
+    struct IndexedDocument
+    {
+        qint64 id = -1;
+        QByteArray hash;
+    };
+    // Indexed documents of a namespace by their attributes and url.
+    using IndexedDocuments = QHash<QPair<QString, QString>, IndexedDocument>;
+
     Writer(const QString &path);
     ~Writer();
 
@@ -72,28 +83,36 @@ public:
 
     void removeNamespace(const QString &namespaceName);
     bool hasNamespace(const QString &namespaceName);
+    IndexedDocuments indexedDocuments(const QString &namespaceName);
+    void removeDocuments(const QVariantList &ids);
     void insertDoc(const QString &namespaceName,
                    const QString &attributes,
                    const QString &url,
                    const QString &title,
-                   const QString &contents);
+                   const QString &contents,
+                   const QByteArray &hash);
     void startTransaction();
     void endTransaction();
 private:
     void init(bool reindex);
+    void createInsertTriggers();
     bool hasDB();
+    bool hasDocumentHashes();
     void clearLegacyIndex();
 
     const QString m_dbDir;
     QString m_uniqueId;
 
     bool m_needOptimize = false;
+    bool m_bulkIndex = false;
     QSqlDatabase *m_db = nullptr;
+    QSqlQuery *m_insertQuery = nullptr;
     QVariantList m_namespaces;
     QVariantList m_attributes;
     QVariantList m_urls;
     QVariantList m_titles;
     QVariantList m_contents;
+    QVariantList m_hashes;
 };
 
 
@@ -0,0 +1,120 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Assistant of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QHELPSQLQUERY_P_H
+#define QHELPSQLQUERY_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists for the convenience
+// of the help generator tools. This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/QElapsedTimer>
+
+#include <QtSql/QSqlQuery>
+
+#include <atomic>
+
+QT_BEGIN_NAMESPACE
+
+class QHelpQueryStatistics
+{
+public:
+    qint64 count() const { return m_count.load(std::memory_order_relaxed); }
+    qint64 time() const { return m_time.load(std::memory_order_relaxed); }
+
+    void record(qint64 nsecs)
+    {
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_time.fetch_add(nsecs, std::memory_order_relaxed);
+    }
+
+    void reset()
+    {
+        m_count.store(0, std::memory_order_relaxed);
+        m_time.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<qint64> m_count{0};
+    std::atomic<qint64> m_time{0};
+};
+
+// A QSqlQuery that adds the number of executions and the time spent in
+// them to QHelpQueryStatistics. The exec functions hide those of
+// QSqlQuery, so they only count where the query is used by this type.
+class QHelpSqlQuery : public QSqlQuery
+{
+public:
+    explicit QHelpSqlQuery(const QSqlDatabase &db, QHelpQueryStatistics *statistics = nullptr)
+        : QSqlQuery(db), m_statistics(statistics)
+    {}
+
+    bool exec() { return measure([this] { return QSqlQuery::exec(); }); }
+    bool exec(const QString &query) { return measure([&] { return QSqlQuery::exec(query); }); }
+    bool execBatch(BatchExecutionMode mode = ValuesAsRows)
+    {
+        return measure([&] { return QSqlQuery::execBatch(mode); });
+    }
+
+private:
+    template <typename Exec>
+    bool measure(Exec exec)
+    {
+        if (!m_statistics)
+            return exec();
+        QElapsedTimer timer;
+        timer.start();
+        const bool result = exec();
+        m_statistics->record(timer.nsecsElapsed());
+        return result;
+    }
+
+    QHelpQueryStatistics *m_statistics;
+};
+
+QT_END_NAMESPACE
+
+#endif
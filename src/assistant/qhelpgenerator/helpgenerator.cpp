@@ -46,15 +46,21 @@
 #include <QtCore/QFileInfo>
 #include <QtCore/QDir>
 #include <QtCore/QDebug>
-#include <QtCore/QRegularExpression>
+#include <QtCore/QHash>
 #include <QtCore/QSet>
 #include <QtCore/QVariant>
 #include <QtCore/QDateTime>
 #include <QtCore/QStringConverter>
 #include <QtCore/QDataStream>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+#include <QtCore/QtEndian>
 #include <QtSql/QSqlQuery>
 
 #include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
@@ -63,13 +69,19 @@ class HelpGeneratorPrivate : public QObject
     Q_OBJECT
 
 public:
-    HelpGeneratorPrivate(QObject *parent = nullptr) : QObject(parent) {}
+    HelpGeneratorPrivate(QObject *parent = nullptr)
+        : QObject(parent)
+        , m_connectionName(QHelpGlobal::uniquifyConnectionName(QLatin1String("builder"), this))
+    {}
 
     bool generate(QHelpProjectData *helpData,
         const QString &outputFileName);
     bool checkLinks(const QHelpProjectData &helpData);
     QString error() const;
 
+    bool m_incremental = false;
+    int m_threadCount = QThread::idealThreadCount();
+
 Q_SIGNALS:
     void statusChanged(const QString &msg);
     void progressChanged(double progress);
@@ -83,6 +95,33 @@ private:
         QString title;
     };
 
+    struct PreparedFile
+    {
+        bool exists = false;
+        bool opened = false;
+        QString titleSource;
+        QByteArray compressedData;
+    };
+
+    static PreparedFile prepareFile(const QString &filePath, const QString &fileName,
+                                    bool readData, int previousFileId = -1,
+                                    QSqlQuery *previousData = nullptr);
+
+    struct CheckedLink
+    {
+        QString linkedFileName;
+        QString canonicalLinkedFileName;
+    };
+
+    struct CheckedFile
+    {
+        bool opened = false;
+        QList<CheckedLink> links;
+    };
+
+    static CheckedFile extractLinks(const QString &fileName,
+                                    QHash<QString, QString> *canonicalPaths);
+
     void writeTree(QDataStream &s, QHelpDataContentItem *item, int depth);
     bool createTables();
     bool insertFileNotFoundFile();
@@ -97,11 +136,14 @@ private:
     bool insertContents(const QByteArray &ba,
         const QStringList &filterAttributes);
     bool insertMetaData(const QMap<QString, QVariant> &metaData);
+    bool readPreviousFiles();
     void cleanupDB();
     void setupProgress(QHelpProjectData *helpData);
     void addProgress(double step);
 
     QString m_error;
+    // unique, so that several generators can run at the same time
+    const QString m_connectionName;
     QSqlQuery *m_query = nullptr;
 
     int m_namespaceId = -1;
@@ -110,6 +152,10 @@ private:
     QMap<QString, int> m_fileMap;
     QMap<int, QSet<int> > m_fileFilterMap;
 
+    // the .qch file being replaced, and the ids of its files by name
+    QString m_previousFileName;
+    QHash<QString, int> m_previousFileIds;
+
     double m_progress;
     double m_oldProgress;
     double m_contentStep;
@@ -140,7 +186,19 @@ bool HelpGeneratorPrivate::generate(QHelpProjectData *helpData,
 
     QFileInfo fi(outFileName);
     if (fi.exists()) {
-        if (!fi.dir().remove(fi.fileName())) {
+        bool removed;
+        if (m_incremental) {
+            // Keep the existing file around until the new one is written,
+            // so that the data of unchanged files can be copied from it.
+            m_previousFileName = outFileName + QLatin1String(".previous");
+            QFile::remove(m_previousFileName);
+            removed = QFile::rename(outFileName, m_previousFileName);
+            if (!removed)
+                m_previousFileName.clear();
+        } else {
+            removed = fi.dir().remove(fi.fileName());
+        }
+        if (!removed) {
             m_error = tr("The file %1 cannot be overwritten.").arg(outFileName);
             return false;
         }
@@ -151,7 +209,7 @@ bool HelpGeneratorPrivate::generate(QHelpProjectData *helpData,
     emit statusChanged(tr("Building up file structure..."));
     bool openingOk = true;
     {
-        QSqlDatabase db = QSqlDatabase::addDatabase(QLatin1String("QSQLITE"), QLatin1String("builder"));
+        QSqlDatabase db = QSqlDatabase::addDatabase(QLatin1String("QSQLITE"), m_connectionName);
         db.setDatabaseName(outFileName);
         openingOk = db.open();
         if (openingOk)
@@ -167,6 +225,9 @@ bool HelpGeneratorPrivate::generate(QHelpProjectData *helpData,
     m_query->exec(QLatin1String("PRAGMA synchronous=OFF"));
     m_query->exec(QLatin1String("PRAGMA cache_size=3000"));
 
+    if (!m_previousFileName.isEmpty() && !readPreviousFiles())
+        emit warning(tr("Cannot read %1, all files will be compressed again.").arg(outFileName));
+
     addProgress(1.0);
     createTables();
     insertFileNotFoundFile();
@@ -241,6 +302,34 @@ void HelpGeneratorPrivate::addProgress(double step)
     }
 }
 
+/*!
+    Reads the names and ids of the files in the .qch file that is being
+    replaced. Files whose contents did not change reuse their
+    compressed data from there instead of being compressed again.
+*/
+bool HelpGeneratorPrivate::readPreviousFiles()
+{
+    const QString connectionName = m_connectionName + QLatin1String("-previous");
+    bool ok = false;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase(QLatin1String("QSQLITE"), connectionName);
+        db.setDatabaseName(m_previousFileName);
+        if (db.open()) {
+            QSqlQuery query(db);
+            ok = query.exec(QLatin1String("SELECT Name, FileId FROM FileNameTable"));
+            while (query.next())
+                m_previousFileIds.insert(query.value(0).toString(), query.value(1).toInt());
+        }
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+    if (!ok) {
+        m_previousFileIds.clear();
+        QFile::remove(m_previousFileName);
+        m_previousFileName.clear();
+    }
+    return ok;
+}
+
 void HelpGeneratorPrivate::cleanupDB()
 {
     if (m_query) {
@@ -248,7 +337,13 @@ void HelpGeneratorPrivate::cleanupDB()
         delete m_query;
         m_query = nullptr;
     }
-    QSqlDatabase::removeDatabase(QLatin1String("builder"));
+    QSqlDatabase::removeDatabase(m_connectionName);
+
+    if (!m_previousFileName.isEmpty()) {
+        QFile::remove(m_previousFileName);
+        m_previousFileName.clear();
+        m_previousFileIds.clear();
+    }
 }
 
 void HelpGeneratorPrivate::writeTree(QDataStream &s, QHelpDataContentItem *item, int depth)
@@ -429,9 +524,9 @@ bool HelpGeneratorPrivate::insertFiles(const QStringList &files, const QString &
 
     emit statusChanged(tr("Insert files..."));
     QSet<int> filterAtts;
+    m_query->prepare(QLatin1String("SELECT Id FROM FilterAttributeTable "
+        "WHERE Name=?"));
     for (const QString &filterAtt : filterAttributes) {
-        m_query->prepare(QLatin1String("SELECT Id FROM FilterAttributeTable "
-            "WHERE Name=?"));
         m_query->bindValue(0, filterAtt);
         m_query->exec();
         if (m_query->next())
@@ -445,9 +540,9 @@ bool HelpGeneratorPrivate::insertFiles(const QStringList &files, const QString &
     if (filterSetId < 0)
         return false;
     ++filterSetId;
+    m_query->prepare(QLatin1String("INSERT INTO FileAttributeSetTable "
+        "VALUES(?, ?)"));
     for (int attId : qAsConst(filterAtts)) {
-        m_query->prepare(QLatin1String("INSERT INTO FileAttributeSetTable "
-            "VALUES(?, ?)"));
         m_query->bindValue(0, filterSetId);
         m_query->bindValue(1, attId);
         m_query->exec();
@@ -464,30 +559,80 @@ bool HelpGeneratorPrivate::insertFiles(const QStringList &files, const QString &
     QMap<int, QSet<int> > tmpFileFilterMap;
     QList<FileNameTableData> fileNameDataList;
 
-    int i = 0;
+    /*
+      Reading, compressing and finding the title of a file don't
+      depend on the other files, so that is done on worker threads
+      first. The database is only touched below, in file order.
+    */
+    QStringList fileNames;
+    QList<bool> isNewFile;
+    fileNames.reserve(files.size());
+    isNewFile.reserve(files.size());
     for (const QString &file : files) {
-        const QString fileName = QDir::cleanPath(file);
+        fileNames.append(QDir::cleanPath(file));
+        isNewFile.append(!m_fileMap.contains(fileNames.last()));
+    }
+    QList<PreparedFile> preparedFiles(fileNames.size());
+    {
+        const int workerCount = qBound(1, m_threadCount, int(fileNames.size()));
+        PreparedFile *results = preparedFiles.data(); // detached once, for the workers
+        // A pool of its own, as several generators may run on the global one.
+        QThreadPool pool;
+        pool.setMaxThreadCount(workerCount);
+        for (int worker = 0; worker < workerCount; ++worker) {
+            pool.start([&, worker]() {
+                // Each worker reads the previous data through a connection
+                // of its own, as connections cannot be shared by threads.
+                const QString connectionName = m_connectionName
+                        + QString::fromLatin1("-previous-%1").arg(worker);
+                {
+                    QSqlDatabase db;
+                    QSqlQuery *previousData = nullptr;
+                    if (!m_previousFileName.isEmpty()) {
+                        db = QSqlDatabase::addDatabase(QLatin1String("QSQLITE"), connectionName);
+                        db.setDatabaseName(m_previousFileName);
+                        if (db.open()) {
+                            previousData = new QSqlQuery(db);
+                            previousData->prepare(QLatin1String(
+                                    "SELECT Data FROM FileDataTable WHERE Id=?"));
+                        }
+                    }
+                    for (qsizetype j = worker; j < fileNames.size(); j += workerCount) {
+                        const QString &fileName = fileNames.at(j);
+                        results[j] = prepareFile(rootPath + QDir::separator() + fileName,
+                                                 fileName, isNewFile.at(j),
+                                                 m_previousFileIds.value(fileName, -1),
+                                                 previousData);
+                    }
+                    delete previousData;
+                }
+                if (!m_previousFileName.isEmpty())
+                    QSqlDatabase::removeDatabase(connectionName);
+            });
+        }
+        pool.waitForDone();
+    }
+
+    int i = 0;
+    for (qsizetype j = 0; j < fileNames.size(); ++j) {
+        const QString &fileName = fileNames.at(j);
+        PreparedFile &prepared = preparedFiles[j];
 
-        QFile fi(rootPath + QDir::separator() + fileName);
-        if (!fi.exists()) {
+        if (!prepared.exists) {
             emit warning(tr("The file %1 does not exist, skipping it...")
                 .arg(QDir::cleanPath(rootPath + QDir::separator() + fileName)));
             continue;
         }
 
-        if (!fi.open(QIODevice::ReadOnly)) {
+        if (!prepared.opened) {
             emit warning(tr("Cannot open file %1, skipping it...")
                 .arg(QDir::cleanPath(rootPath + QDir::separator() + fileName)));
             continue;
         }
 
-        QByteArray data = fi.readAll();
         if (fileName.endsWith(QLatin1String(".html"))
             || fileName.endsWith(QLatin1String(".htm"))) {
-            auto encoding = QStringDecoder::encodingForHtml(data);
-            if (!encoding)
-                encoding = QStringDecoder::Utf8;
-            title = QHelpGlobal::documentTitle(QStringDecoder(*encoding)(data));
+            title = QHelpGlobal::documentTitle(prepared.titleSource);
         } else {
             title = fileName.mid(fileName.lastIndexOf(QLatin1Char('/')) + 1);
         }
@@ -495,7 +640,7 @@ bool HelpGeneratorPrivate::insertFiles(const QStringList &files, const QString &
         int fileId = -1;
         const auto &it = m_fileMap.constFind(fileName);
         if (it == m_fileMap.cend()) {
-            fileDataList.append(qCompress(data));
+            fileDataList.append(std::move(prepared.compressedData));
 
             FileNameTableData fileNameData;
             fileNameData.name = fileName;
@@ -524,30 +669,30 @@ bool HelpGeneratorPrivate::insertFiles(const QStringList &files, const QString &
 
     if (!tmpFileFilterMap.isEmpty()) {
         m_query->exec(QLatin1String("BEGIN"));
+        m_query->prepare(QLatin1String("INSERT INTO FileFilterTable "
+            "VALUES(?, ?)"));
         for (auto it = tmpFileFilterMap.cbegin(), end = tmpFileFilterMap.cend(); it != end; ++it) {
             QList<int> filterValues = it.value().values();
             std::sort(filterValues.begin(), filterValues.end());
             for (int fv : qAsConst(filterValues)) {
-                m_query->prepare(QLatin1String("INSERT INTO FileFilterTable "
-                    "VALUES(?, ?)"));
                 m_query->bindValue(0, fv);
                 m_query->bindValue(1, it.key());
                 m_query->exec();
             }
         }
 
+        m_query->prepare(QLatin1String("INSERT INTO FileDataTable VALUES "
+            "(Null, ?)"));
         for (const QByteArray &fileData : qAsConst(fileDataList)) {
-            m_query->prepare(QLatin1String("INSERT INTO FileDataTable VALUES "
-                "(Null, ?)"));
             m_query->bindValue(0, fileData);
             m_query->exec();
             if (++i % 20 == 0)
                 addProgress(m_fileStep * 20.0);
         }
 
+        m_query->prepare(QLatin1String("INSERT INTO FileNameTable "
+            "(FolderId, Name, FileId, Title) VALUES (?, ?, ?, ?)"));
         for (const FileNameTableData &fnd : qAsConst(fileNameDataList)) {
-            m_query->prepare(QLatin1String("INSERT INTO FileNameTable "
-                "(FolderId, Name, FileId, Title) VALUES (?, ?, ?, ?)"));
             m_query->bindValue(0, 1);
             m_query->bindValue(1, fnd.name);
             m_query->bindValue(2, fnd.fileId);
@@ -566,6 +711,74 @@ bool HelpGeneratorPrivate::insertFiles(const QStringList &files, const QString &
     return false;
 }
 
+/*!
+    Checks that the file at \a filePath, named \a fileName in the
+    help project, can be opened and, if \a readData is \c true, reads
+    and compresses it. This is called on worker threads, so it must
+    not touch the database or emit signals.
+
+    If \a previousData is set, it selects the data of \a previousFileId
+    in the .qch file being replaced. When the file did not change, that
+    data is reused instead of compressing the file again.
+
+    For HTML files, only the part of the file up to the end of the
+    title is decoded, unless the encoding is not ASCII compatible.
+    The title is then extracted from it by QHelpGlobal::documentTitle(),
+    which may need a QTextDocument and therefore runs on the main
+    thread.
+*/
+HelpGeneratorPrivate::PreparedFile HelpGeneratorPrivate::prepareFile(const QString &filePath,
+                                                                     const QString &fileName,
+                                                                     bool readData,
+                                                                     int previousFileId,
+                                                                     QSqlQuery *previousData)
+{
+    PreparedFile prepared;
+    QFile fi(filePath);
+    prepared.exists = fi.exists();
+    if (!prepared.exists)
+        return prepared;
+    prepared.opened = fi.open(QIODevice::ReadOnly);
+    if (!prepared.opened || !readData)
+        return prepared;
+
+    const QByteArray data = fi.readAll();
+    if (fileName.endsWith(QLatin1String(".html"))
+        || fileName.endsWith(QLatin1String(".htm"))) {
+        auto encoding = QStringDecoder::encodingForHtml(data);
+        if (!encoding)
+            encoding = QStringDecoder::Utf8;
+        QByteArrayView head(data);
+        if (*encoding == QStringDecoder::Utf8 || *encoding == QStringDecoder::Latin1) {
+            for (qsizetype pos = data.indexOf('<'); pos >= 0; pos = data.indexOf('<', pos + 1)) {
+                if (data.size() - pos >= 8 && qstrnicmp(data.constData() + pos, "</title>", 8) == 0) {
+                    head = head.first(pos + 8);
+                    break;
+                }
+            }
+        }
+        prepared.titleSource = QStringDecoder(*encoding)(head);
+    }
+    if (previousData && previousFileId > 0) {
+        previousData->bindValue(0, previousFileId);
+        if (previousData->exec() && previousData->next()) {
+            QByteArray previous = previousData->value(0).toByteArray();
+            // qCompress() stores the uncompressed size in the first four
+            // bytes, which rules out most changed files without
+            // decompressing them.
+            if (previous.size() >= 4 && qFromBigEndian<quint32>(previous.constData()) == quint32(data.size())
+                && qUncompress(previous) == data) {
+                prepared.compressedData = std::move(previous);
+            }
+        }
+        previousData->finish();
+        if (!prepared.compressedData.isNull())
+            return prepared;
+    }
+    prepared.compressedData = qCompress(data);
+    return prepared;
+}
+
 bool HelpGeneratorPrivate::registerCustomFilter(const QString &filterName,
     const QStringList &filterAttribs, bool forceUpdate)
 {
@@ -639,19 +852,31 @@ bool HelpGeneratorPrivate::insertKeywords(const QList<QHelpDataIndexItem> &keywo
         indexId = m_query->value(0).toInt() + 1;
 
     QList<int> filterAtts;
+    m_query->prepare(QLatin1String("SELECT Id FROM FilterAttributeTable WHERE Name=?"));
     for (const QString &filterAtt : filterAttributes) {
-        m_query->prepare(QLatin1String("SELECT Id FROM FilterAttributeTable WHERE Name=?"));
         m_query->bindValue(0, filterAtt);
         m_query->exec();
         if (m_query->next())
             filterAtts.append(m_query->value(0).toInt());
     }
 
-    QList<int> indexFilterTable;
+    // Collect the columns of all rows and insert them with one batch per table.
+    QVariantList names;
+    QVariantList identifiers;
+    QVariantList fileIds;
+    QVariantList anchors;
+    names.reserve(keywords.size());
+    identifiers.reserve(keywords.size());
+    fileIds.reserve(keywords.size());
+    anchors.reserve(keywords.size());
+
+    // Keywords of the same file usually follow each other.
+    QString lastFileName;
+    int lastFileId = 1;
 
     int i = 0;
-    m_query->exec(QLatin1String("BEGIN"));
     QSet<QString> indices;
+    indices.reserve(keywords.size());
     for (const QHelpDataIndexItem &itm : keywords) {
          // Identical ids make no sense and just confuse the Assistant user,
          // so we ignore all repetitions.
@@ -667,38 +892,54 @@ bool HelpGeneratorPrivate::insertKeywords(const QList<QHelpDataIndexItem> &keywo
         const QString &fileName = itm.reference.left(pos);
         const QString anchor = pos < 0 ? QString() : itm.reference.mid(pos + 1);
 
-        const QString &fName = QDir::cleanPath(fileName);
+        if (fileName != lastFileName || i == 0) {
+            lastFileName = fileName;
+            const auto &it = m_fileMap.constFind(QDir::cleanPath(fileName));
+            lastFileId = it == m_fileMap.cend() ? 1 : it.value();
+        }
 
-        const auto &it = m_fileMap.constFind(fName);
-        const int fileId = it == m_fileMap.cend() ? 1 : it.value();
+        names.append(itm.name);
+        identifiers.append(itm.identifier);
+        fileIds.append(lastFileId);
+        anchors.append(anchor);
 
-        m_query->prepare(QLatin1String("INSERT INTO IndexTable (Name, Identifier, NamespaceId, FileId, Anchor) "
-            "VALUES(?, ?, ?, ?, ?)"));
-        m_query->bindValue(0, itm.name);
-        m_query->bindValue(1, itm.identifier);
-        m_query->bindValue(2, m_namespaceId);
-        m_query->bindValue(3, fileId);
-        m_query->bindValue(4, anchor);
-        m_query->exec();
-
-        indexFilterTable.append(indexId++);
         if (++i % 100 == 0)
             addProgress(m_indexStep * 100.0);
     }
-    m_query->exec(QLatin1String("COMMIT"));
 
     m_query->exec(QLatin1String("BEGIN"));
-    for (int idx : qAsConst(indexFilterTable)) {
-        for (int a : qAsConst(filterAtts)) {
-            m_query->prepare(QLatin1String("INSERT INTO IndexFilterTable (FilterAttributeId, IndexId) "
-                "VALUES(?, ?)"));
-            m_query->bindValue(0, a);
-            m_query->bindValue(1, idx);
-            m_query->exec();
-        }
+    if (!names.isEmpty()) {
+        m_query->prepare(QLatin1String("INSERT INTO IndexTable (Name, Identifier, NamespaceId, FileId, Anchor) "
+            "VALUES(?, ?, ?, ?, ?)"));
+        m_query->addBindValue(names);
+        m_query->addBindValue(identifiers);
+        m_query->addBindValue(QVariantList(names.size(), m_namespaceId));
+        m_query->addBindValue(fileIds);
+        m_query->addBindValue(anchors);
+        m_query->execBatch();
     }
     m_query->exec(QLatin1String("COMMIT"));
 
+    if (!names.isEmpty() && !filterAtts.isEmpty()) {
+        QVariantList filterAttributeIds;
+        QVariantList indexIds;
+        filterAttributeIds.reserve(names.size() * filterAtts.size());
+        indexIds.reserve(names.size() * filterAtts.size());
+        for (int idx = indexId, end = indexId + int(names.size()); idx < end; ++idx) {
+            for (int a : qAsConst(filterAtts)) {
+                filterAttributeIds.append(a);
+                indexIds.append(idx);
+            }
+        }
+        m_query->exec(QLatin1String("BEGIN"));
+        m_query->prepare(QLatin1String("INSERT INTO IndexFilterTable (FilterAttributeId, IndexId) "
+            "VALUES(?, ?)"));
+        m_query->addBindValue(filterAttributeIds);
+        m_query->addBindValue(indexIds);
+        m_query->execBatch();
+        m_query->exec(QLatin1String("COMMIT"));
+    }
+
     m_query->exec(QLatin1String("SELECT COUNT(Id) FROM IndexTable"));
     if (m_query->next() && m_query->value(0).toInt() >= indices.count())
         return true;
@@ -724,9 +965,9 @@ bool HelpGeneratorPrivate::insertContents(const QByteArray &ba,
     }
 
     // associate the filter attributes
+    m_query->prepare(QLatin1String("INSERT INTO ContentsFilterTable (FilterAttributeId, ContentsId) "
+        "SELECT Id, ? FROM FilterAttributeTable WHERE Name=?"));
     for (const QString &filterAtt : filterAttributes) {
-        m_query->prepare(QLatin1String("INSERT INTO ContentsFilterTable (FilterAttributeId, ContentsId) "
-            "SELECT Id, ? FROM FilterAttributeTable WHERE Name=?"));
         m_query->bindValue(0, contentId);
         m_query->bindValue(1, filterAtt);
         m_query->exec();
@@ -773,6 +1014,84 @@ bool HelpGeneratorPrivate::insertMetaData(const QMap<QString, QVariant> &metaDat
     return true;
 }
 
+/*!
+    Returns the local files referenced by \c{<a href>} and \c{<img src>}
+    elements in the HTML file \a fileName, together with their canonical
+    paths. This is called on worker threads, so it must not emit signals.
+
+    The file is memory-mapped if possible and scanned byte by byte, which
+    works for all ASCII compatible encodings; other encodings are
+    converted to UTF-8 first. Canonical paths are looked up in, and added
+    to, \a canonicalPaths, which is keyed by the directory and the link,
+    as many files in a directory link to the same targets.
+*/
+HelpGeneratorPrivate::CheckedFile HelpGeneratorPrivate::extractLinks(const QString &fileName,
+                                                                     QHash<QString, QString> *canonicalPaths)
+{
+    CheckedFile checkedFile;
+    QFile htmlFile(fileName);
+    checkedFile.opened = htmlFile.open(QIODevice::ReadOnly);
+    if (!checkedFile.opened)
+        return checkedFile;
+
+    QByteArray buffer;
+    QByteArrayView data;
+    if (const uchar *mapped = htmlFile.size() > 0 ? htmlFile.map(0, htmlFile.size()) : nullptr) {
+        data = QByteArrayView(reinterpret_cast<const char *>(mapped), htmlFile.size());
+    } else {
+        buffer = htmlFile.readAll();
+        data = buffer;
+    }
+
+    auto encoding = QStringDecoder::encodingForHtml(data);
+    if (!encoding)
+        encoding = QStringDecoder::Utf8;
+    if (*encoding != QStringDecoder::Utf8 && *encoding != QStringDecoder::Latin1
+        && *encoding != QStringDecoder::System) {
+        buffer = QString(QStringDecoder(*encoding)(data)).toUtf8();
+        data = buffer;
+        encoding = QStringDecoder::Utf8;
+    }
+
+    const QString curDir = QFileInfo(fileName).dir().path();
+    static const QByteArrayView patterns[] = { "<a href=", "<img src=" };
+    const char *begin = data.data();
+    const char *end = begin + data.size();
+    for (const char *p = begin; (p = static_cast<const char *>(
+                                     memchr(p, '<', end - p))) != nullptr; ++p) {
+        const QByteArrayView rest(p, end - p);
+        const QByteArrayView *pattern = std::find_if(std::begin(patterns), std::end(patterns),
+                                                     [&rest](QByteArrayView pattern) {
+            return rest.startsWith(pattern);
+        });
+        if (pattern == std::end(patterns))
+            continue;
+
+        // <(?:a href|img src)="?([^#">]+)[#">]
+        const char *linkBegin = p + pattern->size();
+        if (linkBegin < end && *linkBegin == '"')
+            ++linkBegin;
+        const char *linkEnd = linkBegin;
+        while (linkEnd < end && *linkEnd != '#' && *linkEnd != '"' && *linkEnd != '>')
+            ++linkEnd;
+        if (linkEnd == end || linkEnd == linkBegin)
+            continue;
+        p = linkEnd;
+
+        const QString linkedFileName = QStringDecoder(*encoding)(
+                    QByteArrayView(linkBegin, linkEnd - linkBegin));
+        if (linkedFileName.contains(QLatin1String("://")))
+            continue;
+
+        const QString linkPath = curDir + QDir::separator() + linkedFileName;
+        auto it = canonicalPaths->find(linkPath);
+        if (it == canonicalPaths->end())
+            it = canonicalPaths->insert(linkPath, QFileInfo(linkPath).canonicalFilePath());
+        checkedFile.links.append({ linkedFileName, it.value() });
+    }
+    return checkedFile;
+}
+
 bool HelpGeneratorPrivate::checkLinks(const QHelpProjectData &helpData)
 {
     /*
@@ -796,41 +1115,49 @@ bool HelpGeneratorPrivate::checkLinks(const QHelpProjectData &helpData)
      *         Note that we don't parse the files, but simply grep for the
      *         respective HTML elements. Therefore. contents that are e.g.
      *         commented out can cause false warning.
+     *         The files are scanned in parallel, the results are reported
+     *         in order afterwards.
      */
-    bool allLinksOk = true;
+    QStringList htmlFiles;
     for (const QString &fileName : qAsConst(files)) {
-        if (!fileName.endsWith(QLatin1String("html"))
-            && !fileName.endsWith(QLatin1String("htm")))
-            continue;
-        QFile htmlFile(fileName);
-        if (!htmlFile.open(QIODevice::ReadOnly)) {
+        if (fileName.endsWith(QLatin1String("html"))
+            || fileName.endsWith(QLatin1String("htm")))
+            htmlFiles.append(fileName);
+    }
+
+    QList<CheckedFile> checkedFiles(htmlFiles.size());
+    if (!htmlFiles.isEmpty()) {
+        const int workerCount = qBound(1, m_threadCount, int(htmlFiles.size()));
+        CheckedFile *results = checkedFiles.data(); // detached once, for the workers
+        QThreadPool pool;
+        pool.setMaxThreadCount(workerCount);
+        for (int worker = 0; worker < workerCount; ++worker) {
+            pool.start([&, results, worker]() {
+                QHash<QString, QString> canonicalPaths;
+                for (qsizetype j = worker; j < htmlFiles.size(); j += workerCount)
+                    results[j] = extractLinks(htmlFiles.at(j), &canonicalPaths);
+            });
+        }
+        pool.waitForDone();
+    }
+
+    bool allLinksOk = true;
+    for (qsizetype j = 0; j < htmlFiles.size(); ++j) {
+        const QString &fileName = htmlFiles.at(j);
+        const CheckedFile &checkedFile = checkedFiles.at(j);
+        if (!checkedFile.opened) {
             emit warning(tr("File \"%1\" cannot be opened.").arg(fileName));
             continue;
         }
-        const QRegularExpression linkPattern(QLatin1String("<(?:a href|img src)=\"?([^#\">]+)[#\">]"));
-        QByteArray data = htmlFile.readAll();
-        auto encoding = QStringDecoder::encodingForHtml(data);
-        if (!encoding)
-            encoding = QStringDecoder::Utf8;
-        const QString &content = QStringDecoder(*encoding)(data);
         QStringList invalidLinks;
-        QRegularExpressionMatch match;
-        int pos = 0;
-        while ((match = linkPattern.match(content, pos)).hasMatch()) {
-            const QString &linkedFileName = match.captured(1);
-            if (linkedFileName.contains(QLatin1String("://")))
-                continue;
-            const QString &curDir = QFileInfo(fileName).dir().path();
-            const QString &canonicalLinkedFileName =
-                QFileInfo(curDir + QDir::separator() + linkedFileName).canonicalFilePath();
-            if (!files.contains(canonicalLinkedFileName)
-                && !invalidLinks.contains(canonicalLinkedFileName)) {
+        for (const CheckedLink &link : checkedFile.links) {
+            if (!files.contains(link.canonicalLinkedFileName)
+                && !invalidLinks.contains(link.canonicalLinkedFileName)) {
                 emit warning(tr("File \"%1\" contains an invalid link to file \"%2\"").
-                         arg(fileName).arg(linkedFileName));
+                         arg(fileName).arg(link.linkedFileName));
                 allLinksOk = false;
-                invalidLinks.append(canonicalLinkedFileName);
+                invalidLinks.append(link.canonicalLinkedFileName);
             }
-            pos = match.capturedEnd();
         }
     }
 
@@ -858,6 +1185,26 @@ bool HelpGenerator::generate(QHelpProjectData *helpData,
     return m_private->generate(helpData, outputFileName);
 }
 
+/*!
+    Sets whether generate() reuses the compressed data of unchanged files
+    from an existing output file to \a incremental. The output is the
+    same as without it; only files that changed are compressed again.
+*/
+void HelpGenerator::setIncremental(bool incremental)
+{
+    m_private->m_incremental = incremental;
+}
+
+/*!
+    Sets the number of threads that generate() and checkLinks() use for
+    reading and compressing files to \a threadCount. The default is
+    QThread::idealThreadCount().
+*/
+void HelpGenerator::setThreadCount(int threadCount)
+{
+    m_private->m_threadCount = qMax(1, threadCount);
+}
+
 bool HelpGenerator::checkLinks(const QHelpProjectData &helpData)
 {
     return m_private->checkLinks(helpData);
@@ -55,6 +55,8 @@ public:
     HelpGenerator(bool silent = false);
     bool generate(QHelpProjectData *helpData,
         const QString &outputFileName);
+    void setIncremental(bool incremental);
+    void setThreadCount(int threadCount);
     bool checkLinks(const QHelpProjectData &helpData);
     QString error() const;
 
@@ -37,12 +37,16 @@
 #include <QtCore/QFileInfo>
 #include <QtCore/QLibraryInfo>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
 #include <QtCore/QTranslator>
 
 #include <QtGui/QGuiApplication>
 
 #include <QtHelp/QHelpEngineCore>
 
+#include <atomic>
+
 
 QT_USE_NAMESPACE
 
@@ -63,7 +67,16 @@ namespace {
     }
 }
 
-int generateCollectionFile(const QByteArray &data, const QString &basePath, const QString outputFile)
+struct GeneratorOptions
+{
+    bool checkLinks = false;
+    bool silent = false;
+    bool incremental = false;
+    int threadCount = QThread::idealThreadCount();
+};
+
+int generateCollectionFile(const QByteArray &data, const QString &basePath, const QString outputFile,
+                           const GeneratorOptions &options)
 {
     fputs(qPrintable(QHG::tr("Reading collection config file...\n")), stdout);
     CollectionConfigReader config;
@@ -84,6 +97,8 @@ int generateCollectionFile(const QByteArray &data, const QString &basePath, cons
         }
 
         HelpGenerator helpGenerator;
+        helpGenerator.setIncremental(options.incremental);
+        helpGenerator.setThreadCount(options.threadCount);
         if (!helpGenerator.generate(&helpData, absoluteFilePath(basePath, it.value()))) {
             fprintf(stderr, "%s\n", qPrintable(helpGenerator.error()));
             return 1;
@@ -246,16 +261,91 @@ int generateCollectionFile(const QByteArray &data, const QString &basePath, cons
     return 0;
 }
 
+enum InputType {
+    InputQhp,
+    InputQhcp,
+    InputUnknown
+};
+
+static InputType inputType(const QString &inputFile)
+{
+    const QFileInfo fi(inputFile);
+    if (fi.suffix() == QHP)
+        return InputQhp;
+    if (fi.suffix() == QHCP)
+        return InputQhcp;
+    return InputUnknown;
+}
+
+static int processInputFile(const QString &inputFile, QString outputFile,
+                            const GeneratorOptions &options)
+{
+    const QString basePath = QFileInfo(inputFile).absolutePath();
+    const InputType type = inputType(inputFile);
+
+    QFile file(inputFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        fputs(qPrintable(QHG::tr("Could not open %1.\n").arg(inputFile)), stderr);
+        return 1;
+    }
+
+    const QString outputExtension = type == InputQhp ? QCH : QHC;
+
+    if (outputFile.isEmpty()) {
+        if (type == InputQhcp || !options.checkLinks) {
+            QFileInfo fi(inputFile);
+            outputFile = basePath + QDir::separator()
+                             + fi.baseName() + QLatin1Char('.') + outputExtension;
+        }
+    } else {
+        // check if the output dir exists -- create if it doesn't
+        QFileInfo fi(outputFile);
+        QDir parentDir = fi.dir();
+        if (!parentDir.exists()) {
+            if (!parentDir.mkpath(QLatin1String("."))) {
+                fputs(qPrintable(QHG::tr("Could not create output directory: %1\n")
+                                 .arg(parentDir.path())), stderr);
+            }
+        }
+    }
+
+    if (type == InputQhp) {
+        QHelpProjectData *helpData = new QHelpProjectData();
+        if (!helpData->readData(inputFile)) {
+            fprintf(stderr, "%s\n", qPrintable(helpData->errorMessage()));
+            return 1;
+        }
+
+        HelpGenerator generator(options.silent);
+        generator.setIncremental(options.incremental);
+        generator.setThreadCount(options.threadCount);
+        bool success = true;
+        if (options.checkLinks)
+            success = generator.checkLinks(*helpData);
+        if (success && !outputFile.isEmpty())
+            success = generator.generate(helpData, outputFile);
+        delete helpData;
+        if (!success) {
+            fprintf(stderr, "%s\n", qPrintable(generator.error()));
+            return 1;
+        }
+    } else {
+        const QByteArray data = file.readAll();
+        return generateCollectionFile(data, basePath, outputFile, options);
+    }
+
+    return 0;
+}
+
 int main(int argc, char *argv[])
 {
     QString error;
     QString outputFile;
-    QString inputFile;
-    QString basePath;
+    QStringList inputFiles;
     bool showHelp = false;
     bool showVersion = false;
-    bool checkLinks = false;
-    bool silent = false;
+    GeneratorOptions options;
+    int jobs = QThread::idealThreadCount();
 
     // don't require a window manager even though we're a QGuiApplication
     qputenv("QT_QPA_PLATFORM", QByteArrayLiteral("minimal"));
@@ -290,13 +380,20 @@ int main(int argc, char *argv[])
         } else if (arg == QLatin1String("-h")) {
             showHelp = true;
         } else if (arg == QLatin1String("-c")) {
-            checkLinks = true;
+            options.checkLinks = true;
         } else if (arg == QLatin1String("-s")) {
-            silent = true;
+            options.silent = true;
+        } else if (arg == QLatin1String("-u")) {
+            options.incremental = true;
+        } else if (arg == QLatin1String("-jobs")) {
+            bool ok = false;
+            if (++i < argc)
+                jobs = QString::fromLocal8Bit(argv[i]).toInt(&ok);
+            if (!ok || jobs < 1)
+                error = QHG::tr("The -jobs option requires a positive number.");
         } else {
             const QFileInfo fi(arg);
-            inputFile = fi.absoluteFilePath();
-            basePath = fi.absolutePath();
+            inputFiles.append(fi.absoluteFilePath());
         }
     }
 
@@ -306,31 +403,23 @@ int main(int argc, char *argv[])
         return 0;
     }
 
-    enum InputType {
-        InputQhp,
-        InputQhcp,
-        InputUnknown
-    };
-
-    InputType inputType = InputUnknown;
-
-    if (!showHelp) {
-        if (inputFile.isEmpty()) {
+    if (!showHelp && error.isEmpty()) {
+        if (inputFiles.isEmpty()) {
             error = QHG::tr("Missing input file name.");
+        } else if (inputFiles.count() > 1 && !outputFile.isEmpty()) {
+            error = QHG::tr("An output file name cannot be given for several input files.");
         } else {
-            const QFileInfo fi(inputFile);
-            if (fi.suffix() == QHP)
-                inputType = InputQhp;
-            else if (fi.suffix() == QHCP)
-                inputType = InputQhcp;
-
-            if (inputType == InputUnknown)
-                error = QHG::tr("Unknown input file type.");
+            for (const QString &inputFile : qAsConst(inputFiles)) {
+                if (inputType(inputFile) == InputUnknown) {
+                    error = QHG::tr("Unknown input file type.");
+                    break;
+                }
+            }
         }
     }
 
     const QString help = QHG::tr("\nUsage:\n\n"
-        "qhelpgenerator <file> [options]\n\n"
+        "qhelpgenerator <file>... [options]\n\n"
         "  -o <output-file>       Generates a Qt compressed help\n"
         "                         called <output-file> (*.qch) for the\n"
         "                         Qt help project <file> (*.qhp).\n"
@@ -340,9 +429,18 @@ int main(int argc, char *argv[])
         "                         If this option is not specified\n"
         "                         a default name will be used\n"
         "                         (*.qch for *.qhp and *.qhc for *.qhcp).\n"
+        "                         If several files are given, they are\n"
+        "                         generated at the same time, each with\n"
+        "                         its default output file name.\n"
         "  -c                     Checks whether all links in HTML files\n"
         "                         point to files in this help project.\n"
         "  -s                     Suppresses status messages.\n"
+        "  -u                     Reuses the compressed data of unchanged\n"
+        "                         files from existing Qt compressed help\n"
+        "                         files (*.qch) that are regenerated.\n"
+        "  -jobs <count>          Uses up to <count> threads, shared by\n"
+        "                         the files that are generated. The\n"
+        "                         default is the number of cores.\n"
         "  -v                     Displays the version of \n"
         "                         qhelpgenerator.\n\n");
 
@@ -354,57 +452,25 @@ int main(int argc, char *argv[])
         return 1;
     }
 
-    // detect input file type (qhp or qhcp)
-
-    QFile file(inputFile);
-    if (!file.open(QIODevice::ReadOnly)) {
-        fputs(qPrintable(QHG::tr("Could not open %1.\n").arg(inputFile)), stderr);
-        return 1;
-    }
-
-    const QString outputExtension = inputType == InputQhp ? QCH : QHC;
-
-    if (outputFile.isEmpty()) {
-        if (inputType == InputQhcp || !checkLinks) {
-            QFileInfo fi(inputFile);
-            outputFile = basePath + QDir::separator()
-                             + fi.baseName() + QLatin1Char('.') + outputExtension;
-        }
-    } else {
-        // check if the output dir exists -- create if it doesn't
-        QFileInfo fi(outputFile);
-        QDir parentDir = fi.dir();
-        if (!parentDir.exists()) {
-            if (!parentDir.mkpath(QLatin1String("."))) {
-                fputs(qPrintable(QHG::tr("Could not create output directory: %1\n")
-                                 .arg(parentDir.path())), stderr);
-            }
-        }
-    }
-
-    if (inputType == InputQhp) {
-        QHelpProjectData *helpData = new QHelpProjectData();
-        if (!helpData->readData(inputFile)) {
-            fprintf(stderr, "%s\n", qPrintable(helpData->errorMessage()));
-            return 1;
-        }
-
-        HelpGenerator generator(silent);
-        bool success = true;
-        if (checkLinks)
-            success = generator.checkLinks(*helpData);
-        if (success && !outputFile.isEmpty())
-            success = generator.generate(helpData, outputFile);
-        delete helpData;
-        if (!success) {
-            fprintf(stderr, "%s\n", qPrintable(generator.error()));
-            return 1;
-        }
-    } else {
-        const QByteArray data = file.readAll();
-        return generateCollectionFile(data, basePath, outputFile);
-
+    options.threadCount = jobs;
+    if (inputFiles.count() == 1)
+        return processInputFile(inputFiles.first(), outputFile, options);
+
+    // Generate several projects at the same time, with the threads shared
+    // between them, so that the startup of one tool invocation per project
+    // is paid only once.
+    const int projectJobs = qBound(1, jobs, int(inputFiles.count()));
+    options.threadCount = qMax(1, jobs / projectJobs);
+    std::atomic<int> result(0);
+    QThreadPool pool;
+    pool.setMaxThreadCount(projectJobs);
+    for (const QString &inputFile : qAsConst(inputFiles)) {
+        pool.start([&options, &result, inputFile]() {
+            if (processInputFile(inputFile, QString(), options) != 0)
+                result = 1;
+        });
     }
+    pool.waitForDone();
 
-    return 0;
+    return result;
 }
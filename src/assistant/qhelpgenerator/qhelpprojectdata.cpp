@@ -55,7 +55,7 @@ QT_BEGIN_NAMESPACE
 class QHelpProjectDataPrivate : public QXmlStreamReader
 {
 public:
-    void readData(const QByteArray &contents);
+    void readData(QIODevice *device);
 
     QString virtualFolder;
     QString namespaceName;
@@ -92,9 +92,11 @@ void QHelpProjectDataPrivate::skipUnknownToken()
     skipCurrentElement();
 }
 
-void QHelpProjectDataPrivate::readData(const QByteArray &contents)
+void QHelpProjectDataPrivate::readData(QIODevice *device)
 {
-    addData(contents);
+    // Read from the device in chunks instead of holding the whole file in
+    // memory next to the data parsed from it.
+    setDevice(device);
     while (!atEnd()) {
         readNext();
         if (isStartElement()) {
@@ -206,8 +208,9 @@ void QHelpProjectDataPrivate::readTOC()
         readNext();
         if (isStartElement()) {
             if (name() == QLatin1String("section")) {
-                const QString &title = attributes().value(QLatin1String("title")).toString();
-                const QString &ref = attributes().value(QLatin1String("ref")).toString();
+                const QXmlStreamAttributes attrs = attributes();
+                const QString title = attrs.value(QLatin1String("title")).toString();
+                const QString ref = attrs.value(QLatin1String("ref")).toString();
                 if (contentStack.isEmpty()) {
                     itm = new QHelpDataContentItem(nullptr, title, ref);
                     filterSectionList.last().addContent(itm);
@@ -245,19 +248,21 @@ static inline QString msgMissingAttribute(const QString &fileName, qint64 lineNu
 
 void QHelpProjectDataPrivate::readKeywords()
 {
+    // Projects generated by qdoc have many thousands of keywords.
+    QHelpDataFilterSection &filterSection = filterSectionList.last();
     while (!atEnd()) {
         readNext();
         if (isStartElement()) {
             if (name() == QLatin1String("keyword")) {
-                const QString &refAttribute = attributes().value(QStringLiteral("ref")).toString();
-                const QString &nameAttribute = attributes().value(QStringLiteral("name")).toString();
-                const QString &idAttribute = attributes().value(QStringLiteral("id")).toString();
+                const QXmlStreamAttributes attrs = attributes();
+                const QString refAttribute = attrs.value(QLatin1String("ref")).toString();
+                const QString nameAttribute = attrs.value(QLatin1String("name")).toString();
+                const QString idAttribute = attrs.value(QLatin1String("id")).toString();
                 if (refAttribute.isEmpty() || (nameAttribute.isEmpty() && idAttribute.isEmpty())) {
                     qWarning("%s", qPrintable(msgMissingAttribute(fileName, lineNumber(), nameAttribute)));
                     continue;
                 }
-                filterSectionList.last()
-                    .addIndex(QHelpDataIndexItem(nameAttribute, idAttribute, refAttribute));
+                filterSection.addIndex(QHelpDataIndexItem(nameAttribute, idAttribute, refAttribute));
             } else {
                 skipUnknownToken();
             }
@@ -400,7 +405,7 @@ bool QHelpProjectData::readData(const QString &fileName)
         return false;
     }
 
-    d->readData(file.readAll());
+    d->readData(&file);
     return !d->hasError();
 }
 
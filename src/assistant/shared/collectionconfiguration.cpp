@@ -39,6 +39,8 @@
 
 #include "collectionconfiguration.h"
 
+#include <QtCore/QDataStream>
+
 #include <QtHelp/QHelpEngineCore>
 
 QT_BEGIN_NAMESPACE
@@ -61,6 +63,7 @@ namespace {
     const QString LastPageKey(QLatin1String("LastTabPage"));
     const QString LastRegisterTime(QLatin1String("LastRegisterTime"));
     const QString LastShownPagesKey(QLatin1String("LastShownPages"));
+    const QString LastShownPageTitlesKey(QLatin1String("LastShownPageTitles"));
     const QString LastZoomFactorsKey(QLatin1String(
 #if defined(BROWSER_QTWEBKIT)
             "LastPagesZoomWebView"
@@ -249,6 +252,24 @@ void CollectionConfiguration::setLastShownPages(QHelpEngineCore &helpEngine,
                               lastShownPages.join(ListSeparator));
 }
 
+const QStringList CollectionConfiguration::lastShownPageTitles(const QHelpEngineCore &helpEngine)
+{
+    // titles may contain the list separator, so they are stored as a stream
+    QStringList titles;
+    QDataStream stream(helpEngine.customValue(LastShownPageTitlesKey).toByteArray());
+    stream >> titles;
+    return titles;
+}
+
+void CollectionConfiguration::setLastShownPageTitles(QHelpEngineCore &helpEngine,
+                                                     const QStringList &titles)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << titles;
+    helpEngine.setCustomValue(LastShownPageTitlesKey, data);
+}
+
 const QStringList CollectionConfiguration::lastZoomFactors(const QHelpEngineCore &helpEngine)
 {
     return helpEngine.customValue(LastZoomFactorsKey).toString().
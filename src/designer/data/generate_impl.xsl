@@ -236,10 +236,11 @@
         </xsl:if>
     </xsl:template>
 
+    <!-- Dispatch for one child element within the switch on the tag length -->
     <xsl:template name="read-impl-load-child-element">
         <xsl:param name="node"/>
 
-        <xsl:for-each select="$node/xs:element">
+        <xsl:for-each select="$node">
             <xsl:variable name="camel-case-name">
                 <xsl:call-template name="camel-case">
                     <xsl:with-param name="text" select="@name"/>
@@ -263,7 +264,7 @@
             </xsl:variable>
             <xsl:variable name="array" select="@maxOccurs = 'unbounded'"/>
 
-            <xsl:text>            if (!tag.compare(</xsl:text>
+            <xsl:text>                if (!tag.compare(</xsl:text>
             <xsl:call-template name="string-constant-for-comparison">
                 <xsl:with-param name="literal" select="$lower-name"/>
             </xsl:call-template>
@@ -271,10 +272,10 @@
 
             <xsl:choose>
                 <xsl:when test="@use='deprecated'">
-                    <xsl:text>                qWarning("Omitting deprecated element &lt;</xsl:text>
+                    <xsl:text>                    qWarning("Omitting deprecated element &lt;</xsl:text>
                     <xsl:value-of select="$lower-name"/>
                     <xsl:text>&gt;.");&endl;</xsl:text>
-                    <xsl:text>                reader.skipCurrentElement();&endl;</xsl:text>
+                    <xsl:text>                    reader.skipCurrentElement();&endl;</xsl:text>
                 </xsl:when>
                 <xsl:when test="not($array) and $xs-type-cat = 'value'">
                     <xsl:variable name="qstring-func">
@@ -284,7 +285,7 @@
                         </xsl:call-template>
                     </xsl:variable>
 
-                    <xsl:text>                setElement</xsl:text>
+                    <xsl:text>                    setElement</xsl:text>
                     <xsl:value-of select="$cap-name"/>
                     <xsl:text>(</xsl:text>
                     <xsl:value-of select="$qstring-func"/>
@@ -298,35 +299,35 @@
                         </xsl:call-template>
                     </xsl:variable>
 
-                    <xsl:text>                m_</xsl:text>
+                    <xsl:text>                    m_</xsl:text>
                     <xsl:value-of select="$camel-case-name"/>
                     <xsl:text>.append(</xsl:text>
                     <xsl:value-of select="$qstring-func"/>
                     <xsl:text>);&endl;</xsl:text>
                 </xsl:when>
                 <xsl:when test="not(@maxOccurs='unbounded') and $xs-type-cat = 'pointer'">
-                    <xsl:text>                auto</xsl:text>
+                    <xsl:text>                    auto</xsl:text>
                     <xsl:text> *v = new Dom</xsl:text>
                     <xsl:value-of select="@type"/>
                     <xsl:text>();&endl;</xsl:text>
-                    <xsl:text>                v->read(reader);&endl;</xsl:text>
-                    <xsl:text>                setElement</xsl:text>
+                    <xsl:text>                    v->read(reader);&endl;</xsl:text>
+                    <xsl:text>                    setElement</xsl:text>
                     <xsl:value-of select="$cap-name"/>
                     <xsl:text>(v);&endl;</xsl:text>
                 </xsl:when>
                 <xsl:when test="@maxOccurs='unbounded' and $xs-type-cat = 'pointer'">
-                    <xsl:text>                auto</xsl:text>
+                    <xsl:text>                    auto</xsl:text>
                     <xsl:text> *v = new Dom</xsl:text>
                     <xsl:value-of select="@type"/>
                     <xsl:text>();&endl;</xsl:text>
-                    <xsl:text>                v->read(reader);&endl;</xsl:text>
-                    <xsl:text>                m_</xsl:text>
+                    <xsl:text>                    v->read(reader);&endl;</xsl:text>
+                    <xsl:text>                    m_</xsl:text>
                     <xsl:value-of select="$camel-case-name"/>
                     <xsl:text>.append(v);&endl;</xsl:text>
                 </xsl:when>
             </xsl:choose>
-            <xsl:text>                continue;&endl;</xsl:text>
-            <xsl:text>            }&endl;</xsl:text>
+            <xsl:text>                    continue;&endl;</xsl:text>
+            <xsl:text>                }&endl;</xsl:text>
         </xsl:for-each>
     </xsl:template>
 
@@ -349,11 +350,30 @@
         <xsl:text>        case QXmlStreamReader::StartElement : {&endl;</xsl:text>
         <xsl:text>            const auto tag = reader.name();&endl;</xsl:text>
 
-        <xsl:for-each select="$node//xs:sequence | $node//xs:choice | $node//xs:all">
-            <xsl:call-template name="read-impl-load-child-element">
-                <xsl:with-param name="node" select="."/>
-            </xsl:call-template>
-        </xsl:for-each>
+        <!-- Switch on the length of the tag first, so that only the few
+             names of that length are compared case-insensitively -->
+        <xsl:variable name="elements" select="$node//xs:sequence/xs:element | $node//xs:choice/xs:element | $node//xs:all/xs:element"/>
+        <xsl:if test="$elements">
+            <xsl:text>            switch (tag.size()) {&endl;</xsl:text>
+            <xsl:for-each select="$elements">
+                <xsl:variable name="pos" select="position()"/>
+                <xsl:variable name="length" select="string-length(@name)"/>
+                <xsl:if test="not($elements[position() &lt; $pos and string-length(@name) = $length])">
+                    <xsl:text>            case </xsl:text>
+                    <xsl:value-of select="$length"/>
+                    <xsl:text>:&endl;</xsl:text>
+                    <xsl:for-each select="$elements[string-length(@name) = $length]">
+                        <xsl:call-template name="read-impl-load-child-element">
+                            <xsl:with-param name="node" select="."/>
+                        </xsl:call-template>
+                    </xsl:for-each>
+                    <xsl:text>                break;&endl;</xsl:text>
+                </xsl:if>
+            </xsl:for-each>
+            <xsl:text>            default:&endl;</xsl:text>
+            <xsl:text>                break;&endl;</xsl:text>
+            <xsl:text>            }&endl;</xsl:text>
+        </xsl:if>
 
         <xsl:text>            reader.raiseError(QLatin1String("Unexpected element ") + tag);&endl;</xsl:text>
         <xsl:text>        }&endl;</xsl:text>
@@ -971,6 +971,11 @@ void FormWindow::raiseSelection(QWidget *w)
 
 void FormWindow::updateSelection(QWidget *w)
 {
+    // Many widgets are resized at once, update the selection when done.
+    if (isBatchChange()) {
+        checkSelection();
+        return;
+    }
     if (!w->isVisibleTo(this)) {
         selectWidget(w, false);
     } else {
@@ -1656,14 +1661,34 @@ void FormWindow::setFileName(const QString &fileName)
 
 QString FormWindow::contents() const
 {
-    QBuffer b;
-    if (!mainContainer() || !b.open(QIODevice::WriteOnly))
+    // Saving, backups and previews of an unchanged form share the DOM
+    // snapshot, the XML is only written once per change.
+    const QSharedPointer<DomUI> ui = domSnapshot();
+    if (ui.isNull())
         return QString();
+    if (ui != m_contentsDom) {
+        QBuffer b;
+        if (!b.open(QIODevice::WriteOnly))
+            return QString();
+        QXmlStreamWriter writer(&b);
+        writer.setAutoFormatting(true);
+        writer.setAutoFormattingIndent(1);
+        writer.writeStartDocument();
+        ui->write(writer);
+        writer.writeEndDocument();
+        m_contents = QString::fromUtf8(b.buffer());
+        m_contentsDom = ui;
+    }
+    return m_contents;
+}
 
-    QDesignerResource resource(const_cast<FormWindow*>(this));
-    resource.save(&b, mainContainer());
+DomUI *FormWindow::createDomUi() const
+{
+    if (!mainContainer())
+        return nullptr;
 
-    return QString::fromUtf8(b.buffer());
+    QDesignerResource resource(const_cast<FormWindow*>(this));
+    return resource.saveUi(mainContainer());
 }
 
 #if QT_CONFIG(clipboard)
@@ -2153,12 +2178,19 @@ bool FormWindow::handleContextMenu(QWidget *, QWidget *managedWidget, QContextMe
 bool FormWindow::setContents(QIODevice *dev, QString *errorMessageIn /* = 0 */)
 {
     QDesignerResource r(this);
-    QScopedPointer<DomUI> ui(r.readUi(dev));
-    if (ui.isNull()) {
+    DomUI *ui = r.readUi(dev);
+    if (ui == nullptr) {
         if (errorMessageIn)
             *errorMessageIn = r.errorString();
         return false;
     }
+    return setContents(ui, errorMessageIn);
+}
+
+bool FormWindow::setContents(DomUI *domUi, QString *errorMessageIn)
+{
+    QScopedPointer<DomUI> ui(domUi);
+    QDesignerResource r(this);
 
     UpdateBlocker ub(this);
     clearSelection();
@@ -2474,10 +2506,14 @@ bool FormWindow::isDirty() const
 
 void FormWindow::setDirty(bool dirty)
 {
-    if (dirty)
+    // Changes of the form settings are not commands and emit changed()
+    // only when the form was clean.
+    if (dirty) {
+        invalidateDomSnapshot();
         m_undoStack.resetClean();
-    else
+    } else {
         m_undoStack.setClean();
+    }
 }
 
 QWidget *FormWindow::containerAt(const QPoint &pos)
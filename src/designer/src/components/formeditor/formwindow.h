@@ -120,6 +120,7 @@ public:
     QString contents() const override;
     bool setContents(QIODevice *dev, QString *errorMessage = nullptr) override;
     bool setContents(const QString &) override;
+    bool setContents(DomUI *ui, QString *errorMessage) override;
 
     QDir absoluteDir() const override;
 
@@ -232,6 +233,7 @@ public slots:
 protected:
     virtual QMenu *createPopupMenu(QWidget *w);
     void resizeEvent(QResizeEvent *e) override;
+    DomUI *createDomUi() const override;
 
     void insertWidget(QWidget *w, const QRect &rect, QWidget *target, bool already_in_form = false);
 
@@ -339,6 +341,9 @@ private:
     QUndoStack m_undoStack;
 
     QString m_fileName;
+    // XML written for the DOM snapshot m_contentsDom
+    mutable QSharedPointer<DomUI> m_contentsDom;
+    mutable QString m_contents;
 
     using PaletteAndFill = QPair<QPalette ,bool>;
     using WidgetPaletteMap = QMap<QWidget*, PaletteAndFill>;
@@ -472,7 +472,29 @@ static inline QString messageBoxTitle()
 
 void QDesignerResource::save(QIODevice *dev, QWidget *widget)
 {
-    QAbstractFormBuilder::save(dev, widget);
+    QScopedPointer<DomUI> ui(saveUi(widget));
+
+    QXmlStreamWriter writer(dev);
+    writer.setAutoFormatting(true);
+    writer.setAutoFormattingIndent(1);
+    writer.writeStartDocument();
+    ui->write(writer);
+    writer.writeEndDocument();
+}
+
+DomUI *QDesignerResource::saveUi(QWidget *widget)
+{
+    DomWidget *ui_widget = createDom(widget, nullptr);
+    Q_ASSERT( ui_widget != nullptr );
+
+    DomUI *ui = new DomUI();
+    ui->setAttributeVersion(QStringLiteral("4.0"));
+    ui->setElementWidget(ui_widget);
+
+    saveDom(ui, widget);
+
+    d->m_laidout.clear();
+    return ui;
 }
 
 void QDesignerResource::saveDom(DomUI *ui, QWidget *widget)
@@ -2116,6 +2138,8 @@ void QDesignerResource::createResources(DomResources *resources)
         m_formWindow->setResourceSet(resourceSet);
         QObject::connect(m_formWindow->core()->resourceModel(), &QtResourceModel::resourceSetActivated,
                 m_formWindow, &FormWindowBase::resourceSetActivated);
+        QObject::connect(m_formWindow->core()->resourceModel(), &QtResourceModel::resourceSetReloaded,
+                m_formWindow, &FormWindowBase::resourceSetReloaded);
     }
 }
 
@@ -80,6 +80,8 @@ public:
 
     DomUI *readUi(QIODevice *dev);
     QWidget *loadUi(DomUI *ui, QWidget *parentWidget);
+    // Create the DOM written by save()
+    DomUI *saveUi(QWidget *widget);
 
 protected:
     using QEditorFormBuilder::create;
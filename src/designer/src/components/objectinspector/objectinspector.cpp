@@ -64,6 +64,7 @@
 #include <QtCore/qdebug.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qsortfilterproxymodel.h>
+#include <QtCore/qtimer.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -215,6 +216,7 @@ public:
 
 private:
     void setFormWindowBlocked(QDesignerFormWindowInterface *fwi);
+    void scheduleUpdate();
     void applyCursorSelection();
     void synchronizeSelection(const QItemSelection & selected, const QItemSelection &deselected);
     bool checkManagedWidgetSelection(const QModelIndexList &selection);
@@ -230,7 +232,9 @@ private:
     QSortFilterProxyModel *m_filterModel;
     QPointer<FormWindowBase> m_formWindow;
     QPointer<QWidget> m_formFakeDropTarget;
+    QMetaObject::Connection m_formWindowChangedConnection;
     bool m_withinClearSelection;
+    bool m_updatePending = false;
 };
 
 ObjectInspector::ObjectInspectorPrivate::ObjectInspectorPrivate(QDesignerFormEditorInterface *core) :
@@ -505,8 +509,15 @@ void ObjectInspector::ObjectInspectorPrivate::setFormWindowBlocked(QDesignerForm
     const int xoffset = m_treeView->horizontalScrollBar()->value();
     const int yoffset = m_treeView->verticalScrollBar()->value();
 
-    if (formWindowChanged)
+    if (formWindowChanged) {
         m_formFakeDropTarget = nullptr;
+        QObject::disconnect(m_formWindowChangedConnection);
+        if (fw) {
+            m_formWindowChangedConnection =
+                QObject::connect(fw, &QDesignerFormWindowInterface::changed,
+                                 m_treeView, [this] { scheduleUpdate(); });
+        }
+    }
 
     switch (m_model->update(m_formWindow)) {
     case ObjectInspectorModel::NoForm:
@@ -540,11 +551,29 @@ void ObjectInspector::ObjectInspectorPrivate::setFormWindowBlocked(QDesignerForm
         }
         if (applySelection)
             applyCursorSelection();
+        // Expand rows inserted incrementally
+        const QModelIndexList insertedIndexes = m_model->takeInsertedIndexes();
+        for (const QModelIndex &index : insertedIndexes)
+            m_treeView->expandRecursively(m_filterModel->mapFromSource(index));
     }
         break;
     }
 }
 
+// Commands may change the object tree without the form window being set
+// again; pick up the changes once control returns to the event loop.
+void ObjectInspector::ObjectInspectorPrivate::scheduleUpdate()
+{
+    if (m_updatePending)
+        return;
+    m_updatePending = true;
+    QTimer::singleShot(0, m_treeView, [this] {
+        m_updatePending = false;
+        if (m_formWindow)
+            setFormWindow(m_formWindow);
+    });
+}
+
 // Apply selection of form window cursor to object inspector, set current
 void ObjectInspector::ObjectInspectorPrivate::applyCursorSelection()
 {
@@ -36,6 +36,7 @@
 
 #include <QtDesigner/abstractformeditor.h>
 #include <QtDesigner/abstractformwindow.h>
+#include <QtDesigner/abstractintegration.h>
 #include <QtDesigner/abstractwidgetdatabase.h>
 #include <QtDesigner/container.h>
 #include <QtDesigner/abstractmetadatabase.h>
@@ -47,7 +48,6 @@
 
 #include <QtGui/qaction.h>
 
-#include <QtCore/qset.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qcoreapplication.h>
 
@@ -127,8 +127,9 @@ namespace qdesigner_internal {
     // As a tree is difficult to represent, a flat list of entries (ObjectData)
     // containing object and parent object is used.
     // ObjectData has an overloaded operator== that compares the object pointers.
-    // Structural changes which cause a rebuild can be detected by
-    // comparing the lists of ObjectData. If it is the same, only the item data (class name [changed by promotion],
+    // The items of a new model are matched against the existing rows per parent,
+    // so that structural changes only insert or remove the affected rows. For the
+    // matched rows, only the item data (class name [changed by promotion],
     // object name and icon) are checked and the existing items are updated.
 
     ObjectData::ObjectData() = default;
@@ -221,6 +222,14 @@ namespace qdesigner_internal {
         return rc;
     }
 
+    bool ObjectData::setObjectName(const QString &name)
+    {
+        if (m_type == SeparatorAction || m_type == LayoutWidget || m_objectName == name)
+            return false;
+        m_objectName = name;
+        return true;
+    }
+
     void ObjectData::setItemsDisplayData(const StandardItemList &row, const ObjectInspectorIcons &icons, unsigned mask) const
     {
         if (mask & ObjectNameChanged)
@@ -342,37 +351,89 @@ namespace qdesigner_internal {
     void ObjectInspectorModel::clearItems()
     {
         beginResetModel();
-        m_objectIndexMultiMap.clear();
-        m_model.clear();
+        m_objectIndexHash.clear();
+        m_objectData.clear();
+        m_insertedIndexes.clear();
         endResetModel(); // force editors to be closed in views
         removeRow(0);
     }
 
+    void ObjectInspectorModel::setFormWindow(QDesignerFormWindowInterface *fw)
+    {
+        for (const QMetaObject::Connection &connection : qAsConst(m_formWindowConnections))
+            disconnect(connection);
+        m_formWindowConnections.clear();
+        m_formWindow = fw;
+        m_structureChanged = true;
+        if (!fw)
+            return;
+        // Any command may change the structure in ways not signalled below
+        // (reparenting, promotion); the next update() walks the tree again.
+        m_formWindowConnections.append(connect(fw, &QDesignerFormWindowInterface::changed,
+                                               this, [this] { m_structureChanged = true; }));
+        m_formWindowConnections.append(connect(fw, &QDesignerFormWindowInterface::widgetManaged,
+                                               this, &ObjectInspectorModel::slotWidgetManaged));
+        m_formWindowConnections.append(connect(fw, &QDesignerFormWindowInterface::widgetUnmanaged,
+                                               this, &ObjectInspectorModel::slotObjectRemoved));
+        m_formWindowConnections.append(connect(fw, &QDesignerFormWindowInterface::objectRemoved,
+                                               this, &ObjectInspectorModel::slotObjectRemoved));
+        if (QDesignerIntegrationInterface *integration = fw->core()->integration()) {
+            m_formWindowConnections.append(connect(integration, &QDesignerIntegrationInterface::objectNameChanged,
+                                                   this, &ObjectInspectorModel::slotObjectNameChanged));
+        }
+    }
+
+    void ObjectInspectorModel::createModel(QObject *parent, QObject *object, ObjectModel &model) const
+    {
+        static const QString separator = QCoreApplication::translate("ObjectInspectorModel", "separator");
+        const ModelRecursionContext ctx(m_formWindow->core(),  separator);
+        createModelRecursion(m_formWindow, parent, object, model, ctx);
+    }
+
     ObjectInspectorModel::UpdateResult ObjectInspectorModel::update(QDesignerFormWindowInterface *fw)
     {
         QWidget *mainContainer = fw ? fw->mainContainer() : nullptr;
         if (!mainContainer) {
             clearItems();
-            m_formWindow = nullptr;
+            setFormWindow(nullptr);
             return NoForm;
         }
-        m_formWindow = fw;
-        // Build new model and compare to previous one. If the structure is
-        // identical, just update, else rebuild
+        if (fw != m_formWindow)
+            setFormWindow(fw);
+        else if (!m_structureChanged && rowCount() != 0)
+            return Updated; // Selection change, nothing to walk
+
+        m_structureChanged = false;
+        // Build new model and match it against the existing items. If the form
+        // changed, rebuild.
         ObjectModel newModel;
+        createModel(nullptr, mainContainer, newModel);
 
-        static const QString separator = QCoreApplication::translate("ObjectInspectorModel", "separator");
-        const ModelRecursionContext ctx(fw->core(),  separator);
-        createModelRecursion(fw, nullptr, mainContainer, newModel, ctx);
-
-        if (newModel == m_model) {
-            updateItemContents(m_model, newModel);
-            return Updated;
+        if (rowCount() == 0) {
+            rebuild(newModel);
+            return Rebuilt;
         }
+        return synchronize(newModel);
+    }
 
-        rebuild(newModel);
-        m_model = newModel;
-        return Rebuilt;
+    const QModelIndexList ObjectInspectorModel::indexesOf(QObject *o) const
+    {
+        QModelIndexList rc;
+        const auto indexes = m_objectIndexHash.values(o);
+        for (const QPersistentModelIndex &index : indexes)
+            rc.append(index);
+        return rc;
+    }
+
+    QModelIndexList ObjectInspectorModel::takeInsertedIndexes()
+    {
+        QModelIndexList rc;
+        for (const QPersistentModelIndex &index : qAsConst(m_insertedIndexes)) {
+            if (index.isValid())
+                rc.append(index);
+        }
+        m_insertedIndexes.clear();
+        return rc;
     }
 
     QObject *ObjectInspectorModel::objectAt(const QModelIndex &index) const
@@ -397,58 +458,173 @@ namespace qdesigner_internal {
         return rc;
     }
 
+    // Determine the child entries of each entry of a model built by
+    // createModelRecursion(). As objects like menus may occur several
+    // times, the parent is the last occurrence preceding the entry.
+    static QList<QList<int>> childEntries(const ObjectModel &model)
+    {
+        const int size = model.size();
+        QList<QList<int>> rc(size);
+        QHash<QObject *, int> lastEntries;
+        for (int i = 0; i < size; ++i) {
+            const ObjectData &entry = model.at(i);
+            if (i > 0) {
+                const int parentEntry = lastEntries.value(entry.parent(), -1);
+                if (parentEntry >= 0)
+                    rc[parentEntry].append(i);
+            }
+            lastEntries.insert(entry.object(), i);
+        }
+        return rc;
+    }
+
+    // Append a row for an entry and its children to parentItem (or the top level)
+    QStandardItem *ObjectInspectorModel::appendEntry(QStandardItem *parentItem, const ObjectModel &model,
+                                                     const ChildEntries &children, int entry)
+    {
+        const ObjectData &data = model.at(entry);
+        StandardItemList row = createModelRow(data.object());
+        data.setItems(row, m_icons);
+        if (parentItem)
+            parentItem->appendRow(row);
+        else
+            appendRow(row);
+        QStandardItem *item = row.constFirst();
+        m_objectIndexHash.insert(data.object(), indexFromItem(item));
+        m_objectData.insert(data.object(), data);
+        for (int child : children.at(entry))
+            appendEntry(item, model, children, child);
+        return item;
+    }
+
+    // Remove an item and its children from the index hash
+    void ObjectInspectorModel::forgetItem(QStandardItem *item)
+    {
+        for (int r = 0, count = item->rowCount(); r < count; ++r)
+            forgetItem(item->child(r));
+        QObject *object = objectOfItem(item);
+        m_objectIndexHash.remove(object, QPersistentModelIndex(indexFromItem(item)));
+        if (!m_objectIndexHash.contains(object))
+            m_objectData.remove(object);
+    }
+
+    void ObjectInspectorModel::removeItemRow(QStandardItem *parentItem, int row)
+    {
+        forgetItem(parentItem ? parentItem->child(row) : item(row));
+        if (parentItem)
+            parentItem->removeRow(row);
+        else
+            removeRow(row);
+    }
+
     // Rebuild the tree in case the model has completely changed.
     void ObjectInspectorModel::rebuild(const ObjectModel &newModel)
     {
         clearItems();
         if (newModel.isEmpty())
             return;
+        appendEntry(nullptr, newModel, childEntries(newModel), 0);
+    }
 
-        const ObjectModel::const_iterator mcend = newModel.constEnd();
-        ObjectModel::const_iterator it = newModel.constBegin();
-        // Set up root element
-        StandardItemList rootRow = createModelRow(it->object());
-        it->setItems(rootRow, m_icons);
-        appendRow(rootRow);
-        m_objectIndexMultiMap.insert(it->object(), indexFromItem(rootRow.constFirst()));
-        for (++it; it != mcend; ++it) {
-            // Add to parent item, found via map
-            const QModelIndex parentIndex = m_objectIndexMultiMap.value(it->parent(), QModelIndex());
-            Q_ASSERT(parentIndex.isValid());
-            QStandardItem *parentItem = itemFromIndex(parentIndex);
-            StandardItemList row = createModelRow(it->object());
-            it->setItems(row, m_icons);
-            parentItem->appendRow(row);
-            m_objectIndexMultiMap.insert(it->object(), indexFromItem(row.constFirst()));
+    // Match the new model against the existing items, inserting and removing
+    // rows where the structure differs and updating the item data otherwise.
+    ObjectInspectorModel::UpdateResult ObjectInspectorModel::synchronize(const ObjectModel &newModel)
+    {
+        QStandardItem *rootItem = item(0);
+        if (newModel.isEmpty() || rowCount() != 1 || objectOfItem(rootItem) != newModel.constFirst().object()) {
+            rebuild(newModel);
+            return Rebuilt;
+        }
+
+        // Determine the changed data per object once
+        // as for example actions might occur several times in the tree.
+        const unsigned allChanged = ObjectData::ClassNameChanged|ObjectData::ObjectNameChanged
+            |ObjectData::ClassIconChanged|ObjectData::TypeChanged|ObjectData::LayoutTypeChanged;
+        QHash<QObject *, unsigned> changedMasks;
+        for (const ObjectData &entry : newModel) {
+            QObject *object = entry.object();
+            if (!changedMasks.contains(object)) {
+                const auto it = m_objectData.constFind(object);
+                changedMasks.insert(object, it != m_objectData.cend() ? it->compare(entry) : allChanged);
+            }
         }
+
+        synchronizeRow(rootItem, newModel, childEntries(newModel), 0, changedMasks);
+
+        m_objectData.clear();
+        for (const ObjectData &entry : newModel)
+            m_objectData.insert(entry.object(), entry);
+        return Updated;
     }
 
-    // Update item data in case the model has the same structure
-    void ObjectInspectorModel::updateItemContents(ObjectModel &oldModel, const ObjectModel &newModel)
+    void ObjectInspectorModel::synchronizeRow(QStandardItem *item, const ObjectModel &newModel,
+                                              const ChildEntries &children, int entry,
+                                              const QHash<QObject *, unsigned> &changedMasks)
     {
-        // Change text and icon. Keep a set of changed object
-        // as for example actions might occur several times in the tree.
-        using QObjectSet = QSet<QObject *>;
-
-        QObjectSet changedObjects;
-
-        const int size = newModel.size();
-        Q_ASSERT(oldModel.size() ==  size);
-        for (int i = 0; i < size; i++) {
-            const ObjectData &newEntry = newModel[i];
-            ObjectData &entry =  oldModel[i];
-            // Has some data changed?
-            if (const unsigned changedMask = entry.compare(newEntry)) {
-                entry = newEntry;
-                QObject * o = entry.object();
-                if (!changedObjects.contains(o)) {
-                    changedObjects.insert(o);
-                    const QModelIndexList indexes =  m_objectIndexMultiMap.values(o);
-                    for (const QModelIndex &index : indexes)
-                        entry.setItemsDisplayData(rowAt(index), m_icons, changedMask);
-                }
+        const ObjectData &data = newModel.at(entry);
+        if (const unsigned changedMask = changedMasks.value(data.object()))
+            data.setItemsDisplayData(rowAt(indexFromItem(item)), m_icons, changedMask);
+
+        // The view sorts, so the order of the rows does not matter.
+        QList<int> pending = children.at(entry);
+        for (int r = item->rowCount() - 1; r >= 0; --r) {
+            QStandardItem *childItem = item->child(r);
+            QObject *childObject = objectOfItem(childItem);
+            const auto it = std::find_if(pending.begin(), pending.end(),
+                                         [&newModel, childObject] (int e) {
+                                             return newModel.at(e).object() == childObject;
+                                         });
+            if (it != pending.end()) {
+                const int childEntry = *it;
+                pending.erase(it);
+                synchronizeRow(childItem, newModel, children, childEntry, changedMasks);
+            } else {
+                removeItemRow(item, r);
             }
         }
+        for (int childEntry : qAsConst(pending))
+            m_insertedIndexes.append(indexFromItem(appendEntry(item, newModel, children, childEntry)));
+    }
+
+    // Incremental updates driven by the form window. A subsequent update()
+    // walking the tree corrects anything not represented exactly here.
+    void ObjectInspectorModel::slotWidgetManaged(QWidget *widget)
+    {
+        if (!m_formWindow || rowCount() == 0 || m_objectIndexHash.contains(widget))
+            return;
+        QWidget *parentWidget = widget->parentWidget();
+        while (parentWidget && !m_objectIndexHash.contains(parentWidget))
+            parentWidget = parentWidget->parentWidget();
+        if (!parentWidget)
+            return;
+
+        ObjectModel subModel;
+        createModel(parentWidget, widget, subModel);
+        const ChildEntries children = childEntries(subModel);
+        for (const QModelIndex &parentIndex : indexesOf(parentWidget))
+            m_insertedIndexes.append(indexFromItem(appendEntry(itemFromIndex(parentIndex), subModel, children, 0)));
+    }
+
+    void ObjectInspectorModel::slotObjectRemoved(QObject *object)
+    {
+        const auto indexes = m_objectIndexHash.values(object);
+        for (const QPersistentModelIndex &index : indexes) {
+            if (!index.isValid() || !index.parent().isValid())
+                continue; // Gone with a previous row or the main container
+            removeItemRow(itemFromIndex(index.parent()), index.row());
+        }
+    }
+
+    void ObjectInspectorModel::slotObjectNameChanged(QDesignerFormWindowInterface *fw, QObject *object,
+                                                     const QString &newName)
+    {
+        if (fw != m_formWindow)
+            return;
+        const auto it = m_objectData.find(object);
+        if (it == m_objectData.end() || !it->setObjectName(newName))
+            return;
+        for (const QModelIndex &index : indexesOf(object))
+            it->setItemsDisplayData(rowAt(index), m_icons, ObjectData::ObjectNameChanged);
     }
 
     QVariant ObjectInspectorModel::data(const QModelIndex &index, int role) const
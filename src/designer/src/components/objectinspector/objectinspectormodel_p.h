@@ -46,7 +46,7 @@
 #include <QtGui/qicon.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qlist.h>
-#include <QtCore/qmap.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qpointer.h>
 
 QT_BEGIN_NAMESPACE
@@ -92,6 +92,8 @@ namespace qdesigner_internal {
                            LayoutTypeChanged = 16};
 
         unsigned compare(const ObjectData & me) const;
+        // Apply a rename notification; returns false if the row does not display it.
+        bool setObjectName(const QString &name);
 
         // Initially set up a row
         void setItems(const StandardItemList &row, const ObjectInspectorIcons &icons) const;
@@ -117,7 +119,9 @@ namespace qdesigner_internal {
     using ObjectModel = QList<ObjectData>;
 
     // QStandardItemModel for ObjectInspector. Uses ObjectData/ObjectModel
-    // internally for its updates.
+    // internally for its updates. Insertions, removals and renames signalled
+    // by the form window are applied incrementally; the object tree is only
+    // walked again after the form has changed.
     class ObjectInspectorModel : public QStandardItemModel {
     public:
         using StandardItemList = QList<QStandardItem *>;
@@ -128,24 +132,43 @@ namespace qdesigner_internal {
         enum UpdateResult { NoForm, Rebuilt, Updated };
         UpdateResult update(QDesignerFormWindowInterface *fw);
 
-        const QModelIndexList indexesOf(QObject *o) const { return m_objectIndexMultiMap.values(o); }
+        const QModelIndexList indexesOf(QObject *o) const;
         QObject *objectAt(const QModelIndex &index) const;
+        // Top level indexes of the rows inserted incrementally since the last call
+        QModelIndexList takeInsertedIndexes();
 
         QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
         bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
 
     private:
-        typedef QMultiMap<QObject *,QModelIndex> ObjectIndexMultiMap;
+        using ObjectIndexHash = QMultiHash<QObject *, QPersistentModelIndex>;
+        using ObjectDataHash = QHash<QObject *, ObjectData>;
+        using ChildEntries = QList<QList<int>>;
 
+        void setFormWindow(QDesignerFormWindowInterface *fw);
+        void createModel(QObject *parent, QObject *object, ObjectModel &model) const;
         void rebuild(const ObjectModel &newModel);
-        void updateItemContents(ObjectModel &oldModel, const ObjectModel &newModel);
+        UpdateResult synchronize(const ObjectModel &newModel);
+        void synchronizeRow(QStandardItem *item, const ObjectModel &newModel, const ChildEntries &children,
+                            int entry, const QHash<QObject *, unsigned> &changedMasks);
+        QStandardItem *appendEntry(QStandardItem *parentItem, const ObjectModel &model,
+                                   const ChildEntries &children, int entry);
+        void removeItemRow(QStandardItem *parentItem, int row);
+        void forgetItem(QStandardItem *item);
         void clearItems();
         StandardItemList rowAt(QModelIndex index) const;
 
+        void slotWidgetManaged(QWidget *widget);
+        void slotObjectRemoved(QObject *object);
+        void slotObjectNameChanged(QDesignerFormWindowInterface *fw, QObject *object, const QString &newName);
+
         ObjectInspectorIcons m_icons;
-        ObjectIndexMultiMap m_objectIndexMultiMap;
-        ObjectModel m_model;
+        ObjectIndexHash m_objectIndexHash;
+        ObjectDataHash m_objectData;
+        QList<QPersistentModelIndex> m_insertedIndexes;
         QPointer<QDesignerFormWindowInterface> m_formWindow;
+        QList<QMetaObject::Connection> m_formWindowConnections;
+        bool m_structureChanged = true;
     };
 }  // namespace qdesigner_internal
 
@@ -69,6 +69,7 @@
 
 #include <QtCore/qdebug.h>
 #include <QtCore/qtextstream.h>
+#include <QtCore/qtimer.h>
 
 static const char *SettingsGroupC = "PropertyEditor";
 static const char *ViewKeyC = "View";
@@ -741,11 +742,49 @@ void PropertyEditor::setPropertyValue(const QString &name, const QVariant &value
     property->setModified(changed);
 }
 
+// Update the values of a property tree whose layout matches the sheet
+void PropertyEditor::updatePropertyValues(bool isMainContainer)
+{
+    const int stringTypeId = qMetaTypeId<PropertySheetStringValue>();
+    const int propertyCount = m_propertySheet->count();
+    for (int i = 0; i < propertyCount; ++i) {
+        if (!m_propertySheet->isVisible(i))
+            continue;
+        const QString propertyName = m_propertySheet->propertyName(i);
+        if (m_propertySheet->indexOf(propertyName) != i)
+            continue;
+        QtVariantProperty *property = m_nameToProperty.value(propertyName, nullptr);
+        if (property == nullptr)
+            continue;
+        const int type = property->propertyType();
+        if (type == QMetaType::QPalette)
+            setupPaletteProperty(property);
+        else if (type == QMetaType::QString || type == stringTypeId)
+            setupStringProperty(property, isMainContainer);
+        property->setAttribute(m_strings.m_resettableAttribute, m_propertySheet->hasReset(i));
+        updateBrowserValue(property, m_propertySheet->property(i));
+        property->setModified(m_propertySheet->isChanged(i));
+    }
+}
+
 /* Quick update that assumes the actual count of properties has not changed
- * N/A when for example executing a layout command and margin properties appear. */
+ * N/A when for example executing a layout command and margin properties appear.
+ * Commands changing several objects call this repeatedly, so the update is
+ * done once when returning to the event loop. */
 void PropertyEditor::updatePropertySheet()
 {
-    if (!m_propertySheet)
+    if (!m_propertySheet || m_propertySheetUpdatePending)
+        return;
+    m_propertySheetUpdatePending = true;
+    QTimer::singleShot(0, this, &PropertyEditor::doUpdatePropertySheet);
+}
+
+void PropertyEditor::doUpdatePropertySheet()
+{
+    if (!m_propertySheetUpdatePending)
+        return;
+    m_propertySheetUpdatePending = false;
+    if (!m_propertySheet || m_object.isNull())
         return;
 
     updateToolBarLabel();
@@ -902,6 +941,7 @@ void PropertyEditor::setObject(QObject *object)
     // In the first setObject() call following the addition of a dynamic property, focus and edit it.
     const bool editNewDynamicProperty = object != nullptr && m_object == object && !m_recentlyAddedDynamicProperty.isEmpty();
     m_object = object;
+    m_propertySheetUpdatePending = false; // Values are refreshed below
     m_propertyManager->setObject(object);
     QDesignerFormWindowInterface *formWindow = QDesignerFormWindowInterface::findFormWindow(m_object);
     // QTBUG-68507: Form window can be null for objects in Morph Undo macros with buddies
@@ -937,6 +977,7 @@ void PropertyEditor::setObject(QObject *object)
     QExtensionManager *m = m_core->extensionManager();
 
     m_propertySheet = qobject_cast<QDesignerPropertySheetExtension*>(m->extension(object, Q_TYPEID(QDesignerPropertySheetExtension)));
+    PropertyLayout propertyLayout;
     if (m_propertySheet) {
         const int stringTypeId = qMetaTypeId<PropertySheetStringValue>();
         const int propertyCount = m_propertySheet->count();
@@ -948,6 +989,10 @@ void PropertyEditor::setObject(QObject *object)
             if (m_propertySheet->indexOf(propertyName) != i)
                 continue;
             const QString groupName = m_propertySheet->propertyGroup(i);
+            const int type = toBrowserType(m_propertySheet->property(i), propertyName);
+            const bool dynamicProperty = (dynamicSheet && dynamicSheet->isDynamicProperty(i))
+                        || (sheet && sheet->isDefaultDynamicProperty(i));
+            propertyLayout.entries.append({propertyName, groupName, type, dynamicProperty});
             const QMap<QString, QtVariantProperty *>::const_iterator rit = toRemove.constFind(propertyName);
             if (rit != toRemove.constEnd()) {
                 QtVariantProperty *property = rit.value();
@@ -956,13 +1001,38 @@ void PropertyEditor::setObject(QObject *object)
                 // occurred since different sub-properties are used (disambiguation/id).
                 if (m_propertyToGroup.value(property) == groupName
                     && (idIdBasedTranslationUnchanged || propertyType != stringTypeId)
-                    && toBrowserType(m_propertySheet->property(i), propertyName) == propertyType) {
+                    && type == propertyType) {
                     toRemove.remove(propertyName);
                 }
             }
         }
     }
 
+    bool isMainContainer = false;
+    if (QWidget *widget = qobject_cast<QWidget*>(object)) {
+        if (QDesignerFormWindowInterface *fw = QDesignerFormWindowInterface::findFormWindow(widget)) {
+            isMainContainer = (fw->mainContainer() == widget);
+        }
+    }
+    if (m_propertySheet) {
+        propertyLayout.className = WidgetFactory::classNameOf(formWindow->core(), m_object);
+        propertyLayout.isMainContainer = isMainContainer;
+    }
+
+    // Selecting another object of the same class: The property tree can be
+    // kept, only the values need to be updated.
+    if (m_propertySheet && oldFormWindow == formWindow && idIdBasedTranslationUnchanged
+        && propertyLayout == m_propertyLayout) {
+        updatePropertyValues(isMainContainer);
+        const bool addEnabled = dynamicSheet ? dynamicSheet->dynamicPropertiesAllowed() : false;
+        m_addDynamicAction->setEnabled(addEnabled);
+        m_removeDynamicAction->setEnabled(false);
+        m_recentlyAddedDynamicProperty.clear();
+        m_filterWidget->setEnabled(object);
+        return;
+    }
+    m_propertyLayout = propertyLayout;
+
     for (auto itRemove = toRemove.cbegin(), end = toRemove.cend(); itRemove != end; ++itRemove) {
         QtVariantProperty *property = itRemove.value();
         m_nameToProperty.remove(itRemove.key());
@@ -973,17 +1043,10 @@ void PropertyEditor::setObject(QObject *object)
     if (oldFormWindow != formWindow)
         reloadResourceProperties();
 
-    bool isMainContainer = false;
-    if (QWidget *widget = qobject_cast<QWidget*>(object)) {
-        if (QDesignerFormWindowInterface *fw = QDesignerFormWindowInterface::findFormWindow(widget)) {
-            isMainContainer = (fw->mainContainer() == widget);
-        }
-    }
     m_groups.clear();
 
     if (m_propertySheet) {
-        const QString className = WidgetFactory::classNameOf(formWindow->core(), m_object);
-        const QDesignerCustomWidgetData customData = formWindow->core()->pluginManager()->customWidgetData(className);
+        const QDesignerCustomWidgetData customData = formWindow->core()->pluginManager()->customWidgetData(propertyLayout.className);
 
         QtProperty *lastProperty = nullptr;
         QtProperty *lastGroup = nullptr;
@@ -96,8 +96,39 @@ private slots:
     void slotColoring(bool color);
     void slotCurrentItemChanged(QtBrowserItem*);
     void setFilter(const QString &pattern);
+    void doUpdatePropertySheet();
 
 private:
+    // The visible properties of a sheet, used to detect whether setObject()
+    // can keep the property tree.
+    struct PropertyLayoutEntry
+    {
+        QString name;
+        QString group;
+        int type;
+        bool dynamic;
+
+        friend bool operator==(const PropertyLayoutEntry &e1, const PropertyLayoutEntry &e2)
+        {
+            return e1.type == e2.type && e1.dynamic == e2.dynamic
+                && e1.name == e2.name && e1.group == e2.group;
+        }
+    };
+
+    struct PropertyLayout
+    {
+        QString className;
+        bool isMainContainer = false;
+        QList<PropertyLayoutEntry> entries;
+
+        friend bool operator==(const PropertyLayout &l1, const PropertyLayout &l2)
+        {
+            return l1.isMainContainer == l2.isMainContainer
+                && l1.className == l2.className && l1.entries == l2.entries;
+        }
+    };
+
+    void updatePropertyValues(bool isMainContainer);
     void updateBrowserValue(QtVariantProperty *property, const QVariant &value);
     void updateToolBarLabel();
     int toBrowserType(const QVariant &value, const QString &propertyName) const;
@@ -161,6 +192,8 @@ private:
     QtProperty *m_dynamicGroup = nullptr;
     QString m_recentlyAddedDynamicProperty;
     bool m_updatingBrowser = false;
+    bool m_propertySheetUpdatePending = false;
+    PropertyLayout m_propertyLayout;
 
     QStackedWidget *m_stackedWidget;
     QLineEdit *m_filterWidget;
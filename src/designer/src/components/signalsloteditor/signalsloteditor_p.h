@@ -43,11 +43,15 @@
 #include <QtCore/qstring.h>
 #include <QtCore/qstringlist.h>
 #include <QtCore/qlist.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qset.h>
 #include <QtCore/qpointer.h>
 #include <QtCore/qabstractitemmodel.h>
 
 #include <connectionedit_p.h>
 
+#include "signalslot_utils_p.h"
+
 QT_BEGIN_NAMESPACE
 
 class QDesignerFormWindowInterface;
@@ -104,6 +108,8 @@ public:
     QModelIndex connectionToIndex(Connection *con) const;
     Connection *indexToConnection(const QModelIndex &index) const;
     void updateAll();
+    // Update the rows of the connections from or to object
+    void updateObject(QObject *object);
 
     const SignalSlotConnection *connectionAt(const QModelIndex &index) const;
     static QString columnText(const SignalSlotConnection *con, int column);
@@ -116,7 +122,29 @@ private slots:
     void connectionChanged(Connection *con);
 
 private:
+    struct EndPointObjects
+    {
+        QObject *source = nullptr;
+        QObject *target = nullptr;
+    };
+
+    void clearIndex();
+    void ensureIndex() const;
+    void indexConnection(Connection *con) const;
+    void unindexConnection(Connection *con);
+    int rowOf(Connection *con) const;
+    bool isMemberFunction(QObject *object, MemberType type, const QString &signature) const;
+
     QPointer<SignalSlotEditor> m_editor;
+
+    // Connections by the objects at their end points, maintained through
+    // the editor's signals, and rows of the connections, rebuilt lazily.
+    mutable QHash<Connection *, EndPointObjects> m_endPoints;
+    mutable QMultiHash<QObject *, Connection *> m_objectConnections;
+    mutable QHash<Connection *, int> m_rows;
+    mutable bool m_rowsDirty = true;
+    // Visible member sheet signatures of a class, by MemberType.
+    mutable QHash<const QMetaObject *, QSet<QString>> m_memberCache[2];
 };
 
 } // namespace qdesigner_internal
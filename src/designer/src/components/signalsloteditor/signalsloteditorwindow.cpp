@@ -39,6 +39,7 @@
 #include <QtDesigner/abstractformeditor.h>
 #include <QtDesigner/abstractformwindowmanager.h>
 #include <QtDesigner/qextensionmanager.h>
+#include <QtDesigner/membersheet.h>
 #include <QtDesigner/abstractintegration.h>
 #include <QtDesigner/container.h>
 #include <QtDesigner/abstractmetadatabase.h>
@@ -155,6 +156,9 @@ void ConnectionModel::setEditor(SignalSlotEditor *editor)
                    this, &ConnectionModel::connectionChanged);
     }
     m_editor = editor;
+    clearIndex();
+    for (auto &cache : m_memberCache)
+        cache.clear();
     if (m_editor) {
         connect(m_editor.data(), &SignalSlotEditor::connectionAdded,
                 this, &ConnectionModel::connectionAdded);
@@ -216,7 +220,91 @@ Connection *ConnectionModel::indexToConnection(const QModelIndex &index) const
 QModelIndex ConnectionModel::connectionToIndex(Connection *con) const
 {
     Q_ASSERT(m_editor);
-    return createIndex(m_editor->indexOfConnection(con), 0);
+    return createIndex(rowOf(con), 0);
+}
+
+void ConnectionModel::clearIndex()
+{
+    m_endPoints.clear();
+    m_objectConnections.clear();
+    m_rows.clear();
+    m_rowsDirty = true;
+}
+
+// Index the connections if the editor's list was changed behind our back,
+// for example by loading a form, and recompute the rows if they moved.
+void ConnectionModel::ensureIndex() const
+{
+    if (!m_editor)
+        return;
+    const int count = m_editor->connectionCount();
+    if (m_endPoints.size() != count) {
+        m_endPoints.clear();
+        m_objectConnections.clear();
+        for (int i = 0; i < count; ++i)
+            indexConnection(m_editor->connection(i));
+        m_rowsDirty = true;
+    }
+    if (m_rowsDirty || m_rows.size() != count) {
+        m_rows.clear();
+        m_rows.reserve(count);
+        for (int i = 0; i < count; ++i)
+            m_rows.insert(m_editor->connection(i), i);
+        m_rowsDirty = false;
+    }
+}
+
+void ConnectionModel::indexConnection(Connection *con) const
+{
+    const EndPointObjects endPoints{con->object(CETypes::EndPoint::Source),
+                                    con->object(CETypes::EndPoint::Target)};
+    m_endPoints.insert(con, endPoints);
+    m_objectConnections.insert(endPoints.source, con);
+    if (endPoints.target != endPoints.source)
+        m_objectConnections.insert(endPoints.target, con);
+}
+
+void ConnectionModel::unindexConnection(Connection *con)
+{
+    const auto it = m_endPoints.find(con);
+    if (it == m_endPoints.end())
+        return;
+    m_objectConnections.remove(it->source, con);
+    m_objectConnections.remove(it->target, con);
+    m_endPoints.erase(it);
+}
+
+int ConnectionModel::rowOf(Connection *con) const
+{
+    ensureIndex();
+    return m_rows.value(con, -1);
+}
+
+// Check a signature against the member sheet, whose visible members are
+// cached per class, before falling back to the fake methods of the object.
+bool ConnectionModel::isMemberFunction(QObject *object, MemberType type,
+                                       const QString &signature) const
+{
+    if (!object)
+        return false;
+    QDesignerFormEditorInterface *core = m_editor->formWindow()->core();
+    auto &cache = m_memberCache[type];
+    auto it = cache.find(object->metaObject());
+    if (it == cache.end()) {
+        QSet<QString> signatures;
+        const QDesignerMemberSheetExtension *members =
+            qt_extension<QDesignerMemberSheetExtension*>(core->extensionManager(), object);
+        Q_ASSERT(members != nullptr);
+        for (int i = 0, count = members->count(); i < count; ++i) {
+            if (members->isVisible(i)
+                && (type == SignalMember ? members->isSignal(i) : members->isSlot(i))) {
+                signatures.insert(members->signature(i));
+            }
+        }
+        it = cache.insert(object->metaObject(), signatures);
+    }
+    return it->contains(signature)
+        || memberFunctionListContains(core, object, type, signature);
 }
 
 QModelIndex ConnectionModel::parent(const QModelIndex&) const
@@ -322,7 +410,7 @@ bool ConnectionModel::setData(const QModelIndex &index, const QVariant &data, in
             m_editor->setSource(con, s);
             break;
         case 1:
-            if (!memberFunctionListContains(form->core(), con->object(CETypes::EndPoint::Source), SignalMember, s))
+            if (!isMemberFunction(con->object(CETypes::EndPoint::Source), SignalMember, s))
                 s.clear();
             m_editor->setSignal(con, s);
             break;
@@ -332,7 +420,7 @@ bool ConnectionModel::setData(const QModelIndex &index, const QVariant &data, in
             m_editor->setTarget(con, s);
             break;
         case 3:
-            if (!memberFunctionListContains(form->core(), con->object(CETypes::EndPoint::Target), SlotMember, s))
+            if (!isMemberFunction(con->object(CETypes::EndPoint::Target), SlotMember, s))
                 s.clear();
             m_editor->setSlot(con, s);
             break;
@@ -341,20 +429,24 @@ bool ConnectionModel::setData(const QModelIndex &index, const QVariant &data, in
     return true;
 }
 
-void ConnectionModel::connectionAdded(Connection*)
+void ConnectionModel::connectionAdded(Connection *con)
 {
+    indexConnection(con);
+    m_rowsDirty = true;
     endInsertRows();
 }
 
 void ConnectionModel::connectionRemoved(int)
 {
+    m_rowsDirty = true;
     endRemoveRows();
 }
 
 void ConnectionModel::aboutToRemoveConnection(Connection *con)
 {
     Q_ASSERT(m_editor);
-    int idx = m_editor->indexOfConnection(con);
+    const int idx = rowOf(con);
+    unindexConnection(con);
     beginRemoveRows(QModelIndex(), idx, idx);
 }
 
@@ -372,13 +464,18 @@ Qt::ItemFlags ConnectionModel::flags(const QModelIndex&) const
 void ConnectionModel::connectionChanged(Connection *con)
 {
     Q_ASSERT(m_editor);
-    const int idx = m_editor->indexOfConnection(con);
-    SignalSlotConnection *changedCon = static_cast<SignalSlotConnection*>(m_editor->connection(idx));
-    SignalSlotConnection *c = nullptr;
-    for (int i=0; i<m_editor->connectionCount(); ++i) {
-        if (i == idx)
+    // The end points may have changed, re-index the connection
+    ensureIndex();
+    unindexConnection(con);
+    indexConnection(con);
+    const int idx = rowOf(con);
+    SignalSlotConnection *changedCon = static_cast<SignalSlotConnection*>(con);
+    // A duplicate has the same sender object
+    const auto candidates = m_objectConnections.equal_range(con->object(CETypes::EndPoint::Source));
+    for (auto it = candidates.first; it != candidates.second; ++it) {
+        if (it.value() == con)
             continue;
-        c = static_cast<SignalSlotConnection*>(m_editor->connection(i));
+        const SignalSlotConnection *c = static_cast<const SignalSlotConnection*>(it.value());
         if (c->sender() == changedCon->sender() && c->signal() == changedCon->signal()
             && c->receiver() == changedCon->receiver() && c->slot() == changedCon->slot()) {
             const QString message = tr("The connection already exists!<br>%1").arg(changedCon->toString());
@@ -394,6 +491,18 @@ void ConnectionModel::updateAll()
 {
     emit dataChanged(index(0, 0), index(rowCount() - 1, columnCount() - 1));
 }
+
+void ConnectionModel::updateObject(QObject *object)
+{
+    if (!m_editor)
+        return;
+    ensureIndex();
+    const auto connections = m_objectConnections.equal_range(object);
+    for (auto it = connections.first; it != connections.second; ++it) {
+        const int row = rowOf(it.value());
+        emit dataChanged(createIndex(row, 0), createIndex(row, columnCount() - 1));
+    }
+}
 }
 
 namespace {
@@ -803,10 +912,10 @@ void SignalSlotEditorWindow::updateEditorSelection(const QModelIndex &index)
     updateUi();
 }
 
-void SignalSlotEditorWindow::objectNameChanged(QDesignerFormWindowInterface *, QObject *, const QString &, const QString &)
+void SignalSlotEditorWindow::objectNameChanged(QDesignerFormWindowInterface *, QObject *object, const QString &, const QString &)
 {
     if (m_editor)
-        m_model->updateAll();
+        m_model->updateObject(object);
 }
 
 void SignalSlotEditorWindow::addConnection()
@@ -43,6 +43,7 @@
 #include <QtCore/qabstractitemmodel.h>
 #include <QtCore/qiodevice.h>
 #include <QtCore/qlist.h>
+#include <QtCore/qset.h>
 #include <QtCore/qtextstream.h>
 #include <QtCore/qregularexpression.h>
 
@@ -78,25 +79,27 @@ namespace qdesigner_internal {
 struct WidgetBoxCategoryEntry {
     WidgetBoxCategoryEntry() = default;
     explicit WidgetBoxCategoryEntry(const QDesignerWidgetBoxInterface::Widget &widget,
-                                    const QString &filter,
                                     const QIcon &icon,
                                     bool editable);
 
     QDesignerWidgetBoxInterface::Widget widget;
-    QString toolTip;
-    QString whatsThis;
-    QString filter;
-    QIcon icon;
+    // Tool tips, filter and icon are only needed once the entry is shown
+    // or filtered, they are populated on demand by the model.
+    mutable QString toolTip;
+    mutable QString whatsThis;
+    mutable QString filter;
+    mutable QIcon icon;
     bool editable{false};
+    mutable bool detailsLoaded{false};
+    mutable bool iconLoaded{false};
 };
 
 WidgetBoxCategoryEntry::WidgetBoxCategoryEntry(const QDesignerWidgetBoxInterface::Widget &w,
-                                               const QString &filterIn,
                                                const QIcon &i, bool e) :
     widget(w),
-    filter(filterIn),
     icon(i),
-    editable(e)
+    editable(e),
+    iconLoaded(!i.isNull())
 {
 }
 
@@ -120,6 +123,9 @@ public:
     void setViewMode(QListView::ViewMode vm);
 
     void addWidget(const QDesignerWidgetBoxInterface::Widget &widget, const QIcon &icon, bool editable);
+    void addWidgets(const QDesignerWidgetBoxInterface::Category &cat, bool editable);
+    void setIconProvider(const WidgetBoxCategoryListView::IconProvider &iconProvider)
+        { m_iconProvider = iconProvider; }
 
     QDesignerWidgetBoxInterface::Widget widgetAt(const QModelIndex & index) const;
     QDesignerWidgetBoxInterface::Widget widgetAt(int row) const;
@@ -132,9 +138,13 @@ public:
 private:
     using WidgetBoxCategoryEntrys = QList<WidgetBoxCategoryEntry>;
 
+    void ensureDetails(const WidgetBoxCategoryEntry &item) const;
+    void ensureIcon(const WidgetBoxCategoryEntry &item) const;
+
     QDesignerFormEditorInterface *m_core;
     WidgetBoxCategoryEntrys m_items;
     QListView::ViewMode m_viewMode;
+    WidgetBoxCategoryListView::IconProvider m_iconProvider;
 };
 
 WidgetBoxCategoryModel::WidgetBoxCategoryModel(QDesignerFormEditorInterface *core, QObject *parent) :
@@ -198,9 +208,13 @@ bool WidgetBoxCategoryModel::removeCustomWidgets()
     return changed;
 }
 
-void WidgetBoxCategoryModel::addWidget(const QDesignerWidgetBoxInterface::Widget &widget, const QIcon &icon,bool editable)
+void WidgetBoxCategoryModel::ensureDetails(const WidgetBoxCategoryEntry &item) const
 {
-    // build item. Filter on name + class name if it is different and not a layout.
+    if (item.detailsLoaded)
+        return;
+    item.detailsLoaded = true;
+    const QDesignerWidgetBoxInterface::Widget &widget = item.widget;
+    // Filter on name + class name if it is different and not a layout.
     QString filter = widget.name();
     if (!filter.contains(QStringLiteral("Layout"))) {
         static const QRegularExpression classNameRegExp(QStringLiteral("<widget +class *= *\"([^\"]+)\""));
@@ -212,7 +226,7 @@ void WidgetBoxCategoryModel::addWidget(const QDesignerWidgetBoxInterface::Widget
                 filter += className;
         }
     }
-    WidgetBoxCategoryEntry item(widget, filter, icon, editable);
+    item.filter = filter;
     const QDesignerWidgetDataBaseInterface *db = m_core->widgetDataBase();
     const int dbIndex = db->indexOfClassName(widget.name());
     if (dbIndex != -1) {
@@ -224,10 +238,50 @@ void WidgetBoxCategoryModel::addWidget(const QDesignerWidgetBoxInterface::Widget
         if (!whatsThis.isEmpty())
             item.whatsThis = whatsThis;
     }
+}
+
+void WidgetBoxCategoryModel::ensureIcon(const WidgetBoxCategoryEntry &item) const
+{
+    if (item.iconLoaded)
+        return;
+    item.iconLoaded = true;
+    if (m_iconProvider)
+        item.icon = m_iconProvider(item.widget.iconName());
+}
+
+void WidgetBoxCategoryModel::addWidget(const QDesignerWidgetBoxInterface::Widget &widget, const QIcon &icon,bool editable)
+{
     // insert
     const int row = m_items.size();
     beginInsertRows(QModelIndex(), row, row);
-    m_items.push_back(item);
+    m_items.push_back(WidgetBoxCategoryEntry(widget, icon, editable));
+    endInsertRows();
+}
+
+// Add the widgets of a category not yet present in one go, their icons are created by the
+// icon provider when first requested.
+void WidgetBoxCategoryModel::addWidgets(const QDesignerWidgetBoxInterface::Category &cat,
+                                        bool editable)
+{
+    QSet<QString> names;
+    for (const WidgetBoxCategoryEntry &item : qAsConst(m_items))
+        names.insert(item.widget.name());
+
+    WidgetBoxCategoryEntrys newItems;
+    const int widgetCount = cat.widgetCount();
+    for (int i = 0; i < widgetCount; ++i) {
+        const QDesignerWidgetBoxInterface::Widget widget = cat.widget(i);
+        if (!names.contains(widget.name())) {
+            names.insert(widget.name());
+            newItems.append(WidgetBoxCategoryEntry(widget, QIcon(), editable));
+        }
+    }
+    if (newItems.isEmpty())
+        return;
+
+    const int row = m_items.size();
+    beginInsertRows(QModelIndex(), row, row + newItems.size() - 1);
+    m_items.append(newItems);
     endInsertRows();
 }
 
@@ -243,10 +297,12 @@ QVariant WidgetBoxCategoryModel::data(const QModelIndex &index, int role) const
         // No text in icon mode
         return QVariant(m_viewMode == QListView::ListMode ? item.widget.name() : QString());
     case Qt::DecorationRole:
+        ensureIcon(item);
         return QVariant(item.icon);
     case Qt::EditRole:
         return QVariant(item.widget.name());
     case Qt::ToolTipRole: {
+        ensureDetails(item);
         if (m_viewMode == QListView::ListMode)
             return QVariant(item.toolTip);
         // Icon mode tooltip should contain the  class name
@@ -259,8 +315,10 @@ QVariant WidgetBoxCategoryModel::data(const QModelIndex &index, int role) const
 
     }
     case Qt::WhatsThisRole:
+        ensureDetails(item);
         return QVariant(item.whatsThis);
     case FilterRole:
+        ensureDetails(item);
         return item.filter;
     }
     return QVariant();
@@ -471,6 +529,16 @@ void WidgetBoxCategoryListView::addWidget(const QDesignerWidgetBoxInterface::Wid
     m_model->addWidget(widget, icon, editable);
 }
 
+void WidgetBoxCategoryListView::addWidgets(const QDesignerWidgetBoxInterface::Category &cat, bool editable)
+{
+    m_model->addWidgets(cat, editable);
+}
+
+void WidgetBoxCategoryListView::setIconProvider(const IconProvider &iconProvider)
+{
+    m_model->setIconProvider(iconProvider);
+}
+
 QString WidgetBoxCategoryListView::widgetDomXml(const QDesignerWidgetBoxInterface::Widget &widget)
 {
     QString domXml = widget.domXml();
@@ -34,6 +34,8 @@
 #include <QtWidgets/qlistview.h>
 #include <QtCore/qlist.h>
 
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 
 class QDesignerFormEditorInterface;
@@ -53,6 +55,8 @@ class WidgetBoxCategoryListView : public QListView
 public:
     // Whether to access the filtered or unfiltered view
     enum AccessMode { FilteredAccess, UnfilteredAccess };
+    // Creates the icon of a widget added by addWidgets() when it is first shown
+    using IconProvider = std::function<QIcon(const QString &iconName)>;
 
     explicit WidgetBoxCategoryListView(QDesignerFormEditorInterface *core, QWidget *parent = nullptr);
     void setViewMode(ViewMode vm);
@@ -70,6 +74,8 @@ public:
 
     // These methods operate on the unfiltered model and are used for serialization
     void addWidget(const QDesignerWidgetBoxInterface::Widget &widget, const QIcon &icon, bool editable);
+    void addWidgets(const QDesignerWidgetBoxInterface::Category &cat, bool editable);
+    void setIconProvider(const IconProvider &iconProvider);
     bool containsWidget(const QString &name);
     QDesignerWidgetBoxInterface::Category category() const;
     bool removeCustomWidgets();
@@ -73,6 +73,8 @@ static const char *invisibleNameC = "[invisible]";
 
 enum TopLevelRole  { NORMAL_ITEM, SCRATCHPAD_ITEM, CUSTOM_ITEM };
 
+enum { listSizePendingRole = Qt::UserRole + 1 };
+
 QT_BEGIN_NAMESPACE
 
 static void setTopLevelRole(TopLevelRole tlr, QTreeWidgetItem *item)
@@ -106,6 +108,8 @@ WidgetBoxTreeWidget::WidgetBoxTreeWidget(QDesignerFormEditorInterface *core, QWi
 
     connect(this, &QTreeWidget::itemPressed,
             this, &WidgetBoxTreeWidget::handleMousePress);
+    connect(this, &QTreeWidget::itemExpanded,
+            this, &WidgetBoxTreeWidget::slotItemExpanded);
 }
 
 QIcon WidgetBoxTreeWidget::iconForWidget(const QString &iconName) const
@@ -152,25 +156,41 @@ void WidgetBoxTreeWidget::saveExpandedState() const
     settings->endGroup();
 }
 
-void  WidgetBoxTreeWidget::restoreExpandedState()
+void WidgetBoxTreeWidget::readExpandedState()
 {
-    using StringSet = QSet<QString>;
     QDesignerSettingsInterface *settings = m_core->settingsManager();
     const QString groupKey = QLatin1String(widgetBoxSettingsGroupC) + QLatin1Char('/');
     m_iconMode = settings->value(groupKey + QLatin1String(widgetBoxViewModeKeyC)).toBool();
-    updateViewMode();
     const auto &closedCategoryList = settings->value(groupKey + QLatin1String(widgetBoxExpandedKeyC), QStringList()).toStringList();
-    const StringSet closedCategories(closedCategoryList.cbegin(), closedCategoryList.cend());
-    expandAll();
-    if (closedCategories.isEmpty())
-        return;
+    m_closedCategories = QSet<QString>(closedCategoryList.cbegin(), closedCategoryList.cend());
+}
 
+void  WidgetBoxTreeWidget::restoreExpandedState()
+{
+    updateViewMode();
+    // Expand item by item instead of using expandAll() so that
+    // slotItemExpanded() lays out categories that were added collapsed.
     if (const int numCategories = categoryCount()) {
         for (int i = 0; i < numCategories; ++i) {
             QTreeWidgetItem *item = topLevelItem(i);
-            if (closedCategories.contains(item->text(0)))
-                item->setExpanded(false);
-            }
+            item->setExpanded(!m_closedCategories.contains(item->text(0)));
+        }
+    }
+}
+
+void WidgetBoxTreeWidget::expandAllCategories()
+{
+    if (const int numCategories = categoryCount()) {
+        for (int i = 0; i < numCategories; ++i)
+            topLevelItem(i)->setExpanded(true);
+    }
+}
+
+void WidgetBoxTreeWidget::slotItemExpanded(QTreeWidgetItem *item)
+{
+    if (item->parent() == nullptr && item->childCount() > 0
+        && item->child(0)->data(0, listSizePendingRole).toBool()) {
+        adjustSubListSize(item);
     }
 }
 
@@ -251,6 +271,9 @@ WidgetBoxCategoryListView *WidgetBoxTreeWidget::addCategoryView(QTreeWidgetItem
     embed_item->setFlags(Qt::ItemIsEnabled);
     WidgetBoxCategoryListView *categoryView = new WidgetBoxCategoryListView(m_core, this);
     categoryView->setViewMode(iconMode ? QListView::IconMode : QListView::ListMode);
+    categoryView->setIconProvider([this](const QString &iconName) {
+        return iconForWidget(iconName);
+    });
     connect(categoryView, &WidgetBoxCategoryListView::scratchPadChanged,
             this, &WidgetBoxTreeWidget::slotSave);
     connect(categoryView, &WidgetBoxCategoryListView::pressed,
@@ -325,6 +348,10 @@ bool WidgetBoxTreeWidget::loadContents(const QString &contents)
         return false;
     }
 
+    // Create the categories closed in the previous session collapsed
+    // so that their lists are only laid out when opened.
+    readExpandedState();
+
     for (const Category &cat : qAsConst(cat_list))
         addCategory(cat);
 
@@ -668,6 +695,12 @@ void WidgetBoxTreeWidget::adjustSubListSize(QTreeWidgetItem *cat_item)
     if (embedItem == nullptr)
         return;
 
+    // Laying out the list is deferred until a collapsed category is opened
+    const bool pending = !cat_item->isExpanded();
+    embedItem->setData(0, listSizePendingRole, QVariant(pending));
+    if (pending)
+        return;
+
     WidgetBoxCategoryListView *list_widget = static_cast<WidgetBoxCategoryListView*>(itemWidget(embedItem, 0));
     list_widget->setFixedWidth(header()->width());
     list_widget->doItemsLayout();
@@ -731,20 +764,15 @@ void WidgetBoxTreeWidget::addCategory(const Category &cat)
             } else {
                 insertTopLevelItem(scratchPadIndex, cat_item);
             }
-            cat_item->setExpanded(true);
+            cat_item->setExpanded(!m_closedCategories.contains(cat.name()));
             categoryView = addCategoryView(cat_item, m_iconMode);
         } else {
             categoryView = categoryViewAt(existingIndex);
             cat_item = topLevelItem(existingIndex);
         }
     }
-    // The same categories are read from the file $HOME, avoid duplicates
-    const int widgetCount = cat.widgetCount();
-    for (int i = 0; i < widgetCount; ++i) {
-        const Widget w = cat.widget(i);
-        if (!categoryView->containsWidget(w.name()))
-            categoryView->addWidget(w, iconForWidget(w.iconName()), isScratchPad);
-    }
+    // The same categories are read from the file $HOME, duplicates are skipped
+    categoryView->addWidgets(cat, isScratchPad);
     adjustSubListSize(cat_item);
 }
 
@@ -880,7 +908,7 @@ void WidgetBoxTreeWidget::contextMenuEvent(QContextMenuEvent *e)
                             && topLevelRole(item->parent()) ==  SCRATCHPAD_ITEM;
 
     QMenu menu;
-    menu.addAction(tr("Expand all"), this, &WidgetBoxTreeWidget::expandAll);
+    menu.addAction(tr("Expand all"), this, &WidgetBoxTreeWidget::expandAllCategories);
     menu.addAction(tr("Collapse all"), this, &WidgetBoxTreeWidget::collapseAll);
     menu.addSeparator();
 
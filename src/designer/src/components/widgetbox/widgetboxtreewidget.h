@@ -35,6 +35,7 @@
 #include <QtGui/qicon.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qhash.h>
+#include <QtCore/qset.h>
 #include <QtCore/qxmlstream.h>
 
 QT_BEGIN_NAMESPACE
@@ -100,6 +101,8 @@ private slots:
     void deleteScratchpad();
     void slotListMode();
     void slotIconMode();
+    void slotItemExpanded(QTreeWidgetItem *item);
+    void expandAllCategories();
 
 private:
     WidgetBoxCategoryListView *addCategoryView(QTreeWidgetItem *parent, bool iconMode);
@@ -118,6 +121,7 @@ private:
     void addCustomCategories(bool replace);
 
     void saveExpandedState() const;
+    void readExpandedState();
     void restoreExpandedState();
     void updateViewMode();
 
@@ -127,6 +131,7 @@ private:
     mutable IconCache m_pluginIcons;
     bool m_iconMode;
     QTimer *m_scratchPadDeleteTimer;
+    QSet<QString> m_closedCategories;
 };
 
 }  // namespace qdesigner_internal
@@ -48,6 +48,7 @@ int main(int argc, char *argv[])
     case QDesigner::ParseArgumentsError:
         return 1;
     case QDesigner::ParseArgumentsHelpRequested:
+    case QDesigner::ParseArgumentsForwarded:
         return 0;
     }
     QGuiApplication::setQuitOnLastWindowClosed(false);
@@ -35,6 +35,7 @@
 #include "mainwindow.h"
 
 #include <qdesigner_propertysheet_p.h>
+#include <formwindowbase_p.h>
 
 #include <QtGui/qevent.h>
 #include <QtWidgets/qmessagebox.h>
@@ -162,6 +163,7 @@ struct Options
     QStringList files;
     QString resourceDir{QLibraryInfo::path(QLibraryInfo::TranslationsPath)};
     bool server{false};
+    bool single{false};
     quint16 clientPort{0};
     bool enableInternalDynamicProperties{false};
 };
@@ -182,6 +184,10 @@ static inline QDesigner::ParseArgumentsResult
                                           QStringLiteral("Client mode"),
                                           QStringLiteral("port"));
     parser.addOption(clientOption);
+    const QCommandLineOption singleOption(QStringLiteral("single"),
+                                          QStringLiteral("Open the files in a running instance started with -single, "
+                                                         "or become that instance"));
+    parser.addOption(singleOption);
     const QCommandLineOption resourceDirOption(QStringLiteral("resourcedir"),
                                           QStringLiteral("Resource directory"),
                                           QStringLiteral("directory"));
@@ -205,6 +211,7 @@ static inline QDesigner::ParseArgumentsResult
     if (parser.isSet(u"help-all"_qs))
         parser.process(QCoreApplication::arguments()); // exits
     options->server = parser.isSet(serverOption);
+    options->single = parser.isSet(singleOption);
     if (parser.isSet(clientOption)) {
         bool ok;
         options->clientPort = parser.value(clientOption).toUShort(&ok);
@@ -230,6 +237,15 @@ QDesigner::ParseArgumentsResult QDesigner::parseCommandLineArguments()
         showHelp(parser, errorMessage);
         return result;
     }
+    // Hand the files over to a running instance, which has already
+    // loaded the plugins and the widget database.
+    if (options.single) {
+        if (QDesignerInstanceServer::sendOpenRequest(options.files))
+            return ParseArgumentsForwarded;
+        m_instanceServer = new QDesignerInstanceServer(this);
+        if (!m_instanceServer->listen())
+            qWarning("Unable to listen for files to open in this instance.");
+    }
     // initialize the sub components
     if (options.clientPort)
         m_client = new QDesignerClient(options.clientPort, this);
@@ -258,6 +274,7 @@ QDesigner::ParseArgumentsResult QDesigner::parseCommandLineArguments()
     m_suppressNewFormShow = m_workbench->readInBackup();
 
     if (!options.files.isEmpty()) {
+        QStringList fileNames;
         const QStringList::const_iterator cend = options.files.constEnd();
         for (QStringList::const_iterator it = options.files.constBegin(); it != cend; ++it) {
             // Ensure absolute paths for recent file list to be unique
@@ -265,8 +282,12 @@ QDesigner::ParseArgumentsResult QDesigner::parseCommandLineArguments()
             const QFileInfo fi(fileName);
             if (fi.exists() && fi.isRelative())
                 fileName = fi.absoluteFilePath();
-            m_workbench->readInForm(fileName);
+            fileNames.append(fileName);
         }
+        if (fileNames.size() > 1)
+            qdesigner_internal::FormWindowBase::parseFormsInBackground(m_workbench->core(), fileNames);
+        for (const QString &fileName : qAsConst(fileNames))
+            m_workbench->readInForm(fileName);
     }
     if ( m_workbench->formWindowCount())
         m_suppressNewFormShow = true;
@@ -42,6 +42,7 @@ class QDesignerToolWindow;
 class MainWindowBase;
 class QDesignerServer;
 class QDesignerClient;
+class QDesignerInstanceServer;
 class QErrorMessage;
 class QCommandLineParser;
 struct Options;
@@ -53,7 +54,8 @@ public:
     enum ParseArgumentsResult {
         ParseArgumentsSuccess,
         ParseArgumentsError,
-        ParseArgumentsHelpRequested
+        ParseArgumentsHelpRequested,
+        ParseArgumentsForwarded
     };
 
     QDesigner(int &argc, char **argv);
@@ -83,6 +85,7 @@ private:
 
     QDesignerServer *m_server;
     QDesignerClient *m_client;
+    QDesignerInstanceServer *m_instanceServer = nullptr;
     QDesignerWorkbench *m_workbench;
     QPointer<MainWindowBase> m_mainWindow;
     QPointer<QErrorMessage> m_errorMessageDialog;
@@ -600,6 +600,8 @@ bool QDesignerActions::openForm(QWidget *parent)
     if (fileNames.isEmpty())
         return false;
 
+    if (fileNames.size() > 1)
+        qdesigner_internal::FormWindowBase::parseFormsInBackground(core(), fileNames);
     bool atLeastOne = false;
     for (const QString &fileName : fileNames) {
         if (readInForm(fileName) && !atLeastOne)
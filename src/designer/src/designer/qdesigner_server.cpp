@@ -26,15 +26,20 @@
 **
 ****************************************************************************/
 
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdir.h>
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qstringlist.h>
 
 #include <QtNetwork/qhostaddress.h>
+#include <QtNetwork/qlocalserver.h>
+#include <QtNetwork/qlocalsocket.h>
 #include <QtNetwork/qtcpserver.h>
 #include <QtNetwork/qtcpsocket.h>
 
 #include "qdesigner.h"
 #include "qdesigner_server.h"
+#include "mainwindow.h"
 
 #include <qevent.h>
 
@@ -105,6 +110,99 @@ void QDesignerServer::handleNewConnection()
     }
 }
 
+// ------------ QDesignerInstanceServer
+
+QDesignerInstanceServer::QDesignerInstanceServer(QObject *parent)
+    : QObject(parent), m_server(new QLocalServer(this))
+{
+    m_server->setSocketOptions(QLocalServer::UserAccessOption);
+    connect(m_server, &QLocalServer::newConnection,
+            this, &QDesignerInstanceServer::handleNewConnection);
+}
+
+QDesignerInstanceServer::~QDesignerInstanceServer() = default;
+
+// One instance per user and Qt version.
+QString QDesignerInstanceServer::serverName()
+{
+    const QByteArray key = QDir::homePath().toUtf8() + '/' + QT_VERSION_STR;
+    const QByteArray hash = QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex();
+    return QStringLiteral("QtDesigner-") + QString::fromLatin1(hash.left(16));
+}
+
+bool QDesignerInstanceServer::listen()
+{
+    const QString name = serverName();
+    if (m_server->listen(name))
+        return true;
+    // On Unix, an instance that crashed leaves its socket file behind.
+    if (m_server->serverError() == QAbstractSocket::AddressInUseError) {
+        QLocalServer::removeServer(name);
+        return m_server->listen(name);
+    }
+    return false;
+}
+
+// Sends the files to the running instance, which opens them. The
+// trailing empty line asks it to come to the front. Returns false
+// if no instance is running.
+bool QDesignerInstanceServer::sendOpenRequest(const QStringList &files)
+{
+    QLocalSocket socket;
+    socket.connectToServer(serverName());
+    if (!socket.waitForConnected(1000))
+        return false;
+
+    QByteArray request;
+    for (const QString &file : files)
+        request += QFileInfo(file).absoluteFilePath().toUtf8() + '\n';
+    request += '\n';
+    socket.write(request);
+    socket.disconnectFromServer();
+    if (socket.state() != QLocalSocket::UnconnectedState)
+        socket.waitForDisconnected(3000);
+    return true;
+}
+
+void QDesignerInstanceServer::handleNewConnection()
+{
+    while (QLocalSocket *socket = m_server->nextPendingConnection()) {
+        connect(socket, &QLocalSocket::readyRead,
+                this, [this, socket] { readFromClient(socket); });
+        connect(socket, &QLocalSocket::disconnected,
+                socket, &QObject::deleteLater);
+        readFromClient(socket);
+    }
+}
+
+void QDesignerInstanceServer::readFromClient(QLocalSocket *socket)
+{
+    while (socket->canReadLine()) {
+        QString file = QString::fromUtf8(socket->readLine());
+        file.remove(QLatin1Char('\n'));
+        file.remove(QLatin1Char('\r'));
+        if (file.isEmpty()) {
+            // Queued behind the open events posted before.
+            QMetaObject::invokeMethod(this, &QDesignerInstanceServer::activateMainWindow,
+                                      Qt::QueuedConnection);
+        } else {
+            qDesigner->postEvent(qDesigner, new QFileOpenEvent(file));
+        }
+    }
+}
+
+void QDesignerInstanceServer::activateMainWindow()
+{
+    MainWindowBase *mainWindow = qDesigner->mainWindow();
+    if (!mainWindow)
+        return;
+    if (mainWindow->isMinimized())
+        mainWindow->showNormal();
+    mainWindow->raise();
+    mainWindow->activateWindow();
+}
+
+// ------------ QDesignerClient
 
 QDesignerClient::QDesignerClient(quint16 port, QObject *parent)
 : QObject(parent)
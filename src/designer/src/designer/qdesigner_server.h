@@ -33,6 +33,8 @@
 
 QT_BEGIN_NAMESPACE
 
+class QLocalServer;
+class QLocalSocket;
 class QTcpServer;
 class QTcpSocket;
 
@@ -57,6 +59,30 @@ private:
     QTcpSocket *m_socket;
 };
 
+// Lets "designer -single" open its files in an instance that is already
+// running; an IDE can start such an instance in advance.
+class QDesignerInstanceServer: public QObject
+{
+    Q_OBJECT
+public:
+    explicit QDesignerInstanceServer(QObject *parent = nullptr);
+    ~QDesignerInstanceServer() override;
+
+    bool listen();
+
+    static bool sendOpenRequest(const QStringList &files);
+
+private slots:
+    void handleNewConnection();
+    void activateMainWindow();
+
+private:
+    static QString serverName();
+    void readFromClient(QLocalSocket *socket);
+
+    QLocalServer *m_server;
+};
+
 class QDesignerClient: public QObject
 {
     Q_OBJECT
@@ -806,6 +806,7 @@ bool QDesignerWorkbench::readInBackup()
     if (answer == QMessageBox::No)
         return false;
 
+    qdesigner_internal::FormWindowBase::parseFormsInBackground(m_core, backupFileMap.values());
     const QString modifiedPlaceHolder = QStringLiteral("[*]");
     for (auto it = backupFileMap.cbegin(), end = backupFileMap.cend(); it != end; ++it) {
         QString fileName = it.key();
@@ -922,14 +923,17 @@ QDesignerFormWindow * QDesignerWorkbench::loadForm(const QString &fileName,
     // In this case, the file name will we be cleared on return to force a save box.
     editor->setFileName(fileName);
 
-    if (!editor->setContents(&file, errorMessage)) {
+    qdesigner_internal::FormWindowBase *fwb = qobject_cast<qdesigner_internal::FormWindowBase *>(editor);
+    const bool loaded = fwb ? fwb->setContentsFromFile(&file, errorMessage)
+                            : editor->setContents(&file, errorMessage);
+    if (!loaded) {
         removeFormWindow(formWindow);
         formWindowManager->removeFormWindow(editor);
         m_core->metaDataBase()->remove(editor);
         return nullptr;
     }
 
-    if (qdesigner_internal::FormWindowBase *fwb = qobject_cast<qdesigner_internal::FormWindowBase *>(editor))
+    if (fwb)
         fwb->setLineTerminatorMode(mode);
 
     switch (m_mode) {
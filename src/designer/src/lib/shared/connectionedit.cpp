@@ -42,6 +42,7 @@
 #include <QtGui/qtransform.h>
 
 #include <QtCore/qmap.h>
+#include <QtCore/qset.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -52,6 +53,7 @@ static const int VLABEL_MARGIN =          1;
 static const int HLABEL_MARGIN =          3;
 static const int GROUND_W =              20;
 static const int GROUND_H =              25;
+static const int INDEX_CELL_SIZE =       64;
 
 /*******************************************************************************
 ** Tools
@@ -95,6 +97,16 @@ static void paintEndPoint(QPainter *p, const QPoint &pos)
     p->fillRect(fixRect(r), p->pen().color());
 }
 
+static inline int indexCell(int v)
+{
+    return v >= 0 ? v / INDEX_CELL_SIZE : (v + 1) / INDEX_CELL_SIZE - 1;
+}
+
+static inline quint64 cellKey(int column, int row)
+{
+    return (quint64(quint32(column)) << 32) | quint32(row);
+}
+
 static qdesigner_internal::CETypes::LineDir classifyLine(const QPoint &p1, const QPoint &p2)
 {
     if (p1.x() == p2.x())
@@ -135,6 +147,7 @@ void AddConnectionCommand::redo()
     edit()->selectNone();
     emit edit()->aboutToAddConnection(edit()->m_con_list.size());
     edit()->m_con_list.append(m_con);
+    edit()->invalidateConnectionIndex();
     m_con->inserted();
     emit edit()->connectionAdded(m_con);
     edit()->setSelected(m_con, true);
@@ -148,6 +161,7 @@ void AddConnectionCommand::undo()
     m_con->update();
     m_con->removed();
     edit()->m_con_list.removeAll(m_con);
+    edit()->invalidateConnectionIndex();
     emit edit()->connectionRemoved(idx);
 }
 
@@ -213,6 +227,7 @@ void DeleteConnectionsCommand::redo()
         con->update();
         con->removed();
         edit()->m_con_list.removeAll(con);
+        edit()->invalidateConnectionIndex();
         emit edit()->connectionRemoved(idx);
     }
 }
@@ -223,6 +238,7 @@ void DeleteConnectionsCommand::undo()
         Q_ASSERT(!edit()->m_con_list.contains(con));
         emit edit()->aboutToAddConnection(edit()->m_con_list.size());
         edit()->m_con_list.append(con);
+        edit()->invalidateConnectionIndex();
         edit()->selectNone();
         con->update();
         con->inserted();
@@ -442,6 +458,8 @@ void Connection::updateKneeList()
     const LineDir old_source_label_dir = labelDir(EndPoint::Source);
     const LineDir old_target_label_dir = labelDir(EndPoint::Target);
 
+    invalidateRegion();
+
     QPoint s = endPointPos(EndPoint::Source);
     QPoint t = endPointPos(EndPoint::Target);
     const QRect sr = m_source_rect;
@@ -718,8 +736,19 @@ QRect Connection::groundRect() const
     return QRect(p.x() - GROUND_W/2, p.y(), GROUND_W, GROUND_H);
 }
 
+void Connection::invalidateRegion()
+{
+    m_region_dirty = true;
+    m_edit->invalidateConnectionIndex();
+}
+
 QRegion Connection::region() const
 {
+    // ground() depends on the background widget of the editor
+    const bool isGround = ground();
+    if (!m_region_dirty && isGround == m_region_ground)
+        return m_region;
+
     QRegion result;
 
     for (int i = 0; i < m_knee_list.size() - 1; ++i)
@@ -729,13 +758,19 @@ QRegion Connection::region() const
         QRect r = m_arrow_head.boundingRect().toRect();
         r = expand(r, 1);
         result = result.united(r);
-    } else if (ground()) {
+    } else if (isGround) {
         result = result.united(groundRect());
     }
 
     result = result.united(labelRect(EndPoint::Source));
     result = result.united(labelRect(EndPoint::Target));
 
+    m_region = result;
+    m_region_dirty = false;
+    if (isGround != m_region_ground) {
+        m_region_ground = isGround;
+        m_edit->invalidateConnectionIndex();
+    }
     return result;
 }
 
@@ -860,6 +895,7 @@ void Connection::setLabel(EndPoint::Type type, const QString &text)
 void Connection::updatePixmap(EndPoint::Type type)
 {
     QPixmap *pm = type == EndPoint::Source ? &m_source_label_pm : &m_target_label_pm;
+    invalidateRegion();
 
     const QString text = label(type);
     if (text.isEmpty()) {
@@ -952,6 +988,8 @@ ConnectionEdit::~ConnectionEdit()
 void ConnectionEdit::clear()
 {
     m_con_list.clear();
+    m_con_index.clear();
+    invalidateConnectionIndex();
     m_sel_con_set.clear();
     m_bg_widget = nullptr;
     m_widget_under_mouse = nullptr;
@@ -966,6 +1004,7 @@ void ConnectionEdit::setBackground(QWidget *background)
     }
 
     m_bg_widget = background;
+    invalidateConnectionIndex();
     updateBackground();
 }
 
@@ -1037,7 +1076,7 @@ void ConnectionEdit::paintLabel(QPainter *p, EndPoint::Type type, Connection *co
     p->drawRect(fixRect(r));
 }
 
-void ConnectionEdit::paintConnection(QPainter *p, Connection *con,
+void ConnectionEdit::paintConnection(QPainter *p, const QRegion &clip, Connection *con,
                                         WidgetSet *heavy_highlight_set,
                                         WidgetSet *light_highlight_set) const
 {
@@ -1046,8 +1085,12 @@ void ConnectionEdit::paintConnection(QPainter *p, Connection *con,
 
     const bool heavy = selected(con) || con == m_tmp_con;
     WidgetSet *set = heavy ? heavy_highlight_set : light_highlight_set;
-    p->setPen(heavy ? m_active_color : m_inactive_color);
-    con->paint(p);
+    // The highlighted end point widgets are collected regardless of the clip
+    // since they may lie in the exposed area while the line does not.
+    if (clip.intersects(con->boundingRect())) {
+        p->setPen(heavy ? m_active_color : m_inactive_color);
+        con->paint(p);
+    }
 
     if (source != nullptr && source != m_bg_widget)
         set->insert(source, source);
@@ -1059,7 +1102,8 @@ void ConnectionEdit::paintConnection(QPainter *p, Connection *con,
 void ConnectionEdit::paintEvent(QPaintEvent *e)
 {
     QPainter p(this);
-    p.setClipRegion(e->region());
+    const QRegion &clip = e->region();
+    p.setClipRegion(clip);
 
     WidgetSet heavy_highlight_set, light_highlight_set;
 
@@ -1067,11 +1111,11 @@ void ConnectionEdit::paintEvent(QPaintEvent *e)
         if (!con->isVisible())
             continue;
 
-        paintConnection(&p, con, &heavy_highlight_set, &light_highlight_set);
+        paintConnection(&p, clip, con, &heavy_highlight_set, &light_highlight_set);
     }
 
     if (m_tmp_con != nullptr)
-        paintConnection(&p, m_tmp_con, &heavy_highlight_set, &light_highlight_set);
+        paintConnection(&p, clip, m_tmp_con, &heavy_highlight_set, &light_highlight_set);
 
     if (!m_widget_under_mouse.isNull() && m_widget_under_mouse != m_bg_widget)
         heavy_highlight_set.insert(m_widget_under_mouse, m_widget_under_mouse);
@@ -1082,7 +1126,9 @@ void ConnectionEdit::paintEvent(QPaintEvent *e)
     p.setBrush(c);
 
     for (QWidget *w : qAsConst(heavy_highlight_set)) {
-        p.drawRect(fixRect(widgetRect(w)));
+        const QRect r = widgetRect(w);
+        if (clip.intersects(r))
+            p.drawRect(fixRect(r));
         light_highlight_set.remove(w);
     }
 
@@ -1091,13 +1137,16 @@ void ConnectionEdit::paintEvent(QPaintEvent *e)
     c.setAlpha(BG_ALPHA);
     p.setBrush(c);
 
-    for (QWidget *w : qAsConst(light_highlight_set))
-        p.drawRect(fixRect(widgetRect(w)));
+    for (QWidget *w : qAsConst(light_highlight_set)) {
+        const QRect r = widgetRect(w);
+        if (clip.intersects(r))
+            p.drawRect(fixRect(r));
+    }
 
     p.setBrush(palette().color(QPalette::Base));
     p.setPen(palette().color(QPalette::Text));
     for (Connection *con : qAsConst(m_con_list)) {
-        if (con->isVisible()) {
+        if (con->isVisible() && clip.intersects(con->boundingRect())) {
             paintLabel(&p, EndPoint::Source, con);
             paintLabel(&p, EndPoint::Target, con);
         }
@@ -1441,9 +1490,40 @@ void ConnectionEdit::selectAll()
         setSelected(con, true);
 }
 
-Connection *ConnectionEdit::connectionAt(const QPoint &pos) const
+void ConnectionEdit::updateConnectionIndex() const
 {
+    if (!m_con_index_dirty)
+        return;
+
+    // Register each connection in the grid cells touched by the rectangles
+    // of its region, in list order, so that connectionAt() still returns the
+    // first matching connection.
+    m_con_index.clear();
     for (Connection *con : m_con_list) {
+        const QRegion region = con->region();
+        QSet<quint64> cells;
+        for (const QRect &r : region) {
+            const int right = indexCell(r.right());
+            const int bottom = indexCell(r.bottom());
+            for (int column = indexCell(r.left()); column <= right; ++column) {
+                for (int row = indexCell(r.top()); row <= bottom; ++row)
+                    cells.insert(cellKey(column, row));
+            }
+        }
+        for (quint64 key : qAsConst(cells))
+            m_con_index[key].append(con);
+    }
+    // region() may have flagged the index again while it was being built
+    m_con_index_dirty = false;
+}
+
+Connection *ConnectionEdit::connectionAt(const QPoint &pos) const
+{
+    updateConnectionIndex();
+    const auto it = m_con_index.constFind(cellKey(indexCell(pos.x()), indexCell(pos.y())));
+    if (it == m_con_index.cend())
+        return nullptr;
+    for (Connection *con : it.value()) {
         if (con->contains(pos))
             return con;
     }
@@ -1512,6 +1592,7 @@ void ConnectionEdit::deleteSelected()
 void ConnectionEdit::addConnection(Connection *con)
 {
     m_con_list.append(con);
+    invalidateConnectionIndex();
 }
 
 void ConnectionEdit::updateLines()
@@ -1559,6 +1640,7 @@ Connection *ConnectionEdit::takeConnection(Connection *con)
     if (!m_con_list.contains(con))
         return nullptr;
     m_con_list.removeAll(con);
+    invalidateConnectionIndex();
     return con;
 }
 
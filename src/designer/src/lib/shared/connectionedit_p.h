@@ -50,6 +50,7 @@
 #include <QtWidgets/qwidget.h>
 #include <QtGui/qpixmap.h>
 #include <QtGui/qpolygon.h>
+#include <QtGui/qregion.h>
 #include <QtGui/qundostack.h>
 
 QT_BEGIN_NAMESPACE
@@ -110,6 +111,7 @@ public:
     void setVisible(bool b);
 
     virtual QRegion region() const;
+    QRect boundingRect() const { return region().boundingRect(); }
     bool contains(const QPoint &pos) const;
     virtual void paint(QPainter *p) const;
 
@@ -138,7 +140,13 @@ private:
     QPixmap m_source_label_pm, m_target_label_pm;
     QRect m_source_rect, m_target_rect;
     bool m_visible;
+    // The region is needed for every hit test and repaint; it is
+    // recomputed only after the knees, labels or background change.
+    mutable QRegion m_region;
+    mutable bool m_region_dirty = true;
+    mutable bool m_region_ground = false;
 
+    void invalidateRegion();
     void setSource(QObject *source, const QPoint &pos);
     void setTarget(QObject *target, const QPoint &pos);
     void updateKneeList();
@@ -240,11 +248,12 @@ private:
     void adjustHotSopt(const EndPoint &end_point, const QPoint &pos);
     Connection *connectionAt(const QPoint &pos) const;
     EndPoint endPointAt(const QPoint &pos) const;
-    void paintConnection(QPainter *p, Connection *con,
+    void paintConnection(QPainter *p, const QRegion &clip, Connection *con,
                          WidgetSet *heavy_highlight_set,
                          WidgetSet *light_highlight_set) const;
     void paintLabel(QPainter *p, EndPoint::Type type, Connection *con);
-
+    void invalidateConnectionIndex() { m_con_index_dirty = true; }
+    void updateConnectionIndex() const;
 
     QPointer<QWidget> m_bg_widget;
     QUndoStack *m_undo_stack;
@@ -262,6 +271,10 @@ private:
     const QColor m_inactive_color;
     const QColor m_active_color;
 
+    // Grid of connections for hit testing, keyed by cell (see cellKey()).
+    mutable QHash<quint64, ConnectionList> m_con_index;
+    mutable bool m_con_index_dirty = true;
+
 private:
     friend class Connection;
     friend class AddConnectionCommand;
@@ -44,6 +44,10 @@
 #include <QtDesigner/qextensionmanager.h>
 #include <QtDesigner/taskmenu.h>
 #include <QtDesigner/abstractintegration.h>
+#include <QtDesigner/abstractlanguage.h>
+
+#include <QtDesigner/private/ui4_p.h>
+#include <QtDesigner/private/formbuilderextra_p.h>
 
 #include <QtWidgets/qmenu.h>
 #include <QtWidgets/qlistwidget.h>
@@ -59,15 +63,64 @@
 
 #include <QtGui/qaction.h>
 
+#include <QtCore/qdatetime.h>
 #include <QtCore/qdebug.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qset.h>
+#include <QtCore/qurl.h>
+#include <QtCore/qthreadpool.h>
 #include <QtCore/qtimer.h>
 
+#include <future>
+#include <map>
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 namespace qdesigner_internal {
 
+// Forms parsed on background threads by parseFormsInBackground(). Only
+// accessed from the GUI thread, the workers just fill in the futures.
+struct ParsedForm
+{
+    DomUI *ui = nullptr;
+    QString errorMessage;
+    QDateTime lastModified;
+};
+
+struct BackgroundParsedForms
+{
+    ~BackgroundParsedForms() { clear(); }
+    void clear();
+
+    std::map<QString, std::future<ParsedForm>> forms;
+};
+
+void BackgroundParsedForms::clear()
+{
+    for (auto &form : forms)
+        delete form.second.get().ui;
+    forms.clear();
+}
+
+Q_GLOBAL_STATIC(BackgroundParsedForms, backgroundParsedForms)
+
+static ParsedForm parseForm(const QString &fileName, const QString &language)
+{
+    ParsedForm result;
+    QFile file(fileName);
+    result.lastModified = QFileInfo(file).lastModified();
+    if (!file.open(QFile::ReadOnly|QFile::Text)) {
+        result.errorMessage = FormWindowBase::tr("The file <b>%1</b> could not be opened: %2")
+                              .arg(file.fileName(), file.errorString());
+        return result;
+    }
+    result.ui = QFormBuilderExtra::readUi(&file, language, &result.errorMessage);
+    return result;
+}
+
 class FormWindowBasePrivate {
 public:
     explicit FormWindowBasePrivate(QDesignerFormEditorInterface *core);
@@ -87,6 +140,8 @@ public:
     FormWindowBase::ResourceFileSaveMode m_saveResourcesBehaviour;
     bool m_useIdBasedTranslations;
     bool m_connectSlotsByName;
+    int m_batchChangeDepth = 0;
+    QSharedPointer<DomUI> m_domSnapshot;
 };
 
 FormWindowBasePrivate::FormWindowBasePrivate(QDesignerFormEditorInterface *core) :
@@ -115,6 +170,26 @@ FormWindowBase::FormWindowBase(QDesignerFormEditorInterface *core, QWidget *pare
     m_d->m_iconCache = new DesignerIconCache(m_d->m_pixmapCache, this);
     if (core->integration()->hasFeature(QDesignerIntegrationInterface::DefaultWidgetActionFeature))
         connect(this, &QDesignerFormWindowInterface::activated, this, &FormWindowBase::triggerDefaultAction);
+    // Commands emit changed(); resizing the form and editing the resource
+    // file list are not commands.
+    connect(this, &QDesignerFormWindowInterface::changed, this, &FormWindowBase::invalidateDomSnapshot);
+    connect(this, &QDesignerFormWindowInterface::geometryChanged, this, &FormWindowBase::invalidateDomSnapshot);
+    connect(this, &QDesignerFormWindowInterface::mainContainerChanged, this, &FormWindowBase::invalidateDomSnapshot);
+    connect(this, &QDesignerFormWindowInterface::resourceFilesChanged, this, &FormWindowBase::invalidateDomSnapshot);
+    // Paths are saved relative to the form file
+    connect(this, &QDesignerFormWindowInterface::fileNameChanged, this, &FormWindowBase::invalidateDomSnapshot);
+}
+
+QSharedPointer<DomUI> FormWindowBase::domSnapshot() const
+{
+    if (m_d->m_domSnapshot.isNull())
+        m_d->m_domSnapshot.reset(createDomUi());
+    return m_d->m_domSnapshot;
+}
+
+void FormWindowBase::invalidateDomSnapshot()
+{
+    m_d->m_domSnapshot.reset();
 }
 
 FormWindowBase::~FormWindowBase()
@@ -223,15 +298,65 @@ void FormWindowBase::sheetDestroyed(QObject *object)
     }
 }
 
+// Check whether a reloadable property value might reference one of the resource paths
+static bool referencesResources(const QVariant &value, const QSet<QString> &resourcePaths)
+{
+    if (value.canConvert<PropertySheetPixmapValue>())
+        return resourcePaths.contains(qvariant_cast<PropertySheetPixmapValue>(value).path());
+    if (value.canConvert<PropertySheetIconValue>()) {
+        const auto &paths = qvariant_cast<PropertySheetIconValue>(value).paths();
+        for (auto it = paths.cbegin(), end = paths.cend(); it != end; ++it) {
+            if (resourcePaths.contains(it.value().path()))
+                return true;
+        }
+        return false;
+    }
+    // Texts, style sheets and URLs: Check for a reference to qt resources
+    QString text;
+    if (value.canConvert<PropertySheetStringValue>())
+        text = qvariant_cast<PropertySheetStringValue>(value).value();
+    else if (value.metaType().id() == QMetaType::QUrl)
+        text = value.toUrl().toString();
+    else
+        text = value.toString();
+    return text.contains(QStringLiteral(":/"));
+}
+
 void FormWindowBase::reloadProperties()
+{
+    reloadResourceProperties(nullptr);
+}
+
+void FormWindowBase::reloadProperties(const QStringList &resourcePaths)
+{
+    const QSet<QString> resourcePathSet(resourcePaths.cbegin(), resourcePaths.cend());
+    reloadResourceProperties(&resourcePathSet);
+}
+
+// Reload all properties or those referencing the given resource paths
+void FormWindowBase::reloadResourceProperties(const QSet<QString> *resourcePaths)
 {
     pixmapCache()->clear();
     iconCache()->clear();
+    // Decode the pixmaps to be reloaded in the background
+    QStringList pixmapPaths;
+    for (auto it = m_d->m_reloadableResources.cbegin(), end = m_d->m_reloadableResources.cend(); it != end; ++it) {
+        for (auto jt = it.value().cbegin(), end = it.value().cend(); jt != end; ++jt) {
+            const QVariant value = it.key()->property(jt.key());
+            if (value.canConvert<PropertySheetPixmapValue>()
+                && (!resourcePaths || referencesResources(value, *resourcePaths)))
+                pixmapPaths.append(qvariant_cast<PropertySheetPixmapValue>(value).path());
+        }
+    }
+    DesignerImageCache::prefetch(pixmapPaths);
+
     for (auto it = m_d->m_reloadableResources.cbegin(), end = m_d->m_reloadableResources.cend(); it != end; ++it) {
         QDesignerPropertySheet *sheet = it.key();
         for (auto jt = it.value().begin(), end = it.value().end(); jt != end; ++jt) {
             const int index = jt.key();
             const QVariant newValue = sheet->property(index);
+            if (resourcePaths && !referencesResources(newValue, *resourcePaths))
+                continue;
             if (qobject_cast<QLabel *>(sheet->object()) && sheet->propertyName(index) == QStringLiteral("text")) {
                 const PropertySheetStringValue newString = qvariant_cast<PropertySheetStringValue>(newValue);
                 // optimize a bit, reset only if the text value might contain a reference to qt resources
@@ -281,6 +406,18 @@ void FormWindowBase::resourceSetActivated(QtResourceSet *resource, bool resource
     }
 }
 
+void FormWindowBase::resourceSetReloaded(QtResourceSet *resource, const QStringList &,
+                                         const QStringList &resourcePaths)
+{
+    if (resource == resourceSet()) {
+        reloadProperties(resourcePaths);
+        emit pixmapCache()->reloaded();
+        emit iconCache()->reloaded();
+        if (QDesignerPropertyEditor *propertyEditor = qobject_cast<QDesignerPropertyEditor *>(core()->propertyEditor()))
+            propertyEditor->reloadResourceProperties();
+    }
+}
+
 QVariantMap FormWindowBase::formData()
 {
     QVariantMap rc;
@@ -570,6 +707,67 @@ QStringList FormWindowBase::checkContents() const
     return problems;
 }
 
+void FormWindowBase::beginBatchChange()
+{
+    ++m_d->m_batchChangeDepth;
+}
+
+void FormWindowBase::endBatchChange()
+{
+    Q_ASSERT(m_d->m_batchChangeDepth > 0);
+    --m_d->m_batchChangeDepth;
+}
+
+bool FormWindowBase::isBatchChange() const
+{
+    return m_d->m_batchChangeDepth > 0;
+}
+
+void FormWindowBase::parseFormsInBackground(QDesignerFormEditorInterface *core,
+                                            const QStringList &fileNames)
+{
+    // Check the language unless an extension is present (Jambi), as QDesignerResource does.
+    QString language = QStringLiteral("c++");
+    if (const QDesignerLanguageExtension *le = qt_extension<QDesignerLanguageExtension*>(core->extensionManager(), core))
+        language = le->name();
+
+    BackgroundParsedForms *parsedForms = backgroundParsedForms();
+    parsedForms->clear();
+    for (const QString &fileName : fileNames) {
+        if (parsedForms->forms.find(fileName) != parsedForms->forms.end())
+            continue;
+        // Shared, as the pool takes copyable functions only
+        auto result = std::make_shared<std::promise<ParsedForm>>();
+        parsedForms->forms.emplace(fileName, result->get_future());
+        QThreadPool::globalInstance()->start([result, fileName, language] {
+            result->set_value(parseForm(fileName, language));
+        });
+    }
+}
+
+bool FormWindowBase::setContentsFromFile(QFile *file, QString *errorMessage)
+{
+    BackgroundParsedForms *parsedForms = backgroundParsedForms();
+    const auto it = parsedForms->forms.find(file->fileName());
+    if (it == parsedForms->forms.end())
+        return setContents(file, errorMessage);
+
+    ParsedForm form = it->second.get();
+    parsedForms->forms.erase(it);
+    // Parse again if the file was modified in the meantime
+    if (form.lastModified != QFileInfo(*file).lastModified()) {
+        delete form.ui;
+        return setContents(file, errorMessage);
+    }
+    if (!form.ui) {
+        designerWarning(form.errorMessage);
+        if (errorMessage)
+            *errorMessage = form.errorMessage;
+        return false;
+    }
+    return setContents(form.ui, errorMessage);
+}
+
 } // namespace qdesigner_internal
 
 QT_END_NAMESPACE
@@ -46,10 +46,13 @@
 
 #include <QtCore/qvariant.h>
 #include <QtCore/qlist.h>
+#include <QtCore/qsharedpointer.h>
 
 QT_BEGIN_NAMESPACE
 
+class DomUI;
 class QDesignerDnDItemInterface;
+class QFile;
 class QMenu;
 class QtResourceSet;
 class QDesignerPropertySheet;
@@ -140,6 +143,8 @@ public:
     void removeReloadableProperty(QDesignerPropertySheet *sheet, int index);
     void addReloadablePropertySheet(QDesignerPropertySheet *sheet, QObject *object);
     void reloadProperties();
+    // Reload the properties referencing the resources (after reloading some qrc files)
+    void reloadProperties(const QStringList &resourcePaths);
 
     void emitWidgetRemoved(QWidget *w);
     void emitObjectRemoved(QObject *o);
@@ -168,8 +173,38 @@ public:
     bool connectSlotsByName() const;
     void setConnectSlotsByName(bool v);
 
+    // While a command applies a change to many objects, per-widget updates
+    // like those of the selection handles are deferred and done once.
+    void beginBatchChange();
+    void endBatchChange();
+    bool isBatchChange() const;
+
+    // Start parsing form files on background threads when opening several
+    // forms, so that setContentsFromFile() only needs to create the widgets.
+    static void parseFormsInBackground(QDesignerFormEditorInterface *core,
+                                       const QStringList &fileNames);
+    // Set the contents from a form file, using the result of
+    // parseFormsInBackground() if there is one.
+    bool setContentsFromFile(QFile *file, QString *errorMessage);
+    // Create the widgets of a parsed form, takes ownership of the DomUI
+    virtual bool setContents(DomUI *ui, QString *errorMessage) = 0;
+    using QDesignerFormWindowInterface::setContents;
+
+    // DOM of the form as it would be saved. It is created on demand and
+    // shared until the form is changed, so that previews do not need to
+    // write and parse the XML.
+    QSharedPointer<DomUI> domSnapshot() const;
+
+protected:
+    // Overwrite to create the DOM of the form, returns nullptr if there is
+    // no main container
+    virtual DomUI *createDomUi() const = 0;
+    void invalidateDomSnapshot();
+
 public slots:
     void resourceSetActivated(QtResourceSet *resourceSet, bool resourceSetChanged);
+    void resourceSetReloaded(QtResourceSet *resourceSet, const QStringList &qrcPaths,
+                             const QStringList &resourcePaths);
 
 private slots:
     void triggerDefaultAction(QWidget *w);
@@ -177,6 +212,7 @@ private slots:
 
 private:
     void syncGridFeature();
+    void reloadResourceProperties(const QSet<QString> *resourcePaths);
     void connectSheet(QDesignerPropertySheet *sheet);
     void disconnectSheet(QDesignerPropertySheet *sheet);
 
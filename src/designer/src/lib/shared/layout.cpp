@@ -43,6 +43,7 @@
 #include <QtDesigner/qextensionmanager.h>
 
 #include <QtCore/qdebug.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qset.h>
 
@@ -606,7 +607,21 @@ public:
     bool locateWidget(QWidget* w, int& row, int& col, int& rowspan, int& colspan) const;
 
 private:
-    void setCell(int row, int col, QWidget* w) { m_cells[ row * m_ncols + col] = w; }
+    using WidgetLocations = QHash<QWidget *, QRect>; // cell rectangles
+
+    void setCell(int row, int col, QWidget* w)
+    {
+        m_cells[ row * m_ncols + col] = w;
+        m_locationsValid = false;
+    }
+    void updateCell(int row, int col, QWidget *w);
+    bool startsCol(int r, int c) const;
+    bool endsCol(int r, int c) const;
+    bool startsRow(int r, int c) const;
+    bool endsRow(int r, int c) const;
+    void computeEdgeCounts();
+    void adjustEdgeCounts(int r, int c, int delta);
+    WidgetLocations widgetLocations() const;
     void shrink();
     void reallocFormLayout();
     int countRow(int r, int c) const;
@@ -629,6 +644,18 @@ private:
     int m_ncols;
 
     QWidget** m_cells; // widget matrix w11, w12, w21...
+
+    // Number of rows in which a widget starts/ends at a column and of
+    // columns in which a widget starts/ends at a row. Maintained by
+    // updateCell() while the widgets are extended so that the extend
+    // functions do not need to scan whole rows and columns.
+    QList<int> m_colStarts;
+    QList<int> m_colEnds;
+    QList<int> m_rowStarts;
+    QList<int> m_rowEnds;
+
+    mutable WidgetLocations m_locations;
+    mutable bool m_locationsValid = false;
 };
 
 Grid::Grid(Mode mode) :
@@ -646,6 +673,7 @@ Grid::~Grid()
 
 void Grid::resize(int nrows, int ncols)
 {
+    m_locationsValid = false;
     delete [] m_cells;
     m_cells = nullptr;
     m_nrows = nrows;
@@ -658,6 +686,7 @@ void Grid::resize(int nrows, int ncols)
 
 void Grid::setCells(const QRect &c, QWidget* w)
 {
+    m_locationsValid = false;
     const int bottom = c.top() + c.height();
     const int width =  c.width();
 
@@ -688,50 +717,105 @@ int Grid::countCol(int r, int c) const
 void Grid::setCol(int r, int c, QWidget* w, int count)
 {
     for (int i = 0; i < count; i++)
-        setCell(r + i, c, w);
+        updateCell(r + i, c, w);
 }
 
 void Grid::setRow(int r, int c, QWidget* w, int count)
 {
     for (int i = 0; i < count; i++)
-        setCell(r, c + i, w);
+        updateCell(r, c + i, w);
 }
 
-bool Grid::isWidgetStartCol(int c) const
+bool Grid::startsCol(int r, int c) const
+{
+    QWidget *w = cell(r, c);
+    return w && (c == 0 || cell(r, c - 1) != w);
+}
+
+bool Grid::endsCol(int r, int c) const
+{
+    QWidget *w = cell(r, c);
+    return w && (c == m_ncols - 1 || cell(r, c + 1) != w);
+}
+
+bool Grid::startsRow(int r, int c) const
+{
+    QWidget *w = cell(r, c);
+    return w && (r == 0 || cell(r - 1, c) != w);
+}
+
+bool Grid::endsRow(int r, int c) const
+{
+    QWidget *w = cell(r, c);
+    return w && (r == m_nrows - 1 || cell(r + 1, c) != w);
+}
+
+void Grid::computeEdgeCounts()
 {
+    m_colStarts.fill(0, m_ncols);
+    m_colEnds.fill(0, m_ncols);
+    m_rowStarts.fill(0, m_nrows);
+    m_rowEnds.fill(0, m_nrows);
     for (int r = 0; r < m_nrows; r++) {
-        if (cell(r, c) && ((c==0) || (cell(r, c)  != cell(r, c-1)))) {
-            return true;
+        for (int c = 0; c < m_ncols; c++) {
+            if (startsCol(r, c))
+                ++m_colStarts[c];
+            if (endsCol(r, c))
+                ++m_colEnds[c];
+            if (startsRow(r, c))
+                ++m_rowStarts[r];
+            if (endsRow(r, c))
+                ++m_rowEnds[r];
         }
     }
-    return false;
+}
+
+// Add the edges that depend on cell (r, c) to the counts
+void Grid::adjustEdgeCounts(int r, int c, int delta)
+{
+    if (startsCol(r, c))
+        m_colStarts[c] += delta;
+    if (c + 1 < m_ncols && startsCol(r, c + 1))
+        m_colStarts[c + 1] += delta;
+    if (endsCol(r, c))
+        m_colEnds[c] += delta;
+    if (c > 0 && endsCol(r, c - 1))
+        m_colEnds[c - 1] += delta;
+    if (startsRow(r, c))
+        m_rowStarts[r] += delta;
+    if (r + 1 < m_nrows && startsRow(r + 1, c))
+        m_rowStarts[r + 1] += delta;
+    if (endsRow(r, c))
+        m_rowEnds[r] += delta;
+    if (r > 0 && endsRow(r - 1, c))
+        m_rowEnds[r - 1] += delta;
+}
+
+void Grid::updateCell(int row, int col, QWidget *w)
+{
+    adjustEdgeCounts(row, col, -1);
+    setCell(row, col, w);
+    adjustEdgeCounts(row, col, 1);
+}
+
+bool Grid::isWidgetStartCol(int c) const
+{
+    return m_colStarts.at(c) > 0;
 }
 
 bool Grid::isWidgetEndCol(int c) const
 {
-    for (int r = 0; r < m_nrows; r++) {
-        if (cell(r, c) && ((c == m_ncols-1) || (cell(r, c) != cell(r, c+1))))
-            return true;
-    }
-    return false;
+    return m_colEnds.at(c) > 0;
 }
 
 bool Grid::isWidgetStartRow(int r) const
 {
-    for ( int c = 0; c < m_ncols; c++) {
-        if (cell(r, c) && ((r==0) || (cell(r, c) != cell(r-1, c))))
-            return true;
-    }
-    return false;
+    return m_rowStarts.at(r) > 0;
 }
 
 bool Grid::isWidgetEndRow(int r) const
 {
-    for (int c = 0; c < m_ncols; c++) {
-        if (cell(r, c) && ((r == m_nrows-1) || (cell(r, c) != cell(r+1, c))))
-            return true;
-    }
-    return false;
+    return m_rowEnds.at(r) > 0;
 }
 
 
@@ -868,6 +952,7 @@ void Grid::simplify()
     case GridLayout:
         // Grid: Extend all widgets to occupy most space and delete
         // rows/columns that are not bordering on a widget
+        computeEdgeCounts();
         extendLeft();
         extendRight();
         extendUp();
@@ -879,6 +964,7 @@ void Grid::simplify()
         // regarding spanning and shrinking. Then restrict the span to
         // the horizontal span possible in the form, simplify again
         // and spread the widgets over a 2-column layout
+        computeEdgeCounts();
         extendLeft();
         extendRight();
         extendUp();
@@ -922,6 +1008,7 @@ void Grid::shrink()
                     simplifiedPtr++;
                 }
     Q_ASSERT(simplifiedPtr == simplifiedCells + simplifiedNCols * simplifiedNRows);
+    m_locationsValid = false;
     delete [] m_cells;
     m_cells = simplifiedCells;
     m_nrows = simplifiedNRows;
@@ -931,23 +1018,17 @@ void Grid::shrink()
 bool Grid::shrinkFormLayoutSpans()
 {
     bool shrunk = false;
-    using WidgetSet = QSet<QWidget *>;
-    // Determine unique set of widgets
-    WidgetSet widgets;
-    QWidget **end =  m_cells + m_ncols * m_nrows;
-    for (QWidget **wptr = m_cells; wptr < end; wptr++)
-        if (QWidget *w = *wptr)
-            widgets.insert(w);
+    // Determine unique set of widgets. Clearing the cells of a widget
+    // does not move the others, so their locations can be determined once.
+    const WidgetLocations locations = widgetLocations();
     // Restrict the widget span: max horizontal span at column 0: 2, anything else: 1
     const int maxRowSpan = 1;
-    const WidgetSet::const_iterator cend = widgets.constEnd();
-    for (WidgetSet::const_iterator it = widgets.constBegin(); it != cend ; ++it) {
-        QWidget *w = *it;
-        int row, col,  rowspan, colspan;
-        if (!locateWidget(w, row, col, rowspan, colspan)) {
-            qDebug("ooops, widget '%s' does not fit in layout", w->objectName().toUtf8().constData());
-            row = col = rowspan = colspan = 0;
-        }
+    for (auto it = locations.cbegin(), cend = locations.cend(); it != cend; ++it) {
+        QWidget *w = it.key();
+        const int row = it.value().top();
+        const int col = it.value().left();
+        const int rowspan = it.value().height();
+        const int colspan = it.value().width();
         const int maxColSpan = col == 0 ? 2 : 1;
         const int newColSpan = qMin(colspan, maxColSpan);
         const int newRowSpan = qMin(rowspan, maxRowSpan);
@@ -1027,23 +1108,46 @@ void Grid::reallocFormLayout()
             }
     }
     Q_ASSERT(formPtr == formCells + FormLayoutColumns * formNRows);
+    m_locationsValid = false;
     delete [] m_cells;
     m_cells = formCells;
     m_nrows = formNRows;
     m_ncols = FormLayoutColumns;
 }
 
+// Locate all widgets by their first cell in row-major order
+Grid::WidgetLocations Grid::widgetLocations() const
+{
+    WidgetLocations result;
+    for (int row = 0; row < m_nrows; row++) {
+        for (int col = 0; col < m_ncols; col++) {
+            QWidget *w = cell(row, col);
+            if (w == nullptr || result.contains(w))
+                continue;
+            int rowspan = 1;
+            int colspan = 1;
+            for ( ; row + rowspan < m_nrows && cell(row + rowspan, col) == w; rowspan++) {}
+            for ( ; col + colspan < m_ncols && cell(row, col + colspan) == w; colspan++) {}
+            result.insert(w, QRect(col, row, colspan, rowspan));
+        }
+    }
+    return result;
+}
+
 bool Grid::locateWidget(QWidget *w, int &row, int &col, int &rowspan, int &colspan) const
 {
-    const int end = m_nrows * m_ncols;
-    const int startIndex = std::find(m_cells, m_cells + end, w) - m_cells;
-    if (startIndex == end)
+    if (!m_locationsValid) {
+        m_locations = widgetLocations();
+        m_locationsValid = true;
+    }
+    const auto it = m_locations.constFind(w);
+    if (it == m_locations.cend())
         return false;
 
-    row = startIndex / m_ncols;
-    col = startIndex % m_ncols;
-    for (rowspan = 1; row + rowspan < m_nrows && cell(row + rowspan, col) == w; rowspan++) {}
-    for (colspan = 1; col + colspan < m_ncols && cell(row, col + colspan) == w; colspan++) {}
+    row = it.value().top();
+    col = it.value().left();
+    rowspan = it.value().height();
+    colspan = it.value().width();
     return true;
 }
 
@@ -1186,37 +1290,34 @@ QWidgetList GridLayout<GridLikeLayout, LayoutType, GridMode>::buildGrid(const QW
         const QRect widgetPos = expandGeometry(w->geometry());
         QRect c(0, 0, 0, 0); // rect of columns/rows
 
-        // From left til right (not including)
-        const int leftIdx = x.indexOf(widgetPos.left());
-        Q_ASSERT(leftIdx != -1);
+        // From left til right (not including); the coordinates are sorted
+        const auto leftIt = std::lower_bound(x.cbegin(), x.cend(), widgetPos.left());
+        Q_ASSERT(leftIt != x.cend() && *leftIt == widgetPos.left());
+        const int leftIdx = int(leftIt - x.cbegin());
+        const int rightIdx = int(std::lower_bound(leftIt, x.cend(), widgetPos.right()) - x.cbegin()) - 1;
         c.setLeft(leftIdx);
-        c.setRight(leftIdx);
-        for (int cw=leftIdx; cw<x.size(); cw++)
-            if (x[cw] <  widgetPos.right())
-                c.setRight(cw);
-            else
-                break;
+        c.setRight(qMax(leftIdx, rightIdx));
         // From top til bottom (not including)
-        const int topIdx = y.indexOf(widgetPos.top());
-        Q_ASSERT(topIdx != -1);
+        const auto topIt = std::lower_bound(y.cbegin(), y.cend(), widgetPos.top());
+        Q_ASSERT(topIt != y.cend() && *topIt == widgetPos.top());
+        const int topIdx = int(topIt - y.cbegin());
+        const int bottomIdx = int(std::lower_bound(topIt, y.cend(), widgetPos.bottom()) - y.cbegin()) - 1;
         c.setTop(topIdx);
-        c.setBottom(topIdx);
-        for (int ch=topIdx; ch<y.size(); ch++)
-            if (y[ch] <  widgetPos.bottom())
-                c.setBottom(ch);
-            else
-                break;
+        c.setBottom(qMax(topIdx, bottomIdx));
         m_grid.setCells(c, w); // Mark cellblock
     }
 
     m_grid.simplify();
 
     QWidgetList ordered;
+    QSet<QWidget *> seen;
     for (int i = 0; i < m_grid.numRows(); i++)
         for (int j = 0; j < m_grid.numCols(); j++) {
             QWidget *w = m_grid.cell(i, j);
-            if (w && !ordered.contains(w))
+            if (w && !seen.contains(w)) {
+                seen.insert(w);
                 ordered.append(w);
+            }
         }
     return ordered;
 }
@@ -127,9 +127,18 @@ MetaDataBase::~MetaDataBase()
     qDeleteAll(m_items);
 }
 
+MetaDataBaseItem *MetaDataBase::findItem(QObject *object) const
+{
+    if (object != m_lastObject || object == nullptr) {
+        m_lastItem = m_items.value(object);
+        m_lastObject = m_lastItem != nullptr ? object : nullptr;
+    }
+    return m_lastItem;
+}
+
 MetaDataBaseItem *MetaDataBase::metaDataBaseItem(QObject *object) const
 {
-    MetaDataBaseItem *i = m_items.value(object);
+    MetaDataBaseItem *i = findItem(object);
     if (i == nullptr || !i->enabled())
         return nullptr;
     return i;
@@ -137,7 +146,7 @@ MetaDataBaseItem *MetaDataBase::metaDataBaseItem(QObject *object) const
 
 void MetaDataBase::add(QObject *object)
 {
-    MetaDataBaseItem *item = m_items.value(object);
+    MetaDataBaseItem *&item = m_items[object];
     if (item != nullptr) {
         item->setEnabled(true);
         if (debugMetaDatabase) {
@@ -147,7 +156,6 @@ void MetaDataBase::add(QObject *object)
     }
 
     item = new MetaDataBaseItem(object);
-    m_items.insert(object, item);
     if (debugMetaDatabase) {
         qDebug() << "MetaDataBase::add: New item " << object->metaObject()->className() << item->name();
     }
@@ -160,7 +168,7 @@ void MetaDataBase::remove(QObject *object)
 {
     Q_ASSERT(object);
 
-    if (MetaDataBaseItem *item = m_items.value(object)) {
+    if (MetaDataBaseItem *item = findItem(object)) {
         item->setEnabled(false);
         emit changed();
     }
@@ -169,6 +177,7 @@ void MetaDataBase::remove(QObject *object)
 QObjectList MetaDataBase::objects() const
 {
     QObjectList result;
+    result.reserve(m_items.size());
 
     ItemMap::const_iterator it = m_items.begin();
     for (; it != m_items.end(); ++it) {
@@ -186,11 +195,11 @@ QDesignerFormEditorInterface *MetaDataBase::core() const
 
 void MetaDataBase::slotDestroyed(QObject *object)
 {
-    if (m_items.contains(object)) {
-        MetaDataBaseItem *item = m_items.value(object);
-        delete item;
-        m_items.remove(object);
+    if (object == m_lastObject) {
+        m_lastObject = nullptr;
+        m_lastItem = nullptr;
     }
+    delete m_items.take(object);
 }
 
 // promotion convenience
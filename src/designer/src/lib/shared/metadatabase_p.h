@@ -105,9 +105,14 @@ private slots:
     void slotDestroyed(QObject *object);
 
 private:
+    MetaDataBaseItem *findItem(QObject *object) const;
+
     QDesignerFormEditorInterface *m_core;
     typedef QHash<QObject *, MetaDataBaseItem*> ItemMap;
     ItemMap m_items;
+    // Batch operations query the same object several times in a row
+    mutable QObject *m_lastObject = nullptr;
+    mutable MetaDataBaseItem *m_lastItem = nullptr;
 };
 
     // promotion convenience
@@ -47,9 +47,16 @@
 #include <QtCore/qmap.h>
 #include <QtCore/qsettings.h>
 #include <QtCore/qcoreapplication.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qstandardpaths.h>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthreadpool.h>
 
 #include <QtCore/qxmlstream.h>
 
+
 static const char *uiElementC = "ui";
 static const char *languageAttributeC = "language";
 static const char *widgetElementC = "widget";
@@ -225,6 +232,35 @@ QString QDesignerCustomWidgetData::propertyToolTip(const QString &name) const
     return m_d->propertyToolTipMap.value(name);
 }
 
+void QDesignerCustomWidgetData::writeXmlData(QDataStream &str) const
+{
+    const QDesignerCustomWidgetSharedData &data = *m_d;
+    str << data.xmlClassName << data.xmlDisplayName << data.xmlLanguage
+        << data.xmlAddPageMethod << data.xmlExtends;
+    str << qint32(data.xmlStringPropertyTypeMap.size());
+    for (auto it = data.xmlStringPropertyTypeMap.cbegin(), end = data.xmlStringPropertyTypeMap.cend(); it != end; ++it)
+        str << it.key() << qint32(it.value().first) << it.value().second;
+    str << data.propertyToolTipMap;
+}
+
+void QDesignerCustomWidgetData::readXmlData(QDataStream &str)
+{
+    QDesignerCustomWidgetSharedData &data = *m_d;
+    data.clearXML();
+    str >> data.xmlClassName >> data.xmlDisplayName >> data.xmlLanguage
+        >> data.xmlAddPageMethod >> data.xmlExtends;
+    qint32 count = 0;
+    str >> count;
+    for (qint32 i = 0; i < count && str.status() == QDataStream::Ok; ++i) {
+        QString name;
+        qint32 mode;
+        bool translatable;
+        str >> name >> mode >> translatable;
+        data.xmlStringPropertyTypeMap.insert(name, StringPropertyType(qdesigner_internal::TextPropertyValidationMode(mode), translatable));
+    }
+    str >> data.propertyToolTipMap;
+}
+
 // Wind a QXmlStreamReader  until it finds an element. Returns index or one of FindResult
 enum FindResult { FindError = -2, ElementNotFound = -1 };
 
@@ -438,6 +474,205 @@ QDesignerCustomWidgetData::ParseResult
     return rc;
 }
 
+// ---------------- QDesignerPluginCache
+
+/* Stores the load failures of plugin libraries and the parsed Dom XML of
+ * their custom widgets in a file, keyed by the library's modification time
+ * and size, so that Designer does not try to load libraries that failed
+ * before and does not parse the XML of unchanged custom widgets again. */
+
+class QDesignerPluginCache
+{
+public:
+    QDesignerPluginCache();
+
+    bool failure(const QString &plugin, QString *errorMessage);
+    void setFailure(const QString &plugin, const QString &errorMessage);
+    void clearFailures();
+
+    bool widgetData(const QString &plugin, const QString &name, const QString &domXml,
+                    QDesignerCustomWidgetData *data);
+    void setWidgetData(const QString &plugin, const QString &name, const QString &domXml,
+                       const QDesignerCustomWidgetData &data);
+
+    void save();
+
+private:
+    struct WidgetEntry
+    {
+        QString domXml;
+        QByteArray data;
+    };
+
+    struct PluginEntry
+    {
+        qint64 lastModified = 0;
+        qint64 size = 0;
+        QString failure;
+        QHash<QString, WidgetEntry> widgets;
+    };
+
+    PluginEntry &entry(const QString &plugin);
+
+    static constexpr quint32 magic = 0x51445043; // "QDPC"
+    static constexpr quint32 version = 1;
+
+    QString m_fileName;
+    QHash<QString, PluginEntry> m_entries;
+    bool m_modified = false;
+};
+
+QDesignerPluginCache::QDesignerPluginCache()
+{
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (cacheDir.isEmpty())
+        return;
+    m_fileName = cacheDir + u"/plugins.cache"_qs;
+
+    QFile file(m_fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+    QDataStream in(&file);
+    quint32 fileMagic = 0;
+    quint32 fileVersion = 0;
+    quint32 qtVersion = 0;
+    in >> fileMagic >> fileVersion >> qtVersion;
+    if (fileMagic != magic || fileVersion != version || qtVersion != QT_VERSION)
+        return;
+    in.setVersion(QDataStream::Qt_6_0);
+    qint32 pluginCount = 0;
+    in >> pluginCount;
+    for (qint32 p = 0; p < pluginCount && in.status() == QDataStream::Ok; ++p) {
+        QString plugin;
+        PluginEntry pluginEntry;
+        qint32 widgetCount = 0;
+        in >> plugin >> pluginEntry.lastModified >> pluginEntry.size
+           >> pluginEntry.failure >> widgetCount;
+        for (qint32 w = 0; w < widgetCount && in.status() == QDataStream::Ok; ++w) {
+            QString name;
+            WidgetEntry widgetEntry;
+            in >> name >> widgetEntry.domXml >> widgetEntry.data;
+            pluginEntry.widgets.insert(name, widgetEntry);
+        }
+        m_entries.insert(plugin, pluginEntry);
+    }
+    if (in.status() != QDataStream::Ok)
+        m_entries.clear();
+}
+
+// Return the entry of a plugin, reset if the library changed.
+QDesignerPluginCache::PluginEntry &QDesignerPluginCache::entry(const QString &plugin)
+{
+    const QFileInfo fi(plugin);
+    const qint64 lastModified = fi.lastModified().toMSecsSinceEpoch();
+    PluginEntry &result = m_entries[plugin];
+    if (result.lastModified != lastModified || result.size != fi.size()) {
+        result = PluginEntry();
+        result.lastModified = lastModified;
+        result.size = fi.size();
+        m_modified = true;
+    }
+    return result;
+}
+
+bool QDesignerPluginCache::failure(const QString &plugin, QString *errorMessage)
+{
+    const PluginEntry &e = entry(plugin);
+    if (e.failure.isEmpty())
+        return false;
+    *errorMessage = e.failure;
+    return true;
+}
+
+void QDesignerPluginCache::setFailure(const QString &plugin, const QString &errorMessage)
+{
+    PluginEntry &e = entry(plugin);
+    if (e.failure != errorMessage) {
+        e.failure = errorMessage;
+        m_modified = true;
+    }
+}
+
+void QDesignerPluginCache::clearFailures()
+{
+    for (PluginEntry &e : m_entries) {
+        if (!e.failure.isEmpty()) {
+            e.failure.clear();
+            m_modified = true;
+        }
+    }
+}
+
+bool QDesignerPluginCache::widgetData(const QString &plugin, const QString &name,
+                                      const QString &domXml, QDesignerCustomWidgetData *data)
+{
+    const PluginEntry &e = entry(plugin);
+    const auto it = e.widgets.constFind(name);
+    // Compare the XML since collections (Jambi) may change their widgets.
+    if (it == e.widgets.constEnd() || it->domXml != domXml)
+        return false;
+    QDataStream in(it->data);
+    in.setVersion(QDataStream::Qt_6_0);
+    data->readXmlData(in);
+    return in.status() == QDataStream::Ok;
+}
+
+void QDesignerPluginCache::setWidgetData(const QString &plugin, const QString &name,
+                                         const QString &domXml,
+                                         const QDesignerCustomWidgetData &data)
+{
+    WidgetEntry widgetEntry;
+    widgetEntry.domXml = domXml;
+    QDataStream out(&widgetEntry.data, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+    data.writeXmlData(out);
+    entry(plugin).widgets.insert(name, widgetEntry);
+    m_modified = true;
+}
+
+void QDesignerPluginCache::save()
+{
+    if (!m_modified || m_fileName.isEmpty()
+        || !QDir().mkpath(QFileInfo(m_fileName).absolutePath())) {
+        return;
+    }
+    QSaveFile file(m_fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+    QDataStream out(&file);
+    out << magic << version << quint32(QT_VERSION);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << qint32(m_entries.size());
+    for (auto it = m_entries.cbegin(), end = m_entries.cend(); it != end; ++it) {
+        const PluginEntry &e = it.value();
+        out << it.key() << e.lastModified << e.size << e.failure << qint32(e.widgets.size());
+        for (auto wit = e.widgets.cbegin(), wend = e.widgets.cend(); wit != wend; ++wit)
+            out << wit.key() << wit->domXml << wit->data;
+    }
+    if (file.commit())
+        m_modified = false;
+}
+
+// Load plugin libraries concurrently, return the error messages. Only the
+// libraries are loaded here; the plugin instances are created later on in
+// the GUI thread by QPluginLoader::instance().
+static QStringList loadPluginLibraries(const QStringList &plugins)
+{
+    QStringList errorMessages(plugins.size());
+    QString *messages = errorMessages.data(); // detached once, for the workers
+    QSemaphore done;
+    for (qsizetype i = 0; i < plugins.size(); ++i) {
+        QThreadPool::globalInstance()->start([&plugins, messages, &done, i]() {
+            QPluginLoader loader(plugins.at(i));
+            if (!loader.isLoaded() && !loader.load())
+                messages[i] = loader.errorString();
+            done.release();
+        });
+    }
+    done.acquire(plugins.size());
+    return errorMessages;
+}
+
 // ---------------- QDesignerPluginManagerPrivate
 
 class QDesignerPluginManagerPrivate {
@@ -470,6 +705,8 @@ class QDesignerPluginManagerPrivate {
 
     QStringList defaultPluginPaths() const;
 
+    QDesignerPluginCache m_cache;
+
     bool m_initialized;
 };
 
@@ -499,11 +736,13 @@ bool QDesignerPluginManagerPrivate::addCustomWidget(QDesignerCustomWidgetInterfa
     // Parse the XML even if the plugin is initialized as Jambi might play tricks here
     QDesignerCustomWidgetData data(pluginPath);
     const QString domXml = c->domXml();
-    if (!domXml.isEmpty()) { // Legacy: Empty XML means: Do not show up in widget box.
+    if (!domXml.isEmpty() // Legacy: Empty XML means: Do not show up in widget box.
+        && !m_cache.widgetData(pluginPath, c->name(), domXml, &data)) {
         QString errorMessage;
         const QDesignerCustomWidgetData::ParseResult pr = data.parseXml(domXml, c->name(), &errorMessage);
         switch (pr) {
             case QDesignerCustomWidgetData::ParseOk:
+            m_cache.setWidgetData(pluginPath, c->name(), domXml, data);
             break;
             case QDesignerCustomWidgetData::ParseWarning:
             qdesigner_internal::designerWarning(errorMessage);
@@ -512,11 +751,11 @@ bool QDesignerPluginManagerPrivate::addCustomWidget(QDesignerCustomWidgetInterfa
             qdesigner_internal::designerWarning(errorMessage);
             return false;
         }
-        // Does the language match?
-        const QString pluginLanguage = data.xmlLanguage();
-        if (!pluginLanguage.isEmpty() && pluginLanguage.compare(designerLanguage, Qt::CaseInsensitive))
-            return false;
     }
+    // Does the language match?
+    const QString pluginLanguage = data.xmlLanguage();
+    if (!pluginLanguage.isEmpty() && pluginLanguage.compare(designerLanguage, Qt::CaseInsensitive))
+        return false;
     m_customWidgets.push_back(c);
     m_customWidgetData.push_back(data);
     return true;
@@ -561,6 +800,7 @@ QDesignerPluginManager::QDesignerPluginManager(QDesignerFormEditorInterface *cor
 QDesignerPluginManager::~QDesignerPluginManager()
 {
     syncSettings();
+    m_d->m_cache.save();
     delete m_d;
 }
 
@@ -653,6 +893,7 @@ void QDesignerPluginManager::updateRegisteredPlugins()
     m_d->m_registeredPlugins.clear();
     for (const QString &path : qAsConst(m_d->m_pluginPaths))
         registerPath(path);
+    m_d->m_cache.save();
 }
 
 bool QDesignerPluginManager::registerNewPlugins()
@@ -661,6 +902,8 @@ bool QDesignerPluginManager::registerNewPlugins()
         qDebug() << Q_FUNC_INFO;
 
     const int before = m_d->m_registeredPlugins.size();
+    // Retry plugins that failed before, their dependencies might be available now.
+    m_d->m_cache.clearFailures();
     for (const QString &path : qAsConst(m_d->m_pluginPaths))
         registerPath(path);
     const bool newPluginsFound = m_d->m_registeredPlugins.size() > before;
@@ -677,21 +920,29 @@ void QDesignerPluginManager::registerPath(const QString &path)
     if (debugPluginManager)
         qDebug() << Q_FUNC_INFO << path;
     const QStringList &candidates = findPlugins(path);
-    for (const QString &plugin : candidates)
-        registerPlugin(plugin);
+    QStringList plugins;
+    for (const QString &plugin : candidates) {
+        if (m_d->m_disabledPlugins.contains(plugin) || m_d->m_registeredPlugins.contains(plugin))
+            continue;
+        QString errorMessage;
+        if (m_d->m_cache.failure(plugin, &errorMessage))
+            m_d->m_failedPlugins.insert(plugin, errorMessage);
+        else
+            plugins.append(plugin);
+    }
+
+    const QStringList errorMessages = loadPluginLibraries(plugins);
+    for (qsizetype i = 0, size = plugins.size(); i < size; ++i)
+        registerPlugin(plugins.at(i), errorMessages.at(i));
 }
 
-void QDesignerPluginManager::registerPlugin(const QString &plugin)
+void QDesignerPluginManager::registerPlugin(const QString &plugin, const QString &errorMessage)
 {
     if (debugPluginManager)
         qDebug() << Q_FUNC_INFO << plugin;
-    if (m_d->m_disabledPlugins.contains(plugin))
-        return;
-    if (m_d->m_registeredPlugins.contains(plugin))
-        return;
 
-    QPluginLoader loader(plugin);
-    if (loader.isLoaded() || loader.load()) {
+    m_d->m_cache.setFailure(plugin, errorMessage);
+    if (errorMessage.isEmpty()) {
         m_d->m_registeredPlugins += plugin;
         QDesignerPluginManagerPrivate::FailedPluginMap::iterator fit = m_d->m_failedPlugins.find(plugin);
         if (fit != m_d->m_failedPlugins.end())
@@ -699,7 +950,6 @@ void QDesignerPluginManager::registerPlugin(const QString &plugin)
         return;
     }
 
-    const QString errorMessage = loader.errorString();
     m_d->m_failedPlugins.insert(plugin, errorMessage);
 }
 
@@ -736,6 +986,7 @@ void QDesignerPluginManager::ensureInitialized()
         if (QObject *o = instance(plugin))
             m_d->addCustomWidgets(o, plugin, designerLanguage);
     }
+    m_d->m_cache.save();
 
     m_d->m_initialized = true;
 }
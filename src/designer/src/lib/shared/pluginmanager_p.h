@@ -51,6 +51,7 @@
 
 QT_BEGIN_NAMESPACE
 
+class QDataStream;
 class QDesignerFormEditorInterface;
 class QDesignerCustomWidgetInterface;
 class QDesignerPluginManagerPrivate;
@@ -91,6 +92,10 @@ public:
     // Custom tool tip of property
     QString propertyToolTip(const QString &name) const;
 
+    // Serialization for the plugin cache
+    void writeXmlData(QDataStream &str) const;
+    void readXmlData(QDataStream &str);
+
 private:
     QSharedDataPointer<QDesignerCustomWidgetSharedData> m_d;
 };
@@ -136,7 +141,7 @@ public slots:
 private:
     void updateRegisteredPlugins();
     void registerPath(const QString &path);
-    void registerPlugin(const QString &plugin);
+    void registerPlugin(const QString &plugin, const QString &errorMessage);
 
 private:
     static QStringList defaultPluginPaths();
@@ -326,12 +326,21 @@ QWidget *QDesignerFormBuilder::createPreview(const QDesignerFormWindowInterface
     QDesignerFormBuilder builder(fw->core(), deviceProfile);
     builder.setWorkingDirectory(fw->absoluteDir());
 
-    QByteArray bytes = fw->contents().toUtf8();
+    QWidget *widget = nullptr;
+    // Build from the DOM snapshot of the form if possible, it is shared
+    // between previews until the form changes.
+    if (const FormWindowBase *fwb = qobject_cast<const FormWindowBase *>(fw)) {
+        const QSharedPointer<DomUI> ui = fwb->domSnapshot();
+        if (!ui.isNull())
+            widget = builder.create(ui.data(), nullptr);
+    } else {
+        QByteArray bytes = fw->contents().toUtf8();
 
-    QBuffer buffer(&bytes);
-    buffer.open(QIODevice::ReadOnly);
+        QBuffer buffer(&bytes);
+        buffer.open(QIODevice::ReadOnly);
 
-    QWidget *widget = builder.load(&buffer, nullptr);
+        widget = builder.load(&buffer, nullptr);
+    }
     if (!widget) { // Shouldn't happen
         *errorMessage = QCoreApplication::translate("QDesignerFormBuilder", "The preview failed to build.");
         return  nullptr;
@@ -28,6 +28,7 @@
 
 #include "qdesigner_introspection_p.h"
 
+#include <QtCore/qhash.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qmetaobject.h>
 #include <QtCore/qstringlist.h>
@@ -197,7 +198,9 @@ namespace  {
        m_parameterNames(byteArrayListToStringList(method.parameterNames())),
        m_parameterTypes(byteArrayListToStringList(method.parameterTypes())),
        m_signature(QString::fromLatin1(method.methodSignature())),
-       m_normalizedSignature(QString::fromLatin1(QMetaObject::normalizedSignature(method.methodSignature().constData()))),
+       // The signatures stored by moc and QMetaObjectBuilder are already
+       // normalized, so both strings share the same data.
+       m_normalizedSignature(m_signature),
        m_tag(charToQString(method.tag())),
        m_typeName(charToQString(method.typeName()))
     {
@@ -244,8 +247,7 @@ namespace  {
 
         int indexOfEnumerator(const QString &name) const override
         { return m_metaObject->indexOfEnumerator(name.toUtf8()); }
-        int indexOfMethod(const QString &method) const override
-        { return m_metaObject->indexOfMethod(method.toUtf8()); }
+        int indexOfMethod(const QString &method) const override;
         int indexOfProperty(const QString &name) const override
         { return m_metaObject->indexOfProperty(name.toUtf8()); }
         int indexOfSignal(const QString &signal) const override
@@ -282,6 +284,9 @@ namespace  {
         Properties m_properties;
 
         QDesignerMetaPropertyInterface *m_userProperty;
+
+        // Index of the methods by signature, built on the first lookup.
+        mutable QHash<QString, int> m_methodIndex;
     };
 
     QDesignerMetaObject::QDesignerMetaObject(const qdesigner_internal::QDesignerIntrospection *introspection, const QMetaObject *metaObject) :
@@ -317,6 +322,18 @@ namespace  {
         delete m_userProperty;
     }
 
+    int QDesignerMetaObject::indexOfMethod(const QString &method) const
+    {
+        // Like QMetaObject::indexOfMethod(), prefer the method declared
+        // last, which overrides those of the base classes.
+        if (m_methodIndex.isEmpty() && !m_methods.isEmpty()) {
+            m_methodIndex.reserve(m_methods.size());
+            for (int i = 0, count = m_methods.size(); i < count; ++i)
+                m_methodIndex.insert(m_methods.at(i)->signature(), i);
+        }
+        return m_methodIndex.value(method, -1);
+    }
+
     const QDesignerMetaObjectInterface *QDesignerMetaObject::superClass() const
     {
         const QMetaObject *qSuperClass = m_metaObject->superClass();
@@ -343,7 +360,7 @@ namespace qdesigner_internal {
 
     const QDesignerMetaObjectInterface* QDesignerIntrospection::metaObjectForQMetaObject(const QMetaObject *metaObject) const
     {
-        MetaObjectMap::iterator it = m_metaObjectMap.find(metaObject);
+        auto it = m_metaObjectMap.find(metaObject);
         if (it == m_metaObjectMap.end())
             it = m_metaObjectMap.insert(metaObject, new QDesignerMetaObject(this, metaObject));
         return it.value();
@@ -42,7 +42,7 @@
 
 #include "shared_global_p.h"
 #include <abstractintrospection_p.h>
-#include <QtCore/qmap.h>
+#include <QtCore/qhash.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -60,7 +60,7 @@ namespace qdesigner_internal {
 
         const QDesignerMetaObjectInterface* metaObjectForQMetaObject(const QMetaObject *metaObject) const;
     private:
-        using MetaObjectMap = QMap<const QMetaObject*, QDesignerMetaObjectInterface*>;
+        using MetaObjectMap = QHash<const QMetaObject*, QDesignerMetaObjectInterface*>;
         mutable MetaObjectMap m_metaObjectMap;
 
     };
@@ -32,6 +32,9 @@
 #include <abstractintrospection_p.h>
 
 #include <QtWidgets/qwidget.h>
+
+#include <QtCore/qmap.h>
+
 QT_BEGIN_NAMESPACE
 
 static QList<QByteArray> stringListToByteArray(const QStringList &l)
@@ -59,13 +62,64 @@ static QDesignerFormEditorInterface *formEditorForObject(QObject *o) {
     return nullptr;
 }
 
+// Find class whose superclass does not contain the method.
+static QString declaringClass(const QDesignerMetaObjectInterface *meta, const QString &member)
+{
+    for (;;) {
+        const QDesignerMetaObjectInterface *tmp = meta->superClass();
+        if (tmp == nullptr)
+            break;
+        if (tmp->indexOfMethod(member) == -1)
+            break;
+        meta = tmp;
+    }
+    return meta->className();
+}
+
+// Metadata of the members of a class, which is the same for all objects
+// of the class. It is computed once and shared by their sheets.
+struct QDesignerMemberSheetClassInfo
+{
+    QStringList declaredInClass;
+    QList<bool> inheritedFromWidget;
+};
+
+static const QDesignerMemberSheetClassInfo &memberSheetClassInfo(const QMetaObject *metaObject,
+                                                                 const QDesignerMetaObjectInterface *meta)
+{
+    using ClassInfoCache = QMap<const QMetaObject *, QDesignerMemberSheetClassInfo>;
+    static ClassInfoCache cache;
+
+    ClassInfoCache::iterator it = cache.find(metaObject);
+    if (it != cache.end())
+        return it.value();
+
+    static const QString qWidgetClass = QStringLiteral("QWidget");
+    static const QString qObjectClass = QStringLiteral("QObject");
+
+    QDesignerMemberSheetClassInfo classInfo;
+    const int methodCount = meta->methodCount();
+    classInfo.declaredInClass.reserve(methodCount);
+    classInfo.inheritedFromWidget.reserve(methodCount);
+    for (int index = 0; index < methodCount; ++index) {
+        const QString className = declaringClass(meta, meta->method(index)->signature());
+        classInfo.declaredInClass.append(className);
+        classInfo.inheritedFromWidget.append(className == qWidgetClass || className == qObjectClass);
+    }
+    return cache.insert(metaObject, classInfo).value();
+}
+
 // ------------ QDesignerMemberSheetPrivate
 class QDesignerMemberSheetPrivate {
 public:
     explicit QDesignerMemberSheetPrivate(QObject *object, QObject *sheetParent);
 
+    const QDesignerMemberSheetClassInfo &classInfo() const;
+
     QDesignerFormEditorInterface *m_core;
     const QDesignerMetaObjectInterface *m_meta;
+    const QMetaObject *m_metaObject;
+    mutable const QDesignerMemberSheetClassInfo *m_classInfo = nullptr;
 
     class Info {
     public:
@@ -82,10 +136,20 @@ public:
 
 QDesignerMemberSheetPrivate::QDesignerMemberSheetPrivate(QObject *object, QObject *sheetParent) :
     m_core(formEditorForObject(sheetParent)),
-    m_meta(m_core->introspection()->metaObject(object))
+    m_meta(m_core->introspection()->metaObject(object)),
+    m_metaObject(object->metaObject())
 {
 }
 
+// The class info is only needed by the signal/slot editors, so it is
+// computed when first asked for.
+const QDesignerMemberSheetClassInfo &QDesignerMemberSheetPrivate::classInfo() const
+{
+    if (!m_classInfo)
+        m_classInfo = &memberSheetClassInfo(m_metaObject, m_meta);
+    return *m_classInfo;
+}
+
 QDesignerMemberSheetPrivate::Info &QDesignerMemberSheetPrivate::ensureInfo(int index)
 {
     InfoHash::iterator it = m_info.find(index);
@@ -125,20 +189,7 @@ QString QDesignerMemberSheet::memberName(int index) const
 
 QString QDesignerMemberSheet::declaredInClass(int index) const
 {
-    const QString member = d->m_meta->method(index)->signature();
-
-    // Find class whose superclass does not contain the method.
-    const QDesignerMetaObjectInterface *meta_obj = d->m_meta;
-
-    for (;;) {
-        const QDesignerMetaObjectInterface *tmp = meta_obj->superClass();
-        if (tmp == nullptr)
-            break;
-        if (tmp->indexOfMethod(member) == -1)
-            break;
-        meta_obj = tmp;
-    }
-    return meta_obj->className();
+    return d->classInfo().declaredInClass.at(index);
 }
 
 QString QDesignerMemberSheet::memberGroup(int index) const
@@ -183,7 +234,7 @@ bool QDesignerMemberSheet::isSlot(int index) const
 
 bool QDesignerMemberSheet::inheritedFromWidget(int index) const
 {
-    return declaredInClass(index) == QStringLiteral("QWidget") || declaredInClass(index) == QStringLiteral("QObject");
+    return d->classInfo().inheritedFromWidget.at(index);
 }
 
 
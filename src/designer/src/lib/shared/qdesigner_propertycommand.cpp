@@ -32,6 +32,7 @@
 #include "qdesigner_propertyeditor_p.h"
 #include "spacer_widget_p.h"
 #include "qdesigner_propertysheet_p.h"
+#include "formwindowbase_p.h"
 
 #include <QtDesigner/abstractformeditor.h>
 #include <QtDesigner/abstractintegration.h>
@@ -57,6 +58,8 @@
 #include <QtCore/qsize.h>
 #include <QtCore/qtextstream.h>
 
+#include <iterator>
+
 QT_BEGIN_NAMESPACE
 
 namespace  {
@@ -1091,16 +1094,22 @@ private:
 // applies a function to them.
 // The function returns the  corrected value which is then set in  the property editor.
 // Returns a combination of update flags.
+// When changing several objects, the form window defers its per-widget
+// updates until all values are applied.
 template <class PropertyListIterator, class Function>
-        unsigned changePropertyList(QDesignerFormEditorInterface *core,
+        unsigned changePropertyList(QDesignerFormWindowInterface *formWindow,
                                     const QString &propertyName,
                                     PropertyListIterator begin,
                                     PropertyListIterator end,
                                     Function function)
 {
     unsigned updateMask = 0;
-    QDesignerPropertyEditorInterface *propertyEditor = core->propertyEditor();
+    QDesignerPropertyEditorInterface *propertyEditor = formWindow->core()->propertyEditor();
     bool updatedPropertyEditor = false;
+    FormWindowBase *fwb = begin != end && std::next(begin) != end
+        ? qobject_cast<FormWindowBase *>(formWindow) : nullptr;
+    if (fwb)
+        fwb->beginBatchChange();
 
     for (PropertyListIterator it = begin; it != end; ++it) {
         PropertyHelper *ph = it->data();
@@ -1114,6 +1123,8 @@ template <class PropertyListIterator, class Function>
             }
         }
     }
+    if (fwb)
+        fwb->endBatchChange();
     if (!updatedPropertyEditor) updateMask |=  PropertyHelper::UpdatePropertyEditor;
     return updateMask;
 }
@@ -1125,7 +1136,7 @@ unsigned PropertyListCommand::setValue(const QVariant &value, bool changed, unsi
     if(debugPropertyCommands)
         qDebug() << "PropertyListCommand::setValue(" << value
                  << changed << subPropertyMask << ')';
-    return changePropertyList(formWindow()->core(),
+    return changePropertyList(formWindow(),
                               m_propertyDescription.m_propertyName,
                               m_propertyHelperList.begin(), m_propertyHelperList.end(),
                               SetValueFunction(formWindow(), PropertyHelper::Value(value, changed), subPropertyMask));
@@ -1137,7 +1148,7 @@ unsigned PropertyListCommand::restoreOldValue()
     if(debugPropertyCommands)
         qDebug() << "PropertyListCommand::restoreOldValue()";
 
-    return changePropertyList(formWindow()->core(),
+    return changePropertyList(formWindow(),
                               m_propertyDescription.m_propertyName, m_propertyHelperList.begin(), m_propertyHelperList.end(),
                               UndoSetValueFunction(formWindow()));
 }
@@ -1147,7 +1158,7 @@ unsigned PropertyListCommand::restoreDefaultValue()
     if(debugPropertyCommands)
         qDebug() << "PropertyListCommand::restoreDefaultValue()";
 
-    return changePropertyList(formWindow()->core(),
+    return changePropertyList(formWindow(),
                               m_propertyDescription.m_propertyName, m_propertyHelperList.begin(), m_propertyHelperList.end(),
                               RestoreDefaultFunction(formWindow()));
 }
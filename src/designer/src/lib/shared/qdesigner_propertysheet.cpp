@@ -173,7 +173,51 @@ static const qdesigner_internal::DesignerMetaFlags &designerMetaFlagsFor(const Q
     return it.value();
 }
 
-// ------------ QDesignerMemberSheetPrivate
+// Metadata of the real properties of a class, which is the same for all
+// objects of the class. It is computed once and shared by their sheets.
+struct QDesignerPropertySheetClassInfo
+{
+    struct Property
+    {
+        QString group;
+        QDesignerPropertySheet::PropertyType propertyType = QDesignerPropertySheet::PropertyNone;
+        int type = QMetaType::UnknownType;
+    };
+
+    QList<Property> properties;
+};
+
+static const QDesignerPropertySheetClassInfo &propertySheetClassInfo(const QMetaObject *metaObject,
+                                                                     const QDesignerMetaObjectInterface *meta)
+{
+    using ClassInfoCache = QMap<const QMetaObject *, QDesignerPropertySheetClassInfo>;
+    static ClassInfoCache cache;
+
+    ClassInfoCache::iterator it = cache.find(metaObject);
+    if (it != cache.end())
+        return it.value();
+
+    const QDesignerMetaObjectInterface *baseMeta = meta;
+    while (baseMeta && baseMeta->className().startsWith(QStringLiteral("QDesigner")))
+        baseMeta = baseMeta->superClass();
+    Q_ASSERT(baseMeta != nullptr);
+
+    QDesignerPropertySheetClassInfo classInfo;
+    const int propertyCount = meta->propertyCount();
+    classInfo.properties.reserve(propertyCount);
+    for (int index = 0; index < propertyCount; ++index) {
+        const QDesignerMetaPropertyInterface *p = meta->property(index);
+        QDesignerPropertySheetClassInfo::Property property;
+        const QDesignerMetaObjectInterface *pmeta = propertyIntroducedBy(baseMeta, index);
+        property.group = pmeta ? pmeta->className() : baseMeta->className();
+        property.propertyType = QDesignerPropertySheet::propertyTypeFromName(p->name());
+        property.type = p->type();
+        classInfo.properties.append(property);
+    }
+    return cache.insert(metaObject, classInfo).value();
+}
+
+// ------------ QDesignerPropertySheetPrivate
 class QDesignerPropertySheetPrivate {
 public:
     using PropertyType = QDesignerPropertySheet::PropertyType;
@@ -582,12 +626,8 @@ QDesignerPropertySheet::QDesignerPropertySheet(QObject *object, QObject *parent)
     d(new QDesignerPropertySheetPrivate(this, object, parent))
 {
     using Info = QDesignerPropertySheetPrivate::Info;
-    const QDesignerMetaObjectInterface *baseMeta = d->m_meta;
-
-    while (baseMeta &&baseMeta->className().startsWith(QStringLiteral("QDesigner"))) {
-        baseMeta = baseMeta->superClass();
-    }
-    Q_ASSERT(baseMeta != nullptr);
+    const QDesignerPropertySheetClassInfo &classInfo =
+        propertySheetClassInfo(object->metaObject(), d->m_meta);
 
     QDesignerFormWindowInterface *formWindow = QDesignerFormWindowInterface::findFormWindow(d->m_object);
     d->m_fwb = qobject_cast<qdesigner_internal::FormWindowBase *>(formWindow);
@@ -597,31 +637,26 @@ QDesignerPropertySheet::QDesignerPropertySheet(QObject *object, QObject *parent)
         d->m_fwb->addReloadablePropertySheet(this, object);
     }
 
-    for (int index=0; index<count(); ++index) {
-        const QDesignerMetaPropertyInterface *p = d->m_meta->property(index);
-        const QString name = p->name();
-        if (p->type() == QMetaType::QKeySequence) {
-            createFakeProperty(name);
+    const int propertyCount = classInfo.properties.size();
+    d->m_info.reserve(propertyCount);
+    for (int index = 0; index < propertyCount; ++index) {
+        const QDesignerPropertySheetClassInfo::Property &property = classInfo.properties.at(index);
+        const int type = property.type;
+        if (type == QMetaType::QKeySequence) {
+            createFakeProperty(d->m_meta->property(index)->name());
         } else {
             setVisible(index, false); // use the default for `real' properties
         }
 
-        QString pgroup = baseMeta->className();
-
-        if (const QDesignerMetaObjectInterface *pmeta = propertyIntroducedBy(baseMeta, index)) {
-            pgroup = pmeta->className();
-        }
-
         Info &info = d->ensureInfo(index);
-        info.group = pgroup;
-        info.propertyType = propertyTypeFromName(name);
+        info.group = property.group;
+        info.propertyType = property.propertyType;
 
-        const int type = p->type();
         switch (type) {
         case QMetaType::QCursor:
         case QMetaType::QIcon:
         case QMetaType::QPixmap:
-            info.defaultValue = p->read(d->m_object);
+            info.defaultValue = d->m_meta->property(index)->read(d->m_object);
             if (type == QMetaType::QIcon || type == QMetaType::QPixmap)
                 d->addResourceProperty(index, type);
             break;
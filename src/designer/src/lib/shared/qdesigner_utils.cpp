@@ -38,8 +38,15 @@
 #include <QtDesigner/taskmenu.h>
 #include <QtDesigner/qextensionmanager.h>
 
+#include <QtCore/qcache.h>
+#include <QtCore/qdatetime.h>
 #include <QtCore/qdir.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qprocess.h>
+#include <QtCore/qresource.h>
+#include <QtCore/qset.h>
+#include <QtCore/qthreadpool.h>
 #include <QtCore/qlibraryinfo.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qqueue.h>
@@ -48,12 +55,17 @@
 
 #include <QtWidgets/qapplication.h>
 #include <QtGui/qicon.h>
+#include <QtGui/qimage.h>
 #include <QtGui/qpixmap.h>
 #include <QtWidgets/qlistwidget.h>
 #include <QtWidgets/qtreewidget.h>
 #include <QtWidgets/qtablewidget.h>
 #include <QtWidgets/qcombobox.h>
 
+#include <future>
+#include <map>
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 namespace qdesigner_internal
@@ -408,13 +420,140 @@ namespace qdesigner_internal
             m_data->m_paths.insert(pair, pixmap);
     }
 
+    // ------------- DesignerImageCache
+    enum { imageCacheSizeKB = 64 * 1024, iconCacheSize = 1024 };
+
+    struct DesignerImageCacheData
+    {
+        QMutex mutex;
+        QCache<QString, QImage> images{imageCacheSizeKB}; // cost in KB
+        QCache<QString, QIcon> icons{iconCacheSize};
+        std::map<QString, std::shared_future<QImage>> pending; // decoded by prefetch()
+    };
+
+    Q_GLOBAL_STATIC(DesignerImageCacheData, designerImageCacheData)
+
+    // Key identifying the data of a path: Resources are identified
+    // by their registered data, files by their modification time.
+    static QString imageCacheKey(const QString &path)
+    {
+        if (path.startsWith(QLatin1Char(':'))) {
+            const QResource resource(path);
+            return path + QLatin1Char('@') + QString::number(quintptr(resource.data()), 16);
+        }
+        return path + QLatin1Char('@')
+            + QString::number(QFileInfo(path).lastModified().toMSecsSinceEpoch());
+    }
+
+    static inline QString pathOfImageCacheKey(const QString &key)
+    {
+        return key.left(key.lastIndexOf(QLatin1Char('@')));
+    }
+
+    // Call with mutex locked
+    static void insertImage(DesignerImageCacheData *d, const QString &key, const QImage &image)
+    {
+        const int cost = qMax(1, int(image.sizeInBytes() / 1024));
+        d->images.insert(key, new QImage(image), cost);
+        d->pending.erase(key);
+    }
+
+    QImage DesignerImageCache::image(const QString &path)
+    {
+        DesignerImageCacheData *d = designerImageCacheData();
+        const QString key = imageCacheKey(path);
+        std::shared_future<QImage> pending;
+        {
+            QMutexLocker locker(&d->mutex);
+            if (const QImage *cached = d->images.object(key))
+                return *cached;
+            const auto it = d->pending.find(key);
+            if (it != d->pending.end())
+                pending = it->second;
+        }
+
+        const QImage result = pending.valid() ? pending.get() : QImage(path);
+        QMutexLocker locker(&d->mutex);
+        insertImage(d, key, result);
+        return result;
+    }
+
+    QPixmap DesignerImageCache::pixmap(const QString &path)
+    {
+        return QPixmap::fromImage(image(path));
+    }
+
+    QIcon DesignerImageCache::icon(const PropertySheetIconValue &value)
+    {
+        const PropertySheetIconValue::ModeStateToPixmapMap &paths = value.paths();
+        QString key;
+        for (auto it = paths.constBegin(), cend = paths.constEnd(); it != cend; ++it) {
+            key += QString::number(it.key().first) + QLatin1Char(',')
+                + QString::number(it.key().second) + QLatin1Char(',')
+                + imageCacheKey(it.value().path()) + QLatin1Char('\n');
+        }
+
+        DesignerImageCacheData *d = designerImageCacheData();
+        QMutexLocker locker(&d->mutex);
+        if (const QIcon *cached = d->icons.object(key))
+            return *cached;
+        // The icon engine decodes the files on demand, sharing the icon
+        // shares the decoded pixmaps.
+        QIcon *icon = new QIcon;
+        for (auto it = paths.constBegin(), cend = paths.constEnd(); it != cend; ++it) {
+            const auto pair = it.key();
+            icon->addFile(it.value().path(), QSize(), pair.first, pair.second);
+        }
+        const QIcon result = *icon;
+        d->icons.insert(key, icon);
+        return result;
+    }
+
+    void DesignerImageCache::prefetch(const QStringList &paths)
+    {
+        DesignerImageCacheData *d = designerImageCacheData();
+        QMutexLocker locker(&d->mutex);
+        for (const QString &path : paths) {
+            const QString key = imageCacheKey(path);
+            if (path.isEmpty() || d->images.contains(key) || d->pending.count(key) != 0)
+                continue;
+            // Shared, as the pool takes copyable functions only
+            auto result = std::make_shared<std::promise<QImage>>();
+            d->pending.emplace(key, result->get_future().share());
+            // The global pool is waited for before the application exits.
+            QThreadPool::globalInstance()->start([d, key, path, result] {
+                const QImage image(path);
+                {
+                    QMutexLocker locker(&d->mutex);
+                    insertImage(d, key, image);
+                }
+                result->set_value(image);
+            });
+        }
+    }
+
+    void DesignerImageCache::invalidate(const QStringList &paths)
+    {
+        if (paths.isEmpty())
+            return;
+        const QSet<QString> pathSet(paths.cbegin(), paths.cend());
+        DesignerImageCacheData *d = designerImageCacheData();
+        QMutexLocker locker(&d->mutex);
+        const QStringList keys = d->images.keys();
+        for (const QString &key : keys) {
+            if (pathSet.contains(pathOfImageCacheKey(key)))
+                d->images.remove(key);
+        }
+        d->icons.clear();
+    }
+
     QPixmap DesignerPixmapCache::pixmap(const PropertySheetPixmapValue &value) const
     {
         QMap<PropertySheetPixmapValue, QPixmap>::const_iterator it = m_cache.constFind(value);
         if (it != m_cache.constEnd())
             return it.value();
 
-        QPixmap pix = QPixmap(value.path());
+        QPixmap pix = DesignerImageCache::pixmap(value.path());
         m_cache.insert(value, pix);
         return pix;
     }
@@ -445,12 +584,7 @@ namespace qdesigner_internal
             }
         }
 
-        QIcon icon;
-        const PropertySheetIconValue::ModeStateToPixmapMap &paths = value.paths();
-        for (auto it = paths.constBegin(), cend = paths.constEnd(); it != cend; ++it) {
-            const auto pair = it.key();
-            icon.addFile(it.value().path(), QSize(), pair.first, pair.second);
-        }
+        const QIcon icon = DesignerImageCache::icon(value);
         m_cache.insert(value, icon);
         return icon;
     }
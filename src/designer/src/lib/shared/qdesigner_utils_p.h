@@ -289,6 +289,21 @@ private:
 
 QDESIGNER_SHARED_EXPORT QDebug operator<<(QDebug, const PropertySheetIconValue &);
 
+// Process-wide, size-bounded cache of the images and icons used for pixmap and
+// icon properties, shared by the DesignerPixmapCache/DesignerIconCache of all
+// form windows. Entries are identified by the registered resource data or the
+// file modification time; QtResourceModel invalidates them on reloads.
+class QDESIGNER_SHARED_EXPORT DesignerImageCache
+{
+public:
+    static QImage image(const QString &path);
+    static QPixmap pixmap(const QString &path);
+    static QIcon icon(const PropertySheetIconValue &value); // unthemed
+    // Decode the images in the background, so that later image() calls find them
+    static void prefetch(const QStringList &paths);
+    static void invalidate(const QStringList &paths);
+};
+
 class QDESIGNER_SHARED_EXPORT DesignerPixmapCache : public QObject
 {
     Q_OBJECT
@@ -27,6 +27,7 @@
 ****************************************************************************/
 
 #include "qtresourcemodel_p.h"
+#include "qdesigner_utils_p.h"
 #include "rcc_p.h"
 
 #include <QtCore/qstringlist.h>
@@ -38,11 +39,133 @@
 #include <QtCore/qdebug.h>
 #include <QtCore/qbuffer.h>
 #include <QtCore/qfilesystemwatcher.h>
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qset.h>
+#include <QtCore/qstandardpaths.h>
+
+#include <memory>
 
 QT_BEGIN_NAMESPACE
 
 enum { debugResourceModel = 0 };
 
+// ------------------- Compiled resource cache
+// The binary resources compiled from .qrc files are kept in the cache
+// location along with the time stamps of their input files, so that
+// unchanged resources are not recompiled when reopening forms. Setting the
+// environment variable QT_DESIGNER_NO_RESOURCE_CACHE disables the cache.
+
+struct ResourceInputStamp
+{
+    QString fileName;
+    qint64 lastModified = 0;
+    qint64 size = 0;
+};
+
+static constexpr quint32 resourceCacheMagic = 0x51445243; // "QDRC"
+static constexpr quint32 resourceCacheVersion = 1;
+
+// Base name of the cache files for a .qrc file, empty if caching is disabled.
+static QString resourceCacheBaseName(const QString &qrcPath)
+{
+    if (qEnvironmentVariableIsSet("QT_DESIGNER_NO_RESOURCE_CACHE"))
+        return {};
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (cacheDir.isEmpty())
+        return {};
+    const QByteArray key = QFileInfo(qrcPath).absoluteFilePath().toUtf8();
+    const QByteArray hash = QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex();
+    return cacheDir + u"/resources/"_qs + QLatin1String(hash);
+}
+
+static ResourceInputStamp resourceInputStamp(const QString &fileName)
+{
+    const QFileInfo fi(fileName);
+    ResourceInputStamp result;
+    result.fileName = fileName;
+    result.lastModified = fi.exists() ? fi.lastModified().toMSecsSinceEpoch() : -1;
+    result.size = fi.isFile() ? fi.size() : 0;
+    return result;
+}
+
+// Stamp the .qrc file, the resource files and their directories (which
+// catches files added to directory entries of the .qrc file).
+static QList<ResourceInputStamp> resourceInputStamps(const QString &qrcPath,
+                                                     const RCCResourceLibrary::ResourceDataFileMap &resMap)
+{
+    QList<ResourceInputStamp> result;
+    result.append(resourceInputStamp(qrcPath));
+    QSet<QString> directories;
+    for (const QString &fileName : resMap) {
+        result.append(resourceInputStamp(fileName));
+        const QString directory = QFileInfo(fileName).absolutePath();
+        if (!directories.contains(directory)) {
+            directories.insert(directory);
+            result.append(resourceInputStamp(directory));
+        }
+    }
+    return result;
+}
+
+// Read the stamps of a cached resource, returns true if it is up to date.
+static bool readResourceCacheStamps(const QString &baseName, const QString &qrcPath, QStringList *contents)
+{
+    QFile file(baseName + u".stamps"_qs);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    QDataStream in(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 qtVersion = 0;
+    in >> magic >> version >> qtVersion;
+    if (magic != resourceCacheMagic || version != resourceCacheVersion || qtVersion != QT_VERSION)
+        return false;
+    in.setVersion(QDataStream::Qt_6_0);
+    QString cachedQrcPath;
+    QStringList cachedContents;
+    qint32 stampCount = 0;
+    in >> cachedQrcPath >> cachedContents >> stampCount;
+    if (in.status() != QDataStream::Ok || cachedQrcPath != QFileInfo(qrcPath).absoluteFilePath())
+        return false;
+    for (qint32 i = 0; i < stampCount; ++i) {
+        ResourceInputStamp stamp;
+        in >> stamp.fileName >> stamp.lastModified >> stamp.size;
+        if (in.status() != QDataStream::Ok)
+            return false;
+        const ResourceInputStamp current = resourceInputStamp(stamp.fileName);
+        if (current.lastModified != stamp.lastModified || current.size != stamp.size)
+            return false;
+    }
+    *contents = cachedContents;
+    return true;
+}
+
+static bool writeResourceCache(const QString &baseName, const QString &qrcPath,
+                               const RCCResourceLibrary::ResourceDataFileMap &resMap,
+                               const QByteArray &data)
+{
+    if (!QDir().mkpath(QFileInfo(baseName).absolutePath()))
+        return false;
+    QSaveFile rccFile(baseName + u".rcc"_qs);
+    if (!rccFile.open(QIODevice::WriteOnly) || rccFile.write(data) != data.size() || !rccFile.commit())
+        return false;
+
+    QSaveFile stampFile(baseName + u".stamps"_qs);
+    if (!stampFile.open(QIODevice::WriteOnly))
+        return false;
+    QDataStream out(&stampFile);
+    out << resourceCacheMagic << resourceCacheVersion << quint32(QT_VERSION);
+    out.setVersion(QDataStream::Qt_6_0);
+    const QList<ResourceInputStamp> stamps = resourceInputStamps(qrcPath, resMap);
+    out << QFileInfo(qrcPath).absoluteFilePath() << resMap.keys() << qint32(stamps.size());
+    for (const ResourceInputStamp &stamp : stamps)
+        out << stamp.fileName << stamp.lastModified << stamp.size;
+    return out.status() == QDataStream::Ok && stampFile.commit();
+}
+
 // ------------------- QtResourceSetPrivate
 class QtResourceSetPrivate
 {
@@ -68,6 +191,7 @@ class QtResourceModelPrivate
     Q_DISABLE_COPY_MOVE(QtResourceModelPrivate)
 public:
     QtResourceModelPrivate();
+    ~QtResourceModelPrivate();
     void activate(QtResourceSet *resourceSet, const QStringList &newPaths, int *errorCount = nullptr, QString *errorMessages = nullptr);
     void removeOldPaths(QtResourceSet *resourceSet, const QStringList &newPaths);
 
@@ -93,20 +217,31 @@ public:
     bool m_fileWatcherEnabled = true;
     QMap<QString, bool> m_fileWatchedMap;
 private:
-    void registerResourceSet(QtResourceSet *resourceSet);
-    void unregisterResourceSet(QtResourceSet *resourceSet);
+    void registerResourceSet(QtResourceSet *resourceSet, int from = 0);
+    void unregisterResourceSet(QtResourceSet *resourceSet, int from = 0);
     void setWatcherEnabled(const QString &path, bool enable);
     void addWatcher(const QString &path);
     void removeWatcher(const QString &path);
 
     void slotFileChanged(const QString &);
 
-    const QByteArray *createResource(const QString &path, QStringList *contents, int *errorCount, QIODevice &errorDevice) const;
-    void deleteResource(const QByteArray *data) const;
+    const QByteArray *createResource(const QString &path, QStringList *contents, int *errorCount, QIODevice &errorDevice);
+    const QByteArray *mapResource(const QString &rccPath);
+    void deleteResource(const QByteArray *data);
+
+    QHash<const QByteArray *, QFile *> m_mappedResources; // data referencing mapped cache files
 };
 
 QtResourceModelPrivate::QtResourceModelPrivate() = default;
 
+QtResourceModelPrivate::~QtResourceModelPrivate()
+{
+    for (auto it = m_mappedResources.cbegin(), end = m_mappedResources.cend(); it != end; ++it) {
+        delete it.key();
+        delete it.value();
+    }
+}
+
 // --------------------- QtResourceSet
 QtResourceSet::QtResourceSet() :
     d_ptr(new QtResourceSetPrivate)
@@ -144,13 +279,24 @@ void QtResourceSet::setModified(const QString &path)
 }
 
 // ------------------- QtResourceModelPrivate
-const QByteArray *QtResourceModelPrivate::createResource(const QString &path, QStringList *contents, int *errorCount, QIODevice &errorDevice) const
+const QByteArray *QtResourceModelPrivate::createResource(const QString &path, QStringList *contents, int *errorCount, QIODevice &errorDevice)
 {
     using ResourceDataFileMap = RCCResourceLibrary::ResourceDataFileMap;
     const QByteArray *rc = nullptr;
     *errorCount = -1;
     contents->clear();
+    const QString cacheBaseName = resourceCacheBaseName(path);
     do {
+        // Use the cached resource if neither the .qrc file nor its files changed
+        if (!cacheBaseName.isEmpty() && readResourceCacheStamps(cacheBaseName, path, contents)) {
+            rc = mapResource(cacheBaseName + u".rcc"_qs);
+            if (rc) {
+                *errorCount = 0;
+                break;
+            }
+            contents->clear();
+        }
+
         // run RCC
         RCCResourceLibrary library;
         library.setVerbose(true);
@@ -173,7 +319,14 @@ const QByteArray *QtResourceModelPrivate::createResource(const QString &path, QS
             break;
 
         buffer.close();
-        rc = new QByteArray(buffer.data());
+        // Cache resources without failures and register the mapped file
+        // instead of keeping the data on the heap.
+        if (!cacheBaseName.isEmpty() && *errorCount == 0
+            && writeResourceCache(cacheBaseName, path, resMap, buffer.data())) {
+            rc = mapResource(cacheBaseName + u".rcc"_qs);
+        }
+        if (!rc)
+            rc = new QByteArray(buffer.data());
     } while (false);
 
     if (debugResourceModel)
@@ -181,30 +334,49 @@ const QByteArray *QtResourceModelPrivate::createResource(const QString &path, QS
     return rc;
 }
 
-void QtResourceModelPrivate::deleteResource(const QByteArray *data) const
+const QByteArray *QtResourceModelPrivate::mapResource(const QString &rccPath)
+{
+    auto file = std::make_unique<QFile>(rccPath);
+    if (!file->open(QIODevice::ReadOnly) || file->size() == 0)
+        return nullptr;
+    const uchar *data = file->map(0, file->size());
+    if (!data)
+        return nullptr;
+    const QByteArray *rc = new QByteArray(QByteArray::fromRawData(reinterpret_cast<const char *>(data),
+                                                                   file->size()));
+    m_mappedResources.insert(rc, file.release());
+    return rc;
+}
+
+void QtResourceModelPrivate::deleteResource(const QByteArray *data)
 {
     if (data) {
         if (debugResourceModel)
             qDebug() << "deleteResource";
+        QFile *mappedFile = m_mappedResources.take(data);
         delete data;
+        delete mappedFile; // unmaps
     }
 }
 
-void QtResourceModelPrivate::registerResourceSet(QtResourceSet *resourceSet)
+// Register the paths of a resource set starting at index 'from'; the
+// paths before it are still registered.
+void QtResourceModelPrivate::registerResourceSet(QtResourceSet *resourceSet, int from)
 {
     if (!resourceSet)
         return;
 
-    // unregister old paths (all because the order of registration is important), later it can be optimized a bit
+    // The order of registration is important, so registration starts at the first changed path
     const QStringList toRegister = resourceSet->activeResourceFilePaths();
-    for (const QString &path : toRegister) {
-        if (debugResourceModel)
+    for (int i = 0, count = toRegister.size(); i < count; ++i) {
+        const QString &path = toRegister.at(i);
+        if (debugResourceModel && i >= from)
             qDebug() << "registerResourceSet " << path;
         const PathDataMap::const_iterator itRcc = m_pathToData.constFind(path);
         if (itRcc != m_pathToData.constEnd()) { // otherwise data was not created yet
             const QByteArray *data = itRcc.value();
             if (data) {
-                if (!QResource::registerResource(reinterpret_cast<const uchar *>(data->constData()))) {
+                if (i >= from && !QResource::registerResource(reinterpret_cast<const uchar *>(data->constData()))) {
                     qWarning() << "** WARNING: Failed to register " << path << " (QResource failure).";
                 } else {
                     const QStringList contents = m_pathToContents.value(path);
@@ -218,14 +390,15 @@ void QtResourceModelPrivate::registerResourceSet(QtResourceSet *resourceSet)
     }
 }
 
-void QtResourceModelPrivate::unregisterResourceSet(QtResourceSet *resourceSet)
+// Unregister the paths of a resource set starting at index 'from'
+void QtResourceModelPrivate::unregisterResourceSet(QtResourceSet *resourceSet, int from)
 {
     if (!resourceSet)
         return;
 
-    // unregister old paths (all because the order of registration is importans), later it can be optimized a bit
     const QStringList toUnregister = resourceSet->activeResourceFilePaths();
-    for (const QString &path : toUnregister) {
+    for (int i = from, count = toUnregister.size(); i < count; ++i) {
+        const QString &path = toUnregister.at(i);
         if (debugResourceModel)
             qDebug() << "unregisterResourceSet " << path;
         const PathDataMap::const_iterator itRcc = m_pathToData.constFind(path);
@@ -255,9 +428,15 @@ void QtResourceModelPrivate::activate(QtResourceSet *resourceSet, const QStringL
     int errorCount = 0;
     int generatedCount = 0;
     bool newResourceSetChanged = false;
+    QStringList generatedPaths;
+    QStringList generatedContents; // old and new contents of the generated paths
 
     if (resourceSet && resourceSet->activeResourceFilePaths() != newPaths && !m_newlyCreated.contains(resourceSet))
         newResourceSetChanged = true;
+    // Reloading some of the paths of the current resource set does not require
+    // its complete re-registration.
+    bool partialReload = resourceSet && resourceSet == m_currentResourceSet
+        && resourceSet->activeResourceFilePaths() == newPaths && !m_newlyCreated.contains(resourceSet);
 
     PathDataMap newPathToData = m_pathToData;
 
@@ -269,7 +448,11 @@ void QtResourceModelPrivate::activate(QtResourceSet *resourceSet, const QStringL
             QStringList contents;
             int qrcErrorCount;
             generatedCount++;
+            generatedPaths.append(path);
+            generatedContents += m_pathToContents.value(path);
+            qdesigner_internal::DesignerImageCache::invalidate(m_pathToContents.value(path));
             const QByteArray *data = createResource(path, &contents, &qrcErrorCount, errorStream);
+            generatedContents += contents;
 
             newPathToData.insert(path, data);
             if (qrcErrorCount) // Count single failed files as sort of 1/2 error
@@ -317,10 +500,26 @@ void QtResourceModelPrivate::activate(QtResourceSet *resourceSet, const QStringL
     if (itReload != m_resourceSetToReload.end()) {
         if (itReload.value()) {
             newResourceSetChanged = true;
+            partialReload = false;
             m_resourceSetToReload.insert(resourceSet, false);
         }
     }
 
+    if (partialReload && !generatedPaths.isEmpty()) {
+        // Re-register starting with the first reloaded path to maintain the priorities
+        int from = newPaths.size();
+        for (const QString &path : qAsConst(generatedPaths))
+            from = qMin(from, int(newPaths.indexOf(path)));
+        unregisterResourceSet(m_currentResourceSet, from);
+        for (const QByteArray *data : qAsConst(toDelete))
+            deleteResource(data);
+        m_pathToData = newPathToData;
+        registerResourceSet(m_currentResourceSet, from);
+        generatedContents.removeDuplicates();
+        emit q_ptr->resourceSetReloaded(m_currentResourceSet, generatedPaths, generatedContents);
+        return;
+    }
+
     QStringList oldActivePaths;
     if (m_currentResourceSet)
         oldActivePaths = m_currentResourceSet->activeResourceFilePaths();
@@ -382,6 +581,7 @@ void QtResourceModelPrivate::removeOldPaths(QtResourceSet *resourceSet, const QS
                         PathDataMap::iterator it = m_pathToData.find(oldPath);
                         if (it != m_pathToData.end())
                             deleteResource(it.value());
+                        qdesigner_internal::DesignerImageCache::invalidate(m_pathToContents.value(oldPath));
                         m_pathToResourceSet.erase(itRemove);
                         m_pathToModified.remove(oldPath);
                         m_pathToContents.remove(oldPath);
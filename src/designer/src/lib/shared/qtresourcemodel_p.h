@@ -115,6 +115,9 @@ public:
 
 signals:
     void resourceSetActivated(QtResourceSet *resourceSet, bool resourceSetChanged); // resourceSetChanged since last time it was activated!
+    // Emitted instead of resourceSetActivated() if only some qrc files of the current
+    // resource set were reloaded; resourcePaths are their old and new contents.
+    void resourceSetReloaded(QtResourceSet *resourceSet, const QStringList &qrcPaths, const QStringList &resourcePaths);
     void qrcFileModifiedExternally(const QString &path);
 
 private:
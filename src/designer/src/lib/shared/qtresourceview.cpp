@@ -696,6 +696,8 @@ void QtResourceView::setResourceModel(QtResourceModel *model)
     if (d_ptr->m_resourceModel) {
         disconnect(d_ptr->m_resourceModel, SIGNAL(resourceSetActivated(QtResourceSet*,bool)),
                     this, SLOT(slotResourceSetActivated(QtResourceSet*)));
+        disconnect(d_ptr->m_resourceModel, SIGNAL(resourceSetReloaded(QtResourceSet*,QStringList,QStringList)),
+                    this, SLOT(slotResourceSetActivated(QtResourceSet*)));
     }
 
     // clear here
@@ -709,6 +711,8 @@ void QtResourceView::setResourceModel(QtResourceModel *model)
 
     connect(d_ptr->m_resourceModel, SIGNAL(resourceSetActivated(QtResourceSet*,bool)),
             this, SLOT(slotResourceSetActivated(QtResourceSet*)));
+    connect(d_ptr->m_resourceModel, SIGNAL(resourceSetReloaded(QtResourceSet*,QStringList,QStringList)),
+            this, SLOT(slotResourceSetActivated(QtResourceSet*)));
 
     // fill new here
     d_ptr->slotResourceSetActivated(d_ptr->m_resourceModel->currentResourceSet());
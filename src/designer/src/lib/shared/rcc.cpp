@@ -39,9 +39,12 @@
 #include <QtCore/qiodevice.h>
 #include <QtCore/qlocale.h>
 #include <QtCore/qstack.h>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthreadpool.h>
 #include <QtCore/qxmlstream.h>
 
 #include <algorithm>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -100,7 +103,8 @@ public:
     QString resourceName() const;
 
 public:
-    qint64 writeDataBlob(RCCResourceLibrary &lib, qint64 offset, QString *errorMessage);
+    bool readDataBlob(QString *errorMessage);
+    qint64 writeDataBlob(RCCResourceLibrary &lib, qint64 offset);
     qint64 writeDataName(RCCResourceLibrary &, qint64 offset);
     void writeDataInfo(RCCResourceLibrary &lib);
 
@@ -117,6 +121,9 @@ public:
     qint64 m_nameOffset;
     qint64 m_dataOffset;
     qint64 m_childOffset;
+
+    QByteArray m_data; // read (and compressed) by readDataBlob()
+    qint64 m_uncompressedSize;
 };
 
 RCCFileInfo::RCCFileInfo(const QString &name, const QFileInfo &fileInfo,
@@ -132,6 +139,7 @@ RCCFileInfo::RCCFileInfo(const QString &name, const QFileInfo &fileInfo,
     m_nameOffset = 0;
     m_dataOffset = 0;
     m_childOffset = 0;
+    m_uncompressedSize = 0;
     m_compressLevel = compressLevel;
     m_compressThreshold = compressThreshold;
 }
@@ -200,21 +208,18 @@ void RCCFileInfo::writeDataInfo(RCCResourceLibrary &lib)
         lib.writeChar('\n');
 }
 
-qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset,
-    QString *errorMessage)
+// Read and compress the data, does not touch the library and may be run
+// concurrently for different files.
+bool RCCFileInfo::readDataBlob(QString *errorMessage)
 {
-    const bool text = (lib.m_format == RCCResourceLibrary::C_Code);
-
-    //capture the offset
-    m_dataOffset = offset;
-
     //find the data to be written
     QFile file(m_fileInfo.absoluteFilePath());
     if (!file.open(QFile::ReadOnly)) {
         *errorMessage = msgOpenReadFailed(m_fileInfo.absoluteFilePath(), file.errorString());
-        return 0;
+        return false;
     }
     QByteArray data = file.readAll();
+    m_uncompressedSize = data.size();
 
 #ifndef QT_NO_COMPRESS
     // Check if compression is useful for this file
@@ -230,6 +235,20 @@ qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset,
     }
 #endif // QT_NO_COMPRESS
 
+    m_data = data;
+    return true;
+}
+
+qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset)
+{
+    const bool text = (lib.m_format == RCCResourceLibrary::C_Code);
+
+    //capture the offset
+    m_dataOffset = offset;
+
+    const QByteArray data = m_data;
+    m_data.clear();
+
     // some info
     if (text) {
         lib.writeString("  // ");
@@ -811,9 +830,9 @@ bool RCCResourceLibrary::writeDataBlobs()
     if (!m_root)
         return false;
 
+    // Collect the files in the order of the layout pass
+    QList<RCCFileInfo *> files;
     pending.push(m_root);
-    qint64 offset = 0;
-    QString errorMessage;
     while (!pending.isEmpty()) {
         RCCFileInfo *file = pending.pop();
         for (QHash<QString, RCCFileInfo*>::iterator it = file->m_children.begin();
@@ -821,15 +840,38 @@ bool RCCResourceLibrary::writeDataBlobs()
             RCCFileInfo *child = it.value();
             if (child->m_flags & RCCFileInfo::Directory)
                 pending.push(child);
-            else {
-                offset = child->writeDataBlob(*this, offset, &errorMessage);
-                if (offset == 0) {
-                    m_errorDevice->write(errorMessage.toUtf8());
-                    return false;
-                }
-            }
+            else
+                files.append(child);
         }
     }
+
+    // Reading and compressing dominates, do it concurrently
+    std::vector<QString> errorMessages(files.size());
+    QSemaphore done;
+    for (qsizetype i = 0; i < files.size(); ++i) {
+        QThreadPool::globalInstance()->start([&files, &errorMessages, &done, i]() {
+            files.at(i)->readDataBlob(&errorMessages[i]);
+            done.release();
+        });
+    }
+    done.acquire(files.size());
+
+    // Lay out the blobs serially in the original order, so that the output is deterministic
+    qint64 offset = 0;
+    qint64 uncompressedSize = 0;
+    for (qsizetype i = 0; i < files.size(); ++i) {
+        if (!errorMessages[i].isEmpty()) {
+            m_errorDevice->write(errorMessages[i].toUtf8());
+            return false;
+        }
+        offset = files.at(i)->writeDataBlob(*this, offset);
+        uncompressedSize += files.at(i)->m_uncompressedSize;
+    }
+    if (m_verbose) {
+        const QString msg = QString::fromUtf8("Wrote %1 files, %2 bytes (%3 bytes uncompressed)\n")
+            .arg(files.size()).arg(offset).arg(uncompressedSize);
+        m_errorDevice->write(msg.toUtf8());
+    }
     if (m_format == C_Code)
         writeString("\n};\n\n");
     return true;
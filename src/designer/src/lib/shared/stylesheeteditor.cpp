@@ -56,14 +56,22 @@
 #include <QtGui/qevent.h>
 #include <QtGui/qtextdocument.h>
 
+#include <QtCore/qpromise.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qtimer.h>
+
 #include <private/qcssparser_p.h>
 
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 static const char *styleSheetProperty = "styleSheet";
 static const char *StyleSheetDialogC = "StyleSheetDialog";
 static const char *Geometry = "Geometry";
 
+enum { ValidationDelayMs = 300 };
+
 namespace qdesigner_internal {
 
 StyleSheetEditor::StyleSheetEditor(QWidget *parent)
@@ -81,6 +89,8 @@ StyleSheetEditorDialog::StyleSheetEditorDialog(QDesignerFormEditorInterface *cor
     m_editor(new StyleSheetEditor),
     m_findWidget(new TextEditFindWidget),
     m_validityLabel(new QLabel(tr("Valid Style Sheet"))),
+    m_validationTimer(new QTimer(this)),
+    m_validationWatcher(new QFutureWatcher<StyleSheetValidation>(this)),
     m_core(core),
     m_addResourceAction(new QAction(tr("Add Resource..."), this)),
     m_addGradientAction(new QAction(tr("Add Gradient..."), this)),
@@ -96,7 +106,16 @@ StyleSheetEditorDialog::StyleSheetEditorDialog(QDesignerFormEditorInterface *cor
             this, &StyleSheetEditorDialog::slotRequestHelp);
     m_buttonBox->button(QDialogButtonBox::Help)->setShortcut(QKeySequence::HelpContents);
 
-    connect(m_editor, &QTextEdit::textChanged, this, &StyleSheetEditorDialog::validateStyleSheet);
+    // Parsing large style sheets takes a while, so wait for a pause in
+    // typing and parse a copy of the text in the thread pool.
+    m_validationTimer->setSingleShot(true);
+    m_validationTimer->setInterval(ValidationDelayMs);
+    connect(m_editor, &QTextEdit::textChanged,
+            m_validationTimer, QOverload<>::of(&QTimer::start));
+    connect(m_validationTimer, &QTimer::timeout,
+            this, &StyleSheetEditorDialog::validateStyleSheet);
+    connect(m_validationWatcher, &QFutureWatcherBase::finished,
+            this, &StyleSheetEditorDialog::validationFinished);
     m_findWidget->setTextEdit(m_editor);
 
     QToolBar *toolBar = new QToolBar;
@@ -357,28 +376,79 @@ void StyleSheetEditorDialog::setText(const QString &t)
     m_editor->setText(t);
 }
 
-bool StyleSheetEditorDialog::isStyleSheetValid(const QString &styleSheet)
+// Offset of the symbol the parser stopped at, the end of the text if it ran out of symbols
+static int errorOffset(QCss::Parser &parser, qsizetype textLength)
+{
+    const QCss::Symbol symbol = parser.errorSymbol();
+    return symbol.len < 0 ? int(textLength) : symbol.start;
+}
+
+static StyleSheetValidation validateStyleSheetText(const QString &styleSheet)
 {
+    StyleSheetValidation result;
     QCss::Parser parser(styleSheet);
     QCss::StyleSheet sheet;
     if (parser.parse(&sheet))
-        return true;
-    QString fullSheet = QStringLiteral("* { ");
+        return result;
+
+    // Try as a list of properties of an inline style sheet
+    static const QString inlinePrefix = QStringLiteral("* { ");
+    QString fullSheet = inlinePrefix;
     fullSheet += styleSheet;
     fullSheet += QLatin1Char('}');
     QCss::Parser parser2(fullSheet);
-    return parser2.parse(&sheet);
+    if (parser2.parse(&sheet))
+        return result;
+
+    // Report the error of the interpretation that got further
+    const int offset = qBound(0, qMax(errorOffset(parser, styleSheet.size()),
+                                      errorOffset(parser2, fullSheet.size()) - int(inlinePrefix.size())),
+                              int(styleSheet.size()));
+    result.valid = false;
+    const QStringView head = QStringView(styleSheet).left(offset);
+    result.line = int(head.count(QLatin1Char('\n'))) + 1;
+    result.column = int(offset - (head.lastIndexOf(QLatin1Char('\n')) + 1)) + 1;
+    return result;
+}
+
+bool StyleSheetEditorDialog::isStyleSheetValid(const QString &styleSheet)
+{
+    return validateStyleSheetText(styleSheet).valid;
 }
 
 void StyleSheetEditorDialog::validateStyleSheet()
 {
-    const bool valid = isStyleSheetValid(m_editor->toPlainText());
-    setOkButtonEnabled(valid);
-    if (valid) {
+    // Only one parse at a time; the latest text is parsed once it is done.
+    if (m_validationWatcher->isRunning()) {
+        m_validationPending = true;
+        return;
+    }
+    m_validationPending = false;
+
+    auto promise = std::make_shared<QPromise<StyleSheetValidation>>();
+    m_validationWatcher->setFuture(promise->future());
+    promise->start();
+    QThreadPool::globalInstance()->start([promise, styleSheet = m_editor->toPlainText()] {
+        promise->addResult(validateStyleSheetText(styleSheet));
+        promise->finish();
+    });
+}
+
+void StyleSheetEditorDialog::validationFinished()
+{
+    if (m_validationPending) {
+        validateStyleSheet();
+        return;
+    }
+
+    const StyleSheetValidation validation = m_validationWatcher->result();
+    setOkButtonEnabled(validation.valid);
+    if (validation.valid) {
         m_validityLabel->setText(tr("Valid Style Sheet"));
         m_validityLabel->setStyleSheet(QStringLiteral("color: green"));
     } else {
-        m_validityLabel->setText(tr("Invalid Style Sheet"));
+        m_validityLabel->setText(tr("Invalid Style Sheet (line %1, column %2)")
+                                 .arg(validation.line).arg(validation.column));
         m_validityLabel->setStyleSheet(QStringLiteral("color: red"));
     }
 }
@@ -43,6 +43,7 @@
 #include <QtWidgets/qtextedit.h>
 #include <QtWidgets/qdialog.h>
 #include <QtWidgets/qlabel.h>
+#include <QtCore/qfuturewatcher.h>
 #include "shared_global_p.h"
 
 QT_BEGIN_NAMESPACE
@@ -52,9 +53,18 @@ class QDesignerFormEditorInterface;
 class TextEditFindWidget;
 
 class QDialogButtonBox;
+class QTimer;
 
 namespace qdesigner_internal {
 
+// Outcome of parsing a style sheet; line and column (1-based) of the first error
+struct StyleSheetValidation
+{
+    bool valid = true;
+    int line = 0;
+    int column = 0;
+};
+
 class QDESIGNER_SHARED_EXPORT StyleSheetEditor : public QTextEdit
 {
     Q_OBJECT
@@ -82,6 +92,7 @@ public:
 
 private slots:
     void validateStyleSheet();
+    void validationFinished();
     void slotContextMenuRequested(const QPoint &pos);
     void slotAddResource(const QString &property);
     void slotAddGradient(const QString &property);
@@ -101,6 +112,9 @@ private:
     StyleSheetEditor *m_editor;
     TextEditFindWidget *m_findWidget;
     QLabel *m_validityLabel;
+    QTimer *m_validationTimer;
+    QFutureWatcher<StyleSheetValidation> *m_validationWatcher;
+    bool m_validationPending = false;
     QDesignerFormEditorInterface *m_core;
     QAction *m_addResourceAction;
     QAction *m_addGradientAction;
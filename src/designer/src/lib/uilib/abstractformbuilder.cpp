@@ -73,6 +73,9 @@
 
 #include <QtGui/qaction.h>
 #include <QtGui/qactiongroup.h>
+#if QT_CONFIG(standarditemmodel)
+#  include <QtGui/qstandarditemmodel.h>
+#endif
 
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qdebug.h>
@@ -1606,6 +1609,7 @@ public:
     using QAbstractFormBuilder::resourceBuilder;
     using QAbstractFormBuilder::textBuilder;
     using QAbstractFormBuilder::toVariant;
+    using QAbstractFormBuilder::d;
 };
 
 template<class T>
@@ -1672,10 +1676,9 @@ static void loadItemProps(QAbstractFormBuilder *abstractFormBuilder, T *item,
 
     for (const QFormBuilderStrings::TextRoleNName &it : strings.itemTextRoles)
         if ((p = properties.value(it.second))) {
-            v = formBuilder->textBuilder()->loadText(p);
-            QVariant nativeValue = formBuilder->textBuilder()->toNativeValue(v);
-            item->setData(it.first.first, qvariant_cast<QString>(nativeValue));
-            item->setData(it.first.second, v);
+            const QFormBuilderExtra::LoadedValue text = formBuilder->d->loadItemText(p);
+            item->setData(it.first.first, qvariant_cast<QString>(text.nativeValue));
+            item->setData(it.first.second, text.value);
         }
 
     for (const QFormBuilderStrings::RoleNName &it : strings.itemRoles)
@@ -1684,10 +1687,10 @@ static void loadItemProps(QAbstractFormBuilder *abstractFormBuilder, T *item,
             item->setData(it.first, v);
 
     if ((p = properties.value(strings.iconAttribute))) {
-        v = formBuilder->resourceBuilder()->loadResource(formBuilder->workingDirectory(), p);
-        QVariant nativeValue = formBuilder->resourceBuilder()->toNativeValue(v);
-        item->setIcon(qvariant_cast<QIcon>(nativeValue));
-        item->setData(Qt::DecorationPropertyRole, v);
+        const QFormBuilderExtra::LoadedValue icon =
+            formBuilder->d->loadItemIcon(formBuilder->workingDirectory(), p);
+        item->setIcon(qvariant_cast<QIcon>(icon.nativeValue));
+        item->setData(Qt::DecorationPropertyRole, icon.value);
     }
 }
 
@@ -2055,11 +2058,27 @@ void QAbstractFormBuilder::loadListWidgetExtraInfo(DomWidget *ui_widget, QListWi
     Q_UNUSED(parentWidget);
     const QFormBuilderStrings &strings = QFormBuilderStrings::instance();
 
+    // Load the items before adding them, so that the view does not update
+    // or sort itself for each value that is set.
     const auto &elementItem = ui_widget->elementItem();
-    for (DomItem *ui_item : elementItem) {
-        const DomPropertyHash properties = propertyMap(ui_item->elementProperty());
-        QListWidgetItem *item = new QListWidgetItem(listWidget);
-        loadItemPropsNFlags<QListWidgetItem>(this, item, properties);
+    if (!elementItem.isEmpty()) {
+        const bool sortingEnabled = listWidget->isSortingEnabled();
+        const bool updatesEnabled = listWidget->updatesEnabled();
+        listWidget->setSortingEnabled(false);
+        if (updatesEnabled)
+            listWidget->setUpdatesEnabled(false);
+        for (DomItem *ui_item : elementItem) {
+            const DomPropertyHash properties = propertyMap(ui_item->elementProperty());
+            QListWidgetItem *item = new QListWidgetItem;
+            loadItemPropsNFlags<QListWidgetItem>(this, item, properties);
+            listWidget->addItem(item);
+        }
+        if (sortingEnabled) {
+            listWidget->setSortingEnabled(true);
+            listWidget->sortItems();
+        }
+        if (updatesEnabled)
+            listWidget->setUpdatesEnabled(true);
     }
 
     DomProperty *currentRow = propertyMap(ui_widget->elementProperty()).value(strings.currentRowProperty);
@@ -2093,22 +2112,27 @@ void QAbstractFormBuilder::loadTreeWidgetExtraInfo(DomWidget *ui_widget, QTreeWi
 
         for (const QFormBuilderStrings::TextRoleNName &it : strings.itemTextRoles)
             if ((p = properties.value(it.second))) {
-                v = textBuilder()->loadText(p);
-                QVariant nativeValue = textBuilder()->toNativeValue(v);
-                treeWidget->headerItem()->setData(i, it.first.first, qvariant_cast<QString>(nativeValue));
-                treeWidget->headerItem()->setData(i, it.first.second, v);
+                const QFormBuilderExtra::LoadedValue text = d->loadItemText(p);
+                treeWidget->headerItem()->setData(i, it.first.first, qvariant_cast<QString>(text.nativeValue));
+                treeWidget->headerItem()->setData(i, it.first.second, text.value);
             }
 
         if ((p = properties.value(strings.iconAttribute))) {
-            v = resourceBuilder()->loadResource(workingDirectory(), p);
-            QVariant nativeValue = resourceBuilder()->toNativeValue(v);
-            treeWidget->headerItem()->setIcon(i, qvariant_cast<QIcon>(nativeValue));
-            treeWidget->headerItem()->setData(i, Qt::DecorationPropertyRole, v);
+            const QFormBuilderExtra::LoadedValue icon = d->loadItemIcon(workingDirectory(), p);
+            treeWidget->headerItem()->setIcon(i, qvariant_cast<QIcon>(icon.nativeValue));
+            treeWidget->headerItem()->setData(i, Qt::DecorationPropertyRole, icon.value);
         }
     }
 
-    QQueue<QPair<DomItem *, QTreeWidgetItem *> > pendingQueue;
     const auto &widgetElementItem = ui_widget->elementItem();
+    if (widgetElementItem.isEmpty())
+        return;
+
+    // Build the item tree before adding it to the view in one go, so that
+    // the view does not update or sort itself for each value that is set.
+    QList<QTreeWidgetItem *> topLevelItems;
+    topLevelItems.reserve(widgetElementItem.size());
+    QQueue<QPair<DomItem *, QTreeWidgetItem *> > pendingQueue;
     for (DomItem *ui_item : widgetElementItem)
         pendingQueue.enqueue(qMakePair(ui_item, nullptr));
 
@@ -2119,10 +2143,12 @@ void QAbstractFormBuilder::loadTreeWidgetExtraInfo(DomWidget *ui_widget, QTreeWi
 
         QTreeWidgetItem *currentItem = nullptr;
 
-        if (parentItem)
+        if (parentItem) {
             currentItem = new QTreeWidgetItem(parentItem);
-        else
-            currentItem = new QTreeWidgetItem(treeWidget);
+        } else {
+            currentItem = new QTreeWidgetItem;
+            topLevelItems.append(currentItem);
+        }
 
         const auto &properties = domItem->elementProperty();
         int col = -1;
@@ -2131,17 +2157,15 @@ void QAbstractFormBuilder::loadTreeWidgetExtraInfo(DomWidget *ui_widget, QTreeWi
                 currentItem->setFlags(enumKeysToValue<Qt::ItemFlags>(itemFlags_enum, property->elementSet().toLatin1()));
             } else if (property->attributeName() == strings.textAttribute && property->elementString()) {
                 col++;
-                QVariant textV = textBuilder()->loadText(property);
-                QVariant nativeValue = textBuilder()->toNativeValue(textV);
-                currentItem->setText(col, qvariant_cast<QString>(nativeValue));
-                currentItem->setData(col, Qt::DisplayPropertyRole, textV);
+                const QFormBuilderExtra::LoadedValue text = d->loadItemText(property);
+                currentItem->setText(col, qvariant_cast<QString>(text.nativeValue));
+                currentItem->setData(col, Qt::DisplayPropertyRole, text.value);
             } else if (col >= 0) {
                 if (property->attributeName() == strings.iconAttribute) {
-                    QVariant v = resourceBuilder()->loadResource(workingDirectory(), property);
-                    if (v.isValid()) {
-                        QVariant nativeValue = resourceBuilder()->toNativeValue(v);
-                        currentItem->setIcon(col, qvariant_cast<QIcon>(nativeValue));
-                        currentItem->setData(col, Qt::DecorationPropertyRole, v);
+                    const QFormBuilderExtra::LoadedValue icon = d->loadItemIcon(workingDirectory(), property);
+                    if (icon.value.isValid()) {
+                        currentItem->setIcon(col, qvariant_cast<QIcon>(icon.nativeValue));
+                        currentItem->setData(col, Qt::DecorationPropertyRole, icon.value);
                     }
                 } else {
                     QVariant v;
@@ -2154,10 +2178,9 @@ void QAbstractFormBuilder::loadTreeWidgetExtraInfo(DomWidget *ui_widget, QTreeWi
                             strings.treeItemTextRoleHash.value(property->attributeName(),
                                          qMakePair((Qt::ItemDataRole)-1, (Qt::ItemDataRole)-1));
                         if (rolePair.first >= 0) {
-                            QVariant textV = textBuilder()->loadText(property);
-                            QVariant nativeValue = textBuilder()->toNativeValue(textV);
-                            currentItem->setData(col, rolePair.first, qvariant_cast<QString>(nativeValue));
-                            currentItem->setData(col, rolePair.second, textV);
+                            const QFormBuilderExtra::LoadedValue text = d->loadItemText(property);
+                            currentItem->setData(col, rolePair.first, qvariant_cast<QString>(text.nativeValue));
+                            currentItem->setData(col, rolePair.second, text.value);
                         }
                     }
                 }
@@ -2169,6 +2192,16 @@ void QAbstractFormBuilder::loadTreeWidgetExtraInfo(DomWidget *ui_widget, QTreeWi
             pendingQueue.enqueue(qMakePair(childItem, currentItem));
 
     }
+
+    const bool sortingEnabled = treeWidget->isSortingEnabled();
+    const bool updatesEnabled = treeWidget->updatesEnabled();
+    treeWidget->setSortingEnabled(false);
+    if (updatesEnabled)
+        treeWidget->setUpdatesEnabled(false);
+    treeWidget->addTopLevelItems(topLevelItems);
+    treeWidget->setSortingEnabled(sortingEnabled);
+    if (updatesEnabled)
+        treeWidget->setUpdatesEnabled(true);
 }
 
 /*!
@@ -2206,7 +2239,16 @@ void QAbstractFormBuilder::loadTableWidgetExtraInfo(DomWidget *ui_widget, QTable
         }
     }
 
+    // Sorting is disabled while the items are set, as it would move the rows
+    // of the items already set and make the view update for each item.
     const auto &elementItem = ui_widget->elementItem();
+    if (elementItem.isEmpty())
+        return;
+    const bool sortingEnabled = tableWidget->isSortingEnabled();
+    const bool updatesEnabled = tableWidget->updatesEnabled();
+    tableWidget->setSortingEnabled(false);
+    if (updatesEnabled)
+        tableWidget->setUpdatesEnabled(false);
     for (DomItem *ui_item : elementItem) {
         if (ui_item->hasAttributeRow() && ui_item->hasAttributeColumn()) {
             const DomPropertyHash properties = propertyMap(ui_item->elementProperty());
@@ -2215,6 +2257,9 @@ void QAbstractFormBuilder::loadTableWidgetExtraInfo(DomWidget *ui_widget, QTable
             tableWidget->setItem(ui_item->attributeRow(), ui_item->attributeColumn(), item);
         }
     }
+    tableWidget->setSortingEnabled(sortingEnabled);
+    if (updatesEnabled)
+        tableWidget->setUpdatesEnabled(true);
 }
 
 /*!
@@ -2225,6 +2270,16 @@ void QAbstractFormBuilder::loadComboBoxExtraInfo(DomWidget *ui_widget, QComboBox
     Q_UNUSED(parentWidget);
     const QFormBuilderStrings &strings = QFormBuilderStrings::instance();
     const auto &elementItem = ui_widget->elementItem();
+#if QT_CONFIG(standarditemmodel)
+    // Append the items of the default model in one go, so that the combo
+    // does not update its current index and size hint for each of them.
+    QStandardItemModel *model = qobject_cast<QStandardItemModel *>(comboBox->model());
+    if (model && comboBox->modelColumn() != 0)
+        model = nullptr;
+    QList<QStandardItem *> items;
+    if (model)
+        items.reserve(elementItem.size());
+#endif
     for (DomItem *ui_item : elementItem) {
         const DomPropertyHash properties = propertyMap(ui_item->elementProperty());
         QString text;
@@ -2236,20 +2291,41 @@ void QAbstractFormBuilder::loadComboBoxExtraInfo(DomWidget *ui_widget, QComboBox
 
         p = properties.value(strings.textAttribute);
         if (p && p->elementString()) {
-             textData = textBuilder()->loadText(p);
-             text = qvariant_cast<QString>(textBuilder()->toNativeValue(textData));
+             const QFormBuilderExtra::LoadedValue loadedText = d->loadItemText(p);
+             textData = loadedText.value;
+             text = qvariant_cast<QString>(loadedText.nativeValue);
         }
 
         p = properties.value(strings.iconAttribute);
         if (p) {
-             iconData = resourceBuilder()->loadResource(workingDirectory(), p);
-             icon = qvariant_cast<QIcon>(resourceBuilder()->toNativeValue(iconData));
+             const QFormBuilderExtra::LoadedValue loadedIcon = d->loadItemIcon(workingDirectory(), p);
+             iconData = loadedIcon.value;
+             icon = qvariant_cast<QIcon>(loadedIcon.nativeValue);
         }
 
+#if QT_CONFIG(standarditemmodel)
+        if (model) {
+            if (comboBox->count() + items.size() >= comboBox->maxCount())
+                break;
+            QStandardItem *item = new QStandardItem(text);
+            if (!icon.isNull())
+                item->setData(icon, Qt::DecorationRole);
+            if (iconData.isValid())
+                item->setData(iconData, Qt::DecorationPropertyRole);
+            if (textData.isValid())
+                item->setData(textData, Qt::DisplayPropertyRole);
+            items.append(item);
+            continue;
+        }
+#endif
         comboBox->addItem(icon, text);
         comboBox->setItemData((comboBox->count()-1), iconData, Qt::DecorationPropertyRole);
         comboBox->setItemData((comboBox->count()-1), textData, Qt::DisplayPropertyRole);
     }
+#if QT_CONFIG(standarditemmodel)
+    if (!items.isEmpty())
+        model->invisibleRootItem()->appendRows(items);
+#endif
 
     DomProperty *currentIndex = propertyMap(ui_widget->elementProperty()).value(strings.currentIndexProperty);
     if (currentIndex)
@@ -44,6 +44,12 @@
 #include <QtUiPlugin/customwidget.h>
 #include <QtWidgets/QtWidgets>
 
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qstandardpaths.h>
+
 #ifdef QT_OPENGLWIDGETS_LIB
 #  include <QtOpenGLWidgets/qopenglwidget.h>
 #endif
@@ -91,6 +97,11 @@ namespace QFormInternal {
        can be used to create new instances of registered custom widgets.
     \endlist
 
+    The custom widget class names provided by the plugins are cached, so
+    that a plugin library is loaded only when one of its widgets is
+    created. Setting the environment variable \c QT_DESIGNER_NO_PLUGIN_CACHE
+    disables the cache.
+
     The QFormBuilder class is typically used by custom components and
     applications that embed \QD. Standalone applications that need to
     dynamically generate user interfaces at run-time use the
@@ -154,6 +165,55 @@ QWidget *QFormBuilder::create(DomWidget *ui_widget, QWidget *parentWidget)
 }
 
 
+// Inserts the custom widgets of a plugin instance, returns their class names
+static QStringList insertPlugins(QObject *o, QMap<QString, QDesignerCustomWidgetInterface*> *customWidgets)
+{
+    QStringList classNames;
+    // step 1) try with a normal plugin
+    if (QDesignerCustomWidgetInterface *iface = qobject_cast<QDesignerCustomWidgetInterface *>(o)) {
+        customWidgets->insert(iface->name(), iface);
+        classNames.append(iface->name());
+        return classNames;
+    }
+    // step 2) try with a collection of plugins
+    if (QDesignerCustomWidgetCollectionInterface *c = qobject_cast<QDesignerCustomWidgetCollectionInterface *>(o)) {
+        const auto &collectionCustomWidgets = c->customWidgets();
+        for (QDesignerCustomWidgetInterface *iface : collectionCustomWidgets) {
+            customWidgets->insert(iface->name(), iface);
+            classNames.append(iface->name());
+        }
+    }
+    return classNames;
+}
+
+// Loads the plugin library providing a custom widget class found in the
+// plugin metadata cache by updateCustomWidgets().
+static bool loadDeferredCustomWidgetPlugin(QFormBuilderExtra *d, const QString &className)
+{
+#if QT_CONFIG(library)
+    const QString pluginPath = d->m_deferredCustomWidgets.value(className);
+    if (pluginPath.isEmpty())
+        return false;
+
+    for (auto it = d->m_deferredCustomWidgets.begin(); it != d->m_deferredCustomWidgets.end(); ) {
+        if (it.value() == pluginPath)
+            it = d->m_deferredCustomWidgets.erase(it);
+        else
+            ++it;
+    }
+
+    QPluginLoader loader(pluginPath);
+    if (!loader.load())
+        return false;
+    insertPlugins(loader.instance(), &d->m_customWidgets);
+    return d->m_customWidgets.contains(className);
+#else
+    Q_UNUSED(d);
+    Q_UNUSED(className);
+    return false;
+#endif // QT_CONFIG(library)
+}
+
 /*!
     \internal
 */
@@ -209,6 +269,8 @@ QWidget *QFormBuilder::createWidget(const QString &widgetName, QWidget *parentWi
 
         // try with a registered custom widget
         QDesignerCustomWidgetInterface *factory = d->m_customWidgets.value(widgetName);
+        if (factory == nullptr && loadDeferredCustomWidgetPlugin(d.data(), widgetName))
+            factory = d->m_customWidgets.value(widgetName);
         if (factory != nullptr)
             w = factory->createWidget(parentWidget);
     } while(false);
@@ -445,29 +507,114 @@ void QFormBuilder::setPluginPath(const QStringList &pluginPaths)
     updateCustomWidgets();
 }
 
-static void insertPlugins(QObject *o, QMap<QString, QDesignerCustomWidgetInterface*> *customWidgets)
+#if QT_CONFIG(library)
+namespace {
+// Remembers the custom widget class names of the plugin libraries by path and
+// modification time, so that the libraries need to be loaded only when one of
+// their classes is used. Plugins that do not provide custom widgets are stored
+// with an empty list of class names; libraries that fail to load are not stored.
+class CustomWidgetPluginCache
 {
-    // step 1) try with a normal plugin
-    if (QDesignerCustomWidgetInterface *iface = qobject_cast<QDesignerCustomWidgetInterface *>(o)) {
-        customWidgets->insert(iface->name(), iface);
+public:
+    CustomWidgetPluginCache();
+
+    bool lookup(const QFileInfo &plugin, QStringList *classNames) const;
+    void insert(const QFileInfo &plugin, const QStringList &classNames);
+    void save() const;
+
+private:
+    struct Entry
+    {
+        qint64 lastModified = 0;
+        QStringList classNames;
+    };
+
+    static constexpr quint32 magic = 0x5155504c; // "QUPL"
+    static constexpr quint32 version = 2; // 1 also stored libraries that failed to load
+
+    QString m_fileName;
+    QHash<QString, Entry> m_entries;
+    bool m_modified = false;
+};
+
+CustomWidgetPluginCache::CustomWidgetPluginCache()
+{
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    if (cacheDir.isEmpty() || qEnvironmentVariableIsSet("QT_DESIGNER_NO_PLUGIN_CACHE"))
+        return;
+    m_fileName = cacheDir + QLatin1String("/QtProject/designer-plugins.cache");
+
+    QFile file(m_fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+    QDataStream in(&file);
+    quint32 fileMagic = 0;
+    quint32 fileVersion = 0;
+    quint32 qtVersion = 0;
+    in >> fileMagic >> fileVersion >> qtVersion;
+    if (fileMagic != magic || fileVersion != version || qtVersion != QT_VERSION)
         return;
+    in.setVersion(QDataStream::Qt_6_0);
+    qint32 count = 0;
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString path;
+        Entry entry;
+        in >> path >> entry.lastModified >> entry.classNames;
+        m_entries.insert(path, entry);
     }
-    // step 2) try with a collection of plugins
-    if (QDesignerCustomWidgetCollectionInterface *c = qobject_cast<QDesignerCustomWidgetCollectionInterface *>(o)) {
-        const auto &collectionCustomWidgets = c->customWidgets();
-        for (QDesignerCustomWidgetInterface *iface : collectionCustomWidgets)
-            customWidgets->insert(iface->name(), iface);
+    if (in.status() != QDataStream::Ok)
+        m_entries.clear();
+}
+
+bool CustomWidgetPluginCache::lookup(const QFileInfo &plugin, QStringList *classNames) const
+{
+    const auto it = m_entries.constFind(plugin.absoluteFilePath());
+    if (it == m_entries.constEnd()
+        || it->lastModified != plugin.lastModified().toMSecsSinceEpoch()) {
+        return false;
     }
+    *classNames = it->classNames;
+    return true;
 }
 
+void CustomWidgetPluginCache::insert(const QFileInfo &plugin, const QStringList &classNames)
+{
+    if (m_fileName.isEmpty())
+        return;
+    m_entries.insert(plugin.absoluteFilePath(),
+                     {plugin.lastModified().toMSecsSinceEpoch(), classNames});
+    m_modified = true;
+}
+
+void CustomWidgetPluginCache::save() const
+{
+    if (!m_modified || !QDir().mkpath(QFileInfo(m_fileName).absolutePath()))
+        return;
+    QSaveFile file(m_fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+    QDataStream out(&file);
+    out << magic << version << quint32(QT_VERSION);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << qint32(m_entries.size());
+    for (auto it = m_entries.cbegin(), end = m_entries.cend(); it != end; ++it)
+        out << it.key() << it->lastModified << it->classNames;
+    file.commit();
+}
+} // namespace
+#endif // QT_CONFIG(library)
+
 /*!
     \internal
 */
 void QFormBuilder::updateCustomWidgets()
 {
     d->m_customWidgets.clear();
+    d->m_deferredCustomWidgets.clear();
 
 #if QT_CONFIG(library)
+    CustomWidgetPluginCache cache;
     for (const QString &path : qAsConst(d->m_pluginPaths)) {
         const QDir dir(path);
         const QStringList candidates = dir.entryList(QDir::Files);
@@ -480,11 +627,29 @@ void QFormBuilder::updateCustomWidgets()
             loaderPath += QLatin1Char('/');
             loaderPath += plugin;
 
+            const QFileInfo pluginInfo(loaderPath);
+            QStringList classNames;
+            if (cache.lookup(pluginInfo, &classNames)) {
+                for (const QString &className : qAsConst(classNames)) {
+                    if (!d->m_deferredCustomWidgets.contains(className))
+                        d->m_deferredCustomWidgets.insert(className, loaderPath);
+                }
+                continue;
+            }
+
+            // Failures are not cached, the plugin may load next time (for
+            // example once a library it depends on has been installed).
             QPluginLoader loader(loaderPath);
-            if (loader.load())
-                insertPlugins(loader.instance(), &d->m_customWidgets);
+            if (!loader.load())
+                continue;
+            QObject *instance = loader.instance();
+            if (!instance)
+                continue;
+            classNames = insertPlugins(instance, &d->m_customWidgets);
+            cache.insert(pluginInfo, classNames);
         }
     }
+    cache.save();
 #endif // QT_CONFIG(library)
 
     // Check statically linked plugins
@@ -500,6 +665,8 @@ void QFormBuilder::updateCustomWidgets()
 */
 QList<QDesignerCustomWidgetInterface*> QFormBuilder::customWidgets() const
 {
+    while (!d->m_deferredCustomWidgets.isEmpty())
+        loadDeferredCustomWidgetPlugin(d.data(), d->m_deferredCustomWidgets.firstKey());
     return d->m_customWidgets.values();
 }
 
@@ -529,6 +696,9 @@ void QFormBuilder::applyProperties(QObject *o, const QList<DomProperty*> &proper
         } else if (isWidget && !qstrcmp("QFrame", o->metaObject()->className ()) && attributeName == strings.orientationProperty) {
             // ### special-casing for Line (QFrame) -- try to fix me
             o->setProperty("frameShape", v); // v is of QFrame::Shape enum
+        } else if (const FormBuilderPropertyInfo *info = propertyInfo(o->metaObject(), attributeName);
+                   info->writable) {
+            o->metaObject()->property(info->index).write(o, v);
         } else {
             o->setProperty(attributeName.toUtf8(), v);
         }
@@ -97,6 +97,8 @@ void QFormBuilderExtra::clear()
     m_parentWidgetIsSet = false;
     m_customWidgetDataHash.clear();
     m_buttonGroups.clear();
+    m_itemTextCache.clear();
+    m_itemIconCache.clear();
 }
 
 static inline QString msgXmlError(const QXmlStreamReader &reader)
@@ -161,17 +163,24 @@ static bool inline readUiAttributes(QXmlStreamReader &reader, const QString &lan
 
 DomUI *QFormBuilderExtra::readUi(QIODevice *dev)
 {
-    QXmlStreamReader reader(dev);
     m_errorString.clear();
-    if (!readUiAttributes(reader, m_language, &m_errorString)) {
+    DomUI *ui = readUi(dev, m_language, &m_errorString);
+    if (!ui)
         uiLibWarning(m_errorString);
+    return ui;
+}
+
+// Does not access any state or emit warnings, so that forms can be read
+// in other threads.
+DomUI *QFormBuilderExtra::readUi(QIODevice *dev, const QString &language, QString *errorMessage)
+{
+    QXmlStreamReader reader(dev);
+    if (!readUiAttributes(reader, language, errorMessage))
         return nullptr;
-    }
     DomUI *ui = new DomUI;
     ui->read(reader);
     if (reader.hasError()) {
-        m_errorString = msgXmlError(reader);
-        uiLibWarning(m_errorString);
+        *errorMessage = msgXmlError(reader);
         delete ui;
         return nullptr;
     }
@@ -304,6 +313,7 @@ void QFormBuilderExtra::clearResourceBuilder()
         delete m_resourceBuilder;
         m_resourceBuilder = nullptr;
     }
+    m_itemIconCache.clear();
 }
 
 void QFormBuilderExtra::setTextBuilder(QTextBuilder *builder)
@@ -325,6 +335,77 @@ void QFormBuilderExtra::clearTextBuilder()
         delete m_textBuilder;
         m_textBuilder = nullptr;
     }
+    m_itemTextCache.clear();
+}
+
+static inline QString itemTextKey(const DomString *str)
+{
+    const QChar separator = QChar(0);
+    return str->text() + separator + str->attributeNotr()
+        + separator + str->attributeComment()
+        + separator + str->attributeExtraComment()
+        + separator + str->attributeId();
+}
+
+QFormBuilderExtra::LoadedValue QFormBuilderExtra::loadItemText(const DomProperty *p)
+{
+    const DomString *str = p->kind() == DomProperty::String ? p->elementString() : nullptr;
+    if (str == nullptr) {
+        const QVariant value = m_textBuilder->loadText(p);
+        return {value, m_textBuilder->toNativeValue(value)};
+    }
+
+    const QString key = itemTextKey(str);
+    auto it = m_itemTextCache.find(key);
+    if (it == m_itemTextCache.end()) {
+        const QVariant value = m_textBuilder->loadText(p);
+        it = m_itemTextCache.insert(key, {value, m_textBuilder->toNativeValue(value)});
+    }
+    return it.value();
+}
+
+static inline void appendIconPixmapKey(QString *key, const DomResourcePixmap *pixmap)
+{
+    key->append(QChar(0));
+    if (pixmap != nullptr)
+        key->append(pixmap->text());
+}
+
+static QString itemIconKey(const QDir &workingDirectory, const DomResourceIcon *icon)
+{
+    QString key = workingDirectory.path();
+    key += QChar(0);
+    key += icon->attributeTheme();
+    key += QChar(0);
+    key += icon->attributeResource();
+    key += QChar(0);
+    key += icon->text();
+    appendIconPixmapKey(&key, icon->elementNormalOff());
+    appendIconPixmapKey(&key, icon->elementNormalOn());
+    appendIconPixmapKey(&key, icon->elementDisabledOff());
+    appendIconPixmapKey(&key, icon->elementDisabledOn());
+    appendIconPixmapKey(&key, icon->elementActiveOff());
+    appendIconPixmapKey(&key, icon->elementActiveOn());
+    appendIconPixmapKey(&key, icon->elementSelectedOff());
+    appendIconPixmapKey(&key, icon->elementSelectedOn());
+    return key;
+}
+
+QFormBuilderExtra::LoadedValue QFormBuilderExtra::loadItemIcon(const QDir &workingDirectory,
+                                                               const DomProperty *p)
+{
+    if (p->kind() != DomProperty::IconSet) {
+        const QVariant value = m_resourceBuilder->loadResource(workingDirectory, p);
+        return {value, m_resourceBuilder->toNativeValue(value)};
+    }
+
+    const QString key = itemIconKey(workingDirectory, p->elementIconSet());
+    auto it = m_itemIconCache.find(key);
+    if (it == m_itemIconCache.end()) {
+        const QVariant value = m_resourceBuilder->loadResource(workingDirectory, p);
+        it = m_itemIconCache.insert(key, {value, m_resourceBuilder->toNativeValue(value)});
+    }
+    return it.value();
 }
 
 void QFormBuilderExtra::registerButtonGroups(const DomButtonGroups *domGroups)
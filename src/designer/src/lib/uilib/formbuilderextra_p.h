@@ -58,6 +58,7 @@
 #include <QtCore/qstringlist.h>
 #include <QtCore/qmap.h>
 #include <QtCore/qdir.h>
+#include <QtCore/qvariant.h>
 #include <QtGui/qpalette.h>
 
 QT_BEGIN_NAMESPACE
@@ -111,6 +112,7 @@ public:
     void clear();
 
     DomUI *readUi(QIODevice *dev);
+    static DomUI *readUi(QIODevice *dev, const QString &language, QString *errorMessage);
     static QString msgInvalidUiFile();
 
     bool applyPropertyInternally(QObject *o, const QString &propertyName, const QVariant &value);
@@ -133,6 +135,16 @@ public:
     void setTextBuilder(QTextBuilder *builder);
     QTextBuilder *textBuilder() const;
 
+    // Texts and icons of items loaded by the builders. Equal values are
+    // loaded once while creating a form and shared by its items.
+    struct LoadedValue {
+        QVariant value;
+        QVariant nativeValue;
+    };
+
+    LoadedValue loadItemText(const DomProperty *p);
+    LoadedValue loadItemIcon(const QDir &workingDirectory, const DomProperty *p);
+
     void storeCustomWidgetData(const QString &className, const DomCustomWidget *d);
     QString customWidgetAddPageMethod(const QString &className) const;
     QString customWidgetBaseClass(const QString &className) const;
@@ -181,6 +193,9 @@ public:
 
     QStringList m_pluginPaths;
     QMap<QString, QDesignerCustomWidgetInterface*> m_customWidgets;
+    // Custom widget classes of plugin libraries that have not been loaded yet,
+    // mapped to the library path
+    QMap<QString, QString> m_deferredCustomWidgets;
 
     QHash<QObject*, bool> m_laidout;
     QHash<QString, QAction*> m_actions;
@@ -206,6 +221,9 @@ private:
     QResourceBuilder *m_resourceBuilder = nullptr;
     QTextBuilder *m_textBuilder = nullptr;
 
+    QHash<QString, LoadedValue> m_itemTextCache;
+    QHash<QString, LoadedValue> m_itemIconCache;
+
     QPointer<QWidget> m_parentWidget;
     bool m_parentWidgetIsSet = false;
 };
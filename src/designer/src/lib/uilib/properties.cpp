@@ -44,6 +44,8 @@
 #include "resourcebuilder_p.h"
 
 #include <QtCore/qdatetime.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qurl.h>
 #include <QtCore/qdebug.h>
 
@@ -68,14 +70,65 @@ static inline void fixEnum(QString &s)
     if (qualifierIndex != -1)
         s.remove(0, qualifierIndex + 1);
 }
+namespace {
+struct CachedPropertyInfo : FormBuilderPropertyInfo
+{
+    QHash<QString, int> enumValues;
+    QHash<QString, int> flagValues;
+};
+
+struct PropertyInfoCache
+{
+    ~PropertyInfoCache() { qDeleteAll(properties); }
+
+    QMutex mutex;
+    // Entries are never removed, so the pointers stay valid.
+    QHash<QPair<const QMetaObject *, QString>, CachedPropertyInfo *> properties;
+};
+} // namespace
+
+Q_GLOBAL_STATIC(PropertyInfoCache, propertyInfoCache)
+
+const FormBuilderPropertyInfo *propertyInfo(const QMetaObject *meta, const QString &propertyName)
+{
+    PropertyInfoCache *cache = propertyInfoCache();
+    QMutexLocker locker(&cache->mutex);
+    CachedPropertyInfo *&info = cache->properties[qMakePair(meta, propertyName)];
+    if (!info) {
+        info = new CachedPropertyInfo;
+        info->index = meta->indexOfProperty(propertyName.toUtf8());
+        if (info->index != -1) {
+            const QMetaProperty property = meta->property(info->index);
+            info->metaTypeId = property.metaType().id();
+            info->writable = property.isWritable();
+            info->enumerator = property.enumerator();
+        }
+    }
+    return info;
+}
+
+int propertyEnumValue(const FormBuilderPropertyInfo *info, const QString &keys, bool flags)
+{
+    auto *cached = static_cast<CachedPropertyInfo *>(const_cast<FormBuilderPropertyInfo *>(info));
+    QMutexLocker locker(&propertyInfoCache()->mutex);
+    QHash<QString, int> &values = flags ? cached->flagValues : cached->enumValues;
+    const auto it = values.constFind(keys);
+    if (it != values.constEnd())
+        return it.value();
+    const QByteArray keysUtf8 = keys.toUtf8();
+    const int value = flags ? info->enumerator.keysToValue(keysUtf8)
+                            : info->enumerator.keyToValue(keysUtf8);
+    values.insert(keys, value);
+    return value;
+}
+
 // Convert complex DOM types with the help of  QAbstractFormBuilder
 QVariant domPropertyToVariant(QAbstractFormBuilder *afb,const QMetaObject *meta,const  DomProperty *p)
 {
     // Complex types that need functions from QAbstractFormBuilder
     switch(p->kind()) {
     case DomProperty::String: {
-        const int index = meta->indexOfProperty(p->attributeName().toUtf8());
-        if (index != -1 && meta->property(index).metaType().id() == QMetaType::QKeySequence)
+        if (propertyInfo(meta, p->attributeName())->metaTypeId == QMetaType::QKeySequence)
             return QVariant::fromValue(QKeySequence(p->elementString()->text()));
     }
         break;
@@ -98,38 +151,34 @@ QVariant domPropertyToVariant(QAbstractFormBuilder *afb,const QMetaObject *meta,
     }
 
     case DomProperty::Set: {
-        const QByteArray pname = p->attributeName().toUtf8();
-        const int index = meta->indexOfProperty(pname);
-        if (index == -1) {
+        const FormBuilderPropertyInfo *info = propertyInfo(meta, p->attributeName());
+        if (info->index == -1) {
             uiLibWarning(QCoreApplication::translate("QFormBuilder", "The set-type property %1 could not be read.").arg(p->attributeName()));
             return QVariant();
         }
 
-        const QMetaEnum e = meta->property(index).enumerator();
-        Q_ASSERT(e.isFlag() == true);
-        return QVariant(e.keysToValue(p->elementSet().toUtf8()));
+        Q_ASSERT(info->enumerator.isFlag() == true);
+        return QVariant(propertyEnumValue(info, p->elementSet(), true));
     }
 
     case DomProperty::Enum: {
-        const QByteArray pname = p->attributeName().toUtf8();
-        const int index = meta->indexOfProperty(pname);
+        const FormBuilderPropertyInfo *info = propertyInfo(meta, p->attributeName());
         QString enumValue = p->elementEnum();
         // Triggers in case of objects in Designer like Spacer/Line for which properties
         // are serialized using language introspection. On preview, however, these objects are
         // emulated by hacks in the formbuilder (size policy/orientation)
         fixEnum(enumValue);
-        if (index == -1) {
+        if (info->index == -1) {
             // ### special-casing for Line (QFrame) -- fix for 4.2. Jambi hack for enumerations
             if (!qstrcmp(meta->className(), "QFrame")
-                && (pname == QByteArray("orientation"))) {
+                && (p->attributeName() == QLatin1String("orientation"))) {
                 return QVariant(enumValue == QFormBuilderStrings::instance().horizontalPostFix ? QFrame::HLine : QFrame::VLine);
             }
             uiLibWarning(QCoreApplication::translate("QFormBuilder", "The enumeration-type property %1 could not be read.").arg(p->attributeName()));
             return QVariant();
         }
 
-        const QMetaEnum e = meta->property(index).enumerator();
-        return QVariant(e.keyToValue(enumValue.toUtf8()));
+        return QVariant(propertyEnumValue(info, enumValue, false));
     }
     case DomProperty::Brush:
         return QVariant::fromValue(afb->setupBrush(p->elementBrush()));
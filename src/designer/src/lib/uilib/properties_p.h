@@ -78,6 +78,20 @@ QDESIGNER_UILIB_EXPORT DomProperty *variantToDomProperty(QAbstractFormBuilder *a
 QDESIGNER_UILIB_EXPORT QVariant domPropertyToVariant(const DomProperty *property);
 QDESIGNER_UILIB_EXPORT QVariant domPropertyToVariant(QAbstractFormBuilder *abstractFormBuilder, const QMetaObject *meta, const  DomProperty *property);
 
+// Meta data of a property looked up by name. It is cached per meta object
+// for all form builders, since the same classes occur in every form.
+struct FormBuilderPropertyInfo
+{
+    int index = -1;
+    int metaTypeId = QMetaType::UnknownType;
+    bool writable = false;
+    QMetaEnum enumerator;
+};
+
+const FormBuilderPropertyInfo *propertyInfo(const QMetaObject *meta, const QString &propertyName);
+// Cached QMetaEnum::keysToValue() or QMetaEnum::keyToValue() of the property's enumerator
+int propertyEnumValue(const FormBuilderPropertyInfo *info, const QString &keys, bool flags);
+
 // This class exists to provide meta information
 // for enumerations only.
 class QAbstractFormBuilderGadget: public QWidget
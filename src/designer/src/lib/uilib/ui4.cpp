@@ -106,96 +106,118 @@ void DomUI::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("author"), Qt::CaseInsensitive)) {
-                setElementAuthor(reader.readElementText());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("comment"), Qt::CaseInsensitive)) {
-                setElementComment(reader.readElementText());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("exportmacro"), Qt::CaseInsensitive)) {
-                setElementExportMacro(reader.readElementText());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("class"), Qt::CaseInsensitive)) {
-                setElementClass(reader.readElementText());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("widget"), Qt::CaseInsensitive)) {
-                auto *v = new DomWidget();
-                v->read(reader);
-                setElementWidget(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("layoutdefault"), Qt::CaseInsensitive)) {
-                auto *v = new DomLayoutDefault();
-                v->read(reader);
-                setElementLayoutDefault(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("layoutfunction"), Qt::CaseInsensitive)) {
-                auto *v = new DomLayoutFunction();
-                v->read(reader);
-                setElementLayoutFunction(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("pixmapfunction"), Qt::CaseInsensitive)) {
-                setElementPixmapFunction(reader.readElementText());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("customwidgets"), Qt::CaseInsensitive)) {
-                auto *v = new DomCustomWidgets();
-                v->read(reader);
-                setElementCustomWidgets(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("tabstops"), Qt::CaseInsensitive)) {
-                auto *v = new DomTabStops();
-                v->read(reader);
-                setElementTabStops(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("images"), Qt::CaseInsensitive)) {
-                qWarning("Omitting deprecated element <images>.");
-                reader.skipCurrentElement();
-                continue;
-            }
-            if (!tag.compare(QLatin1String("includes"), Qt::CaseInsensitive)) {
-                auto *v = new DomIncludes();
-                v->read(reader);
-                setElementIncludes(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("resources"), Qt::CaseInsensitive)) {
-                auto *v = new DomResources();
-                v->read(reader);
-                setElementResources(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("connections"), Qt::CaseInsensitive)) {
-                auto *v = new DomConnections();
-                v->read(reader);
-                setElementConnections(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("designerdata"), Qt::CaseInsensitive)) {
-                auto *v = new DomDesignerData();
-                v->read(reader);
-                setElementDesignerdata(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("slots"), Qt::CaseInsensitive)) {
-                auto *v = new DomSlots();
-                v->read(reader);
-                setElementSlots(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("buttongroups"), Qt::CaseInsensitive)) {
-                auto *v = new DomButtonGroups();
-                v->read(reader);
-                setElementButtonGroups(v);
-                continue;
+            switch (tag.size()) {
+            case 6:
+                if (!tag.compare(QLatin1String("author"), Qt::CaseInsensitive)) {
+                    setElementAuthor(reader.readElementText());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("widget"), Qt::CaseInsensitive)) {
+                    auto *v = new DomWidget();
+                    v->read(reader);
+                    setElementWidget(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("images"), Qt::CaseInsensitive)) {
+                    qWarning("Omitting deprecated element <images>.");
+                    reader.skipCurrentElement();
+                    continue;
+                }
+                break;
+            case 7:
+                if (!tag.compare(QLatin1String("comment"), Qt::CaseInsensitive)) {
+                    setElementComment(reader.readElementText());
+                    continue;
+                }
+                break;
+            case 11:
+                if (!tag.compare(QLatin1String("exportmacro"), Qt::CaseInsensitive)) {
+                    setElementExportMacro(reader.readElementText());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("connections"), Qt::CaseInsensitive)) {
+                    auto *v = new DomConnections();
+                    v->read(reader);
+                    setElementConnections(v);
+                    continue;
+                }
+                break;
+            case 5:
+                if (!tag.compare(QLatin1String("class"), Qt::CaseInsensitive)) {
+                    setElementClass(reader.readElementText());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("slots"), Qt::CaseInsensitive)) {
+                    auto *v = new DomSlots();
+                    v->read(reader);
+                    setElementSlots(v);
+                    continue;
+                }
+                break;
+            case 13:
+                if (!tag.compare(QLatin1String("layoutdefault"), Qt::CaseInsensitive)) {
+                    auto *v = new DomLayoutDefault();
+                    v->read(reader);
+                    setElementLayoutDefault(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("customwidgets"), Qt::CaseInsensitive)) {
+                    auto *v = new DomCustomWidgets();
+                    v->read(reader);
+                    setElementCustomWidgets(v);
+                    continue;
+                }
+                break;
+            case 14:
+                if (!tag.compare(QLatin1String("layoutfunction"), Qt::CaseInsensitive)) {
+                    auto *v = new DomLayoutFunction();
+                    v->read(reader);
+                    setElementLayoutFunction(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("pixmapfunction"), Qt::CaseInsensitive)) {
+                    setElementPixmapFunction(reader.readElementText());
+                    continue;
+                }
+                break;
+            case 8:
+                if (!tag.compare(QLatin1String("tabstops"), Qt::CaseInsensitive)) {
+                    auto *v = new DomTabStops();
+                    v->read(reader);
+                    setElementTabStops(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("includes"), Qt::CaseInsensitive)) {
+                    auto *v = new DomIncludes();
+                    v->read(reader);
+                    setElementIncludes(v);
+                    continue;
+                }
+                break;
+            case 9:
+                if (!tag.compare(QLatin1String("resources"), Qt::CaseInsensitive)) {
+                    auto *v = new DomResources();
+                    v->read(reader);
+                    setElementResources(v);
+                    continue;
+                }
+                break;
+            case 12:
+                if (!tag.compare(QLatin1String("designerdata"), Qt::CaseInsensitive)) {
+                    auto *v = new DomDesignerData();
+                    v->read(reader);
+                    setElementDesignerdata(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("buttongroups"), Qt::CaseInsensitive)) {
+                    auto *v = new DomButtonGroups();
+                    v->read(reader);
+                    setElementButtonGroups(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -593,11 +615,17 @@ void DomIncludes::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("include"), Qt::CaseInsensitive)) {
-                auto *v = new DomInclude();
-                v->read(reader);
-                m_include.append(v);
-                continue;
+            switch (tag.size()) {
+            case 7:
+                if (!tag.compare(QLatin1String("include"), Qt::CaseInsensitive)) {
+                    auto *v = new DomInclude();
+                    v->read(reader);
+                    m_include.append(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -701,11 +729,17 @@ void DomResources::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("include"), Qt::CaseInsensitive)) {
-                auto *v = new DomResource();
-                v->read(reader);
-                m_include.append(v);
-                continue;
+            switch (tag.size()) {
+            case 7:
+                if (!tag.compare(QLatin1String("include"), Qt::CaseInsensitive)) {
+                    auto *v = new DomResource();
+                    v->read(reader);
+                    m_include.append(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -804,29 +838,41 @@ void DomActionGroup::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("action"), Qt::CaseInsensitive)) {
-                auto *v = new DomAction();
-                v->read(reader);
-                m_action.append(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("actiongroup"), Qt::CaseInsensitive)) {
-                auto *v = new DomActionGroup();
-                v->read(reader);
-                m_actionGroup.append(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("property"), Qt::CaseInsensitive)) {
-                auto *v = new DomProperty();
-                v->read(reader);
-                m_property.append(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("attribute"), Qt::CaseInsensitive)) {
-                auto *v = new DomProperty();
-                v->read(reader);
-                m_attribute.append(v);
-                continue;
+            switch (tag.size()) {
+            case 6:
+                if (!tag.compare(QLatin1String("action"), Qt::CaseInsensitive)) {
+                    auto *v = new DomAction();
+                    v->read(reader);
+                    m_action.append(v);
+                    continue;
+                }
+                break;
+            case 11:
+                if (!tag.compare(QLatin1String("actiongroup"), Qt::CaseInsensitive)) {
+                    auto *v = new DomActionGroup();
+                    v->read(reader);
+                    m_actionGroup.append(v);
+                    continue;
+                }
+                break;
+            case 8:
+                if (!tag.compare(QLatin1String("property"), Qt::CaseInsensitive)) {
+                    auto *v = new DomProperty();
+                    v->read(reader);
+                    m_property.append(v);
+                    continue;
+                }
+                break;
+            case 9:
+                if (!tag.compare(QLatin1String("attribute"), Qt::CaseInsensitive)) {
+                    auto *v = new DomProperty();
+                    v->read(reader);
+                    m_attribute.append(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -913,17 +959,25 @@ void DomAction::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("property"), Qt::CaseInsensitive)) {
-                auto *v = new DomProperty();
-                v->read(reader);
-                m_property.append(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("attribute"), Qt::CaseInsensitive)) {
-                auto *v = new DomProperty();
-                v->read(reader);
-                m_attribute.append(v);
-                continue;
+            switch (tag.size()) {
+            case 8:
+                if (!tag.compare(QLatin1String("property"), Qt::CaseInsensitive)) {
+                    auto *v = new DomProperty();
+                    v->read(reader);
+                    m_property.append(v);
+                    continue;
+                }
+                break;
+            case 9:
+                if (!tag.compare(QLatin1String("attribute"), Qt::CaseInsensitive)) {
+                    auto *v = new DomProperty();
+                    v->read(reader);
+                    m_attribute.append(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -1030,17 +1084,25 @@ void DomButtonGroup::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("property"), Qt::CaseInsensitive)) {
-                auto *v = new DomProperty();
-                v->read(reader);
-                m_property.append(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("attribute"), Qt::CaseInsensitive)) {
-                auto *v = new DomProperty();
-                v->read(reader);
-                m_attribute.append(v);
-                continue;
+            switch (tag.size()) {
+            case 8:
+                if (!tag.compare(QLatin1String("property"), Qt::CaseInsensitive)) {
+                    auto *v = new DomProperty();
+                    v->read(reader);
+                    m_property.append(v);
+                    continue;
+                }
+                break;
+            case 9:
+                if (!tag.compare(QLatin1String("attribute"), Qt::CaseInsensitive)) {
+                    auto *v = new DomProperty();
+                    v->read(reader);
+                    m_attribute.append(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -1093,11 +1155,17 @@ void DomButtonGroups::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("buttongroup"), Qt::CaseInsensitive)) {
-                auto *v = new DomButtonGroup();
-                v->read(reader);
-                m_buttonGroup.append(v);
-                continue;
+            switch (tag.size()) {
+            case 11:
+                if (!tag.compare(QLatin1String("buttongroup"), Qt::CaseInsensitive)) {
+                    auto *v = new DomButtonGroup();
+                    v->read(reader);
+                    m_buttonGroup.append(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -1138,11 +1206,17 @@ void DomCustomWidgets::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("customwidget"), Qt::CaseInsensitive)) {
-                auto *v = new DomCustomWidget();
-                v->read(reader);
-                m_customWidget.append(v);
-                continue;
+            switch (tag.size()) {
+            case 12:
+                if (!tag.compare(QLatin1String("customwidget"), Qt::CaseInsensitive)) {
+                    auto *v = new DomCustomWidget();
+                    v->read(reader);
+                    m_customWidget.append(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -1231,64 +1305,84 @@ void DomCustomWidget::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("class"), Qt::CaseInsensitive)) {
-                setElementClass(reader.readElementText());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("extends"), Qt::CaseInsensitive)) {
-                setElementExtends(reader.readElementText());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("header"), Qt::CaseInsensitive)) {
-                auto *v = new DomHeader();
-                v->read(reader);
-                setElementHeader(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("sizehint"), Qt::CaseInsensitive)) {
-                auto *v = new DomSize();
-                v->read(reader);
-                setElementSizeHint(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("addpagemethod"), Qt::CaseInsensitive)) {
-                setElementAddPageMethod(reader.readElementText());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("container"), Qt::CaseInsensitive)) {
-                setElementContainer(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("sizepolicy"), Qt::CaseInsensitive)) {
-                qWarning("Omitting deprecated element <sizepolicy>.");
-                reader.skipCurrentElement();
-                continue;
-            }
-            if (!tag.compare(QLatin1String("pixmap"), Qt::CaseInsensitive)) {
-                setElementPixmap(reader.readElementText());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("script"), Qt::CaseInsensitive)) {
-                qWarning("Omitting deprecated element <script>.");
-                reader.skipCurrentElement();
-                continue;
-            }
-            if (!tag.compare(QLatin1String("properties"), Qt::CaseInsensitive)) {
-                qWarning("Omitting deprecated element <properties>.");
-                reader.skipCurrentElement();
-                continue;
-            }
-            if (!tag.compare(QLatin1String("slots"), Qt::CaseInsensitive)) {
-                auto *v = new DomSlots();
-                v->read(reader);
-                setElementSlots(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("propertyspecifications"), Qt::CaseInsensitive)) {
-                auto *v = new DomPropertySpecifications();
-                v->read(reader);
-                setElementPropertyspecifications(v);
-                continue;
+            switch (tag.size()) {
+            case 5:
+                if (!tag.compare(QLatin1String("class"), Qt::CaseInsensitive)) {
+                    setElementClass(reader.readElementText());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("slots"), Qt::CaseInsensitive)) {
+                    auto *v = new DomSlots();
+                    v->read(reader);
+                    setElementSlots(v);
+                    continue;
+                }
+                break;
+            case 7:
+                if (!tag.compare(QLatin1String("extends"), Qt::CaseInsensitive)) {
+                    setElementExtends(reader.readElementText());
+                    continue;
+                }
+                break;
+            case 6:
+                if (!tag.compare(QLatin1String("header"), Qt::CaseInsensitive)) {
+                    auto *v = new DomHeader();
+                    v->read(reader);
+                    setElementHeader(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("pixmap"), Qt::CaseInsensitive)) {
+                    setElementPixmap(reader.readElementText());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("script"), Qt::CaseInsensitive)) {
+                    qWarning("Omitting deprecated element <script>.");
+                    reader.skipCurrentElement();
+                    continue;
+                }
+                break;
+            case 8:
+                if (!tag.compare(QLatin1String("sizehint"), Qt::CaseInsensitive)) {
+                    auto *v = new DomSize();
+                    v->read(reader);
+                    setElementSizeHint(v);
+                    continue;
+                }
+                break;
+            case 13:
+                if (!tag.compare(QLatin1String("addpagemethod"), Qt::CaseInsensitive)) {
+                    setElementAddPageMethod(reader.readElementText());
+                    continue;
+                }
+                break;
+            case 9:
+                if (!tag.compare(QLatin1String("container"), Qt::CaseInsensitive)) {
+                    setElementContainer(reader.readElementText().toInt());
+                    continue;
+                }
+                break;
+            case 10:
+                if (!tag.compare(QLatin1String("sizepolicy"), Qt::CaseInsensitive)) {
+                    qWarning("Omitting deprecated element <sizepolicy>.");
+                    reader.skipCurrentElement();
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("properties"), Qt::CaseInsensitive)) {
+                    qWarning("Omitting deprecated element <properties>.");
+                    reader.skipCurrentElement();
+                    continue;
+                }
+                break;
+            case 22:
+                if (!tag.compare(QLatin1String("propertyspecifications"), Qt::CaseInsensitive)) {
+                    auto *v = new DomPropertySpecifications();
+                    v->read(reader);
+                    setElementPropertyspecifications(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -1581,9 +1675,15 @@ void DomTabStops::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("tabstop"), Qt::CaseInsensitive)) {
-                m_tabStop.append(reader.readElementText());
-                continue;
+            switch (tag.size()) {
+            case 7:
+                if (!tag.compare(QLatin1String("tabstop"), Qt::CaseInsensitive)) {
+                    m_tabStop.append(reader.readElementText());
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -1662,23 +1762,33 @@ void DomLayout::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("property"), Qt::CaseInsensitive)) {
-                auto *v = new DomProperty();
-                v->read(reader);
-                m_property.append(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("attribute"), Qt::CaseInsensitive)) {
-                auto *v = new DomProperty();
-                v->read(reader);
-                m_attribute.append(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("item"), Qt::CaseInsensitive)) {
-                auto *v = new DomLayoutItem();
-                v->read(reader);
-                m_item.append(v);
-                continue;
+            switch (tag.size()) {
+            case 8:
+                if (!tag.compare(QLatin1String("property"), Qt::CaseInsensitive)) {
+                    auto *v = new DomProperty();
+                    v->read(reader);
+                    m_property.append(v);
+                    continue;
+                }
+                break;
+            case 9:
+                if (!tag.compare(QLatin1String("attribute"), Qt::CaseInsensitive)) {
+                    auto *v = new DomProperty();
+                    v->read(reader);
+                    m_attribute.append(v);
+                    continue;
+                }
+                break;
+            case 4:
+                if (!tag.compare(QLatin1String("item"), Qt::CaseInsensitive)) {
+                    auto *v = new DomLayoutItem();
+                    v->read(reader);
+                    m_item.append(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -1798,23 +1908,29 @@ void DomLayoutItem::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("widget"), Qt::CaseInsensitive)) {
-                auto *v = new DomWidget();
-                v->read(reader);
-                setElementWidget(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("layout"), Qt::CaseInsensitive)) {
-                auto *v = new DomLayout();
-                v->read(reader);
-                setElementLayout(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("spacer"), Qt::CaseInsensitive)) {
-                auto *v = new DomSpacer();
-                v->read(reader);
-                setElementSpacer(v);
-                continue;
+            switch (tag.size()) {
+            case 6:
+                if (!tag.compare(QLatin1String("widget"), Qt::CaseInsensitive)) {
+                    auto *v = new DomWidget();
+                    v->read(reader);
+                    setElementWidget(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("layout"), Qt::CaseInsensitive)) {
+                    auto *v = new DomLayout();
+                    v->read(reader);
+                    setElementLayout(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("spacer"), Qt::CaseInsensitive)) {
+                    auto *v = new DomSpacer();
+                    v->read(reader);
+                    setElementSpacer(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -1922,11 +2038,17 @@ void DomRow::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("property"), Qt::CaseInsensitive)) {
-                auto *v = new DomProperty();
-                v->read(reader);
-                m_property.append(v);
-                continue;
+            switch (tag.size()) {
+            case 8:
+                if (!tag.compare(QLatin1String("property"), Qt::CaseInsensitive)) {
+                    auto *v = new DomProperty();
+                    v->read(reader);
+                    m_property.append(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -1967,11 +2089,17 @@ void DomColumn::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("property"), Qt::CaseInsensitive)) {
-                auto *v = new DomProperty();
-                v->read(reader);
-                m_property.append(v);
-                continue;
+            switch (tag.size()) {
+            case 8:
+                if (!tag.compare(QLatin1String("property"), Qt::CaseInsensitive)) {
+                    auto *v = new DomProperty();
+                    v->read(reader);
+                    m_property.append(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -2028,17 +2156,25 @@ void DomItem::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("property"), Qt::CaseInsensitive)) {
-                auto *v = new DomProperty();
-                v->read(reader);
-                m_property.append(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("item"), Qt::CaseInsensitive)) {
-                auto *v = new DomItem();
-                v->read(reader);
-                m_item.append(v);
-                continue;
+            switch (tag.size()) {
+            case 8:
+                if (!tag.compare(QLatin1String("property"), Qt::CaseInsensitive)) {
+                    auto *v = new DomProperty();
+                    v->read(reader);
+                    m_property.append(v);
+                    continue;
+                }
+                break;
+            case 4:
+                if (!tag.compare(QLatin1String("item"), Qt::CaseInsensitive)) {
+                    auto *v = new DomItem();
+                    v->read(reader);
+                    m_item.append(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -2132,83 +2268,103 @@ void DomWidget::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("class"), Qt::CaseInsensitive)) {
-                m_class.append(reader.readElementText());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("property"), Qt::CaseInsensitive)) {
-                auto *v = new DomProperty();
-                v->read(reader);
-                m_property.append(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("script"), Qt::CaseInsensitive)) {
-                qWarning("Omitting deprecated element <script>.");
-                reader.skipCurrentElement();
-                continue;
-            }
-            if (!tag.compare(QLatin1String("widgetdata"), Qt::CaseInsensitive)) {
-                qWarning("Omitting deprecated element <widgetdata>.");
-                reader.skipCurrentElement();
-                continue;
-            }
-            if (!tag.compare(QLatin1String("attribute"), Qt::CaseInsensitive)) {
-                auto *v = new DomProperty();
-                v->read(reader);
-                m_attribute.append(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("row"), Qt::CaseInsensitive)) {
-                auto *v = new DomRow();
-                v->read(reader);
-                m_row.append(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("column"), Qt::CaseInsensitive)) {
-                auto *v = new DomColumn();
-                v->read(reader);
-                m_column.append(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("item"), Qt::CaseInsensitive)) {
-                auto *v = new DomItem();
-                v->read(reader);
-                m_item.append(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("layout"), Qt::CaseInsensitive)) {
-                auto *v = new DomLayout();
-                v->read(reader);
-                m_layout.append(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("widget"), Qt::CaseInsensitive)) {
-                auto *v = new DomWidget();
-                v->read(reader);
-                m_widget.append(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("action"), Qt::CaseInsensitive)) {
-                auto *v = new DomAction();
-                v->read(reader);
-                m_action.append(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("actiongroup"), Qt::CaseInsensitive)) {
-                auto *v = new DomActionGroup();
-                v->read(reader);
-                m_actionGroup.append(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("addaction"), Qt::CaseInsensitive)) {
-                auto *v = new DomActionRef();
-                v->read(reader);
-                m_addAction.append(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("zorder"), Qt::CaseInsensitive)) {
-                m_zOrder.append(reader.readElementText());
-                continue;
+            switch (tag.size()) {
+            case 5:
+                if (!tag.compare(QLatin1String("class"), Qt::CaseInsensitive)) {
+                    m_class.append(reader.readElementText());
+                    continue;
+                }
+                break;
+            case 8:
+                if (!tag.compare(QLatin1String("property"), Qt::CaseInsensitive)) {
+                    auto *v = new DomProperty();
+                    v->read(reader);
+                    m_property.append(v);
+                    continue;
+                }
+                break;
+            case 6:
+                if (!tag.compare(QLatin1String("script"), Qt::CaseInsensitive)) {
+                    qWarning("Omitting deprecated element <script>.");
+                    reader.skipCurrentElement();
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("column"), Qt::CaseInsensitive)) {
+                    auto *v = new DomColumn();
+                    v->read(reader);
+                    m_column.append(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("layout"), Qt::CaseInsensitive)) {
+                    auto *v = new DomLayout();
+                    v->read(reader);
+                    m_layout.append(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("widget"), Qt::CaseInsensitive)) {
+                    auto *v = new DomWidget();
+                    v->read(reader);
+                    m_widget.append(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("action"), Qt::CaseInsensitive)) {
+                    auto *v = new DomAction();
+                    v->read(reader);
+                    m_action.append(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("zorder"), Qt::CaseInsensitive)) {
+                    m_zOrder.append(reader.readElementText());
+                    continue;
+                }
+                break;
+            case 10:
+                if (!tag.compare(QLatin1String("widgetdata"), Qt::CaseInsensitive)) {
+                    qWarning("Omitting deprecated element <widgetdata>.");
+                    reader.skipCurrentElement();
+                    continue;
+                }
+                break;
+            case 9:
+                if (!tag.compare(QLatin1String("attribute"), Qt::CaseInsensitive)) {
+                    auto *v = new DomProperty();
+                    v->read(reader);
+                    m_attribute.append(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("addaction"), Qt::CaseInsensitive)) {
+                    auto *v = new DomActionRef();
+                    v->read(reader);
+                    m_addAction.append(v);
+                    continue;
+                }
+                break;
+            case 3:
+                if (!tag.compare(QLatin1String("row"), Qt::CaseInsensitive)) {
+                    auto *v = new DomRow();
+                    v->read(reader);
+                    m_row.append(v);
+                    continue;
+                }
+                break;
+            case 4:
+                if (!tag.compare(QLatin1String("item"), Qt::CaseInsensitive)) {
+                    auto *v = new DomItem();
+                    v->read(reader);
+                    m_item.append(v);
+                    continue;
+                }
+                break;
+            case 11:
+                if (!tag.compare(QLatin1String("actiongroup"), Qt::CaseInsensitive)) {
+                    auto *v = new DomActionGroup();
+                    v->read(reader);
+                    m_actionGroup.append(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -2367,11 +2523,17 @@ void DomSpacer::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("property"), Qt::CaseInsensitive)) {
-                auto *v = new DomProperty();
-                v->read(reader);
-                m_property.append(v);
-                continue;
+            switch (tag.size()) {
+            case 8:
+                if (!tag.compare(QLatin1String("property"), Qt::CaseInsensitive)) {
+                    auto *v = new DomProperty();
+                    v->read(reader);
+                    m_property.append(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -2421,17 +2583,27 @@ void DomColor::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("red"), Qt::CaseInsensitive)) {
-                setElementRed(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("green"), Qt::CaseInsensitive)) {
-                setElementGreen(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("blue"), Qt::CaseInsensitive)) {
-                setElementBlue(reader.readElementText().toInt());
-                continue;
+            switch (tag.size()) {
+            case 3:
+                if (!tag.compare(QLatin1String("red"), Qt::CaseInsensitive)) {
+                    setElementRed(reader.readElementText().toInt());
+                    continue;
+                }
+                break;
+            case 5:
+                if (!tag.compare(QLatin1String("green"), Qt::CaseInsensitive)) {
+                    setElementGreen(reader.readElementText().toInt());
+                    continue;
+                }
+                break;
+            case 4:
+                if (!tag.compare(QLatin1String("blue"), Qt::CaseInsensitive)) {
+                    setElementBlue(reader.readElementText().toInt());
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -2517,11 +2689,17 @@ void DomGradientStop::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("color"), Qt::CaseInsensitive)) {
-                auto *v = new DomColor();
-                v->read(reader);
-                setElementColor(v);
-                continue;
+            switch (tag.size()) {
+            case 5:
+                if (!tag.compare(QLatin1String("color"), Qt::CaseInsensitive)) {
+                    auto *v = new DomColor();
+                    v->read(reader);
+                    setElementColor(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -2639,11 +2817,17 @@ void DomGradient::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("gradientstop"), Qt::CaseInsensitive)) {
-                auto *v = new DomGradientStop();
-                v->read(reader);
-                m_gradientStop.append(v);
-                continue;
+            switch (tag.size()) {
+            case 12:
+                if (!tag.compare(QLatin1String("gradientstop"), Qt::CaseInsensitive)) {
+                    auto *v = new DomGradientStop();
+                    v->read(reader);
+                    m_gradientStop.append(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -2747,23 +2931,33 @@ void DomBrush::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("color"), Qt::CaseInsensitive)) {
-                auto *v = new DomColor();
-                v->read(reader);
-                setElementColor(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("texture"), Qt::CaseInsensitive)) {
-                auto *v = new DomProperty();
-                v->read(reader);
-                setElementTexture(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("gradient"), Qt::CaseInsensitive)) {
-                auto *v = new DomGradient();
-                v->read(reader);
-                setElementGradient(v);
-                continue;
+            switch (tag.size()) {
+            case 5:
+                if (!tag.compare(QLatin1String("color"), Qt::CaseInsensitive)) {
+                    auto *v = new DomColor();
+                    v->read(reader);
+                    setElementColor(v);
+                    continue;
+                }
+                break;
+            case 7:
+                if (!tag.compare(QLatin1String("texture"), Qt::CaseInsensitive)) {
+                    auto *v = new DomProperty();
+                    v->read(reader);
+                    setElementTexture(v);
+                    continue;
+                }
+                break;
+            case 8:
+                if (!tag.compare(QLatin1String("gradient"), Qt::CaseInsensitive)) {
+                    auto *v = new DomGradient();
+                    v->read(reader);
+                    setElementGradient(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -2868,11 +3062,17 @@ void DomColorRole::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("brush"), Qt::CaseInsensitive)) {
-                auto *v = new DomBrush();
-                v->read(reader);
-                setElementBrush(v);
-                continue;
+            switch (tag.size()) {
+            case 5:
+                if (!tag.compare(QLatin1String("brush"), Qt::CaseInsensitive)) {
+                    auto *v = new DomBrush();
+                    v->read(reader);
+                    setElementBrush(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -2934,17 +3134,25 @@ void DomColorGroup::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("colorrole"), Qt::CaseInsensitive)) {
-                auto *v = new DomColorRole();
-                v->read(reader);
-                m_colorRole.append(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("color"), Qt::CaseInsensitive)) {
-                auto *v = new DomColor();
-                v->read(reader);
-                m_color.append(v);
-                continue;
+            switch (tag.size()) {
+            case 9:
+                if (!tag.compare(QLatin1String("colorrole"), Qt::CaseInsensitive)) {
+                    auto *v = new DomColorRole();
+                    v->read(reader);
+                    m_colorRole.append(v);
+                    continue;
+                }
+                break;
+            case 5:
+                if (!tag.compare(QLatin1String("color"), Qt::CaseInsensitive)) {
+                    auto *v = new DomColor();
+                    v->read(reader);
+                    m_color.append(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -2995,23 +3203,31 @@ void DomPalette::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("active"), Qt::CaseInsensitive)) {
-                auto *v = new DomColorGroup();
-                v->read(reader);
-                setElementActive(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("inactive"), Qt::CaseInsensitive)) {
-                auto *v = new DomColorGroup();
-                v->read(reader);
-                setElementInactive(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("disabled"), Qt::CaseInsensitive)) {
-                auto *v = new DomColorGroup();
-                v->read(reader);
-                setElementDisabled(v);
-                continue;
+            switch (tag.size()) {
+            case 6:
+                if (!tag.compare(QLatin1String("active"), Qt::CaseInsensitive)) {
+                    auto *v = new DomColorGroup();
+                    v->read(reader);
+                    setElementActive(v);
+                    continue;
+                }
+                break;
+            case 8:
+                if (!tag.compare(QLatin1String("inactive"), Qt::CaseInsensitive)) {
+                    auto *v = new DomColorGroup();
+                    v->read(reader);
+                    setElementInactive(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("disabled"), Qt::CaseInsensitive)) {
+                    auto *v = new DomColorGroup();
+                    v->read(reader);
+                    setElementDisabled(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -3114,45 +3330,61 @@ void DomFont::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("family"), Qt::CaseInsensitive)) {
-                setElementFamily(reader.readElementText());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("pointsize"), Qt::CaseInsensitive)) {
-                setElementPointSize(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("weight"), Qt::CaseInsensitive)) {
-                setElementWeight(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("italic"), Qt::CaseInsensitive)) {
-                setElementItalic(reader.readElementText() == QLatin1String("true"));
-                continue;
-            }
-            if (!tag.compare(QLatin1String("bold"), Qt::CaseInsensitive)) {
-                setElementBold(reader.readElementText() == QLatin1String("true"));
-                continue;
-            }
-            if (!tag.compare(QLatin1String("underline"), Qt::CaseInsensitive)) {
-                setElementUnderline(reader.readElementText() == QLatin1String("true"));
-                continue;
-            }
-            if (!tag.compare(QLatin1String("strikeout"), Qt::CaseInsensitive)) {
-                setElementStrikeOut(reader.readElementText() == QLatin1String("true"));
-                continue;
-            }
-            if (!tag.compare(QLatin1String("antialiasing"), Qt::CaseInsensitive)) {
-                setElementAntialiasing(reader.readElementText() == QLatin1String("true"));
-                continue;
-            }
-            if (!tag.compare(QLatin1String("stylestrategy"), Qt::CaseInsensitive)) {
-                setElementStyleStrategy(reader.readElementText());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("kerning"), Qt::CaseInsensitive)) {
-                setElementKerning(reader.readElementText() == QLatin1String("true"));
-                continue;
+            switch (tag.size()) {
+            case 6:
+                if (!tag.compare(QLatin1String("family"), Qt::CaseInsensitive)) {
+                    setElementFamily(reader.readElementText());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("weight"), Qt::CaseInsensitive)) {
+                    setElementWeight(reader.readElementText().toInt());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("italic"), Qt::CaseInsensitive)) {
+                    setElementItalic(reader.readElementText() == QLatin1String("true"));
+                    continue;
+                }
+                break;
+            case 9:
+                if (!tag.compare(QLatin1String("pointsize"), Qt::CaseInsensitive)) {
+                    setElementPointSize(reader.readElementText().toInt());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("underline"), Qt::CaseInsensitive)) {
+                    setElementUnderline(reader.readElementText() == QLatin1String("true"));
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("strikeout"), Qt::CaseInsensitive)) {
+                    setElementStrikeOut(reader.readElementText() == QLatin1String("true"));
+                    continue;
+                }
+                break;
+            case 4:
+                if (!tag.compare(QLatin1String("bold"), Qt::CaseInsensitive)) {
+                    setElementBold(reader.readElementText() == QLatin1String("true"));
+                    continue;
+                }
+                break;
+            case 12:
+                if (!tag.compare(QLatin1String("antialiasing"), Qt::CaseInsensitive)) {
+                    setElementAntialiasing(reader.readElementText() == QLatin1String("true"));
+                    continue;
+                }
+                break;
+            case 13:
+                if (!tag.compare(QLatin1String("stylestrategy"), Qt::CaseInsensitive)) {
+                    setElementStyleStrategy(reader.readElementText());
+                    continue;
+                }
+                break;
+            case 7:
+                if (!tag.compare(QLatin1String("kerning"), Qt::CaseInsensitive)) {
+                    setElementKerning(reader.readElementText() == QLatin1String("true"));
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -3320,13 +3552,19 @@ void DomPoint::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("x"), Qt::CaseInsensitive)) {
-                setElementX(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("y"), Qt::CaseInsensitive)) {
-                setElementY(reader.readElementText().toInt());
-                continue;
+            switch (tag.size()) {
+            case 1:
+                if (!tag.compare(QLatin1String("x"), Qt::CaseInsensitive)) {
+                    setElementX(reader.readElementText().toInt());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("y"), Qt::CaseInsensitive)) {
+                    setElementY(reader.readElementText().toInt());
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -3382,21 +3620,31 @@ void DomRect::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("x"), Qt::CaseInsensitive)) {
-                setElementX(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("y"), Qt::CaseInsensitive)) {
-                setElementY(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("width"), Qt::CaseInsensitive)) {
-                setElementWidth(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("height"), Qt::CaseInsensitive)) {
-                setElementHeight(reader.readElementText().toInt());
-                continue;
+            switch (tag.size()) {
+            case 1:
+                if (!tag.compare(QLatin1String("x"), Qt::CaseInsensitive)) {
+                    setElementX(reader.readElementText().toInt());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("y"), Qt::CaseInsensitive)) {
+                    setElementY(reader.readElementText().toInt());
+                    continue;
+                }
+                break;
+            case 5:
+                if (!tag.compare(QLatin1String("width"), Qt::CaseInsensitive)) {
+                    setElementWidth(reader.readElementText().toInt());
+                    continue;
+                }
+                break;
+            case 6:
+                if (!tag.compare(QLatin1String("height"), Qt::CaseInsensitive)) {
+                    setElementHeight(reader.readElementText().toInt());
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -3540,21 +3788,29 @@ void DomSizePolicy::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("hsizetype"), Qt::CaseInsensitive)) {
-                setElementHSizeType(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("vsizetype"), Qt::CaseInsensitive)) {
-                setElementVSizeType(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("horstretch"), Qt::CaseInsensitive)) {
-                setElementHorStretch(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("verstretch"), Qt::CaseInsensitive)) {
-                setElementVerStretch(reader.readElementText().toInt());
-                continue;
+            switch (tag.size()) {
+            case 9:
+                if (!tag.compare(QLatin1String("hsizetype"), Qt::CaseInsensitive)) {
+                    setElementHSizeType(reader.readElementText().toInt());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("vsizetype"), Qt::CaseInsensitive)) {
+                    setElementVSizeType(reader.readElementText().toInt());
+                    continue;
+                }
+                break;
+            case 10:
+                if (!tag.compare(QLatin1String("horstretch"), Qt::CaseInsensitive)) {
+                    setElementHorStretch(reader.readElementText().toInt());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("verstretch"), Qt::CaseInsensitive)) {
+                    setElementVerStretch(reader.readElementText().toInt());
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -3644,13 +3900,21 @@ void DomSize::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("width"), Qt::CaseInsensitive)) {
-                setElementWidth(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("height"), Qt::CaseInsensitive)) {
-                setElementHeight(reader.readElementText().toInt());
-                continue;
+            switch (tag.size()) {
+            case 5:
+                if (!tag.compare(QLatin1String("width"), Qt::CaseInsensitive)) {
+                    setElementWidth(reader.readElementText().toInt());
+                    continue;
+                }
+                break;
+            case 6:
+                if (!tag.compare(QLatin1String("height"), Qt::CaseInsensitive)) {
+                    setElementHeight(reader.readElementText().toInt());
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -3706,17 +3970,27 @@ void DomDate::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("year"), Qt::CaseInsensitive)) {
-                setElementYear(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("month"), Qt::CaseInsensitive)) {
-                setElementMonth(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("day"), Qt::CaseInsensitive)) {
-                setElementDay(reader.readElementText().toInt());
-                continue;
+            switch (tag.size()) {
+            case 4:
+                if (!tag.compare(QLatin1String("year"), Qt::CaseInsensitive)) {
+                    setElementYear(reader.readElementText().toInt());
+                    continue;
+                }
+                break;
+            case 5:
+                if (!tag.compare(QLatin1String("month"), Qt::CaseInsensitive)) {
+                    setElementMonth(reader.readElementText().toInt());
+                    continue;
+                }
+                break;
+            case 3:
+                if (!tag.compare(QLatin1String("day"), Qt::CaseInsensitive)) {
+                    setElementDay(reader.readElementText().toInt());
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -3786,17 +4060,25 @@ void DomTime::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("hour"), Qt::CaseInsensitive)) {
-                setElementHour(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("minute"), Qt::CaseInsensitive)) {
-                setElementMinute(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("second"), Qt::CaseInsensitive)) {
-                setElementSecond(reader.readElementText().toInt());
-                continue;
+            switch (tag.size()) {
+            case 4:
+                if (!tag.compare(QLatin1String("hour"), Qt::CaseInsensitive)) {
+                    setElementHour(reader.readElementText().toInt());
+                    continue;
+                }
+                break;
+            case 6:
+                if (!tag.compare(QLatin1String("minute"), Qt::CaseInsensitive)) {
+                    setElementMinute(reader.readElementText().toInt());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("second"), Qt::CaseInsensitive)) {
+                    setElementSecond(reader.readElementText().toInt());
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -3866,29 +4148,41 @@ void DomDateTime::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("hour"), Qt::CaseInsensitive)) {
-                setElementHour(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("minute"), Qt::CaseInsensitive)) {
-                setElementMinute(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("second"), Qt::CaseInsensitive)) {
-                setElementSecond(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("year"), Qt::CaseInsensitive)) {
-                setElementYear(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("month"), Qt::CaseInsensitive)) {
-                setElementMonth(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("day"), Qt::CaseInsensitive)) {
-                setElementDay(reader.readElementText().toInt());
-                continue;
+            switch (tag.size()) {
+            case 4:
+                if (!tag.compare(QLatin1String("hour"), Qt::CaseInsensitive)) {
+                    setElementHour(reader.readElementText().toInt());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("year"), Qt::CaseInsensitive)) {
+                    setElementYear(reader.readElementText().toInt());
+                    continue;
+                }
+                break;
+            case 6:
+                if (!tag.compare(QLatin1String("minute"), Qt::CaseInsensitive)) {
+                    setElementMinute(reader.readElementText().toInt());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("second"), Qt::CaseInsensitive)) {
+                    setElementSecond(reader.readElementText().toInt());
+                    continue;
+                }
+                break;
+            case 5:
+                if (!tag.compare(QLatin1String("month"), Qt::CaseInsensitive)) {
+                    setElementMonth(reader.readElementText().toInt());
+                    continue;
+                }
+                break;
+            case 3:
+                if (!tag.compare(QLatin1String("day"), Qt::CaseInsensitive)) {
+                    setElementDay(reader.readElementText().toInt());
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -4025,9 +4319,15 @@ void DomStringList::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("string"), Qt::CaseInsensitive)) {
-                m_string.append(reader.readElementText());
-                continue;
+            switch (tag.size()) {
+            case 6:
+                if (!tag.compare(QLatin1String("string"), Qt::CaseInsensitive)) {
+                    m_string.append(reader.readElementText());
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -4153,53 +4453,65 @@ void DomResourceIcon::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("normaloff"), Qt::CaseInsensitive)) {
-                auto *v = new DomResourcePixmap();
-                v->read(reader);
-                setElementNormalOff(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("normalon"), Qt::CaseInsensitive)) {
-                auto *v = new DomResourcePixmap();
-                v->read(reader);
-                setElementNormalOn(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("disabledoff"), Qt::CaseInsensitive)) {
-                auto *v = new DomResourcePixmap();
-                v->read(reader);
-                setElementDisabledOff(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("disabledon"), Qt::CaseInsensitive)) {
-                auto *v = new DomResourcePixmap();
-                v->read(reader);
-                setElementDisabledOn(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("activeoff"), Qt::CaseInsensitive)) {
-                auto *v = new DomResourcePixmap();
-                v->read(reader);
-                setElementActiveOff(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("activeon"), Qt::CaseInsensitive)) {
-                auto *v = new DomResourcePixmap();
-                v->read(reader);
-                setElementActiveOn(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("selectedoff"), Qt::CaseInsensitive)) {
-                auto *v = new DomResourcePixmap();
-                v->read(reader);
-                setElementSelectedOff(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("selectedon"), Qt::CaseInsensitive)) {
-                auto *v = new DomResourcePixmap();
-                v->read(reader);
-                setElementSelectedOn(v);
-                continue;
+            switch (tag.size()) {
+            case 9:
+                if (!tag.compare(QLatin1String("normaloff"), Qt::CaseInsensitive)) {
+                    auto *v = new DomResourcePixmap();
+                    v->read(reader);
+                    setElementNormalOff(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("activeoff"), Qt::CaseInsensitive)) {
+                    auto *v = new DomResourcePixmap();
+                    v->read(reader);
+                    setElementActiveOff(v);
+                    continue;
+                }
+                break;
+            case 8:
+                if (!tag.compare(QLatin1String("normalon"), Qt::CaseInsensitive)) {
+                    auto *v = new DomResourcePixmap();
+                    v->read(reader);
+                    setElementNormalOn(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("activeon"), Qt::CaseInsensitive)) {
+                    auto *v = new DomResourcePixmap();
+                    v->read(reader);
+                    setElementActiveOn(v);
+                    continue;
+                }
+                break;
+            case 11:
+                if (!tag.compare(QLatin1String("disabledoff"), Qt::CaseInsensitive)) {
+                    auto *v = new DomResourcePixmap();
+                    v->read(reader);
+                    setElementDisabledOff(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("selectedoff"), Qt::CaseInsensitive)) {
+                    auto *v = new DomResourcePixmap();
+                    v->read(reader);
+                    setElementSelectedOff(v);
+                    continue;
+                }
+                break;
+            case 10:
+                if (!tag.compare(QLatin1String("disabledon"), Qt::CaseInsensitive)) {
+                    auto *v = new DomResourcePixmap();
+                    v->read(reader);
+                    setElementDisabledOn(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("selectedon"), Qt::CaseInsensitive)) {
+                    auto *v = new DomResourcePixmap();
+                    v->read(reader);
+                    setElementSelectedOn(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -4507,13 +4819,19 @@ void DomPointF::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("x"), Qt::CaseInsensitive)) {
-                setElementX(reader.readElementText().toDouble());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("y"), Qt::CaseInsensitive)) {
-                setElementY(reader.readElementText().toDouble());
-                continue;
+            switch (tag.size()) {
+            case 1:
+                if (!tag.compare(QLatin1String("x"), Qt::CaseInsensitive)) {
+                    setElementX(reader.readElementText().toDouble());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("y"), Qt::CaseInsensitive)) {
+                    setElementY(reader.readElementText().toDouble());
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -4569,21 +4887,31 @@ void DomRectF::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("x"), Qt::CaseInsensitive)) {
-                setElementX(reader.readElementText().toDouble());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("y"), Qt::CaseInsensitive)) {
-                setElementY(reader.readElementText().toDouble());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("width"), Qt::CaseInsensitive)) {
-                setElementWidth(reader.readElementText().toDouble());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("height"), Qt::CaseInsensitive)) {
-                setElementHeight(reader.readElementText().toDouble());
-                continue;
+            switch (tag.size()) {
+            case 1:
+                if (!tag.compare(QLatin1String("x"), Qt::CaseInsensitive)) {
+                    setElementX(reader.readElementText().toDouble());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("y"), Qt::CaseInsensitive)) {
+                    setElementY(reader.readElementText().toDouble());
+                    continue;
+                }
+                break;
+            case 5:
+                if (!tag.compare(QLatin1String("width"), Qt::CaseInsensitive)) {
+                    setElementWidth(reader.readElementText().toDouble());
+                    continue;
+                }
+                break;
+            case 6:
+                if (!tag.compare(QLatin1String("height"), Qt::CaseInsensitive)) {
+                    setElementHeight(reader.readElementText().toDouble());
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -4667,13 +4995,21 @@ void DomSizeF::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("width"), Qt::CaseInsensitive)) {
-                setElementWidth(reader.readElementText().toDouble());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("height"), Qt::CaseInsensitive)) {
-                setElementHeight(reader.readElementText().toDouble());
-                continue;
+            switch (tag.size()) {
+            case 5:
+                if (!tag.compare(QLatin1String("width"), Qt::CaseInsensitive)) {
+                    setElementWidth(reader.readElementText().toDouble());
+                    continue;
+                }
+                break;
+            case 6:
+                if (!tag.compare(QLatin1String("height"), Qt::CaseInsensitive)) {
+                    setElementHeight(reader.readElementText().toDouble());
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -4729,9 +5065,15 @@ void DomChar::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("unicode"), Qt::CaseInsensitive)) {
-                setElementUnicode(reader.readElementText().toInt());
-                continue;
+            switch (tag.size()) {
+            case 7:
+                if (!tag.compare(QLatin1String("unicode"), Qt::CaseInsensitive)) {
+                    setElementUnicode(reader.readElementText().toInt());
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -4776,11 +5118,17 @@ void DomUrl::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("string"), Qt::CaseInsensitive)) {
-                auto *v = new DomString();
-                v->read(reader);
-                setElementString(v);
-                continue;
+            switch (tag.size()) {
+            case 6:
+                if (!tag.compare(QLatin1String("string"), Qt::CaseInsensitive)) {
+                    auto *v = new DomString();
+                    v->read(reader);
+                    setElementString(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -4926,179 +5274,201 @@ void DomProperty::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("bool"), Qt::CaseInsensitive)) {
-                setElementBool(reader.readElementText());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("color"), Qt::CaseInsensitive)) {
-                auto *v = new DomColor();
-                v->read(reader);
-                setElementColor(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("cstring"), Qt::CaseInsensitive)) {
-                setElementCstring(reader.readElementText());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("cursor"), Qt::CaseInsensitive)) {
-                setElementCursor(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("cursorshape"), Qt::CaseInsensitive)) {
-                setElementCursorShape(reader.readElementText());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("enum"), Qt::CaseInsensitive)) {
-                setElementEnum(reader.readElementText());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("font"), Qt::CaseInsensitive)) {
-                auto *v = new DomFont();
-                v->read(reader);
-                setElementFont(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("iconset"), Qt::CaseInsensitive)) {
-                auto *v = new DomResourceIcon();
-                v->read(reader);
-                setElementIconSet(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("pixmap"), Qt::CaseInsensitive)) {
-                auto *v = new DomResourcePixmap();
-                v->read(reader);
-                setElementPixmap(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("palette"), Qt::CaseInsensitive)) {
-                auto *v = new DomPalette();
-                v->read(reader);
-                setElementPalette(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("point"), Qt::CaseInsensitive)) {
-                auto *v = new DomPoint();
-                v->read(reader);
-                setElementPoint(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("rect"), Qt::CaseInsensitive)) {
-                auto *v = new DomRect();
-                v->read(reader);
-                setElementRect(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("set"), Qt::CaseInsensitive)) {
-                setElementSet(reader.readElementText());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("locale"), Qt::CaseInsensitive)) {
-                auto *v = new DomLocale();
-                v->read(reader);
-                setElementLocale(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("sizepolicy"), Qt::CaseInsensitive)) {
-                auto *v = new DomSizePolicy();
-                v->read(reader);
-                setElementSizePolicy(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("size"), Qt::CaseInsensitive)) {
-                auto *v = new DomSize();
-                v->read(reader);
-                setElementSize(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("string"), Qt::CaseInsensitive)) {
-                auto *v = new DomString();
-                v->read(reader);
-                setElementString(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("stringlist"), Qt::CaseInsensitive)) {
-                auto *v = new DomStringList();
-                v->read(reader);
-                setElementStringList(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("number"), Qt::CaseInsensitive)) {
-                setElementNumber(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("float"), Qt::CaseInsensitive)) {
-                setElementFloat(reader.readElementText().toFloat());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("double"), Qt::CaseInsensitive)) {
-                setElementDouble(reader.readElementText().toDouble());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("date"), Qt::CaseInsensitive)) {
-                auto *v = new DomDate();
-                v->read(reader);
-                setElementDate(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("time"), Qt::CaseInsensitive)) {
-                auto *v = new DomTime();
-                v->read(reader);
-                setElementTime(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("datetime"), Qt::CaseInsensitive)) {
-                auto *v = new DomDateTime();
-                v->read(reader);
-                setElementDateTime(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("pointf"), Qt::CaseInsensitive)) {
-                auto *v = new DomPointF();
-                v->read(reader);
-                setElementPointF(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("rectf"), Qt::CaseInsensitive)) {
-                auto *v = new DomRectF();
-                v->read(reader);
-                setElementRectF(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("sizef"), Qt::CaseInsensitive)) {
-                auto *v = new DomSizeF();
-                v->read(reader);
-                setElementSizeF(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("longlong"), Qt::CaseInsensitive)) {
-                setElementLongLong(reader.readElementText().toLongLong());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("char"), Qt::CaseInsensitive)) {
-                auto *v = new DomChar();
-                v->read(reader);
-                setElementChar(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("url"), Qt::CaseInsensitive)) {
-                auto *v = new DomUrl();
-                v->read(reader);
-                setElementUrl(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("uint"), Qt::CaseInsensitive)) {
-                setElementUInt(reader.readElementText().toUInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("ulonglong"), Qt::CaseInsensitive)) {
-                setElementULongLong(reader.readElementText().toULongLong());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("brush"), Qt::CaseInsensitive)) {
-                auto *v = new DomBrush();
-                v->read(reader);
-                setElementBrush(v);
-                continue;
+            switch (tag.size()) {
+            case 4:
+                if (!tag.compare(QLatin1String("bool"), Qt::CaseInsensitive)) {
+                    setElementBool(reader.readElementText());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("enum"), Qt::CaseInsensitive)) {
+                    setElementEnum(reader.readElementText());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("font"), Qt::CaseInsensitive)) {
+                    auto *v = new DomFont();
+                    v->read(reader);
+                    setElementFont(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("rect"), Qt::CaseInsensitive)) {
+                    auto *v = new DomRect();
+                    v->read(reader);
+                    setElementRect(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("size"), Qt::CaseInsensitive)) {
+                    auto *v = new DomSize();
+                    v->read(reader);
+                    setElementSize(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("date"), Qt::CaseInsensitive)) {
+                    auto *v = new DomDate();
+                    v->read(reader);
+                    setElementDate(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("time"), Qt::CaseInsensitive)) {
+                    auto *v = new DomTime();
+                    v->read(reader);
+                    setElementTime(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("char"), Qt::CaseInsensitive)) {
+                    auto *v = new DomChar();
+                    v->read(reader);
+                    setElementChar(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("uint"), Qt::CaseInsensitive)) {
+                    setElementUInt(reader.readElementText().toUInt());
+                    continue;
+                }
+                break;
+            case 5:
+                if (!tag.compare(QLatin1String("color"), Qt::CaseInsensitive)) {
+                    auto *v = new DomColor();
+                    v->read(reader);
+                    setElementColor(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("point"), Qt::CaseInsensitive)) {
+                    auto *v = new DomPoint();
+                    v->read(reader);
+                    setElementPoint(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("float"), Qt::CaseInsensitive)) {
+                    setElementFloat(reader.readElementText().toFloat());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("rectf"), Qt::CaseInsensitive)) {
+                    auto *v = new DomRectF();
+                    v->read(reader);
+                    setElementRectF(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("sizef"), Qt::CaseInsensitive)) {
+                    auto *v = new DomSizeF();
+                    v->read(reader);
+                    setElementSizeF(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("brush"), Qt::CaseInsensitive)) {
+                    auto *v = new DomBrush();
+                    v->read(reader);
+                    setElementBrush(v);
+                    continue;
+                }
+                break;
+            case 7:
+                if (!tag.compare(QLatin1String("cstring"), Qt::CaseInsensitive)) {
+                    setElementCstring(reader.readElementText());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("iconset"), Qt::CaseInsensitive)) {
+                    auto *v = new DomResourceIcon();
+                    v->read(reader);
+                    setElementIconSet(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("palette"), Qt::CaseInsensitive)) {
+                    auto *v = new DomPalette();
+                    v->read(reader);
+                    setElementPalette(v);
+                    continue;
+                }
+                break;
+            case 6:
+                if (!tag.compare(QLatin1String("cursor"), Qt::CaseInsensitive)) {
+                    setElementCursor(reader.readElementText().toInt());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("pixmap"), Qt::CaseInsensitive)) {
+                    auto *v = new DomResourcePixmap();
+                    v->read(reader);
+                    setElementPixmap(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("locale"), Qt::CaseInsensitive)) {
+                    auto *v = new DomLocale();
+                    v->read(reader);
+                    setElementLocale(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("string"), Qt::CaseInsensitive)) {
+                    auto *v = new DomString();
+                    v->read(reader);
+                    setElementString(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("number"), Qt::CaseInsensitive)) {
+                    setElementNumber(reader.readElementText().toInt());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("double"), Qt::CaseInsensitive)) {
+                    setElementDouble(reader.readElementText().toDouble());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("pointf"), Qt::CaseInsensitive)) {
+                    auto *v = new DomPointF();
+                    v->read(reader);
+                    setElementPointF(v);
+                    continue;
+                }
+                break;
+            case 11:
+                if (!tag.compare(QLatin1String("cursorshape"), Qt::CaseInsensitive)) {
+                    setElementCursorShape(reader.readElementText());
+                    continue;
+                }
+                break;
+            case 3:
+                if (!tag.compare(QLatin1String("set"), Qt::CaseInsensitive)) {
+                    setElementSet(reader.readElementText());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("url"), Qt::CaseInsensitive)) {
+                    auto *v = new DomUrl();
+                    v->read(reader);
+                    setElementUrl(v);
+                    continue;
+                }
+                break;
+            case 10:
+                if (!tag.compare(QLatin1String("sizepolicy"), Qt::CaseInsensitive)) {
+                    auto *v = new DomSizePolicy();
+                    v->read(reader);
+                    setElementSizePolicy(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("stringlist"), Qt::CaseInsensitive)) {
+                    auto *v = new DomStringList();
+                    v->read(reader);
+                    setElementStringList(v);
+                    continue;
+                }
+                break;
+            case 8:
+                if (!tag.compare(QLatin1String("datetime"), Qt::CaseInsensitive)) {
+                    auto *v = new DomDateTime();
+                    v->read(reader);
+                    setElementDateTime(v);
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("longlong"), Qt::CaseInsensitive)) {
+                    setElementLongLong(reader.readElementText().toLongLong());
+                    continue;
+                }
+                break;
+            case 9:
+                if (!tag.compare(QLatin1String("ulonglong"), Qt::CaseInsensitive)) {
+                    setElementULongLong(reader.readElementText().toULongLong());
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -5671,11 +6041,17 @@ void DomConnections::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("connection"), Qt::CaseInsensitive)) {
-                auto *v = new DomConnection();
-                v->read(reader);
-                m_connection.append(v);
-                continue;
+            switch (tag.size()) {
+            case 10:
+                if (!tag.compare(QLatin1String("connection"), Qt::CaseInsensitive)) {
+                    auto *v = new DomConnection();
+                    v->read(reader);
+                    m_connection.append(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -5715,27 +6091,39 @@ void DomConnection::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("sender"), Qt::CaseInsensitive)) {
-                setElementSender(reader.readElementText());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("signal"), Qt::CaseInsensitive)) {
-                setElementSignal(reader.readElementText());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("receiver"), Qt::CaseInsensitive)) {
-                setElementReceiver(reader.readElementText());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("slot"), Qt::CaseInsensitive)) {
-                setElementSlot(reader.readElementText());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("hints"), Qt::CaseInsensitive)) {
-                auto *v = new DomConnectionHints();
-                v->read(reader);
-                setElementHints(v);
-                continue;
+            switch (tag.size()) {
+            case 6:
+                if (!tag.compare(QLatin1String("sender"), Qt::CaseInsensitive)) {
+                    setElementSender(reader.readElementText());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("signal"), Qt::CaseInsensitive)) {
+                    setElementSignal(reader.readElementText());
+                    continue;
+                }
+                break;
+            case 8:
+                if (!tag.compare(QLatin1String("receiver"), Qt::CaseInsensitive)) {
+                    setElementReceiver(reader.readElementText());
+                    continue;
+                }
+                break;
+            case 4:
+                if (!tag.compare(QLatin1String("slot"), Qt::CaseInsensitive)) {
+                    setElementSlot(reader.readElementText());
+                    continue;
+                }
+                break;
+            case 5:
+                if (!tag.compare(QLatin1String("hints"), Qt::CaseInsensitive)) {
+                    auto *v = new DomConnectionHints();
+                    v->read(reader);
+                    setElementHints(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -5848,11 +6236,17 @@ void DomConnectionHints::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("hint"), Qt::CaseInsensitive)) {
-                auto *v = new DomConnectionHint();
-                v->read(reader);
-                m_hint.append(v);
-                continue;
+            switch (tag.size()) {
+            case 4:
+                if (!tag.compare(QLatin1String("hint"), Qt::CaseInsensitive)) {
+                    auto *v = new DomConnectionHint();
+                    v->read(reader);
+                    m_hint.append(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -5899,13 +6293,19 @@ void DomConnectionHint::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("x"), Qt::CaseInsensitive)) {
-                setElementX(reader.readElementText().toInt());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("y"), Qt::CaseInsensitive)) {
-                setElementY(reader.readElementText().toInt());
-                continue;
+            switch (tag.size()) {
+            case 1:
+                if (!tag.compare(QLatin1String("x"), Qt::CaseInsensitive)) {
+                    setElementX(reader.readElementText().toInt());
+                    continue;
+                }
+                if (!tag.compare(QLatin1String("y"), Qt::CaseInsensitive)) {
+                    setElementY(reader.readElementText().toInt());
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -5968,11 +6368,17 @@ void DomDesignerData::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("property"), Qt::CaseInsensitive)) {
-                auto *v = new DomProperty();
-                v->read(reader);
-                m_property.append(v);
-                continue;
+            switch (tag.size()) {
+            case 8:
+                if (!tag.compare(QLatin1String("property"), Qt::CaseInsensitive)) {
+                    auto *v = new DomProperty();
+                    v->read(reader);
+                    m_property.append(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -6013,13 +6419,21 @@ void DomSlots::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("signal"), Qt::CaseInsensitive)) {
-                m_signal.append(reader.readElementText());
-                continue;
-            }
-            if (!tag.compare(QLatin1String("slot"), Qt::CaseInsensitive)) {
-                m_slot.append(reader.readElementText());
-                continue;
+            switch (tag.size()) {
+            case 6:
+                if (!tag.compare(QLatin1String("signal"), Qt::CaseInsensitive)) {
+                    m_signal.append(reader.readElementText());
+                    continue;
+                }
+                break;
+            case 4:
+                if (!tag.compare(QLatin1String("slot"), Qt::CaseInsensitive)) {
+                    m_slot.append(reader.readElementText());
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
@@ -6071,17 +6485,25 @@ void DomPropertySpecifications::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(QLatin1String("tooltip"), Qt::CaseInsensitive)) {
-                auto *v = new DomPropertyToolTip();
-                v->read(reader);
-                m_tooltip.append(v);
-                continue;
-            }
-            if (!tag.compare(QLatin1String("stringpropertyspecification"), Qt::CaseInsensitive)) {
-                auto *v = new DomStringPropertySpecification();
-                v->read(reader);
-                m_stringpropertyspecification.append(v);
-                continue;
+            switch (tag.size()) {
+            case 7:
+                if (!tag.compare(QLatin1String("tooltip"), Qt::CaseInsensitive)) {
+                    auto *v = new DomPropertyToolTip();
+                    v->read(reader);
+                    m_tooltip.append(v);
+                    continue;
+                }
+                break;
+            case 27:
+                if (!tag.compare(QLatin1String("stringpropertyspecification"), Qt::CaseInsensitive)) {
+                    auto *v = new DomStringPropertySpecification();
+                    v->read(reader);
+                    m_stringpropertyspecification.append(v);
+                    continue;
+                }
+                break;
+            default:
+                break;
             }
             reader.raiseError(QLatin1String("Unexpected element ") + tag);
         }
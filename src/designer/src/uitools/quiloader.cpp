@@ -354,6 +354,12 @@ public:
         return ParentClass::createActionGroup(parent, name);
     }
 
+    // Names of the custom widget classes without loading deferred plugins
+    QStringList customWidgetClassNames() const
+    {
+        return d->m_customWidgets.keys() + d->m_deferredCustomWidgets.keys();
+    }
+
     QWidget *createWidget(const QString &className, QWidget *parent, const QString &name) override
     {
         if (QWidget *widget = loader->createWidget(className, parent, name)) {
@@ -394,6 +400,9 @@ public:
         return nullptr;
     }
 
+    DomUI *readUi(QIODevice *dev) { return d->readUi(dev); }
+    QWidget *loadPrepared(DomUI *ui, QWidget *parentWidget);
+
     void applyProperties(QObject *o, const QList<DomProperty*> &properties) override;
     QWidget *create(DomUI *ui, QWidget *parentWidget) override;
     QWidget *create(DomWidget *ui_widget, QWidget *parentWidget) override;
@@ -456,6 +465,16 @@ void FormBuilderPrivate::applyProperties(QObject *o, const QList<DomProperty*> &
         o->installEventFilter(m_trwatch);
 }
 
+// Instantiates a form read before by readUi(), like load() does
+QWidget *FormBuilderPrivate::loadPrepared(DomUI *ui, QWidget *parentWidget)
+{
+    d->m_errorString.clear();
+    QWidget *widget = create(ui, parentWidget);
+    if (!widget && d->m_errorString.isEmpty())
+        d->m_errorString = QFormBuilderExtra::msgInvalidUiFile();
+    return widget;
+}
+
 QWidget *FormBuilderPrivate::create(DomUI *ui, QWidget *parentWidget)
 {
     m_class = ui->elementClass().toUtf8();
@@ -559,6 +578,18 @@ bool FormBuilderPrivate::addItem(DomWidget *ui_widget, QWidget *widget, QWidget
 }
 #endif
 
+class QUiPreparedFormPrivate
+{
+public:
+    // Never modified once read, so that any number of widgets can be
+    // created from it.
+#ifdef QFORMINTERNAL_NAMESPACE
+    QScopedPointer<QFormInternal::DomUI> ui;
+#else
+    QScopedPointer<DomUI> ui;
+#endif
+};
+
 class QUiLoaderPrivate
 {
 public:
@@ -691,6 +722,51 @@ QWidget *QUiLoader::load(QIODevice *device, QWidget *parentWidget)
     return d->builder.load(device, parentWidget);
 }
 
+/*!
+    \since 6.3
+
+    Reads a form from the given \a device without creating any widgets.
+    The returned form can be passed to load() any number of times, which
+    saves parsing the XML again for forms that are instantiated often,
+    such as the editors of item delegates.
+
+    Returns a null form if the device does not contain a valid form.
+
+    \sa load(), errorString()
+*/
+QUiPreparedForm QUiLoader::prepare(QIODevice *device)
+{
+    Q_D(QUiLoader);
+    // QXmlStreamReader will report errors on open failure.
+    if (!device->isOpen())
+        device->open(QIODevice::ReadOnly|QIODevice::Text);
+    QUiPreparedForm form;
+    if (auto *ui = d->builder.readUi(device)) {
+        form.d.reset(new QUiPreparedFormPrivate);
+        form.d->ui.reset(ui);
+    }
+    return form;
+}
+
+/*!
+    \since 6.3
+    \overload
+
+    Creates a new widget with the given \a parentWidget from the \a form
+    read before by prepare(). The widgets are created with the current
+    settings of this loader, which need not be the loader that prepared
+    the form.
+
+    \sa prepare(), errorString()
+*/
+QWidget *QUiLoader::load(const QUiPreparedForm &form, QWidget *parentWidget)
+{
+    Q_D(QUiLoader);
+    if (form.isNull())
+        return nullptr;
+    return d->builder.loadPrepared(form.d->ui.data(), parentWidget);
+}
+
 /*!
     Returns a list naming the paths in which the loader will search when
     locating custom widget plugins.
@@ -813,9 +889,9 @@ QStringList QUiLoader::availableWidgets() const
     d->setupWidgetMap();
     widget_map available = *g_widgets();
 
-    const auto &customWidgets = d->builder.customWidgets();
-    for (QDesignerCustomWidgetInterface *plugin : customWidgets)
-        available.insert(plugin->name(), true);
+    const QStringList customWidgetClassNames = d->builder.customWidgetClassNames();
+    for (const QString &className : customWidgetClassNames)
+        available.insert(className, true);
 
     return available.keys();
 }
@@ -944,6 +1020,47 @@ QString QUiLoader::errorString() const
     return d->builder.errorString();
 }
 
+/*!
+    \class QUiPreparedForm
+    \inmodule QtUiTools
+    \since 6.3
+
+    \brief The QUiPreparedForm class holds a form that was read by QUiLoader.
+
+    A prepared form is returned by QUiLoader::prepare() and passed to
+    QUiLoader::load() to create widgets from it. Copies share the same
+    form.
+*/
+
+/*!
+    Constructs a null form.
+*/
+QUiPreparedForm::QUiPreparedForm() = default;
+
+/*!
+    Constructs a copy of \a other.
+*/
+QUiPreparedForm::QUiPreparedForm(const QUiPreparedForm &other) = default;
+
+/*!
+    Assigns \a other to this form.
+*/
+QUiPreparedForm &QUiPreparedForm::operator=(const QUiPreparedForm &other) = default;
+
+/*!
+    Destroys the form.
+*/
+QUiPreparedForm::~QUiPreparedForm() = default;
+
+/*!
+    Returns \c true if this form holds no form, for example because
+    QUiLoader::prepare() failed.
+*/
+bool QUiPreparedForm::isNull() const
+{
+    return d.isNull();
+}
+
 QT_END_NAMESPACE
 
 #include "quiloader.moc"
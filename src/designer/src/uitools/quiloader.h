@@ -43,6 +43,7 @@
 #include <QtUiTools/qtuitoolsglobal.h>
 #include <QtCore/qobject.h>
 #include <QtCore/qscopedpointer.h>
+#include <QtCore/qsharedpointer.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -54,6 +55,22 @@ class QString;
 class QIODevice;
 class QDir;
 
+class QUiPreparedFormPrivate;
+class Q_UITOOLS_EXPORT QUiPreparedForm
+{
+public:
+    QUiPreparedForm();
+    QUiPreparedForm(const QUiPreparedForm &other);
+    QUiPreparedForm &operator=(const QUiPreparedForm &other);
+    ~QUiPreparedForm();
+
+    bool isNull() const;
+
+private:
+    friend class QUiLoader;
+    QSharedPointer<QUiPreparedFormPrivate> d;
+};
+
 class QUiLoaderPrivate;
 class Q_UITOOLS_EXPORT QUiLoader : public QObject
 {
@@ -67,6 +84,8 @@ public:
     void addPluginPath(const QString &path);
 
     QWidget *load(QIODevice *device, QWidget *parentWidget = nullptr);
+    QUiPreparedForm prepare(QIODevice *device);
+    QWidget *load(const QUiPreparedForm &form, QWidget *parentWidget = nullptr);
     QStringList availableWidgets() const;
     QStringList availableLayouts() const;
 
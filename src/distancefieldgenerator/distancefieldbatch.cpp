@@ -0,0 +1,209 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "distancefieldbatch.h"
+#include "distancefieldmodelworker.h"
+#include "distancefieldwriter.h"
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qthreadpool.h>
+
+#include <cstdio>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+static QMutex outputMutex;
+
+static void printLine(const QString &line)
+{
+    QMutexLocker locker(&outputMutex);
+    fprintf(stderr, "%s\n", qPrintable(line));
+}
+
+static QString tr(const char *sourceText, const char *disambiguation = nullptr, int n = -1)
+{
+    return QCoreApplication::translate("DistanceFieldBatch", sourceText, disambiguation, n);
+}
+
+bool parseUnicodeRange(const QString &range, QPair<quint32, quint32> *result)
+{
+    auto parseCodePoint = [](QString codePoint, quint32 *ucs4) {
+        codePoint = codePoint.trimmed();
+        if (codePoint.startsWith(QLatin1String("U+"), Qt::CaseInsensitive))
+            codePoint = codePoint.mid(2);
+        bool ok;
+        *ucs4 = codePoint.toUInt(&ok, 16);
+        return ok && *ucs4 <= 0x10ffff;
+    };
+
+    const qsizetype separator = range.indexOf(QLatin1Char('-'));
+    if (separator < 0) {
+        if (!parseCodePoint(range, &result->first))
+            return false;
+        result->second = result->first;
+        return true;
+    }
+
+    return parseCodePoint(range.left(separator), &result->first)
+        && parseCodePoint(range.mid(separator + 1), &result->second)
+        && result->first <= result->second;
+}
+
+static bool isSelected(const DistanceFieldBatchOptions &options, quint32 ucs4)
+{
+    if (options.unicodeRanges.isEmpty())
+        return true;
+    if (ucs4 == 0)
+        return false;
+    for (const QPair<quint32, quint32> &range : options.unicodeRanges) {
+        if (ucs4 >= range.first && ucs4 <= range.second)
+            return true;
+    }
+    return false;
+}
+
+static bool processFont(const DistanceFieldBatchOptions &options,
+                        const QString &fontFile,
+                        QString *errorString)
+{
+    const QString outputFile = QDir(options.outputDirectory).absoluteFilePath(QFileInfo(fontFile).fileName());
+    if (QFileInfo(outputFile) == QFileInfo(fontFile)) {
+        *errorString = tr("Refusing to overwrite the input font '%1'.").arg(fontFile);
+        return false;
+    }
+
+    // The worker lives on this thread, so all its signals are delivered directly
+    DistanceFieldModelWorker worker;
+    QScopedPointer<DistanceFieldWriter> writer;
+    quint16 glyphCount = 0;
+    int generatedCount = 0;
+    int reportedPercent = 0;
+    bool done = false;
+
+    QObject::connect(&worker, &DistanceFieldModelWorker::error, [&](const QString &error) {
+        printLine(QStringLiteral("%1: %2").arg(fontFile, error));
+    });
+    QObject::connect(&worker, &DistanceFieldModelWorker::fontLoaded,
+                     [&](quint16 count, bool doubleResolution, qreal pixelSize) {
+        glyphCount = count;
+        writer.reset(new DistanceFieldWriter(pixelSize, doubleResolution));
+        writer->setMaximumTextureSize(options.maximumTextureSize);
+        if (!options.silent)
+            printLine(tr("%1: Generating %n glyph(s)", nullptr, count).arg(fontFile));
+    });
+    QObject::connect(&worker, &DistanceFieldModelWorker::distanceFieldsGenerated,
+                     [&](const QList<DistanceFieldGlyph> &glyphs) {
+        for (const DistanceFieldGlyph &glyph : glyphs) {
+            if (isSelected(options, glyph.cmapAssignment))
+                writer->addGlyph(glyph.glyphId, glyph.distanceField, glyph.path);
+        }
+
+        generatedCount += glyphs.size();
+        const int percent = generatedCount * 100 / glyphCount;
+        if (!options.silent && percent / 10 > reportedPercent / 10) {
+            reportedPercent = percent;
+            printLine(QStringLiteral("%1: %2%").arg(fontFile).arg(percent));
+        }
+    });
+    QObject::connect(&worker, &DistanceFieldModelWorker::fontGenerated, [&]() {
+        done = true;
+    });
+
+    worker.loadFont(fontFile);
+    if (glyphCount == 0) {
+        *errorString = tr("No glyphs found in '%1'.").arg(fontFile);
+        return false;
+    }
+
+    while (!done)
+        worker.generateDistanceFields();
+
+    if (writer->glyphCount() == 0) {
+        *errorString = tr("No glyphs in '%1' match the selected ranges.").arg(fontFile);
+        return false;
+    }
+
+    if (!writer->writeFont(fontFile, outputFile, errorString))
+        return false;
+
+    if (!options.silent) {
+        printLine(tr("%1: Wrote %n glyph(s) to '%2'", nullptr, writer->glyphCount())
+                  .arg(fontFile, QDir::toNativeSeparators(outputFile)));
+    }
+    return true;
+}
+
+int runDistanceFieldBatch(const DistanceFieldBatchOptions &options)
+{
+    if (options.fontFiles.isEmpty()) {
+        printLine(tr("No font files given."));
+        return 1;
+    }
+
+    if (!QDir().mkpath(options.outputDirectory)) {
+        printLine(tr("Cannot create output directory '%1'.").arg(options.outputDirectory));
+        return 1;
+    }
+
+    // Each font already rasterizes its glyphs on all cores, running several at once
+    // mostly overlaps loading, packing and writing.
+    const QStringList &fontFiles = options.fontFiles;
+    // The fonts get a pool of their own, the global one is left to the glyphs, so that
+    // a font waiting for its glyphs never holds a thread they need.
+    std::vector<QString> errorStrings(fontFiles.size());
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(options.jobs, 1));
+    for (qsizetype i = 0; i < fontFiles.size(); ++i) {
+        pool.start([&options, &fontFiles, &errorStrings, i]() {
+            if (!processFont(options, fontFiles.at(i), &errorStrings[i]) && errorStrings[i].isEmpty())
+                errorStrings[i] = tr("Failed to process '%1'.").arg(fontFiles.at(i));
+        });
+    }
+    pool.waitForDone();
+
+    int failures = 0;
+    for (qsizetype i = 0; i < fontFiles.size(); ++i) {
+        if (!errorStrings[i].isEmpty()) {
+            printLine(errorStrings[i]);
+            ++failures;
+        }
+    }
+
+    if (!options.silent) {
+        printLine(tr("Processed %1 of %n font(s) successfully.", nullptr, fontFiles.size())
+                  .arg(fontFiles.size() - failures));
+    }
+    return failures > 0 ? 1 : 0;
+}
+
+QT_END_NAMESPACE
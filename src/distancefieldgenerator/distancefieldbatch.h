@@ -0,0 +1,53 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef DISTANCEFIELDBATCH_H
+#define DISTANCEFIELDBATCH_H
+
+#include <QtCore/qlist.h>
+#include <QtCore/qpair.h>
+#include <QtCore/qstringlist.h>
+
+QT_BEGIN_NAMESPACE
+
+struct DistanceFieldBatchOptions
+{
+    QStringList fontFiles;
+    QString outputDirectory;
+    QList<QPair<quint32, quint32>> unicodeRanges; // Empty selects all glyphs
+    int maximumTextureSize = 2048;
+    int jobs = 1;
+    bool silent = false;
+};
+
+bool parseUnicodeRange(const QString &range, QPair<quint32, quint32> *result);
+int runDistanceFieldBatch(const DistanceFieldBatchOptions &options);
+
+QT_END_NAMESPACE
+
+#endif // DISTANCEFIELDBATCH_H
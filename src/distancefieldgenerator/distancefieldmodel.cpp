@@ -54,12 +54,10 @@ DistanceFieldModel::DistanceFieldModel(QObject *parent)
             this, &DistanceFieldModel::startGeneration);
     connect(m_worker, &DistanceFieldModelWorker::fontLoaded,
             this, &DistanceFieldModel::reserveSpace);
-    connect(m_worker, &DistanceFieldModelWorker::distanceFieldGenerated,
-            this, &DistanceFieldModel::addDistanceField);
+    connect(m_worker, &DistanceFieldModelWorker::distanceFieldsGenerated,
+            this, &DistanceFieldModel::addDistanceFields);
     connect(m_worker, &DistanceFieldModelWorker::fontGenerated,
             this, &DistanceFieldModel::stopGeneration);
-    connect(m_worker, &DistanceFieldModelWorker::distanceFieldGenerated,
-            this, &DistanceFieldModel::distanceFieldGenerated);
     connect(m_worker, &DistanceFieldModelWorker::error,
             this, &DistanceFieldModel::error);
 
@@ -134,7 +132,7 @@ void DistanceFieldModel::reserveSpace(quint16 glyphCount,
     m_pixelSize = pixelSize;
 
     QMetaObject::invokeMethod(m_worker,
-                              [this] { m_worker->generateOneDistanceField(); },
+                              [this] { m_worker->generateDistanceFields(); },
                               Qt::QueuedConnection);
 }
 
@@ -169,28 +167,37 @@ QString DistanceFieldModel::nameForUnicodeRange(UnicodeRange range) const
     return QString::fromLatin1(m_rangeEnum.valueToKey(int(range)));
 }
 
-void DistanceFieldModel::addDistanceField(const QImage &distanceField,
-                                          const QPainterPath &path,
-                                          glyph_t glyphId,
-                                          quint32 ucs4)
+void DistanceFieldModel::addDistanceFields(const QList<DistanceFieldGlyph> &glyphs)
 {
-    if (glyphId >= quint16(m_distanceFields.size()))
-        m_distanceFields.resize(glyphId + 1);
-    m_distanceFields[glyphId] = distanceField;
-    if (glyphId >= quint16(m_paths.size()))
-        m_paths.resize(glyphId + 1);
-    m_paths[glyphId] = path;
-
-    if (ucs4 != 0) {
-        UnicodeRange range = unicodeRangeForUcs4(ucs4);
-        m_glyphsPerUnicodeRange.insert(range, glyphId);
-        m_glyphsPerUcs4.insert(ucs4, glyphId);
+    if (glyphs.isEmpty())
+        return;
+
+    glyph_t firstGlyphId = glyphs.constFirst().glyphId;
+    glyph_t lastGlyphId = firstGlyphId;
+    for (const DistanceFieldGlyph &glyph : glyphs) {
+        const glyph_t glyphId = glyph.glyphId;
+        if (glyphId >= quint16(m_distanceFields.size()))
+            m_distanceFields.resize(glyphId + 1);
+        m_distanceFields[glyphId] = glyph.distanceField;
+        if (glyphId >= quint16(m_paths.size()))
+            m_paths.resize(glyphId + 1);
+        m_paths[glyphId] = glyph.path;
+
+        if (glyph.cmapAssignment != 0) {
+            UnicodeRange range = unicodeRangeForUcs4(glyph.cmapAssignment);
+            m_glyphsPerUnicodeRange.insert(range, glyphId);
+            m_glyphsPerUcs4.insert(glyph.cmapAssignment, glyphId);
+        }
+
+        firstGlyphId = qMin(firstGlyphId, glyphId);
+        lastGlyphId = qMax(lastGlyphId, glyphId);
     }
 
-    emit dataChanged(createIndex(glyphId, 0), createIndex(glyphId, 0));
+    emit dataChanged(createIndex(firstGlyphId, 0), createIndex(lastGlyphId, 0));
+    emit distanceFieldsGenerated(glyphs.size());
 
     QMetaObject::invokeMethod(m_worker,
-                             [this] { m_worker->generateOneDistanceField(); },
+                             [this] { m_worker->generateDistanceFields(); },
                              Qt::QueuedConnection);
 }
 
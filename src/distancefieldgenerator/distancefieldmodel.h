@@ -42,6 +42,7 @@ QT_BEGIN_NAMESPACE
 
 class QThread;
 class DistanceFieldModelWorker;
+struct DistanceFieldGlyph;
 class DistanceFieldModel : public QAbstractListModel
 {
     Q_OBJECT
@@ -205,14 +206,11 @@ public:
 signals:
     void startGeneration(quint16 glyphCount);
     void stopGeneration();
-    void distanceFieldGenerated();
+    void distanceFieldsGenerated(int count);
     void error(const QString &errorString);
 
 private slots:
-    void addDistanceField(const QImage &distanceField,
-                          const QPainterPath &path,
-                          glyph_t glyphId,
-                          quint32 ucs4);
+    void addDistanceFields(const QList<DistanceFieldGlyph> &glyphs);
     void reserveSpace(quint16 glyphCount,
                       bool doubleResolution,
                       qreal pixelSize);
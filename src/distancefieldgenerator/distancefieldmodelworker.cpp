@@ -30,8 +30,11 @@
 
 #include "distancefieldmodel.h"
 #include <qendian.h>
+#include <QSemaphore>
+#include <QThreadPool>
 #include <QtGui/private/qdistancefield_p.h>
 
+
 QT_BEGIN_NAMESPACE
 
 #   pragma pack(1)
@@ -330,7 +333,7 @@ void DistanceFieldModelWorker::loadFont(const QString &fileName)
                     pixelSize);
 }
 
-void DistanceFieldModelWorker::generateOneDistanceField()
+void DistanceFieldModelWorker::generateDistanceFields()
 {
     Q_ASSERT(m_nextGlyphId <= m_glyphCount);
 
@@ -339,14 +342,36 @@ void DistanceFieldModelWorker::generateOneDistanceField()
         return;
     }
 
-    QPainterPath path = m_font.pathForGlyph(m_nextGlyphId);
-    QDistanceField distanceField(path, m_nextGlyphId, m_doubleGlyphResolution);
-    emit distanceFieldGenerated(distanceField.toImage(QImage::Format_Alpha8),
-                                path,
-                                m_nextGlyphId,
-                                m_cmapping.value(m_nextGlyphId));
+    // Generate a batch per invocation, so the model gets to update the view between batches
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int threadCount = pool->maxThreadCount();
+    const int batchSize = qMin(qMax(threadCount, 1) * 16, m_glyphCount - m_nextGlyphId);
+
+    // QRawFont is not shared between threads, so fetch the outlines serially
+    QList<DistanceFieldGlyph> glyphs(batchSize);
+    for (int i = 0; i < batchSize; ++i) {
+        DistanceFieldGlyph &glyph = glyphs[i];
+        glyph.glyphId = m_nextGlyphId + i;
+        glyph.path = m_font.pathForGlyph(glyph.glyphId);
+        glyph.cmapAssignment = m_cmapping.value(glyph.glyphId);
+    }
+
+    // Rasterizing the distance fields dominates, do it concurrently
+    DistanceFieldGlyph *data = glyphs.data(); // detached once, for the workers
+    const bool doubleGlyphResolution = m_doubleGlyphResolution;
+    QSemaphore done;
+    for (int i = 0; i < batchSize; ++i) {
+        pool->start([data, doubleGlyphResolution, &done, i]() {
+            DistanceFieldGlyph &glyph = data[i];
+            QDistanceField distanceField(glyph.path, glyph.glyphId, doubleGlyphResolution);
+            glyph.distanceField = distanceField.toImage(QImage::Format_Alpha8);
+            done.release();
+        });
+    }
+    done.acquire(batchSize);
 
-    m_nextGlyphId++;
+    m_nextGlyphId += batchSize;
+    emit distanceFieldsGenerated(glyphs);
 }
 
 QT_END_NAMESPACE
@@ -31,10 +31,20 @@
 
 #include <QObject>
 #include <QRawFont>
+#include <QtGui/qimage.h>
+#include <QtGui/qpainterpath.h>
 #include <QtGui/private/qtextengine_p.h>
 
 QT_BEGIN_NAMESPACE
 
+struct DistanceFieldGlyph
+{
+    QImage distanceField;
+    QPainterPath path;
+    glyph_t glyphId = 0;
+    quint32 cmapAssignment = 0;
+};
+
 struct CmapSubtable0;
 struct CmapSubtable4;
 struct CmapSubtable6;
@@ -46,7 +56,7 @@ class DistanceFieldModelWorker : public QObject
 public:
     explicit DistanceFieldModelWorker(QObject *parent = nullptr);
 
-    Q_INVOKABLE void generateOneDistanceField();
+    Q_INVOKABLE void generateDistanceFields();
     Q_INVOKABLE void loadFont(const QString &fileName);
 
     void readCmapSubtable(const CmapSubtable0 *subtable, const void *end);
@@ -58,10 +68,7 @@ public:
 signals:
     void fontLoaded(quint16 glyphCount, bool doubleResolution, qreal pixelSize);
     void fontGenerated();
-    void distanceFieldGenerated(const QImage &distanceField,
-                                const QPainterPath &path,
-                                glyph_t glyphId,
-                                quint32 cmapAssignment);
+    void distanceFieldsGenerated(const QList<DistanceFieldGlyph> &glyphs);
     void error(const QString &errorString);
 
 private:
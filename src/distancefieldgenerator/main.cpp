@@ -27,18 +27,41 @@
 ****************************************************************************/
 
 #include "mainwindow.h"
+#include "distancefieldbatch.h"
 
 #include <QApplication>
 #include <QCommandLineParser>
+#include <QScopedPointer>
+
+#include <cstdio>
+#include <cstring>
 
 QT_USE_NAMESPACE
 
+// Batch mode has to be known before the application object is created, as it
+// must not require a windowing system.
+static bool isBatchMode(int argc, char **argv)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "-o") || !strcmp(argv[i], "--output-directory")
+                || !strncmp(argv[i], "--output-directory=", 19)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 int main(int argc, char **argv)
 {
-    QApplication app(argc, argv);
-    app.setOrganizationName(QStringLiteral("QtProject"));
-    app.setApplicationName(QStringLiteral("Qt Distance Field Generator"));
-    app.setApplicationVersion(QStringLiteral(QT_VERSION_STR));
+    const bool batchMode = isBatchMode(argc, argv);
+    if (batchMode && !qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QScopedPointer<QGuiApplication> app(batchMode ? new QGuiApplication(argc, argv)
+                                                  : new QApplication(argc, argv));
+    app->setOrganizationName(QStringLiteral("QtProject"));
+    app->setApplicationName(QStringLiteral("Qt Distance Field Generator"));
+    app->setApplicationVersion(QStringLiteral(QT_VERSION_STR));
 
     QCommandLineParser parser;
     parser.setApplicationDescription(
@@ -49,12 +72,88 @@ int main(int argc, char **argv)
     parser.addPositionalArgument(QLatin1String("file"),
                                  QCoreApplication::translate("main",
                                                              "Font file (*.ttf, *.otf)"));
-    parser.process(app);
+
+    QCommandLineOption outputDirectoryOption(QStringList() << QStringLiteral("o") << QStringLiteral("output-directory"),
+                                             QCoreApplication::translate("main",
+                                                                         "Generate the distance fields for all given font files without "
+                                                                         "the user interface and save the resulting fonts to <directory>."),
+                                             QCoreApplication::translate("main", "directory"));
+    parser.addOption(outputDirectoryOption);
+
+    QCommandLineOption rangeOption(QStringLiteral("range"),
+                                   QCoreApplication::translate("main",
+                                                               "In batch mode, only save the glyphs for the characters in <range>, "
+                                                               "given as hexadecimal code points such as 20-7e. Can be given "
+                                                               "multiple times. All glyphs are saved by default."),
+                                   QCoreApplication::translate("main", "range"));
+    parser.addOption(rangeOption);
+
+    QCommandLineOption textureSizeOption(QStringLiteral("texture-size"),
+                                         QCoreApplication::translate("main",
+                                                                     "In batch mode, the maximum texture size. Defaults to 2048."),
+                                         QCoreApplication::translate("main", "size"));
+    parser.addOption(textureSizeOption);
+
+    QCommandLineOption jobsOption(QStringList() << QStringLiteral("j") << QStringLiteral("jobs"),
+                                  QCoreApplication::translate("main",
+                                                              "In batch mode, process up to <count> fonts at the same time. "
+                                                              "Defaults to 1."),
+                                  QCoreApplication::translate("main", "count"));
+    parser.addOption(jobsOption);
+
+    QCommandLineOption silentOption(QStringLiteral("silent"),
+                                    QCoreApplication::translate("main",
+                                                                "In batch mode, do not report progress."));
+    parser.addOption(silentOption);
+
+    parser.process(*app);
+
+    if (batchMode) {
+        DistanceFieldBatchOptions options;
+        options.fontFiles = parser.positionalArguments();
+        options.outputDirectory = parser.value(outputDirectoryOption);
+        options.silent = parser.isSet(silentOption);
+
+        const QStringList ranges = parser.values(rangeOption);
+        for (const QString &range : ranges) {
+            QPair<quint32, quint32> unicodeRange;
+            if (!parseUnicodeRange(range, &unicodeRange)) {
+                fprintf(stderr, "%s\n",
+                        qPrintable(QCoreApplication::translate("main", "Invalid Unicode range '%1'.").arg(range)));
+                return 1;
+            }
+            options.unicodeRanges.append(unicodeRange);
+        }
+
+        if (parser.isSet(textureSizeOption)) {
+            bool ok;
+            options.maximumTextureSize = parser.value(textureSizeOption).toInt(&ok);
+            if (!ok || options.maximumTextureSize < 64) {
+                fprintf(stderr, "%s\n",
+                        qPrintable(QCoreApplication::translate("main", "Invalid texture size '%1'.")
+                                   .arg(parser.value(textureSizeOption))));
+                return 1;
+            }
+        }
+
+        if (parser.isSet(jobsOption)) {
+            bool ok;
+            options.jobs = parser.value(jobsOption).toInt(&ok);
+            if (!ok || options.jobs < 1) {
+                fprintf(stderr, "%s\n",
+                        qPrintable(QCoreApplication::translate("main", "Invalid job count '%1'.")
+                                   .arg(parser.value(jobsOption))));
+                return 1;
+            }
+        }
+
+        return runDistanceFieldBatch(options);
+    }
 
     MainWindow mainWindow;
     if (!parser.positionalArguments().isEmpty())
         mainWindow.open(parser.positionalArguments().constFirst());
     mainWindow.show();
 
-    return app.exec();
+    return app->exec();
 }
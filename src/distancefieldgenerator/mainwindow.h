@@ -58,7 +58,7 @@ private slots:
     void openFont();
     void startProgressBar(quint16 glyphCount);
     void stopProgressBar();
-    void updateProgressBar();
+    void updateProgressBar(int count);
     void selectAll();
     void updateSelection();
     void updateUnicodeRanges();
@@ -72,7 +72,6 @@ private slots:
 private:
     void setupConnections();
     void writeFile();
-    QByteArray createSfntTable();
 
     Ui::MainWindow *ui;
     QString m_fontDir;
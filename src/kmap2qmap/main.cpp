@@ -27,15 +27,19 @@
 ****************************************************************************/
 
 #include <cstdio>
+#include <atomic>
 
 #include <QFile>
 #include <QFileInfo>
 #include <QDir>
+#include <QHash>
 #include <QList>
 #include <QByteArray>
+#include <QSemaphore>
 #include <QStringDecoder>
 #include <QStringList>
 #include <QTextStream>
+#include <QThreadPool>
 
 #include <QtInputSupport/private/qevdevkeyboardhandler_p.h>
 
@@ -387,6 +391,38 @@ static const symbol_synonyms_t symbol_synonyms[] = {
 
 static const int symbol_synonyms_size = sizeof(symbol_synonyms)/sizeof(symbol_synonyms_t);
 
+// Every symbol of every kmap is looked up in the tables above, so index
+// them once. As with a linear search, the first entry of a name wins.
+static const QHash<QByteArray, quint32> &symbolHash()
+{
+    static const QHash<QByteArray, quint32> hash = [] {
+        QHash<QByteArray, quint32> h;
+        h.reserve(symbol_map_size);
+        for (int i = 0; i < symbol_map_size; ++i) {
+            const QByteArray symbol = QByteArray::fromRawData(symbol_map[i].symbol, qstrlen(symbol_map[i].symbol));
+            if (!h.contains(symbol))
+                h.insert(symbol, symbol_map[i].qtcode);
+        }
+        return h;
+    }();
+    return hash;
+}
+
+static const QHash<QByteArray, QByteArray> &synonymHash()
+{
+    static const QHash<QByteArray, QByteArray> hash = [] {
+        QHash<QByteArray, QByteArray> h;
+        h.reserve(symbol_synonyms_size);
+        for (int i = 0; i < symbol_synonyms_size; ++i) {
+            const QByteArray from = QByteArray::fromRawData(symbol_synonyms[i].from, qstrlen(symbol_synonyms[i].from));
+            if (!h.contains(from))
+                h.insert(from, QByteArray(symbol_synonyms[i].to));
+        }
+        return h;
+    }();
+    return hash;
+}
+
 // makes the generated array in --header mode a bit more human readable
 QT_BEGIN_NAMESPACE
 namespace QEvdevKeyboardMap {
@@ -428,15 +464,85 @@ private:
 
 
 
+// Converts a single kmap to a qmap, returning the exit code of main().
+static int convertKeymap(const QString &kmapName, const QString &qmapName)
+{
+    QFile kmap(kmapName);
+    if (!kmap.open(QIODevice::ReadOnly)) {
+        fprintf(stderr, "Could not read from '%s'.\n", qPrintable(kmapName));
+        return 2;
+    }
+    QFile qmap(qmapName);
+    if (!qmap.open(QIODevice::WriteOnly)) {
+        fprintf(stderr, "Could not write to '%s'.\n", qPrintable(qmapName));
+        return 3;
+    }
+
+    KeymapParser p;
+    if (!p.parseKmap(&kmap)) {
+        fprintf(stderr, "Parsing kmap '%s' failed.\n", qPrintable(kmapName));
+        return 4;
+    }
+    if (p.parseWarningCount()) {
+        fprintf(stderr, "Parsing '%s' produced %d warning(s).\n",
+                qPrintable(kmapName), p.parseWarningCount());
+    }
+    if (!p.generateQmap(&qmap)) {
+        fprintf(stderr, "Generating the qmap '%s' failed.\n", qPrintable(qmapName));
+        return 5;
+    }
+    return 0;
+}
+
+// Converts each kmap into a qmap of the same base name in outputDir. The
+// keymaps are independent of each other, so they are converted on
+// several threads.
+static int convertKeymaps(const QString &outputDir, const QStringList &kmapNames)
+{
+    const QDir dir(outputDir);
+    if (!dir.exists()) {
+        fprintf(stderr, "Output directory '%s' does not exist.\n", qPrintable(outputDir));
+        return 3;
+    }
+
+    std::atomic<int> result(0);
+    QSemaphore done;
+    for (const QString &kmapName : kmapNames) {
+        QThreadPool::globalInstance()->start([&dir, &result, &done, kmapName] {
+            const QString qmapName =
+                dir.filePath(QFileInfo(kmapName).completeBaseName() + QLatin1String(".qmap"));
+            const int rc = convertKeymap(kmapName, qmapName);
+            int expected = result.load();
+            while (rc > expected && !result.compare_exchange_weak(expected, rc)) { }
+            done.release();
+        });
+    }
+    done.acquire(kmapNames.size());
+    return result;
+}
+
 int main(int argc, char **argv)
 {
+    if (argc >= 2 && !qstrcmp(argv[1], "--batch")) {
+        if (argc < 4) {
+            fprintf(stderr, "Usage: kmap2qmap --batch <qmap directory> <kmap> [<kmap> ...]\n");
+            return 1;
+        }
+        QStringList kmapNames;
+        for (int i = 3; i < argc; ++i)
+            kmapNames.append(QString::fromLocal8Bit(argv[i]));
+        return convertKeymaps(QString::fromLocal8Bit(argv[2]), kmapNames);
+    }
+
     int header = 0;
     if (argc >= 2 && !qstrcmp(argv[1], "--header"))
         header = 1;
 
     if (argc < (3 + header)) {
         fprintf(stderr, "Usage: kmap2qmap [--header] <kmap> [<additional kmaps> ...] <qmap>\n");
+        fprintf(stderr, "       kmap2qmap --batch <qmap directory> <kmap> [<kmap> ...]\n");
         fprintf(stderr, "  --header   can be used to generate Qt's default compiled in qmap.\n");
+        fprintf(stderr, "  --batch    converts each kmap into its own qmap in the given directory.\n");
         return 1;
     }
 
@@ -876,12 +982,9 @@ bool KeymapParser::parseSymbol(const QByteArray &str, quint16 &unicode, quint32
         if (!ok)
             return false;
     } else { // symbolic
-        for (int i = 0; i < symbol_synonyms_size; ++i) {
-            if (sym == symbol_synonyms[i].from) {
-                sym = symbol_synonyms[i].to;
-                break;
-            }
-        }
+        const auto synonym = synonymHash().constFind(sym);
+        if (synonym != synonymHash().constEnd())
+            sym = synonym.value();
 
         quint32 qtmod = 0;
 
@@ -911,12 +1014,7 @@ bool KeymapParser::parseSymbol(const QByteArray &str, quint16 &unicode, quint32
             }
 
             // map symbol to Qt key code
-            for  (int i = 0; i < symbol_map_size; ++i) {
-                if (sym == symbol_map[i].symbol) {
-                    qtcode = symbol_map[i].qtcode;
-                    break;
-                }
-            }
+            qtcode = symbolHash().value(sym, Qt::Key_unknown);
 
             // a-zA-Z is not in the table to save space
             if (qtcode == Qt::Key_unknown && sym.length() == 1) {
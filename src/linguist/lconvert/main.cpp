@@ -26,6 +26,7 @@
 **
 ****************************************************************************/
 
+#include "concurrency.h"
 #include "translator.h"
 
 #include <QtCore/QCoreApplication>
@@ -35,7 +36,9 @@
 #include <QtCore/QTranslator>
 #include <QtCore/QLibraryInfo>
 
+#include <atomic>
 #include <iostream>
+#include <vector>
 
 QT_USE_NAMESPACE
 
@@ -99,6 +102,9 @@ static int usage(const QStringList &args)
         "           Default is absolute.\n\n"
         "    -no-ui-lines\n"
         "           Drop line numbers from references to UI files.\n\n"
+        "    -jobs <count>\n"
+        "           Load up to <count> input files at the same time. The default is 1.\n"
+        "           The result does not depend on the number of jobs.\n\n"
         "    -verbose\n"
         "           be a bit more verbose\n\n"
         "Long options can be specified with only one leading dash, too.\n\n"
@@ -116,6 +122,36 @@ struct File
     QString format;
 };
 
+struct LoadedFile
+{
+    ConversionData cd;
+    Translator translator;
+    Translator::Duplicates duplicates;
+    bool ok = false;
+};
+
+/*
+  Loads the input files into separate translators on up to \a jobCount
+  threads. As in the sequential case, no further files are started once
+  one failed to load. Merging is left to the caller, so the result is
+  the same regardless of the order in which the files finish loading.
+*/
+static void loadFiles(const QList<File> &inFiles, std::vector<LoadedFile> &loaded, int jobCount)
+{
+    std::atomic<bool> failed(false);
+
+    forEachConcurrently(inFiles.size(), jobCount, [&](qsizetype i) {
+        if (failed)
+            return;
+        LoadedFile &file = loaded[i];
+        file.ok = file.translator.load(inFiles.at(i).name, file.cd, inFiles.at(i).format);
+        if (file.ok)
+            file.duplicates = file.translator.resolveDuplicates();
+        else
+            failed = true;
+    });
+}
+
 int main(int argc, char *argv[])
 {
     QCoreApplication app(argc, argv);
@@ -148,8 +184,8 @@ int main(int argc, char *argv[])
     bool noUiLines = false;
     Translator::LocationsType locations = Translator::DefaultLocations;
 
+    int jobCount = 1;
     ConversionData cd;
-    Translator tr;
 
     for (int i = 1; i < args.size(); ++i) {
         if (args[i].startsWith(QLatin1String("--")))
@@ -215,6 +251,13 @@ int main(int argc, char *argv[])
                 return usage(args);
         } else if (args[i] == QLatin1String("-no-ui-lines")) {
             noUiLines = true;
+        } else if (args[i] == QLatin1String("-jobs")) {
+            if (++i >= args.size())
+                return usage(args);
+            bool ok = false;
+            jobCount = args[i].toInt(&ok);
+            if (!ok || jobCount < 1)
+                return usage(args);
         } else if (args[i] == QLatin1String("-verbose")) {
             verbose = true;
         } else if (args[i].startsWith(QLatin1Char('-'))) {
@@ -230,23 +273,47 @@ int main(int argc, char *argv[])
     if (inFiles.isEmpty())
         return usage(args);
 
+    std::vector<LoadedFile> loaded(inFiles.size());
+    for (LoadedFile &file : loaded)
+        file.cd = cd;
+    Translator &tr = loaded[0].translator;
     tr.setLanguageCode(Translator::guessLanguageCodeFromFileName(inFiles[0].name));
 
-    if (!tr.load(inFiles[0].name, cd, inFiles[0].format)) {
-        std::cerr << qPrintable(cd.error());
-        return 2;
+    // With a single input file nothing can be overridden by later files, so
+    // unwanted messages can be dropped right while loading. This keeps the
+    // memory usage down when converting huge files. The strip calls below
+    // are no-ops then.
+    if (inFiles.size() == 1 && (noObsolete || noFinished || noUntranslated)) {
+        tr.setMessageFilter([=](const TranslatorMessage &msg) {
+            if (noObsolete && (msg.type() == TranslatorMessage::Obsolete
+                               || msg.type() == TranslatorMessage::Vanished))
+                return false;
+            if (noFinished && msg.type() == TranslatorMessage::Finished)
+                return false;
+            if (noUntranslated && !msg.isTranslated())
+                return false;
+            return true;
+        });
     }
-    tr.reportDuplicates(tr.resolveDuplicates(), inFiles[0].name, verbose);
 
-    for (int i = 1; i < inFiles.size(); ++i) {
-        Translator tr2;
-        if (!tr2.load(inFiles[i].name, cd, inFiles[i].format)) {
+    loadFiles(inFiles, loaded, jobCount);
+
+    for (int i = 0; i < inFiles.size(); ++i) {
+        LoadedFile &file = loaded[i];
+        cd.m_errors += file.cd.m_errors;
+        cd.m_sourceDir = file.cd.m_sourceDir;
+        cd.m_sourceFileName = file.cd.m_sourceFileName;
+        if (!file.ok) {
             std::cerr << qPrintable(cd.error());
             return 2;
         }
-        tr2.reportDuplicates(tr2.resolveDuplicates(), inFiles[i].name, verbose);
-        for (int j = 0; j < tr2.messageCount(); ++j)
-            tr.replaceSorted(tr2.message(j));
+        file.translator.reportDuplicates(file.duplicates, inFiles[i].name, verbose);
+        if (i > 0) {
+            const Translator &tr2 = file.translator;
+            for (int j = 0; j < tr2.messageCount(); ++j)
+                tr.replaceSorted(tr2.message(j));
+            file.translator = Translator();
+        }
     }
 
     if (!targetLanguage.isEmpty())
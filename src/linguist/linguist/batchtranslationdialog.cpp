@@ -100,49 +100,59 @@ void BatchTranslationDialog::startTranslation()
     int translatedcount = 0;
     QCursor oldCursor = cursor();
     setCursor(Qt::BusyCursor);
-    int messageCount = m_dataModel->messageCount();
 
-    QProgressDialog *dlgProgress;
-    dlgProgress = new QProgressDialog(tr("Searching, please wait..."), tr("&Cancel"), 0, messageCount, this);
-    dlgProgress->show();
+    // Go through them in the order the user specified in the phrasebookList,
+    // so the first phrase with a matching source text wins
+    QHash<QString, QString> targets;
+    for (int b = 0; b < m_model.rowCount(); ++b) {
+        QModelIndex idx(m_model.index(b, 0));
+        QVariant checkState = m_model.data(idx, Qt::CheckStateRole);
+        if (checkState == Qt::Checked) {
+            PhraseBook *pb = m_phrasebooks[m_model.data(idx, Qt::UserRole).toInt()];
+            const auto phrases = pb->phrases();
+            for (const Phrase *ph : phrases) {
+                if (!targets.contains(ph->source()))
+                    targets.insert(ph->source(), ph->target());
+            }
+        }
+    }
 
-    int msgidx = 0;
+    // Collect the matches first, then apply them in batches, so that the
+    // event loop does not run for every single message
+    QList<QPair<MultiDataIndex, QString> > matches;
     const bool translateTranslated = m_ui.ckTranslateTranslated->isChecked();
     const bool translateFinished = m_ui.ckTranslateFinished->isChecked();
-    for (MultiDataModelIterator it(m_dataModel, m_modelIndex); it.isValid(); ++it) {
-        if (MessageItem *m = it.current()) {
-            if (!m->isObsolete()
-                && (translateTranslated || m->translation().isEmpty())
-                && (translateFinished || !m->isFinished())) {
-
-                // Go through them in the order the user specified in the phrasebookList
-                for (int b = 0; b < m_model.rowCount(); ++b) {
-                    QModelIndex idx(m_model.index(b, 0));
-                    QVariant checkState = m_model.data(idx, Qt::CheckStateRole);
-                    if (checkState == Qt::Checked) {
-                        PhraseBook *pb = m_phrasebooks[m_model.data(idx, Qt::UserRole).toInt()];
-                        const auto phrases = pb->phrases();
-                        for (const Phrase *ph : phrases) {
-                            if (ph->source() == m->text()) {
-                                m_dataModel->setTranslation(it, ph->target());
-                                m_dataModel->setFinished(it, m_ui.ckMarkFinished->isChecked());
-                                ++translatedcount;
-                                goto done; // break 2;
-                            }
-                        }
-                    }
+    if (!targets.isEmpty()) {
+        for (MultiDataModelIterator it(m_dataModel, m_modelIndex); it.isValid(); ++it) {
+            if (MessageItem *m = it.current()) {
+                if (!m->isObsolete()
+                    && (translateTranslated || m->translation().isEmpty())
+                    && (translateFinished || !m->isFinished())) {
+                    const auto target = targets.constFind(m->text());
+                    if (target != targets.constEnd())
+                        matches.append(qMakePair(MultiDataIndex(it), *target));
                 }
             }
         }
-      done:
-        ++msgidx;
-        if (!(msgidx & 15))
-            dlgProgress->setValue(msgidx);
-        qApp->processEvents();
-        if (dlgProgress->wasCanceled())
-            break;
     }
-    dlgProgress->hide();
+
+    QProgressDialog dlgProgress(tr("Searching, please wait..."), tr("&Cancel"),
+                                0, matches.size(), this);
+    dlgProgress.show();
+
+    const bool markFinished = m_ui.ckMarkFinished->isChecked();
+    for (const auto &match : qAsConst(matches)) {
+        m_dataModel->setTranslation(match.first, match.second);
+        m_dataModel->setFinished(match.first, markFinished);
+        ++translatedcount;
+        if (!(translatedcount & 255)) {
+            dlgProgress.setValue(translatedcount);
+            qApp->processEvents();
+            if (dlgProgress.wasCanceled())
+                break;
+        }
+    }
+    dlgProgress.hide();
 
     setCursor(oldCursor);
     emit finished();
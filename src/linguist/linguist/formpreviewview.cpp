@@ -483,8 +483,14 @@ static void highlightTargets(const QList<TranslatableEntry> &targets, bool on)
         highlightTarget(target, on);
 }
 
+FormPreviewView::CachedForm::~CachedForm()
+{
+    destroyTargets(&targets);
+    delete form;
+}
+
 FormPreviewView::FormPreviewView(QWidget *parent, MultiDataModel *dataModel)
-  : QMainWindow(parent), m_form(0), m_dataModel(dataModel)
+  : QMainWindow(parent), m_form(0), m_dataModel(dataModel), m_formCache(8)
 {
     m_mdiSubWindow = new QMdiSubWindow;
     m_mdiSubWindow->setWindowFlags(m_mdiSubWindow->windowFlags() & ~Qt::WindowSystemMenuHint);
@@ -495,6 +501,70 @@ FormPreviewView::FormPreviewView(QWidget *parent, MultiDataModel *dataModel)
     m_mdiArea->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
 }
 
+// Moves the current form into the cache
+void FormPreviewView::releaseForm()
+{
+    if (!m_form)
+        return;
+    highlightTargets(m_highlights, false);
+    m_highlights.clear();
+    m_mdiSubWindow->setWidget(nullptr);
+    m_form->setParent(this);
+    m_form->hide();
+    m_formCache.insert(m_lastFormName,
+                       new CachedForm { m_form, m_targets, m_lastClassName, m_lastFormModified });
+    m_form = 0;
+    m_targets.clear();
+    m_lastFormName.clear();
+}
+
+bool FormPreviewView::loadForm(const QString &fileName, const QDateTime &lastModified,
+                               const QString &className)
+{
+    if (CachedForm *cached = m_formCache.object(fileName)) {
+        if (cached->lastModified == lastModified) {
+            m_form = cached->form;
+            m_targets = cached->targets;
+            m_lastClassName = cached->className;
+            cached->form = 0;
+            cached->targets.clear();
+            m_formCache.remove(fileName);
+            m_mdiSubWindow->setWidget(m_form);
+            m_form->show();
+            return true;
+        }
+        m_formCache.remove(fileName);
+    }
+
+    static QUiLoader *uiLoader;
+    if (!uiLoader) {
+        uiLoader = new QUiLoader(this);
+        uiLoader->setLanguageChangeEnabled(true);
+        uiLoader->setTranslationEnabled(false);
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "CANNOT OPEN FORM" << fileName;
+        return false;
+    }
+    m_form = uiLoader->load(&file, m_mdiSubWindow);
+    if (!m_form) {
+        qDebug() << "CANNOT LOAD FORM" << fileName;
+        return false;
+    }
+    file.close();
+    buildTargets(m_form, &m_targets);
+
+    m_form->setWindowFlags(Qt::Widget);
+    m_form->setWindowModality(Qt::NonModal);
+    m_form->setFocusPolicy(Qt::NoFocus);
+    m_form->show(); // needed, otherwide the Qt::NoFocus is not propagated.
+    m_mdiSubWindow->setWidget(m_form);
+    m_lastClassName = className;
+    return true;
+}
+
 void FormPreviewView::setSourceContext(int model, MessageItem *messageItem)
 {
     if (model < 0 || !messageItem) {
@@ -504,47 +574,21 @@ void FormPreviewView::setSourceContext(int model, MessageItem *messageItem)
 
     QDir dir = QFileInfo(m_dataModel->srcFileName(model)).dir();
     QString fileName = QDir::cleanPath(dir.absoluteFilePath(messageItem->fileName()));
-    if (m_lastFormName != fileName) {
-        delete m_form;
-        m_form = 0;
-        m_lastFormName.clear();
-        m_highlights.clear();
-        destroyTargets(&m_targets);
-
-        static QUiLoader *uiLoader;
-        if (!uiLoader) {
-            uiLoader = new QUiLoader(this);
-            uiLoader->setLanguageChangeEnabled(true);
-            uiLoader->setTranslationEnabled(false);
-        }
-
-        QFile file(fileName);
-        if (!file.open(QIODevice::ReadOnly)) {
-            qDebug() << "CANNOT OPEN FORM" << fileName;
-            m_mdiSubWindow->hide();
-            return;
-        }
-        m_form = uiLoader->load(&file, m_mdiSubWindow);
-        if (!m_form) {
-            qDebug() << "CANNOT LOAD FORM" << fileName;
+    const QDateTime lastModified = QFileInfo(fileName).lastModified();
+    if (m_lastFormName != fileName || m_lastFormModified != lastModified) {
+        releaseForm();
+        if (!loadForm(fileName, lastModified, messageItem->context())) {
             m_mdiSubWindow->hide();
             return;
         }
-        file.close();
-        buildTargets(m_form, &m_targets);
 
         setToolTip(fileName);
 
-        m_form->setWindowFlags(Qt::Widget);
-        m_form->setWindowModality(Qt::NonModal);
-        m_form->setFocusPolicy(Qt::NoFocus);
-        m_form->show(); // needed, otherwide the Qt::NoFocus is not propagated.
-        m_mdiSubWindow->setWidget(m_form);
         m_mdiSubWindow->setWindowTitle(m_form->windowTitle());
         m_mdiSubWindow->show();
         m_mdiArea->cascadeSubWindows();
         m_lastFormName = fileName;
-        m_lastClassName = messageItem->context();
+        m_lastFormModified = lastModified;
         m_lastModel = -1;
     } else {
         highlightTargets(m_highlights, false);
@@ -31,6 +31,8 @@
 
 #include <private/quiloader_p.h>
 
+#include <QtCore/QCache>
+#include <QtCore/QDateTime>
 #include <QtCore/QHash>
 #include <QtCore/QList>
 
@@ -96,6 +98,20 @@ public:
     void setSourceContext(int model, MessageItem *messageItem);
 
 private:
+    // A form which was shown before, kept so that going back to it does not
+    // require building it again
+    struct CachedForm {
+        ~CachedForm();
+        QWidget *form;
+        TargetsHash targets;
+        QString className;
+        QDateTime lastModified;
+    };
+
+    void releaseForm();
+    bool loadForm(const QString &fileName, const QDateTime &lastModified,
+                  const QString &className);
+
     bool m_isActive;
     QString m_currentFileName;
     QMdiArea *m_mdiArea;
@@ -106,8 +122,10 @@ private:
     MultiDataModel *m_dataModel;
 
     QString m_lastFormName;
+    QDateTime m_lastFormModified;
     QString m_lastClassName;
     int m_lastModel;
+    QCache<QString, CachedForm> m_formCache;
 };
 
 QT_END_NAMESPACE
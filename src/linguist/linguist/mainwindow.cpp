@@ -55,9 +55,12 @@
 #include <QCloseEvent>
 #include <QDebug>
 #include <QDockWidget>
+#include <QEventLoop>
 #include <QFile>
 #include <QFileDialog>
 #include <QFileInfo>
+#include <QFuture>
+#include <QFutureWatcher>
 #include <QHeaderView>
 #include <QInputDialog>
 #include <QItemDelegate>
@@ -71,20 +74,26 @@
 #include <QPrintDialog>
 #include <QPrinter>
 #include <QProcess>
+#include <QPromise>
 #include <QRegularExpression>
 #include <QScreen>
+#include <QSemaphore>
 #include <QShortcut>
 #include <QSettings>
 #include <QSortFilterProxyModel>
 #include <QStackedWidget>
 #include <QStatusBar>
 #include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
 #include <QToolBar>
 #include <QUrl>
 #include <QWhatsThis>
 
 #include <ctype.h>
 
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 static const int MessageMS = 2500;
@@ -585,6 +594,31 @@ struct OpenedFile {
     bool langGuessed;
 };
 
+static QFuture<LoadedTranslation> startReading(const QString &fileName)
+{
+    auto promise = std::make_shared<QPromise<LoadedTranslation>>();
+    promise->start();
+    QFuture<LoadedTranslation> future = promise->future();
+    QThreadPool::globalInstance()->start([promise, fileName]() {
+        promise->addResult(DataModel::read(fileName));
+        promise->finish();
+    });
+    return future;
+}
+
+// Keeps the window painted, but does not accept input while waiting.
+static LoadedTranslation waitForResult(const QFuture<LoadedTranslation> &future)
+{
+    if (!future.isFinished()) {
+        QEventLoop loop;
+        QFutureWatcher<LoadedTranslation> watcher;
+        QObject::connect(&watcher, &QFutureWatcherBase::finished, &loop, &QEventLoop::quit);
+        watcher.setFuture(future);
+        loop.exec(QEventLoop::ExcludeUserInputEvents);
+    }
+    return future.result();
+}
+
 bool MainWindow::openFiles(const QStringList &names, bool globalReadWrite)
 {
     if (names.isEmpty())
@@ -594,14 +628,12 @@ bool MainWindow::openFiles(const QStringList &names, bool globalReadWrite)
     statusBar()->showMessage(tr("Loading..."));
     qApp->processEvents();
 
-    QList<OpenedFile> opened;
-    bool closeOld = false;
+    // Parse all files at once in the background; they are turned into
+    // models one by one below, in the order they were given.
+    QStringList fileNames;
+    QList<bool> readWrites;
+    QList<QFuture<LoadedTranslation>> reads;
     for (QString name : names) {
-        if (!waitCursor) {
-            QApplication::setOverrideCursor(Qt::WaitCursor);
-            waitCursor = true;
-        }
-
         bool readWrite = globalReadWrite;
         if (name.startsWith(QLatin1Char('='))) {
             name.remove(0, 1);
@@ -612,10 +644,24 @@ bool MainWindow::openFiles(const QStringList &names, bool globalReadWrite)
             name = fi.canonicalFilePath();
         if (m_dataModel->isFileLoaded(name) >= 0)
             continue;
+        fileNames << name;
+        readWrites << readWrite;
+        reads << startReading(name);
+    }
+
+    QList<OpenedFile> opened;
+    bool closeOld = false;
+    for (int i = 0; i < fileNames.size(); ++i) {
+        if (!waitCursor) {
+            QApplication::setOverrideCursor(Qt::WaitCursor);
+            waitCursor = true;
+        }
 
+        const QString &name = fileNames.at(i);
+        const bool readWrite = readWrites.at(i);
         bool langGuessed;
         DataModel *dm = new DataModel(m_dataModel);
-        if (!dm->load(name, &langGuessed, this)) {
+        if (!dm->load(waitForResult(reads.at(i)), &langGuessed, this)) {
             delete dm;
             continue;
         }
@@ -994,14 +1040,22 @@ void MainWindow::findAgain()
     if (m_dataModel->contextCount() == 0)
         return;
 
+    // Let the trigram index rule out messages which cannot match, so that
+    // only the candidates are searched
+    QSet<QPair<int, int> > candidates;
+    const bool narrowed = !m_findUseRegExp
+            && m_dataModel->searchCandidates(m_findText, m_findWhere, &candidates);
+
     const QModelIndex &startIndex = m_messageView->currentIndex();
-    QModelIndex index = nextMessage(startIndex);
+    QModelIndex index = (narrowed && candidates.isEmpty()) ? QModelIndex() : nextMessage(startIndex);
 
     while (index.isValid()) {
         QModelIndex realIndex = m_sortedMessagesModel->mapToSource(index);
         MultiDataIndex dataIndex = m_messageModel->dataIndex(realIndex, -1);
+        const bool candidate = !narrowed
+                || candidates.contains(qMakePair(dataIndex.context(), dataIndex.message()));
         bool hadMessage = false;
-        for (int i = 0; i < m_dataModel->modelCount(); ++i) {
+        for (int i = 0; candidate && i < m_dataModel->modelCount(); ++i) {
             if (MessageItem *m = m_dataModel->messageItem(dataIndex, i)) {
                 if (m_findSkipObsolete && m->isObsolete())
                     continue;
@@ -1560,7 +1614,11 @@ void MainWindow::updateTranslation(const QStringList &translations)
     if (translations == m->translations())
         return;
 
+    DataModel *dm = m_dataModel->model(m_currentIndex.model());
+    dm->messageAboutToChange(m);
     m->setTranslations(translations);
+    dm->messageChanged(m);
+    m_dataModel->updateSearchIndex(m_currentIndex);
     if (!m->fileName().isEmpty() && hasFormPreview(m->fileName()))
         m_formPreviewView->setSourceContext(m_currentIndex.model(), m);
     updateDanger(m_currentIndex, true);
@@ -1580,6 +1638,7 @@ void MainWindow::updateTranslatorComment(const QString &comment)
         return;
 
     m->setTranslatorComment(comment);
+    m_dataModel->updateSearchIndex(m_currentIndex);
 
     m_dataModel->setModified(m_currentIndex.model(), true);
 }
@@ -1795,21 +1854,9 @@ void MainWindow::findNext(const QString &text, DataModel::FindLocation where,
     findAgain();
 }
 
-void MainWindow::revalidate()
-{
-    for (MultiDataModelIterator it(m_dataModel, -1); it.isValid(); ++it)
-        updateDanger(it, false);
-
-    if (m_currentIndex.isValid())
-        updateDanger(m_currentIndex, true);
-}
-
 QString MainWindow::friendlyString(const QString& str)
 {
-    QString f = str.toLower();
-    f.replace(QRegularExpression(QString(QLatin1String("[.,:;!?()-]"))), QString(QLatin1String(" ")));
-    f.remove(QLatin1Char('&'));
-    return f.simplified();
+    return Phrase::friendlyString(str);
 }
 
 void MainWindow::setupMenuBar()
@@ -2423,16 +2470,13 @@ void MainWindow::updatePhraseDictInternal(int model)
         }
         const auto phrases = pb->phrases();
         for (Phrase *p : phrases) {
-            QString f = friendlyString(p->source());
+            const QString f = p->friendlySource();
             if (f.length() > 0) {
-                f = f.split(QLatin1Char(' ')).first();
-                if (!pd.contains(f)) {
-                    pd.insert(f, QList<Phrase *>());
-                }
+                QList<Phrase *> &list = pd[f.left(f.indexOf(QLatin1Char(' ')))];
                 if (before)
-                    pd[f].prepend(p);
+                    list.prepend(p);
                 else
-                    pd[f].append(p);
+                    list.append(p);
             }
         }
     }
@@ -2481,11 +2525,209 @@ static bool haveMnemonic(const QString &str)
     return false;
 }
 
+struct DangerCheckSettings
+{
+    bool accelerators;
+    bool surroundingWhitespace;
+    bool endingPunctuation;
+    bool phraseMatches;
+    bool placeMarkers;
+};
+
+struct DangerError
+{
+    ErrorsView::ErrorType type;
+    QString arg;
+};
+
+// The per-model data the danger checks need.
+struct DangerCheckModel
+{
+    QLocale::Language sourceLanguage = QLocale::C;
+    QLocale::Language language = QLocale::C;
+    QList<bool> countRefNeeds;
+    const QHash<QString, QList<Phrase *> > *phraseDict = nullptr;
+};
+
+/*
+  Runs the enabled validators on the translated message \a m. This touches
+  no GUI state, so it can be run on worker threads. If \a errors is given,
+  all problems found are appended to it.
+*/
+static bool isDangerous(const DangerCheckSettings &settings, const DangerCheckModel &model,
+                        const QString &source, const MessageItem *m, QList<DangerError> *errors)
+{
+    bool danger = false;
+    QStringList translations = m->translations();
+
+    // Truncated variants are permitted to be "denormalized"
+    for (int i = 0; i < translations.count(); ++i) {
+        int sep = translations.at(i).indexOf(QChar(Translator::BinaryVariantSeparator));
+        if (sep >= 0)
+            translations[i].truncate(sep);
+    }
+
+    if (settings.accelerators) {
+        bool sk = haveMnemonic(source);
+        bool tk = true;
+        for (int i = 0; i < translations.count() && tk; ++i) {
+            tk &= haveMnemonic(translations[i]);
+        }
+
+        if (!sk && tk) {
+            if (errors)
+                errors->append({ ErrorsView::SuperfluousAccelerator, QString() });
+            danger = true;
+        } else if (sk && !tk) {
+            if (errors)
+                errors->append({ ErrorsView::MissingAccelerator, QString() });
+            danger = true;
+        }
+    }
+    if (settings.surroundingWhitespace) {
+        bool whitespaceok = true;
+        for (int i = 0; i < translations.count() && whitespaceok; ++i) {
+            whitespaceok &= (leadingWhitespace(source) == leadingWhitespace(translations[i]));
+            whitespaceok &= (trailingWhitespace(source) == trailingWhitespace(translations[i]));
+        }
+
+        if (!whitespaceok) {
+            if (errors)
+                errors->append({ ErrorsView::SurroundingWhitespaceDiffers, QString() });
+            danger = true;
+        }
+    }
+    if (settings.endingPunctuation) {
+        bool endingok = true;
+        for (int i = 0; i < translations.count() && endingok; ++i) {
+            endingok &= (ending(source, model.sourceLanguage) ==
+                        ending(translations[i], model.language));
+        }
+
+        if (!endingok) {
+            if (errors)
+                errors->append({ ErrorsView::PunctuationDiffers, QString() });
+            danger = true;
+        }
+    }
+    if (settings.phraseMatches) {
+        QString fsource = MainWindow::friendlyString(source);
+        QString ftranslation = MainWindow::friendlyString(translations.first());
+        QStringList lookupWords = fsource.split(QLatin1Char(' '));
+
+        bool phraseFound;
+        for (const QString &s : qAsConst(lookupWords)) {
+            const auto it = model.phraseDict->constFind(s);
+            if (it != model.phraseDict->constEnd()) {
+                phraseFound = true;
+                for (const Phrase *p : *it) {
+                    if (fsource == p->friendlySource()) {
+                        if (ftranslation.indexOf(p->friendlyTarget()) >= 0) {
+                            phraseFound = true;
+                            break;
+                        } else {
+                            phraseFound = false;
+                        }
+                    }
+                }
+                if (!phraseFound) {
+                    if (errors)
+                        errors->append({ ErrorsView::IgnoredPhrasebook, s });
+                    danger = true;
+                }
+            }
+        }
+    }
+
+    if (settings.placeMarkers) {
+        // Stores the occurrence count of the place markers in the map placeMarkerIndexes.
+        // i.e. the occurrence count of %1 is stored at placeMarkerIndexes[1],
+        // count of %2 is stored at placeMarkerIndexes[2] etc.
+        // In the first pass, it counts all place markers in the sourcetext.
+        // In the second pass it (de)counts all place markers in the translation.
+        // When finished, all elements should have returned to a count of 0,
+        // if not there is a mismatch
+        // between place markers in the source text and the translation text.
+        QHash<int, int> placeMarkerIndexes;
+        QString translation;
+        int numTranslations = translations.count();
+        for (int pass = 0; pass < numTranslations + 1; ++pass) {
+            const QChar *uc_begin = source.unicode();
+            const QChar *uc_end = uc_begin + source.length();
+            if (pass >= 1) {
+                translation = translations[pass - 1];
+                uc_begin = translation.unicode();
+                uc_end = uc_begin + translation.length();
+            }
+            const QChar *c = uc_begin;
+            while (c < uc_end) {
+                if (c->unicode() == '%') {
+                    const QChar *escape_start = ++c;
+                    while (c->isDigit())
+                        ++c;
+                    const QChar *escape_end = c;
+                    bool ok = true;
+                    int markerIndex = QString::fromRawData(
+                            escape_start, escape_end - escape_start).toInt(&ok);
+                    if (ok)
+                        placeMarkerIndexes[markerIndex] += (pass == 0 ? numTranslations : -1);
+                }
+                ++c;
+            }
+        }
+
+        for (int i : qAsConst(placeMarkerIndexes)) {
+            if (i != 0) {
+                if (errors)
+                    errors->append({ ErrorsView::PlaceMarkersDiffer, QString() });
+                danger = true;
+                break;
+            }
+        }
+
+        // Piggy-backed on the general place markers, we check the plural count marker.
+        if (m->message().isPlural()) {
+            for (int i = 0; i < numTranslations; ++i)
+                if (model.countRefNeeds.at(i)
+                    && !(translations[i].contains(QLatin1String("%n"))
+                    || translations[i].contains(QLatin1String("%Ln")))) {
+                    if (errors)
+                        errors->append({ ErrorsView::NumerusMarkerMissing, QString() });
+                    danger = true;
+                    break;
+                }
+        }
+    }
+    return danger;
+}
+
+DangerCheckSettings MainWindow::dangerCheckSettings() const
+{
+    DangerCheckSettings settings;
+    settings.accelerators = m_ui.actionAccelerators->isChecked();
+    settings.surroundingWhitespace = m_ui.actionSurroundingWhitespace->isChecked();
+    settings.endingPunctuation = m_ui.actionEndingPunctuation->isChecked();
+    settings.phraseMatches = m_ui.actionPhraseMatches->isChecked();
+    settings.placeMarkers = m_ui.actionPlaceMarkerMatches->isChecked();
+    return settings;
+}
+
+DangerCheckModel MainWindow::dangerCheckModel(int model) const
+{
+    DangerCheckModel checkModel;
+    checkModel.sourceLanguage = m_dataModel->sourceLanguage(model);
+    checkModel.language = m_dataModel->language(model);
+    checkModel.countRefNeeds = m_dataModel->model(model)->countRefNeeds();
+    checkModel.phraseDict = &m_phraseDict.at(model);
+    return checkModel;
+}
+
 void MainWindow::updateDanger(const MultiDataIndex &index, bool verbose)
 {
     MultiDataIndex curIdx = index;
     m_errorsView->clear();
 
+    const DangerCheckSettings settings = dangerCheckSettings();
     QString source;
     for (int mi = 0; mi < m_dataModel->modelCount(); ++mi) {
         if (!m_dataModel->isModelWritable(mi))
@@ -2502,154 +2744,91 @@ void MainWindow::updateDanger(const MultiDataIndex &index, bool verbose)
                 if (source.isEmpty())
                     source = m->text();
             }
-            QStringList translations = m->translations();
-
-            // Truncated variants are permitted to be "denormalized"
-            for (int i = 0; i < translations.count(); ++i) {
-                int sep = translations.at(i).indexOf(QChar(Translator::BinaryVariantSeparator));
-                if (sep >= 0)
-                    translations[i].truncate(sep);
-            }
+            QList<DangerError> errors;
+            danger = isDangerous(settings, dangerCheckModel(mi), source, m,
+                                 verbose ? &errors : nullptr);
+            for (const DangerError &error : qAsConst(errors))
+                m_errorsView->addError(mi, error.type, error.arg);
+        }
 
-            if (m_ui.actionAccelerators->isChecked()) {
-                bool sk = haveMnemonic(source);
-                bool tk = true;
-                for (int i = 0; i < translations.count() && tk; ++i) {
-                    tk &= haveMnemonic(translations[i]);
-                }
+        if (danger != m->danger())
+            m_dataModel->setDanger(curIdx, danger);
+    }
 
-                if (!sk && tk) {
-                    if (verbose)
-                        m_errorsView->addError(mi, ErrorsView::SuperfluousAccelerator);
-                    danger = true;
-                } else if (sk && !tk) {
-                    if (verbose)
-                        m_errorsView->addError(mi, ErrorsView::MissingAccelerator);
-                    danger = true;
-                }
-            }
-            if (m_ui.actionSurroundingWhitespace->isChecked()) {
-                bool whitespaceok = true;
-                for (int i = 0; i < translations.count() && whitespaceok; ++i) {
-                    whitespaceok &= (leadingWhitespace(source) == leadingWhitespace(translations[i]));
-                    whitespaceok &= (trailingWhitespace(source) == trailingWhitespace(translations[i]));
-                }
+    if (verbose)
+        statusBar()->showMessage(m_errorsView->firstError());
+}
 
-                if (!whitespaceok) {
-                    if (verbose)
-                        m_errorsView->addError(mi, ErrorsView::SurroundingWhitespaceDiffers);
-                    danger = true;
-                }
-            }
-            if (m_ui.actionEndingPunctuation->isChecked()) {
-                bool endingok = true;
-                for (int i = 0; i < translations.count() && endingok; ++i) {
-                    endingok &= (ending(source, m_dataModel->sourceLanguage(mi)) ==
-                                ending(translations[i], m_dataModel->language(mi)));
-                }
+void MainWindow::revalidate()
+{
+    m_errorsView->clear();
 
-                if (!endingok) {
-                    if (verbose)
-                        m_errorsView->addError(mi, ErrorsView::PunctuationDiffers);
-                    danger = true;
-                }
+    // Collect the translated messages here, check them on all cores and
+    // apply the results back on the GUI thread.
+    struct Check {
+        MultiDataIndex index;
+        const MessageItem *message;
+        QString source;
+        bool danger;
+    };
+    QList<Check> checks;
+    const DangerCheckSettings settings = dangerCheckSettings();
+    QList<DangerCheckModel> models;
+    for (int mi = 0; mi < m_dataModel->modelCount(); ++mi)
+        models.append(m_dataModel->isModelWritable(mi) ? dangerCheckModel(mi) : DangerCheckModel());
+    for (MultiDataModelIterator it(m_dataModel, -1); it.isValid(); ++it) {
+        MultiDataIndex curIdx = it;
+        QString source;
+        for (int mi = 0; mi < m_dataModel->modelCount(); ++mi) {
+            if (!m_dataModel->isModelWritable(mi))
+                continue;
+            curIdx.setModel(mi);
+            MessageItem *m = m_dataModel->messageItem(curIdx);
+            if (!m || m->isObsolete())
+                continue;
+            if (!m->message().isTranslated()) {
+                if (m->danger())
+                    m_dataModel->setDanger(curIdx, false);
+                continue;
             }
-            if (m_ui.actionPhraseMatches->isChecked()) {
-                QString fsource = friendlyString(source);
-                QString ftranslation = friendlyString(translations.first());
-                QStringList lookupWords = fsource.split(QLatin1Char(' '));
-
-                bool phraseFound;
-                for (const QString &s : qAsConst(lookupWords)) {
-                    if (m_phraseDict[mi].contains(s)) {
-                        phraseFound = true;
-                        const auto phrases = m_phraseDict[mi].value(s);
-                        for (const Phrase *p : phrases) {
-                            if (fsource == friendlyString(p->source())) {
-                                if (ftranslation.indexOf(friendlyString(p->target())) >= 0) {
-                                    phraseFound = true;
-                                    break;
-                                } else {
-                                    phraseFound = false;
-                                }
-                            }
-                        }
-                        if (!phraseFound) {
-                            if (verbose)
-                                m_errorsView->addError(mi, ErrorsView::IgnoredPhrasebook, s);
-                            danger = true;
-                        }
-                    }
-                }
+            if (source.isEmpty()) {
+                source = m->pluralText();
+                if (source.isEmpty())
+                    source = m->text();
             }
+            checks.append({ curIdx, m, source, false });
+        }
+    }
 
-            if (m_ui.actionPlaceMarkerMatches->isChecked()) {
-                // Stores the occurrence count of the place markers in the map placeMarkerIndexes.
-                // i.e. the occurrence count of %1 is stored at placeMarkerIndexes[1],
-                // count of %2 is stored at placeMarkerIndexes[2] etc.
-                // In the first pass, it counts all place markers in the sourcetext.
-                // In the second pass it (de)counts all place markers in the translation.
-                // When finished, all elements should have returned to a count of 0,
-                // if not there is a mismatch
-                // between place markers in the source text and the translation text.
-                QHash<int, int> placeMarkerIndexes;
-                QString translation;
-                int numTranslations = translations.count();
-                for (int pass = 0; pass < numTranslations + 1; ++pass) {
-                    const QChar *uc_begin = source.unicode();
-                    const QChar *uc_end = uc_begin + source.length();
-                    if (pass >= 1) {
-                        translation = translations[pass - 1];
-                        uc_begin = translation.unicode();
-                        uc_end = uc_begin + translation.length();
-                    }
-                    const QChar *c = uc_begin;
-                    while (c < uc_end) {
-                        if (c->unicode() == '%') {
-                            const QChar *escape_start = ++c;
-                            while (c->isDigit())
-                                ++c;
-                            const QChar *escape_end = c;
-                            bool ok = true;
-                            int markerIndex = QString::fromRawData(
-                                    escape_start, escape_end - escape_start).toInt(&ok);
-                            if (ok)
-                                placeMarkerIndexes[markerIndex] += (pass == 0 ? numTranslations : -1);
-                        }
-                        ++c;
-                    }
-                }
-
-                for (int i : qAsConst(placeMarkerIndexes)) {
-                    if (i != 0) {
-                        if (verbose)
-                            m_errorsView->addError(mi, ErrorsView::PlaceMarkersDiffer);
-                        danger = true;
-                        break;
-                    }
-                }
-
-                // Piggy-backed on the general place markers, we check the plural count marker.
-                if (m->message().isPlural()) {
-                    for (int i = 0; i < numTranslations; ++i)
-                        if (m_dataModel->model(mi)->countRefNeeds().at(i)
-                            && !(translations[i].contains(QLatin1String("%n"))
-                            || translations[i].contains(QLatin1String("%Ln")))) {
-                            if (verbose)
-                                m_errorsView->addError(mi, ErrorsView::NumerusMarkerMissing);
-                            danger = true;
-                            break;
-                        }
-                }
-            }
+    const int count = checks.size();
+    const int shardCount = qBound(1, QThread::idealThreadCount(), count / 1024 + 1);
+    const int shardSize = (count + shardCount - 1) / shardCount;
+    Check *data = checks.data();
+    auto checkShard = [&](int shard) {
+        const int end = qMin(count, (shard + 1) * shardSize);
+        for (int i = shard * shardSize; i < end; ++i) {
+            Check &check = data[i];
+            check.danger = isDangerous(settings, models.at(check.index.model()),
+                                       check.source, check.message, nullptr);
         }
+    };
+    QSemaphore done;
+    for (int shard = 1; shard < shardCount; ++shard) {
+        QThreadPool::globalInstance()->start([&checkShard, &done, shard]() {
+            checkShard(shard);
+            done.release();
+        });
+    }
+    checkShard(0);
+    done.acquire(shardCount - 1);
 
-        if (danger != m->danger())
-            m_dataModel->setDanger(curIdx, danger);
+    for (const Check &check : qAsConst(checks)) {
+        if (check.danger != check.message->danger())
+            m_dataModel->setDanger(check.index, check.danger);
     }
 
-    if (verbose)
-        statusBar()->showMessage(m_errorsView->firstError());
+    if (m_currentIndex.isValid())
+        updateDanger(m_currentIndex, true);
 }
 
 void MainWindow::readConfig()
@@ -2777,7 +2956,6 @@ void MainWindow::maybeUpdateStatistics(const MultiDataIndex &index)
 void MainWindow::updateStatistics()
 {
     // don't call this if stats dialog is not open
-    // because this can be slow...
     if (!m_statistics || !m_statistics->isVisible() || m_currentIndex.model() < 0)
         return;
 
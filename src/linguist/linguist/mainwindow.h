@@ -65,6 +65,8 @@ class SourceCodeView;
 class Statistics;
 class TranslateDialog;
 class TranslationSettingsDialog;
+struct DangerCheckModel;
+struct DangerCheckSettings;
 
 class MainWindow : public QMainWindow
 {
@@ -198,6 +200,8 @@ private:
 
     // FIXME: move to DataModel
     void updateDanger(const MultiDataIndex &index, bool verbose);
+    DangerCheckSettings dangerCheckSettings() const;
+    DangerCheckModel dangerCheckModel(int model) const;
 
     bool searchItem(DataModel::FindLocation where, const QString &searchWhat);
 
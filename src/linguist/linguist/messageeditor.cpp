@@ -645,10 +645,8 @@ void MessageEditor::showMessage(const MultiDataIndex &index)
                 m_dataModel->model(j)->normalizedTranslations(*item);
             for (int i = 0; i < ed.transTexts.size(); ++i) {
                 bool shouldShow = (i < normalizedTranslations.count());
-                if (shouldShow)
-                    setNumerusTranslation(j, normalizedTranslations.at(i), i);
-                else
-                    setNumerusTranslation(j, QString(), i);
+                ed.transTexts.at(i)->setTranslation(
+                        shouldShow ? normalizedTranslations.at(i) : QString(), false);
                 ed.transTexts.at(i)->setVisible(i == 0 || shouldShow);
             }
         }
@@ -656,6 +654,7 @@ void MessageEditor::showMessage(const MultiDataIndex &index)
         ed.transCommentText->setTranslation(item->translatorComment().trimmed(), false);
     }
 
+    updateBeginFromSource();
     updateUndoRedo();
 }
 
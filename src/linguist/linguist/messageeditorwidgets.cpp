@@ -99,8 +99,36 @@ void ExpandingTextEdit::reallyEnsureCursorVisible()
     }
 }
 
+// Copied from QTextDocument::toPlainText() and modified to
+// not replace QChar::Nbsp with QLatin1Char(' ')
+QString toPlainText(const QString &text)
+{
+    QString txt = text;
+    QChar *uc = txt.data();
+    QChar *e = uc + txt.size();
+
+    for (; uc != e; ++uc) {
+        switch (uc->unicode()) {
+        case 0xfdd0: // QTextBeginningOfFrame
+        case 0xfdd1: // QTextEndOfFrame
+        case QChar::ParagraphSeparator:
+        case QChar::LineSeparator:
+            *uc = QLatin1Char('\n');
+            break;
+        }
+    }
+    return txt;
+}
+
+// The text of an editor as FormMultiWidget::getTranslation() sees it
+static QString documentText(const QTextDocument *document)
+{
+    return toPlainText(document->toRawText());
+}
+
 FormatTextEdit::FormatTextEdit(QWidget *parent)
-    : ExpandingTextEdit(parent)
+    : ExpandingTextEdit(parent),
+      m_rehighlightPending(false)
 {
     setLineWrapMode(QTextEdit::WidgetWidth);
     setAcceptRichText(false);
@@ -142,17 +170,37 @@ void FormatTextEdit::setPlainText(const QString &text, bool userAction)
     if (!userAction) {
         // Prevent contentsChanged signal
         bool oldBlockState = blockSignals(true);
-        document()->setUndoRedoEnabled(false);
-        ExpandingTextEdit::setPlainText(text);
-        // highlighter is out of sync because of blocked signals
-        m_highlighter->rehighlight();
-        document()->setUndoRedoEnabled(true);
+        if (documentText(document()) == text) {
+            // Keep the document and its highlighting, but not the
+            // undo history of the previous message
+            document()->clearUndoRedoStacks();
+            moveCursor(QTextCursor::Start);
+        } else {
+            document()->setUndoRedoEnabled(false);
+            ExpandingTextEdit::setPlainText(text);
+            // highlighter is out of sync because of blocked signals;
+            // hidden editors catch up when they are shown
+            if (isVisible())
+                m_highlighter->rehighlight();
+            else
+                m_rehighlightPending = true;
+            document()->setUndoRedoEnabled(true);
+        }
         blockSignals(oldBlockState);
     } else {
         ExpandingTextEdit::setPlainText(text);
     }
 }
 
+void FormatTextEdit::showEvent(QShowEvent *event)
+{
+    if (m_rehighlightPending) {
+        m_rehighlightPending = false;
+        m_highlighter->rehighlight();
+    }
+    ExpandingTextEdit::showEvent(event);
+}
+
 void FormatTextEdit::setVisualizeWhitespace(bool value)
 {
     QTextOption option = document()->defaultTextOption();
@@ -381,6 +429,7 @@ void FormMultiWidget::setTranslation(const QString &text, bool userAction)
 {
     QStringList texts = text.split(QChar(Translator::BinaryVariantSeparator), Qt::KeepEmptyParts);
 
+    const int oldCount = m_editors.count();
     while (m_editors.count() > texts.count()) {
         delete m_minusButtons.takeLast();
         delete m_plusButtons.takeLast();
@@ -388,7 +437,8 @@ void FormMultiWidget::setTranslation(const QString &text, bool userAction)
     }
     while (m_editors.count() < texts.count())
         addEditor(m_editors.count());
-    updateLayout();
+    if (m_editors.count() != oldCount)
+        updateLayout();
 
     for (int i = 0; i < texts.count(); ++i)
         // XXX this will emit n textChanged signals
@@ -398,27 +448,6 @@ void FormMultiWidget::setTranslation(const QString &text, bool userAction)
         setHidden(text.isEmpty());
 }
 
-// Copied from QTextDocument::toPlainText() and modified to
-// not replace QChar::Nbsp with QLatin1Char(' ')
-QString toPlainText(const QString &text)
-{
-    QString txt = text;
-    QChar *uc = txt.data();
-    QChar *e = uc + txt.size();
-
-    for (; uc != e; ++uc) {
-        switch (uc->unicode()) {
-        case 0xfdd0: // QTextBeginningOfFrame
-        case 0xfdd1: // QTextEndOfFrame
-        case QChar::ParagraphSeparator:
-        case QChar::LineSeparator:
-            *uc = QLatin1Char('\n');
-            break;
-        }
-    }
-    return txt;
-}
-
 QString FormMultiWidget::getTranslation() const
 {
     QString ret;
@@ -435,6 +464,8 @@ void FormMultiWidget::setEditingEnabled(bool enable)
     // Use read-only state so that the text can still be copied
     for (int i = 0; i < m_editors.count(); ++i)
         m_editors.at(i)->setReadOnly(!enable);
+    if (m_label->isEnabled() == enable)
+        return;
     m_label->setEnabled(enable);
     if (m_multiEnabled)
         updateLayout();
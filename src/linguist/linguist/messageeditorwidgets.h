@@ -44,6 +44,7 @@ class QAction;
 class QContextMenuEvent;
 class QKeyEvent;
 class QMenu;
+class QShowEvent;
 class QSizeF;
 class QString;
 class QVariant;
@@ -88,8 +89,12 @@ public slots:
     void setPlainText(const QString & text, bool userAction);
     void setVisualizeWhitespace(bool value);
 
+protected:
+    void showEvent(QShowEvent *event) override;
+
 private:
     MessageHighlighter *m_highlighter;
+    bool m_rehighlightPending;
 };
 
 /*
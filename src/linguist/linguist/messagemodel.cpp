@@ -39,6 +39,8 @@
 
 #include <private/qtranslator_p.h>
 
+#include <algorithm>
+
 #include <limits.h>
 
 QT_BEGIN_NAMESPACE
@@ -124,6 +126,10 @@ DataModel::DataModel(QObject *parent)
     m_sourceCountry(QLocale::Country(-1))
 {}
 
+DataModel::~DataModel()
+{
+}
+
 QStringList DataModel::normalizedTranslations(const MessageItem &m) const
 {
     return Translator::normalizedTranslations(m.message(), m_numerusForms.count());
@@ -186,13 +192,34 @@ bool DataModel::isWellMergeable(const DataModel *other) const
     return calcMergeScore(this, other) + calcMergeScore(other, this) > 90;
 }
 
-bool DataModel::load(const QString &fileName, bool *langGuessed, QWidget *parent)
+LoadedTranslation DataModel::read(const QString &fileName)
 {
-    Translator tor;
+    LoadedTranslation loaded;
+    loaded.fileName = fileName;
     ConversionData cd;
-    bool ok = tor.load(fileName, cd, QLatin1String("auto"));
-    if (!ok) {
-        QMessageBox::warning(parent, QObject::tr("Qt Linguist"), cd.error());
+    Translator &tor = loaded.translator;
+    if (!tor.load(fileName, cd, QLatin1String("auto"))) {
+        loaded.error = cd.error();
+        return loaded;
+    }
+    loaded.ok = true;
+    if (!tor.messageCount())
+        return loaded;
+
+    loaded.duplicates = tor.resolveDuplicates();
+    for (const TranslatorMessage &msg : tor.messages()) {
+        if (msg.sourceText() != QLatin1String(ContextComment))
+            loaded.matrices.append(CoMatrix(msg.sourceText()));
+    }
+    return loaded;
+}
+
+bool DataModel::load(const LoadedTranslation &loaded, bool *langGuessed, QWidget *parent)
+{
+    const QString &fileName = loaded.fileName;
+    const Translator &tor = loaded.translator;
+    if (!loaded.ok) {
+        QMessageBox::warning(parent, QObject::tr("Qt Linguist"), loaded.error);
         return false;
     }
 
@@ -203,7 +230,7 @@ bool DataModel::load(const QString &fileName, bool *langGuessed, QWidget *parent
         return false;
     }
 
-    const Translator::Duplicates dupes = tor.resolveDuplicates();
+    const Translator::Duplicates &dupes = loaded.duplicates;
     if (!dupes.byId.isEmpty() || !dupes.byContents.isEmpty()) {
         QString err = tr("<qt>Duplicate messages found in '%1':").arg(fileName.toHtmlEscaped());
         int numdups = 0;
@@ -236,6 +263,7 @@ bool DataModel::load(const QString &fileName, bool *langGuessed, QWidget *parent
     m_numMessages = 0;
 
     QHash<QString, int> contexts;
+    QSharedPointer<SimilarityIndex> similarityIndex(new SimilarityIndex);
 
     m_srcWords = 0;
     m_srcChars = 0;
@@ -261,8 +289,14 @@ bool DataModel::load(const QString &fileName, bool *langGuessed, QWidget *parent
             }
             c->appendMessage(tmp);
             ++m_numMessages;
+
+            similarityIndex->matrices.append(loaded.matrices.at(similarityIndex->lengths.size()));
+            similarityIndex->lengths.append(tmp.text().size());
+            similarityIndex->messages.append(
+                    DataIndex(contexts.value(msg.context()), c->messageCount() - 1));
         }
     }
+    m_similarityIndex = similarityIndex;
 
     // Try to detect the correct language in the following order
     // 1. Look for the language attribute in the ts
@@ -425,39 +459,50 @@ void DataModel::setSourceLanguageAndCountry(QLocale::Language lang, QLocale::Cou
     setModified(true);
 }
 
+void DataModel::countMessage(const MessageItem *mi, int sign)
+{
+    StatisticalData &stats = *m_stats;
+    if (mi->isObsolete()) {
+        stats.obsoleteMsg += sign;
+        return;
+    }
+    if (!mi->isFinished() && !mi->isUnfinished())
+        return;
+    int words = 0, chars = 0, charsSpaces = 0;
+    const QStringList translations = mi->translations();
+    for (const QString &trnsl : translations)
+        doCharCounting(trnsl, words, chars, charsSpaces);
+    const bool hasDanger = !translations.isEmpty() && mi->danger();
+    if (mi->isFinished()) {
+        stats.wordsFinished += sign * words;
+        stats.charsFinished += sign * chars;
+        stats.charsSpacesFinished += sign * charsSpaces;
+        if (hasDanger)
+            stats.translatedMsgDanger += sign;
+        else
+            stats.translatedMsgNoDanger += sign;
+    } else {
+        stats.wordsUnfinished += sign * words;
+        stats.charsUnfinished += sign * chars;
+        stats.charsSpacesUnfinished += sign * charsSpaces;
+        if (hasDanger)
+            stats.unfinishedMsgDanger += sign;
+        else
+            stats.unfinishedMsgNoDanger += sign;
+    }
+}
+
 void DataModel::updateStatistics()
 {
-    StatisticalData stats {};
-    for (DataModelIterator it(this); it.isValid(); ++it) {
-        const MessageItem *mi = it.current();
-        if (mi->isObsolete()) {
-            stats.obsoleteMsg++;
-        } else if (mi->isFinished()) {
-            bool hasDanger = false;
-            for (const QString &trnsl : mi->translations()) {
-                doCharCounting(trnsl, stats.wordsFinished, stats.charsFinished, stats.charsSpacesFinished);
-                hasDanger |= mi->danger();
-            }
-            if (hasDanger)
-                stats.translatedMsgDanger++;
-            else
-                stats.translatedMsgNoDanger++;
-        } else if (mi->isUnfinished()) {
-            bool hasDanger = false;
-            for (const QString &trnsl : mi->translations()) {
-                doCharCounting(trnsl, stats.wordsUnfinished, stats.charsUnfinished, stats.charsSpacesUnfinished);
-                hasDanger |= mi->danger();
-            }
-            if (hasDanger)
-                stats.unfinishedMsgDanger++;
-            else
-                stats.unfinishedMsgNoDanger++;
-        }
+    if (!m_stats) {
+        m_stats.reset(new StatisticalData {});
+        for (DataModelIterator it(this); it.isValid(); ++it)
+            countMessage(it.current(), 1);
+        m_stats->wordsSource = m_srcWords;
+        m_stats->charsSource = m_srcChars;
+        m_stats->charsSpacesSource = m_srcCharsSpc;
     }
-    stats.wordsSource = m_srcWords;
-    stats.charsSource = m_srcChars;
-    stats.charsSpacesSource = m_srcCharsSpc;
-    emit statsChanged(stats);
+    emit statsChanged(*m_stats);
 }
 
 void DataModel::setModified(bool isModified)
@@ -543,7 +588,8 @@ MultiContextItem::MultiContextItem(int oldCount, ContextItem *ctx, bool writable
       m_comment(ctx->comment()),
       m_finishedCount(0),
       m_editableCount(0),
-      m_nonobsoleteCount(0)
+      m_nonobsoleteCount(0),
+      m_indexOk(true)
 {
     QList<MessageItem *> mList;
     QList<MessageItem *> eList;
@@ -552,6 +598,7 @@ MultiContextItem::MultiContextItem(int oldCount, ContextItem *ctx, bool writable
         mList.append(m);
         eList.append(0);
         m_multiMessageList.append(MultiMessageItem(m));
+        indexMessage(j);
     }
     for (int i = 0; i < oldCount; ++i) {
         m_messageLists.append(eList);
@@ -609,8 +656,11 @@ void MultiContextItem::appendMessageItems(const QList<MessageItem *> &m)
     for (int i = 0; i < m_messageLists.count() - 1; ++i)
         m_messageLists[i] += nullItems;
     m_messageLists.last() += m;
-    for (MessageItem *mi : m)
+    for (MessageItem *mi : m) {
         m_multiMessageList.append(MultiMessageItem(mi));
+        if (m_indexOk)
+            indexMessage(m_multiMessageList.count() - 1);
+    }
 }
 
 void MultiContextItem::removeMultiMessageItem(int pos)
@@ -618,6 +668,29 @@ void MultiContextItem::removeMultiMessageItem(int pos)
     for (int i = 0; i < m_messageLists.count(); ++i)
         m_messageLists[i].removeAt(pos);
     m_multiMessageList.removeAt(pos);
+    m_indexOk = false;
+}
+
+void MultiContextItem::indexMessage(int msgIdx) const
+{
+    // Like the linear search this replaces, find the first match
+    const MultiMessageItem &m = m_multiMessageList.at(msgIdx);
+    const QPair<QString, QString> key(m.text(), m.comment());
+    if (!m_messageIndex.contains(key))
+        m_messageIndex.insert(key, msgIdx);
+    if (!m.id().isEmpty() && !m_idIndex.contains(m.id()))
+        m_idIndex.insert(m.id(), msgIdx);
+}
+
+void MultiContextItem::ensureIndexed() const
+{
+    if (m_indexOk)
+        return;
+    m_messageIndex.clear();
+    m_idIndex.clear();
+    for (int i = 0; i < m_multiMessageList.count(); ++i)
+        indexMessage(i);
+    m_indexOk = true;
 }
 
 int MultiContextItem::firstNonobsoleteMessageIndex(int msgIdx) const
@@ -630,22 +703,16 @@ int MultiContextItem::firstNonobsoleteMessageIndex(int msgIdx) const
 
 int MultiContextItem::findMessage(const QString &sourcetext, const QString &comment) const
 {
-    for (int i = 0, cnt = messageCount(); i < cnt; ++i) {
-        MultiMessageItem *m = multiMessageItem(i);
-        if (m->text() == sourcetext && m->comment() == comment)
-            return i;
-    }
-    return -1;
+    ensureIndexed();
+    return m_messageIndex.value(qMakePair(sourcetext, comment), -1);
 }
 
 int MultiContextItem::findMessageById(const QString &id) const
 {
-    for (int i = 0, cnt = messageCount(); i < cnt; ++i) {
-        MultiMessageItem *m = multiMessageItem(i);
-        if (m->id() == id)
-            return i;
-    }
-    return -1;
+    if (id.isEmpty())
+        return -1;
+    ensureIndexed();
+    return m_idIndex.value(id, -1);
 }
 
 /******************************************************************************
@@ -669,7 +736,9 @@ MultiDataModel::MultiDataModel(QObject *parent) :
     m_numFinished(0),
     m_numEditable(0),
     m_numMessages(0),
-    m_modified(false)
+    m_modified(false),
+    m_contextIndexOk(true),
+    m_searchIndexOk(false)
 {
     for (int i = 0; i < 7; ++i)
         m_colors[i] = QColor(paletteRGBs[i][0], paletteRGBs[i][1], paletteRGBs[i][2]);
@@ -773,6 +842,8 @@ void MultiDataModel::append(DataModel *dm, bool readWrite)
                 m_numMessages += appendItems.size();
             }
         } else {
+            if (m_contextIndexOk)
+                m_contextIndex.insert(c->context(), m_multiContextList.size());
             m_multiContextList << MultiContextItem(modelCount() - 1, c, readWrite);
             m_numMessages += c->messageCount();
             ++appendedContexts;
@@ -786,6 +857,7 @@ void MultiDataModel::append(DataModel *dm, bool readWrite)
         m_msgModel->endInsertRows();
     }
     dm->setWritable(readWrite);
+    invalidateSearchIndex();
     updateCountsOnAdd(modelCount() - 1, readWrite);
     connect(dm, &DataModel::modifiedChanged,
             this, &MultiDataModel::onModifiedChanged);
@@ -810,6 +882,7 @@ void MultiDataModel::close(int model)
             m_msgModel->endRemoveColumns();
         }
         delete m_dataModels.takeAt(model);
+        invalidateSearchIndex();
         m_msgModel->endRemoveColumns();
         emit modelDeleted(model);
         for (int i = m_multiContextList.size(); --i >= 0;) {
@@ -825,6 +898,7 @@ void MultiDataModel::close(int model)
             if (!mc.messageCount()) {
                 m_msgModel->beginRemoveRows(QModelIndex(), i, i);
                 m_multiContextList.removeAt(i);
+                m_contextIndexOk = false;
                 m_msgModel->endRemoveRows();
             }
         }
@@ -841,6 +915,9 @@ void MultiDataModel::closeAll()
     qDeleteAll(m_dataModels);
     m_dataModels.clear();
     m_multiContextList.clear();
+    m_contextIndex.clear();
+    m_contextIndexOk = true;
+    invalidateSearchIndex();
     m_msgModel->endResetModel();
     emit allModelsDeleted();
     onModifiedChanged();
@@ -970,22 +1047,19 @@ int MultiDataModel::isFileLoaded(const QString &name) const
 
 int MultiDataModel::findContextIndex(const QString &context) const
 {
-    for (int i = 0; i < m_multiContextList.size(); ++i) {
-        const MultiContextItem &mc = m_multiContextList[i];
-        if (mc.context() == context)
-            return i;
+    if (!m_contextIndexOk) {
+        m_contextIndex.clear();
+        for (int i = m_multiContextList.size(); --i >= 0;)
+            m_contextIndex.insert(m_multiContextList.at(i).context(), i);
+        m_contextIndexOk = true;
     }
-    return -1;
+    return m_contextIndex.value(context, -1);
 }
 
 MultiContextItem *MultiDataModel::findContext(const QString &context) const
 {
-    for (int i = 0; i < m_multiContextList.size(); ++i) {
-        const MultiContextItem &mc = m_multiContextList[i];
-        if (mc.context() == context)
-            return const_cast<MultiContextItem *>(&mc);
-    }
-    return 0;
+    int idx = findContextIndex(context);
+    return idx >= 0 ? multiContextItem(idx) : 0;
 }
 
 MessageItem *MultiDataModel::messageItem(const MultiDataIndex &index, int model) const
@@ -1005,20 +1079,141 @@ void MultiDataModel::setTranslation(const MultiDataIndex &index, const QString &
     MessageItem *m = messageItem(index);
     if (translation == m->translation())
         return;
+    DataModel *dm = m_dataModels[index.model()];
+    dm->messageAboutToChange(m);
     m->setTranslation(translation);
+    dm->messageChanged(m);
+    updateSearchIndex(index);
     setModified(index.model(), true);
     emit translationChanged(index);
 }
 
+void MultiDataModel::updateSearchIndex(const MultiDataIndex &index)
+{
+    if (!m_searchIndexOk)
+        return;
+    if (MessageItem *m = messageItem(index))
+        indexMessageText(index.context(), index.message(), m, true);
+}
+
+// Calls func for each trigram of the case-folded text, skipping accelerators.
+template <typename Func>
+static void forEachTrigram(const QString &text, Func func)
+{
+    quint64 trigram = 0;
+    int length = 0;
+    for (const QChar c : text) {
+        if (c == QLatin1Char('&'))
+            continue;
+        trigram = ((trigram << 16) | c.toCaseFolded().unicode()) & Q_UINT64_C(0xffffffffffff);
+        if (++length >= 3)
+            func(trigram);
+    }
+}
+
+void MultiDataModel::indexMessageText(int ctxIdx, int msgIdx, MessageItem *m,
+                                      bool editableOnly) const
+{
+    const QPair<int, int> key(ctxIdx, msgIdx);
+    auto add = [&key](TrigramIndex &index, const QString &text) {
+        forEachTrigram(text, [&](quint64 trigram) {
+            QList<QPair<int, int> > &list = index[trigram];
+            if (list.isEmpty() || list.constLast() != key)
+                list.append(key);
+        });
+    };
+
+    if (!editableOnly) {
+        add(m_searchIndex[0], m->text());
+        add(m_searchIndex[0], m->pluralText());
+        add(m_searchIndex[2], m->comment());
+        add(m_searchIndex[2], m->extraComment());
+    }
+    const QStringList translations = m->translations();
+    for (const QString &trans : translations)
+        add(m_searchIndex[1], trans);
+    add(m_searchIndex[2], m->translatorComment());
+}
+
+void MultiDataModel::ensureSearchIndexed() const
+{
+    if (m_searchIndexOk)
+        return;
+    for (int i = 0; i < m_multiContextList.size(); ++i) {
+        const MultiContextItem &mc = m_multiContextList.at(i);
+        for (int j = 0; j < mc.messageCount(); ++j) {
+            for (int k = 0; k < modelCount(); ++k) {
+                if (MessageItem *m = mc.messageItem(k, j))
+                    indexMessageText(i, j, m, false);
+            }
+        }
+    }
+    m_searchIndexOk = true;
+}
+
+void MultiDataModel::invalidateSearchIndex()
+{
+    for (TrigramIndex &index : m_searchIndex)
+        index.clear();
+    m_searchIndexOk = false;
+}
+
+bool MultiDataModel::searchCandidates(const QString &text, int where,
+                                      QSet<QPair<int, int> > *candidates) const
+{
+    QList<quint64> trigrams;
+    forEachTrigram(text, [&trigrams](quint64 trigram) { trigrams.append(trigram); });
+    if (trigrams.isEmpty())
+        return false;
+
+    ensureSearchIndexed();
+    candidates->clear();
+    for (int loc = 0; loc < 3; ++loc) {
+        if (!(where & (1 << loc)))
+            continue;
+        const TrigramIndex &index = m_searchIndex[loc];
+        QList<const QList<QPair<int, int> > *> lists;
+        for (quint64 trigram : qAsConst(trigrams)) {
+            const auto it = index.constFind(trigram);
+            if (it == index.constEnd()) {
+                lists.clear();
+                break;
+            }
+            lists.append(&*it);
+        }
+        if (lists.isEmpty())
+            continue;
+
+        // Intersect, starting with the rarest trigram
+        std::sort(lists.begin(), lists.end(),
+                  [](const QList<QPair<int, int> > *a, const QList<QPair<int, int> > *b) {
+                      return a->size() < b->size();
+                  });
+        QSet<QPair<int, int> > found(lists.first()->cbegin(), lists.first()->cend());
+        for (int i = 1; i < lists.size() && !found.isEmpty(); ++i) {
+            QSet<QPair<int, int> > next;
+            for (const QPair<int, int> &key : *lists.at(i))
+                if (found.contains(key))
+                    next.insert(key);
+            found.swap(next);
+        }
+        candidates->unite(found);
+    }
+    return true;
+}
+
 void MultiDataModel::setFinished(const MultiDataIndex &index, bool finished)
 {
     MultiContextItem *mc = multiContextItem(index.context());
     MultiMessageItem *mm = mc->multiMessageItem(index.message());
     ContextItem *c = contextItem(index);
     MessageItem *m = messageItem(index);
+    DataModel *dm = m_dataModels[index.model()];
     TranslatorMessage::Type type = m->type();
     if (type == TranslatorMessage::Unfinished && finished) {
+        dm->messageAboutToChange(m);
         m->setType(TranslatorMessage::Finished);
+        dm->messageChanged(m);
         mm->decrementUnfinishedCount();
         if (!mm->countUnfinished()) {
             incrementFinishedCount();
@@ -1038,7 +1233,9 @@ void MultiDataModel::setFinished(const MultiDataIndex &index, bool finished)
         emit messageDataChanged(index);
         setModified(index.model(), true);
     } else if (type == TranslatorMessage::Finished && !finished) {
+        dm->messageAboutToChange(m);
         m->setType(TranslatorMessage::Unfinished);
+        dm->messageChanged(m);
         mm->incrementUnfinishedCount();
         if (mm->countUnfinished() == 1) {
             decrementFinishedCount();
@@ -1064,6 +1261,7 @@ void MultiDataModel::setDanger(const MultiDataIndex &index, bool danger)
 {
     ContextItem *c = contextItem(index);
     MessageItem *m = messageItem(index);
+    DataModel *dm = m_dataModels[index.model()];
     if (!m->danger() && danger) {
         if (m->isFinished()) {
             c->incrementFinishedDangerCount();
@@ -1075,7 +1273,9 @@ void MultiDataModel::setDanger(const MultiDataIndex &index, bool danger)
                 emit contextDataChanged(index);
         }
         emit messageDataChanged(index);
+        dm->messageAboutToChange(m);
         m->setDanger(danger);
+        dm->messageChanged(m);
     } else if (m->danger() && !danger) {
         if (m->isFinished()) {
             c->decrementFinishedDangerCount();
@@ -1087,7 +1287,9 @@ void MultiDataModel::setDanger(const MultiDataIndex &index, bool danger)
                 emit contextDataChanged(index);
         }
         emit messageDataChanged(index);
+        dm->messageAboutToChange(m);
         m->setDanger(danger);
+        dm->messageChanged(m);
     }
 }
 
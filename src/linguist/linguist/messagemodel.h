@@ -29,12 +29,17 @@
 #ifndef MESSAGEMODEL_H
 #define MESSAGEMODEL_H
 
+#include "simtexth.h"
 #include "translator.h"
 
 #include <QtCore/QAbstractItemModel>
 #include <QtCore/QList>
 #include <QtCore/QHash>
 #include <QtCore/QLocale>
+#include <QtCore/QPair>
+#include <QtCore/QScopedPointer>
+#include <QtCore/QSet>
+#include <QtCore/QSharedPointer>
 #include <QtGui/QColor>
 #include <QtGui/QBitmap>
 
@@ -150,6 +155,17 @@ protected:
 };
 
 
+// The co-occurrence matrices of the source texts of a DataModel, for
+// guessing translations from similar messages. Source texts do not change
+// after loading, so the index is immutable and may be read from any thread.
+struct SimilarityIndex
+{
+    QList<CoMatrix> matrices;
+    QList<int> lengths;
+    QList<DataIndex> messages;
+};
+
+
 class DataModelIterator : public DataIndex
 {
 public:
@@ -163,11 +179,24 @@ private:
 };
 
 
+// A translation file as read by DataModel::read(), which may run on any
+// thread. DataModel::load() turns it into a model on the GUI thread.
+struct LoadedTranslation
+{
+    QString fileName;
+    Translator translator;
+    Translator::Duplicates duplicates;
+    QList<CoMatrix> matrices; // For the messages which are not context comments
+    QString error;
+    bool ok = false;
+};
+
 class DataModel : public QObject
 {
     Q_OBJECT
 public:
     DataModel(QObject *parent = 0);
+    ~DataModel();
 
     enum FindLocation { NoLocation = 0, SourceText = 0x1, Translations = 0x2, Comments = 0x4 };
 
@@ -188,7 +217,8 @@ public:
     void setWritable(bool writable) { m_writable = writable; }
 
     bool isWellMergeable(const DataModel *other) const;
-    bool load(const QString &fileName, bool *langGuessed, QWidget *parent);
+    static LoadedTranslation read(const QString &fileName);
+    bool load(const LoadedTranslation &loaded, bool *langGuessed, QWidget *parent);
     bool save(QWidget *parent) { return save(m_srcFileName, parent); }
     bool saveAs(const QString &newFileName, QWidget *parent);
     bool release(const QString &fileName, bool verbose,
@@ -213,11 +243,17 @@ public:
     QStringList normalizedTranslations(const MessageItem &m) const;
     void doCharCounting(const QString& text, int& trW, int& trC, int& trCS);
     void updateStatistics();
+    // Keep the statistics current when a message is modified: call the first
+    // before and the second after changing it.
+    void messageAboutToChange(const MessageItem *m) { if (m_stats) countMessage(m, -1); }
+    void messageChanged(const MessageItem *m) { if (m_stats) countMessage(m, 1); }
 
     int getSrcWords() const { return m_srcWords; }
     int getSrcChars() const { return m_srcChars; }
     int getSrcCharsSpc() const { return m_srcCharsSpc; }
 
+    QSharedPointer<const SimilarityIndex> similarityIndex() const { return m_similarityIndex; }
+
 signals:
     void statsChanged(const StatisticalData &newStats);
     void progressChanged(int finishedCount, int oldFinishedCount);
@@ -230,6 +266,7 @@ private:
 
     bool save(const QString &fileName, QWidget *parent);
     void updateLocale();
+    void countMessage(const MessageItem *mi, int sign);
 
     bool m_writable;
     bool m_modified;
@@ -240,6 +277,11 @@ private:
     int m_srcWords;
     int m_srcChars;
     int m_srcCharsSpc;
+    // Counts of the translations, computed on the first request and then
+    // adjusted as messages change
+    QScopedPointer<StatisticalData> m_stats;
+
+    QSharedPointer<const SimilarityIndex> m_similarityIndex;
 
     QString m_srcFileName;
     QLocale::Language m_language;
@@ -331,6 +373,8 @@ private:
     void decrementEditableCount() { --m_editableCount; }
     void incrementNonobsoleteCount() { ++m_nonobsoleteCount; }
     void decrementNonobsoleteCount() { --m_nonobsoleteCount; }
+    void indexMessage(int msgIdx) const;
+    void ensureIndexed() const;
 
     QString m_context;
     QString m_comment;
@@ -342,6 +386,11 @@ private:
     int m_finishedCount; // read-write
     int m_editableCount; // read-write
     int m_nonobsoleteCount; // all (note: this counts messages, not multi-messages)
+    // Lookup tables for findMessage() and findMessageById(), pointing to the
+    // first matching message. Removing messages invalidates them.
+    mutable QHash<QPair<QString, QString>, int> m_messageIndex;
+    mutable QHash<QString, int> m_idIndex;
+    mutable bool m_indexOk;
 };
 
 
@@ -419,11 +468,23 @@ public:
     void setModified(int model, bool dirty) { m_dataModels[model]->setModified(dirty); }
     QLocale::Language language(int model) const { return m_dataModels[model]->language(); }
     QLocale::Language sourceLanguage(int model) const { return m_dataModels[model]->sourceLanguage(); }
+    QSharedPointer<const SimilarityIndex> similarityIndex(int model) const
+        { return m_dataModels[model]->similarityIndex(); }
 
     // Per message
     void setTranslation(const MultiDataIndex &index, const QString &translation);
     void setFinished(const MultiDataIndex &index, bool finished);
     void setDanger(const MultiDataIndex &index, bool danger);
+    // To be called after editing the translations or the translator comment
+    // of a message directly through its MessageItem.
+    void updateSearchIndex(const MultiDataIndex &index);
+
+    // Narrows down a plain-text search. Returns false if the text is too short
+    // for the trigram index; otherwise fills candidates with the (context, message)
+    // pairs which may contain the text, ignoring case and accelerators, in one of
+    // the locations in where. The caller still needs to verify each candidate.
+    bool searchCandidates(const QString &text, int where,
+                          QSet<QPair<int, int> > *candidates) const;
 
     // Retrieve items
     DataModel *model(int i) { return m_dataModels[i]; }
@@ -470,6 +531,9 @@ private:
     void decrementFinishedCount() { --m_numFinished; }
     void incrementEditableCount() { ++m_numEditable; }
     void decrementEditableCount() { --m_numEditable; }
+    void ensureSearchIndexed() const;
+    void indexMessageText(int ctxIdx, int msgIdx, MessageItem *m, bool editableOnly) const;
+    void invalidateSearchIndex();
 
     int m_numFinished;
     int m_numEditable;
@@ -478,6 +542,14 @@ private:
     bool m_modified;
 
     QList<MultiContextItem> m_multiContextList;
+    mutable QHash<QString, int> m_contextIndex; // Only valid if m_contextIndexOk
+    mutable bool m_contextIndexOk;
+    // Trigrams of the case-folded texts, per FindLocation bit, pointing to the
+    // (context, message) pairs containing them. Built on the first search; edits
+    // only add entries, so the lists may contain stale candidates.
+    typedef QHash<quint64, QList<QPair<int, int> > > TrigramIndex;
+    mutable TrigramIndex m_searchIndex[3];
+    mutable bool m_searchIndexOk;
     QList<DataModel *> m_dataModels;
 
     MessageModel *m_msgModel;
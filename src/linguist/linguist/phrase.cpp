@@ -57,14 +57,15 @@ Phrase::Phrase()
 
 Phrase::Phrase(const QString &source, const QString &target, const QString &definition,
                const Candidate &candidate, int sc)
-    : shrtc(sc), s(source), t(target), d(definition), cand(candidate), m_phraseBook(0)
+    : shrtc(sc), s(source), t(target), fs(friendlyString(source)), ft(friendlyString(target)),
+      d(definition), cand(candidate), m_phraseBook(0)
 {
 }
 
 Phrase::Phrase(const QString &source, const QString &target,
                const QString &definition, PhraseBook *phraseBook)
-    : shrtc(-1), s(source), t(target), d(definition),
-      m_phraseBook(phraseBook)
+    : shrtc(-1), s(source), t(target), fs(friendlyString(source)), ft(friendlyString(target)),
+      d(definition), m_phraseBook(phraseBook)
 {
 }
 
@@ -73,6 +74,7 @@ void Phrase::setSource(const QString &ns)
     if (s == ns)
         return;
     s = ns;
+    fs = friendlyString(ns);
     if (m_phraseBook)
         m_phraseBook->phraseChanged(this);
 }
@@ -82,6 +84,7 @@ void Phrase::setTarget(const QString &nt)
     if (t == nt)
         return;
     t = nt;
+    ft = friendlyString(nt);
     if (m_phraseBook)
         m_phraseBook->phraseChanged(this);
 }
@@ -95,6 +98,37 @@ void Phrase::setDefinition(const QString &nd)
         m_phraseBook->phraseChanged(this);
 }
 
+// Lower-cases the string, turns the punctuation in ".,:;!?()-" into word
+// separators, drops '&' mnemonics and collapses all whitespace, in one pass.
+QString Phrase::friendlyString(const QString &str)
+{
+    const QString lower = str.toLower();
+    QString f;
+    f.reserve(lower.size());
+    bool pendingSpace = false;
+    for (const QChar c : lower) {
+        switch (c.unicode()) {
+        case '&':
+            continue;
+        case '.': case ',': case ':': case ';': case '!': case '?':
+        case '(': case ')': case '-':
+            pendingSpace = !f.isEmpty();
+            continue;
+        default:
+            if (c.isSpace()) {
+                pendingSpace = !f.isEmpty();
+                continue;
+            }
+        }
+        if (pendingSpace) {
+            f += QLatin1Char(' ');
+            pendingSpace = false;
+        }
+        f += c;
+    }
+    return f;
+}
+
 bool operator==(const Phrase &p, const Phrase &q)
 {
     return p.source() == q.source() && p.target() == q.target() &&
@@ -55,15 +55,23 @@ public:
     void setTarget(const QString &nt);
     QString definition() const {return d;}
     void setDefinition (const QString &nd);
+    // Lower-cased, punctuation-free forms used for phrase matching; kept
+    // up to date by setSource() and setTarget().
+    QString friendlySource() const { return fs; }
+    QString friendlyTarget() const { return ft; }
     int shortcut() const { return shrtc; }
     Candidate candidate() const { return cand; }
     PhraseBook *phraseBook() const { return m_phraseBook; }
     void setPhraseBook(PhraseBook *book) { m_phraseBook = book; }
 
+    static QString friendlyString(const QString &str);
+
 private:
     int shrtc;
     QString s;
     QString t;
+    QString fs;
+    QString ft;
     QString d;
     Candidate cand;
     PhraseBook *m_phraseBook;
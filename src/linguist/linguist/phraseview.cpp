@@ -36,12 +36,17 @@
 
 #include <QHeaderView>
 #include <QKeyEvent>
+#include <QPromise>
 #include <QSettings>
 #include <QShortcut>
+#include <QThreadPool>
 #include <QTreeView>
 #include <QWidget>
 #include <QDebug>
 
+#include <algorithm>
+#include <memory>
+
 
 QT_BEGIN_NAMESPACE
 
@@ -81,10 +86,13 @@ PhraseView::PhraseView(MultiDataModel *model, QList<QHash<QString, QList<Phrase
 
     connect(this, &QAbstractItemView::activated,
             this, &PhraseView::selectPhrase);
+    connect(&m_guessWatcher, &QFutureWatcherBase::finished,
+            this, &PhraseView::showGuesses);
 }
 
 PhraseView::~PhraseView()
 {
+    m_guessWatcher.cancel();
     QSettings().setValue(phraseViewHeaderKey(), header()->saveState());
     deleteGuesses();
 }
@@ -197,60 +205,14 @@ void PhraseView::resetNumGuesses()
     setSourceText(m_modelIndex, m_sourceText);
 }
 
-static CandidateList similarTextHeuristicCandidates(MultiDataModel *model, int mi,
-    const char *text, int maxCandidates)
-{
-    QList<int> scores;
-    CandidateList candidates;
-
-    StringSimilarityMatcher stringmatcher(QString::fromLatin1(text));
-
-    for (MultiDataModelIterator it(model, mi); it.isValid(); ++it) {
-        MessageItem *m = it.current();
-        if (!m)
-            continue;
-
-        TranslatorMessage mtm = m->message();
-        if (mtm.type() == TranslatorMessage::Unfinished
-            || mtm.translation().isEmpty())
-            continue;
-
-        QString s = m->text();
-
-        int score = stringmatcher.getSimilarityScore(s);
-
-        if (candidates.count() == maxCandidates && score > scores[maxCandidates - 1])
-            candidates.removeLast();
-        if (candidates.count() < maxCandidates && score >= textSimilarityThreshold ) {
-            Candidate cand(mtm.context(), s, mtm.comment(), mtm.translation());
-
-            int i;
-            for (i = 0; i < candidates.size(); ++i) {
-                if (score >= scores.at(i)) {
-                    if (score == scores.at(i)) {
-                        if (candidates.at(i) == cand)
-                            goto continue_outer_loop;
-                    } else {
-                        break;
-                    }
-                }
-            }
-            scores.insert(i, score);
-            candidates.insert(i, cand);
-        }
-        continue_outer_loop:
-        ;
-    }
-    return candidates;
-}
-
-
 void PhraseView::setSourceText(int model, const QString &sourceText)
 {
     m_modelIndex = model;
     m_sourceText = sourceText;
     m_phraseModel->removePhrases();
     deleteGuesses();
+    m_guessWatcher.cancel();
+    m_guessIndex.reset();
 
     if (model < 0)
         return;
@@ -259,23 +221,101 @@ void PhraseView::setSourceText(int model, const QString &sourceText)
     for (Phrase *p : phrases)
         m_phraseModel->addPhrase(p);
 
-    if (!sourceText.isEmpty() && m_doGuesses) {
-        const CandidateList cl = similarTextHeuristicCandidates(m_dataModel, model,
-            sourceText.toLatin1(), m_maxCandidates);
-        int n = 0;
-        for (const Candidate &candidate : cl) {
-            QString def;
-            if (n < 9)
-                def = tr("Guess from '%1' (%2)")
-                      .arg(candidate.context, QKeySequence(Qt::CTRL | (Qt::Key_0 + (n + 1)))
-                                              .toString(QKeySequence::NativeText));
-            else
-                def = tr("Guess from '%1'").arg(candidate.context);
-            Phrase *guess = new Phrase(candidate.source, candidate.translation, def, candidate, n);
-            m_guesses.append(guess);
-            m_phraseModel->addPhrase(guess);
-            ++n;
+    if (!sourceText.isEmpty() && m_doGuesses)
+        startGuessing(sourceText);
+}
+
+/*
+  Scores the source text against all messages of the current model on a
+  worker thread. The worker only reads the immutable similarity index of
+  the model; whether a message can serve as a guess depends on its current
+  translation and is decided in showGuesses(), on the GUI thread.
+*/
+void PhraseView::startGuessing(const QString &sourceText)
+{
+    m_guessIndex = m_dataModel->similarityIndex(m_modelIndex);
+    if (!m_guessIndex)
+        return;
+
+    auto promise = std::make_shared<QPromise<SimilarMessages>>();
+    promise->start();
+    m_guessWatcher.setFuture(promise->future());
+
+    const QString text = QString::fromLatin1(sourceText.toLatin1());
+    QThreadPool::globalInstance()->start([promise, index = m_guessIndex, text]() {
+        const int chunkSize = 1024;
+        int scores[chunkSize];
+        const StringSimilarityMatcher matcher(text);
+        const int count = index->matrices.size();
+        SimilarMessages similar;
+        for (int begin = 0; begin < count; begin += chunkSize) {
+            if (promise->isCanceled())
+                break;
+            const int n = qMin(chunkSize, count - begin);
+            matcher.getSimilarityScores(index->matrices.constData() + begin,
+                                        index->lengths.constData() + begin, n, scores);
+            for (int i = 0; i < n; ++i) {
+                if (scores[i] >= textSimilarityThreshold)
+                    similar.append(qMakePair(begin + i, scores[i]));
+            }
+        }
+        if (!promise->isCanceled()) {
+            std::stable_sort(similar.begin(), similar.end(),
+                             [](const QPair<int, int> &a, const QPair<int, int> &b) {
+                                 return a.second > b.second;
+                             });
+            promise->addResult(similar);
+        }
+        promise->finish();
+    });
+}
+
+void PhraseView::showGuesses()
+{
+    const QFuture<SimilarMessages> future = m_guessWatcher.future();
+    if (future.isCanceled() || future.resultCount() == 0 || !m_guessIndex
+        || m_modelIndex < 0 || m_modelIndex >= m_dataModel->modelCount()
+        || m_dataModel->similarityIndex(m_modelIndex) != m_guessIndex) {
+        return;
+    }
+
+    DataModel *dataModel = m_dataModel->model(m_modelIndex);
+    QList<int> scores;
+    CandidateList candidates;
+    for (const auto &similar : future.result()) {
+        if (candidates.size() == m_maxCandidates)
+            break;
+        const MessageItem *m = dataModel->messageItem(m_guessIndex->messages.at(similar.first));
+        if (!m || m->type() == TranslatorMessage::Unfinished || m->translation().isEmpty())
+            continue;
+
+        const Candidate cand(m->context(), m->text(), m->comment(), m->translation());
+        bool duplicate = false;
+        for (int i = scores.size(); --i >= 0 && scores.at(i) == similar.second;) {
+            if (candidates.at(i) == cand) {
+                duplicate = true;
+                break;
+            }
         }
+        if (duplicate)
+            continue;
+        scores.append(similar.second);
+        candidates.append(cand);
+    }
+
+    int n = 0;
+    for (const Candidate &candidate : qAsConst(candidates)) {
+        QString def;
+        if (n < 9)
+            def = tr("Guess from '%1' (%2)")
+                  .arg(candidate.context, QKeySequence(Qt::CTRL | (Qt::Key_0 + (n + 1)))
+                                          .toString(QKeySequence::NativeText));
+        else
+            def = tr("Guess from '%1'").arg(candidate.context);
+        Phrase *guess = new Phrase(candidate.source, candidate.translation, def, candidate, n);
+        m_guesses.append(guess);
+        m_phraseModel->addPhrase(guess);
+        ++n;
     }
 }
 
@@ -285,13 +325,14 @@ QList<Phrase *> PhraseView::getPhrases(int model, const QString &source)
     const QString f = MainWindow::friendlyString(source);
     const QStringList lookupWords = f.split(QLatin1Char(' '));
 
+    const QHash<QString, QList<Phrase *> > &dict = m_phraseDict->at(model);
     for (const QString &s : lookupWords) {
-        if (m_phraseDict->at(model).contains(s)) {
-            const auto phraseList = m_phraseDict->at(model).value(s);
-            for (Phrase *p : phraseList) {
-                if (f.contains(MainWindow::friendlyString(p->source())))
-                    phrases.append(p);
-            }
+        const auto it = dict.constFind(s);
+        if (it == dict.constEnd())
+            continue;
+        for (Phrase *p : *it) {
+            if (f.contains(p->friendlySource()))
+                phrases.append(p);
         }
     }
     return phrases;
@@ -29,7 +29,10 @@
 #ifndef PHRASEVIEW_H
 #define PHRASEVIEW_H
 
+#include <QFutureWatcher>
 #include <QList>
+#include <QPair>
+#include <QSharedPointer>
 #include <QTreeView>
 #include "phrase.h"
 
@@ -39,6 +42,10 @@ static const int DefaultMaxCandidates = 5;
 
 class MultiDataModel;
 class PhraseModel;
+struct SimilarityIndex;
+
+// Positions in a SimilarityIndex and their similarity scores
+typedef QList<QPair<int, int> > SimilarMessages;
 
 class PhraseView : public QTreeView
 {
@@ -76,10 +83,12 @@ private slots:
     void selectCurrentPhrase();
     void editPhrase();
     void gotoMessageFromGuess();
+    void showGuesses();
 
 private:
     QList<Phrase *> getPhrases(int model, const QString &sourceText);
     void deleteGuesses();
+    void startGuessing(const QString &sourceText);
 
     MultiDataModel *m_dataModel;
     QList<QHash<QString, QList<Phrase *> > > *m_phraseDict;
@@ -89,6 +98,8 @@ private:
     int m_modelIndex;
     bool m_doGuesses;
     int m_maxCandidates = DefaultMaxCandidates;
+    QSharedPointer<const SimilarityIndex> m_guessIndex;
+    QFutureWatcher<SimilarMessages> m_guessWatcher;
 };
 
 QT_END_NAMESPACE
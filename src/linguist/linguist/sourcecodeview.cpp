@@ -41,7 +41,8 @@ QT_BEGIN_NAMESPACE
 SourceCodeView::SourceCodeView(QWidget *parent)
   : QPlainTextEdit(parent),
     m_isActive(true),
-    m_lineNumToLoad(0)
+    m_lineNumToLoad(0),
+    m_fileCache(32 * 1024 * 1024)
 {
     setReadOnly(true);
 }
@@ -77,15 +78,20 @@ void SourceCodeView::setActivated(bool activated)
 
 void SourceCodeView::showSourceCode(const QString &absFileName, const int lineNum)
 {
-    QString fileText = fileHash.value(absFileName);
-
-    if (fileText.isNull()) { // File not in hash
+    // Assume fileName is relative to directory
+    const QFileInfo fileInfo(absFileName);
+    const QDateTime lastModified = fileInfo.lastModified();
+    const SourceFile *cached = m_fileCache.object(absFileName);
+    QString fileText;
+    if (cached && cached->lastModified == lastModified)
+        fileText = cached->text;
+
+    if (fileText.isNull()) { // File not in cache or modified
         m_currentFileName.clear();
 
-        // Assume fileName is relative to directory
         QFile file(absFileName);
 
-        if (!file.exists()) {
+        if (!fileInfo.exists()) {
             clear();
             appendHtml(tr("<i>File %1 not available</i>").arg(absFileName));
             return;
@@ -96,13 +102,14 @@ void SourceCodeView::showSourceCode(const QString &absFileName, const int lineNu
             return;
         }
         fileText = QString::fromUtf8(file.readAll());
-        fileHash.insert(absFileName, fileText);
+        m_fileCache.insert(absFileName, new SourceFile { fileText, lastModified },
+                           qMax(qsizetype(1), fileText.size()));
     }
 
-
-    if (m_currentFileName != absFileName) {
+    if (m_currentFileName != absFileName || m_currentLastModified != lastModified) {
         setPlainText(fileText);
         m_currentFileName = absFileName;
+        m_currentLastModified = lastModified;
     }
 
     QTextCursor cursor = textCursor();
@@ -29,8 +29,9 @@
 #ifndef SOURCECODEVIEW_H
 #define SOURCECODEVIEW_H
 
+#include <QCache>
+#include <QDateTime>
 #include <QDir>
-#include <QHash>
 #include <QPlainTextEdit>
 
 QT_BEGIN_NAMESPACE
@@ -52,8 +53,14 @@ private:
     QString m_fileToLoad;
     int m_lineNumToLoad;
     QString m_currentFileName;
+    QDateTime m_currentLastModified;
 
-    QHash<QString, QString> fileHash;
+    struct SourceFile {
+        QString text;
+        QDateTime lastModified;
+    };
+    // Decoded files, with their size in characters as the cost
+    QCache<QString, SourceFile> m_fileCache;
 };
 
 QT_END_NAMESPACE
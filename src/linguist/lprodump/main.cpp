@@ -26,20 +26,13 @@
 **
 ****************************************************************************/
 
-#include <profileevaluator.h>
 #include <profileutils.h>
-#include <qmakeparser.h>
-#include <qmakevfs.h>
-#include <qrcreader.h>
+#include <projectevaluator.h>
 
 #include <QtCore/QCoreApplication>
-#include <QtCore/QDebug>
 #include <QtCore/QDir>
-#include <QtCore/QDirIterator>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
-#include <QtCore/QLibraryInfo>
-#include <QtCore/QRegularExpression>
 #include <QtCore/QString>
 #include <QtCore/QStringList>
 
@@ -99,6 +92,12 @@ Options:
            Virtual output directory for processing subsequent .pro files.
     -pro-debug
            Trace processing .pro files. Specify twice for more verbosity.
+    -pro-cache <directory>
+           Store parsed .pro, .pri and .prf files in <directory> and reuse
+           them in later runs if the files did not change.
+    -pro-jobs <count>
+           Evaluate up to <count> subprojects at the same time.
+           The default is 1.
     -out <filename>
            Name of the output file.
     -version
@@ -106,260 +105,27 @@ Options:
 )"_qs);
 }
 
-static void print(const QString &fileName, int lineNo, const QString &msg)
-{
-    if (lineNo > 0)
-        printErr(QString::fromLatin1("WARNING: %1:%2: %3\n").arg(fileName, QString::number(lineNo), msg));
-    else if (lineNo)
-        printErr(QString::fromLatin1("WARNING: %1: %2\n").arg(fileName, msg));
-    else
-        printErr(QString::fromLatin1("WARNING: %1\n").arg(msg));
-}
-
-class EvalHandler : public QMakeHandler {
-public:
-    void message(int type, const QString &msg, const QString &fileName, int lineNo) override
-    {
-        if (verbose && !(type & CumulativeEvalMessage) && (type & CategoryMask) == ErrorMessage)
-            print(fileName, lineNo, msg);
-    }
-
-    void fileMessage(int type, const QString &msg) override
-    {
-        if (verbose && !(type & CumulativeEvalMessage) && (type & CategoryMask) == ErrorMessage) {
-            // "Downgrade" errors, as we don't really care for them
-            printErr(QLatin1String("WARNING: ") + msg + QLatin1Char('\n'));
-        }
-    }
-
-    void aboutToEval(ProFile *, ProFile *, EvalFileType) override {}
-    void doneWithEval(ProFile *) override {}
-
-    bool verbose = true;
-};
-
-static EvalHandler evalHandler;
-
-static bool isSupportedExtension(const QString &ext)
-{
-    return ext == QLatin1String("qml")
-        || ext == QLatin1String("js") || ext == QLatin1String("qs")
-        || ext == QLatin1String("ui") || ext == QLatin1String("jui");
-}
-
-static QStringList getResources(const QString &resourceFile, QMakeVfs *vfs)
-{
-    Q_ASSERT(vfs);
-    if (!vfs->exists(resourceFile, QMakeVfs::VfsCumulative))
-        return QStringList();
-    QString content;
-    QString errStr;
-    if (vfs->readFile(vfs->idForFileName(resourceFile, QMakeVfs::VfsCumulative),
-                      &content, &errStr) != QMakeVfs::ReadOk) {
-        printErr(QStringLiteral("lprodump error: Cannot read %1: %2\n").arg(resourceFile, errStr));
-        return QStringList();
-    }
-    const ReadQrcResult rqr = readQrcFile(resourceFile, content);
-    if (rqr.hasError()) {
-        printErr(QStringLiteral("lprodump error: %1:%2: %3\n")
-                 .arg(resourceFile, QString::number(rqr.line), rqr.errorString));
-    }
-    return rqr.files;
-}
-
-static QStringList getSources(const char *var, const char *vvar, const QStringList &baseVPaths,
-                              const QString &projectDir, const ProFileEvaluator &visitor)
-{
-    QStringList vPaths = visitor.absolutePathValues(QLatin1String(vvar), projectDir);
-    vPaths += baseVPaths;
-    vPaths.removeDuplicates();
-    return visitor.absoluteFileValues(QLatin1String(var), projectDir, vPaths, 0);
-}
-
-static QStringList getSources(const ProFileEvaluator &visitor, const QString &projectDir,
-                              const QStringList &excludes, QMakeVfs *vfs)
-{
-    QStringList baseVPaths;
-    baseVPaths += visitor.absolutePathValues(QLatin1String("VPATH"), projectDir);
-    baseVPaths << projectDir; // QMAKE_ABSOLUTE_SOURCE_PATH
-    baseVPaths.removeDuplicates();
-
-    QStringList sourceFiles;
-
-    // app/lib template
-    sourceFiles += getSources("SOURCES", "VPATH_SOURCES", baseVPaths, projectDir, visitor);
-    sourceFiles += getSources("HEADERS", "VPATH_HEADERS", baseVPaths, projectDir, visitor);
-
-    sourceFiles += getSources("FORMS", "VPATH_FORMS", baseVPaths, projectDir, visitor);
-
-    const QStringList resourceFiles = getSources("RESOURCES", "VPATH_RESOURCES", baseVPaths, projectDir, visitor);
-    for (const QString &resource : resourceFiles)
-        sourceFiles += getResources(resource, vfs);
-
-    QStringList installs = visitor.values(QLatin1String("INSTALLS"))
-                         + visitor.values(QLatin1String("DEPLOYMENT"));
-    installs.removeDuplicates();
-    QDir baseDir(projectDir);
-    for (const QString &inst : qAsConst(installs)) {
-        for (const QString &file : visitor.values(inst + QLatin1String(".files"))) {
-            QFileInfo info(file);
-            if (!info.isAbsolute())
-                info.setFile(baseDir.absoluteFilePath(file));
-            QStringList nameFilter;
-            QString searchPath;
-            if (info.isDir()) {
-                nameFilter << QLatin1String("*");
-                searchPath = info.filePath();
-            } else {
-                nameFilter << info.fileName();
-                searchPath = info.path();
-            }
-
-            QDirIterator iterator(searchPath, nameFilter,
-                                  QDir::Files | QDir::NoDotAndDotDot | QDir::NoSymLinks,
-                                  QDirIterator::Subdirectories);
-            while (iterator.hasNext()) {
-                iterator.next();
-                QFileInfo cfi = iterator.fileInfo();
-                if (isSupportedExtension(cfi.suffix()))
-                    sourceFiles << cfi.filePath();
-            }
-        }
-    }
-
-    sourceFiles.removeDuplicates();
-    sourceFiles.sort();
-
-    for (const QString &ex : excludes) {
-        // TODO: take advantage of the file list being sorted
-        QRegularExpression rx(QRegularExpression::wildcardToRegularExpression(ex));
-        for (auto it = sourceFiles.begin(); it != sourceFiles.end(); ) {
-            if (rx.match(*it).hasMatch())
-                it = sourceFiles.erase(it);
-            else
-                ++it;
-        }
-    }
-
-    return sourceFiles;
-}
-
-QStringList getExcludes(const ProFileEvaluator &visitor, const QString &projectDirPath)
-{
-    const QStringList trExcludes = visitor.values(QLatin1String("TR_EXCLUDE"));
-    QStringList excludes;
-    excludes.reserve(trExcludes.size());
-    const QDir projectDir(projectDirPath);
-    for (const QString &ex : trExcludes)
-        excludes << QDir::cleanPath(projectDir.absoluteFilePath(ex));
-    return excludes;
-}
-
-static void excludeProjects(const ProFileEvaluator &visitor, QStringList *subProjects)
-{
-    for (const QString &ex : visitor.values(QLatin1String("TR_EXCLUDE"))) {
-        QRegularExpression rx(QRegularExpression::wildcardToRegularExpression(ex));
-        for (auto it = subProjects->begin(); it != subProjects->end(); ) {
-            if (rx.match(*it).hasMatch())
-                it = subProjects->erase(it);
-            else
-                ++it;
-        }
-    }
-}
-
-static QJsonArray processProjects(bool topLevel, const QStringList &proFiles,
-        const QHash<QString, QString> &outDirMap,
-        ProFileGlobals *option, QMakeVfs *vfs, QMakeParser *parser,
-        bool *fail);
-
-static QJsonObject processProject(const QString &proFile, ProFileGlobals *option, QMakeVfs *vfs,
-                                  QMakeParser *parser, ProFileEvaluator &visitor)
-{
-    QJsonObject result;
-    QStringList tmp = visitor.values(QLatin1String("CODECFORSRC"));
-    if (!tmp.isEmpty())
-        result[QStringLiteral("codec")] = tmp.last();
-    QString proPath = QFileInfo(proFile).path();
-    if (visitor.templateType() == ProFileEvaluator::TT_Subdirs) {
-        QStringList subProjects = visitor.values(QLatin1String("SUBDIRS"));
-        excludeProjects(visitor, &subProjects);
-        QStringList subProFiles;
-        QDir proDir(proPath);
-        for (const QString &subdir : qAsConst(subProjects)) {
-            QString realdir = visitor.value(subdir + QLatin1String(".subdir"));
-            if (realdir.isEmpty())
-                realdir = visitor.value(subdir + QLatin1String(".file"));
-            if (realdir.isEmpty())
-                realdir = subdir;
-            QString subPro = QDir::cleanPath(proDir.absoluteFilePath(realdir));
-            QFileInfo subInfo(subPro);
-            if (subInfo.isDir()) {
-                subProFiles << (subPro + QLatin1Char('/')
-                                + subInfo.fileName() + QLatin1String(".pro"));
-            } else {
-                subProFiles << subPro;
-            }
-        }
-        QJsonArray subResults = processProjects(false, subProFiles,
-                                                QHash<QString, QString>(), option, vfs, parser,
-                                                nullptr);
-        if (!subResults.isEmpty())
-            setValue(result, "subProjects", subResults);
-    } else {
-        const QStringList excludes = getExcludes(visitor, proPath);
-        const QStringList sourceFiles = getSources(visitor, proPath, excludes, vfs);
-        setValue(result, "includePaths",
-                 visitor.absolutePathValues(QLatin1String("INCLUDEPATH"), proPath));
-        setValue(result, "excluded", excludes);
-        setValue(result, "sources", sourceFiles);
-    }
-    return result;
-}
-
-static QJsonArray processProjects(bool topLevel, const QStringList &proFiles,
-        const QHash<QString, QString> &outDirMap,
-        ProFileGlobals *option, QMakeVfs *vfs, QMakeParser *parser, bool *fail)
+static QJsonArray toJson(const Projects &projects)
 {
     QJsonArray result;
-    for (const QString &proFile : proFiles) {
-        if (!outDirMap.isEmpty())
-            option->setDirectories(QFileInfo(proFile).path(), outDirMap[proFile]);
-
-        ProFile *pro;
-        if (!(pro = parser->parsedProFile(proFile, topLevel ? QMakeParser::ParseReportMissing
-                                                            : QMakeParser::ParseDefault))) {
-            if (topLevel)
-                *fail = true;
-            continue;
-        }
-        ProFileEvaluator visitor(option, parser, vfs, &evalHandler);
-        visitor.setCumulative(true);
-        visitor.setOutputDir(option->shadowedPath(pro->directoryName()));
-        if (!visitor.accept(pro)) {
-            if (topLevel)
-                *fail = true;
-            pro->deref();
-            continue;
-        }
-
-        QJsonObject prj = processProject(proFile, option, vfs, parser, visitor);
-        setValue(prj, "projectFile", proFile);
-        if (visitor.contains(QLatin1String("TRANSLATIONS"))) {
-            QStringList tsFiles;
-            QDir proDir(QFileInfo(proFile).path());
-            const QStringList translations = visitor.values(QLatin1String("TRANSLATIONS"));
-            for (const QString &tsFile : translations)
-                tsFiles << proDir.filePath(tsFile);
-            setValue(prj, "translations", tsFiles);
-        }
-        if (visitor.contains(QLatin1String("LUPDATE_COMPILE_COMMANDS_PATH"))) {
-            const QStringList thepathjson = visitor.values(
-                QLatin1String("LUPDATE_COMPILE_COMMANDS_PATH"));
-            setValue(prj, "compileCommands", thepathjson.value(0));
-        }
-        result.append(prj);
-        pro->deref();
+    for (const Project &project : projects) {
+        QJsonObject obj;
+        setValue(obj, "projectFile", project.filePath);
+        if (!project.codec.isEmpty())
+            setValue(obj, "codec", project.codec);
+        if (!project.compileCommands.isEmpty())
+            setValue(obj, "compileCommands", project.compileCommands);
+        if (!project.includePaths.isEmpty())
+            setValue(obj, "includePaths", project.includePaths);
+        if (!project.excluded.isEmpty())
+            setValue(obj, "excluded", project.excluded);
+        if (!project.sources.isEmpty())
+            setValue(obj, "sources", project.sources);
+        if (project.translations)
+            setValue(obj, "translations", *project.translations);
+        if (!project.subProjects.empty())
+            setValue(obj, "subProjects", toJson(project.subProjects));
+        result.append(obj);
     }
     return result;
 }
@@ -370,9 +136,8 @@ int main(int argc, char **argv)
     QStringList args = app.arguments();
     QStringList proFiles;
     QString outDir = QDir::currentPath();
-    QHash<QString, QString> outDirMap;
     QString outputFilePath;
-    int proDebug = 0;
+    ProjectEvaluationOptions options;
 
     for (int i = 1; i < args.size(); ++i) {
         QString arg = args.at(i);
@@ -389,9 +154,9 @@ int main(int argc, char **argv)
             }
             outputFilePath = args[i];
         } else if (arg == QLatin1String("-silent")) {
-            evalHandler.verbose = false;
+            options.verbose = false;
         } else if (arg == QLatin1String("-pro-debug")) {
-            proDebug++;
+            options.debugLevel++;
         } else if (arg == QLatin1String("-version")) {
             printOut(QStringLiteral("lprodump version %1\n").arg(QLatin1String(QT_VERSION_STR)));
             return 0;
@@ -403,7 +168,7 @@ int main(int argc, char **argv)
             }
             QString file = QDir::cleanPath(QFileInfo(args[i]).absoluteFilePath());
             proFiles += file;
-            outDirMap[file] = outDir;
+            options.outDirMap[file] = outDir;
         } else if (arg == QLatin1String("-pro-out")) {
             ++i;
             if (i == argc) {
@@ -411,6 +176,22 @@ int main(int argc, char **argv)
                 return 1;
             }
             outDir = QDir::cleanPath(QFileInfo(args[i]).absoluteFilePath());
+        } else if (arg == QLatin1String("-pro-cache")) {
+            ++i;
+            if (i == argc) {
+                printErr(QStringLiteral("The -pro-cache option should be followed by a directory name.\n"));
+                return 1;
+            }
+            options.cacheDir = QDir::cleanPath(QFileInfo(args[i]).absoluteFilePath());
+        } else if (arg == QLatin1String("-pro-jobs")) {
+            ++i;
+            bool ok = false;
+            if (i < argc)
+                options.jobCount = args[i].toInt(&ok);
+            if (!ok || options.jobCount < 1) {
+                printErr(QStringLiteral("The -pro-jobs option should be followed by a positive number.\n"));
+                return 1;
+            }
         } else if (arg.startsWith(QLatin1String("-")) && arg != QLatin1String("-")) {
             printErr(QStringLiteral("Unrecognized option '%1'.\n").arg(arg));
             return 1;
@@ -427,7 +208,7 @@ int main(int argc, char **argv)
             }
             QString cleanFile = QDir::cleanPath(fi.absoluteFilePath());
             proFiles << cleanFile;
-            outDirMap[cleanFile] = outDir;
+            options.outDirMap[cleanFile] = outDir;
         }
     } // for args
 
@@ -436,26 +217,11 @@ int main(int argc, char **argv)
         return 1;
     }
 
-    bool fail = false;
-    ProFileGlobals option;
-    option.qmake_abslocation = QString::fromLocal8Bit(qgetenv("QMAKE"));
-    if (option.qmake_abslocation.isEmpty()) {
-        option.qmake_abslocation = QLibraryInfo::path(QLibraryInfo::BinariesPath)
-            + QLatin1String("/qmake");
-    }
-    option.debugLevel = proDebug;
-    option.initProperties();
-    option.setCommandLineArguments(QDir::currentPath(),
-                                   QStringList() << QLatin1String("CONFIG+=lupdate_run"));
-    QMakeVfs vfs;
-    QMakeParser parser(0, &vfs, &evalHandler);
-
-    QJsonArray results = processProjects(true, proFiles, outDirMap, &option, &vfs,
-                                         &parser, &fail);
-    if (fail)
+    Projects projects;
+    if (!evaluateProjects(proFiles, options, &projects))
         return 1;
 
-    const QByteArray output = QJsonDocument(results).toJson(QJsonDocument::Compact);
+    const QByteArray output = QJsonDocument(toJson(projects)).toJson(QJsonDocument::Compact);
     if (outputFilePath.isEmpty()) {
         puts(output.constData());
     } else {
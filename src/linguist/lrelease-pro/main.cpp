@@ -63,6 +63,11 @@ Options:
     -keep  Keep the temporary project dump around
     -silent
            Do not explain what is being done
+    -pro-cache <directory>
+           Store parsed .pro, .pri and .prf files in <directory> and reuse
+           them in later runs if the files did not change
+    -pro-jobs <count>
+           Evaluate up to <count> subprojects at the same time
     -version
            Display the version of lrelease-pro and exit
 )"_qs);
@@ -97,6 +102,18 @@ int main(int argc, char **argv)
             const QString arg = QString::fromLocal8Bit(argv[i]);
             lprodumpOptions << arg;
             lreleaseOptions << arg;
+        } else if (!strcmp(argv[i], "-pro-jobs")) {
+            if (i == argc - 1) {
+                printErr(u"The -pro-jobs option should be followed by a number.\n"_qs);
+                return 1;
+            }
+            lprodumpOptions << QString::fromLocal8Bit(argv[i]) << QString::fromLocal8Bit(argv[++i]);
+        } else if (!strcmp(argv[i], "-pro-cache")) {
+            if (i == argc - 1) {
+                printErr(u"The -pro-cache option should be followed by a directory name.\n"_qs);
+                return 1;
+            }
+            lprodumpOptions << QString::fromLocal8Bit(argv[i]) << QString::fromLocal8Bit(argv[++i]);
         } else if (!strcmp(argv[i], "-version")) {
             printOut(QStringLiteral("lrelease-pro version %1\n")
                      .arg(QLatin1String(QT_VERSION_STR)));
@@ -28,14 +28,19 @@
 
 #include "translator.h"
 
+#include <concurrency.h>
 #include <profileutils.h>
 #include <projectdescriptionreader.h>
+#ifdef LINGUIST_INPROCESS_PROJECTS
+#include <projectevaluator.h>
+#endif
 #include <runqttool.h>
 
 #ifndef QT_BOOTSTRAPPED
 #include <QtCore/QCoreApplication>
 #include <QtCore/QTranslator>
 #endif
+#include <QtCore/QBuffer>
 #include <QtCore/QDebug>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
@@ -45,20 +50,53 @@
 #include <QtCore/QTextStream>
 #include <QtCore/QLibraryInfo>
 
+#include <atomic>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
 QT_USE_NAMESPACE
 
+// The messages of a file released on a worker thread. They are printed in
+// the order of the input files once the file is done.
+struct BufferedOutput
+{
+    struct Chunk
+    {
+        bool isError;
+        QString text;
+    };
+    QList<Chunk> chunks;
+};
+
+static thread_local BufferedOutput *bufferedOutput = nullptr;
+
 static void printOut(const QString & out)
 {
+    if (bufferedOutput) {
+        bufferedOutput->chunks.append({ false, out });
+        return;
+    }
     QTextStream stream(stdout);
     stream << out;
 }
 
 static void printErr(const QString & out)
 {
+    if (bufferedOutput) {
+        bufferedOutput->chunks.append({ true, out });
+        return;
+    }
     QTextStream stream(stderr);
     stream << out;
 }
 
+static void printBufferedOutput(const BufferedOutput &output)
+{
+    for (const BufferedOutput::Chunk &chunk : output.chunks)
+        QTextStream(chunk.isError ? stderr : stdout) << chunk.text;
+}
+
 static void printUsage()
 {
     printOut(uR"(Usage:
@@ -77,6 +115,9 @@ Options:
     -help  Display this information and exit
     -idbased
            Use IDs instead of source strings for message keying
+    -jobs <count>
+           Release up to <count> TS files at the same time. The default is 1.
+           Messages are still printed in the order of the input files
     -compress
            Compress the QM files
     -nounfinished
@@ -90,6 +131,11 @@ Options:
     -project <filename>
            Name of a file containing the project's description in JSON format.
            Such a file may be generated from a .pro file using the lprodump tool.
+    -pro-cache <directory>
+           Store parsed .pro, .pri and .prf files in <directory> and reuse
+           them in later runs if the files did not change.
+    -pro-jobs <count>
+           Evaluate up to <count> subprojects of .pro files at the same time.
     -silent
            Do not explain what is being done
     -version
@@ -111,10 +157,48 @@ static bool loadTsFile(Translator &tor, const QString &tsFileName, bool /* verbo
     return ok;
 }
 
+/*
+  Writes \a data to \a fileName unless the file already has exactly that
+  content. Keeping an up-to-date file untouched preserves its timestamp,
+  so build systems do not redo the steps that depend on it.
+*/
+static bool writeIfChanged(const QString &fileName, const QByteArray &data, bool verbose)
+{
+    QFile file(fileName);
+    if (file.size() == data.size() && file.open(QIODevice::ReadOnly)) {
+        const bool unchanged = file.readAll() == data;
+        file.close();
+        if (unchanged) {
+            if (verbose)
+                printOut(QLatin1String("'%1' is up to date.\n").arg(fileName));
+            return true;
+        }
+    }
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        printErr(QLatin1String("lrelease error: cannot create '%1': %2\n")
+                         .arg(fileName, file.errorString()));
+        return false;
+    }
+    if (file.write(data) != data.size()) {
+        printErr(QLatin1String("lrelease error: cannot write '%1': %2\n")
+                         .arg(fileName, file.errorString()));
+        return false;
+    }
+    return true;
+}
+
 static bool releaseTranslator(Translator &tor, const QString &qmFileName,
     ConversionData &cd, bool removeIdentical)
 {
-    tor.reportDuplicates(tor.resolveDuplicates(), qmFileName, cd.isVerbose());
+    if (bufferedOutput) {
+        std::ostringstream duplicates;
+        tor.reportDuplicates(tor.resolveDuplicates(), qmFileName, cd.isVerbose(), duplicates);
+        if (!duplicates.str().empty())
+            printErr(QString::fromStdString(duplicates.str()));
+    } else {
+        tor.reportDuplicates(tor.resolveDuplicates(), qmFileName, cd.isVerbose());
+    }
 
     if (cd.isVerbose())
         printOut(QLatin1String("Updating '%1'...\n").arg(qmFileName));
@@ -125,16 +209,12 @@ static bool releaseTranslator(Translator &tor, const QString &qmFileName,
         tor.stripIdenticalSourceTranslations();
     }
 
-    QFile file(qmFileName);
-    if (!file.open(QIODevice::WriteOnly)) {
-        printErr(QLatin1String("lrelease error: cannot create '%1': %2\n")
-                         .arg(qmFileName, file.errorString()));
-        return false;
-    }
-
     tor.normalizeTranslations(cd);
-    bool ok = saveQM(tor, file, cd);
-    file.close();
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    bool ok = saveQM(tor, buffer, cd);
+    if (ok && !writeIfChanged(qmFileName, buffer.data(), cd.isVerbose()))
+        return false;
 
     if (!ok) {
         printErr(QLatin1String("lrelease error: cannot save '%1': %2").arg(qmFileName, cd.error()));
@@ -164,6 +244,38 @@ static bool releaseTsFile(const QString& tsFileName,
     return releaseTranslator(tor, qmFileName, cd, removeIdentical);
 }
 
+/*
+  Releases each TS file into its own QM file on up to \a jobCount threads.
+  Like the sequential loop, this stops reporting at the first file that
+  fails; files after it may have been released already, though.
+*/
+static bool releaseTsFiles(const QStringList &tsFileNames, const ConversionData &cd,
+                           bool removeIdentical, int jobCount)
+{
+    const int count = tsFileNames.size();
+    std::vector<BufferedOutput> outputs(count);
+    std::vector<char> results(count, false);
+    std::atomic<bool> failed(false);
+
+    forEachConcurrently(count, jobCount, [&](qsizetype i) {
+        if (failed)
+            return;
+        ConversionData fileCd = cd;
+        bufferedOutput = &outputs[i];
+        results[i] = releaseTsFile(tsFileNames.at(i), fileCd, removeIdentical);
+        bufferedOutput = nullptr;
+        if (!results[i])
+            failed = true;
+    });
+
+    for (int i = 0; i < count; ++i) {
+        printBufferedOutput(outputs[i]);
+        if (!results[i])
+            return false;
+    }
+    return true;
+}
+
 static QStringList translationsFromProjects(const Projects &projects, bool topLevel);
 
 static QStringList translationsFromProject(const Project &project, bool topLevel)
@@ -199,6 +311,9 @@ int main(int argc, char **argv)
     QStringList inputFiles;
     QString outputFile;
     QString projectDescriptionFile;
+    int jobCount = 1;
+    QString proCacheDir;
+    int proJobCount = 1;
 
     for (int i = 1; i < argc; ++i) {
         if (!strcmp(argv[i], "-compress")) {
@@ -222,6 +337,17 @@ int main(int argc, char **argv)
                 return 1;
             }
             cd.m_unTrPrefix = QString::fromLocal8Bit(argv[++i]);
+        } else if (!strcmp(argv[i], "-jobs")) {
+            if (i == argc - 1) {
+                printErr(QLatin1String("The option -jobs requires a parameter.\n"));
+                return 1;
+            }
+            bool ok = false;
+            jobCount = QString::fromLocal8Bit(argv[++i]).toInt(&ok);
+            if (!ok || jobCount < 1) {
+                printErr(QLatin1String("The option -jobs requires a positive number.\n"));
+                return 1;
+            }
         } else if (!strcmp(argv[i], "-project")) {
             if (i == argc - 1) {
                 printErr(QLatin1String("The option -project requires a parameter.\n"));
@@ -232,6 +358,24 @@ int main(int argc, char **argv)
                 return 1;
             }
             projectDescriptionFile = QString::fromLocal8Bit(argv[++i]);
+        } else if (!strcmp(argv[i], "-pro-cache")) {
+            if (i == argc - 1) {
+                printErr(QLatin1String("The option -pro-cache requires a parameter.\n"));
+                return 1;
+            }
+            proCacheDir = QDir::cleanPath(
+                    QFileInfo(QString::fromLocal8Bit(argv[++i])).absoluteFilePath());
+        } else if (!strcmp(argv[i], "-pro-jobs")) {
+            if (i == argc - 1) {
+                printErr(QLatin1String("The option -pro-jobs requires a parameter.\n"));
+                return 1;
+            }
+            bool ok = false;
+            proJobCount = QString::fromLocal8Bit(argv[++i]).toInt(&ok);
+            if (!ok || proJobCount < 1) {
+                printErr(QLatin1String("The option -pro-jobs requires a positive number.\n"));
+                return 1;
+            }
         } else if (!strcmp(argv[i], "-silent")) {
             cd.m_verbose = false;
             continue;
@@ -264,12 +408,36 @@ int main(int argc, char **argv)
     }
 
     QString errorString;
-    if (!extractProFiles(&inputFiles).isEmpty()) {
+    QStringList proFiles = extractProFiles(&inputFiles);
+    if (!proFiles.isEmpty()) {
+#ifdef LINGUIST_INPROCESS_PROJECTS
+        if (!inputFiles.isEmpty() || !projectDescriptionFile.isEmpty()) {
+            printErr(QLatin1String(
+                    "lrelease error: Do not specify TS files or -project if .pro files are given.\n"));
+            return 1;
+        }
+        ProjectEvaluationOptions evaluationOptions;
+        for (QString &proFile : proFiles) {
+            const QFileInfo fi(proFile);
+            if (!fi.exists()) {
+                printErr(QLatin1String("lrelease error: File '%1' does not exist.\n").arg(proFile));
+                return 1;
+            }
+            proFile = QDir::cleanPath(fi.absoluteFilePath());
+            evaluationOptions.outDirMap[proFile] = QDir::currentPath();
+        }
+        evaluationOptions.cacheDir = proCacheDir;
+        evaluationOptions.jobCount = proJobCount;
+        evaluationOptions.verbose = cd.isVerbose();
+        Projects projectDescription;
+        if (!evaluateProjects(proFiles, evaluationOptions, &projectDescription))
+            return 1;
+        inputFiles = translationsFromProjects(projectDescription);
+#else
         runInternalQtTool(QLatin1String("lrelease-pro"), app.arguments().mid(1));
         return 0;
-    }
-
-    if (!projectDescriptionFile.isEmpty()) {
+#endif
+    } else if (!projectDescriptionFile.isEmpty()) {
         if (!inputFiles.isEmpty()) {
             printErr(QLatin1String(
                     "lrelease error: Do not specify TS files if -project is given.\n"));
@@ -283,6 +451,9 @@ int main(int argc, char **argv)
         inputFiles = translationsFromProjects(projectDescription);
     }
 
+    if (outputFile.isEmpty() && jobCount > 1 && inputFiles.size() > 1)
+        return releaseTsFiles(inputFiles, cd, removeIdentical, jobCount) ? 0 : 1;
+
     for (const QString &inputFile : qAsConst(inputFiles)) {
         if (outputFile.isEmpty()) {
             if (!releaseTsFile(inputFile, cd, removeIdentical))
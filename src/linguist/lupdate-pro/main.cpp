@@ -73,6 +73,11 @@ Options:
            Virtual output directory for processing subsequent .pro files.
     -pro-debug
            Trace processing .pro files. Specify twice for more verbosity.
+    -pro-cache <directory>
+           Store parsed .pro, .pri and .prf files in <directory> and reuse
+           them in later runs if the files did not change.
+    -pro-jobs <count>
+           Evaluate up to <count> subprojects at the same time.
     -version
            Display the version of lupdate-pro and exit.
 )"_qs);
@@ -133,6 +138,20 @@ int main(int argc, char **argv)
                 return 1;
             }
             lprodumpOptions << arg << args[i];
+        } else if (arg == QLatin1String("-pro-jobs")) {
+            ++i;
+            if (i == argc) {
+                printErr(u"The -pro-jobs option should be followed by a number.\n"_qs);
+                return 1;
+            }
+            lprodumpOptions << arg << args[i];
+        } else if (arg == QLatin1String("-pro-cache")) {
+            ++i;
+            if (i == argc) {
+                printErr(u"The -pro-cache option should be followed by a directory name.\n"_qs);
+                return 1;
+            }
+            lprodumpOptions << arg << args[i];
         } else if (isProOrPriFile(arg)) {
             lprodumpOptions << arg;
             hasProFiles = true;
@@ -30,6 +30,9 @@
 #define CLANG_TOOL_AST_READER_H
 
 #include "cpp_clang.h"
+#include "lupdatepreprocessoraction.h"
+#include "synchronized.h"
+
 #if defined(Q_CC_MSVC)
 # pragma warning(push)
 # pragma warning(disable: 4100)
@@ -49,6 +52,8 @@
 
 #include <iostream>
 #include <memory>
+#include <string>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -112,45 +117,62 @@ private:
     LupdateVisitor m_visitor;
 };
 
+// Collects the preprocessor information (macros) and the AST information of a file in one parse.
+// The preprocessor information ends up in stores->Preprocessor before the AST is visited.
 class LupdateFrontendAction : public clang::ASTFrontendAction
 {
 public:
-    LupdateFrontendAction(Stores *stores)
+    LupdateFrontendAction(Stores *stores, WriteSynchronizedRef<TranslationRelatedStore> *ppStores,
+            std::vector<std::string> *includedFiles = nullptr)
         : m_stores(stores)
+        , m_ppStores(ppStores)
+        , m_includedFiles(includedFiles)
     {}
 
     std::unique_ptr<clang::ASTConsumer> CreateASTConsumer(
         clang::CompilerInstance &compiler, llvm::StringRef /* inFile */) override
     {
+        auto &preprocessor = compiler.getPreprocessor();
+        auto callbacks = new LupdatePPCallbacks(m_ppStores, preprocessor, m_includedFiles);
+        preprocessor.addPPCallbacks(std::unique_ptr<clang::PPCallbacks>(callbacks));
+
         auto consumer = new LupdateASTConsumer(&compiler.getASTContext(), m_stores);
         return std::unique_ptr<clang::ASTConsumer>(consumer);
     }
 
 private:
     Stores *m_stores = nullptr;
+    WriteSynchronizedRef<TranslationRelatedStore> *m_ppStores = nullptr;
+    std::vector<std::string> *m_includedFiles = nullptr;
 };
 
 class LupdateToolActionFactory : public clang::tooling::FrontendActionFactory
 {
 public:
-    LupdateToolActionFactory(Stores *stores)
+    // The factory must outlive the tool run, as the preprocessor callbacks write to m_ppStores
+    // when the compiler instance is destroyed.
+    LupdateToolActionFactory(Stores *stores, std::vector<std::string> *includedFiles = nullptr)
         : m_stores(stores)
+        , m_ppStores(stores->Preprocessor)
+        , m_includedFiles(includedFiles)
     {}
 
 #if (LUPDATE_CLANG_VERSION >= LUPDATE_CLANG_VERSION_CHECK(10,0,0))
     std::unique_ptr<clang::FrontendAction> create() override
     {
-        return std::make_unique<LupdateFrontendAction>(m_stores);
+        return std::make_unique<LupdateFrontendAction>(m_stores, &m_ppStores, m_includedFiles);
     }
 #else
     clang::FrontendAction *create() override
     {
-        return new LupdateFrontendAction(m_stores);
+        return new LupdateFrontendAction(m_stores, &m_ppStores, m_includedFiles);
     }
 #endif
 
 private:
     Stores *m_stores = nullptr;
+    WriteSynchronizedRef<TranslationRelatedStore> m_ppStores;
+    std::vector<std::string> *m_includedFiles = nullptr;
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,220 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Linguist of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "clangtranslationcache.h"
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qstringlist.h>
+
+QT_BEGIN_NAMESPACE
+
+// Bump whenever the layout of the cache files or of TranslationRelatedStore changes
+static const quint32 cacheMagic = 0x4c555043; // "LUPC"
+static const quint32 cacheVersion = 1;
+
+static QDataStream &operator<<(QDataStream &out, const TranslationRelatedStore &store)
+{
+    // The source location is only meaningful for the source manager that created it.
+    return out << store.callType << store.rawCode << store.funcName << store.locationCol
+               << store.contextArg << store.contextRetrieved << store.lupdateSource
+               << store.lupdateLocationFile << store.lupdateLocationLine << store.lupdateId
+               << store.lupdateSourceWhenId << store.lupdateIdMetaData
+               << store.lupdateMagicMetaData << store.lupdateAllMagicMetaData
+               << store.lupdateComment << store.lupdateExtraComment << store.lupdatePlural
+               << store.lupdateWarning;
+}
+
+static QDataStream &operator>>(QDataStream &in, TranslationRelatedStore &store)
+{
+    return in >> store.callType >> store.rawCode >> store.funcName >> store.locationCol
+              >> store.contextArg >> store.contextRetrieved >> store.lupdateSource
+              >> store.lupdateLocationFile >> store.lupdateLocationLine >> store.lupdateId
+              >> store.lupdateSourceWhenId >> store.lupdateIdMetaData
+              >> store.lupdateMagicMetaData >> store.lupdateAllMagicMetaData
+              >> store.lupdateComment >> store.lupdateExtraComment >> store.lupdatePlural
+              >> store.lupdateWarning;
+}
+
+static void writeStores(QDataStream &out, const TranslationStores &stores)
+{
+    out << quint32(stores.size());
+    for (const auto &store : stores)
+        out << store;
+}
+
+static bool readStores(QDataStream &in, TranslationStores *stores)
+{
+    quint32 count = 0;
+    in >> count;
+    stores->clear();
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        TranslationRelatedStore store;
+        in >> store;
+        stores->emplace_back(std::move(store));
+    }
+    return in.status() == QDataStream::Ok;
+}
+
+ClangTranslationCache::ClangTranslationCache(const QString &directory,
+    const QByteArray &configurationKey)
+    : m_configurationKey(configurationKey)
+{
+    if (directory.isEmpty())
+        return;
+    if (QDir().mkpath(directory))
+        m_directory = QDir(directory).absolutePath();
+    else
+        qWarning("lupdate: Cannot create the clang parser cache directory %s", qPrintable(directory));
+}
+
+QString ClangTranslationCache::cacheFilePath(const QString &fileName) const
+{
+    const QByteArray pathHash = QCryptographicHash::hash(
+        QFileInfo(fileName).absoluteFilePath().toUtf8(), QCryptographicHash::Sha1);
+    return m_directory + QLatin1Char('/') + QString::fromLatin1(pathHash.toHex())
+        + QLatin1String(".lupdatecache");
+}
+
+QByteArray ClangTranslationCache::fileHash(const QString &fileName)
+{
+    {
+        QMutexLocker lock(&m_mutex);
+        const auto it = m_fileHashes.constFind(fileName);
+        if (it != m_fileHashes.cend())
+            return *it;
+    }
+
+    // A file that cannot be read gets an empty hash, which never matches a stored one.
+    QByteArray result;
+    QFile file(fileName);
+    if (file.open(QIODevice::ReadOnly)) {
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        if (hash.addData(&file))
+            result = hash.result();
+    }
+
+    QMutexLocker lock(&m_mutex);
+    m_fileHashes.insert(fileName, result);
+    return result;
+}
+
+QByteArray ClangTranslationCache::entryKey(const QString &fileName, const QByteArray &commandKey)
+{
+    const QByteArray contentHash = fileHash(fileName);
+    if (contentHash.isEmpty())
+        return QByteArray();
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(m_configurationKey);
+    hash.addData(commandKey);
+    hash.addData(contentHash);
+    return hash.result();
+}
+
+bool ClangTranslationCache::load(const QString &fileName, const QByteArray &commandKey,
+    TranslationUnitStores *stores)
+{
+    if (!isEnabled())
+        return false;
+    const QByteArray key = entryKey(fileName, commandKey);
+    if (key.isEmpty())
+        return false;
+
+    QFile file(cacheFilePath(fileName));
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0, version = 0;
+    QByteArray storedKey;
+    in >> magic >> version >> storedKey;
+    if (magic != cacheMagic || version != cacheVersion || storedKey != key)
+        return false;
+
+    quint32 includedCount = 0;
+    in >> includedCount;
+    for (quint32 i = 0; i < includedCount; ++i) {
+        QString includedFile;
+        QByteArray includedHash;
+        in >> includedFile >> includedHash;
+        if (in.status() != QDataStream::Ok || fileHash(includedFile) != includedHash)
+            return false;
+    }
+
+    if (!readStores(in, &stores->Preprocessor) || !readStores(in, &stores->AST)
+        || !readStores(in, &stores->QDeclareTrWithContext)
+        || !readStores(in, &stores->QNoopTranlsationWithContext)) {
+        *stores = TranslationUnitStores();
+        return false;
+    }
+    qCDebug(lcClang) << "Using cached translation information for" << fileName;
+    return true;
+}
+
+void ClangTranslationCache::store(const QString &fileName, const QByteArray &commandKey,
+    const std::vector<std::string> &includedFiles, const TranslationUnitStores &stores)
+{
+    if (!isEnabled())
+        return;
+    const QByteArray key = entryKey(fileName, commandKey);
+    if (key.isEmpty())
+        return;
+
+    QSaveFile file(cacheFilePath(fileName));
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << cacheMagic << cacheVersion << key;
+
+    // A file is entered again for every inclusion that is not guarded.
+    QStringList paths;
+    paths.reserve(qsizetype(includedFiles.size()));
+    for (const std::string &includedFile : includedFiles)
+        paths.append(QString::fromStdString(includedFile));
+    paths.sort();
+    paths.removeDuplicates();
+
+    out << quint32(paths.size());
+    for (const QString &path : qAsConst(paths))
+        out << path << fileHash(path);
+
+    writeStores(out, stores.Preprocessor);
+    writeStores(out, stores.AST);
+    writeStores(out, stores.QDeclareTrWithContext);
+    writeStores(out, stores.QNoopTranlsationWithContext);
+    if (!file.commit())
+        qWarning("lupdate: Cannot write the clang parser cache file for %s", qPrintable(fileName));
+}
+
+QT_END_NAMESPACE
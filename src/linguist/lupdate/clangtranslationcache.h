@@ -0,0 +1,89 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Linguist of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef CLANG_TRANSLATION_CACHE_H
+#define CLANG_TRANSLATION_CACHE_H
+
+#include "cpp_clang.h"
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qstring.h>
+
+#include <string>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+// The translation information the clang parser collected for one source file
+struct TranslationUnitStores
+{
+    TranslationStores Preprocessor;
+    TranslationStores AST;
+    TranslationStores QDeclareTrWithContext;
+    TranslationStores QNoopTranlsationWithContext;
+};
+
+/*
+    An on-disk cache of the translation information of the source files
+    parsed with clang, with one cache file per source file.
+
+    An entry is only used if the content of the source file, its compile
+    command, the lupdate configuration, and the content of every file it
+    included when the entry was written are unchanged.
+*/
+class ClangTranslationCache
+{
+    Q_DISABLE_COPY_MOVE(ClangTranslationCache)
+
+public:
+    ClangTranslationCache(const QString &directory, const QByteArray &configurationKey);
+
+    bool isEnabled() const { return !m_directory.isEmpty(); }
+
+    bool load(const QString &fileName, const QByteArray &commandKey,
+        TranslationUnitStores *stores);
+    void store(const QString &fileName, const QByteArray &commandKey,
+        const std::vector<std::string> &includedFiles, const TranslationUnitStores &stores);
+
+private:
+    QByteArray entryKey(const QString &fileName, const QByteArray &commandKey);
+    QByteArray fileHash(const QString &fileName);
+    QString cacheFilePath(const QString &fileName) const;
+
+    QString m_directory;
+    QByteArray m_configurationKey;
+
+    QMutex m_mutex;
+    QHash<QString, QByteArray> m_fileHashes; // content hashes, computed once per run
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -27,13 +27,20 @@
 ****************************************************************************/
 
 #include "cpp.h"
+#include "timings.h"
 
+#include <concurrency.h>
 #include <translator.h>
 #include <QtCore/QBitArray>
+#include <QtCore/QMutex>
 #include <QtCore/QStack>
 #include <QtCore/QTextStream>
+#include <QtCore/QThread>
 #include <QtCore/QRegularExpression>
 
+#include <atomic>
+#include <sstream>
+
 QT_BEGIN_NAMESPACE
 
 
@@ -65,7 +72,16 @@ size_t qHash(const HashStringList &list)
     return list.m_hash;
 }
 
-static int nextFileId;
+static std::atomic<int> nextFileId;
+
+// The files are parsed on several threads by loadCPP(). The parse results of headers are
+// shared between them, and so are the namespaces in them; this guards the members of a
+// Namespace that are updated when a tr() call refers to it.
+static QMutex sharedNamespaceMutex;
+
+// Where the parser messages of the current thread go; they are collected per file so that
+// the messages of files parsed concurrently do not interleave.
+static thread_local std::ostream *messageStream = nullptr;
 
 class VisitRecorder {
 public:
@@ -269,7 +285,8 @@ CppParser::CppParser(ParseResults *_results)
 
 std::ostream &CppParser::yyMsg(int line)
 {
-    return std::cerr << qPrintable(yyFileName) << ':' << (line ? line : yyLineNo) << ": ";
+    std::ostream &out = messageStream ? *messageStream : std::cerr;
+    return out << qPrintable(yyFileName) << ':' << (line ? line : yyLineNo) << ": ";
 }
 
 void CppParser::setInput(const QString &in)
@@ -1172,6 +1189,13 @@ bool CppParser::isInClassDeclaration() const
   Functions for processing include files.
 */
 
+QMutex *CppFiles::mutex()
+{
+    static QMutex mutex;
+
+    return &mutex;
+}
+
 IncludeCycleHash &CppFiles::includeCycles()
 {
     static IncludeCycleHash cycles;
@@ -1195,6 +1219,7 @@ QSet<QString> &CppFiles::blacklistedFiles()
 
 QSet<const ParseResults *> CppFiles::getResults(const QString &cleanFile)
 {
+    QMutexLocker lock(mutex());
     IncludeCycle * const cycle = includeCycles().value(cleanFile);
 
     if (cycle)
@@ -1205,6 +1230,7 @@ QSet<const ParseResults *> CppFiles::getResults(const QString &cleanFile)
 
 void CppFiles::setResults(const QString &cleanFile, const ParseResults *results)
 {
+    QMutexLocker lock(mutex());
     IncludeCycle *cycle = includeCycles().value(cleanFile);
 
     if (!cycle) {
@@ -1218,26 +1244,101 @@ void CppFiles::setResults(const QString &cleanFile, const ParseResults *results)
 
 const Translator *CppFiles::getTranslator(const QString &cleanFile)
 {
+    QMutexLocker lock(mutex());
     return translatedFiles().value(cleanFile);
 }
 
 void CppFiles::setTranslator(const QString &cleanFile, const Translator *tor)
 {
+    QMutexLocker lock(mutex());
     translatedFiles().insert(cleanFile, tor);
 }
 
 bool CppFiles::isBlacklisted(const QString &cleanFile)
 {
+    QMutexLocker lock(mutex());
     return blacklistedFiles().contains(cleanFile);
 }
 
 void CppFiles::setBlacklisted(const QString &cleanFile)
 {
+    QMutexLocker lock(mutex());
     blacklistedFiles().insert(cleanFile);
 }
 
+QHash<QString, Qt::HANDLE> &CppFiles::claimedHeaders()
+{
+    static QHash<QString, Qt::HANDLE> claimed;
+
+    return claimed;
+}
+
+QHash<Qt::HANDLE, QString> &CppFiles::awaitedHeaders()
+{
+    static QHash<Qt::HANDLE, QString> awaited;
+
+    return awaited;
+}
+
+QWaitCondition *CppFiles::headerReleased()
+{
+    static QWaitCondition released;
+
+    return &released;
+}
+
+bool CppFiles::claimHeader(const QString &cleanFile)
+{
+    QMutexLocker lock(mutex());
+    const Qt::HANDLE self = QThread::currentThreadId();
+    for (;;) {
+        const IncludeCycle * const cycle = includeCycles().value(cleanFile);
+        if (cycle && !cycle->results.isEmpty())
+            return false;
+        const auto owner = claimedHeaders().constFind(cleanFile);
+        if (owner == claimedHeaders().cend()) {
+            claimedHeaders().insert(cleanFile, self);
+            return true;
+        }
+
+        // Follow the headers the owners wait for. If this leads back to the
+        // calling thread, waiting would deadlock: the headers include each other.
+        QSet<QString> chain { cleanFile };
+        Qt::HANDLE thread = *owner;
+        bool cyclic = false;
+        for (;;) {
+            const auto awaited = awaitedHeaders().constFind(thread);
+            if (awaited == awaitedHeaders().cend() || chain.contains(*awaited))
+                break;
+            chain.insert(*awaited);
+            thread = claimedHeaders().value(*awaited);
+            if (thread == self) {
+                cyclic = true;
+                break;
+            }
+        }
+        if (cyclic) {
+            lock.unlock();
+            addIncludeCycle(chain);
+            return false;
+        }
+
+        awaitedHeaders().insert(self, cleanFile);
+        headerReleased()->wait(mutex());
+        awaitedHeaders().remove(self);
+    }
+}
+
+void CppFiles::releaseHeader(const QString &cleanFile)
+{
+    QMutexLocker lock(mutex());
+    claimedHeaders().remove(cleanFile);
+    headerReleased()->wakeAll();
+}
+
 void CppFiles::addIncludeCycle(const QSet<QString> &fileNames)
 {
+    QMutexLocker lock(mutex());
     IncludeCycle * const cycle = new IncludeCycle;
     cycle->fileNames = fileNames;
 
@@ -1258,6 +1359,91 @@ void CppFiles::addIncludeCycle(const QSet<QString> &fileNames)
         includeCycles().insert(fileName, cycle);
 }
 
+QHash<QString, const ParseResults *> &CppFiles::parsedResults()
+{
+    static QHash<QString, const ParseResults *> results;
+
+    return results;
+}
+
+QHash<QString, QSet<QString>> &CppFiles::includedFiles()
+{
+    static QHash<QString, QSet<QString>> included;
+
+    return included;
+}
+
+QHash<QString, QSet<QString>> &CppFiles::includingFiles()
+{
+    static QHash<QString, QSet<QString>> including;
+
+    return including;
+}
+
+void CppFiles::addInclude(const QString &cleanFile, const QString &includedFile)
+{
+    QMutexLocker lock(mutex());
+    includedFiles()[cleanFile].insert(includedFile);
+    includingFiles()[includedFile].insert(cleanFile);
+}
+
+void CppFiles::setParsed(const QString &cleanFile, const ParseResults *ownResults)
+{
+    QMutexLocker lock(mutex());
+    parsedResults().insert(cleanFile, ownResults);
+}
+
+bool CppFiles::isParsed(const QString &cleanFile)
+{
+    QMutexLocker lock(mutex());
+    return parsedResults().contains(cleanFile);
+}
+
+QStringList CppFiles::parsedFiles()
+{
+    QMutexLocker lock(mutex());
+    return parsedResults().keys();
+}
+
+QSet<QString> CppFiles::forget(const QSet<QString> &cleanFiles)
+{
+    QMutexLocker lock(mutex());
+
+    // The results of a file are part of the results of the files including it, and
+    // the files of an include cycle share theirs, so all of them go.
+    QSet<QString> forgotten;
+    QStringList pending(cleanFiles.cbegin(), cleanFiles.cend());
+    while (!pending.isEmpty()) {
+        const QString fileName = pending.takeLast();
+        if (forgotten.contains(fileName))
+            continue;
+        forgotten.insert(fileName);
+        for (const QString &including : includingFiles().value(fileName))
+            pending << including;
+        if (const IncludeCycle *cycle = includeCycles().value(fileName)) {
+            for (const QString &cycleFile : cycle->fileNames)
+                pending << cycleFile;
+        }
+    }
+
+    QSet<IncludeCycle *> cycles;
+    for (const QString &fileName : qAsConst(forgotten)) {
+        if (IncludeCycle *cycle = includeCycles().take(fileName))
+            cycles.insert(cycle);
+        delete translatedFiles().take(fileName);
+        delete parsedResults().take(fileName);
+        blacklistedFiles().remove(fileName);
+        for (const QString &included : includedFiles().take(fileName)) {
+            const auto it = includingFiles().find(included);
+            if (it != includingFiles().end())
+                it->remove(fileName);
+        }
+        includingFiles().remove(fileName);
+    }
+    qDeleteAll(cycles);
+    return forgotten;
+}
+
 static bool isHeader(const QString &name)
 {
     QString fileExt = QFileInfo(name).suffix();
@@ -1275,6 +1461,8 @@ void CppParser::processInclude(const QString &file, ConversionData &cd, const QS
             return;
     }
 
+    CppFiles::addInclude(yyFileName, cleanFile);
+
     const int index = includeStack.indexOf(cleanFile);
     if (index != -1) {
         CppFiles::addIncludeCycle(QSet<QString>(includeStack.cbegin() + index, includeStack.cend()));
@@ -1296,6 +1484,10 @@ void CppParser::processInclude(const QString &file, ConversionData &cd, const QS
             results->includes.unite(res);
             return;
         }
+        if (!CppFiles::claimHeader(cleanFile)) {
+            results->includes.unite(CppFiles::getResults(cleanFile));
+            return;
+        }
 
         isIndirect = true;
     }
@@ -1304,6 +1496,8 @@ void CppParser::processInclude(const QString &file, ConversionData &cd, const QS
     if (!f.open(QIODevice::ReadOnly)) {
         yyMsg() << qPrintable(
             QStringLiteral("Cannot open %1: %2\n").arg(cleanFile, f.errorString()));
+        if (isIndirect)
+            CppFiles::releaseHeader(cleanFile);
         return;
     }
 
@@ -1324,6 +1518,7 @@ void CppParser::processInclude(const QString &file, ConversionData &cd, const QS
         stack << cleanFile;
         parser.parse(cd, stack, inclusions);
         results->includes.insert(parser.recordResults(true));
+        CppFiles::releaseHeader(cleanFile);
     } else {
         CppParser parser(results);
         parser.namespaces = namespaces;
@@ -1499,6 +1694,7 @@ void CppParser::handleTr(QString &prefix, bool plural)
                     yyMsg() << "tr() cannot be called without context\n";
                     return;
                 }
+                QMutexLocker lock(&sharedNamespaceMutex);
                 Namespace *fctx;
                 while (!(fctx = findNamespace(functionContext, idx)->classDef)->hasTrFunctions) {
                     if (idx == 1) {
@@ -1541,6 +1737,7 @@ void CppParser::handleTr(QString &prefix, bool plural)
             NamespaceList nsl;
             NamespaceList unresolved;
             if (fullyQualify(functionContext, prefix, false, &nsl, &unresolved)) {
+                QMutexLocker lock(&sharedNamespaceMutex);
                 Namespace *fctx = findNamespace(nsl)->classDef;
                 if (fctx->trQualification.isEmpty()) {
                     context = stringifyNamespace(nsl);
@@ -2232,9 +2429,11 @@ const ParseResults *CppParser::recordResults(bool isHeader)
             pr = results;
         }
         CppFiles::setResults(yyFileName, pr);
+        CppFiles::setParsed(yyFileName, pr == results ? results : nullptr);
         return pr;
     } else {
         delete results;
+        CppFiles::setParsed(yyFileName, nullptr);
         return 0;
     }
 }
@@ -2243,17 +2442,37 @@ void loadCPP(Translator &translator, const QStringList &filenames, ConversionDat
 {
     QStringConverter::Encoding e = cd.m_sourceIsUtf16 ? QStringConverter::Utf16 : QStringConverter::Utf8;
 
-    for (const QString &filename : filenames) {
+    // The files are parsed on up to jobCount() threads. A header that is not yet parsed when
+    // a file includes it is parsed by the thread that claims it first, and its results are
+    // shared through CppFiles; other threads that need it wait for them.
+    // The messages are collected per file and taken from the files in their given order below.
+    trFunctionAliasManager.nameToTrFunctionMap(); // build the lookup hash before it is shared
+    QMutex outputMutex;
+    forEachConcurrently(filenames.size(), jobCount(), [&](qsizetype i) {
+        const QString &filename = filenames.at(i);
         if (!CppFiles::getResults(filename).isEmpty() || CppFiles::isBlacklisted(filename))
-            continue;
+            return;
+        if (cd.m_reuseParsedSources && CppFiles::isParsed(filename))
+            return;
+        const bool header = isHeader(filename);
+        if (header && !CppFiles::claimHeader(filename))
+            return;
 
         QFile file(filename);
         if (!file.open(QIODevice::ReadOnly)) {
+            if (header)
+                CppFiles::releaseHeader(filename);
+            QMutexLocker lock(&outputMutex);
             cd.appendError(QStringLiteral("Cannot open %1: %2").arg(filename,
                                                                     file.errorString()));
-            continue;
+            return;
         }
 
+        // The warnings of a file are written in one piece, not interleaved with
+        // those of files parsed at the same time.
+        std::ostringstream messages;
+        messageStream = &messages;
+        const qint64 start = Timings::now();
         CppParser parser;
         QTextStream ts(&file);
         ts.setEncoding(e);
@@ -2263,8 +2482,17 @@ void loadCPP(Translator &translator, const QStringList &filenames, ConversionDat
         parser.setTranslator(tor);
         QSet<QString> inclusions;
         parser.parse(cd, QStringList(), inclusions);
-        parser.recordResults(isHeader(filename));
-    }
+        parser.recordResults(header);
+        if (header)
+            CppFiles::releaseHeader(filename);
+        Timings::addFile(filename, start, Timings::now() - start);
+        messageStream = nullptr;
+
+        if (messages.tellp() > 0) {
+            QMutexLocker lock(&outputMutex);
+            std::cerr << messages.str();
+        }
+    });
 
     for (const QString &filename : filenames) {
         if (!CppFiles::isBlacklisted(filename)) {
@@ -2276,4 +2504,14 @@ void loadCPP(Translator &translator, const QStringList &filenames, ConversionDat
     }
 }
 
+QStringList parsedCppFiles()
+{
+    return CppFiles::parsedFiles();
+}
+
+QSet<QString> forgetCppFiles(const QSet<QString> &fileNames)
+{
+    return CppFiles::forget(fileNames);
+}
+
 QT_END_NAMESPACE
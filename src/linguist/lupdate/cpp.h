@@ -31,7 +31,9 @@
 
 #include "lupdate.h"
 
+#include <QtCore/QMutex>
 #include <QtCore/QSet>
+#include <QtCore/QWaitCondition>
 
 #include <iostream>
 
@@ -116,12 +118,34 @@ public:
     static void setTranslator(const QString &cleanFile, const Translator *results);
     static bool isBlacklisted(const QString &cleanFile);
     static void setBlacklisted(const QString &cleanFile);
+    // A header is parsed stand-alone by one thread only. Returns true if the calling
+    // thread is to parse cleanFile, and false if getResults() already has its results.
+    // Waits while another thread parses it, unless that thread waits for a header the
+    // caller parses; the headers are then recorded as an include cycle.
+    static bool claimHeader(const QString &cleanFile);
+    static void releaseHeader(const QString &cleanFile);
     static void addIncludeCycle(const QSet<QString> &fileNames);
+    static void addInclude(const QString &cleanFile, const QString &includedFile);
+    // ownResults are the results the file does not share with a header it forwards to
+    static void setParsed(const QString &cleanFile, const ParseResults *ownResults);
+    static bool isParsed(const QString &cleanFile);
+    static QStringList parsedFiles();
+    // Drops everything kept about the files and the files that include them,
+    // and returns all files dropped
+    static QSet<QString> forget(const QSet<QString> &cleanFiles);
 
 private:
+    // The files are parsed concurrently, so all accesses are serialized
+    static QMutex *mutex();
     static IncludeCycleHash &includeCycles();
     static TranslatorHash &translatedFiles();
     static QSet<QString> &blacklistedFiles();
+    static QHash<QString, Qt::HANDLE> &claimedHeaders();
+    static QHash<Qt::HANDLE, QString> &awaitedHeaders();
+    static QWaitCondition *headerReleased();
+    static QHash<QString, const ParseResults *> &parsedResults();
+    static QHash<QString, QSet<QString>> &includedFiles();
+    static QHash<QString, QSet<QString>> &includingFiles();
 };
 
 QT_END_NAMESPACE
@@ -28,11 +28,14 @@
 
 #include "cpp_clang.h"
 #include "clangtoolastreader.h"
+#include "clangtranslationcache.h"
 #include "lupdatepreprocessoraction.h"
 #include "synchronized.h"
+#include "timings.h"
 #include "translator.h"
 
 #include <QLibraryInfo>
+#include <QtCore/qcryptographichash.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qjsonarray.h>
@@ -43,14 +46,17 @@
 #include <QtTools/private/qttools-config_p.h>
 
 #include <clang/Tooling/CompilationDatabase.h>
+#include <llvm/Support/VirtualFileSystem.h>
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <thread>
 #include <iostream>
 #include <cstdlib>
 
 #include <cstdio>
+#include <cstring>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -244,6 +250,14 @@ std::vector<std::string> ClangCppParser::getAliasFunctionDefinition()
     return results;
 }
 
+// The include paths of the system compiler do not change during a run, and asking the compiler
+// for them spawns a process, so they are only determined once.
+static const QByteArrayList &systemIncludePaths()
+{
+    static const QByteArrayList paths = getIncludePathsFromCompiler();
+    return paths;
+}
+
 static std::vector<std::string> aliasDefinition;
 // Makes sure all the comments will be parsed and part of the AST
 // Clang will run with the flag -fparse-all-comments
@@ -277,7 +291,7 @@ clang::tooling::ArgumentsAdjuster getClangArgumentAdjuster()
         adjustedArgs.push_back("-Wno-everything");
         adjustedArgs.push_back("-std=gnu++17");
 
-        for (QByteArray line : getIncludePathsFromCompiler()) {
+        for (QByteArray line : systemIncludePaths()) {
             line = line.trimmed();
             if (line.isEmpty())
                 continue;
@@ -294,47 +308,44 @@ clang::tooling::ArgumentsAdjuster getClangArgumentAdjuster()
 bool ClangCppParser::containsTranslationInformation(llvm::StringRef ba)
 {
     // pre-process the files by a simple text search if there is any occurrence
-    // of things we are interested in
-    constexpr llvm::StringLiteral qDeclareTrFunction("Q_DECLARE_TR_FUNCTIONS(");
-    constexpr llvm::StringLiteral qtTrNoop("QT_TR_NOOP(");
-    constexpr llvm::StringLiteral qtTrNoopUTF8("QT_TR_NOOP)UTF8(");
-    constexpr llvm::StringLiteral qtTrNNoop("QT_TR_N_NOOP(");
-    constexpr llvm::StringLiteral qtTrIdNoop("QT_TRID_NOOP(");
-    constexpr llvm::StringLiteral qtTrIdNNoop("QT_TRID_N_NOOP(");
-    constexpr llvm::StringLiteral qtTranslateNoop("QT_TRANSLATE_NOOP(");
-    constexpr llvm::StringLiteral qtTranslateNoopUTF8("QT_TRANSLATE_NOOP_UTF8(");
-    constexpr llvm::StringLiteral qtTranslateNNoop("QT_TRANSLATE_N_NOOP(");
-    constexpr llvm::StringLiteral qtTranslateNoop3("QT_TRANSLATE_NOOP3(");
-    constexpr llvm::StringLiteral qtTranslateNoop3UTF8("QT_TRANSLATE_NOOP3_UTF8(");
-    constexpr llvm::StringLiteral qtTranslateNNoop3("QT_TRANSLATE_N_NOOP3(");
+    // of things we are interested in.
+    // All function-like keywords are followed by an opening parenthesis, so instead of searching
+    // the whole text for each of them, the text is searched once for '(' and the identifier in
+    // front of each parenthesis is compared to the keywords.
+    static constexpr llvm::StringLiteral functionKeywords[] = {
+        "Q_DECLARE_TR_FUNCTIONS", "QT_TR_NOOP", "QT_TR_NOOP_UTF8", "QT_TR_N_NOOP",
+        "QT_TRID_NOOP", "QT_TRID_N_NOOP", "QT_TRANSLATE_NOOP", "QT_TRANSLATE_NOOP_UTF8",
+        "QT_TRANSLATE_N_NOOP", "QT_TRANSLATE_NOOP3", "QT_TRANSLATE_NOOP3_UTF8",
+        "QT_TRANSLATE_N_NOOP3", "qtTrId", "tr", "trUtf8", "translate"
+    };
+    // The last characters of the keywords above, to skip most parentheses with one comparison
+    static constexpr llvm::StringLiteral keywordEndings("rSP83de");
     constexpr llvm::StringLiteral translatorComment("TRANSLATOR ");
-    constexpr llvm::StringLiteral qtTrId("qtTrId(");
-    constexpr llvm::StringLiteral tr("tr(");
-    constexpr llvm::StringLiteral trUtf8("trUtf8(");
-    constexpr llvm::StringLiteral translate("translate(");
-
-    const size_t pos = ba.find_first_of("QT_TR");
-    const auto baSliced = ba.slice(pos, llvm::StringRef::npos);
-     if (pos != llvm::StringRef::npos) {
-         if (baSliced.contains(qtTrNoop) || baSliced.contains(qtTrNoopUTF8) || baSliced.contains(qtTrNNoop)
-             || baSliced.contains(qtTrIdNoop) || baSliced.contains(qtTrIdNNoop)
-             || baSliced.contains(qtTranslateNoop) ||  baSliced.contains(qtTranslateNoopUTF8)
-             ||  baSliced.contains(qtTranslateNNoop) || baSliced.contains(qtTranslateNoop3)
-             ||  baSliced.contains(qtTranslateNoop3UTF8) ||  baSliced.contains(qtTranslateNNoop3))
-             return true;
-     }
-
-     if (ba.contains(qDeclareTrFunction) || ba.contains(translatorComment) || ba.contains(qtTrId) || ba.contains(tr)
-         || ba.contains(trUtf8) || ba.contains(translate))
-        return true;
 
-     for (QString alias : trFunctionAliasManager.listAliases()) {
-         if (ba.contains(qPrintable(alias)))
-             return true;
-     }
+    const char *const begin = ba.data();
+    const char *const end = begin + ba.size();
+    for (const char *paren = begin; paren != end; ++paren) {
+        paren = static_cast<const char *>(std::memchr(paren, '(', size_t(end - paren)));
+        if (!paren)
+            break;
+        if (paren == begin || keywordEndings.find(paren[-1]) == llvm::StringRef::npos)
+            continue;
+        const llvm::StringRef before(begin, size_t(paren - begin));
+        for (const llvm::StringLiteral &keyword : functionKeywords) {
+            if (before.endswith(keyword))
+                return true;
+        }
+    }
 
+    if (ba.contains(translatorComment))
+        return true;
+
+    for (QString alias : trFunctionAliasManager.listAliases()) {
+        if (ba.contains(qPrintable(alias)))
+            return true;
+    }
 
-     return false;
+    return false;
 }
 
 static bool generateCompilationDatabase(const QString &outputFilePath, const ConversionData &cd)
@@ -401,6 +412,37 @@ static void sortMessagesByFileOrder(ClangCppParser::TranslatorMessageVector &mes
               });
 }
 
+// Everything besides the file and its compile command that changes what is extracted from it.
+static QByteArray cacheConfigurationKey()
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArray(QT_VERSION_STR));
+    hash.addData(QByteArray(LUPDATE_CLANG_VERSION_STR));
+    for (const std::string &alias : aliasDefinition)
+        hash.addData(QByteArray::fromStdString(alias + '\0'));
+    for (const QByteArray &includePath : systemIncludePaths())
+        hash.addData(includePath + '\0');
+    return hash.result();
+}
+
+static QByteArray compileCommandKey(const std::vector<clang::tooling::CompileCommand> &commands)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (const auto &command : commands) {
+        hash.addData(QByteArray::fromStdString(command.Directory + '\0'));
+        hash.addData(QByteArray::fromStdString(command.Filename + '\0'));
+        for (const std::string &argument : command.CommandLine)
+            hash.addData(QByteArray::fromStdString(argument + '\0'));
+    }
+    return hash.result();
+}
+
+template<typename T>
+static void appendStores(std::vector<T> *target, const std::vector<T> &source)
+{
+    target->insert(target->end(), source.cbegin(), source.cend());
+}
+
 bool ClangCppParser::hasAliases()
 {
     QStringList listAlias = trFunctionAliasManager.listAliases();
@@ -418,28 +460,58 @@ void ClangCppParser::loadCPP(Translator &translator, const QStringList &files, C
     // pre-process the files by a simple text search if there is any occurrence
     // of things we are interested in
     qCDebug(lcClang) << "Load CPP \n";
-    std::vector<std::string> sourcesAst, sourcesPP;
-    for (const QString &filename : files) {
-        QFile file(filename);
-        qCDebug(lcClang) << "File: " << filename << " \n";
-        if (file.open(QIODevice::ReadOnly)) {
-            if (const uchar *memory = file.map(0, file.size())) {
-                const auto ba = llvm::StringRef((const char*) (memory), file.size());
-                if (containsTranslationInformation(ba)) {
-                    sourcesPP.emplace_back(filename.toStdString());
-                    sourcesAst.emplace_back(sourcesPP.back());
-                }
-            } else {
-                QByteArray mem = file.readAll();
-                const auto ba = llvm::StringRef((const char*) (mem), file.size());
-                if (containsTranslationInformation(ba)) {
-                    sourcesPP.emplace_back(filename.toStdString());
-                    sourcesAst.emplace_back(sourcesPP.back());
+    // The files are scanned in parallel; the size of a file that is to be parsed is stored at
+    // its index, -1 marks the files without translation information.
+    std::vector<qint64> sizes(size_t(files.size()), -1);
+    std::atomic<size_t> nextFile = 0;
+    const qint64 scanStart = Timings::now();
+    std::vector<std::thread> scanners;
+    const size_t scannerCount = std::min(sizes.size(), size_t(std::thread::hardware_concurrency()));
+    for (size_t i = 0; i < scannerCount; ++i) {
+        scanners.emplace_back([&files, &sizes, &nextFile]() {
+            for (size_t index = nextFile++; index < sizes.size(); index = nextFile++) {
+                const QString &filename = files.at(qsizetype(index));
+                QFile file(filename);
+                qCDebug(lcClang) << "File: " << filename << " \n";
+                if (!file.open(QIODevice::ReadOnly))
+                    continue;
+                if (const uchar *memory = file.map(0, file.size())) {
+                    const auto ba = llvm::StringRef((const char*) (memory), file.size());
+                    if (containsTranslationInformation(ba))
+                        sizes[index] = file.size();
+                } else {
+                    QByteArray mem = file.readAll();
+                    const auto ba = llvm::StringRef((const char*) (mem), file.size());
+                    if (containsTranslationInformation(ba))
+                        sizes[index] = file.size();
                 }
             }
-        }
+        });
+    }
+    for (auto &scanner : scanners)
+        scanner.join();
+    Timings::addPhase("clang: scanning for translation information", scanStart,
+                      Timings::now() - scanStart);
+
+    std::vector<std::pair<qint64, std::string>> sourcesBySize;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (sizes[i] >= 0)
+            sourcesBySize.emplace_back(sizes[i], files.at(qsizetype(i)).toStdString());
     }
 
+    // Hand out the largest files first, so that a big file near the end of the list does not
+    // keep one producer busy while the others are idle. The messages are sorted by file order
+    // afterwards.
+    std::stable_sort(sourcesBySize.begin(), sourcesBySize.end(),
+        [](const std::pair<qint64, std::string> &lhs, const std::pair<qint64, std::string> &rhs) {
+            return lhs.first > rhs.first;
+        });
+    std::vector<std::string> sourcesAst;
+    sourcesAst.reserve(sourcesBySize.size());
+    for (auto &source : sourcesBySize)
+        sourcesAst.emplace_back(std::move(source.second));
+    sourcesBySize.clear();
+
     std::string errorMessage;
     std::unique_ptr<CompilationDatabase> db;
     if (cd.m_compilationDatabaseDir.isEmpty()) {
@@ -456,6 +528,7 @@ void ClangCppParser::loadCPP(Translator &translator, const QStringList &files, C
     if (!db) {
         const QString dbFilePath = QStringLiteral("compile_commands.json");
         qCDebug(lcClang) << "Generating compilation database" << dbFilePath;
+        Timings::Phase phase("clang: generating the compilation database");
         if (!generateCompilationDatabase(dbFilePath, cd)) {
             *fail = true;
             cd.appendError(u"Cannot generate compilation database."_qs);
@@ -472,37 +545,72 @@ void ClangCppParser::loadCPP(Translator &translator, const QStringList &files, C
     }
 
     TranslationStores ast, qdecl, qnoop;
-    Stores stores(ast, qdecl, qnoop);
+    QMutex storesMutex;
 
-    std::vector<std::thread> producers;
-    ReadSynchronizedRef<std::string> ppSources(sourcesPP);
-    WriteSynchronizedRef<TranslationRelatedStore> ppStore(stores.Preprocessor);
-    size_t idealProducerCount = std::min(ppSources.size(), size_t(std::thread::hardware_concurrency()));
+    ClangTranslationCache cache(cd.m_clangParserCacheDir,
+        cd.m_clangParserCacheDir.isEmpty() ? QByteArray() : cacheConfigurationKey());
 
+    // Each file is parsed once; the preprocessor and the AST information of a file are
+    // collected together, so that the per-file results can be taken from or written to the cache.
+    std::vector<std::thread> producers;
+    ReadSynchronizedRef<std::string> sources(sourcesAst);
+    const size_t idealProducerCount = std::min(sources.size(),
+        size_t(std::thread::hardware_concurrency()));
+    const qint64 producersStart = Timings::now();
+    std::atomic<qint64> producersBusy = 0;
     for (size_t i = 0; i < idealProducerCount; ++i) {
-        std::thread producer([&ppSources, &db, &ppStore]() {
+        std::thread producer([&]() {
+#if (LUPDATE_CLANG_VERSION >= LUPDATE_CLANG_VERSION_CHECK(10,0,0))
+            // Shared by the tools of all files of this producer, so that the headers the files
+            // have in common are looked up and stat'ed once per producer instead of once per file.
+            // Each producer has its own file system, because the tools change its working directory.
+            llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem(
+                llvm::vfs::createPhysicalFileSystem().release());
+            llvm::IntrusiveRefCntPtr<clang::FileManager> fileManager(
+                new clang::FileManager(clang::FileSystemOptions(), fileSystem));
+#endif
             std::string file;
-            while (ppSources.next(&file)) {
-                clang::tooling::ClangTool tool(*db, file);
-                tool.appendArgumentsAdjuster(getClangArgumentAdjuster());
-                tool.run(new LupdatePreprocessorActionFactory(&ppStore));
-            }
-        });
-        producers.emplace_back(std::move(producer));
-    }
-    for (auto &producer : producers)
-        producer.join();
-    producers.clear();
+            while (sources.next(&file)) {
+                const qint64 start = Timings::now();
+                const QString fileName = QString::fromStdString(file);
+                QByteArray commandKey;
+                TranslationUnitStores unit;
+                bool cached = false;
+                if (cache.isEnabled()) {
+                    commandKey = compileCommandKey(db->getCompileCommands(file));
+                    cached = cache.load(fileName, commandKey, &unit);
+                }
 
-    ReadSynchronizedRef<std::string> astSources(sourcesAst);
-    idealProducerCount = std::min(astSources.size(), size_t(std::thread::hardware_concurrency()));
-    for (size_t i = 0; i < idealProducerCount; ++i) {
-        std::thread producer([&astSources, &db, &stores]() {
-            std::string file;
-            while (astSources.next(&file)) {
-                clang::tooling::ClangTool tool(*db, file);
-                tool.appendArgumentsAdjuster(getClangArgumentAdjuster());
-                tool.run(new LupdateToolActionFactory(&stores));
+                if (!cached) {
+                    std::vector<std::string> includedFiles;
+                    Stores stores(unit.AST, unit.QDeclareTrWithContext,
+                        unit.QNoopTranlsationWithContext);
+                    {
+                        LupdateToolActionFactory factory(&stores,
+                            cache.isEnabled() ? &includedFiles : nullptr);
+#if (LUPDATE_CLANG_VERSION >= LUPDATE_CLANG_VERSION_CHECK(10,0,0))
+                        clang::tooling::ClangTool tool(*db, file,
+                            std::make_shared<clang::PCHContainerOperations>(), fileSystem,
+                            fileManager);
+#else
+                        clang::tooling::ClangTool tool(*db, file);
+#endif
+                        tool.appendArgumentsAdjuster(getClangArgumentAdjuster());
+                        tool.run(&factory);
+                    }
+                    unit.Preprocessor = std::move(stores.Preprocessor);
+
+                    cache.store(fileName, commandKey, includedFiles, unit);
+                }
+
+                const qint64 duration = Timings::now() - start;
+                producersBusy += duration;
+                Timings::addFile(fileName, start, duration);
+
+                QMutexLocker lock(&storesMutex);
+                appendStores(&ast, unit.AST);
+                appendStores(&qdecl, unit.QDeclareTrWithContext);
+                appendStores(&qnoop, unit.QNoopTranlsationWithContext);
             }
         });
         producers.emplace_back(std::move(producer));
@@ -510,7 +618,11 @@ void ClangCppParser::loadCPP(Translator &translator, const QStringList &files, C
     for (auto &producer : producers)
         producer.join();
     producers.clear();
+    Timings::addPhase("clang: parsing", producersStart, Timings::now() - producersStart);
+    Timings::addPool("clang producers", int(idealProducerCount),
+                     Timings::now() - producersStart, producersBusy);
 
+    const qint64 correctionStart = Timings::now();
     TranslationStores finalStores;
     WriteSynchronizedRef<TranslationRelatedStore> wsv(finalStores);
 
@@ -526,6 +638,9 @@ void ClangCppParser::loadCPP(Translator &translator, const QStringList &files, C
     for (auto &store : finalStores)
         ClangCppParser::collectMessages(messages, store);
 
+    Timings::addPhase("clang: correcting translation contexts", correctionStart,
+                      Timings::now() - correctionStart);
+
     sortMessagesByFileOrder(messages, files);
 
     for (TranslatorMessage &msg : messages) {
@@ -33,11 +33,11 @@
 #include <QtCore/QDebug>
 #include <QtCore/QFile>
 #include <QtCore/QStack>
-#include <QtCore/QStack>
 #include <QtCore/QString>
+#include <QtCore/QStringConverter>
 #include <QtCore/QCoreApplication>
 
-#include <iostream>
+#include <sstream>
 
 #include <ctype.h>
 
@@ -68,66 +68,96 @@ class Scope
 };
 
 /*
-  The tokenizer maintains the following global variables. The names
-  should be self-explanatory.
+  The parser keeps all of its state in the object, so that several files can
+  be parsed at the same time. The names should be self-explanatory.
+  Identifiers and comments are views into the decoded file, which outlives
+  the parser.
 */
+class JavaParser
+{
+public:
+    JavaParser(const QString &fileName, QStringView input)
+        : yyFileName(fileName), yyInPtr(input.data()), yyInEnd(input.data() + input.size())
+    {}
+    ~JavaParser() { qDeleteAll(yyScope); }
+
+    void parse(Translator *tor, ConversionData &cd);
+    // The warnings about the file, one per line
+    std::string messages() const { return yyMessages.str(); }
+
+private:
+    std::ostream &yyMsg(int line = 0);
+    QChar getChar();
+    int getToken();
+    bool match(int t);
+    bool matchString(QString &s);
+    bool matchStringOrNull(QString &s);
+    bool matchExpression();
+    QString context() const;
+    void recordMessage(Translator *tor, const QString &context, const QString &text,
+                       const QString &comment, const QString &extracomment, bool plural,
+                       ConversionData &cd);
+
+    QString yyFileName;
+    QChar yyCh;
+    QStringView yyIdent;
+    QStringView yyComment;
+    QString yyString;
+    bool yyEOF = false;
+
+    qlonglong yyInteger = 0;
+    int yyParenDepth = 0;
+    int yyLineNo = 0;
+    int yyCurLineNo = 1;
+    int yyParenLineNo = 1;
+    int yyTok = -1;
+
+    // the characters to read and the current position in them
+    const QChar *yyInPtr;
+    const QChar *yyInEnd;
+
+    QString yyPackage;
+    QStack<Scope*> yyScope;
+
+    std::ostringstream yyMessages;
+};
 
-static QString yyFileName;
-static QChar yyCh;
-static QString yyIdent;
-static QString yyComment;
-static QString yyString;
-static bool yyEOF = false;
-
-static qlonglong yyInteger;
-static int yyParenDepth;
-static int yyLineNo;
-static int yyCurLineNo;
-static int yyParenLineNo;
-static int yyTok;
-
-// the string to read from and current position in the string
-static QString yyInStr;
-static int yyInPos;
-
-// The parser maintains the following global variables.
-static QString yyPackage;
-static QStack<Scope*> yyScope;
-
-std::ostream &yyMsg(int line = 0)
+std::ostream &JavaParser::yyMsg(int line)
 {
-    return std::cerr << qPrintable(yyFileName) << ':' << (line ? line : yyLineNo) << ": ";
+    return yyMessages << qPrintable(yyFileName) << ':' << (line ? line : yyLineNo) << ": ";
 }
 
-static QChar getChar()
+QChar JavaParser::getChar()
 {
-    if (yyInPos >= yyInStr.size()) {
+    if (yyInPtr == yyInEnd) {
         yyEOF = true;
         return QChar();
     }
-    QChar c = yyInStr[yyInPos++];
+    QChar c = *yyInPtr++;
     if (c == QLatin1Char('\n'))
         ++yyCurLineNo;
     return c;
 }
 
-static int getToken()
+int JavaParser::getToken()
 {
     const char tab[] = "bfnrt\"\'\\";
     const char backTab[] = "\b\f\n\r\t\"\'\\";
 
-    yyIdent.clear();
-    yyComment.clear();
+    yyIdent = QStringView();
+    yyComment = QStringView();
     yyString.clear();
 
     while (!yyEOF) {
         yyLineNo = yyCurLineNo;
 
         if ( yyCh.isLetter() || yyCh.toLatin1() == '_' ) {
+            // yyCh has been read already
+            const QChar *start = yyInPtr - 1;
             do {
-                yyIdent.append(yyCh);
                 yyCh = getChar();
             } while ( yyCh.isLetterOrNumber() || yyCh.toLatin1() == '_' );
+            yyIdent = QStringView(start, yyEOF ? yyInPtr : yyInPtr - 1);
 
             if (yyTok != Tok_Dot) {
                 switch ( yyIdent.at(0).toLatin1() ) {
@@ -163,15 +193,16 @@ static int getToken()
             case '/':
                 yyCh = getChar();
                 if ( yyCh == QLatin1Char('/') ) {
+                    // up to and including the end of the line
+                    const QChar *start = yyInPtr;
                     do {
                         yyCh = getChar();
-                        if (yyEOF)
-                            break;
-                        yyComment.append(yyCh);
-                    } while (yyCh != QLatin1Char('\n'));
+                    } while (!yyEOF && yyCh != QLatin1Char('\n'));
+                    yyComment = QStringView(start, yyInPtr);
                     return Tok_Comment;
 
                 } else if ( yyCh == QLatin1Char('*') ) {
+                    const QChar *start = yyInPtr;
                     bool metAster = false;
                     bool metAsterSlash = false;
 
@@ -179,11 +210,10 @@ static int getToken()
                         yyCh = getChar();
                         if (yyEOF) {
                             yyMsg() << "Unterminated Java comment.\n";
+                            yyComment = QStringView(start, yyInPtr);
                             return Tok_Comment;
                         }
 
-                        yyComment.append( yyCh );
-
                         if ( yyCh == QLatin1Char('*') )
                             metAster = true;
                         else if ( metAster && yyCh == QLatin1Char('/') )
@@ -191,7 +221,7 @@ static int getToken()
                         else
                             metAster = false;
                     }
-                    yyComment.chop(2);
+                    yyComment = QStringView(start, yyInPtr - 2);
                     yyCh = getChar();
 
                     return Tok_Comment;
@@ -232,8 +262,13 @@ static int getToken()
                             yyCh = getChar();
                         }
                     } else {
-                        yyString.append(yyCh);
-                        yyCh = getChar();
+                        // append the run of characters up to the next escape at once
+                        const QChar *start = yyInPtr - 1;
+                        do {
+                            yyCh = getChar();
+                        } while (!yyEOF && yyCh != QLatin1Char('\n') && yyCh != QLatin1Char('"')
+                                 && yyCh != QLatin1Char('\\'));
+                        yyString.append(QStringView(start, yyEOF ? yyInPtr : yyInPtr - 1));
                     }
                 }
 
@@ -331,7 +366,7 @@ static int getToken()
     return Tok_Eof;
 }
 
-static bool match( int t )
+bool JavaParser::match( int t )
 {
     bool matches = ( yyTok == t );
     if ( matches )
@@ -339,7 +374,7 @@ static bool match( int t )
     return matches;
 }
 
-static bool matchString( QString &s )
+bool JavaParser::matchString( QString &s )
 {
     if ( yyTok != Tok_String )
         return false;
@@ -361,7 +396,7 @@ static bool matchString( QString &s )
     return true;
 }
 
-static bool matchStringOrNull(QString &s)
+bool JavaParser::matchStringOrNull(QString &s)
 {
     bool matches = matchString(s);
     if (!matches) {
@@ -386,7 +421,7 @@ static bool matchStringOrNull(QString &s)
  * list(a,b).size(2,4)
  * etc...
  */
-static bool matchExpression()
+bool JavaParser::matchExpression()
 {
     if (match(Tok_Integer)) {
         return true;
@@ -414,7 +449,7 @@ static bool matchExpression()
     return true;
 }
 
-static const QString context()
+QString JavaParser::context() const
 {
       QString context(yyPackage);
       bool innerClass = false;
@@ -432,7 +467,7 @@ static const QString context()
      return context;
 }
 
-static void recordMessage(
+void JavaParser::recordMessage(
     Translator *tor, const QString &context, const QString &text, const QString &comment,
     const QString &extracomment, bool plural, ConversionData &cd)
 {
@@ -444,7 +479,7 @@ static void recordMessage(
     tor->extend(msg, cd);
 }
 
-static void parse(Translator *tor, ConversionData &cd)
+void JavaParser::parse(Translator *tor, ConversionData &cd)
 {
     QString text;
     QString com;
@@ -459,7 +494,7 @@ static void parse(Translator *tor, ConversionData &cd)
         case Tok_class:
             yyTok = getToken();
             if(yyTok == Tok_Ident) {
-                yyScope.push(new Scope(yyIdent, Scope::Clazz, yyLineNo));
+                yyScope.push(new Scope(yyIdent.toString(), Scope::Clazz, yyLineNo));
             }
             else {
                 yyMsg() << "'class' must be followed by a class name.\n";
@@ -525,10 +560,8 @@ static void parse(Translator *tor, ConversionData &cd)
             break;
 
         case Tok_Comment:
-            if (yyComment.startsWith(QLatin1Char(':'))) {
-                yyComment.remove(0, 1);
-                extracomment.append(yyComment);
-            }
+            if (yyComment.startsWith(QLatin1Char(':')))
+                extracomment.append(yyComment.sliced(1));
             yyTok = getToken();
             break;
 
@@ -590,25 +623,25 @@ bool loadJava(Translator &translator, const QString &filename, ConversionData &c
         return false;
     }
 
-    yyInPos = -1;
-    yyFileName = filename;
-    yyPackage.clear();
-    yyScope.clear();
-    yyTok = -1;
-    yyParenDepth = 0;
-    yyCurLineNo = 0;
-    yyParenLineNo = 1;
-
-    QTextStream ts(&file);
-    ts.setEncoding(cd.m_sourceIsUtf16 ? QStringConverter::Utf16 : QStringConverter::Utf8);
-    ts.setAutoDetectUnicode(true);
-    yyInStr = ts.readAll();
-    yyInPos = 0;
-    yyFileName = filename;
-    yyCurLineNo = 1;
-    yyParenLineNo = 1;
-
-    parse(&translator, cd);
+    // The file is mapped and decoded at once; a byte order mark overrides the
+    // encoding of the project.
+    QByteArray content;
+    QByteArrayView data;
+    if (const uchar *mapped = file.size() ? file.map(0, file.size()) : nullptr)
+        data = QByteArrayView(mapped, file.size());
+    else
+        data = content = file.readAll();
+    const auto encoding = QStringConverter::encodingForData(data).value_or(
+            cd.m_sourceIsUtf16 ? QStringConverter::Utf16 : QStringConverter::Utf8);
+    const QString input = QStringDecoder(encoding).decode(data);
+
+    JavaParser parser(filename, input);
+    parser.parse(&translator, cd);
+
+    // Reported with the messages of the other files, in file order
+    const std::string messages = parser.messages();
+    if (!messages.empty())
+        cd.appendError(QString::fromStdString(messages).chopped(1));
     return true;
 }
 
@@ -35,6 +35,7 @@
 #include <QtCore/QList>
 #include <QtCore/QHash>
 #include <QtCore/QCoreApplication>
+#include <QtCore/QSet>
 #include <QtCore/QString>
 #include <QtCore/QStringList>
 #include <QtCore/QTranslator>
@@ -57,7 +58,8 @@ enum UpdateOption {
     RelativeLocations = 512,
     NoLocations = 1024,
     NoUiLines = 2048,
-    SourceIsUtf16 = 4096
+    SourceIsUtf16 = 4096,
+    Watch = 8192
 };
 
 Q_DECLARE_FLAGS(UpdateOptions, UpdateOption)
@@ -68,6 +70,13 @@ Translator merge(
     UpdateOptions options, QString &err);
 
 void loadCPP(Translator &translator, const QStringList &filenames, ConversionData &cd);
+// For the -watch mode: the C++ files loadCPP() has read, including the headers, and
+// dropping what it keeps of changed files and of the files including them, which
+// are all returned.
+QStringList parsedCppFiles();
+QSet<QString> forgetCppFiles(const QSet<QString> &fileNames);
+// The number of files or projects processed at the same time, set with -jobs
+int jobCount();
 bool loadJava(Translator &translator, const QString &filename, ConversionData &cd);
 bool loadPython(Translator &translator, const QString &fileName, ConversionData &cd);
 bool loadUI(Translator &translator, const QString &filename, ConversionData &cd);
@@ -175,4 +175,20 @@ void LupdatePPCallbacks::SourceRangeSkipped(clang::SourceRange sourceRange,
 
 }
 
+// Hook called when the preprocessor enters or leaves a file.
+// Records the files included by the input file, if requested.
+void LupdatePPCallbacks::FileChanged(clang::SourceLocation sourceLocation, FileChangeReason reason,
+    clang::SrcMgr::CharacteristicKind fileType, clang::FileID previousFileId)
+{
+    Q_UNUSED(fileType);
+    Q_UNUSED(previousFileId);
+
+    if (!m_includedFiles || reason != EnterFile)
+        return;
+    const auto &sm = m_preprocessor.getSourceManager();
+    const clang::FileEntry *fileEntry = sm.getFileEntryForID(sm.getFileID(sourceLocation));
+    if (fileEntry && fileEntry->getName() != m_inputFile)
+        m_includedFiles->push_back(fileEntry->getName().str());
+}
+
 QT_END_NAMESPACE
@@ -40,9 +40,6 @@
 # pragma warning(disable: 4624)
 #endif
 
-#include <clang/Frontend/CompilerInstance.h>
-#include <clang/Frontend/FrontendActions.h>
-#include <clang/Tooling/Tooling.h>
 #include <clang/Lex/PPCallbacks.h>
 #include <clang/Lex/Preprocessor.h>
 
@@ -51,15 +48,19 @@
 #endif
 
 #include <memory>
+#include <string>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
 class LupdatePPCallbacks : public clang::PPCallbacks
 {
 public:
-    LupdatePPCallbacks(WriteSynchronizedRef<TranslationRelatedStore> *stores, clang::Preprocessor &pp)
+    LupdatePPCallbacks(WriteSynchronizedRef<TranslationRelatedStore> *stores, clang::Preprocessor &pp,
+            std::vector<std::string> *includedFiles = nullptr)
         : m_preprocessor(pp)
         , m_stores(stores)
+        , m_includedFiles(includedFiles)
     {
         const auto &sm = m_preprocessor.getSourceManager();
         m_inputFile = sm.getFileEntryForID(sm.getMainFileID())->getName();
@@ -70,6 +71,14 @@ public:
         m_stores->emplace_bulk(std::move(m_ppStores));
     }
 
+    // Hands the collected information over before the AST of the translation unit is
+    // processed, which happens before the preprocessor is destroyed.
+    void EndOfMainFile() override
+    {
+        m_stores->emplace_bulk(std::move(m_ppStores));
+        m_ppStores.clear();
+    }
+
 private:
     void MacroExpands(const clang::Token &token, const clang::MacroDefinition &macroDefinition,
         clang::SourceRange sourceRange, const clang::MacroArgs *macroArgs) override;
@@ -78,56 +87,15 @@ private:
 
     void SourceRangeSkipped(clang::SourceRange sourceRange, clang::SourceLocation endifLoc) override;
 
+    void FileChanged(clang::SourceLocation sourceLocation, FileChangeReason reason,
+        clang::SrcMgr::CharacteristicKind fileType, clang::FileID previousFileId) override;
+
     std::string m_inputFile;
     clang::Preprocessor &m_preprocessor;
 
     TranslationStores m_ppStores;
     WriteSynchronizedRef<TranslationRelatedStore> *m_stores { nullptr };
-};
-
-class LupdatePreprocessorAction : public clang::PreprocessOnlyAction
-{
-public:
-    LupdatePreprocessorAction(WriteSynchronizedRef<TranslationRelatedStore> *stores)
-        : m_stores(stores)
-    {}
-
-private:
-    void ExecuteAction() override
-    {
-        auto &preprocessor = getCompilerInstance().getPreprocessor();
-        preprocessor.SetSuppressIncludeNotFoundError(true);
-        auto callbacks = new LupdatePPCallbacks(m_stores, preprocessor);
-        preprocessor.addPPCallbacks(std::unique_ptr<clang::PPCallbacks>(callbacks));
-
-        clang::PreprocessOnlyAction::ExecuteAction();
-    }
-
-private:
-    WriteSynchronizedRef<TranslationRelatedStore> *m_stores { nullptr };
-};
-
-class LupdatePreprocessorActionFactory : public clang::tooling::FrontendActionFactory
-{
-public:
-    explicit LupdatePreprocessorActionFactory(WriteSynchronizedRef<TranslationRelatedStore> *stores)
-        : m_stores(stores)
-    {}
-
-#if (LUPDATE_CLANG_VERSION >= LUPDATE_CLANG_VERSION_CHECK(10,0,0))
-    std::unique_ptr<clang::FrontendAction> create() override
-    {
-        return std::make_unique<LupdatePreprocessorAction>(m_stores);
-    }
-#else
-    clang::FrontendAction *create() override
-    {
-        return new LupdatePreprocessorAction(m_stores);
-    }
-#endif
-
-private:
-    WriteSynchronizedRef<TranslationRelatedStore> *m_stores { nullptr };
+    std::vector<std::string> *m_includedFiles { nullptr };
 };
 
 QT_END_NAMESPACE
@@ -28,12 +28,17 @@
 ****************************************************************************/
 
 #include "lupdate.h"
+#include "timings.h"
 #if QT_CONFIG(clangcpp)
 #include "cpp_clang.h"
 #endif
 
+#include <concurrency.h>
 #include <profileutils.h>
 #include <projectdescriptionreader.h>
+#ifdef LINGUIST_INPROCESS_PROJECTS
+#include <projectevaluator.h>
+#endif
 #include <qrcreader.h>
 #include <runqttool.h>
 #include <translator.h>
@@ -42,16 +47,27 @@
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
+#if QT_CONFIG(filesystemwatcher)
+#include <QtCore/QFileSystemWatcher>
+#endif
 #include <QtCore/QLibraryInfo>
+#include <QtCore/QMutex>
 #include <QtCore/QString>
 #include <QtCore/QStringList>
+#include <QtCore/QTimer>
 #include <QtCore/QTranslator>
+#include <QtCore/QWaitCondition>
 
+#include <algorithm>
+#include <deque>
+#include <functional>
 #include <iostream>
+#include <vector>
 
 bool useClangToParseCpp = false;
 QString commandLineCompilationDatabaseDir; // for the path to the json file passed as a command line argument.
                                     // Has priority over what is in the .pro file and passed to the project.
+QString clangParserCacheDir;
 
 // Can't have an array of QStaticStringData<N> for different N, so
 // use QString, which requires constructor calls. Doesn't matter
@@ -210,6 +226,12 @@ QString ParserTool::transcode(const QString &str)
 }
 
 static QString m_defaultExtensions;
+static int m_jobCount = 1;
+
+int jobCount()
+{
+    return m_jobCount;
+}
 
 static void printOut(const QString & out)
 {
@@ -256,6 +278,9 @@ static void printUsage()
         "           Only include plural form messages.\n"
         "    -silent\n"
         "           Do not explain what is being done.\n"
+        "    -jobs <count>\n"
+        "           Parse files and update projects on up to <count> threads.\n"
+        "           The default is 1.\n"
         "    -no-sort\n"
         "           Do not sort contexts in TS files.\n"
         "    -no-recursive\n"
@@ -284,6 +309,11 @@ static void printUsage()
         "           Virtual output directory for processing subsequent .pro files.\n"
         "    -pro-debug\n"
         "           Trace processing .pro files. Specify twice for more verbosity.\n"
+        "    -pro-cache <directory>\n"
+        "           Store parsed .pro, .pri and .prf files in <directory> and reuse\n"
+        "           them in later runs if the files did not change.\n"
+        "    -pro-jobs <count>\n"
+        "           Evaluate up to <count> subprojects at the same time.\n"
         "    -source-language <language>[_<region>]\n"
         "           Specify the language of the source strings for new files.\n"
         "           Defaults to POSIX if not specified.\n"
@@ -297,8 +327,18 @@ static void printUsage()
         "             %2\n"
         "    -ts <ts-file>...\n"
         "           Specify the output file(s). This will override the TRANSLATIONS.\n"
+        "    -timings\n"
+        "           Print how long the phases of the run took, the slowest files and\n"
+        "           how busy the parser threads were.\n"
+        "    -timings-trace <trace-file>\n"
+        "           Like -timings, and also write the events as a Chrome trace.\n"
         "    -version\n"
         "           Display the version of lupdate and exit.\n"
+        "    -watch\n"
+        "           Keep running after updating the TS files, and update them again\n"
+        "           whenever source files change. Only the changed files and the files\n"
+        "           including them are parsed again, and only the TS files of the\n"
+        "           projects containing them are written.\n"
         "    -clang-parser [compilation-database-dir]\n"
         "           Use clang to parse cpp files. Otherwise a custom parser is used.\n"
         "           This option needs a clang compilation database (compile_commands.json)\n"
@@ -309,6 +349,11 @@ static void printUsage()
         "           A directory specified on the command line takes precedence.\n"
         "           If no path is given, the compilation database will be searched\n"
         "           in all parent paths of the first input file.\n"
+        "    -clang-parser-cache <directory>\n"
+        "           Store the translation information that the clang parser extracts from\n"
+        "           each file in <directory>, and reuse it in later runs for files that,\n"
+        "           together with the files they include and their compile command, have\n"
+        "           not changed.\n"
         "    @lst-file\n"
         "           Read additional file names (one per line) or includepaths (one per\n"
         "           line, and prefixed with -I) from lst-file.\n"
@@ -347,6 +392,30 @@ static bool handleTrFunctionAliases(const QString &arg)
     return true;
 }
 
+// Set on the threads that process projects concurrently, so that the work
+// of a project is not spread over further threads.
+static thread_local bool inProjectTask = false;
+
+// The output of updating one TS file. It is collected while the files are
+// updated concurrently and printed afterwards, in the order of the files.
+struct TsFileMessages
+{
+    void out(const QString &text) { lines.append({ false, text }); }
+    void err(const QString &text) { lines.append({ true, text }); }
+    void print() const
+    {
+        for (const auto &line : lines) {
+            if (line.first)
+                printErr(line.second);
+            else
+                printOut(line.second);
+        }
+    }
+
+    QList<std::pair<bool, QString>> lines; // true for stderr
+    bool fail = false;
+};
+
 static void updateTsFiles(const Translator &fetchedTor, const QStringList &tsFileNames,
     const QStringList &alienFiles,
     const QString &sourceLanguage, const QString &targetLanguage,
@@ -372,27 +441,35 @@ static void updateTsFiles(const Translator &fetchedTor, const QStringList &tsFil
         aliens << tor;
     }
 
-    QDir dir;
-    QString err;
-    for (const QString &fileName : tsFileNames) {
-        QString fn = dir.relativeFilePath(fileName);
+    // find() builds the lookup index on first use; build it now, as the
+    // translators are shared by the threads below.
+    fetchedTor.ensureIndexed();
+    for (const Translator &alien : qAsConst(aliens))
+        alien.ensureIndexed();
+
+    const qsizetype count = tsFileNames.size();
+    std::vector<TsFileMessages> messages(count);
+    auto updateTsFile = [&](qsizetype index) {
+        const QString &fileName = tsFileNames.at(index);
+        TsFileMessages &msgs = messages[index];
+        QString fn = QDir().relativeFilePath(fileName);
         ConversionData cd;
         Translator tor;
         cd.m_sortContexts = !(options & NoSort);
         if (QFile(fileName).exists()) {
             if (!tor.load(fileName, cd, QLatin1String("auto"))) {
-                printErr(cd.error());
-                *fail = true;
-                continue;
+                msgs.err(cd.error());
+                msgs.fail = true;
+                return;
             }
             tor.resolveDuplicates();
             cd.clearErrors();
             if (!targetLanguage.isEmpty() && targetLanguage != tor.languageCode())
-                printErr(QStringLiteral("lupdate warning: Specified target language '%1' disagrees with"
+                msgs.err(QStringLiteral("lupdate warning: Specified target language '%1' disagrees with"
                                 " existing file's language '%2'. Ignoring.\n")
                          .arg(targetLanguage, tor.languageCode()));
             if (!sourceLanguage.isEmpty() && sourceLanguage != tor.sourceLanguageCode())
-                printErr(QStringLiteral("lupdate warning: Specified source language '%1' disagrees with"
+                msgs.err(QStringLiteral("lupdate warning: Specified source language '%1' disagrees with"
                                 " existing file's language '%2'. Ignoring.\n")
                          .arg(sourceLanguage, tor.sourceLanguageCode()));
             // If there is translation in the file, the language should be recognized
@@ -403,9 +480,9 @@ static void updateTsFiles(const Translator &fetchedTor, const QStringList &tsFil
                 tor.languageAndCountry(tor.languageCode(), &l, &c);
                 QStringList forms;
                 if (!getNumerusInfo(l, c, 0, &forms, 0)) {
-                    printErr(QStringLiteral("File %1 won't be updated: it contains translation but the"
+                    msgs.err(QStringLiteral("File %1 won't be updated: it contains translation but the"
                     " target language is not recognized\n").arg(fileName));
-                    continue;
+                    return;
                 }
             }
         } else {
@@ -424,20 +501,23 @@ static void updateTsFiles(const Translator &fetchedTor, const QStringList &tsFil
         else if (options & AbsoluteLocations)
             tor.setLocationsType(Translator::AbsoluteLocations);
         if (options & Verbose)
-            printOut(QStringLiteral("Updating '%1'...\n").arg(fn));
+            msgs.out(QStringLiteral("Updating '%1'...\n").arg(fn));
 
         UpdateOptions theseOptions = options;
         if (tor.locationsType() == Translator::NoLocations) // Could be set from file
             theseOptions |= NoLocations;
-        Translator out = merge(tor, fetchedTor, aliens, theseOptions, err);
-
-        if ((options & Verbose) && !err.isEmpty()) {
-            printOut(err);
-            err.clear();
+        Translator out;
+        QString err;
+        {
+            Timings::Phase phase("merging");
+            out = merge(tor, fetchedTor, aliens, theseOptions, err);
         }
+
+        if ((options & Verbose) && !err.isEmpty())
+            msgs.out(err);
         if (options & PluralOnly) {
             if (options & Verbose)
-                printOut(QStringLiteral("Stripping non plural forms in '%1'...\n").arg(fn));
+                msgs.out(QStringLiteral("Stripping non plural forms in '%1'...\n").arg(fn));
             out.stripNonPluralForms();
         }
         if (options & NoObsolete)
@@ -446,13 +526,28 @@ static void updateTsFiles(const Translator &fetchedTor, const QStringList &tsFil
 
         out.normalizeTranslations(cd);
         if (!cd.errors().isEmpty()) {
-            printErr(cd.error());
+            msgs.err(cd.error());
             cd.clearErrors();
         }
+        Timings::Phase phase("writing TS files");
         if (!out.save(fileName, cd, QLatin1String("auto"))) {
-            printErr(cd.error());
-            *fail = true;
+            msgs.err(cd.error());
+            msgs.fail = true;
         }
+    };
+
+    // A TS file that is listed twice is updated twice, the second time from the
+    // result of the first, so such lists are processed in order.
+    QSet<QString> uniqueFileNames;
+    for (const QString &fileName : tsFileNames)
+        uniqueFileNames.insert(QFileInfo(fileName).absoluteFilePath());
+    const int jobs = inProjectTask || uniqueFileNames.size() < count ? 1 : jobCount();
+    forEachConcurrently(count, jobs, updateTsFile);
+
+    for (const TsFileMessages &msgs : messages) {
+        msgs.print();
+        if (msgs.fail)
+            *fail = true;
     }
 }
 
@@ -494,6 +589,15 @@ static QStringList getResources(const QString &resourceFile)
     return rqr.files;
 }
 
+static bool isTranslationFile(const QString &file)
+{
+    for (const Translator::FileFormat &fmt : qAsConst(Translator::registeredFileFormats())) {
+        if (file.endsWith(QLatin1Char('.') + fmt.extension, Qt::CaseInsensitive))
+            return true;
+    }
+    return false;
+}
+
 static bool processTs(Translator &fetchedTor, const QString &file, ConversionData &cd)
 {
     for (const Translator::FileFormat &fmt : qAsConst(Translator::registeredFileFormats())) {
@@ -513,33 +617,114 @@ static bool processTs(Translator &fetchedTor, const QString &file, ConversionDat
     return false;
 }
 
+typedef bool (*SourceLoader)(Translator &translator, const QString &fileName,
+                             ConversionData &cd);
+
+// The loader for a file whose parser keeps its state to itself, or nullptr
+static SourceLoader reentrantLoader(const QString &sourceFile)
+{
+    if (sourceFile.endsWith(QLatin1String(".java"), Qt::CaseInsensitive))
+        return loadJava;
+    if (sourceFile.endsWith(QLatin1String(".ui"), Qt::CaseInsensitive)
+        || sourceFile.endsWith(QLatin1String(".jui"), Qt::CaseInsensitive))
+        return loadUI;
+#ifndef QT_NO_QML
+    if (sourceFile.endsWith(QLatin1String(".js"), Qt::CaseInsensitive)
+        || sourceFile.endsWith(QLatin1String(".qs"), Qt::CaseInsensitive))
+        return loadQScript;
+    if (sourceFile.endsWith(QLatin1String(".qml"), Qt::CaseInsensitive))
+        return loadQml;
+#endif
+    if (sourceFile.endsWith(u".py", Qt::CaseInsensitive))
+        return loadPython;
+    return nullptr;
+}
+
+// What loadConcurrently() loaded in -watch mode, so that later runs only load the
+// files that changed. Files that had errors are loaded again.
+static QMutex loadedSourcesMutex;
+static QHash<QString, Translator> loadedSources;
+
+static void forgetLoadedSources(const QSet<QString> &fileNames)
+{
+    QMutexLocker lock(&loadedSourcesMutex);
+    for (const QString &fileName : fileNames)
+        loadedSources.remove(fileName);
+}
+
+// Loads the files on several threads, each into a translator of its own.
+// The errors are reported in file order.
+static QList<Translator> loadConcurrently(const QStringList &fileNames, ConversionData &cd)
+{
+    QList<Translator> translators(fileNames.size());
+    std::vector<QStringList> errors(fileNames.size());
+    trFunctionAliasManager.nameToTrFunctionMap(); // build the lookup hash before it is shared
+    Translator *results = translators.data(); // detached once, for the workers
+    forEachConcurrently(fileNames.size(), jobCount(), [&](qsizetype i) {
+        const QString &fileName = fileNames.at(i);
+        if (cd.m_reuseParsedSources) {
+            QMutexLocker lock(&loadedSourcesMutex);
+            const auto it = loadedSources.constFind(fileName);
+            if (it != loadedSources.constEnd()) {
+                results[i] = *it;
+                return;
+            }
+        }
+        ConversionData fileCd = cd;
+        fileCd.clearErrors();
+        const qint64 start = Timings::now();
+        reentrantLoader(fileName)(results[i], fileName, fileCd);
+        Timings::addFile(fileName, start, Timings::now() - start);
+        errors[i] = fileCd.errors();
+        if (cd.m_reuseParsedSources && errors[i].isEmpty()) {
+            QMutexLocker lock(&loadedSourcesMutex);
+            loadedSources.insert(fileName, results[i]);
+        }
+    });
+
+    for (const QStringList &fileErrors : errors) {
+        for (const QString &error : fileErrors)
+            cd.appendError(error);
+    }
+    return translators;
+}
+
 static void processSources(Translator &fetchedTor,
                            const QStringList &sourceFiles, ConversionData &cd, bool *fail)
 {
 #ifdef QT_NO_QML
     bool requireQmlSupport = false;
 #endif
+    // The clang parser generates files in the working directory; it must not run
+    // for several projects at once.
+    static QMutex nonReentrantParserMutex;
+
+    // The Java, UI, QML, JavaScript and Python files are parsed concurrently up front;
+    // their messages are added in the order of the source files below.
+    QStringList reentrantFiles;
+    for (const auto &sourceFile : sourceFiles) {
+        if (reentrantLoader(sourceFile))
+            reentrantFiles << sourceFile;
+    }
+    QList<Translator> loadedTors;
+    {
+        Timings::Phase phase("parsing Java, UI, QML, JavaScript and Python files");
+        loadedTors = loadConcurrently(reentrantFiles, cd);
+    }
+    qsizetype nextLoadedTor = 0;
+
     QStringList sourceFilesCpp;
     for (const auto &sourceFile : sourceFiles) {
-        if (sourceFile.endsWith(QLatin1String(".java"), Qt::CaseInsensitive))
-            loadJava(fetchedTor, sourceFile, cd);
-        else if (sourceFile.endsWith(QLatin1String(".ui"), Qt::CaseInsensitive)
-                 || sourceFile.endsWith(QLatin1String(".jui"), Qt::CaseInsensitive))
-            loadUI(fetchedTor, sourceFile, cd);
-#ifndef QT_NO_QML
-        else if (sourceFile.endsWith(QLatin1String(".js"), Qt::CaseInsensitive)
-                 || sourceFile.endsWith(QLatin1String(".qs"), Qt::CaseInsensitive))
-            loadQScript(fetchedTor, sourceFile, cd);
-        else if (sourceFile.endsWith(QLatin1String(".qml"), Qt::CaseInsensitive))
-            loadQml(fetchedTor, sourceFile, cd);
-#else
+        if (reentrantLoader(sourceFile)) {
+            for (const TranslatorMessage &msg : loadedTors.at(nextLoadedTor++).messages())
+                fetchedTor.extend(msg, cd);
+        }
+#ifdef QT_NO_QML
         else if (sourceFile.endsWith(QLatin1String(".qml"), Qt::CaseInsensitive)
                  || sourceFile.endsWith(QLatin1String(".js"), Qt::CaseInsensitive)
                  || sourceFile.endsWith(QLatin1String(".qs"), Qt::CaseInsensitive))
             requireQmlSupport = true;
 #endif // QT_NO_QML
-        else if (sourceFile.endsWith(u".py", Qt::CaseInsensitive))
-            loadPython(fetchedTor, sourceFile, cd);
         else if (!processTs(fetchedTor, sourceFile, cd))
             sourceFilesCpp << sourceFile;
     }
@@ -551,14 +736,17 @@ static void processSources(Translator &fetchedTor,
 
     if (useClangToParseCpp) {
 #if QT_CONFIG(clangcpp)
+        QMutexLocker lock(&nonReentrantParserMutex);
         ClangCppParser::loadCPP(fetchedTor, sourceFilesCpp, cd, fail);
 #else
         *fail = true;
         printErr(QStringLiteral("lupdate error: lupdate was built without clang support."));
 #endif
     }
-    else
+    else {
+        Timings::Phase phase("parsing C++ files");
         loadCPP(fetchedTor, sourceFilesCpp, cd);
+    }
 
     if (!cd.error().isEmpty())
         printErr(cd.error());
@@ -591,14 +779,127 @@ public:
     {
     }
 
+    // In -watch mode, projects with TS files of their own are skipped unless
+    // one of their files is in changedFiles. nullptr processes all projects.
+    void setChangedFiles(const QSet<QString> *changedFiles) { m_changedFiles = changedFiles; }
+
     void processProjects(bool topLevel, UpdateOptions options, const Projects &projects,
                          bool nestComplain, Translator *parentTor, bool *fail) const
     {
-        for (const Project &prj : projects)
-            processProject(options, prj, topLevel, nestComplain, parentTor, fail);
+        // Projects nested in a project that is processed concurrently are processed in order.
+        if (inProjectTask || projects.size() < 2 || jobCount() < 2) {
+            for (const Project &prj : projects)
+                processProject(options, prj, topLevel, nestComplain, parentTor, fail);
+            return;
+        }
+
+        // A project depends on an earlier one if both add their messages to the parent
+        // translator, or if one of them writes a TS file that the other writes or reads.
+        const size_t count = projects.size();
+        std::vector<TranslationFiles> files(count);
+        std::vector<bool> usesParent(count);
+        for (size_t i = 0; i < count; ++i) {
+            collectTranslationFiles(projects[i], &files[i]);
+            usesParent[i] = usesParentTranslator(projects[i], topLevel, parentTor);
+        }
+        std::vector<std::vector<size_t>> dependents(count);
+        std::vector<size_t> pendingCount(count, 0);
+        for (size_t j = 1; j < count; ++j) {
+            for (size_t i = 0; i < j; ++i) {
+                if ((usesParent[i] && usesParent[j]) || files[i].conflictsWith(files[j])) {
+                    dependents[i].push_back(j);
+                    ++pendingCount[j];
+                }
+            }
+        }
+
+        std::vector<char> failed(count, false);
+        trFunctionAliasManager.nameToTrFunctionMap(); // build the lookup hash before it is shared
+        QMutex mutex;
+        QWaitCondition taskFinished;
+        std::deque<size_t> ready;
+        for (size_t i = 0; i < count; ++i) {
+            if (!pendingCount[i])
+                ready.push_back(i);
+        }
+        // Each call processes one project, the next one that is ready. One that is
+        // not ready yet depends on a project that another call is processing.
+        forEachConcurrently(count, jobCount(), [&](qsizetype) {
+            QMutexLocker lock(&mutex);
+            while (ready.empty())
+                taskFinished.wait(&mutex);
+            const size_t i = ready.front();
+            ready.pop_front();
+            lock.unlock();
+            inProjectTask = true;
+            bool taskFailed = false;
+            processProject(options, projects[i], topLevel, nestComplain, parentTor,
+                           &taskFailed);
+            inProjectTask = false;
+            lock.relock();
+            failed[i] = taskFailed;
+            for (size_t dependent : dependents[i]) {
+                if (!--pendingCount[dependent])
+                    ready.push_back(dependent);
+            }
+            taskFinished.wakeAll();
+        });
+        if (std::find(failed.cbegin(), failed.cend(), true) != failed.cend())
+            *fail = true;
     }
 
 private:
+    // The TS files a project and its subprojects update, and the ones they read as sources
+    struct TranslationFiles
+    {
+        QSet<QString> written;
+        QSet<QString> read;
+
+        bool conflictsWith(const TranslationFiles &other) const
+        {
+            return written.intersects(other.written) || written.intersects(other.read)
+                || read.intersects(other.written);
+        }
+    };
+
+    static bool containsAny(const Project &prj, const QSet<QString> &fileNames)
+    {
+        for (const QString &source : prj.sources) {
+            if (fileNames.contains(source))
+                return true;
+        }
+        for (const Project &subProject : prj.subProjects) {
+            if (containsAny(subProject, fileNames))
+                return true;
+        }
+        return false;
+    }
+
+    static void collectTranslationFiles(const Project &prj, TranslationFiles *files)
+    {
+        if (prj.translations) {
+            for (const QString &tsFile : *prj.translations)
+                files->written.insert(QFileInfo(tsFile).absoluteFilePath());
+        }
+        for (const QString &source : prj.sources) {
+            if (isTranslationFile(source))
+                files->read.insert(QFileInfo(source).absoluteFilePath());
+        }
+        for (const Project &subProject : prj.subProjects)
+            collectTranslationFiles(subProject, files);
+    }
+
+    // Mirrors the decisions processProject() makes about where the messages go.
+    static bool usesParentTranslator(const Project &prj, bool topLevel,
+                                     const Translator *parentTor)
+    {
+        if (!parentTor)
+            return false;
+        if (prj.translations)
+            return topLevel;
+        return true;
+    }
+
     void processProject(UpdateOptions options, const Project &prj, bool topLevel,
                         bool nestComplain, Translator *parentTor, bool *fail) const
     {
@@ -625,10 +926,12 @@ private:
         cd.m_includePath = prj.includePaths;
         cd.m_excludes = prj.excluded;
         cd.m_sourceIsUtf16 = options & SourceIsUtf16;
+        cd.m_reuseParsedSources = options & Watch;
         if (commandLineCompilationDatabaseDir.isEmpty())
             cd.m_compilationDatabaseDir = prj.compileCommands;
         else
             cd.m_compilationDatabaseDir = commandLineCompilationDatabaseDir;
+        cd.m_clangParserCacheDir = clangParserCacheDir;
 
         QStringList tsFiles;
         if (prj.translations) {
@@ -650,6 +953,8 @@ private:
                 // Just assume correctness and be silent.
                 return;
             }
+            if (m_changedFiles && !containsAny(prj, *m_changedFiles))
+                return;
             Translator tor;
             processProjects(false, options, prj.subProjects, false, &tor, fail);
             processSources(tor, sources, cd, fail);
@@ -675,7 +980,81 @@ private:
 
     QString m_sourceLanguage;
     QString m_targetLanguage;
+    const QSet<QString> *m_changedFiles = nullptr;
+};
+
+static void collectSources(const Projects &projects, QStringList *sources)
+{
+    for (const Project &prj : projects) {
+        *sources << prj.sources;
+        collectSources(prj.subProjects, sources);
+    }
+}
+
+#if QT_CONFIG(filesystemwatcher)
+// Calls update for the -watch mode when files lupdate read have changed. The
+// directories of the files are watched as well, as editors often save a file by
+// replacing it. Changes are collected for a moment, as a save may touch a file
+// several times.
+class SourceWatcher
+{
+public:
+    explicit SourceWatcher(const std::function<void(const QSet<QString> &)> &update)
+        : m_update(update)
+    {
+        m_settleTimer.setSingleShot(true);
+        m_settleTimer.setInterval(200);
+        auto settle = [this]() { m_settleTimer.start(); };
+        QObject::connect(&m_watcher, &QFileSystemWatcher::fileChanged, settle);
+        QObject::connect(&m_watcher, &QFileSystemWatcher::directoryChanged, settle);
+        QObject::connect(&m_settleTimer, &QTimer::timeout, [this]() { checkFiles(); });
+    }
+
+    // TS files are not watched; lupdate writes them itself.
+    void watch(const QStringList &fileNames)
+    {
+        m_lastModified.clear();
+        QSet<QString> dirs;
+        for (const QString &fileName : fileNames) {
+            if (isTranslationFile(fileName) || m_lastModified.contains(fileName))
+                continue;
+            const QFileInfo fi(fileName);
+            m_lastModified.insert(fileName, fi.lastModified());
+            dirs.insert(fi.absolutePath());
+        }
+
+        if (!m_watcher.files().isEmpty())
+            m_watcher.removePaths(m_watcher.files());
+        if (!m_watcher.directories().isEmpty())
+            m_watcher.removePaths(m_watcher.directories());
+        QStringList paths = m_lastModified.keys();
+        paths << QStringList(dirs.cbegin(), dirs.cend());
+        const QStringList failed = m_watcher.addPaths(paths);
+        if (!failed.isEmpty()) {
+            printErr(QStringLiteral("lupdate warning: Cannot watch %1 of %2 files and"
+                                    " directories for changes.\n")
+                     .arg(failed.size()).arg(paths.size()));
+        }
+    }
+
+private:
+    void checkFiles()
+    {
+        QSet<QString> changed;
+        for (auto it = m_lastModified.cbegin(), end = m_lastModified.cend(); it != end; ++it) {
+            if (QFileInfo(it.key()).lastModified() != it.value())
+                changed.insert(it.key());
+        }
+        if (!changed.isEmpty())
+            m_update(changed);
+    }
+
+    std::function<void(const QSet<QString> &)> m_update;
+    QFileSystemWatcher m_watcher;
+    QTimer m_settleTimer;
+    QHash<QString, QDateTime> m_lastModified;
 };
+#endif // QT_CONFIG(filesystemwatcher)
 
 int main(int argc, char **argv)
 {
@@ -701,6 +1080,9 @@ int main(int argc, char **argv)
     QStringList proFiles;
     QString projectDescriptionFile;
     QString outDir = QDir::currentPath();
+    QHash<QString, QString> outDirMap;
+    QString proCacheDir;
+    int proJobCount = 1;
     QMultiHash<QString, QString> allCSources;
     QSet<QString> projectRoots;
     QStringList sourceFiles;
@@ -742,6 +1124,16 @@ int main(int argc, char **argv)
         } else if (arg == QLatin1String("-silent")) {
             options &= ~Verbose;
             continue;
+        } else if (arg == QLatin1String("-jobs")) {
+            ++i;
+            bool ok = false;
+            if (i < argc)
+                m_jobCount = args[i].toInt(&ok);
+            if (!ok || m_jobCount < 1) {
+                printErr(u"The -jobs option should be followed by a positive number.\n"_qs);
+                return 1;
+            }
+            continue;
         } else if (arg == QLatin1String("-pro-debug")) {
             proDebug++;
             continue;
@@ -815,6 +1207,26 @@ int main(int argc, char **argv)
         } else if (arg == QLatin1String("-verbose")) {
             options |= Verbose;
             continue;
+        } else if (arg == QLatin1String("-watch")) {
+#if QT_CONFIG(filesystemwatcher)
+            options |= Watch;
+            continue;
+#else
+            printErr(u"lupdate error: This lupdate was built without support for -watch.\n"_qs);
+            return 1;
+#endif
+        } else if (arg == QLatin1String("-timings")) {
+            Timings::setEnabled(true);
+            continue;
+        } else if (arg == QLatin1String("-timings-trace")) {
+            ++i;
+            if (i == argc) {
+                printErr(u"The -timings-trace option should be followed by a file name.\n"_qs);
+                return 1;
+            }
+            Timings::setEnabled(true);
+            Timings::setTraceFile(args[i]);
+            continue;
         } else if (arg == QLatin1String("-no-recursive")) {
             recursiveScan = false;
             continue;
@@ -861,6 +1273,7 @@ int main(int argc, char **argv)
             }
             QString file = QDir::cleanPath(QFileInfo(args[i]).absoluteFilePath());
             proFiles += file;
+            outDirMap[file] = outDir;
             numFiles++;
             continue;
         } else if (arg == QLatin1String("-pro-out")) {
@@ -871,6 +1284,24 @@ int main(int argc, char **argv)
             }
             outDir = QDir::cleanPath(QFileInfo(args[i]).absoluteFilePath());
             continue;
+        } else if (arg == QLatin1String("-pro-cache")) {
+            ++i;
+            if (i == argc) {
+                printErr(u"The -pro-cache option should be followed by a directory name.\n"_qs);
+                return 1;
+            }
+            proCacheDir = QDir::cleanPath(QFileInfo(args[i]).absoluteFilePath());
+            continue;
+        } else if (arg == QLatin1String("-pro-jobs")) {
+            ++i;
+            bool ok = false;
+            if (i < argc)
+                proJobCount = args[i].toInt(&ok);
+            if (!ok || proJobCount < 1) {
+                printErr(u"The -pro-jobs option should be followed by a positive number.\n"_qs);
+                return 1;
+            }
+            continue;
         } else if (arg.startsWith(QLatin1String("-I"))) {
             if (arg.length() == 2) {
                 ++i;
@@ -893,6 +1324,14 @@ int main(int argc, char **argv)
                  commandLineCompilationDatabaseDir = args[i];
              }
             continue;
+        } else if (arg == QLatin1String("-clang-parser-cache")) {
+            ++i;
+            if (i == argc) {
+                printErr(u"The -clang-parser-cache option should be followed by a directory.\n"_qs);
+                return 1;
+            }
+            clangParserCacheDir = QDir::cleanPath(QFileInfo(args[i]).absoluteFilePath());
+            continue;
         }
 #endif
         else if (arg.startsWith(QLatin1String("-")) && arg != QLatin1String("-")) {
@@ -959,6 +1398,7 @@ int main(int argc, char **argv)
                 if (isProOrPriFile(file)) {
                     QString cleanFile = QDir::cleanPath(fi.absoluteFilePath());
                     proFiles << cleanFile;
+                    outDirMap[cleanFile] = outDir;
                 } else if (fi.isDir()) {
                     if (options & Verbose)
                         printOut(QStringLiteral("Scanning directory '%1'...\n").arg(file));
@@ -1024,13 +1464,30 @@ int main(int argc, char **argv)
                   " makes sense with exactly one TS file.\n"_qs);
 
     QString errorString;
+    Projects projectDescription;
     if (!proFiles.isEmpty()) {
+#ifdef LINGUIST_INPROCESS_PROJECTS
+        if (!projectDescriptionFile.isEmpty()) {
+            printErr(u"lupdate error: The options -project and -pro cannot be combined.\n"_qs);
+            return 1;
+        }
+        ProjectEvaluationOptions evaluationOptions;
+        evaluationOptions.outDirMap = outDirMap;
+        evaluationOptions.cacheDir = proCacheDir;
+        evaluationOptions.debugLevel = proDebug;
+        evaluationOptions.jobCount = proJobCount;
+        evaluationOptions.verbose = options.testFlag(Verbose);
+        if (!evaluateProjects(proFiles, evaluationOptions, &projectDescription))
+            return 1;
+        if (projectDescription.empty()) {
+            printErr(u"lupdate error: Could not find project descriptions.\n"_qs);
+            return 1;
+        }
+#else
         runInternalQtTool(u"lupdate-pro"_qs, app.arguments().mid(1));
         return 0;
-    }
-
-    Projects projectDescription;
-    if (!projectDescriptionFile.isEmpty()) {
+#endif
+    } else if (!projectDescriptionFile.isEmpty()) {
         projectDescription = readProjectDescription(projectDescriptionFile, &errorString);
         if (!errorString.isEmpty()) {
             printErr(QStringLiteral("lupdate error: %1\n").arg(errorString));
@@ -1045,44 +1502,77 @@ int main(int argc, char **argv)
     }
 
     bool fail = false;
+    // Updates the TS files; changedFiles is set for the later runs of the -watch mode
+    std::function<void(const QSet<QString> *changedFiles)> update;
+    QStringList watchedFiles;
     if (projectDescription.empty()) {
         if (tsFileNames.isEmpty())
             printErr(u"lupdate warning:"
                       " no TS files specified. Only diagnostics will be produced.\n"_qs);
 
-        Translator fetchedTor;
         ConversionData cd;
         cd.m_noUiLines = options & NoUiLines;
         cd.m_sourceIsUtf16 = options & SourceIsUtf16;
+        cd.m_reuseParsedSources = options & Watch;
         cd.m_projectRoots = projectRoots;
         cd.m_includePath = includePath;
         cd.m_allCSources = allCSources;
         cd.m_compilationDatabaseDir = commandLineCompilationDatabaseDir;
+        cd.m_clangParserCacheDir = clangParserCacheDir;
         for (const QString &resource : qAsConst(resourceFiles))
             sourceFiles << getResources(resource);
-        processSources(fetchedTor, sourceFiles, cd, &fail);
-        updateTsFiles(fetchedTor, tsFileNames, alienFiles,
-                      sourceLanguage, targetLanguage, options, &fail);
+        watchedFiles = sourceFiles;
+        update = [&, cd](const QSet<QString> *) {
+            Translator fetchedTor;
+            ConversionData runCd = cd;
+            processSources(fetchedTor, sourceFiles, runCd, &fail);
+            updateTsFiles(fetchedTor, tsFileNames, alienFiles,
+                          sourceLanguage, targetLanguage, options, &fail);
+        };
     } else {
         if (!sourceFiles.isEmpty() || !resourceFiles.isEmpty() || !includePath.isEmpty()) {
             printErr(QStringLiteral("lupdate error:"
                             " Both project and source files / include paths specified.\n"));
             return 1;
         }
-        QString errorString;
-        ProjectProcessor projectProcessor(sourceLanguage, targetLanguage);
-        if (!tsFileNames.isEmpty()) {
-            Translator fetchedTor;
-            projectProcessor.processProjects(true, options, projectDescription, true, &fetchedTor,
-                                             &fail);
-            if (!fail) {
-                updateTsFiles(fetchedTor, tsFileNames, alienFiles,
-                              sourceLanguage, targetLanguage, options, &fail);
+        collectSources(projectDescription, &watchedFiles);
+        update = [&](const QSet<QString> *changedFiles) {
+            ProjectProcessor projectProcessor(sourceLanguage, targetLanguage);
+            projectProcessor.setChangedFiles(changedFiles);
+            if (!tsFileNames.isEmpty()) {
+                Translator fetchedTor;
+                projectProcessor.processProjects(true, options, projectDescription, true,
+                                                 &fetchedTor, &fail);
+                if (!fail) {
+                    updateTsFiles(fetchedTor, tsFileNames, alienFiles,
+                                  sourceLanguage, targetLanguage, options, &fail);
+                }
+            } else {
+                projectProcessor.processProjects(true, options, projectDescription, false,
+                                                 nullptr, &fail);
             }
-        } else {
-            projectProcessor.processProjects(true, options, projectDescription, false, nullptr,
-                                             &fail);
-        }
+        };
     }
+    update(nullptr);
+    Timings::report();
+
+#if QT_CONFIG(filesystemwatcher)
+    if (options & Watch) {
+        SourceWatcher watcher([&](const QSet<QString> &changed) {
+            if (options & Verbose)
+                printOut(QStringLiteral("%1 file(s) changed.\n").arg(changed.size()));
+            QSet<QString> changedFiles = changed;
+            changedFiles.unite(forgetCppFiles(changed));
+            forgetLoadedSources(changed);
+            fail = false;
+            update(&changedFiles);
+            watcher.watch(watchedFiles + parsedCppFiles());
+        });
+        watcher.watch(watchedFiles + parsedCppFiles());
+        if (options & Verbose)
+            printOut(u"Watching for changes. Press Ctrl+C to stop.\n"_qs);
+        return app.exec();
+    }
+#endif
     return fail ? 1 : 0;
 }
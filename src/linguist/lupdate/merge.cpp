@@ -33,10 +33,13 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
+#include <QtCore/QHash>
 #include <QtCore/QList>
 #include <QtCore/QMap>
 #include <QtCore/QStringList>
 
+#include <optional>
+
 QT_BEGIN_NAMESPACE
 
 static bool isDigitFriendly(QChar c)
@@ -298,6 +301,64 @@ int applySameTextHeuristic(Translator &tor)
 
 
 
+/*
+  Finds the messages of a translator by context, comment and any of
+  their references, like Translator::find(context, comment, refs), but
+  without scanning all messages for each lookup. The translator must not
+  change while the index is used.
+*/
+class ReferenceIndex
+{
+public:
+    explicit ReferenceIndex(const Translator &tor)
+    {
+        const TranslatorMessage *messages = tor.messages().constData();
+        for (int i = 0, count = tor.messageCount(); i < count; ++i) {
+            const TranslatorMessage &msg = messages[i];
+            for (const auto &ref : msg.allReferences()) {
+                // The first message with a reference wins, as in Translator::find().
+                const Key key{ msg.context(), msg.comment(), ref.fileName(), ref.lineNumber() };
+                if (!m_index.contains(key))
+                    m_index.insert(key, i);
+            }
+        }
+    }
+
+    int find(const QString &context, const QString &comment,
+             const TranslatorMessage::References &refs) const
+    {
+        int result = -1;
+        for (const auto &ref : refs) {
+            const int i = m_index.value(Key{ context, comment, ref.fileName(), ref.lineNumber() },
+                                        -1);
+            if (i >= 0 && (result < 0 || i < result))
+                result = i;
+        }
+        return result;
+    }
+
+private:
+    struct Key
+    {
+        QString context;
+        QString comment;
+        QString fileName;
+        int lineNumber;
+
+        bool operator==(const Key &other) const
+        {
+            return lineNumber == other.lineNumber && fileName == other.fileName
+                && context == other.context && comment == other.comment;
+        }
+        friend size_t qHash(const Key &key, size_t seed = 0)
+        {
+            return qHashMulti(seed, key.context, key.comment, key.fileName, key.lineNumber);
+        }
+    };
+
+    QHash<Key, int> m_index;
+};
+
 /*
   Merges two Translator objects. The first one
   is a set of source texts and translations for a previous version of
@@ -320,6 +381,14 @@ Translator merge(
     outTor.setSourceLanguageCode(tor.sourceLanguageCode());
     outTor.setLocationsType(tor.locationsType());
 
+    // Only the similar text heuristic looks messages up by reference.
+    std::optional<ReferenceIndex> virginRefs;
+    std::optional<ReferenceIndex> torRefs;
+    if (options & HeuristicSimilarText) {
+        virginRefs.emplace(virginTor);
+        torRefs.emplace(tor);
+    }
+
     /*
       The types of all the messages from the vernacular translator
       are updated according to the virgin translator.
@@ -354,7 +423,7 @@ Translator merge(
                     }
                     m.clearReferences();
                 } else {
-                    mvi = virginTor.find(m.context(), m.comment(), m.allReferences());
+                    mvi = virginRefs->find(m.context(), m.comment(), m.allReferences());
                     if (mvi < 0) {
                         // did not find it in the virgin, mark it as obsolete
                         goto makeObsolete;
@@ -453,7 +522,7 @@ Translator merge(
             if (tor.find(mv) >= 0)
                 continue;
             if (options & HeuristicSimilarText) {
-                int mi = tor.find(mv.context(), mv.comment(), mv.allReferences());
+                int mi = torRefs->find(mv.context(), mv.comment(), mv.allReferences());
                 if (mi >= 0) {
                     // The similar message found in tor (ts file) must NOT correspond exactly
                     // to an other message is virginTor
@@ -39,6 +39,7 @@
 #include <cerrno>
 #include <cstdio>
 #include <cstring>
+#include <memory>
 
 QT_BEGIN_NAMESPACE
 
@@ -55,55 +56,108 @@ enum Token { Tok_Eof, Tok_class, Tok_return, Tok_tr,
              Tok_LeftParen, Tok_RightParen,
              Tok_Comma, Tok_None, Tok_Integer};
 
-/*
-  The tokenizer maintains the following global variables. The names
-  should be self-explanatory.
-*/
-static QString yyFileName;
-static int yyCh;
-static QByteArray yyIdent;
-static char yyComment[65536];
-static size_t yyCommentLen;
-static char yyString[65536];
-static size_t yyStringLen;
-static int yyParenDepth;
-static int yyLineNo;
-static int yyCurLineNo;
-
-static QByteArray extraComment;
-static QByteArray id;
-
-QHash<QByteArray, Token> tokens = {
-    {"None", Tok_None},
-    {"class", Tok_class},
-    {"return", Tok_return},
-    {"__tr", Tok_tr}, // Legacy?
-    {"__trUtf8", Tok_trUtf8}
-};
-
-// the file to read from (if reading from a file)
-static FILE *yyInFile;
-
-// the string to read from and current position in the string (otherwise)
-static int yyInPos;
-static int buf;
-
-static int (*getChar)();
-static int (*peekChar)();
-
-static int yyIndentationSize;
-static int yyContinuousSpaceCount;
-static bool yyCountingIndentation;
-
 // (Context, indentation level) pair.
 using ContextPair = QPair<QByteArray, int>;
 // Stack of (Context, indentation level) pairs.
 using ContextStack = QStack<ContextPair>;
-static ContextStack yyContextStack;
 
-static int yyContextPops;
+/*
+  The parser keeps all of its state in the object, so that several files can
+  be parsed at the same time. The names should be self-explanatory.
+*/
+class PythonParser
+{
+public:
+    PythonParser(const QHash<QByteArray, Token> &tokens) : tokens(tokens) {}
+
+    void startTokenizer(const QString &fileName, FILE *inFile);
+    void parse(Translator &tor, ConversionData &cd,
+               const QByteArray &initialContext = {},
+               const QByteArray &defaultContext = {});
+
+private:
+    int getChar();
+    int peekChar();
+    Token parseString();
+    QByteArray readLine();
+    Token getToken();
+
+    bool match(Token t);
+    bool matchString(QByteArray *s);
+    bool matchEncoding(bool *utf8);
+    bool matchStringOrNone(QByteArray *s);
+    bool matchExpression();
+    bool parseTranslate(QByteArray *text, QByteArray *context, QByteArray *comment,
+                        bool *utf8, bool *plural);
+    void setMessageParameters(TranslatorMessage *message);
+
+    const QHash<QByteArray, Token> &tokens;
+
+    QString yyFileName;
+    int yyCh;
+    QByteArray yyIdent;
+    char yyComment[65536];
+    size_t yyCommentLen;
+    char yyString[65536];
+    size_t yyStringLen;
+    int yyParenDepth;
+    int yyLineNo;
+    int yyCurLineNo;
+
+    QByteArray extraComment;
+    QByteArray id;
+
+    // the file to read from
+    FILE *yyInFile;
+    int buf;
+
+    int yyIndentationSize;
+    int yyContinuousSpaceCount;
+    bool yyCountingIndentation;
+
+    ContextStack yyContextStack;
+
+    int yyContextPops;
+
+    Token yyTok;
+};
+
+// The tokens, including the function aliases
+static QHash<QByteArray, Token> createTokens()
+{
+    QHash<QByteArray, Token> tokens = {
+        {"None", Tok_None},
+        {"class", Tok_class},
+        {"return", Tok_return},
+        {"__tr", Tok_tr}, // Legacy?
+        {"__trUtf8", Tok_trUtf8}
+    };
+
+    // Match the function aliases to our tokens
+    const auto &nameMap  = trFunctionAliasManager.nameToTrFunctionMap();
+    for (auto it = nameMap.cbegin(), end = nameMap.cend(); it != end; ++it) {
+        switch (it.value()) {
+        case TrFunctionAliasManager::Function_tr:
+        case TrFunctionAliasManager::Function_QT_TR_NOOP:
+            tokens.insert(it.key().toUtf8(), Tok_tr);
+            break;
+        case TrFunctionAliasManager::Function_trUtf8:
+            tokens.insert(it.key().toUtf8(), Tok_trUtf8);
+            break;
+        case TrFunctionAliasManager::Function_translate:
+        case TrFunctionAliasManager::Function_QT_TRANSLATE_NOOP:
+        // QTranslator::findMessage() has the same parameters as QApplication::translate().
+        case TrFunctionAliasManager::Function_findMessage:
+            tokens.insert(it.key().toUtf8(), Tok_translate);
+            break;
+        default:
+            break;
+        }
+    }
+    return tokens;
+}
 
-static int getCharFromFile()
+int PythonParser::getChar()
 {
     int c;
 
@@ -136,20 +190,17 @@ static int getCharFromFile()
     return c;
 }
 
-static int peekCharFromFile()
+int PythonParser::peekChar()
 {
     int c = getc(yyInFile);
     buf = c;
     return c;
 }
 
-static void startTokenizer(const QString &fileName, int (*getCharFunc)(),
-                           int (*peekCharFunc)())
+void PythonParser::startTokenizer(const QString &fileName, FILE *inFile)
 {
-    yyInPos = 0;
+    yyInFile = inFile;
     buf = -1;
-    getChar = getCharFunc;
-    peekChar = peekCharFunc;
 
     yyFileName = fileName;
     yyCh = getChar();
@@ -163,7 +214,7 @@ static void startTokenizer(const QString &fileName, int (*getCharFunc)(),
     yyContextPops = 0;
 }
 
-static Token parseString()
+Token PythonParser::parseString()
 {
     static const char tab[] = "abfnrtv";
     static const char backTab[] = "\a\b\f\n\r\t\v";
@@ -275,7 +326,7 @@ static Token parseString()
     return Tok_String;
 }
 
-static QByteArray readLine()
+QByteArray PythonParser::readLine()
 {
     QByteArray result;
     while (true) {
@@ -287,7 +338,7 @@ static QByteArray readLine()
     return result;
 }
 
-static Token getToken()
+Token PythonParser::getToken()
 {
     yyIdent.clear();
     yyCommentLen = 0;
@@ -386,9 +437,7 @@ static Token getToken()
   (3) the call appears within a function defined outside the class definition.
 */
 
-static Token yyTok;
-
-static bool match(Token t)
+bool PythonParser::match(Token t)
 {
     const bool matches = (yyTok == t);
     if (matches)
@@ -396,7 +445,7 @@ static bool match(Token t)
     return matches;
 }
 
-static bool matchString(QByteArray *s)
+bool PythonParser::matchString(QByteArray *s)
 {
     const bool matches = (yyTok == Tok_String);
     s->clear();
@@ -407,7 +456,7 @@ static bool matchString(QByteArray *s)
     return matches;
 }
 
-static bool matchEncoding(bool *utf8)
+bool PythonParser::matchEncoding(bool *utf8)
 {
     // Remove any leading module paths.
     if (yyTok == Tok_Ident && std::strcmp(yyIdent, "PySide6") == 0) {
@@ -446,7 +495,7 @@ static bool matchEncoding(bool *utf8)
     return false;
 }
 
-static bool matchStringOrNone(QByteArray *s)
+bool PythonParser::matchStringOrNone(QByteArray *s)
 {
     bool matches = matchString(s);
 
@@ -469,7 +518,7 @@ static bool matchStringOrNone(QByteArray *s)
  * list(a,b).size(2,4)
  * etc...
  */
-static bool matchExpression()
+bool PythonParser::matchExpression()
 {
     if (match(Tok_Integer))
         return true;
@@ -497,8 +546,8 @@ static bool matchExpression()
     return true;
 }
 
-static bool parseTranslate(QByteArray *text, QByteArray *context, QByteArray *comment,
-                           bool *utf8, bool *plural)
+bool PythonParser::parseTranslate(QByteArray *text, QByteArray *context, QByteArray *comment,
+                                  bool *utf8, bool *plural)
 {
     text->clear();
     context->clear();
@@ -544,7 +593,7 @@ static bool parseTranslate(QByteArray *text, QByteArray *context, QByteArray *co
     return true;
 }
 
-static inline void setMessageParameters(TranslatorMessage *message)
+void PythonParser::setMessageParameters(TranslatorMessage *message)
 {
     if (!extraComment.isEmpty()) {
         message->setExtraComment(QString::fromUtf8(extraComment));
@@ -556,9 +605,9 @@ static inline void setMessageParameters(TranslatorMessage *message)
     }
 }
 
-static void parse(Translator &tor, ConversionData &cd,
-                  const QByteArray &initialContext = {},
-                  const QByteArray &defaultContext = {})
+void PythonParser::parse(Translator &tor, ConversionData &cd,
+                         const QByteArray &initialContext,
+                         const QByteArray &defaultContext)
 {
     QByteArray context;
     QByteArray text;
@@ -678,48 +727,27 @@ static void parse(Translator &tor, ConversionData &cd,
 
 bool loadPython(Translator &translator, const QString &fileName, ConversionData &cd)
 {
-    // Match the function aliases to our tokens
-    static bool firstTime = true;
-    if (firstTime) {
-        firstTime = false;
-        const auto &nameMap  = trFunctionAliasManager.nameToTrFunctionMap();
-        for (auto it = nameMap.cbegin(), end = nameMap.cend(); it != end; ++it) {
-            switch (it.value()) {
-            case TrFunctionAliasManager::Function_tr:
-            case TrFunctionAliasManager::Function_QT_TR_NOOP:
-                tokens.insert(it.key().toUtf8(), Tok_tr);
-                break;
-            case TrFunctionAliasManager::Function_trUtf8:
-                tokens.insert(it.key().toUtf8(), Tok_trUtf8);
-                break;
-            case TrFunctionAliasManager::Function_translate:
-            case TrFunctionAliasManager::Function_QT_TRANSLATE_NOOP:
-            // QTranslator::findMessage() has the same parameters as QApplication::translate().
-            case TrFunctionAliasManager::Function_findMessage:
-                tokens.insert(it.key().toUtf8(), Tok_translate);
-                break;
-            default:
-                break;
-            }
-        }
-    }
+    static const QHash<QByteArray, Token> tokens = createTokens();
 
+    FILE *inFile;
 #ifdef Q_CC_MSVC
     const auto *fileNameC = reinterpret_cast<const wchar_t *>(fileName.utf16());
-    const bool ok = _wfopen_s(&yyInFile, fileNameC, L"r") == 0;
+    const bool ok = _wfopen_s(&inFile, fileNameC, L"r") == 0;
 #else
     const QByteArray fileNameC = QFile::encodeName(fileName);
-    yyInFile = std::fopen( fileNameC.constData(), "r");
-    const bool ok = yyInFile != nullptr;
+    inFile = std::fopen( fileNameC.constData(), "r");
+    const bool ok = inFile != nullptr;
 #endif
     if (!ok) {
         cd.appendError(QStringLiteral("Cannot open %1").arg(fileName));
         return false;
     }
 
-    startTokenizer(fileName, getCharFromFile, peekCharFromFile);
-    parse(translator, cd);
-    std::fclose(yyInFile);
+    // The parser's buffers are too large for the stack of a worker thread
+    std::unique_ptr<PythonParser> parser(new PythonParser(tokens));
+    parser->startTokenizer(fileName, inFile);
+    parser->parse(translator, cd);
+    std::fclose(inFile);
     return true;
 }
 
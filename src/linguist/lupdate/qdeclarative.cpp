@@ -43,10 +43,12 @@
 #include <QCoreApplication>
 #include <QFile>
 #include <QFileInfo>
+#include <QMutex>
 #include <QtDebug>
 #include <QStringList>
 
 #include <iostream>
+#include <sstream>
 #include <cstdlib>
 #include <cctype>
 
@@ -56,6 +58,10 @@ using namespace QQmlJS;
 
 static QString MagicComment(QLatin1String("TRANSLATOR"));
 
+// Where the diagnostics of the file being parsed go. They are collected and
+// printed in one piece, as files may be parsed on several threads.
+static thread_local std::ostream *messageStream = nullptr;
+
 class FindTrCalls: protected AST::Visitor
 {
 public:
@@ -222,13 +228,15 @@ protected:
 private:
     std::ostream &yyMsg(int line)
     {
-        return std::cerr << qPrintable(m_fileName) << ':' << line << ": ";
+        std::ostream &out = messageStream ? *messageStream : std::cerr;
+        return out << qPrintable(m_fileName) << ':' << line << ": ";
     }
 
     void throwRecursionDepthError() final
     {
-        std::cerr << qPrintable(m_fileName) << ": "
-                  << "Maximum statement or expression depth exceeded";
+        std::ostream &out = messageStream ? *messageStream : std::cerr;
+        out << qPrintable(m_fileName) << ": "
+            << "Maximum statement or expression depth exceeded";
     }
 
 
@@ -473,10 +481,19 @@ static bool load(Translator &translator, const QString &filename, ConversionData
     driver.setLexer(&lexer);
 
     if (qmlMode ? parser.parse() : parser.parseProgram()) {
+        std::ostringstream messages;
+        messageStream = &messages;
         FindTrCalls trCalls(&driver, cd);
 
         //find all tr calls in the code
         trCalls(&translator, filename, parser.rootNode());
+        messageStream = nullptr;
+
+        if (messages.tellp() > 0) {
+            static QMutex outputMutex;
+            QMutexLocker lock(&outputMutex);
+            std::cerr << messages.str();
+        }
     } else {
         QString error = createErrorString(filename, code, parser);
         cd.appendError(error);
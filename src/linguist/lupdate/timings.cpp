@@ -0,0 +1,227 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Linguist of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "timings.h"
+
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmutex.h>
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+struct TraceEvent
+{
+    QString name;
+    const char *category;
+    qint64 start;
+    qint64 duration;
+    int thread;
+};
+
+struct PhaseTotal
+{
+    qint64 duration = 0;
+    int count = 0;
+};
+
+struct PoolTotal
+{
+    int threadCount = 0;
+    qint64 wall = 0;
+    qint64 busy = 0;
+};
+
+struct TimingData
+{
+    QMutex mutex;
+    QElapsedTimer clock;
+    QString traceFile;
+    QList<const char *> phaseOrder;
+    QHash<QByteArray, PhaseTotal> phases;
+    QList<const char *> poolOrder;
+    QHash<QByteArray, PoolTotal> pools;
+    QList<QPair<qint64, QString>> files;
+    QList<TraceEvent> events;
+};
+
+} // namespace
+
+Q_GLOBAL_STATIC(TimingData, timingData)
+static std::atomic<bool> timingsEnabled = false;
+
+// Small, stable numbers for the threads in the trace
+static int currentThreadIndex()
+{
+    static std::atomic<int> nextIndex = 0;
+    static thread_local int index = nextIndex++;
+    return index;
+}
+
+static QString formatMs(qint64 ns)
+{
+    return QString::number(double(ns) / 1e6, 'f', 1) + QLatin1String(" ms");
+}
+
+void Timings::setEnabled(bool enabled)
+{
+    if (enabled)
+        timingData->clock.start();
+    timingsEnabled = enabled;
+}
+
+bool Timings::isEnabled()
+{
+    return timingsEnabled;
+}
+
+void Timings::setTraceFile(const QString &fileName)
+{
+    timingData->traceFile = fileName;
+}
+
+qint64 Timings::now()
+{
+    return timingsEnabled ? timingData->clock.nsecsElapsed() : 0;
+}
+
+void Timings::addPhase(const char *name, qint64 start, qint64 duration)
+{
+    if (!timingsEnabled)
+        return;
+    TimingData *d = timingData;
+    QMutexLocker lock(&d->mutex);
+    PhaseTotal &total = d->phases[QByteArray(name)];
+    if (!total.count)
+        d->phaseOrder.append(name);
+    total.duration += duration;
+    ++total.count;
+    if (!d->traceFile.isEmpty())
+        d->events.append({ QString::fromLatin1(name), "phase", start, duration, currentThreadIndex() });
+}
+
+void Timings::addFile(const QString &fileName, qint64 start, qint64 duration)
+{
+    if (!timingsEnabled)
+        return;
+    TimingData *d = timingData;
+    QMutexLocker lock(&d->mutex);
+    d->files.append(qMakePair(duration, fileName));
+    if (!d->traceFile.isEmpty())
+        d->events.append({ fileName, "file", start, duration, currentThreadIndex() });
+}
+
+void Timings::addPool(const char *name, int threadCount, qint64 wall, qint64 busy)
+{
+    if (!timingsEnabled)
+        return;
+    TimingData *d = timingData;
+    QMutexLocker lock(&d->mutex);
+    PoolTotal &total = d->pools[QByteArray(name)];
+    if (!total.threadCount)
+        d->poolOrder.append(name);
+    total.threadCount = qMax(total.threadCount, threadCount);
+    total.wall += wall * threadCount;
+    total.busy += busy;
+}
+
+static void writeTrace(const TimingData *d)
+{
+    QJsonArray events;
+    for (const TraceEvent &event : d->events) {
+        events.append(QJsonObject {
+            { QStringLiteral("name"), event.name },
+            { QStringLiteral("cat"), QLatin1String(event.category) },
+            { QStringLiteral("ph"), QStringLiteral("X") },
+            { QStringLiteral("ts"), double(event.start) / 1000 },
+            { QStringLiteral("dur"), double(event.duration) / 1000 },
+            { QStringLiteral("pid"), 1 },
+            { QStringLiteral("tid"), event.thread }
+        });
+    }
+    QFile file(d->traceFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        std::cerr << qPrintable(QStringLiteral("lupdate warning: Cannot write %1: %2\n")
+                                .arg(d->traceFile, file.errorString()));
+        return;
+    }
+    file.write(QJsonDocument(QJsonObject { { QStringLiteral("traceEvents"), events } })
+               .toJson(QJsonDocument::Compact));
+}
+
+void Timings::report()
+{
+    if (!timingsEnabled)
+        return;
+    TimingData *d = timingData;
+    QMutexLocker lock(&d->mutex);
+
+    std::cerr << "lupdate timings:\n";
+    std::cerr << "  total: " << qPrintable(formatMs(d->clock.nsecsElapsed())) << '\n';
+    for (const char *name : qAsConst(d->phaseOrder)) {
+        const PhaseTotal &total = d->phases.value(QByteArray(name));
+        std::cerr << "  " << name << ": " << qPrintable(formatMs(total.duration));
+        if (total.count > 1)
+            std::cerr << " (" << total.count << " runs)";
+        std::cerr << '\n';
+    }
+
+    for (const char *name : qAsConst(d->poolOrder)) {
+        const PoolTotal &total = d->pools.value(QByteArray(name));
+        const int utilization = total.wall ? int(100 * total.busy / total.wall) : 0;
+        std::cerr << "  " << name << ": " << total.threadCount << " threads, "
+                  << utilization << "% busy\n";
+    }
+
+    const int slowestCount = 10;
+    QList<QPair<qint64, QString>> files = d->files;
+    const auto slowestEnd = files.begin() + qMin(files.size(), qsizetype(slowestCount));
+    std::partial_sort(files.begin(), slowestEnd, files.end(),
+                      [](const QPair<qint64, QString> &a, const QPair<qint64, QString> &b) {
+                          return a.first > b.first;
+                      });
+    if (!files.isEmpty())
+        std::cerr << "  slowest files:\n";
+    for (auto it = files.begin(); it != slowestEnd; ++it)
+        std::cerr << "    " << qPrintable(formatMs(it->first)) << "  " << qPrintable(it->second) << '\n';
+
+    if (!d->traceFile.isEmpty())
+        writeTrace(d);
+}
+
+QT_END_NAMESPACE
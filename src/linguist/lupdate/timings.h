@@ -0,0 +1,75 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Linguist of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef TIMINGS_H
+#define TIMINGS_H
+
+#include <QtCore/qglobal.h>
+#include <QtCore/qstring.h>
+
+QT_BEGIN_NAMESPACE
+
+// Collects how long lupdate spends in its phases and on the files it parses,
+// for the -timings option. All functions may be called from any thread; they
+// do nothing unless timings are enabled.
+class Timings
+{
+public:
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+    // Also write the events as a Chrome trace (chrome://tracing) to fileName
+    static void setTraceFile(const QString &fileName);
+
+    // Nanoseconds since the timings were enabled
+    static qint64 now();
+
+    static void addPhase(const char *name, qint64 start, qint64 duration);
+    static void addFile(const QString &fileName, qint64 start, qint64 duration);
+    // busy is the time the threads of the pool spent working, summed over all threads
+    static void addPool(const char *name, int threadCount, qint64 wall, qint64 busy);
+
+    // Prints the summary to stderr and writes the trace file, if any
+    static void report();
+
+    // Records its own lifetime as one run of a phase
+    class Phase
+    {
+    public:
+        explicit Phase(const char *name) : m_name(name), m_start(now()) {}
+        ~Phase() { addPhase(m_name, m_start, now() - m_start); }
+
+    private:
+        Q_DISABLE_COPY(Phase)
+        const char *m_name;
+        qint64 m_start;
+    };
+};
+
+QT_END_NAMESPACE
+
+#endif // TIMINGS_H
@@ -0,0 +1,101 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Linguist of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef CONCURRENCY_H
+#define CONCURRENCY_H
+
+#include <QtCore/qmutex.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qwaitcondition.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+/*
+  Calls \a function with each index from 0 to \a count - 1 on up to \a jobCount
+  threads, and returns when all calls have returned. The calls are shared between
+  the calling thread and tasks of QThreadPool::globalInstance(). As the calling
+  thread takes part, this can be used from a function run by it: tasks that only
+  start once the calling thread has made all calls do nothing.
+
+  With one job, or fewer than two indexes, the calls are made in order on the
+  calling thread.
+*/
+inline void forEachConcurrently(qsizetype count, int jobCount,
+                                const std::function<void(qsizetype)> &function)
+{
+    if (jobCount < 2 || count < 2) {
+        for (qsizetype i = 0; i < count; ++i)
+            function(i);
+        return;
+    }
+
+    struct State
+    {
+        std::atomic<qsizetype> next { 0 };
+        QMutex mutex;
+        QWaitCondition done;
+        int active = 0;
+        bool closed = false;
+    };
+    const auto state = std::make_shared<State>();
+    const auto drain = [state, &function, count]() {
+        for (qsizetype i = state->next++; i < count; i = state->next++)
+            function(i);
+    };
+
+    const qsizetype helpers = std::min<qsizetype>(jobCount, count) - 1;
+    for (qsizetype i = 0; i < helpers; ++i) {
+        QThreadPool::globalInstance()->start([state, drain]() {
+            {
+                QMutexLocker lock(&state->mutex);
+                if (state->closed)
+                    return;
+                ++state->active;
+            }
+            drain();
+            QMutexLocker lock(&state->mutex);
+            if (--state->active == 0)
+                state->done.wakeAll();
+        });
+    }
+    drain();
+
+    QMutexLocker lock(&state->mutex);
+    state->closed = true;
+    while (state->active)
+        state->done.wait(&state->mutex);
+}
+
+QT_END_NAMESPACE
+
+#endif // CONCURRENCY_H
@@ -37,6 +37,7 @@
 #include <QtCore/QTextStream>
 
 #include <ctype.h>
+#include <string.h>
 
 // Uncomment if you wish to hard wrap long lines in .po files. Note that this
 // affects only msg strings, not comments.
@@ -305,7 +306,11 @@ static QByteArray slurpEscapedString(const QList<QByteArray> &lines, int &l,
                     break;
                 }
             } else {
-                msg += c;
+                // The characters up to the next quote or escape are taken at once
+                const char *run = line.constData() + offset - 1;
+                const int runLength = 1 + int(strcspn(run + 1, "\"\\"));
+                msg.append(run, runLength);
+                offset += runLength - 1;
             }
         }
         offset = prefix.size();
@@ -419,9 +424,25 @@ bool loadPO(Translator &translator, QIODevice &dev, ConversionData &cd)
     // ...
 
     // we need line based lookahead below.
+    // The lines are cut out of the whole file and trimmed before they are copied.
     QList<QByteArray> lines;
-    while (!dev.atEnd())
-        lines.append(dev.readLine().trimmed());
+    {
+        const DeviceContent content(dev);
+        const char *pos = reinterpret_cast<const char *>(content.data());
+        const char * const end = pos + content.size();
+        while (pos != end) {
+            const char *eol = static_cast<const char *>(memchr(pos, '\n', end - pos));
+            const char * const next = eol ? eol + 1 : end;
+            if (!eol)
+                eol = end;
+            while (pos != eol && isspace(uchar(*pos)))
+                ++pos;
+            while (eol != pos && isspace(uchar(eol[-1])))
+                --eol;
+            lines.append(QByteArray(pos, eol - pos));
+            pos = next;
+        }
+    }
     lines.append(QByteArray());
 
     int l = 0, lastCmtLine = -1;
@@ -544,9 +565,10 @@ bool loadPO(Translator &translator, QIODevice &dev, ConversionData &cd)
             msg.setContext(toUnicode(item.context));
             if (!item.references.isEmpty()) {
                 QString xrefs;
+                static const QRegularExpression whitespace(QLatin1String("\\s"));
                 for (const QString &ref :
-                         QString(toUnicode(item.references)).split(
-                                 QRegularExpression(QLatin1String("\\s")), Qt::SkipEmptyParts)) {
+                         QString(toUnicode(item.references)).split(whitespace,
+                                                                   Qt::SkipEmptyParts)) {
                     int pos = ref.indexOf(QLatin1Char(':'));
                     int lpos = ref.lastIndexOf(QLatin1Char(':'));
                     if (pos != -1 && pos == lpos) {
@@ -603,9 +625,10 @@ bool loadPO(Translator &translator, QIODevice &dev, ConversionData &cd)
                     item.references += '\n';
                     break;
                 case ',': {
+                    static const QRegularExpression flagSeparators(QLatin1String("[, ]"));
                     QStringList flags =
-                            QString::fromLatin1(line.mid(2)).split(
-                                    QRegularExpression(QLatin1String("[, ]")), Qt::SkipEmptyParts);
+                            QString::fromLatin1(line.mid(2)).split(flagSeparators,
+                                                                   Qt::SkipEmptyParts);
                     if (flags.removeOne(QLatin1String("fuzzy")))
                         item.isFuzzy = true;
                     flags.removeOne(QLatin1String("qt-format"));
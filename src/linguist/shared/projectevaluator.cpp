@@ -0,0 +1,430 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Linguist of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "projectevaluator.h"
+
+#include <profileevaluator.h>
+#include <qmakeparser.h>
+#include <qmakevfs.h>
+#include <qrcreader.h>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QDirIterator>
+#include <QtCore/QFileInfo>
+#include <QtCore/QLibraryInfo>
+#include <QtCore/QMutex>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThreadPool>
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+static void printErr(const QString &out)
+{
+    std::cerr << qPrintable(out);
+}
+
+static QString errorPrefix()
+{
+    return QCoreApplication::applicationName() + QLatin1String(" error: ");
+}
+
+static void print(const QString &fileName, int lineNo, const QString &msg)
+{
+    if (lineNo > 0)
+        printErr(QString::fromLatin1("WARNING: %1:%2: %3\n").arg(fileName, QString::number(lineNo), msg));
+    else if (lineNo)
+        printErr(QString::fromLatin1("WARNING: %1: %2\n").arg(fileName, msg));
+    else
+        printErr(QString::fromLatin1("WARNING: %1\n").arg(msg));
+}
+
+class EvalHandler : public QMakeHandler {
+public:
+    void message(int type, const QString &msg, const QString &fileName, int lineNo) override
+    {
+        if (verbose && !(type & CumulativeEvalMessage) && (type & CategoryMask) == ErrorMessage)
+            print(fileName, lineNo, msg);
+    }
+
+    void fileMessage(int type, const QString &msg) override
+    {
+        if (verbose && !(type & CumulativeEvalMessage) && (type & CategoryMask) == ErrorMessage) {
+            // "Downgrade" errors, as we don't really care for them
+            printErr(QLatin1String("WARNING: ") + msg + QLatin1Char('\n'));
+        }
+    }
+
+    void aboutToEval(ProFile *, ProFile *, EvalFileType) override {}
+    void doneWithEval(ProFile *) override {}
+
+    bool verbose = true;
+};
+
+static EvalHandler evalHandler;
+
+// The state shared by all evaluations of the process. Keeping the cache
+// around lets every project of an invocation reuse the files parsed for
+// the projects before it, e.g. the .prf files of the qmake installation.
+struct EvaluatorState
+{
+    ProFileGlobals option;
+    QMakeVfs vfs;
+    ProFileCache cache;
+    QThreadPool pool;
+    int jobCount = 1;
+};
+
+static EvaluatorState *evaluatorState()
+{
+    static std::unique_ptr<EvaluatorState> state;
+    if (!state) {
+        QMakeParser::initialize();
+        ProFileEvaluator::initialize();
+        state = std::make_unique<EvaluatorState>();
+        ProFileGlobals &option = state->option;
+        option.qmake_abslocation = QString::fromLocal8Bit(qgetenv("QMAKE"));
+        if (option.qmake_abslocation.isEmpty()) {
+            option.qmake_abslocation = QLibraryInfo::path(QLibraryInfo::BinariesPath)
+                + QLatin1String("/qmake");
+        }
+        option.initProperties();
+        option.setCommandLineArguments(QDir::currentPath(),
+                                       QStringList() << QLatin1String("CONFIG+=lupdate_run"));
+    }
+    return state.get();
+}
+
+// QMakeParser keeps the state of the file being parsed, so every thread
+// needs its own. They share the cache, so each file is parsed only once.
+// The parsers are kept alive until exit, as the base environments that
+// the evaluators share keep referring to the parser they were set up with.
+static QMakeParser *threadParser(EvaluatorState *state)
+{
+    static QMutex mutex;
+    static std::vector<std::unique_ptr<QMakeParser>> parsers;
+    static thread_local QMakeParser *parser = nullptr;
+    if (!parser) {
+        QMutexLocker locker(&mutex);
+        parsers.push_back(std::make_unique<QMakeParser>(&state->cache, &state->vfs,
+                                                        &evalHandler));
+        parser = parsers.back().get();
+    }
+    return parser;
+}
+
+static bool isSupportedExtension(const QString &ext)
+{
+    return ext == QLatin1String("qml")
+        || ext == QLatin1String("js") || ext == QLatin1String("qs")
+        || ext == QLatin1String("ui") || ext == QLatin1String("jui");
+}
+
+static QStringList getResources(const QString &resourceFile, QMakeVfs *vfs)
+{
+    Q_ASSERT(vfs);
+    if (!vfs->exists(resourceFile, QMakeVfs::VfsCumulative))
+        return QStringList();
+    QString content;
+    QString errStr;
+    if (vfs->readFile(vfs->idForFileName(resourceFile, QMakeVfs::VfsCumulative),
+                      &content, &errStr) != QMakeVfs::ReadOk) {
+        printErr(errorPrefix() + QStringLiteral("Cannot read %1: %2\n").arg(resourceFile, errStr));
+        return QStringList();
+    }
+    const ReadQrcResult rqr = readQrcFile(resourceFile, content);
+    if (rqr.hasError()) {
+        printErr(errorPrefix() + QStringLiteral("%1:%2: %3\n")
+                 .arg(resourceFile, QString::number(rqr.line), rqr.errorString));
+    }
+    return rqr.files;
+}
+
+static QStringList getSources(const char *var, const char *vvar, const QStringList &baseVPaths,
+                              const QString &projectDir, const ProFileEvaluator &visitor)
+{
+    QStringList vPaths = visitor.absolutePathValues(QLatin1String(vvar), projectDir);
+    vPaths += baseVPaths;
+    vPaths.removeDuplicates();
+    return visitor.absoluteFileValues(QLatin1String(var), projectDir, vPaths, 0);
+}
+
+static QStringList getSources(const ProFileEvaluator &visitor, const QString &projectDir,
+                              const QStringList &excludes, QMakeVfs *vfs)
+{
+    QStringList baseVPaths;
+    baseVPaths += visitor.absolutePathValues(QLatin1String("VPATH"), projectDir);
+    baseVPaths << projectDir; // QMAKE_ABSOLUTE_SOURCE_PATH
+    baseVPaths.removeDuplicates();
+
+    QStringList sourceFiles;
+
+    // app/lib template
+    sourceFiles += getSources("SOURCES", "VPATH_SOURCES", baseVPaths, projectDir, visitor);
+    sourceFiles += getSources("HEADERS", "VPATH_HEADERS", baseVPaths, projectDir, visitor);
+
+    sourceFiles += getSources("FORMS", "VPATH_FORMS", baseVPaths, projectDir, visitor);
+
+    const QStringList resourceFiles = getSources("RESOURCES", "VPATH_RESOURCES", baseVPaths, projectDir, visitor);
+    for (const QString &resource : resourceFiles)
+        sourceFiles += getResources(resource, vfs);
+
+    QStringList installs = visitor.values(QLatin1String("INSTALLS"))
+                         + visitor.values(QLatin1String("DEPLOYMENT"));
+    installs.removeDuplicates();
+    QDir baseDir(projectDir);
+    for (const QString &inst : qAsConst(installs)) {
+        for (const QString &file : visitor.values(inst + QLatin1String(".files"))) {
+            QFileInfo info(file);
+            if (!info.isAbsolute())
+                info.setFile(baseDir.absoluteFilePath(file));
+            QStringList nameFilter;
+            QString searchPath;
+            if (info.isDir()) {
+                nameFilter << QLatin1String("*");
+                searchPath = info.filePath();
+            } else {
+                nameFilter << info.fileName();
+                searchPath = info.path();
+            }
+
+            QDirIterator iterator(searchPath, nameFilter,
+                                  QDir::Files | QDir::NoDotAndDotDot | QDir::NoSymLinks,
+                                  QDirIterator::Subdirectories);
+            while (iterator.hasNext()) {
+                iterator.next();
+                QFileInfo cfi = iterator.fileInfo();
+                if (isSupportedExtension(cfi.suffix()))
+                    sourceFiles << cfi.filePath();
+            }
+        }
+    }
+
+    sourceFiles.removeDuplicates();
+    sourceFiles.sort();
+
+    for (const QString &ex : excludes) {
+        // TODO: take advantage of the file list being sorted
+        QRegularExpression rx(QRegularExpression::wildcardToRegularExpression(ex));
+        for (auto it = sourceFiles.begin(); it != sourceFiles.end(); ) {
+            if (rx.match(*it).hasMatch())
+                it = sourceFiles.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    return sourceFiles;
+}
+
+static QStringList getExcludes(const ProFileEvaluator &visitor, const QString &projectDirPath)
+{
+    const QStringList trExcludes = visitor.values(QLatin1String("TR_EXCLUDE"));
+    QStringList excludes;
+    excludes.reserve(trExcludes.size());
+    const QDir projectDir(projectDirPath);
+    for (const QString &ex : trExcludes)
+        excludes << QDir::cleanPath(projectDir.absoluteFilePath(ex));
+    return excludes;
+}
+
+static void excludeProjects(const ProFileEvaluator &visitor, QStringList *subProjects)
+{
+    for (const QString &ex : visitor.values(QLatin1String("TR_EXCLUDE"))) {
+        QRegularExpression rx(QRegularExpression::wildcardToRegularExpression(ex));
+        for (auto it = subProjects->begin(); it != subProjects->end(); ) {
+            if (rx.match(*it).hasMatch())
+                it = subProjects->erase(it);
+            else
+                ++it;
+        }
+    }
+}
+
+static Projects processProjects(bool topLevel, const QStringList &proFiles,
+        const QHash<QString, QString> &outDirMap, EvaluatorState *state,
+        QMakeParser *parser, bool *fail);
+
+static void processProject(const QString &proFile, EvaluatorState *state, QMakeParser *parser,
+                           ProFileEvaluator &visitor, Project *project)
+{
+    QStringList tmp = visitor.values(QLatin1String("CODECFORSRC"));
+    if (!tmp.isEmpty())
+        project->codec = tmp.last();
+    QString proPath = QFileInfo(proFile).path();
+    if (visitor.templateType() == ProFileEvaluator::TT_Subdirs) {
+        QStringList subProjects = visitor.values(QLatin1String("SUBDIRS"));
+        excludeProjects(visitor, &subProjects);
+        QStringList subProFiles;
+        QDir proDir(proPath);
+        for (const QString &subdir : qAsConst(subProjects)) {
+            QString realdir = visitor.value(subdir + QLatin1String(".subdir"));
+            if (realdir.isEmpty())
+                realdir = visitor.value(subdir + QLatin1String(".file"));
+            if (realdir.isEmpty())
+                realdir = subdir;
+            QString subPro = QDir::cleanPath(proDir.absoluteFilePath(realdir));
+            QFileInfo subInfo(subPro);
+            if (subInfo.isDir()) {
+                subProFiles << (subPro + QLatin1Char('/')
+                                + subInfo.fileName() + QLatin1String(".pro"));
+            } else {
+                subProFiles << subPro;
+            }
+        }
+        project->subProjects = processProjects(false, subProFiles, QHash<QString, QString>(),
+                                               state, parser, nullptr);
+    } else {
+        project->excluded = getExcludes(visitor, proPath);
+        project->sources = getSources(visitor, proPath, project->excluded, &state->vfs);
+        project->includePaths = visitor.absolutePathValues(QLatin1String("INCLUDEPATH"), proPath);
+    }
+}
+
+static bool processProFile(const QString &proFile, QMakeParser::ParseFlags flags,
+                           EvaluatorState *state, QMakeParser *parser, Project *project)
+{
+    ProFile *pro;
+    if (!(pro = parser->parsedProFile(proFile, flags)))
+        return false;
+    ProFileEvaluator visitor(&state->option, parser, &state->vfs, &evalHandler);
+    visitor.setCumulative(true);
+    visitor.setOutputDir(state->option.shadowedPath(pro->directoryName()));
+    if (!visitor.accept(pro)) {
+        pro->deref();
+        return false;
+    }
+
+    processProject(proFile, state, parser, visitor, project);
+    project->filePath = proFile;
+    if (visitor.contains(QLatin1String("TRANSLATIONS"))) {
+        QStringList tsFiles;
+        QDir proDir(QFileInfo(proFile).path());
+        const QStringList translations = visitor.values(QLatin1String("TRANSLATIONS"));
+        for (const QString &tsFile : translations)
+            tsFiles << proDir.filePath(tsFile);
+        project->translations = tsFiles;
+    }
+    if (visitor.contains(QLatin1String("LUPDATE_COMPILE_COMMANDS_PATH"))) {
+        const QStringList thepathjson = visitor.values(
+            QLatin1String("LUPDATE_COMPILE_COMMANDS_PATH"));
+        project->compileCommands = thepathjson.value(0);
+    }
+    pro->deref();
+    return true;
+}
+
+/*
+  Evaluates the subprojects of a SUBDIRS project on the evaluator's thread
+  pool, with the calling thread taking the first one. Threads waiting for
+  their subprojects give their pool slot away, so nested SUBDIRS cannot
+  starve the pool. The results are returned in the order of \a proFiles.
+*/
+static Projects processSubProjects(const QStringList &proFiles, EvaluatorState *state,
+                                   QMakeParser *parser)
+{
+    const int count = proFiles.size();
+    Projects projects(count);
+    std::vector<char> results(count, false);
+    QSemaphore done;
+
+    QThreadPool *pool = &state->pool;
+    for (int i = 1; i < count; ++i) {
+        pool->start([&, i]() {
+            results[i] = processProFile(proFiles.at(i), QMakeParser::ParseDefault,
+                                        state, threadParser(state), &projects[i]);
+            done.release();
+        });
+    }
+    results[0] = processProFile(proFiles.at(0), QMakeParser::ParseDefault,
+                                state, parser, &projects[0]);
+    pool->releaseThread();
+    done.acquire(count - 1);
+    pool->reserveThread();
+
+    Projects result;
+    for (int i = 0; i < count; ++i) {
+        if (results[i])
+            result.push_back(std::move(projects[i]));
+    }
+    return result;
+}
+
+static Projects processProjects(bool topLevel, const QStringList &proFiles,
+        const QHash<QString, QString> &outDirMap, EvaluatorState *state,
+        QMakeParser *parser, bool *fail)
+{
+    // The top-level projects are kept sequential, as they may need
+    // different directories set up in the shared globals.
+    if (!topLevel && state->jobCount > 1 && proFiles.size() > 1)
+        return processSubProjects(proFiles, state, parser);
+
+    Projects result;
+    for (const QString &proFile : proFiles) {
+        if (!outDirMap.isEmpty())
+            state->option.setDirectories(QFileInfo(proFile).path(), outDirMap[proFile]);
+
+        Project prj;
+        if (!processProFile(proFile, topLevel ? QMakeParser::ParseReportMissing
+                                              : QMakeParser::ParseDefault,
+                            state, parser, &prj)) {
+            if (topLevel)
+                *fail = true;
+            continue;
+        }
+        result.push_back(std::move(prj));
+    }
+    return result;
+}
+
+bool evaluateProjects(const QStringList &proFiles, const ProjectEvaluationOptions &options,
+                      Projects *projects)
+{
+    if (!options.cacheDir.isEmpty() && !QDir().mkpath(options.cacheDir)) {
+        printErr(errorPrefix() + QStringLiteral("Cannot create cache directory %1.\n")
+                 .arg(options.cacheDir));
+        return false;
+    }
+
+    EvaluatorState *state = evaluatorState();
+    if (!options.cacheDir.isEmpty())
+        state->cache.setPersistentDirectory(options.cacheDir);
+    state->option.debugLevel = options.debugLevel;
+    state->jobCount = options.jobCount;
+    if (options.jobCount > 1)
+        state->pool.setMaxThreadCount(options.jobCount - 1);
+    evalHandler.verbose = options.verbose;
+
+    bool fail = false;
+    *projects = processProjects(true, proFiles, options.outDirMap, state,
+                                threadParser(state), &fail);
+    return !fail;
+}
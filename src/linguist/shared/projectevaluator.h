@@ -0,0 +1,53 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Linguist of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef PROJECTEVALUATOR_H
+#define PROJECTEVALUATOR_H
+
+#include "projectdescriptionreader.h"
+
+#include <QtCore/qhash.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+
+struct ProjectEvaluationOptions
+{
+    QHash<QString, QString> outDirMap; // .pro file -> virtual output directory
+    QString cacheDir;
+    int debugLevel = 0;
+    int jobCount = 1;
+    bool verbose = true;
+};
+
+// Evaluates the qmake projects in-process. The parsed files are cached for
+// the lifetime of the process, so later calls do not parse them again.
+// Returns false if one of the top-level projects could not be evaluated.
+bool evaluateProjects(const QStringList &proFiles, const ProjectEvaluationOptions &options,
+                      Projects *projects);
+
+#endif // PROJECTEVALUATOR_H
@@ -36,8 +36,13 @@
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
+#include <QtCore/QHash>
 #include <QtCore/QMap>
 #include <QtCore/QString>
+#include <QtCore/QtEndian>
+
+#include <algorithm>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -73,10 +78,11 @@ enum Prefix {
 
 } // namespace anon
 
-static uint elfHash(const QByteArray &ba)
+// Feeds the bytes of \a ba up to the first NUL into the hash \a h.
+// Returns false if a NUL terminated the data.
+static bool elfHashUpdate(uint &h, const QByteArray &ba)
 {
     const uchar *k = (const uchar *)ba.data();
-    uint h = 0;
     uint g;
 
     if (k) {
@@ -86,12 +92,77 @@ static uint elfHash(const QByteArray &ba)
                 h ^= g >> 24;
             h &= ~g;
         }
+        return k == (const uchar *)ba.constData() + ba.size();
     }
+    return true;
+}
+
+static uint elfHash(const QByteArray &ba)
+{
+    uint h = 0;
+    elfHashUpdate(h, ba);
+    if (!h)
+        h = 1;
+    return h;
+}
+
+// Same as elfHash(first + second), without building the concatenation.
+static uint elfHash(const QByteArray &first, const QByteArray &second)
+{
+    uint h = 0;
+    if (elfHashUpdate(h, first))
+        elfHashUpdate(h, second);
     if (!h)
         h = 1;
     return h;
 }
 
+/*
+  Appends data in the big-endian layout QDataStream uses for the QM format,
+  without going through a QIODevice for every field.
+*/
+class QmWriter
+{
+public:
+    explicit QmWriter(QByteArray &data) : m_data(data) {}
+
+    void write8(quint8 value) { m_data.append(char(value)); }
+
+    void write32(quint32 value)
+    {
+        char buf[4];
+        qToBigEndian(value, buf);
+        m_data.append(buf, 4);
+    }
+
+    void writeRaw(const char *data, qsizetype len) { m_data.append(data, len); }
+
+    void write(const QByteArray &ba)
+    {
+        if (ba.isNull()) {
+            write32(0xffffffff);
+            return;
+        }
+        write32(quint32(ba.size()));
+        writeRaw(ba.constData(), ba.size());
+    }
+
+    void write(const QString &str)
+    {
+        if (str.isNull()) {
+            write32(0xffffffff);
+            return;
+        }
+        write32(quint32(str.size() * 2));
+        const qsizetype pos = m_data.size();
+        m_data.resize(pos + str.size() * 2);
+        qToBigEndian<quint16>(str.utf16(), str.size(), m_data.data() + pos);
+    }
+
+private:
+    QByteArray &m_data;
+};
+
 class ByteTranslatorMessage
 {
 public:
@@ -171,11 +242,12 @@ private:
     // on turn should be the same as passed to the actual tr(...) calls
     QByteArray originalBytes(const QString &str) const;
 
-    static Prefix commonPrefix(const ByteTranslatorMessage &m1, const ByteTranslatorMessage &m2);
+    static Prefix commonPrefix(const ByteTranslatorMessage &m1, uint h1,
+                               const ByteTranslatorMessage &m2, uint h2);
 
     static uint msgHash(const ByteTranslatorMessage &msg);
 
-    void writeMessage(const ByteTranslatorMessage & msg, QDataStream & stream,
+    void writeMessage(const ByteTranslatorMessage &msg, QmWriter &writer,
         TranslatorSaveMode strip, Prefix prefix) const;
 
     QString m_language;
@@ -201,12 +273,13 @@ QByteArray Releaser::originalBytes(const QString &str) const
 
 uint Releaser::msgHash(const ByteTranslatorMessage &msg)
 {
-    return elfHash(msg.sourceText() + msg.comment());
+    return elfHash(msg.sourceText(), msg.comment());
 }
 
-Prefix Releaser::commonPrefix(const ByteTranslatorMessage &m1, const ByteTranslatorMessage &m2)
+Prefix Releaser::commonPrefix(const ByteTranslatorMessage &m1, uint h1,
+                              const ByteTranslatorMessage &m2, uint h2)
 {
-    if (msgHash(m1) != msgHash(m2))
+    if (h1 != h2)
         return NoPrefix;
     if (m1.context() != m2.context())
         return Hash;
@@ -217,11 +290,13 @@ Prefix Releaser::commonPrefix(const ByteTranslatorMessage &m1, const ByteTransla
     return HashContextSourceTextComment;
 }
 
-void Releaser::writeMessage(const ByteTranslatorMessage &msg, QDataStream &stream,
+void Releaser::writeMessage(const ByteTranslatorMessage &msg, QmWriter &writer,
     TranslatorSaveMode mode, Prefix prefix) const
 {
-    for (int i = 0; i < msg.translations().count(); ++i)
-        stream << quint8(Tag_Translation) << msg.translations().at(i);
+    for (const QString &translation : msg.translations()) {
+        writer.write8(Tag_Translation);
+        writer.write(translation);
+    }
 
     if (mode == SaveEverything)
         prefix = HashContextSourceTextComment;
@@ -230,17 +305,20 @@ void Releaser::writeMessage(const ByteTranslatorMessage &msg, QDataStream &strea
     switch (prefix) {
     default:
     case HashContextSourceTextComment:
-        stream << quint8(Tag_Comment) << msg.comment();
+        writer.write8(Tag_Comment);
+        writer.write(msg.comment());
         Q_FALLTHROUGH();
     case HashContextSourceText:
-        stream << quint8(Tag_SourceText) << msg.sourceText();
+        writer.write8(Tag_SourceText);
+        writer.write(msg.sourceText());
         Q_FALLTHROUGH();
     case HashContext:
-        stream << quint8(Tag_Context) << msg.context();
+        writer.write8(Tag_Context);
+        writer.write(msg.context());
         break;
     }
 
-    stream << quint8(Tag_End);
+    writer.write8(Tag_End);
 }
 
 
@@ -293,53 +371,79 @@ void Releaser::squeeze(TranslatorSaveMode mode)
     if (m_messages.isEmpty() && mode == SaveEverything)
         return;
 
-    const auto messages = m_messages;
+    const auto messages = std::move(m_messages);
+    m_messages.clear();
 
     // re-build contents
     m_messageArray.clear();
     m_offsetArray.clear();
     m_contextArray.clear();
-    m_messages.clear();
 
-    QMap<Offset, void *> offsets;
+    // The messages are sorted by context, so equal contexts are adjacent and
+    // come in the order of QByteArray::operator<().
+    std::vector<const ByteTranslatorMessage *> msgs;
+    std::vector<uint> hashes;
+    QList<QByteArray> contexts;
+    msgs.reserve(messages.size());
+    hashes.reserve(messages.size());
+    qsizetype messageArraySize = 0;
+    for (auto it = messages.cbegin(), end = messages.cend(); it != end; ++it) {
+        const ByteTranslatorMessage &msg = it.key();
+        msgs.push_back(&msg);
+        hashes.push_back(msgHash(msg));
+        if (contexts.isEmpty() || contexts.constLast() != msg.context())
+            contexts.append(msg.context());
+        for (const QString &translation : msg.translations())
+            messageArraySize += 5 + 2 * translation.size();
+        messageArraySize += 16 + msg.comment().size() + msg.sourceText().size()
+                + msg.context().size();
+    }
 
-    QDataStream ms(&m_messageArray, QIODevice::WriteOnly);
+    const qsizetype count = qsizetype(msgs.size());
+    std::vector<Offset> offsets;
+    offsets.reserve(count);
+    m_messageArray.reserve(messageArraySize);
+    QmWriter ms(m_messageArray);
     int cpPrev = 0, cpNext = 0;
-    for (auto it = messages.cbegin(), end = messages.cend(); it != end; ++it) {
+    for (qsizetype i = 0; i < count; ++i) {
         cpPrev = cpNext;
-        const auto next = std::next(it);
-        if (next == end)
+        if (i + 1 == count)
             cpNext = 0;
         else
-            cpNext = commonPrefix(it.key(), next.key());
-        offsets.insert(Offset(msgHash(it.key()), ms.device()->pos()), (void *)0);
-        writeMessage(it.key(), ms, mode, Prefix(qMax(cpPrev, cpNext + 1)));
+            cpNext = commonPrefix(*msgs[i], hashes[i], *msgs[i + 1], hashes[i + 1]);
+        offsets.push_back(Offset(hashes[i], uint(m_messageArray.size())));
+        writeMessage(*msgs[i], ms, mode, Prefix(qMax(cpPrev, cpNext + 1)));
     }
 
-    auto offset = offsets.cbegin();
-    QDataStream ds(&m_offsetArray, QIODevice::WriteOnly);
-    while (offset != offsets.cend()) {
-        Offset k = offset.key();
-        ++offset;
-        ds << quint32(k.h) << quint32(k.o);
+    std::sort(offsets.begin(), offsets.end());
+    m_offsetArray.resize(count * 8);
+    char *op = m_offsetArray.data();
+    for (const Offset &o : offsets) {
+        qToBigEndian<quint32>(o.h, op);
+        qToBigEndian<quint32>(o.o, op + 4);
+        op += 8;
     }
 
     if (mode == SaveStripped) {
-        QMap<QByteArray, int> contextSet;
-        for (auto it = messages.cbegin(), end = messages.cend(); it != end; ++it)
-            ++contextSet[it.key().context()];
-
+        const qsizetype contextCount = contexts.size();
         quint16 hTableSize;
-        if (contextSet.size() < 200)
-            hTableSize = (contextSet.size() < 60) ? 151 : 503;
-        else if (contextSet.size() < 2500)
-            hTableSize = (contextSet.size() < 750) ? 1511 : 5003;
+        if (contextCount < 200)
+            hTableSize = (contextCount < 60) ? 151 : 503;
+        else if (contextCount < 2500)
+            hTableSize = (contextCount < 750) ? 1511 : 5003;
         else
-            hTableSize = (contextSet.size() < 10000) ? 15013 : 3 * contextSet.size() / 2;
-
-        QMultiMap<int, QByteArray> hashMap;
-        for (auto c = contextSet.cbegin(), end = contextSet.cend(); c != end; ++c)
-            hashMap.insert(elfHash(c.key()) % hTableSize, c.key());
+            hTableSize = (contextCount < 10000) ? 15013 : 3 * contextCount / 2;
+
+        // Contexts that share a bucket are stored in descending order, like
+        // the QMultiMap this used to be built with did.
+        std::vector<std::pair<uint, qsizetype>> buckets;
+        buckets.reserve(contextCount);
+        for (qsizetype i = 0; i < contextCount; ++i)
+            buckets.emplace_back(elfHash(contexts.at(i)) % hTableSize, i);
+        std::sort(buckets.begin(), buckets.end(),
+                  [](const std::pair<uint, qsizetype> &a, const std::pair<uint, qsizetype> &b) {
+                      return a.first != b.first ? a.first < b.first : a.second > b.second;
+                  });
 
         /*
           The contexts found in this translator are stored in a hash
@@ -363,41 +467,36 @@ void Releaser::squeeze(TranslatorSaveMode mode)
           contexts stored there, until we find it or we meet the
           empty string.
         */
-        m_contextArray.resize(2 + (hTableSize << 1));
-        QDataStream t(&m_contextArray, QIODevice::WriteOnly);
-
-        quint16 *hTable = new quint16[hTableSize];
-        memset(hTable, 0, hTableSize * sizeof(quint16));
-
-        t << hTableSize;
-        t.device()->seek(2 + (hTableSize << 1));
-        t << quint16(0); // the entry at offset 0 cannot be used
+        const qsizetype poolStart = 2 + (qsizetype(hTableSize) << 1);
+        m_contextArray.resize(poolStart);
+        memset(m_contextArray.data(), 0, poolStart);
+        qToBigEndian<quint16>(hTableSize, m_contextArray.data());
+
+        QmWriter t(m_contextArray);
+        t.write8(0); // the entry at offset 0 cannot be used
+        t.write8(0);
         uint upto = 2;
 
-        auto entry = hashMap.constBegin();
-        while (entry != hashMap.constEnd()) {
-            int i = entry.key();
-            hTable[i] = quint16(upto >> 1);
+        auto entry = buckets.cbegin();
+        while (entry != buckets.cend()) {
+            const uint i = entry->first;
+            qToBigEndian<quint16>(quint16(upto >> 1), m_contextArray.data() + 2 + 2 * i);
 
             do {
-                const char *con = entry.value().constData();
-                uint len = uint(entry.value().length());
+                const QByteArray &context = contexts.at(entry->second);
+                uint len = uint(context.length());
                 len = qMin(len, 255u);
-                t << quint8(len);
-                t.writeRawData(con, len);
+                t.write8(quint8(len));
+                t.writeRaw(context.constData(), len);
                 upto += 1 + len;
                 ++entry;
-            } while (entry != hashMap.constEnd() && entry.key() == i);
+            } while (entry != buckets.cend() && entry->first == i);
             if (upto & 0x1) {
                 // offsets have to be even
-                t << quint8(0); // empty string
+                t.write8(0); // empty string
                 ++upto;
             }
         }
-        t.device()->seek(2);
-        for (int j = 0; j < hTableSize; j++)
-            t << hTable[j];
-        delete [] hTable;
 
         if (upto > 131072) {
             qWarning("Releaser::squeeze: Too many contexts");
@@ -458,9 +557,9 @@ static void fromBytes(const char *str, int len, QString *out, bool *utf8Fail)
 
 bool loadQM(Translator &translator, QIODevice &dev, ConversionData &cd)
 {
-    QByteArray ba = dev.readAll();
-    const uchar *data = (uchar*)ba.data();
-    int len = ba.size();
+    const DeviceContent content(dev);
+    const uchar *data = content.data();
+    qint64 len = content.size();
     if (len < MagicLength || memcmp(data, magic, MagicLength) != 0) {
         cd.appendError(QLatin1String("QM-Format error: magic marker missing"));
         return false;
@@ -532,6 +631,18 @@ bool loadQM(Translator &translator, QIODevice &dev, ConversionData &cd)
     QString context, sourcetext, comment;
     QStringList translations;
 
+    // Only a few distinct contexts are shared by many messages; decode each
+    // of them once and let the messages share the string data. The keys
+    // point into the file data, which outlives this function's use of them.
+    QHash<QByteArrayView, QString> contexts;
+    QStringDecoder toUnicode(QStringDecoder::Utf8, QStringDecoder::Flag::Stateless);
+    const auto decode = [&](const uchar *str, quint32 len) {
+        QString result = toUnicode(QByteArrayView(str, len));
+        if (toUnicode.hasError())
+            utf8Fail = true;
+        return result;
+    };
+
     for (const uchar *start = offsetArray; start != offsetArray + (numItems << 3); start += 8) {
         //quint32 hash = read32(start);
         quint32 ro = read32(start + 4);
@@ -555,15 +666,12 @@ bool loadQM(Translator &translator, QIODevice &dev, ConversionData &cd)
                     return false;
                 }
                 QString str;
-                if (len != -1)
-                    str = QString((const QChar *)m, len / 2);
-                if (QSysInfo::ByteOrder == QSysInfo::LittleEndian) {
-                    for (int i = 0; i < str.length(); ++i)
-                        str[i] = QChar((str.at(i).unicode() >> 8) +
-                            ((str.at(i).unicode() << 8) & 0xff00));
+                if (len != -1) {
+                    str = QString(len / 2, Qt::Uninitialized);
+                    qFromBigEndian<char16_t>(m, len / 2, str.data());
+                    m += len;
                 }
                 translations << str;
-                m += len;
                 break;
             }
             case Tag_Obsolete1:
@@ -575,7 +683,7 @@ bool loadQM(Translator &translator, QIODevice &dev, ConversionData &cd)
                 m += 4;
                 //qDebug() << "SOURCE LEN: " << len;
                 //qDebug() << "SOURCE: " << QByteArray((const char*)m, len);
-                fromBytes((const char*)m, len, &sourcetext, &utf8Fail);
+                sourcetext = decode(m, len);
                 m += len;
                 break;
             }
@@ -584,7 +692,11 @@ bool loadQM(Translator &translator, QIODevice &dev, ConversionData &cd)
                 m += 4;
                 //qDebug() << "CONTEXT LEN: " << len;
                 //qDebug() << "CONTEXT: " << QByteArray((const char*)m, len);
-                fromBytes((const char*)m, len, &context, &utf8Fail);
+                const QByteArrayView bytes(m, len);
+                auto it = contexts.constFind(bytes);
+                if (it == contexts.constEnd())
+                    it = contexts.insert(bytes, decode(m, len));
+                context = *it;
                 m += len;
                 break;
             }
@@ -593,7 +705,7 @@ bool loadQM(Translator &translator, QIODevice &dev, ConversionData &cd)
                 m += 4;
                 //qDebug() << "COMMENT LEN: " << len;
                 //qDebug() << "COMMENT: " << QByteArray((const char*)m, len);
-                fromBytes((const char*)m, len, &comment, &utf8Fail);
+                comment = decode(m, len);
                 m += len;
                 break;
             }
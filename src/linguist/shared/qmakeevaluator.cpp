@@ -1109,6 +1109,45 @@ void QMakeEvaluator::loadDefaults()
 }
 
 bool QMakeEvaluator::prepareProject(const QString &inDir)
+{
+    // Looking for the files probes every directory up to the root, and
+    // sibling projects of a big tree all end up with the same results.
+    const QPair<QString, QString> key(inDir, m_outputDir);
+    QHash<QPair<QString, QString>, QMakeProjectRoots> &rootsCache =
+            m_option->projectRoots[m_cumulative];
+    {
+#ifdef PROEVALUATOR_THREAD_SAFE
+        QMutexLocker locker(&m_option->mutex);
+#endif
+        const auto it = rootsCache.constFind(key);
+        if (it != rootsCache.constEnd()) {
+            m_superfile = it->superfile;
+            m_conffile = it->conffile;
+            m_cachefile = it->cachefile;
+            m_stashfile = it->stashfile;
+            m_sourceRoot = it->sourceRoot;
+            m_buildRoot = it->buildRoot;
+            return true;
+        }
+    }
+
+    findProjectRoots(inDir);
+
+    QMakeProjectRoots roots;
+    roots.superfile = m_superfile;
+    roots.conffile = m_conffile;
+    roots.cachefile = m_cachefile;
+    roots.stashfile = m_stashfile;
+    roots.sourceRoot = m_sourceRoot;
+    roots.buildRoot = m_buildRoot;
+#ifdef PROEVALUATOR_THREAD_SAFE
+    QMutexLocker locker(&m_option->mutex);
+#endif
+    rootsCache.insert(key, roots);
+    return true;
+}
+
+void QMakeEvaluator::findProjectRoots(const QString &inDir)
 {
     QMakeVfs::VfsFlags flags = (m_cumulative ? QMakeVfs::VfsCumulative : QMakeVfs::VfsExact);
     QString superdir;
@@ -1176,8 +1215,6 @@ bool QMakeEvaluator::prepareProject(const QString &inDir)
             break;
         dir = qdfi.path();
     }
-
-    return true;
 }
 
 bool QMakeEvaluator::loadSpecInternal()
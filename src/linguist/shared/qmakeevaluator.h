@@ -159,6 +159,7 @@ public:
 
     void loadDefaults();
     bool prepareProject(const QString &inDir);
+    void findProjectRoots(const QString &inDir);
     bool loadSpecInternal();
     bool loadSpec();
     void initFrom(const QMakeEvaluator *other);
@@ -82,6 +82,18 @@ public:
     QMakeEvaluator *evaluator;
 };
 
+// The cache, configuration and stash files found for a project directory.
+class QMakeProjectRoots
+{
+public:
+    QString superfile;
+    QString conffile;
+    QString cachefile;
+    QString stashfile;
+    QString sourceRoot;
+    QString buildRoot;
+};
+
 class QMAKE_EXPORT QMakeCmdLineParserState
 {
 public:
@@ -162,6 +174,8 @@ private:
     QMutex mutex;
 #endif
     QHash<QMakeBaseKey, QMakeBaseEnv *> baseEnvs;
+    // Keyed by source and build directory; indexed by cumulative mode.
+    QHash<QPair<QString, QString>, QMakeProjectRoots> projectRoots[2];
 
     friend class QMakeEvaluator;
 };
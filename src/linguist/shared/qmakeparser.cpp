@@ -32,7 +32,9 @@
 #include "ioutils.h"
 using namespace QMakeInternal;
 
+#include <qcryptographichash.h>
 #include <qfile.h>
+#include <qsavefile.h>
 #ifdef PROPARSER_THREAD_SAFE
 # include <qthreadpool.h>
 #endif
@@ -45,6 +47,16 @@ QT_BEGIN_NAMESPACE
 //
 ///////////////////////////////////////////////////////////////////////
 
+// Bump this whenever the token stream format changes.
+// The value also guards against files written with the other byte order.
+static const quint32 persistentFormatVersion = 2;
+static const char persistentMagic[] = { 'Q', 'M', 'P', 'C' };
+
+// The state set on the ProFile while parsing, stored before the items.
+enum PersistentFlag : quint16 {
+    PersistentHostBuild = 1
+};
+
 ProFileCache::ProFileCache()
 {
     QMakeVfs::ref();
@@ -124,6 +136,53 @@ void ProFileCache::discardFiles(const QString &prefix, QMakeVfs *vfs)
     }
 }
 
+QString ProFileCache::persistentFilePath(const QByteArray &key) const
+{
+    return persistent_dir + QLatin1Char('/') + QString::fromLatin1(key) + QLatin1String(".qmc");
+}
+
+bool ProFileCache::loadPersistent(const QByteArray &key, ProFile *pro) const
+{
+    QFile file(persistentFilePath(key));
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    const QByteArray data = file.readAll();
+    const int headerSize = sizeof(persistentMagic) + sizeof(persistentFormatVersion)
+                           + sizeof(quint16);
+    if (data.size() < headerSize || (data.size() - headerSize) % 2
+        || memcmp(data.constData(), persistentMagic, sizeof(persistentMagic))) {
+        return false;
+    }
+    quint32 version;
+    memcpy(&version, data.constData() + sizeof(persistentMagic), sizeof(version));
+    if (version != persistentFormatVersion)
+        return false;
+    quint16 flags;
+    memcpy(&flags, data.constData() + sizeof(persistentMagic) + sizeof(version), sizeof(flags));
+    pro->setHostBuild(flags & PersistentHostBuild);
+    QString *items = pro->itemsRef();
+    items->resize((data.size() - headerSize) / 2);
+    memcpy(items->data(), data.constData() + headerSize, data.size() - headerSize);
+    return true;
+}
+
+void ProFileCache::savePersistent(const QByteArray &key, const ProFile *pro) const
+{
+    // The cache is only an optimization, so failures are silently ignored.
+    // QSaveFile ensures that concurrent processes never see partial files.
+    QSaveFile file(persistentFilePath(key));
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+    file.write(persistentMagic, sizeof(persistentMagic));
+    file.write(reinterpret_cast<const char *>(&persistentFormatVersion),
+               sizeof(persistentFormatVersion));
+    const quint16 flags = pro->isHostBuild() ? PersistentHostBuild : 0;
+    file.write(reinterpret_cast<const char *>(&flags), sizeof(flags));
+    const QString &items = pro->items();
+    file.write(reinterpret_cast<const char *>(items.constData()), items.size() * 2);
+    file.commit();
+}
+
 ////////// Parser ///////////
 
 #define fL1S(s) QString::fromLatin1(s)
@@ -173,7 +232,8 @@ void QMakeParser::initialize()
 }
 
 QMakeParser::QMakeParser(ProFileCache *cache, QMakeVfs *vfs, QMakeParserHandler *handler)
-    : m_cache(cache)
+    : m_reported(false)
+    , m_cache(cache)
     , m_handler(handler)
     , m_vfs(vfs)
 {
@@ -217,7 +277,7 @@ ProFile *QMakeParser::parsedProFile(const QString &fileName, ParseFlags flags)
 #endif
             QString contents;
             if (readFile(id, flags, &contents)) {
-                pro = parsedProBlock(QStringView(contents), id, fileName, 1, FullGrammar);
+                pro = parsedFileContents(QStringView(contents), id, fileName);
                 pro->itemsRef()->squeeze();
                 pro->ref();
             } else {
@@ -238,7 +298,7 @@ ProFile *QMakeParser::parsedProFile(const QString &fileName, ParseFlags flags)
     } else {
         QString contents;
         if (readFile(id, flags, &contents))
-            pro = parsedProBlock(QStringView(contents), id, fileName, 1, FullGrammar);
+            pro = parsedFileContents(QStringView(contents), id, fileName);
         else
             pro = nullptr;
     }
@@ -253,6 +313,31 @@ ProFile *QMakeParser::parsedProBlock(
     return pro;
 }
 
+ProFile *QMakeParser::parsedFileContents(QStringView contents, int id, const QString &fileName)
+{
+    if (!m_cache || m_cache->persistent_dir.isEmpty())
+        return parsedProBlock(contents, id, fileName, 1, FullGrammar);
+
+    // The token stream depends only on the contents, as the file's id is
+    // attached to the strings when they are extracted.
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArrayView(QT_VERSION_STR));
+    hash.addData(QByteArrayView(reinterpret_cast<const char *>(contents.data()),
+                                contents.size() * 2));
+    const QByteArray key = hash.result().toHex();
+
+    ProFile *pro = new ProFile(id, fileName);
+    if (m_cache->loadPersistent(key, pro))
+        return pro;
+    m_reported = false;
+    read(pro, contents, 1, FullGrammar);
+    // Files with diagnostics are not stored, as loading them would
+    // silently drop the messages.
+    if (pro->isOk() && !m_reported)
+        m_cache->savePersistent(key, pro);
+    return pro;
+}
+
 void QMakeParser::discardFileFromCache(int id)
 {
     if (m_cache)
@@ -1310,8 +1395,10 @@ bool QMakeParser::resolveVariable(ushort *xprPtr, int tlen, int needSep, ushort
 
 void QMakeParser::message(int type, const QString &msg) const
 {
-    if (!m_inError && m_handler)
+    if (!m_inError && m_handler) {
+        m_reported = true;
         m_handler->message(type, msg, m_proFile->fileName(), m_lineNo);
+    }
 }
 
 #ifdef PROPARSER_DEBUG
@@ -135,6 +135,7 @@ private:
     };
 
     bool readFile(int id, QMakeParser::ParseFlags flags, QString *contents);
+    ProFile *parsedFileContents(QStringView contents, int id, const QString &fileName);
     void read(ProFile *pro, QStringView content, int line, SubGrammar grammar);
 
     ALWAYS_INLINE void putTok(ushort *&tokPtr, ushort tok);
@@ -179,6 +180,7 @@ private:
     ScopeState m_state;
     int m_markLine; // Put marker for this line
     bool m_inError; // Current line had a parsing error; suppress followup error messages
+    mutable bool m_reported; // A message was emitted while parsing the current file
     bool m_canElse; // Conditionals met on previous line, but no scope was opened
     int m_invert; // Pending conditional is negated
     enum { NoOperator, AndOperator, OrOperator } m_operator; // Pending conditional is ORed/ANDed
@@ -207,7 +209,16 @@ public:
     void discardFile(const QString &fileName, QMakeVfs *vfs);
     void discardFiles(const QString &prefix, QMakeVfs *vfs);
 
+    // Parsed files are also stored in this directory, keyed by a hash of
+    // their contents, so that later processes can skip parsing them.
+    void setPersistentDirectory(const QString &dir) { persistent_dir = dir; }
+    QString persistentDirectory() const { return persistent_dir; }
+
 private:
+    QString persistentFilePath(const QByteArray &key) const;
+    bool loadPersistent(const QByteArray &key, ProFile *pro) const;
+    void savePersistent(const QByteArray &key, const ProFile *pro) const;
+
     struct Entry {
         ProFile *pro;
 #ifdef PROPARSER_THREAD_SAFE
@@ -222,6 +233,7 @@ private:
     };
 
     QHash<int, Entry> parsed_files;
+    QString persistent_dir;
 #ifdef PROPARSER_THREAD_SAFE
     QMutex mutex;
 #endif
@@ -30,6 +30,7 @@
 #include "translator.h"
 
 #include <QtCore/QByteArray>
+#include <QtCore/QtAlgorithms>
 #include <QtCore/QString>
 #include <QtCore/QList>
 
@@ -96,29 +97,6 @@ static const int indexOf[256] = {
     15, 12, 16, 17, 18, 19, 2,  10, 15, 7,  19, 2,  6,  7,  10, 0
 };
 
-/*
-  The entry bitCount[i] (for i between 0 and 255) is the number of bits used to
-  represent i in binary.
-*/
-static const int bitCount[256] = {
-    0,  1,  1,  2,  1,  2,  2,  3,  1,  2,  2,  3,  2,  3,  3,  4,
-    1,  2,  2,  3,  2,  3,  3,  4,  2,  3,  3,  4,  3,  4,  4,  5,
-    1,  2,  2,  3,  2,  3,  3,  4,  2,  3,  3,  4,  3,  4,  4,  5,
-    2,  3,  3,  4,  3,  4,  4,  5,  3,  4,  4,  5,  4,  5,  5,  6,
-    1,  2,  2,  3,  2,  3,  3,  4,  2,  3,  3,  4,  3,  4,  4,  5,
-    2,  3,  3,  4,  3,  4,  4,  5,  3,  4,  4,  5,  4,  5,  5,  6,
-    2,  3,  3,  4,  3,  4,  4,  5,  3,  4,  4,  5,  4,  5,  5,  6,
-    3,  4,  4,  5,  4,  5,  5,  6,  4,  5,  5,  6,  5,  6,  6,  7,
-    1,  2,  2,  3,  2,  3,  3,  4,  2,  3,  3,  4,  3,  4,  4,  5,
-    2,  3,  3,  4,  3,  4,  4,  5,  3,  4,  4,  5,  4,  5,  5,  6,
-    2,  3,  3,  4,  3,  4,  4,  5,  3,  4,  4,  5,  4,  5,  5,  6,
-    3,  4,  4,  5,  4,  5,  5,  6,  4,  5,  5,  6,  5,  6,  6,  7,
-    2,  3,  3,  4,  3,  4,  4,  5,  3,  4,  4,  5,  4,  5,  5,  6,
-    3,  4,  4,  5,  4,  5,  5,  6,  4,  5,  5,  6,  5,  6,  6,  7,
-    3,  4,  4,  5,  4,  5,  5,  6,  4,  5,  5,  6,  5,  6,  6,  7,
-    4,  5,  5,  6,  5,  6,  6,  7,  5,  6,  6,  7,  6,  7,  7,  8
-};
-
 static inline void setCoOccurence(CoMatrix &m, char c, char d)
 {
     int k = indexOf[(uchar) c] + 20 * indexOf[(uchar) d];
@@ -144,43 +122,56 @@ CoMatrix::CoMatrix(const QString &str)
     }
 }
 
-static inline int worth(const CoMatrix &m)
+/*
+  Computes the score of two co-occurrence matrices in a single pass over
+  their words, without materializing their union and intersection. The
+  loop has a fixed trip count and no dependencies between iterations, so
+  compilers unroll and vectorize it, and qPopulationCount() maps to the
+  hardware popcount instruction where there is one.
+*/
+static inline int similarityScore(const CoMatrix &m, const CoMatrix &n, int delta)
 {
-    int w = 0;
-    for (int i = 0; i < 50; i++)
-        w += bitCount[m.b[i]];
-    return w;
+    uint intersectionWorth = 0;
+    uint reunionWorth = 0;
+    for (int i = 0; i < 13; ++i) {
+        intersectionWorth += qPopulationCount(m.w[i] & n.w[i]);
+        reunionWorth += qPopulationCount(m.w[i] | n.w[i]);
+    }
+    return ((int(intersectionWorth) + 1) << 10) / (int(reunionWorth) + (delta << 1) + 1);
 }
 
-static inline CoMatrix reunion(const CoMatrix &m, const CoMatrix &n)
+StringSimilarityMatcher::StringSimilarityMatcher(const QString &stringToMatch)
+    : m_cm(stringToMatch)
 {
-    CoMatrix p;
-    for (int i = 0; i < 13; ++i)
-        p.w[i] = m.w[i] | n.w[i];
-    return p;
+    m_length = stringToMatch.length();
 }
 
-static inline CoMatrix intersection(const CoMatrix &m, const CoMatrix &n)
+int StringSimilarityMatcher::getSimilarityScore(const QString &strCandidate)
 {
-    CoMatrix p;
-    for (int i = 0; i < 13; ++i)
-        p.w[i] = m.w[i] & n.w[i];
-    return p;
+    return getSimilarityScore(CoMatrix(strCandidate), strCandidate.size());
 }
 
-StringSimilarityMatcher::StringSimilarityMatcher(const QString &stringToMatch)
-    : m_cm(stringToMatch)
+/*
+  Scores a candidate whose co-occurrence matrix was computed beforehand,
+  e.g. when the same candidates are matched against many strings.
+*/
+int StringSimilarityMatcher::getSimilarityScore(const CoMatrix &cmCandidate,
+                                                int candidateLength) const
 {
-    m_length = stringToMatch.length();
+    return similarityScore(m_cm, cmCandidate, qAbs(m_length - candidateLength));
 }
 
-int StringSimilarityMatcher::getSimilarityScore(const QString &strCandidate)
+/*
+  Scores \a count candidates stored contiguously in \a cmCandidates, with
+  their string lengths in \a candidateLengths, and writes the results to
+  \a scores.
+*/
+void StringSimilarityMatcher::getSimilarityScores(const CoMatrix *cmCandidates,
+                                                  const int *candidateLengths, int count,
+                                                  int *scores) const
 {
-    CoMatrix cmTarget(strCandidate);
-    int delta = qAbs(m_length - strCandidate.size());
-    int score = ( (worth(intersection(m_cm, cmTarget)) + 1) << 10 ) /
-        ( worth(reunion(m_cm, cmTarget)) + (delta << 1) + 1 );
-    return score;
+    for (int i = 0; i < count; ++i)
+        scores[i] = similarityScore(m_cm, cmCandidates[i], qAbs(m_length - candidateLengths[i]));
 }
 
 CandidateList similarTextHeuristicCandidates(const Translator *tor,
@@ -86,6 +86,9 @@ class StringSimilarityMatcher {
 public:
     StringSimilarityMatcher(const QString &stringToMatch);
     int getSimilarityScore(const QString &strCandidate);
+    int getSimilarityScore(const CoMatrix &cmCandidate, int candidateLength) const;
+    void getSimilarityScores(const CoMatrix *cmCandidates, const int *candidateLengths,
+                             int count, int *scores) const;
 
 private:
     CoMatrix m_cm;
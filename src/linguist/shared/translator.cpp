@@ -31,6 +31,7 @@
 #include "simtexth.h"
 
 #include <iostream>
+#include <numeric>
 
 #include <stdio.h>
 #ifdef Q_OS_WIN
@@ -39,6 +40,7 @@
 #  include <fcntl.h> // for _O_BINARY
 #endif
 
+#include <QtCore/QBuffer>
 #include <QtCore/QDebug>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
@@ -51,9 +53,32 @@
 
 QT_BEGIN_NAMESPACE
 
+DeviceContent::DeviceContent(QIODevice &dev)
+{
+    m_file = qobject_cast<QFile *>(&dev);
+    if (m_file && m_file->pos() == 0 && m_file->size() > 0) {
+        m_data = m_file->map(0, m_file->size());
+        if (m_data) {
+            m_size = m_file->size();
+            return;
+        }
+    }
+    m_file = nullptr;
+    m_buffer = dev.readAll();
+    m_data = reinterpret_cast<uchar *>(m_buffer.data());
+    m_size = m_buffer.size();
+}
+
+DeviceContent::~DeviceContent()
+{
+    if (m_file)
+        m_file->unmap(m_data);
+}
+
 Translator::Translator() :
     m_locationsType(AbsoluteLocations),
-    m_indexOk(true)
+    m_indexOk(true),
+    m_idPositionsOk(true)
 {
 }
 
@@ -77,15 +102,66 @@ QList<Translator::FileFormat> &Translator::registeredFileFormats()
 
 void Translator::addIndex(int idx, const TranslatorMessage &msg) const
 {
+    const int id = m_ids.at(idx);
     if (msg.sourceText().isEmpty() && msg.id().isEmpty()) {
-        m_ctxCmtIdx[msg.context()] = idx;
+        m_ctxCmtIdx[msg.context()] = id;
     } else {
-        m_msgIdx[TMMKey(msg)] = idx;
+        m_msgIdx[TMMKey(msg)] = id;
         if (!msg.id().isEmpty())
-            m_idMsgIdx[msg.id()] = idx;
+            m_idMsgIdx[msg.id()] = id;
     }
 }
 
+void Translator::ensureIdPositions() const
+{
+    if (!m_idPositionsOk) {
+        m_idPositionsOk = true;
+        m_idPositions.resize(m_ids.count());
+        for (int i = 0; i < m_ids.count(); ++i)
+            m_idPositions[m_ids.at(i)] = i;
+    }
+}
+
+int Translator::positionOf(int id) const
+{
+    ensureIdPositions();
+    return m_idPositions.at(id);
+}
+
+// Records \a id for \a key unless a message at or after the insertion point
+// \a idx has the same key; a full rebuild of the index would also let the
+// later one win.
+template <typename Key, typename PositionOf>
+static void insertIndexEntry(QHash<Key, int> &index, const Key &key, int id, int idx,
+                             PositionOf positionOf)
+{
+    auto it = index.find(key);
+    if (it == index.end())
+        index.insert(key, id);
+    else if (positionOf(*it) < idx)
+        *it = id;
+}
+
+void Translator::insertIndex(int idx, const TranslatorMessage &msg) const
+{
+    // The index is dropped whenever messages are removed, so the ids in use
+    // are always 0 to count() - 1 and the next free one is count().
+    const int id = m_ids.count();
+    const auto positionOf = [this](int id) { return this->positionOf(id); };
+    if (msg.sourceText().isEmpty() && msg.id().isEmpty()) {
+        insertIndexEntry(m_ctxCmtIdx, msg.context(), id, idx, positionOf);
+    } else {
+        insertIndexEntry(m_msgIdx, TMMKey(msg), id, idx, positionOf);
+        if (!msg.id().isEmpty())
+            insertIndexEntry(m_idMsgIdx, msg.id(), id, idx, positionOf);
+    }
+    m_ids.insert(idx, id);
+    if (idx == m_messages.count() && m_idPositionsOk)
+        m_idPositions.append(idx);
+    else
+        m_idPositionsOk = false;
+}
+
 void Translator::delIndex(int idx) const
 {
     const TranslatorMessage &msg = m_messages.at(idx);
@@ -105,9 +181,32 @@ void Translator::ensureIndexed() const
         m_ctxCmtIdx.clear();
         m_idMsgIdx.clear();
         m_msgIdx.clear();
+        m_ids.resize(m_messages.count());
+        std::iota(m_ids.begin(), m_ids.end(), 0);
+        m_idPositions = m_ids;
+        m_idPositionsOk = true;
         for (int i = 0; i < m_messages.count(); i++)
             addIndex(i, m_messages.at(i));
     }
+    // Also done here so that lookups on a translator that has been indexed
+    // before being shared between threads do not modify it.
+    ensureIdPositions();
+}
+
+void Translator::internStrings(TranslatorMessage &msg)
+{
+    msg.setContext(m_stringPool.intern(msg.context()));
+    msg.setComment(m_stringPool.intern(msg.comment()));
+    if (msg.fileName().isEmpty())
+        return;
+    if (msg.extraReferences().isEmpty()) {
+        msg.setFileName(m_stringPool.intern(msg.fileName()));
+    } else {
+        TranslatorMessage::References refs = msg.allReferences();
+        for (auto &ref : refs)
+            ref = TranslatorMessage::Reference(m_stringPool.intern(ref.fileName()), ref.lineNumber());
+        msg.setReferences(refs);
+    }
 }
 
 void Translator::replaceSorted(const TranslatorMessage &msg)
@@ -118,6 +217,7 @@ void Translator::replaceSorted(const TranslatorMessage &msg)
     } else {
         delIndex(index);
         m_messages[index] = msg;
+        internStrings(m_messages[index]);
         addIndex(index, msg);
     }
 }
@@ -160,7 +260,7 @@ void Translator::extend(const TranslatorMessage &msg, ConversionData &cd)
                                 : QString::fromLatin1("message '%1'").arg(makeMsgId(msg))));
             return;
         }
-        emsg.addReferenceUniq(msg.fileName(), msg.lineNumber());
+        emsg.addReferenceUniq(m_stringPool.intern(msg.fileName()), msg.lineNumber());
         if (!msg.extraComment().isEmpty()) {
             QString cmt = emsg.extraComment();
             if (!cmt.isEmpty()) {
@@ -179,17 +279,16 @@ void Translator::extend(const TranslatorMessage &msg, ConversionData &cd)
 
 void Translator::insert(int idx, const TranslatorMessage &msg)
 {
-    if (m_indexOk) {
-        if (idx == m_messages.count())
-            addIndex(idx, msg);
-        else
-            m_indexOk = false;
-    }
+    if (m_indexOk)
+        insertIndex(idx, msg);
     m_messages.insert(idx, msg);
+    internStrings(m_messages[idx]);
 }
 
 void Translator::append(const TranslatorMessage &msg)
 {
+    if (m_messageFilter && !m_messageFilter(msg))
+        return;
     insert(m_messages.count(), msg);
 }
 
@@ -312,6 +411,26 @@ bool Translator::load(const QString &filename, ConversionData &cd, const QString
 
 bool Translator::save(const QString &filename, ConversionData &cd, const QString &format) const
 {
+    QString fmt = guessFormat(filename, format);
+    cd.m_targetDir = QFileInfo(filename).absoluteDir();
+
+    SaveFunction saver = nullptr;
+    for (const FileFormat &format : qAsConst(registeredFileFormats())) {
+        if (fmt == format.extension) {
+            if (!format.saver) {
+                cd.appendError(QString(QLatin1String("Cannot save %1 files")).arg(fmt));
+                return false;
+            }
+            saver = format.saver;
+            break;
+        }
+    }
+    if (!saver) {
+        cd.appendError(QString(QLatin1String("Unknown format %1 for file %2"))
+            .arg(format).arg(filename));
+        return false;
+    }
+
     QFile file;
     if (filename.isEmpty() || filename == QLatin1String("-")) {
 #ifdef Q_OS_WIN
@@ -323,30 +442,45 @@ bool Translator::save(const QString &filename, ConversionData &cd, const QString
                 .arg(file.errorString()));
             return false;
         }
-    } else {
-        file.setFileName(filename);
+        return (*saver)(*this, file, cd);
+    }
+
+    file.setFileName(filename);
+    if (!file.exists()) {
         if (!file.open(QIODevice::WriteOnly)) {
             cd.appendError(QString::fromLatin1("Cannot create %1: %2")
                 .arg(filename, file.errorString()));
             return false;
         }
+        return (*saver)(*this, file, cd);
     }
 
-    QString fmt = guessFormat(filename, format);
-    cd.m_targetDir = QFileInfo(filename).absoluteDir();
+    // Generate the file in memory and leave the existing file alone if it
+    // already has that content, so that its timestamp does not trigger
+    // rebuilds of everything generated from it.
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    if (!(*saver)(*this, buffer, cd))
+        return false;
+    const QByteArray &data = buffer.data();
 
-    for (const FileFormat &format : qAsConst(registeredFileFormats())) {
-        if (fmt == format.extension) {
-            if (format.saver)
-                return (*format.saver)(*this, file, cd);
-            cd.appendError(QString(QLatin1String("Cannot save %1 files")).arg(fmt));
-            return false;
-        }
+    if (file.size() == data.size() && file.open(QIODevice::ReadOnly)) {
+        const bool unchanged = file.readAll() == data;
+        file.close();
+        if (unchanged)
+            return true;
     }
-
-    cd.appendError(QString(QLatin1String("Unknown format %1 for file %2"))
-        .arg(format).arg(filename));
-    return false;
+    if (!file.open(QIODevice::WriteOnly)) {
+        cd.appendError(QString::fromLatin1("Cannot create %1: %2")
+            .arg(filename, file.errorString()));
+        return false;
+    }
+    if (file.write(data) != data.size()) {
+        cd.appendError(QString::fromLatin1("Cannot write %1: %2")
+            .arg(filename, file.errorString()));
+        return false;
+    }
+    return true;
 }
 
 QString Translator::makeLanguageCode(QLocale::Language language, QLocale::Country country)
@@ -382,14 +516,19 @@ void Translator::languageAndCountry(QStringView languageCode, QLocale::Language
 int Translator::find(const TranslatorMessage &msg) const
 {
     ensureIndexed();
-    if (msg.id().isEmpty())
-        return m_msgIdx.value(TMMKey(msg), -1);
-    int i = m_idMsgIdx.value(msg.id(), -1);
-    if (i >= 0)
-        return i;
-    i = m_msgIdx.value(TMMKey(msg), -1);
+    if (msg.id().isEmpty()) {
+        const int id = m_msgIdx.value(TMMKey(msg), -1);
+        return id >= 0 ? positionOf(id) : -1;
+    }
+    int id = m_idMsgIdx.value(msg.id(), -1);
+    if (id >= 0)
+        return positionOf(id);
+    id = m_msgIdx.value(TMMKey(msg), -1);
+    if (id < 0)
+        return -1;
     // If both have an id, then find only by id.
-    return i >= 0 && m_messages.at(i).id().isEmpty() ? i : -1;
+    const int i = positionOf(id);
+    return m_messages.at(i).id().isEmpty() ? i : -1;
 }
 
 int Translator::find(const QString &context,
@@ -413,37 +552,36 @@ int Translator::find(const QString &context,
 int Translator::find(const QString &context) const
 {
     ensureIndexed();
-    return m_ctxCmtIdx.value(context, -1);
+    const int id = m_ctxCmtIdx.value(context, -1);
+    return id >= 0 ? positionOf(id) : -1;
 }
 
 void Translator::stripObsoleteMessages()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); )
-        if (it->type() == TranslatorMessage::Obsolete || it->type() == TranslatorMessage::Vanished)
-            it = m_messages.erase(it);
-        else
-            ++it;
-    m_indexOk = false;
+    const auto removed = m_messages.removeIf([](const TranslatorMessage &msg) {
+        return msg.type() == TranslatorMessage::Obsolete
+                || msg.type() == TranslatorMessage::Vanished;
+    });
+    if (removed)
+        m_indexOk = false;
 }
 
 void Translator::stripFinishedMessages()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); )
-        if (it->type() == TranslatorMessage::Finished)
-            it = m_messages.erase(it);
-        else
-            ++it;
-    m_indexOk = false;
+    const auto removed = m_messages.removeIf([](const TranslatorMessage &msg) {
+        return msg.type() == TranslatorMessage::Finished;
+    });
+    if (removed)
+        m_indexOk = false;
 }
 
 void Translator::stripUntranslatedMessages()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); )
-        if (!it->isTranslated())
-            it = m_messages.erase(it);
-        else
-            ++it;
-    m_indexOk = false;
+    const auto removed = m_messages.removeIf([](const TranslatorMessage &msg) {
+        return !msg.isTranslated();
+    });
+    if (removed)
+        m_indexOk = false;
 }
 
 bool Translator::translationsExist() const
@@ -457,34 +595,30 @@ bool Translator::translationsExist() const
 
 void Translator::stripEmptyContexts()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); )
-        if (it->sourceText() == QLatin1String(ContextComment))
-            it = m_messages.erase(it);
-        else
-            ++it;
-    m_indexOk = false;
+    const auto removed = m_messages.removeIf([](const TranslatorMessage &msg) {
+        return msg.sourceText() == QLatin1String(ContextComment);
+    });
+    if (removed)
+        m_indexOk = false;
 }
 
 void Translator::stripNonPluralForms()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); )
-        if (!it->isPlural())
-            it = m_messages.erase(it);
-        else
-            ++it;
-    m_indexOk = false;
+    const auto removed = m_messages.removeIf([](const TranslatorMessage &msg) {
+        return !msg.isPlural();
+    });
+    if (removed)
+        m_indexOk = false;
 }
 
 void Translator::stripIdenticalSourceTranslations()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); ) {
+    const auto removed = m_messages.removeIf([](const TranslatorMessage &msg) {
         // we need to have just one translation, and it be equal to the source
-        if (it->translations().count() == 1 && it->translation() == it->sourceText())
-            it = m_messages.erase(it);
-        else
-            ++it;
-    }
-    m_indexOk = false;
+        return msg.translations().count() == 1 && msg.translation() == msg.sourceText();
+    });
+    if (removed)
+        m_indexOk = false;
 }
 
 void Translator::dropTranslations()
@@ -516,10 +650,13 @@ void Translator::dropUiLines()
     }
 }
 
+// Keys of the hashes used by resolveDuplicates(). They point to the messages
+// and carry the hash of the message, which is computed once per message
+// rather than on every lookup, insertion and rehash.
 struct TranslatorMessageIdPtr {
     explicit TranslatorMessageIdPtr(const TranslatorMessage &tm)
+        : ptr(&tm), hash(qHash(tm.id()))
     {
-        ptr = &tm;
     }
 
     inline const TranslatorMessage *operator->() const
@@ -528,24 +665,29 @@ struct TranslatorMessageIdPtr {
     }
 
     const TranslatorMessage *ptr;
+    size_t hash;
 };
 
-Q_DECLARE_TYPEINFO(TranslatorMessageIdPtr, Q_RELOCATABLE_TYPE);
+Q_DECLARE_TYPEINFO(TranslatorMessageIdPtr, Q_PRIMITIVE_TYPE);
 
 inline size_t qHash(TranslatorMessageIdPtr tmp)
 {
-    return qHash(tmp->id());
+    return tmp.hash;
 }
 
 inline bool operator==(TranslatorMessageIdPtr tmp1, TranslatorMessageIdPtr tmp2)
 {
-    return tmp1->id() == tmp2->id();
+    return tmp1.hash == tmp2.hash && tmp1->id() == tmp2->id();
 }
 
 struct TranslatorMessageContentPtr {
     explicit TranslatorMessageContentPtr(const TranslatorMessage &tm)
+        : ptr(&tm),
+          // Special treatment for context comments (empty source).
+          hash(tm.sourceText().isEmpty() ? qHashMulti(0, tm.context(), tm.sourceText())
+                                         : qHashMulti(0, tm.context(), tm.sourceText(),
+                                                      tm.comment()))
     {
-        ptr = &tm;
     }
 
     inline const TranslatorMessage *operator->() const
@@ -554,21 +696,20 @@ struct TranslatorMessageContentPtr {
     }
 
     const TranslatorMessage *ptr;
+    size_t hash;
 };
 
-Q_DECLARE_TYPEINFO(TranslatorMessageContentPtr, Q_RELOCATABLE_TYPE);
+Q_DECLARE_TYPEINFO(TranslatorMessageContentPtr, Q_PRIMITIVE_TYPE);
 
 inline size_t qHash(TranslatorMessageContentPtr tmp)
 {
-    size_t hash = qHash(tmp->context()) ^ qHash(tmp->sourceText());
-    if (!tmp->sourceText().isEmpty())
-        // Special treatment for context comments (empty source).
-        hash ^= qHash(tmp->comment());
-    return hash;
+    return tmp.hash;
 }
 
 inline bool operator==(TranslatorMessageContentPtr tmp1, TranslatorMessageContentPtr tmp2)
 {
+    if (tmp1.hash != tmp2.hash)
+        return false;
     if (tmp1->context() != tmp2->context() || tmp1->sourceText() != tmp2->sourceText())
         return false;
     // Special treatment for context comments (empty source).
@@ -583,13 +724,19 @@ Translator::Duplicates Translator::resolveDuplicates()
     Duplicates dups;
     QHash<TranslatorMessageIdPtr, int> idRefs;
     QHash<TranslatorMessageContentPtr, int> contentRefs;
+    contentRefs.reserve(m_messages.count());
+    // Detach once up front, the loop keeps pointers into the list
+    m_messages.detach();
     for (int i = 0; i < m_messages.count(); ++i) {
         const TranslatorMessage &msg = m_messages.at(i);
+        const bool hasId = !msg.id().isEmpty();
+        const TranslatorMessageContentPtr contentKey(msg);
         TranslatorMessage *omsg;
         int oi;
         QSet<int> *pDup;
-        if (!msg.id().isEmpty()) {
-            const auto it = idRefs.constFind(TranslatorMessageIdPtr(msg));
+        if (hasId) {
+            const TranslatorMessageIdPtr idKey(msg);
+            const auto it = idRefs.constFind(idKey);
             if (it != idRefs.constEnd()) {
                 oi = *it;
                 omsg = &m_messages[oi];
@@ -598,12 +745,12 @@ Translator::Duplicates Translator::resolveDuplicates()
             }
         }
         {
-            const auto it = contentRefs.constFind(TranslatorMessageContentPtr(msg));
+            const auto it = contentRefs.constFind(contentKey);
             if (it != contentRefs.constEnd()) {
                 oi = *it;
                 omsg = &m_messages[oi];
-                if (msg.id().isEmpty() || omsg->id().isEmpty()) {
-                    if (!msg.id().isEmpty() && omsg->id().isEmpty()) {
+                if (!hasId || omsg->id().isEmpty()) {
+                    if (hasId && omsg->id().isEmpty()) {
                         omsg->setId(msg.id());
                         idRefs[TranslatorMessageIdPtr(*omsg)] = oi;
                     }
@@ -613,9 +760,9 @@ Translator::Duplicates Translator::resolveDuplicates()
                 // This is really a content dupe, but with two distinct IDs.
             }
         }
-        if (!msg.id().isEmpty())
-            idRefs[TranslatorMessageIdPtr(msg)] = i;
-        contentRefs[TranslatorMessageContentPtr(msg)] = i;
+        if (hasId)
+            idRefs.insert(TranslatorMessageIdPtr(msg), i);
+        contentRefs.insert(contentKey, i);
         continue;
       gotDupe:
         pDup->insert(oi);
@@ -626,31 +773,46 @@ Translator::Duplicates Translator::resolveDuplicates()
         // are in the hashes
         duplicateIndices.append(i);
     }
-    // now remove the duplicates from the messages
-    for (int i = duplicateIndices.size() - 1; i >= 0; --i)
-        m_messages.removeAt(duplicateIndices.at(i));
+    // now remove the duplicates from the messages, compacting the list in one pass
+    if (!duplicateIndices.isEmpty()) {
+        int out = duplicateIndices.first();
+        for (int in = out, d = 0; in < m_messages.count(); ++in) {
+            if (d < duplicateIndices.size() && duplicateIndices.at(d) == in) {
+                ++d;
+                continue;
+            }
+            m_messages[out++] = std::move(m_messages[in]);
+        }
+        m_messages.erase(m_messages.begin() + out, m_messages.end());
+    }
     return dups;
 }
 
 void Translator::reportDuplicates(const Duplicates &dupes,
                                   const QString &fileName, bool verbose)
+{
+    reportDuplicates(dupes, fileName, verbose, std::cerr);
+}
+
+void Translator::reportDuplicates(const Duplicates &dupes,
+                                  const QString &fileName, bool verbose, std::ostream &out)
 {
     if (!dupes.byId.isEmpty() || !dupes.byContents.isEmpty()) {
-        std::cerr << "Warning: dropping duplicate messages in '" << qPrintable(fileName);
+        out << "Warning: dropping duplicate messages in '" << qPrintable(fileName);
         if (!verbose) {
-            std::cerr << "'\n(try -verbose for more info).\n";
+            out << "'\n(try -verbose for more info).\n";
         } else {
-            std::cerr << "':\n";
+            out << "':\n";
             for (int i : dupes.byId)
-                std::cerr << "\n* ID: " << qPrintable(message(i).id()) << std::endl;
+                out << "\n* ID: " << qPrintable(message(i).id()) << std::endl;
             for (int j : dupes.byContents) {
                 const TranslatorMessage &msg = message(j);
-                std::cerr << "\n* Context: " << qPrintable(msg.context())
-                          << "\n* Source: " << qPrintable(msg.sourceText()) << std::endl;
+                out << "\n* Context: " << qPrintable(msg.context())
+                    << "\n* Source: " << qPrintable(msg.sourceText()) << std::endl;
                 if (!msg.comment().isEmpty())
-                    std::cerr << "* Comment: " << qPrintable(msg.comment()) << std::endl;
+                    out << "* Comment: " << qPrintable(msg.comment()) << std::endl;
             }
-            std::cerr << std::endl;
+            out << std::endl;
         }
     }
 }
@@ -39,6 +39,8 @@
 #include <QString>
 #include <QSet>
 
+#include <functional>
+#include <iosfwd>
 
 QT_BEGIN_NAMESPACE
 
@@ -46,8 +48,32 @@ class FMT {
     Q_DECLARE_TR_FUNCTIONS(Linguist)
 };
 
+class QFile;
 class QIODevice;
 
+/*
+  Gives access to the bytes of a file being loaded. Files are memory-mapped
+  where possible, so that they are not copied before being decoded; everything
+  else is read into memory.
+*/
+class DeviceContent
+{
+public:
+    explicit DeviceContent(QIODevice &dev);
+    ~DeviceContent();
+
+    const uchar *data() const { return m_data; }
+    qint64 size() const { return m_size; }
+
+private:
+    Q_DISABLE_COPY(DeviceContent)
+
+    QFile *m_file = nullptr;
+    QByteArray m_buffer;
+    uchar *m_data = nullptr;
+    qint64 m_size = 0;
+};
+
 // A struct of "interesting" data passed to and from the load and save routines
 class ConversionData
 {
@@ -58,6 +84,7 @@ public:
         m_sortContexts(false),
         m_noUiLines(false),
         m_idBased(false),
+        m_reuseParsedSources(false),
         m_saveMode(SaveEverything)
     {}
 
@@ -81,6 +108,7 @@ public:
     QString m_sourceFileName;
     QString m_targetFileName;
     QString m_compilationDatabaseDir;
+    QString m_clangParserCacheDir;
     QStringList m_excludes;
     QDir m_sourceDir;
     QDir m_targetDir; // FIXME: TS specific
@@ -94,6 +122,7 @@ public:
     bool m_sortContexts;
     bool m_noUiLines;
     bool m_idBased;
+    bool m_reuseParsedSources; // lupdate -watch: skip sources parsed by an earlier run
     TranslatorSaveMode m_saveMode;
 };
 
@@ -111,6 +140,26 @@ inline size_t qHash(const TMMKey &key)
     return qHash(key.context) ^ qHash(key.source) ^ qHash(key.comment);
 }
 
+// Lets strings that recur across many messages, such as contexts and
+// file names, share their data instead of each message holding a copy.
+class StringPool
+{
+public:
+    QString intern(const QString &str)
+    {
+        if (str.isEmpty())
+            return str;
+        const auto it = m_strings.constFind(str);
+        if (it != m_strings.constEnd())
+            return *it;
+        m_strings.insert(str);
+        return str;
+    }
+
+private:
+    QSet<QString> m_strings;
+};
+
 class Translator
 {
 public:
@@ -130,6 +179,12 @@ public:
     void append(const TranslatorMessage &msg);
     void appendSorted(const TranslatorMessage &msg);
 
+    // Messages rejected by the filter are silently dropped by append(). This
+    // allows discarding messages while a file is loaded instead of storing
+    // them first and stripping them afterwards.
+    typedef std::function<bool(const TranslatorMessage &)> MessageFilter;
+    void setMessageFilter(const MessageFilter &filter) { m_messageFilter = filter; }
+
     void stripObsoleteMessages();
     void stripFinishedMessages();
     void stripUntranslatedMessages();
@@ -140,10 +195,15 @@ public:
     void dropUiLines();
     void makeFileNamesAbsolute(const QDir &originalPath);
     bool translationsExist() const;
+    // Builds the index find() uses, which it otherwise builds on first use.
+    // Call it before sharing a translator between threads.
+    void ensureIndexed() const;
 
     struct Duplicates { QSet<int> byId, byContents; };
     Duplicates resolveDuplicates();
     void reportDuplicates(const Duplicates &dupes, const QString &fileName, bool verbose);
+    void reportDuplicates(const Duplicates &dupes, const QString &fileName, bool verbose,
+                          std::ostream &out);
 
     QString languageCode() const { return m_language; }
     QString sourceLanguageCode() const { return m_sourceLanguage; }
@@ -207,8 +267,11 @@ public:
 private:
     void insert(int idx, const TranslatorMessage &msg);
     void addIndex(int idx, const TranslatorMessage &msg) const;
+    void insertIndex(int idx, const TranslatorMessage &msg) const;
+    void internStrings(TranslatorMessage &msg);
     void delIndex(int idx) const;
-    void ensureIndexed() const;
+    void ensureIdPositions() const;
+    int positionOf(int id) const;
 
     typedef QList<TranslatorMessage> TMM;       // int stores the sequence position.
 
@@ -228,11 +291,20 @@ private:
     QString m_sourceLanguage;
     QStringList m_dependencies;
     ExtraData m_extra;
+    StringPool m_stringPool;
+    MessageFilter m_messageFilter;
 
+    // The hashes map to message ids, which stay the same when messages are
+    // inserted before others. m_ids holds the id of each message. Its inverse,
+    // m_idPositions, is rebuilt in one pass on the first lookup after such an
+    // insert. Removing messages invalidates the whole index.
     mutable bool m_indexOk;
+    mutable bool m_idPositionsOk;
     mutable QHash<QString, int> m_ctxCmtIdx;
     mutable QHash<QString, int> m_idMsgIdx;
     mutable QHash<TMMKey, int> m_msgIdx;
+    mutable QList<int> m_ids;
+    mutable QList<int> m_idPositions;
 };
 
 bool getNumerusInfo(QLocale::Language language, QLocale::Country country,
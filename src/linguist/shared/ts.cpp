@@ -39,7 +39,7 @@
 
 #define STRINGIFY_INTERNAL(x) #x
 #define STRINGIFY(x) STRINGIFY_INTERNAL(x)
-#define STRING(s) static QString str##s(QLatin1String(STRINGIFY(s)))
+#define STRING(s) static const QLatin1String str##s(STRINGIFY(s))
 
 QT_BEGIN_NAMESPACE
 
@@ -60,14 +60,20 @@ public:
     bool read(Translator &translator);
 
 private:
-    bool elementStarts(const QString &str) const
+    bool elementStarts(QLatin1String str) const
     {
         return isStartElement() && name() == str;
     }
 
     bool isWhiteSpace() const
     {
-        return isCharacters() && text().toString().trimmed().isEmpty();
+        if (!isCharacters())
+            return false;
+        if (isWhitespace())
+            return true;
+        const QStringView chars = text();
+        return std::all_of(chars.begin(), chars.end(),
+                           [](QChar c) { return c.isSpace(); });
     }
 
     // needed to expand <byte ... />
@@ -116,12 +122,12 @@ void TSReader::handleError()
     }
 }
 
-static QString byteValue(QString value)
+static QString byteValue(QStringView value)
 {
     int base = 10;
-    if (value.startsWith(QLatin1String("x"))) {
+    if (value.startsWith(QLatin1Char('x'))) {
         base = 16;
-        value.remove(0, 1);
+        value = value.mid(1);
     }
     int n = value.toUInt(0, base);
     return (n != 0) ? QString(QChar(n)) : QString();
@@ -141,7 +147,7 @@ QString TSReader::readContents()
             result += text();
         } else if (elementStarts(strbyte)) {
             // <byte value="...">
-            result += byteValue(attributes().value(strvalue).toString());
+            result += byteValue(attributes().value(strvalue));
             readNext();
             if (!isEndElement()) {
                 handleError();
@@ -217,7 +223,7 @@ bool TSReader::read(Translator &translator)
     //STRING(version);
     STRING(yes);
 
-    static const QString strextrans(QLatin1String("extra-"));
+    static const QLatin1String strextrans("extra-");
 
     while (!atEnd()) {
         readNext();
@@ -248,8 +254,7 @@ bool TSReader::read(Translator &translator)
                     break;
                 } else if (isWhiteSpace()) {
                     // ignore these, just whitespace
-                } else if (isStartElement()
-                        && name().toString().startsWith(strextrans)) {
+                } else if (isStartElement() && name().startsWith(strextrans)) {
                     // <extra-...>
                     QString tag = name().toString();
                     translator.setExtra(tag.mid(6), readContents());
@@ -333,7 +338,11 @@ bool TSReader::read(Translator &translator)
                                     // <location/>
                                     maybeAbsolute = true;
                                     QXmlStreamAttributes atts = attributes();
-                                    QString fileName = atts.value(strfilename).toString();
+                                    // Consecutive locations mostly name the same file;
+                                    // share its string then.
+                                    const QStringView fileNameValue = atts.value(strfilename);
+                                    QString fileName = fileNameValue == currentMsgFile
+                                            ? currentMsgFile : fileNameValue.toString();
                                     if (fileName.isEmpty()) {
                                         fileName = currentMsgFile;
                                         maybeRelative = true;
@@ -342,7 +351,7 @@ bool TSReader::read(Translator &translator)
                                             currentFile = fileName;
                                         currentMsgFile = fileName;
                                     }
-                                    const QString lin = atts.value(strline).toString();
+                                    const QStringView lin = atts.value(strline);
                                     if (lin.isEmpty()) {
                                         refs.append(TranslatorMessage::Reference(fileName, -1));
                                     } else {
@@ -393,8 +402,7 @@ bool TSReader::read(Translator &translator)
                                         msg.setTranslation(readTransContents());
                                     }
                                     // </translation>
-                                } else if (isStartElement()
-                                        && name().toString().startsWith(strextrans)) {
+                                } else if (isStartElement() && name().startsWith(strextrans)) {
                                     // <extra-...>
                                     QString tag = name().toString();
                                     msg.setExtra(tag.mid(6), readContents());
@@ -436,8 +444,26 @@ static QString numericEntity(int ch)
         : QLatin1String("&#x%1;")) .arg(ch, 0, 16);
 }
 
+// Characters below 0x80 that protect() has to replace
+static const bool asciiNeedsProtection[0x80] = {
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 1, 1, 1, 1, 1, // \t and \n are kept
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    0, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, // " & '
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0, // < >
+};
+
+static bool needsProtection(QChar ch)
+{
+    const char16_t c = ch.unicode();
+    return c < 0x80 ? asciiNeedsProtection[c] : ch.isSpace();
+}
+
 static QString protect(const QString &str)
 {
+    // Most strings contain nothing to escape; share them instead of copying.
+    if (std::none_of(str.cbegin(), str.cend(), needsProtection))
+        return str;
+
     QString result;
     result.reserve(str.length() * 12 / 10);
     for (int i = 0; i != str.size(); ++i) {
@@ -482,7 +508,7 @@ static void writeExtras(QTextStream &t, const char *indent,
     }
     outs.sort();
     for (const QString &out : qAsConst(outs))
-        t << indent << out << Qt::endl;
+        t << indent << out << '\n';
 }
 
 static void writeVariants(QTextStream &t, const char *indent, const QString &input)
@@ -538,7 +564,7 @@ bool saveTS(const Translator &translator, QIODevice &dev, ConversionData &cd)
 
     writeExtras(t, "    ", translator.extras(), drops);
 
-    QHash<QString, QList<TranslatorMessage> > messageOrder;
+    QHash<QString, QList<const TranslatorMessage *> > messageOrder;
     QList<QString> contextOrder;
     for (const TranslatorMessage &msg : translator.messages()) {
         // no need for such noise
@@ -547,22 +573,25 @@ bool saveTS(const Translator &translator, QIODevice &dev, ConversionData &cd)
             continue;
         }
 
-        QList<TranslatorMessage> &context = messageOrder[msg.context()];
+        QList<const TranslatorMessage *> &context = messageOrder[msg.context()];
         if (context.isEmpty())
             contextOrder.append(msg.context());
-        context.append(msg);
+        context.append(&msg);
     }
     if (cd.sortContexts())
         std::sort(contextOrder.begin(), contextOrder.end());
 
     QHash<QString, int> currentLine;
     QString currentFile;
+    // Relative paths are expensive to compute and there are few distinct files.
+    QHash<QString, QString> relativeFileNames;
     for (const QString &context : qAsConst(contextOrder)) {
         t << "<context>\n"
              "    <name>"
           << protect(context)
           << "</name>\n";
-        for (const TranslatorMessage &msg : qAsConst(messageOrder[context])) {
+        for (const TranslatorMessage *message : qAsConst(messageOrder[context])) {
+            const TranslatorMessage &msg = *message;
             //msg.dump();
 
                 t << "    <message";
@@ -575,8 +604,13 @@ bool saveTS(const Translator &translator, QIODevice &dev, ConversionData &cd)
                     QString cfile = currentFile;
                     bool first = true;
                     for (const TranslatorMessage::Reference &ref : msg.allReferences()) {
-                        QString fn = cd.m_targetDir.relativeFilePath(ref.fileName())
-                                    .replace(QLatin1Char('\\'),QLatin1Char('/'));
+                        auto relativeFileName = relativeFileNames.find(ref.fileName());
+                        if (relativeFileName == relativeFileNames.end()) {
+                            relativeFileName = relativeFileNames.insert(ref.fileName(),
+                                    cd.m_targetDir.relativeFilePath(ref.fileName())
+                                        .replace(QLatin1Char('\\'), QLatin1Char('/')));
+                        }
+                        QString fn = *relativeFileName;
                         int ln = ref.lineNumber();
                         QString ld;
                         if (translator.locationsType() == Translator::RelativeLocations) {
@@ -505,11 +505,12 @@ bool XLIFFHandler::startElement(QStringView namespaceURI, QStringView localName,
         if (m_sourceLanguage == QLatin1String("en"))
             m_sourceLanguage.clear();
     } else if (localName == QLatin1String("group")) {
-        if (atts.value(QLatin1String("restype")) == QLatin1String(restypeContext)) {
+        const QStringView restype = atts.value(QLatin1String("restype"));
+        if (restype == QLatin1String(restypeContext)) {
             m_context = atts.value(QLatin1String("resname")).toString();
             pushContext(XC_restype_context);
         } else {
-            if (atts.value(QLatin1String("restype")) == QLatin1String(restypePlurals)) {
+            if (restype == QLatin1String(restypePlurals)) {
                 pushContext(XC_restype_plurals);
                 m_id = atts.value(QLatin1String("id")).toString();
                 if (atts.value(QLatin1String("translate")) == QLatin1String("no"))
@@ -675,9 +676,11 @@ bool XLIFFHandler::characters(QStringView ch)
                 accum.append(chr);
         }
     } else {
-        QString t = ch.toString();
-        t.replace(QLatin1String("\r"), QLatin1String(""));
-        accum.append(t);
+        // carriage returns are dropped
+        qsizetype from = 0;
+        for (qsizetype cr; (cr = ch.indexOf(QLatin1Char('\r'), from)) != -1; from = cr + 1)
+            accum.append(ch.sliced(from, cr - from));
+        accum.append(ch.sliced(from));
     }
     return true;
 }
@@ -746,7 +749,10 @@ bool XLIFFHandler::fatalError(qint64 line, qint64 column, const QString &message
 
 bool loadXLIFF(Translator &translator, QIODevice &dev, ConversionData &cd)
 {
-    QXmlStreamReader reader(&dev);
+    // The reader decodes the mapped file instead of reading it in chunks
+    const DeviceContent content(dev);
+    QXmlStreamReader reader(QByteArray::fromRawData(
+            reinterpret_cast<const char *>(content.data()), content.size()));
     XLIFFHandler hand(translator, cd, reader);
     return hand.parse();
 }
@@ -762,20 +768,20 @@ bool saveXLIFF(const Translator &translator, QIODevice &dev, ConversionData &cd)
     dtgs << QLatin1String("po-(old_)?msgid_plural");
     QRegularExpression drops(QRegularExpression::anchoredPattern(dtgs.join(QLatin1Char('|'))));
 
-    QHash<QString, QHash<QString, QList<TranslatorMessage> > > messageOrder;
+    QHash<QString, QHash<QString, QList<const TranslatorMessage *> > > messageOrder;
     QHash<QString, QList<QString> > contextOrder;
     QList<QString> fileOrder;
     for (const TranslatorMessage &msg : translator.messages()) {
         QString fn = msg.fileName();
         if (fn.isEmpty() && msg.type() == TranslatorMessage::Obsolete)
             fn = QLatin1String(MAGIC_OBSOLETE_REFERENCE);
-        QHash<QString, QList<TranslatorMessage> > &file = messageOrder[fn];
+        QHash<QString, QList<const TranslatorMessage *> > &file = messageOrder[fn];
         if (file.isEmpty())
             fileOrder.append(fn);
-        QList<TranslatorMessage> &context = file[msg.context()];
+        QList<const TranslatorMessage *> &context = file[msg.context()];
         if (context.isEmpty())
             contextOrder[fn].append(msg.context());
-        context.append(msg);
+        context.append(&msg);
     }
 
     ts.setFieldAlignment(QTextStream::AlignRight);
@@ -795,7 +801,7 @@ bool saveXLIFF(const Translator &translator, QIODevice &dev, ConversionData &cd)
     for (const QString &fn : qAsConst(fileOrder)) {
         writeIndent(ts, indent);
         ts << "<file original=\"" << fn << "\""
-            << " datatype=\"" << dataType(messageOrder[fn].cbegin()->first()) << "\""
+            << " datatype=\"" << dataType(*messageOrder[fn].cbegin()->first()) << "\""
             << " source-language=\"" << sourceLanguageCode.toLatin1() << "\""
             << " target-language=\"" << languageCode.toLatin1() << "\""
             << "><body>\n";
@@ -809,8 +815,8 @@ bool saveXLIFF(const Translator &translator, QIODevice &dev, ConversionData &cd)
                 ++indent;
             }
 
-            for (const TranslatorMessage &msg : qAsConst(messageOrder[fn][ctx]))
-                writeMessage(ts, msg, drops, indent);
+            for (const TranslatorMessage *msg : qAsConst(messageOrder[fn][ctx]))
+                writeMessage(ts, *msg, drops, indent);
 
             if (!ctx.isEmpty()) {
                 --indent;
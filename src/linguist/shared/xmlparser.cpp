@@ -53,7 +53,7 @@ bool XmlParser::parse()
             break;
         case QXmlStreamReader::Characters:
             if (reportWhitespaceOnlyData
-                || (!reader.isWhitespace() && !reader.text().toString().trimmed().isEmpty())) {
+                || (!reader.isWhitespace() && !reader.text().trimmed().isEmpty())) {
                 if (!characters(reader.text()))
                     return false;
             }
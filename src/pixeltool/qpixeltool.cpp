@@ -51,6 +51,8 @@
 
 #include <qdebug.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 static QPoint initialPos(const QSettings &settings, const QSize &initialSize)
@@ -134,56 +136,119 @@ void render_string(QPainter *p, int w, int h, const QString &text, int flags)
     p->drawText(bounds, flags, text);
 }
 
-static QImage imageLCDFilter(const QImage &image, int lcdMode)
-{
-    Q_ASSERT(lcdMode > 0 && lcdMode < 5);
-    const bool vertical = (lcdMode > 2);
-    QImage scaled(image.width()  * (vertical ? 1 : 3),
-                  image.height() * (vertical ? 3 : 1),
-                  image.format());
-
-    const int w = image.width();
-    const int h = image.height();
-    if (!vertical) {
-        for (int y = 0; y < h; ++y) {
-            const QRgb *in = reinterpret_cast<const QRgb *>(image.scanLine(y));
-            QRgb *out = reinterpret_cast<QRgb *>(scaled.scanLine(y));
-            if (lcdMode == 1) {
-                for (int x = 0; x < w; ++x) {
-                    *out++ = in[x] & 0xffff0000;
-                    *out++ = in[x] & 0xff00ff00;
-                    *out++ = in[x] & 0xff0000ff;
-                }
-            } else {
-                for (int x = 0; x < w; ++x) {
-                    *out++ = in[x] & 0xff0000ff;
-                    *out++ = in[x] & 0xff00ff00;
-                    *out++ = in[x] & 0xffff0000;
-                }
+// A horizontal span of target pixels that all come from the same source
+// column, with the channel mask of the LCD subpixel it represents.
+struct ZoomedSpan
+{
+    int start;
+    int length;
+    int sourceColumn; // -1: outside of the source, -2: grid line
+    QRgb mask;
+};
+
+enum { OutsideSource = -1, GridLine = -2 };
+
+// Scales \a source into \a target with nearest-neighbour sampling, applying the
+// LCD subpixel filter and the grid on the way. The column mapping is computed
+// once as a list of spans, so every target row is a handful of fills, and rows
+// sampling the same source row with the same mask are copied.
+static void renderZoomedImage(const QImage &source, QImage *target, int zoom, int lcdMode,
+                              int gridIncrement, QRgb gridColor)
+{
+    static const QRgb rgbMasks[3] = { 0xffff0000, 0xff00ff00, 0xff0000ff };
+    static const QRgb bgrMasks[3] = { 0xff0000ff, 0xff00ff00, 0xffff0000 };
+    const QRgb *subpixelMasks = (lcdMode == 1 || lcdMode == 3) ? rgbMasks : bgrMasks;
+    const bool horizontalLcd = lcdMode == 1 || lcdMode == 2;
+    const bool verticalLcd = lcdMode > 2;
+
+    const int w = target->width();
+    const int h = target->height();
+    const qreal dpr = target->devicePixelRatio();
+    const qreal scale = zoom * dpr;
+
+    // Grid lines are placed in logical coordinates, like QPainter would.
+    auto gridPositions = [&](int size) {
+        QList<bool> positions(size, false);
+        if (gridIncrement > 0) {
+            for (int i = 0; ; i += gridIncrement) {
+                const int pos = qRound(i * dpr);
+                if (pos >= size)
+                    break;
+                positions[pos] = true;
             }
         }
-    } else {
-        for (int y = 0; y < h; ++y) {
-            const QRgb *in = reinterpret_cast<const QRgb *>(image.scanLine(y));
-            QRgb *out1 = reinterpret_cast<QRgb *>(scaled.scanLine(y * 3 + 0));
-            QRgb *out2 = reinterpret_cast<QRgb *>(scaled.scanLine(y * 3 + 1));
-            QRgb *out3 = reinterpret_cast<QRgb *>(scaled.scanLine(y * 3 + 2));
-            if (lcdMode == 2) {
-                for (int x = 0; x < w; ++x) {
-                    out1[x] = in[x] & 0xffff0000;
-                    out2[x] = in[x] & 0xff00ff00;
-                    out3[x] = in[x] & 0xff0000ff;
-                }
-            } else {
-                for (int x = 0; x < w; ++x) {
-                    out1[x] = in[x] & 0xff0000ff;
-                    out2[x] = in[x] & 0xff00ff00;
-                    out3[x] = in[x] & 0xffff0000;
-                }
-            }
+        return positions;
+    };
+    const QList<bool> gridColumns = gridPositions(horizontalLcd ? 0 : w);
+    const QList<bool> gridRows = gridPositions(verticalLcd ? 0 : h);
+
+    QList<ZoomedSpan> spans;
+    for (int x = 0; x < w; ++x) {
+        int sourceColumn;
+        QRgb mask = 0xffffffff;
+        if (!gridColumns.isEmpty() && gridColumns.at(x)) {
+            sourceColumn = GridLine;
+        } else if (horizontalLcd) {
+            const int subpixel = int(x * 3 / scale);
+            sourceColumn = subpixel / 3;
+            mask = subpixelMasks[subpixel % 3];
+        } else {
+            sourceColumn = int(x / scale);
+        }
+        if (sourceColumn >= source.width())
+            sourceColumn = OutsideSource;
+
+        if (!spans.isEmpty() && spans.last().sourceColumn == sourceColumn
+            && spans.last().mask == mask) {
+            ++spans.last().length;
+        } else {
+            spans.append({ x, 1, sourceColumn, mask });
+        }
+    }
+
+    const QRgb *previousLine = nullptr;
+    int previousSourceRow = OutsideSource;
+    QRgb previousRowMask = 0;
+    for (int y = 0; y < h; ++y) {
+        QRgb *out = reinterpret_cast<QRgb *>(target->scanLine(y));
+        if (!gridRows.isEmpty() && gridRows.at(y)) {
+            std::fill_n(out, w, gridColor);
+            continue;
+        }
+
+        int sourceRow;
+        QRgb rowMask = 0xffffffff;
+        if (verticalLcd) {
+            const int subpixel = int(y * 3 / scale);
+            sourceRow = subpixel / 3;
+            rowMask = subpixelMasks[subpixel % 3];
+        } else {
+            sourceRow = int(y / scale);
+        }
+        if (sourceRow >= source.height())
+            sourceRow = OutsideSource;
+
+        if (previousLine && sourceRow == previousSourceRow && rowMask == previousRowMask) {
+            memcpy(out, previousLine, w * sizeof(QRgb));
+            continue;
+        }
+
+        const QRgb *in = sourceRow >= 0
+            ? reinterpret_cast<const QRgb *>(source.constScanLine(sourceRow)) : nullptr;
+        for (const ZoomedSpan &span : qAsConst(spans)) {
+            QRgb value;
+            if (span.sourceColumn == GridLine)
+                value = gridColor;
+            else if (!in || span.sourceColumn == OutsideSource)
+                value = 0;
+            else
+                value = in[span.sourceColumn] & span.mask & rowMask;
+            std::fill_n(out + span.start, span.length, value);
         }
+        previousLine = out;
+        previousSourceRow = sourceRow;
+        previousRowMask = rowMask;
     }
-    return scaled;
 }
 
 void QPixelTool::paintEvent(QPaintEvent *)
@@ -204,32 +269,20 @@ void QPixelTool::paintEvent(QPaintEvent *)
     int w = width();
     int h = height();
 
-    p.save();
-    if (m_lcdMode == 0)  {
-        p.scale(m_zoom, m_zoom);
-        p.drawPixmap(0, 0, m_buffer);
-    } else {
-        if (m_lcdMode <= 2)
-            p.scale(m_zoom / 3.0, m_zoom);
-        else
-            p.scale(m_zoom, m_zoom / 3.0);
-        p.drawImage(0, 0, imageLCDFilter(m_buffer.toImage(), m_lcdMode));
+    const qreal dpr = devicePixelRatioF();
+    const QSize targetSize = (QSizeF(w, h) * dpr).toSize();
+    if (m_zoomedImage.size() != targetSize || m_zoomedImage.devicePixelRatio() != dpr) {
+        m_zoomedImage = QImage(targetSize, QImage::Format_ARGB32_Premultiplied);
+        m_zoomedImage.setDevicePixelRatio(dpr);
+        m_zoomedImageDirty = true;
     }
-    p.restore();
-
-    // Draw the grid on top.
-    if (m_gridActive) {
-        p.setPen(m_gridActive == 1 ? Qt::black : Qt::white);
-        int incr = m_gridSize * m_zoom;
-        if (m_lcdMode == 0 || m_lcdMode > 2) {
-            for (int x=0; x<w; x+=incr)
-                p.drawLine(x, 0, x, h);
-        }
-        if (m_lcdMode <= 2) {
-            for (int y=0; y<h; y+=incr)
-                p.drawLine(0, y, w, y);
-        }
+    if (m_zoomedImageDirty) {
+        renderZoomedImage(m_bufferImage, &m_zoomedImage, m_zoom, m_lcdMode,
+                          m_gridActive ? m_gridSize * m_zoom : 0,
+                          m_gridActive == 1 ? 0xff000000 : 0xffffffff);
+        m_zoomedImageDirty = false;
     }
+    p.drawImage(0, 0, m_zoomedImage);
 
     QFont f(QStringList{u"courier"_qs}, -1, QFont::Bold);
     p.setFont(f);
@@ -353,9 +406,8 @@ void QPixelTool::mouseMoveEvent(QMouseEvent *e)
     const int x = pos.x() / m_zoom;
     const int y = pos.y() / m_zoom;
 
-    QImage im = m_buffer.toImage().convertToFormat(QImage::Format_ARGB32);
-    if (x < im.width() && y < im.height() && x >= 0 && y >= 0) {
-        m_currentColor = im.pixel(x, y);
+    if (x < m_bufferImage.width() && y < m_bufferImage.height() && x >= 0 && y >= 0) {
+        m_currentColor = m_bufferImage.pixel(x, y);
         update();
     }
 }
@@ -483,6 +535,8 @@ void QPixelTool::contextMenuEvent(QContextMenuEvent *e)
 
     m_autoUpdate = autoUpdate->isChecked();
     m_freeze = freeze->isChecked();
+    m_zoomedImageDirty = true;
+    update();
 
     // LCD mode looks off unless zoom is dividable by 3
     if (m_lcdMode && m_zoom % 3)
@@ -511,7 +565,10 @@ void QPixelTool::grabScreen()
     if (m_preview_mode) {
         int w = qMin(width() / m_zoom + 1, m_preview_image.width());
         int h = qMin(height() / m_zoom + 1, m_preview_image.height());
-        m_buffer = QPixmap::fromImage(m_preview_image).copy(0, 0, w, h);
+        m_bufferImage = m_preview_image.copy(0, 0, w, h)
+                            .convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        m_buffer = QPixmap::fromImage(m_bufferImage);
+        m_zoomedImageDirty = true;
         update();
         return;
     }
@@ -556,9 +613,11 @@ void QPixelTool::grabScreen()
         p.drawRects(geom.begin(), rectsInRegion);
     }
 
+    m_bufferImage = m_buffer.toImage().convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    m_zoomedImageDirty = true;
     update();
 
-    m_currentColor = m_buffer.toImage().pixel(m_buffer.rect().center());
+    m_currentColor = m_bufferImage.pixel(m_bufferImage.rect().center());
     m_lastMousePos = mousePos;
 }
 
@@ -627,6 +686,7 @@ void QPixelTool::toggleGrid()
 {
     if (++m_gridActive > 2)
         m_gridActive = 0;
+    m_zoomedImageDirty = true;
     update();
 }
 
@@ -634,6 +694,7 @@ void QPixelTool::setGridSize(int gridSize)
 {
     if (m_gridActive && gridSize > 0) {
         m_gridSize = gridSize;
+        m_zoomedImageDirty = true;
         startGridSizeVisibleTimer();
         update();
     }
@@ -30,6 +30,7 @@
 #define QPIXELTOOL_H
 
 #include <qwidget.h>
+#include <qimage.h>
 #include <qpixmap.h>
 
 QT_BEGIN_NAMESPACE
@@ -101,6 +102,9 @@ private:
     QPoint m_dragStart;
     QPoint m_dragCurrent;
     QPixmap m_buffer;
+    QImage m_bufferImage;
+    QImage m_zoomedImage;
+    bool m_zoomedImageDirty = true;
 
     QSize m_initialSize;
 
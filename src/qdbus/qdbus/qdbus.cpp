@@ -29,10 +29,15 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <functional>
+
 #include <QtCore/QCoreApplication>
+#include <QtCore/QEventLoop>
+#include <QtCore/QHash>
 #include <QtCore/QRegularExpression>
 #include <QtCore/QStringList>
 #include <QtCore/qmetaobject.h>
+#include <QtCore/QXmlStreamReader>
 #include <QtXml/QDomDocument>
 #include <QtXml/QDomElement>
 #include <QtDBus/QDBusConnection>
@@ -41,6 +46,8 @@
 #include <QtDBus/QDBusVariant>
 #include <QtDBus/QDBusArgument>
 #include <QtDBus/QDBusMessage>
+#include <QtDBus/QDBusPendingCallWatcher>
+#include <QtDBus/QDBusPendingReply>
 #include <QtDBus/QDBusReply>
 #include <private/qdbusutil_p.h>
 
@@ -108,43 +115,93 @@ static void printArg(const QVariant &v)
     }
 }
 
-static void listObjects(const QString &service, const QString &path)
+static QDBusMessage introspectionCall(const QString &service, const QString &path)
 {
     // make a low-level call, to avoid introspecting the Introspectable interface
-    QDBusMessage call = QDBusMessage::createMethodCall(service, path.isEmpty() ? QLatin1String("/") : path,
-                                                       QLatin1String("org.freedesktop.DBus.Introspectable"),
-                                                       QLatin1String("Introspect"));
-    QDBusReply<QString> xml = connection.call(call);
+    return QDBusMessage::createMethodCall(service, path.isEmpty() ? QLatin1String("/") : path,
+                                          QLatin1String("org.freedesktop.DBus.Introspectable"),
+                                          QLatin1String("Introspect"));
+}
 
-    if (path.isEmpty()) {
-        // top-level
-        if (xml.isValid()) {
-            printf("/\n");
-        } else {
-            QDBusError err = xml.error();
-            if (err.type() == QDBusError::ServiceUnknown)
-                fprintf(stderr, "Service '%s' does not exist.\n", qPrintable(service));
-            else
-                printf("Error: %s\n%s\n", qPrintable(err.name()), qPrintable(err.message()));
-            exit(2);
+static QStringList childObjectPaths(const QString &path, const QString &xml)
+{
+    QStringList result;
+    QXmlStreamReader reader(xml);
+    int depth = 0;
+    while (!reader.atEnd()) {
+        switch (reader.readNext()) {
+        case QXmlStreamReader::StartElement:
+            if (++depth == 2 && reader.name() == QLatin1String("node"))
+                result.append(path + QLatin1Char('/') + reader.attributes().value(QLatin1String("name")).toString());
+            break;
+        case QXmlStreamReader::EndElement:
+            --depth;
+            break;
+        default:
+            break;
         }
-    } else if (!xml.isValid()) {
-        // this is not the first object, just fail silently
-        return;
     }
+    return result;
+}
 
-    QDomDocument doc;
-    doc.setContent(xml);
-    QDomElement node = doc.documentElement();
-    QDomElement child = node.firstChildElement();
-    while (!child.isNull()) {
-        if (child.tagName() == QLatin1String("node")) {
-            QString sub = path + QLatin1Char('/') + child.attribute(QLatin1String("name"));
-            printf("%s\n", qPrintable(sub));
-            listObjects(service, sub);
-        }
-        child = child.nextSiblingElement();
+static void printObjects(const QHash<QString, QStringList> &children, const QString &path)
+{
+    for (const QString &sub : children.value(path)) {
+        printf("%s\n", qPrintable(sub));
+        printObjects(children, sub);
+    }
+}
+
+static void listObjects(const QString &service)
+{
+    QDBusReply<QString> xml = connection.call(introspectionCall(service, QString()));
+    if (!xml.isValid()) {
+        QDBusError err = xml.error();
+        if (err.type() == QDBusError::ServiceUnknown)
+            fprintf(stderr, "Service '%s' does not exist.\n", qPrintable(service));
+        else
+            printf("Error: %s\n%s\n", qPrintable(err.name()), qPrintable(err.message()));
+        exit(2);
     }
+    printf("/\n");
+
+    // Introspect the rest of the tree with a bounded number of calls in flight, and
+    // print it once complete, in the same depth-first order the nodes are listed in.
+    // Objects that fail to introspect are skipped silently.
+    const int maxCallsInFlight = 16;
+    QHash<QString, QStringList> children;
+    QStringList pending = childObjectPaths(QString(), xml.value());
+    children.insert(QString(), pending);
+    int callsInFlight = 0;
+    QEventLoop loop;
+
+    std::function<void()> startCalls = [&]() {
+        while (callsInFlight < maxCallsInFlight && !pending.isEmpty()) {
+            const QString path = pending.takeLast();
+            auto *watcher = new QDBusPendingCallWatcher(connection.asyncCall(introspectionCall(service, path)));
+            ++callsInFlight;
+            QObject::connect(watcher, &QDBusPendingCallWatcher::finished,
+                             [&, path](QDBusPendingCallWatcher *call) {
+                const QDBusPendingReply<QString> reply = *call;
+                if (!reply.isError()) {
+                    const QStringList subs = childObjectPaths(path, reply.value());
+                    children.insert(path, subs);
+                    pending += subs;
+                }
+                call->deleteLater();
+                --callsInFlight;
+                startCalls();
+                if (callsInFlight == 0)
+                    loop.quit();
+            });
+        }
+    };
+
+    startCalls();
+    if (callsInFlight > 0)
+        loop.exec();
+
+    printObjects(children, QString());
 }
 
 static void listInterface(const QString &service, const QString &path, const QString &interface)
@@ -498,7 +555,7 @@ int main(int argc, char **argv)
     }
 
     if (args.isEmpty()) {
-        listObjects(service, QString());
+        listObjects(service);
         return 0;
     }
 
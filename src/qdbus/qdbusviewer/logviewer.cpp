@@ -29,18 +29,82 @@
 #include "logviewer.h"
 
 #include <QtGui/QContextMenuEvent>
+#include <QtGui/QTextCursor>
+#include <QtWidgets/QInputDialog>
 #include <QtWidgets/QMenu>
 
 LogViewer::LogViewer(QWidget *parent)
     : QTextBrowser(parent)
 {
+    document()->setMaximumBlockCount(m_maximumEntryCount);
+
+    // coalesce the updates of chatty services
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(100);
+    connect(&m_flushTimer, &QTimer::timeout, this, &LogViewer::flush);
+}
+
+void LogViewer::appendEntry(const QString &html)
+{
+    appendEntry([html]() { return html; });
+}
+
+void LogViewer::appendEntry(const Formatter &formatter)
+{
+    m_pending.push_back(formatter);
+    if (m_pending.size() > size_t(m_maximumEntryCount))
+        m_pending.pop_front();
+    if (!m_flushTimer.isActive())
+        m_flushTimer.start();
+}
+
+void LogViewer::setMaximumEntryCount(int count)
+{
+    m_maximumEntryCount = qMax(1, count);
+    document()->setMaximumBlockCount(m_maximumEntryCount);
+    while (m_pending.size() > size_t(m_maximumEntryCount))
+        m_pending.pop_front();
+}
+
+void LogViewer::clearLog()
+{
+    m_pending.clear();
+    m_flushTimer.stop();
+    clear();
+}
+
+void LogViewer::flush()
+{
+    if (m_pending.empty())
+        return;
+
+    std::deque<Formatter> pending;
+    pending.swap(m_pending);
+
+    QTextCursor cursor(document());
+    cursor.beginEditBlock();
+    for (const Formatter &formatter : pending)
+        append(formatter());
+    cursor.endEditBlock();
+}
+
+void LogViewer::changeMaximumEntryCount()
+{
+    bool ok;
+    const int count = QInputDialog::getInt(this, tr("Log Size"),
+                                           tr("Maximum number of log entries:"),
+                                           m_maximumEntryCount, 1, 1000000, 100, &ok);
+    if (ok)
+        setMaximumEntryCount(count);
 }
 
 void LogViewer::contextMenuEvent(QContextMenuEvent *event)
 {
     QMenu *menu = createStandardContextMenu();
     QAction *action = menu->addAction(tr("Clear"));
-    connect(action, &QAction::triggered, this, &QTextEdit::clear);
+    connect(action, &QAction::triggered, this, &LogViewer::clearLog);
+    action = menu->addAction(tr("Maximum Entries..."));
+    connect(action, &QAction::triggered, this, &LogViewer::changeMaximumEntryCount);
     menu->exec(event->globalPos());
     delete menu;
 }
@@ -30,15 +30,40 @@
 #define LOGVIEWER_H
 
 #include <QtWidgets/QTextBrowser>
+#include <QtCore/QTimer>
+
+#include <deque>
+#include <functional>
 
 class LogViewer : public QTextBrowser
 {
     Q_OBJECT
 public:
+    using Formatter = std::function<QString()>;
+
     explicit LogViewer(QWidget *parent = 0);
 
+    void appendEntry(const QString &html);
+    void appendEntry(const Formatter &formatter);
+
+    int maximumEntryCount() const { return m_maximumEntryCount; }
+    void setMaximumEntryCount(int count);
+
+public slots:
+    void clearLog();
+
 protected:
     void contextMenuEvent(QContextMenuEvent *event) override;
+
+private:
+    void flush();
+    void changeMaximumEntryCount();
+
+    // Entries are only formatted when they are flushed, and only the ones that
+    // will still be shown afterwards
+    std::deque<Formatter> m_pending;
+    QTimer m_flushTimer;
+    int m_maximumEntryCount = 1000;
 };
 
 #endif // LOGVIEWER_H
@@ -32,7 +32,9 @@
 #include <QtCore/QList>
 
 #include <QtDBus/QDBusObjectPath>
-#include <QtDBus/QDBusInterface>
+#include <QtDBus/QDBusMessage>
+#include <QtDBus/QDBusPendingCallWatcher>
+#include <QtDBus/QDBusPendingReply>
 #include <QtDBus/QDBusReply>
 
 #include <QtXml/QDomDocument>
@@ -44,6 +46,7 @@ struct QDBusItem
         {}
     inline ~QDBusItem()
     {
+        delete pendingCall;
         qDeleteAll(children);
     }
 
@@ -66,39 +69,29 @@ struct QDBusItem
     QDBusItem *parent;
     QList<QDBusItem *> children;
     bool isPrefetched;
+    QDBusPendingCallWatcher *pendingCall = nullptr;
     QString name;
     QString caption;
     QString typeSignature;
 };
 
-QDomDocument QDBusModel::introspect(const QString &path)
+static QDBusMessage introspectionCall(const QString &service, const QString &path)
 {
-    QDomDocument doc;
-
-    QDBusInterface iface(service, path, QLatin1String("org.freedesktop.DBus.Introspectable"), c);
-    if (!iface.isValid()) {
-        QDBusError err(iface.lastError());
-        emit busError(QString::fromLatin1("Cannot introspect object %1 at %2:\n  %3 (%4)\n").arg(path).arg(
-                      service).arg(err.name()).arg(err.message()));
-        return doc;
-    }
-
-    QDBusReply<QString> xml = iface.call(QLatin1String("Introspect"));
+    // make a low-level call, to avoid introspecting the Introspectable interface
+    return QDBusMessage::createMethodCall(service, path,
+                                          QLatin1String("org.freedesktop.DBus.Introspectable"),
+                                          QLatin1String("Introspect"));
+}
 
-    if (!xml.isValid()) {
-        QDBusError err(xml.error());
-        if (err.isValid()) {
-            emit busError(QString::fromLatin1("Call to object %1 at %2:\n  %3 (%4) failed\n").arg(
-                        path).arg(service).arg(err.name()).arg(err.message()));
-        } else {
-            emit busError(QString::fromLatin1("Invalid XML received from object %1 at %2\n").arg(
-                    path).arg(service));
-        }
-        return doc;
+void QDBusModel::introspectionFailed(const QString &path, const QDBusError &err)
+{
+    if (err.isValid()) {
+        emit busError(QString::fromLatin1("Call to object %1 at %2:\n  %3 (%4) failed\n").arg(
+                    path).arg(service).arg(err.name()).arg(err.message()));
+    } else {
+        emit busError(QString::fromLatin1("Invalid XML received from object %1 at %2\n").arg(
+                path).arg(service));
     }
-
-    doc.setContent(xml);
-    return doc;
 }
 
 void QDBusModel::addMethods(QDBusItem *parent, const QDomElement &iface)
@@ -137,26 +130,35 @@ void QDBusModel::addMethods(QDBusItem *parent, const QDomElement &iface)
     }
 }
 
-void QDBusModel::addPath(QDBusItem *parent)
+void QDBusModel::setChildren(QDBusItem *parent, const QString &xml)
 {
     Q_ASSERT(parent);
 
-    QString path = parent->path();
+    const QModelIndex parentIndex = indexForItem(parent);
+    if (!parent->children.isEmpty()) {
+        beginRemoveRows(parentIndex, 0, parent->children.count() - 1);
+        qDeleteAll(parent->children);
+        parent->children.clear();
+        endRemoveRows();
+    }
+
+    QList<QDBusItem *> children;
 
-    QDomDocument doc = introspect(path);
+    QDomDocument doc;
+    doc.setContent(xml);
     QDomElement node = doc.documentElement();
     QDomElement child = node.firstChildElement();
     while (!child.isNull()) {
         if (child.tagName() == QLatin1String("node")) {
             QDBusItem *item = new QDBusItem(QDBusModel::PathItem,
                         child.attribute(QLatin1String("name")) + QLatin1Char('/'), parent);
-            parent->children.append(item);
+            children.append(item);
 
             addMethods(item, child);
         } else if (child.tagName() == QLatin1String("interface")) {
             QDBusItem *item = new QDBusItem(QDBusModel::InterfaceItem,
                         child.attribute(QLatin1String("name")), parent);
-            parent->children.append(item);
+            children.append(item);
 
             addMethods(item, child);
         } else {
@@ -166,10 +168,49 @@ void QDBusModel::addPath(QDBusItem *parent)
     }
 
     parent->isPrefetched = true;
+    if (!children.isEmpty()) {
+        beginInsertRows(parentIndex, 0, children.count() - 1);
+        parent->children = children;
+        endInsertRows();
+    }
+}
+
+QModelIndex QDBusModel::indexForItem(QDBusItem *item) const
+{
+    if (!item || item == root)
+        return QModelIndex();
+    return createIndex(item->parent->children.indexOf(item), 0, item);
+}
+
+void QDBusModel::fetchSynchronously(QDBusItem *item)
+{
+    delete item->pendingCall;
+    item->pendingCall = nullptr;
+
+    const QString path = item->path();
+    if (cache) {
+        const auto it = cache->constFind(path);
+        if (it != cache->constEnd()) {
+            setChildren(item, it.value());
+            return;
+        }
+    }
+
+    QDBusReply<QString> xml = c.call(introspectionCall(service, path));
+    if (!xml.isValid()) {
+        introspectionFailed(path, xml.error());
+        setChildren(item, QString());
+        return;
+    }
+
+    if (cache)
+        cache->insert(path, xml.value());
+    setChildren(item, xml.value());
 }
 
-QDBusModel::QDBusModel(const QString &aService, const QDBusConnection &connection)
-    : service(aService), c(connection), root(0)
+QDBusModel::QDBusModel(const QString &aService, const QDBusConnection &connection,
+                       const QSharedPointer<IntrospectionCache> &aCache)
+    : service(aService), c(connection), cache(aCache), root(0)
 {
     root = new QDBusItem(QDBusModel::PathItem, QLatin1String("/"));
 }
@@ -205,12 +246,75 @@ int QDBusModel::rowCount(const QModelIndex &parent) const
     QDBusItem *item = static_cast<QDBusItem *>(parent.internalPointer());
     if (!item)
         item = root;
-    if (!item->isPrefetched)
-        const_cast<QDBusModel *>(this)->addPath(item);
 
     return item->children.count();
 }
 
+bool QDBusModel::hasChildren(const QModelIndex &parent) const
+{
+    const QDBusItem *item = static_cast<QDBusItem *>(parent.internalPointer());
+    if (!item)
+        item = root;
+
+    // unfetched objects are assumed to have children until introspected
+    return !item->isPrefetched || !item->children.isEmpty();
+}
+
+bool QDBusModel::canFetchMore(const QModelIndex &parent) const
+{
+    const QDBusItem *item = static_cast<QDBusItem *>(parent.internalPointer());
+    if (!item)
+        item = root;
+
+    return !item->isPrefetched && !item->pendingCall;
+}
+
+void QDBusModel::fetchMore(const QModelIndex &parent)
+{
+    QDBusItem *item = static_cast<QDBusItem *>(parent.internalPointer());
+    if (!item)
+        item = root;
+    if (item->isPrefetched || item->pendingCall)
+        return;
+
+    const QString path = item->path();
+    if (cache) {
+        const auto it = cache->constFind(path);
+        if (it != cache->constEnd()) {
+            setChildren(item, it.value());
+            return;
+        }
+    }
+
+    // Show a placeholder while the object is introspected asynchronously, so
+    // that slow or hung peers do not block the viewer
+    QDBusItem *placeholder = new QDBusItem(PlaceholderItem, QString(), item);
+    placeholder->caption = tr("Loading...");
+    beginInsertRows(parent, 0, 0);
+    item->children.append(placeholder);
+    endInsertRows();
+
+    // The watcher is owned by the item, so that the reply is dropped when the
+    // item is deleted by a refresh or a model reset before it arrives
+    item->pendingCall = new QDBusPendingCallWatcher(c.asyncCall(introspectionCall(service, path)));
+    connect(item->pendingCall, &QDBusPendingCallWatcher::finished, this,
+            [this, item, path](QDBusPendingCallWatcher *call) {
+        item->pendingCall = nullptr;
+        call->deleteLater();
+
+        const QDBusPendingReply<QString> xml = *call;
+        if (xml.isError()) {
+            introspectionFailed(path, xml.error());
+            setChildren(item, QString());
+            return;
+        }
+
+        if (cache)
+            cache->insert(path, xml.value());
+        setChildren(item, xml.value());
+    });
+}
+
 int QDBusModel::columnCount(const QModelIndex &) const
 {
     return 1;
@@ -253,6 +357,9 @@ void QDBusModel::refresh(const QModelIndex &aIndex)
     if (!item)
         item = root;
 
+    delete item->pendingCall;
+    item->pendingCall = nullptr;
+
     if (!item->children.isEmpty()) {
         beginRemoveRows(index, 0, item->children.count() - 1);
         qDeleteAll(item->children);
@@ -260,11 +367,16 @@ void QDBusModel::refresh(const QModelIndex &aIndex)
         endRemoveRows();
     }
 
-    addPath(item);
-    if (!item->children.isEmpty()) {
-        beginInsertRows(index, 0, item->children.count() - 1);
-        endInsertRows();
+    if (cache) {
+        // drop the object and everything below it, so that expanding re-introspects
+        const QString path = item->path();
+        const QString prefix = path.endsWith(QLatin1Char('/')) ? path : path + QLatin1Char('/');
+        cache->removeIf([&](const IntrospectionCache::iterator &it) {
+            return it.key() == path || it.key().startsWith(prefix);
+        });
     }
+    item->isPrefetched = false;
+    fetchMore(index);
 }
 
 QString QDBusModel::dBusPath(const QModelIndex &aIndex) const
@@ -312,6 +424,10 @@ QModelIndex QDBusModel::findObject(const QDBusObjectPath &objectPath)
     QDBusItem *item = root;
     int childIdx = -1;
     while (item && !path.isEmpty()) {
+        // the caller needs the branch right away, so do not wait for an asynchronous fetch
+        if (!item->isPrefetched)
+            fetchSynchronously(item);
+
         const QString branch = path.takeFirst() + QLatin1Char('/');
         childIdx = -1;
 
@@ -321,10 +437,6 @@ QModelIndex QDBusModel::findObject(const QDBusObjectPath &objectPath)
             if (child->type == PathItem && child->name == branch) {
                 item = child;
                 childIdx = i;
-
-                // prefetch the found branch
-                if (!item->isPrefetched)
-                    addPath(item);
                 break;
             }
         }
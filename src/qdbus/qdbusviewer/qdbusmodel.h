@@ -30,6 +30,8 @@
 #define QDBUSMODEL_H
 
 #include <QtCore/qabstractitemmodel.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qsharedpointer.h>
 #include <QtDBus/QDBusConnection>
 
 struct QDBusItem;
@@ -37,6 +39,7 @@ struct QDBusItem;
 QT_FORWARD_DECLARE_CLASS(QDomDocument);
 QT_FORWARD_DECLARE_CLASS(QDomElement);
 QT_FORWARD_DECLARE_CLASS(QDBusObjectPath)
+QT_FORWARD_DECLARE_CLASS(QDBusError)
 
 
 class QDBusModel: public QAbstractItemModel
@@ -44,15 +47,22 @@ class QDBusModel: public QAbstractItemModel
     Q_OBJECT
 
 public:
-    enum Type { InterfaceItem, PathItem, MethodItem, SignalItem, PropertyItem };
+    enum Type { InterfaceItem, PathItem, MethodItem, SignalItem, PropertyItem, PlaceholderItem };
 
-    QDBusModel(const QString &service, const QDBusConnection &connection);
+    // Introspection XML by object path, shared by all models of a service
+    using IntrospectionCache = QHash<QString, QString>;
+
+    QDBusModel(const QString &service, const QDBusConnection &connection,
+               const QSharedPointer<IntrospectionCache> &cache = QSharedPointer<IntrospectionCache>());
     ~QDBusModel();
 
 
     QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
     QModelIndex parent(const QModelIndex &child) const override;
     int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
     int columnCount(const QModelIndex &parent = QModelIndex()) const override;
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
     QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
@@ -71,12 +81,15 @@ Q_SIGNALS:
     void busError(const QString &text);
 
 private:
-    QDomDocument introspect(const QString &path);
+    QModelIndex indexForItem(QDBusItem *item) const;
+    void fetchSynchronously(QDBusItem *item);
+    void introspectionFailed(const QString &path, const QDBusError &err);
     void addMethods(QDBusItem *parent, const QDomElement &iface);
-    void addPath(QDBusItem *parent);
+    void setChildren(QDBusItem *parent, const QString &xml);
 
     QString service;
     QDBusConnection c;
+    QSharedPointer<IntrospectionCache> cache;
     QDBusItem *root;
 };
 
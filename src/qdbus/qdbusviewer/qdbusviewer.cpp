@@ -59,8 +59,9 @@
 class QDBusViewModel: public QDBusModel
 {
 public:
-    inline QDBusViewModel(const QString &service, const QDBusConnection &connection)
-        : QDBusModel(service, connection)
+    inline QDBusViewModel(const QString &service, const QDBusConnection &connection,
+                          const QSharedPointer<IntrospectionCache> &cache)
+        : QDBusModel(service, connection, cache)
     {}
 
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override
@@ -169,22 +170,25 @@ QDBusViewer::QDBusViewer(const QDBusConnection &connection, QWidget *parent)  :
 
 static inline QString topSplitterStateKey() { return QStringLiteral("topSplitterState"); }
 static inline QString splitterStateKey() { return QStringLiteral("splitterState"); }
+static inline QString logMaximumEntriesKey() { return QStringLiteral("logMaximumEntries"); }
 
 void QDBusViewer::saveState(QSettings *settings) const
 {
     settings->setValue(topSplitterStateKey(), topSplitter->saveState());
     settings->setValue(splitterStateKey(), splitter->saveState());
+    settings->setValue(logMaximumEntriesKey(), log->maximumEntryCount());
 }
 
 void QDBusViewer::restoreState(const QSettings *settings)
 {
     topSplitter->restoreState(settings->value(topSplitterStateKey()).toByteArray());
     splitter->restoreState(settings->value(splitterStateKey()).toByteArray());
+    log->setMaximumEntryCount(settings->value(logMaximumEntriesKey(), log->maximumEntryCount()).toInt());
 }
 
 void QDBusViewer::logMessage(const QString &msg)
 {
-    log->append(msg + QLatin1Char('\n'));
+    log->appendEntry(msg + QLatin1Char('\n'));
 }
 
 void QDBusViewer::showEvent(QShowEvent *)
@@ -209,7 +213,7 @@ bool QDBusViewer::eventFilter(QObject *obj, QEvent *event)
 
 void QDBusViewer::logError(const QString &msg)
 {
-    log->append(QLatin1String("<font color=\"red\">Error: </font>") + msg.toHtmlEscaped() + QLatin1String("<br>"));
+    log->appendEntry(QLatin1String("<font color=\"red\">Error: </font>") + msg.toHtmlEscaped() + QLatin1String("<br>"));
 }
 
 void QDBusViewer::refresh()
@@ -437,6 +441,11 @@ void QDBusViewer::connectionRequested(const BusSignature &sig)
 }
 
 void QDBusViewer::dumpMessage(const QDBusMessage &message)
+{
+    log->appendEntry([this, message]() { return formatMessage(message); });
+}
+
+QString QDBusViewer::formatMessage(const QDBusMessage &message) const
 {
     QList<QVariant> args = message.arguments();
     QString out = QLatin1String("Received ");
@@ -481,7 +490,7 @@ void QDBusViewer::dumpMessage(const QDBusMessage &message)
         out.chop(2);
     }
 
-    log->append(out);
+    return out;
 }
 
 void QDBusViewer::dumpError(const QDBusError &error)
@@ -498,9 +507,22 @@ void QDBusViewer::serviceChanged(const QModelIndex &index)
         return;
     currentService = index.data().toString();
 
-    QDBusViewModel *model = new QDBusViewModel(currentService, c);
+    QSharedPointer<QDBusModel::IntrospectionCache> &cache = introspectionCaches[currentService];
+    if (!cache)
+        cache.reset(new QDBusModel::IntrospectionCache);
+
+    QDBusViewModel *model = new QDBusViewModel(currentService, c, cache);
     tree->setModel(model);
     connect(model, &QDBusModel::busError, this, &QDBusViewer::logError);
+    model->fetchMore(QModelIndex());
+}
+
+void QDBusViewer::invalidateIntrospectionCache(const QString &service)
+{
+    // clear rather than just drop it, a model for the service may still be using it
+    const QSharedPointer<QDBusModel::IntrospectionCache> cache = introspectionCaches.take(service);
+    if (cache)
+        cache->clear();
 }
 
 void QDBusViewer::serviceRegistered(const QString &service)
@@ -523,6 +545,8 @@ static QModelIndex findItem(QStringListModel *servicesModel, const QString &name
 
 void QDBusViewer::serviceUnregistered(const QString &name)
 {
+    invalidateIntrospectionCache(name);
+
     QModelIndex hit = findItem(servicesModel, name);
     if (!hit.isValid())
         return;
@@ -532,6 +556,8 @@ void QDBusViewer::serviceUnregistered(const QString &name)
 void QDBusViewer::serviceOwnerChanged(const QString &name, const QString &oldOwner,
                                       const QString &newOwner)
 {
+    invalidateIntrospectionCache(name);
+
     QModelIndex hit = findItem(servicesModel, name);
 
     if (!hit.isValid() && oldOwner.isEmpty() && !newOwner.isEmpty())
@@ -29,10 +29,15 @@
 #ifndef QDBUSVIEWER_H
 #define QDBUSVIEWER_H
 
+#include "qdbusmodel.h"
+
 #include <QtWidgets/QWidget>
 #include <QtDBus/QDBusConnection>
+#include <QtCore/QHash>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QSharedPointer>
 
+class LogViewer;
 class ServicesProxyModel;
 
 QT_FORWARD_DECLARE_CLASS(QTableView)
@@ -87,6 +92,8 @@ private slots:
 
 private:
     void logMessage(const QString &msg);
+    QString formatMessage(const QDBusMessage &message) const;
+    void invalidateIntrospectionCache(const QString &service);
     void showEvent(QShowEvent *) override;
     bool eventFilter(QObject *obj, QEvent *event) override;
 
@@ -99,10 +106,11 @@ private:
     ServicesProxyModel *servicesProxyModel;
     QLineEdit *serviceFilterLine;
     QTableView *servicesView;
-    QTextBrowser *log;
+    LogViewer *log;
     QSplitter *topSplitter;
     QSplitter *splitter;
     QRegularExpression objectPathRegExp;
+    QHash<QString, QSharedPointer<QDBusModel::IntrospectionCache>> introspectionCaches;
 };
 
 #endif
@@ -35,6 +35,9 @@
 #include "qmlpropertynode.h"
 #include "qmltypenode.h"
 #include "sharedcommentnode.h"
+#include "tasks.h"
+
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -92,6 +95,9 @@ Aggregate::~Aggregate()
   If \a genus is either \c{Node::CPP} or \c {Node::QML}, then
   find all this node's children that have the given \a name,
   and return the one that satisfies the \a genus requirement.
+
+  This is called for nearly every link, so the candidates are
+  visited in place instead of being copied into a list.
  */
 Node *Aggregate::findChildNode(const QString &name, Node::Genus genus, int findFlags) const
 {
@@ -100,8 +106,9 @@ Node *Aggregate::findChildNode(const QString &name, Node::Genus genus, int findF
         if (node)
             return node;
     } else {
-        const NodeList &nodes = m_nonfunctionMap.values(name);
-        for (auto *node : nodes) {
+        const auto [first, last] = m_nonfunctionMap.equal_range(name);
+        for (auto it = first; it != last; ++it) {
+            Node *node = it.value();
             if (genus & node->genus()) {
                 if (findFlags & TypesOnly) {
                     if (!node->isTypedef() && !node->isClassNode() && !node->isQmlType()
@@ -161,10 +168,10 @@ void Aggregate::findChildren(const QString &name, NodeVector &nodes) const
  */
 Node *Aggregate::findNonfunctionChild(const QString &name, bool (Node::*isMatch)() const)
 {
-    const NodeList &nodes = m_nonfunctionMap.values(name);
-    for (auto *node : nodes) {
-        if ((node->*(isMatch))())
-            return node;
+    const auto [first, last] = m_nonfunctionMap.equal_range(name);
+    for (auto it = first; it != last; ++it) {
+        if ((it.value()->*(isMatch))())
+            return it.value();
     }
     return nullptr;
 }
@@ -228,14 +235,52 @@ FunctionNode *Aggregate::findFunctionChild(const FunctionNode *clone)
     return nullptr;
 }
 
+/*
+  Calls \a visit for each aggregate child that \a parent owns, that is,
+  whose parent() is \a parent. If \a parallel is \c true and qdoc runs
+  with more than one job, the children are visited on worker threads.
+
+  Nodes related to a class are also listed by their former parent, and
+  adopted functions can stay in its function map. Only passes that skip
+  the children they do not own, and modify nothing else, can therefore
+  visit the subtrees concurrently.
+ */
+template <typename Visit>
+static void forEachOwnedAggregate(const Aggregate *parent, bool parallel, Visit visit)
+{
+    std::vector<Aggregate *> children;
+    for (Node *child : parent->childNodes()) {
+        if (child->isAggregate() && child->parent() == parent)
+            children.push_back(static_cast<Aggregate *>(child));
+    }
+
+    if (!parallel) {
+        for (Aggregate *child : children)
+            visit(child);
+        return;
+    }
+    Tasks::forEach(qsizetype(children.size()), [&](qsizetype i) { visit(children[i]); });
+}
+
 /*!
   Mark all child nodes that have no documentation as having
   private access and internal status. qdoc will then ignore
   them for documentation purposes.
+
+  The subtrees of the children are processed concurrently when
+  qdoc runs with more than one job.
  */
 void Aggregate::markUndocumentedChildrenInternal()
+{
+    markUndocumentedChildrenInternal(true);
+}
+
+void Aggregate::markUndocumentedChildrenInternal(bool parallel)
 {
     for (auto *child : qAsConst(m_children)) {
+        // Related nodes are handled by the aggregate that owns them.
+        if (child->parent() != this)
+            continue;
         if (!child->isSharingComment() && !child->hasDoc() && !child->isDontDocument()) {
             if (!child->docMustBeGenerated()) {
                 if (child->isFunction()) {
@@ -249,14 +294,18 @@ void Aggregate::markUndocumentedChildrenInternal()
                 child->setStatus(Node::Internal);
             }
         }
-        if (child->isAggregate()) {
-            static_cast<Aggregate *>(child)->markUndocumentedChildrenInternal();
-        }
     }
+    forEachOwnedAggregate(this, parallel, [](Aggregate *child) {
+        child->markUndocumentedChildrenInternal(false);
+    });
 }
 
 /*!
   This is where we set the overload numbers for function nodes.
+
+  This pass stays serial. A function adopted by a related class can
+  remain in the function map of its former parent, so the overload
+  chains of two subtrees are not necessarily disjoint.
  */
 void Aggregate::normalizeOverloads()
 {
@@ -314,13 +363,26 @@ void Aggregate::normalizeOverloads()
  */
 const NodeList &Aggregate::nonfunctionList()
 {
-    m_nonfunctionList = m_nonfunctionMap.values();
-    std::sort(m_nonfunctionList.begin(), m_nonfunctionList.end(), Node::nodeNameLessThan);
-    m_nonfunctionList.erase(std::unique(m_nonfunctionList.begin(), m_nonfunctionList.end()),
-                            m_nonfunctionList.end());
+    fillNonfunctionList(m_nonfunctionList);
     return m_nonfunctionList;
 }
 
+/*!
+  Replaces the contents of \a list with the child nodes of this
+  aggregate that are not function nodes, sorted by name and without
+  duplicates. Unlike nonfunctionList(), no copy is kept in the
+  aggregate, and the capacity of \a list is reused.
+ */
+void Aggregate::fillNonfunctionList(NodeList &list) const
+{
+    list.clear();
+    list.reserve(m_nonfunctionMap.size());
+    for (auto it = m_nonfunctionMap.cbegin(); it != m_nonfunctionMap.cend(); ++it)
+        list.append(it.value());
+    std::sort(list.begin(), list.end(), Node::nodeNameLessThan);
+    list.erase(std::unique(list.begin(), list.end()), list.end());
+}
+
 /*! \fn bool Aggregate::isAggregate() const
   Returns \c true because this node is an instance of Aggregate,
   which means it can have children.
@@ -380,26 +442,33 @@ bool Aggregate::isSameSignature(const FunctionNode *f1, const FunctionNode *f2)
     const Parameters &p2 = f2->parameters();
     for (int i = 0; i < p1.count(); i++) {
         if (p1.at(i).hasType() && p2.at(i).hasType()) {
-            QString t1 = p1.at(i).type();
-            QString t2 = p2.at(i).type();
+            QStringView t1 = p1.at(i).type();
+            QStringView t2 = p2.at(i).type();
 
             if (t1.length() < t2.length())
                 qSwap(t1, t2);
+            if (t1 == t2)
+                continue;
 
             /*
               ### hack for C++ to handle superfluous
               "Foo::" prefixes gracefully
              */
-            if (t1 != t2 && t1 != (f2->parent()->name() + "::" + t2)) {
-                // Accept a difference in the template parametters of the type if one
-                // is omited (eg. "QAtomicInteger" == "QAtomicInteger<T>")
-                auto ltLoc = t1.indexOf('<');
-                auto gtLoc = t1.indexOf('>', ltLoc);
-                if (ltLoc < 0 || gtLoc < ltLoc)
-                    return false;
-                t1.remove(ltLoc, gtLoc - ltLoc + 1);
-                if (t1 != t2)
-                    return false;
+            const QStringView parentName = f2->parent()->name();
+            if (t1.size() == parentName.size() + 2 + t2.size() && t1.startsWith(parentName)
+                && t1.mid(parentName.size(), 2) == u"::" && t1.endsWith(t2)) {
+                continue;
+            }
+
+            // Accept a difference in the template parametters of the type if one
+            // is omited (eg. "QAtomicInteger" == "QAtomicInteger<T>")
+            auto ltLoc = t1.indexOf('<');
+            auto gtLoc = t1.indexOf('>', ltLoc);
+            if (ltLoc < 0 || gtLoc < ltLoc)
+                return false;
+            if (t2.size() != t1.size() - (gtLoc - ltLoc + 1) || !t2.startsWith(t1.left(ltLoc))
+                || !t2.endsWith(t1.mid(gtLoc + 1))) {
+                return false;
             }
         }
     }
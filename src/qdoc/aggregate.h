@@ -59,6 +59,7 @@ public:
     [[nodiscard]] qsizetype count() const { return m_children.size(); }
     [[nodiscard]] const NodeList &childNodes() const { return m_children; }
     const NodeList &nonfunctionList();
+    void fillNonfunctionList(NodeList &list) const;
     [[nodiscard]] NodeList::ConstIterator constBegin() const { return m_children.constBegin(); }
     [[nodiscard]] NodeList::ConstIterator constEnd() const { return m_children.constEnd(); }
 
@@ -95,6 +96,7 @@ protected:
 
 private:
     friend class Node;
+    void markUndocumentedChildrenInternal(bool parallel);
     void addFunction(FunctionNode *fn);
     void adoptFunction(FunctionNode *fn, Aggregate *firstParent);
     static bool isSameSignature(const FunctionNode *f1, const FunctionNode *f2);
@@ -0,0 +1,352 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "binaryindex.h"
+
+#include "utilities.h"
+
+#include <QtCore/qendian.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qsavefile.h>
+
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+/*
+  The binary index is a compact encoding of the element and attribute
+  structure of an XML .index file. All element names, attribute names
+  and attribute values are stored once in a string table and referred
+  to by their position in it.
+
+  The file starts with the magic bytes "QDOCBIN1", followed by the
+  number of strings and each string as its length in bytes and its
+  UTF-8 data. The rest of the file is a sequence of records, each
+  starting with a record type byte. A start element record holds the
+  string number of the element name, the number of attributes, and a
+  pair of string numbers for the name and value of each attribute. An
+  end element record has no data.
+
+  All numbers are stored as 32-bit little-endian integers. Text content
+  is dropped, as index files don't have any.
+ */
+static const char binaryIndexMagic[] = "QDOCBIN1";
+static constexpr qsizetype binaryIndexMagicSize = sizeof(binaryIndexMagic) - 1;
+enum RecordType : uchar { StartElementRecord = 1, EndElementRecord = 2 };
+
+static void appendNumber(QByteArray &data, quint32 number)
+{
+    const quint32 le = qToLittleEndian(number);
+    data.append(reinterpret_cast<const char *>(&le), sizeof(le));
+}
+
+/*!
+  Returns the path of the binary index belonging to the XML
+  index file at \a indexPath.
+ */
+QString BinaryIndex::pathForIndex(const QString &indexPath)
+{
+    QString path = indexPath;
+    if (path.endsWith(QLatin1String(".index")))
+        path.chop(6);
+    return path + QLatin1String(".qdx");
+}
+
+/*!
+  Encodes the XML index read from \a indexDevice and returns the
+  binary index. Returns an empty byte array and sets \a errorString,
+  if it is not null, if the XML cannot be read.
+ */
+QByteArray BinaryIndex::encode(QIODevice *indexDevice, QString *errorString)
+{
+    QHash<QString, quint32> ids;
+    QList<QString> strings;
+    auto intern = [&ids, &strings](QStringView string) {
+        const QString key = string.toString();
+        auto it = ids.constFind(key);
+        if (it != ids.constEnd())
+            return *it;
+        const auto id = static_cast<quint32>(strings.size());
+        strings.append(key);
+        ids.insert(key, id);
+        return id;
+    };
+
+    QByteArray records;
+    QXmlStreamReader reader(indexDevice);
+    reader.setNamespaceProcessing(false);
+    while (!reader.atEnd()) {
+        switch (reader.readNext()) {
+        case QXmlStreamReader::StartElement: {
+            records.append(char(StartElementRecord));
+            appendNumber(records, intern(reader.name()));
+            const QXmlStreamAttributes attributes = reader.attributes();
+            appendNumber(records, static_cast<quint32>(attributes.size()));
+            for (const auto &attribute : attributes) {
+                appendNumber(records, intern(attribute.qualifiedName()));
+                appendNumber(records, intern(attribute.value()));
+            }
+            break;
+        }
+        case QXmlStreamReader::EndElement:
+            records.append(char(EndElementRecord));
+            break;
+        default:
+            break;
+        }
+    }
+    if (reader.hasError()) {
+        if (errorString)
+            *errorString = reader.errorString();
+        return QByteArray();
+    }
+
+    QByteArray data(binaryIndexMagic, binaryIndexMagicSize);
+    appendNumber(data, static_cast<quint32>(strings.size()));
+    for (const auto &string : qAsConst(strings)) {
+        const QByteArray utf8 = string.toUtf8();
+        appendNumber(data, static_cast<quint32>(utf8.size()));
+        data.append(utf8);
+    }
+    data.append(records);
+    return data;
+}
+
+/*!
+  Encodes the XML index file at \a indexPath into a binary index
+  at \a binaryIndexPath. Returns \c true on success.
+ */
+bool BinaryIndex::write(const QString &indexPath, const QString &binaryIndexPath)
+{
+    QFile indexFile(indexPath);
+    if (!indexFile.open(QFile::ReadOnly))
+        return false;
+
+    QString errorString;
+    const QByteArray data = encode(&indexFile, &errorString);
+    if (data.isEmpty()) {
+        qCWarning(lcQdoc) << "Cannot encode index file" << indexPath << ":" << errorString;
+        return false;
+    }
+
+    QSaveFile binaryFile(binaryIndexPath);
+    if (!binaryFile.open(QIODevice::WriteOnly))
+        return false;
+    binaryFile.write(data);
+    return binaryFile.commit();
+}
+
+/*!
+  \class BinaryIndexReader
+  \internal
+
+  Reads a binary index written by BinaryIndex::write(). The reader
+  provides the subset of the QXmlStreamReader API used for reading
+  index files, so the same code can read either format. The strings
+  of the index are decoded once; element names and attribute values
+  share their data with the string table.
+ */
+
+/*!
+  Constructs a reader for the binary index in \a file, which must
+  be open. The file is memory-mapped if possible.
+ */
+BinaryIndexReader::BinaryIndexReader(QFile *file)
+{
+    const qint64 size = file->size();
+    const uchar *data = file->map(0, size);
+    if (!data) {
+        m_buffer = file->readAll();
+        data = reinterpret_cast<const uchar *>(m_buffer.constData());
+    }
+    init(data, size);
+}
+
+/*!
+  Constructs a reader for the binary index \a data, as returned by
+  BinaryIndex::encode().
+ */
+BinaryIndexReader::BinaryIndexReader(const QByteArray &data) : m_buffer(data)
+{
+    init(reinterpret_cast<const uchar *>(m_buffer.constData()), m_buffer.size());
+}
+
+/*!
+  Checks the magic bytes and decodes the string table of the \a size
+  bytes of binary index at \a data.
+ */
+void BinaryIndexReader::init(const uchar *data, qint64 size)
+{
+    m_pos = data;
+    m_end = data + size;
+
+    if (size < binaryIndexMagicSize || std::memcmp(data, binaryIndexMagic, binaryIndexMagicSize) != 0)
+        return;
+    m_pos += binaryIndexMagicSize;
+
+    quint32 count = 0;
+    if (!readNumber(&count))
+        return;
+    m_strings.reserve(qsizetype(qMin<quint64>(count, quint64(m_end - m_pos) / sizeof(quint32))));
+    for (quint32 i = 0; i < count; ++i) {
+        quint32 length = 0;
+        if (!readNumber(&length) || quint32(m_end - m_pos) < length)
+            return;
+        m_strings.append(QString::fromUtf8(reinterpret_cast<const char *>(m_pos), length));
+        m_pos += length;
+    }
+    m_valid = true;
+}
+
+bool BinaryIndexReader::readNumber(quint32 *number)
+{
+    if (m_end - m_pos < qsizetype(sizeof(quint32)))
+        return false;
+    *number = qFromLittleEndian<quint32>(m_pos);
+    m_pos += sizeof(quint32);
+    return true;
+}
+
+bool BinaryIndexReader::readString(quint32 *id)
+{
+    return readNumber(id) && *id < quint32(m_strings.size());
+}
+
+/*!
+  Reads the next record and returns its token type, which is either
+  QXmlStreamReader::StartElement, QXmlStreamReader::EndElement,
+  QXmlStreamReader::EndDocument at the end of the index, or
+  QXmlStreamReader::Invalid after the end or if the data is corrupt.
+ */
+QXmlStreamReader::TokenType BinaryIndexReader::readNext()
+{
+    m_attributes.clear();
+    if (!m_valid || m_token == QXmlStreamReader::EndDocument) {
+        m_token = QXmlStreamReader::Invalid;
+        return m_token;
+    }
+    if (m_pos == m_end) {
+        m_token = QXmlStreamReader::EndDocument;
+        return m_token;
+    }
+
+    m_token = QXmlStreamReader::Invalid;
+    switch (*m_pos++) {
+    case StartElementRecord: {
+        quint32 count = 0;
+        if (!readString(&m_name) || !readNumber(&count))
+            break;
+        m_attributes.reserve(count);
+        for (quint32 i = 0; i < count; ++i) {
+            quint32 key = 0, value = 0;
+            if (!readString(&key) || !readString(&value))
+                return m_token;
+            m_attributes.append(qMakePair(key, value));
+        }
+        m_token = QXmlStreamReader::StartElement;
+        break;
+    }
+    case EndElementRecord:
+        m_token = QXmlStreamReader::EndElement;
+        break;
+    default:
+        break;
+    }
+    if (m_token == QXmlStreamReader::Invalid)
+        m_valid = false;
+    return m_token;
+}
+
+/*!
+  Reads until the next start element within the current element.
+  Returns \c true when a start element was reached, and \c false
+  when the end of the current element or of the index was reached.
+ */
+bool BinaryIndexReader::readNextStartElement()
+{
+    while (true) {
+        switch (readNext()) {
+        case QXmlStreamReader::StartElement:
+            return true;
+        case QXmlStreamReader::EndElement:
+        case QXmlStreamReader::EndDocument:
+        case QXmlStreamReader::Invalid:
+            return false;
+        default:
+            break;
+        }
+    }
+}
+
+/*!
+  Reads until the end of the current element, skipping its children.
+ */
+void BinaryIndexReader::skipCurrentElement()
+{
+    int depth = 1;
+    while (depth) {
+        switch (readNext()) {
+        case QXmlStreamReader::StartElement:
+            ++depth;
+            break;
+        case QXmlStreamReader::EndElement:
+            --depth;
+            break;
+        case QXmlStreamReader::EndDocument:
+        case QXmlStreamReader::Invalid:
+            return;
+        default:
+            break;
+        }
+    }
+}
+
+/*!
+  Returns the name of the current start element.
+ */
+QStringView BinaryIndexReader::name() const
+{
+    if (m_token != QXmlStreamReader::StartElement)
+        return QStringView();
+    return m_strings.at(m_name);
+}
+
+/*!
+  Returns the attributes of the current start element.
+ */
+QXmlStreamAttributes BinaryIndexReader::attributes() const
+{
+    QXmlStreamAttributes attributes;
+    attributes.reserve(m_attributes.size());
+    for (const auto &attribute : m_attributes)
+        attributes.append(m_strings.at(attribute.first), m_strings.at(attribute.second));
+    return attributes;
+}
+
+QT_END_NAMESPACE
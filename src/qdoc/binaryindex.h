@@ -0,0 +1,83 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef BINARYINDEX_H
+#define BINARYINDEX_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qpair.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qxmlstream.h>
+
+QT_BEGIN_NAMESPACE
+
+class QFile;
+class QIODevice;
+
+namespace BinaryIndex {
+QString pathForIndex(const QString &indexPath);
+QByteArray encode(QIODevice *indexDevice, QString *errorString = nullptr);
+bool write(const QString &indexPath, const QString &binaryIndexPath);
+}
+
+class BinaryIndexReader
+{
+public:
+    explicit BinaryIndexReader(QFile *file);
+    explicit BinaryIndexReader(const QByteArray &data);
+
+    [[nodiscard]] bool isValid() const { return m_valid; }
+
+    QXmlStreamReader::TokenType readNext();
+    bool readNextStartElement();
+    void skipCurrentElement();
+    [[nodiscard]] bool isStartElement() const { return m_token == QXmlStreamReader::StartElement; }
+    [[nodiscard]] bool isEndElement() const { return m_token == QXmlStreamReader::EndElement; }
+    [[nodiscard]] QStringView name() const;
+    [[nodiscard]] QXmlStreamAttributes attributes() const;
+    void setNamespaceProcessing(bool) {}
+
+private:
+    void init(const uchar *data, qint64 size);
+    bool readNumber(quint32 *number);
+    bool readString(quint32 *id);
+
+    QByteArray m_buffer {};
+    const uchar *m_pos { nullptr };
+    const uchar *m_end { nullptr };
+    QList<QString> m_strings {};
+    QXmlStreamReader::TokenType m_token { QXmlStreamReader::NoToken };
+    quint32 m_name { 0 };
+    QList<QPair<quint32, quint32>> m_attributes {};
+    bool m_valid { false };
+};
+
+QT_END_NAMESPACE
+
+#endif // BINARYINDEX_H
@@ -48,19 +48,28 @@
 #include "namespacenode.h"
 #include "propertynode.h"
 #include "qdocdatabase.h"
+#include "tasks.h"
+#include "timings.h"
 #include "typedefnode.h"
 #include "utilities.h"
 #include "variablenode.h"
 
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatetime.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qelapsedtimer.h>
 #include <QtCore/qfile.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qscopedvaluerollback.h>
 #include <QtCore/qtemporarydir.h>
 
 #include <clang-c/Index.h>
 
+#include <algorithm>
 #include <cstdio>
+#include <future>
+#include <map>
 
 QT_BEGIN_NAMESPACE
 
@@ -74,6 +83,114 @@ static CXIndex index_ = nullptr;
 QByteArray ClangCodeParser::s_fn;
 constexpr const char *fnDummyFileName = "/fn_dummyfile.cpp";
 
+/*
+  A translation unit that was parsed by a worker thread, together
+  with the index that owns it. Both must be disposed by the consumer.
+ */
+struct PrefetchedTranslationUnit
+{
+    CXIndex index { nullptr };
+    CXTranslationUnit tu { nullptr };
+    CXErrorCode err { CXError_Failure };
+};
+
+/*
+  Parses the translation units of a list of source files ahead of
+  ClangCodeParser::parseSourceFile() on worker threads, with one
+  CXIndex per translation unit. Only the clang parse runs in
+  parallel; visiting the translation unit modifies the database and
+  still happens in parseSourceFile(), in the order the files are
+  consumed, so the output does not depend on the number of jobs.
+
+  At most \c jobs translation units are being parsed or waiting to
+  be consumed at any time.
+ */
+class TranslationUnitPrefetcher
+{
+public:
+    ~TranslationUnitPrefetcher() { clear(); }
+
+    void start(const QStringList &filePaths, int jobs, const QList<QByteArray> &args,
+               const QList<QByteArray> &argsWithoutPch, CXTranslationUnit_Flags flags)
+    {
+        clear();
+        m_pending = filePaths;
+        m_jobs = jobs;
+        m_args = args;
+        m_argsWithoutPch = argsWithoutPch;
+        m_flags = flags;
+        while (int(m_inFlight.size()) < m_jobs && !m_pending.isEmpty())
+            scheduleNext();
+    }
+
+    /*
+      Hands out the translation unit for \a filePath in \a unit and
+      schedules the next pending file. Returns \c false if \a filePath
+      was not prefetched; the caller then has to parse it itself.
+     */
+    bool take(const QString &filePath, PrefetchedTranslationUnit *unit)
+    {
+        auto it = m_inFlight.find(filePath);
+        if (it == m_inFlight.end()) {
+            m_pending.removeOne(filePath);
+            return false;
+        }
+        *unit = it->second.get();
+        m_inFlight.erase(it);
+        if (!m_pending.isEmpty())
+            scheduleNext();
+        return true;
+    }
+
+    void clear()
+    {
+        m_pending.clear();
+        for (auto &entry : m_inFlight) {
+            PrefetchedTranslationUnit unit = entry.second.get();
+            clang_disposeTranslationUnit(unit.tu);
+            clang_disposeIndex(unit.index);
+        }
+        m_inFlight.clear();
+    }
+
+private:
+    void scheduleNext()
+    {
+        const QString filePath = m_pending.takeFirst();
+        const QList<QByteArray> args = filePath.endsWith(".mm") ? m_argsWithoutPch : m_args;
+        const CXTranslationUnit_Flags flags = m_flags;
+        m_inFlight.emplace(filePath, Tasks::run([filePath, args, flags]() {
+            static QMutex indexMutex;
+            std::vector<const char *> argv;
+            argv.reserve(args.size());
+            for (const auto &arg : args)
+                argv.push_back(arg.constData());
+
+            PrefetchedTranslationUnit unit;
+            {
+                // Creating an index initializes global LLVM state.
+                QMutexLocker locker(&indexMutex);
+                unit.index = clang_createIndex(1, kClangDontDisplayDiagnostics);
+            }
+            Timings::Scope timing("clang parse", filePath);
+            Timings::count(Timings::ClangParses);
+            unit.err = clang_parseTranslationUnit2(unit.index, filePath.toLocal8Bit(),
+                                                   argv.data(), static_cast<int>(argv.size()),
+                                                   nullptr, 0, flags, &unit.tu);
+            return unit;
+        }));
+    }
+
+    QStringList m_pending {};
+    std::map<QString, std::future<PrefetchedTranslationUnit>> m_inFlight {};
+    QList<QByteArray> m_args {};
+    QList<QByteArray> m_argsWithoutPch {};
+    CXTranslationUnit_Flags m_flags { static_cast<CXTranslationUnit_Flags>(0) };
+    int m_jobs { 1 };
+};
+
+static TranslationUnitPrefetcher prefetcher_;
+
 #ifndef QT_NO_DEBUG_STREAM
 template<class T>
 static QDebug operator<<(QDebug debug, const std::vector<T> &v)
@@ -118,6 +235,21 @@ static QString fromCXString(CXString &&string)
     return ret;
 }
 
+/*!
+    Records the files included by \a tu as inputs of the current
+    project, so that the prepare stamp notices when headers found
+    through the include paths change.
+ */
+static void recordInclusions(CXTranslationUnit tu)
+{
+    clang_getInclusions(
+            tu,
+            [](CXFile file, CXSourceLocation *, unsigned, CXClientData) {
+                Config::instance().addInputFile(fromCXString(clang_getFileName(file)));
+            },
+            nullptr);
+}
+
 static QString templateDecl(CXCursor cursor);
 
 /*!
@@ -448,6 +580,32 @@ public:
         return ret ? CXChildVisit_Break : CXChildVisit_Continue;
     }
 
+    /*
+      Visits the declarations of a batch of \fn signatures that
+      start before \a limit in the main file, calling \a found with
+      the offset of each function declaration and the node found
+      for it.
+     */
+    template<typename T>
+    void visitFnArgBatch(CXCursor cursor, unsigned int limit, T &&found)
+    {
+        visitChildrenLambda(cursor, [&](CXCursor cur) {
+            auto loc = clang_getCursorLocation(cur);
+            if (!clang_Location_isFromMainFile(loc))
+                return CXChildVisit_Continue;
+            unsigned int offset = 0;
+            clang_getFileLocation(loc, nullptr, nullptr, nullptr, &offset);
+            if (offset >= limit)
+                return CXChildVisit_Continue;
+            Node *fnNode = nullptr;
+            bool ignoreSignature = false;
+            auto ret = visitFnSignature(cur, loc, &fnNode, ignoreSignature);
+            if (ret != CXChildVisit_Recurse)
+                found(offset, fnNode);
+            return ret;
+        });
+    }
+
     Node *nodeForCommentAtLocation(CXSourceLocation loc, CXSourceLocation nextCommentLoc);
 
 private:
@@ -1144,6 +1302,9 @@ void ClangCodeParser::initializeParser()
  */
 void ClangCodeParser::terminateParser()
 {
+    prefetcher_.clear();
+    m_fnArgResults.clear();
+    disposeFnArgSession();
     CppCodeParser::terminateParser();
 }
 
@@ -1342,30 +1503,64 @@ void ClangCodeParser::buildPCH()
                               "file";
             }
             m_args.push_back("-xc++");
-            CXTranslationUnit tu;
-            QString tmpHeader = m_pchFileDir->path() + "/" + module;
-            QFile tmpHeaderFile(tmpHeader);
-            if (tmpHeaderFile.open(QIODevice::Text | QIODevice::WriteOnly)) {
-                QTextStream out(&tmpHeaderFile);
-                if (header.isEmpty()) {
-                    for (auto it = m_allHeaders.constKeyValueBegin();
-                         it != m_allHeaders.constKeyValueEnd(); ++it) {
-                        if (!(*it).first.endsWith(QLatin1String("_p.h"))
-                            && !(*it).first.startsWith(QLatin1String("moc_"))) {
-                            QString line = QLatin1String("#include \"") + (*it).second
-                                    + QLatin1String("/") + (*it).first + QLatin1String("\"");
-                            out << line << "\n";
-                        }
+            QByteArray headerText;
+            if (header.isEmpty()) {
+                for (auto it = m_allHeaders.constKeyValueBegin();
+                     it != m_allHeaders.constKeyValueEnd(); ++it) {
+                    if (!(*it).first.endsWith(QLatin1String("_p.h"))
+                        && !(*it).first.startsWith(QLatin1String("moc_"))) {
+                        QString line = QLatin1String("#include \"") + (*it).second
+                                + QLatin1String("/") + (*it).first + QLatin1String("\"");
+                        headerText += line.toUtf8() + "\n";
                     }
+                }
+            } else {
+                QFileInfo headerFile(header);
+                if (!headerFile.exists()) {
+                    qWarning() << "Could not find module header file" << header;
+                    return;
+                }
+                headerText = "#include \"" + header + "\"";
+            }
+
+            QString pchDir = m_pchFileDir->path();
+            bool cached = false;
+            const QString cacheDir = Config::instance().getString(CONFIG_PCHCACHEDIR);
+            if (!cacheDir.isEmpty()) {
+                const QString keyDir = QDir(cacheDir).absoluteFilePath(
+                        QString::fromLatin1(pchCacheKey(header, headerText)));
+                if (QDir().mkpath(keyDir)) {
+                    pchDir = keyDir;
+                    cached = true;
                 } else {
-                    QFileInfo headerFile(header);
-                    if (!headerFile.exists()) {
-                        qWarning() << "Could not find module header file" << header;
-                        return;
-                    }
-                    out << QLatin1String("#include \"") + header + QLatin1String("\"");
+                    qCWarning(lcQdoc) << "Cannot create PCH cache directory" << keyDir;
+                }
+            }
+
+            const QString tmpHeader = pchDir + "/" + module;
+            const QByteArray pchName = pchDir.toUtf8() + "/" + module + ".pch";
+            CXTranslationUnit tu = nullptr;
+            if (cached && QFile::exists(QString::fromUtf8(pchName))
+                && loadCachedPCH(pchName, &tu)) {
+                m_pchName = pchName;
+                CXCursor cur = clang_getTranslationUnitCursor(tu);
+                ClangVisitor visitor(m_qdb, m_allHeaders);
+                visitor.visitChildren(cur);
+                recordInclusions(tu);
+                qCDebug(lcQdoc) << "Cached PCH" << m_pchName << "visited for" << moduleHeader();
+                clang_disposeTranslationUnit(tu);
+                m_args.pop_back(); // remove the "-xc++";
+                return;
+            }
+
+            // The header must stay where it is when the PCH is reused, as
+            // clang checks the PCH's input files for modifications.
+            QFile tmpHeaderFile(tmpHeader);
+            if (!cached || !tmpHeaderFile.exists()) {
+                if (tmpHeaderFile.open(QIODevice::Text | QIODevice::WriteOnly)) {
+                    tmpHeaderFile.write(headerText);
+                    tmpHeaderFile.close();
                 }
-                tmpHeaderFile.close();
             }
 
             CXErrorCode err =
@@ -1378,9 +1573,28 @@ void ClangCodeParser::buildPCH()
             printDiagnostics(tu);
 
             if (!err && tu) {
-                m_pchName = m_pchFileDir->path().toUtf8() + "/" + module + ".pch";
-                auto error = clang_saveTranslationUnit(tu, m_pchName.constData(),
-                                                       clang_defaultSaveOptions(tu));
+                m_pchName = pchName;
+                int error = CXSaveError_None;
+                if (cached) {
+                    // Save under a unique name first, so that other qdoc
+                    // processes sharing the cache never see a partial file.
+                    const QByteArray partialName =
+                            pchName + '.' + QByteArray::number(QCoreApplication::applicationPid());
+                    error = clang_saveTranslationUnit(tu, partialName.constData(),
+                                                      clang_defaultSaveOptions(tu));
+                    if (!error) {
+                        QFile::remove(QString::fromUtf8(pchName));
+                        if (!QFile::rename(QString::fromUtf8(partialName),
+                                           QString::fromUtf8(pchName))) {
+                            QFile::remove(QString::fromUtf8(partialName));
+                            if (!QFile::exists(QString::fromUtf8(pchName)))
+                                error = CXSaveError_Unknown;
+                        }
+                    }
+                } else {
+                    error = clang_saveTranslationUnit(tu, m_pchName.constData(),
+                                                      clang_defaultSaveOptions(tu));
+                }
                 if (error) {
                     qCCritical(lcQdoc) << "Could not save PCH file for" << moduleHeader();
                     m_pchName.clear();
@@ -1390,6 +1604,7 @@ void ClangCodeParser::buildPCH()
                     CXCursor cur = clang_getTranslationUnitCursor(tu);
                     ClangVisitor visitor(m_qdb, m_allHeaders);
                     visitor.visitChildren(cur);
+                    recordInclusions(tu);
                     qCDebug(lcQdoc) << "PCH built and visited for" << moduleHeader();
                 }
             } else {
@@ -1402,6 +1617,63 @@ void ClangCodeParser::buildPCH()
     }
 }
 
+/*!
+  Returns the name of the PCH cache subdirectory for a module header
+  built from \a headerText, where \a header is the path of the module
+  header found in the include paths, or empty if it was not found.
+
+  The key is a hash of everything that affects the precompiled header
+  and is known without parsing: the clang version, the arguments
+  including the include paths and defines, the contents of \a header,
+  and the size and modification time of each header of the module.
+ */
+QByteArray ClangCodeParser::pchCacheKey(const QByteArray &header,
+                                        const QByteArray &headerText) const
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArray::number(CINDEX_VERSION));
+    for (const char *arg : m_args) {
+        hash.addData(arg, qstrlen(arg));
+        hash.addData("\0", 1);
+    }
+    hash.addData(headerText);
+    if (!header.isEmpty()) {
+        QFile headerFile(QString::fromUtf8(header));
+        if (headerFile.open(QIODevice::ReadOnly))
+            hash.addData(headerFile.readAll());
+    }
+
+    QStringList headerStamps;
+    for (auto it = m_allHeaders.cbegin(); it != m_allHeaders.cend(); ++it) {
+        const QFileInfo fi(it.value() + QLatin1Char('/') + it.key());
+        headerStamps << fi.filePath() + QLatin1Char(' ') + QString::number(fi.size())
+                        + QLatin1Char(' ')
+                        + QString::number(fi.lastModified().toMSecsSinceEpoch());
+    }
+    headerStamps.sort();
+    hash.addData(headerStamps.join(QLatin1Char('\n')).toUtf8());
+    return hash.result().toHex();
+}
+
+/*!
+  Loads the precompiled header \a pchName from the PCH cache into
+  \a tu. Returns \c false if clang cannot load it, for example because
+  one of the headers it was built from has been modified since.
+ */
+bool ClangCodeParser::loadCachedPCH(const QByteArray &pchName, CXTranslationUnit *tu)
+{
+    CXErrorCode err = clang_createTranslationUnit2(index_, pchName.constData(), tu);
+    qCDebug(lcQdoc) << __FUNCTION__ << "clang_createTranslationUnit2(" << pchName
+                    << ") returns" << err;
+    if (err || !*tu) {
+        qCDebug(lcQdoc) << "Cached PCH" << pchName << "is out of date, rebuilding it";
+        clang_disposeTranslationUnit(*tu);
+        *tu = nullptr;
+        return false;
+    }
+    return true;
+}
+
 /*!
   Precompile the header files for the current module.
  */
@@ -1422,6 +1694,46 @@ void ClangCodeParser::precompileHeaders()
     clang_disposeIndex(index_);
 }
 
+/*!
+  Starts parsing the translation units of those \a sourceFiles that
+  this parser handles on worker threads, if more than one job was
+  requested with the \c -jobs command line option. parseSourceFile()
+  then picks up the parsed translation units instead of parsing the
+  files itself. It must be called after precompileHeaders(), and the
+  files should be passed in the order they are going to be parsed in.
+ */
+void ClangCodeParser::prefetchSourceFiles(const QStringList &sourceFiles)
+{
+    const int jobs = Config::instance().jobs();
+    if (jobs < 2)
+        return;
+
+    QStringList filePaths;
+    for (const auto &file : sourceFiles) {
+        if (CodeParser::parserForSourceFile(file) == this)
+            filePaths << file;
+    }
+    if (filePaths.size() < 2)
+        return;
+
+    QList<QByteArray> argsWithoutPch;
+    for (const char *arg : defaultArgs_)
+        argsWithoutPch.append(QByteArray(arg));
+    argsWithoutPch << m_defines;
+    QList<QByteArray> args = argsWithoutPch;
+    if (!m_pchName.isEmpty())
+        args << QByteArray("-w") << QByteArray("-include-pch") << m_pchName;
+    getMoreArgs();
+    args << m_moreArgs;
+    argsWithoutPch << m_moreArgs;
+
+    const auto flags = static_cast<CXTranslationUnit_Flags>(CXTranslationUnit_Incomplete
+                                                            | CXTranslationUnit_SkipFunctionBodies
+                                                            | CXTranslationUnit_KeepGoing);
+    qCDebug(lcQdoc) << "Parsing" << filePaths.size() << "source files with" << jobs << "jobs";
+    prefetcher_.start(filePaths, jobs, args, argsWithoutPch, flags);
+}
+
 static float getUnpatchedVersion(QString t)
 {
     if (t.count(QChar('.')) > 1)
@@ -1448,24 +1760,36 @@ void ClangCodeParser::parseSourceFile(const Location & /*location*/, const QStri
                                                   | CXTranslationUnit_SkipFunctionBodies
                                                   | CXTranslationUnit_KeepGoing);
 
-    index_ = clang_createIndex(1, kClangDontDisplayDiagnostics);
+    CXTranslationUnit tu;
+    CXErrorCode err;
+    PrefetchedTranslationUnit prefetched;
+    if (prefetcher_.take(filePath, &prefetched)) {
+        index_ = prefetched.index;
+        tu = prefetched.tu;
+        err = prefetched.err;
+        qCDebug(lcQdoc) << __FUNCTION__ << "prefetched clang_parseTranslationUnit2(" << filePath
+                        << ") returns" << err;
+    } else {
+        index_ = clang_createIndex(1, kClangDontDisplayDiagnostics);
 
-    getDefaultArgs();
-    if (!m_pchName.isEmpty() && !filePath.endsWith(".mm")) {
-        m_args.push_back("-w");
-        m_args.push_back("-include-pch");
-        m_args.push_back(m_pchName.constData());
+        getDefaultArgs();
+        if (!m_pchName.isEmpty() && !filePath.endsWith(".mm")) {
+            m_args.push_back("-w");
+            m_args.push_back("-include-pch");
+            m_args.push_back(m_pchName.constData());
+        }
+        getMoreArgs();
+        for (const auto &p : qAsConst(m_moreArgs))
+            m_args.push_back(p.constData());
+
+        Timings::Scope timing("clang parse", filePath);
+        Timings::count(Timings::ClangParses);
+        err = clang_parseTranslationUnit2(index_, filePath.toLocal8Bit(), m_args.data(),
+                                          static_cast<int>(m_args.size()), nullptr, 0, flags_,
+                                          &tu);
+        qCDebug(lcQdoc) << __FUNCTION__ << "clang_parseTranslationUnit2(" << filePath << m_args
+                        << ") returns" << err;
     }
-    getMoreArgs();
-    for (const auto &p : qAsConst(m_moreArgs))
-        m_args.push_back(p.constData());
-
-    CXTranslationUnit tu;
-    CXErrorCode err =
-            clang_parseTranslationUnit2(index_, filePath.toLocal8Bit(), m_args.data(),
-                                        static_cast<int>(m_args.size()), nullptr, 0, flags_, &tu);
-    qCDebug(lcQdoc) << __FUNCTION__ << "clang_parseTranslationUnit2(" << filePath << m_args
-                    << ") returns" << err;
     printDiagnostics(tu);
 
     if (err || !tu) {
@@ -1478,12 +1802,24 @@ void ClangCodeParser::parseSourceFile(const Location & /*location*/, const QStri
     CXCursor tuCur = clang_getTranslationUnitCursor(tu);
     ClangVisitor visitor(m_qdb, m_allHeaders);
     visitor.visitChildren(tuCur);
+    recordInclusions(tu);
 
     CXToken *tokens;
     unsigned int numTokens = 0;
     const QSet<QString> &commands = topicCommands() + metaCommands();
     clang_tokenize(tu, clang_getCursorExtent(tuCur), &tokens, &numTokens);
 
+    struct Comment
+    {
+        Doc doc;
+        QString topic;
+        QStringList namespaceScope;
+        NodeList nodes;
+        DocList docs;
+    };
+    QList<Comment> comments;
+    FnArgList fnArgs;
+
     for (unsigned int i = 0; i < numTokens; ++i) {
         if (clang_getTokenKind(tokens[i]) != CXToken_Comment)
             continue;
@@ -1501,9 +1837,8 @@ void ClangCodeParser::parseSourceFile(const Location & /*location*/, const QStri
         if (hasTooManyTopics(doc))
             continue;
 
-        DocList docs;
-        QString topic;
-        NodeList nodes;
+        Comment comment { doc, QString(), QStringList(), NodeList(), DocList() };
+        QString &topic = comment.topic;
         const TopicList &topics = doc.topicsUsed();
         if (!topics.isEmpty())
             topic = topics[0].m_topic;
@@ -1520,8 +1855,8 @@ void ClangCodeParser::parseSourceFile(const Location & /*location*/, const QStri
             }
 
             if (n) {
-                nodes.append(n);
-                docs.append(doc);
+                comment.nodes.append(n);
+                comment.docs.append(doc);
             } else if (CodeParser::isWorthWarningAbout(doc)) {
                 bool future = false;
                 if (doc.metaCommandsUsed().contains(COMMAND_SINCE)) {
@@ -1541,21 +1876,34 @@ void ClangCodeParser::parseSourceFile(const Location & /*location*/, const QStri
             }
         } else {
             // Store the namespace scope from lexical parents of the comment
-            m_namespaceScope.clear();
             CXCursor cur = clang_getCursor(tu, commentLoc);
             while (true) {
                 CXCursorKind kind = clang_getCursorKind(cur);
                 if (clang_isTranslationUnit(kind) || clang_isInvalid(kind))
                     break;
                 if (kind == CXCursor_Namespace)
-                    m_namespaceScope << fromCXString(clang_getCursorSpelling(cur));
+                    comment.namespaceScope << fromCXString(clang_getCursorSpelling(cur));
                 cur = clang_getCursorLexicalParent(cur);
             }
-            processTopicArgs(doc, topic, nodes, docs);
+            collectFnArgs(doc, topic, comment.namespaceScope, fnArgs);
         }
-        processMetaCommands(nodes, docs);
+        comments.append(comment);
     }
 
+    /*
+      Resolve all the \fn signatures of the file in one parse, then
+      process the comments in order.
+     */
+    prepareFnArgs(fnArgs);
+    for (auto &comment : comments) {
+        if (!comment.topic.isEmpty()) {
+            m_namespaceScope = comment.namespaceScope;
+            processTopicArgs(comment.doc, comment.topic, comment.nodes, comment.docs);
+        }
+        processMetaCommands(comment.nodes, comment.docs);
+    }
+    clearFnArgs();
+
     clang_disposeTokens(tu, tokens, numTokens);
     clang_disposeTranslationUnit(tu);
     clang_disposeIndex(index_);
@@ -1563,6 +1911,45 @@ void ClangCodeParser::parseSourceFile(const Location & /*location*/, const QStri
     s_fn.clear();
 }
 
+/*!
+  Returns the synthetic source that clang parses for the \fn
+  signature \a fnSignature, wrapped in the namespaces of
+  \a namespaceScope.
+ */
+static QByteArray fnArgSnippet(const QStringList &namespaceScope, const QString &fnSignature)
+{
+    QByteArray snippet;
+    for (const auto &ns : namespaceScope)
+        snippet.prepend("namespace " + ns.toUtf8() + " {");
+    snippet += fnSignature.toUtf8();
+    if (!snippet.endsWith(";"))
+        snippet += "{ }";
+    snippet.append(namespaceScope.size(), '}');
+    return snippet;
+}
+
+/*!
+  Returns \c true if the brackets in \a fnSignature are balanced, so
+  that it can't swallow the signatures following it in a batch.
+ */
+static bool hasBalancedBrackets(const QString &fnSignature)
+{
+    QString open;
+    for (const QChar c : fnSignature) {
+        if (c == QLatin1Char('(') || c == QLatin1Char('[') || c == QLatin1Char('{')) {
+            open.append(c);
+        } else if (c == QLatin1Char(')') || c == QLatin1Char(']') || c == QLatin1Char('}')) {
+            const QChar expected = c == QLatin1Char(')') ? QLatin1Char('(')
+                    : c == QLatin1Char(']')             ? QLatin1Char('[')
+                                                        : QLatin1Char('{');
+            if (open.isEmpty() || open.back() != expected)
+                return false;
+            open.chop(1);
+        }
+    }
+    return open.isEmpty();
+}
+
 /*!
   Use clang to parse the function signature from a function
   command. \a location is used for reporting errors. \a fnSignature
@@ -1616,42 +2003,14 @@ Node *ClangCodeParser::parseFnArg(const Location &location, const QString &fnSig
         }
         return fnNode;
     }
-    auto flags = static_cast<CXTranslationUnit_Flags>(CXTranslationUnit_Incomplete
-                                                      | CXTranslationUnit_SkipFunctionBodies
-                                                      | CXTranslationUnit_KeepGoing);
-
-    CXIndex index = clang_createIndex(1, kClangDontDisplayDiagnostics);
-
-    std::vector<const char *> args(std::begin(defaultArgs_), std::end(defaultArgs_));
-    // Add the defines from the qdocconf file.
-    for (const auto &p : qAsConst(m_defines))
-        args.push_back(p.constData());
-    if (!m_pchName.isEmpty()) {
-        args.push_back("-w");
-        args.push_back("-include-pch");
-        args.push_back(m_pchName.constData());
-    }
-    CXTranslationUnit tu;
-    s_fn.clear();
-    for (const auto &ns : qAsConst(m_namespaceScope))
-        s_fn.prepend("namespace " + ns.toUtf8() + " {");
-    s_fn += fnSignature.toUtf8();
-    if (!s_fn.endsWith(";"))
-        s_fn += "{ }";
-    s_fn.append(m_namespaceScope.size(), '}');
+    s_fn = fnArgSnippet(m_namespaceScope, fnSignature);
+    fnNode = m_fnArgResults.take(s_fn);
+    if (fnNode)
+        return fnNode;
 
-    const char *dummyFileName = fnDummyFileName;
-    CXUnsavedFile unsavedFile { dummyFileName, s_fn.constData(),
-                                static_cast<unsigned long>(s_fn.size()) };
-    CXErrorCode err = clang_parseTranslationUnit2(index, dummyFileName, args.data(),
-                                                  int(args.size()), &unsavedFile, 1, flags, &tu);
-    qCDebug(lcQdoc) << __FUNCTION__ << "clang_parseTranslationUnit2(" << dummyFileName << args
-                    << ") returns" << err;
-    printDiagnostics(tu);
-    if (err || !tu) {
+    CXTranslationUnit tu = parseFnBuffer();
+    if (!tu) {
         location.error(QStringLiteral("clang could not parse \\fn %1").arg(fnSignature));
-        clang_disposeTranslationUnit(tu);
-        clang_disposeIndex(index);
         return fnNode;
     } else {
         /*
@@ -1697,11 +2056,161 @@ Node *ClangCodeParser::parseFnArg(const Location &location, const QString &fnSig
             }
         }
     }
-    clang_disposeTranslationUnit(tu);
-    clang_disposeIndex(index);
     return fnNode;
 }
 
+/*!
+  Parses the \fn signatures of \a fnArgs, each paired with the
+  namespace scope of its comment, together in one synthetic
+  translation unit, and maps the function declarations back to
+  their signatures by offset. parseFnArg() then returns the nodes
+  found here without another parse. Signatures that can't be
+  resolved in the batch are left to parseFnArg(), which parses them
+  on their own and reports any errors.
+ */
+void ClangCodeParser::prepareFnArgs(const FnArgList &fnArgs)
+{
+    m_fnArgResults.clear();
+    QList<QByteArray> snippets;
+    QList<unsigned int> starts;
+    s_fn.clear();
+    for (const auto &fnArg : fnArgs) {
+        if (!hasBalancedBrackets(fnArg.second))
+            continue;
+        starts.append(unsigned(s_fn.size()));
+        snippets.append(fnArgSnippet(fnArg.first, fnArg.second));
+        s_fn += snippets.last();
+        s_fn += '\n';
+    }
+    if (snippets.size() < 2) {
+        s_fn.clear();
+        return;
+    }
+
+    CXTranslationUnit tu = parseFnBuffer();
+    if (!tu) {
+        s_fn.clear();
+        return;
+    }
+
+    /*
+      An error can derail the parsing of the signatures after it,
+      so only trust the signatures that precede the one containing
+      the first error.
+     */
+    unsigned int limit = unsigned(s_fn.size());
+    const unsigned int diagnosticCount = clang_getNumDiagnostics(tu);
+    for (unsigned int i = 0; i < diagnosticCount; ++i) {
+        CXDiagnostic diagnostic = clang_getDiagnostic(tu, i);
+        CXSourceLocation loc = clang_getDiagnosticLocation(diagnostic);
+        if (clang_getDiagnosticSeverity(diagnostic) >= CXDiagnostic_Error
+            && clang_Location_isFromMainFile(loc)) {
+            unsigned int offset = 0;
+            clang_getFileLocation(loc, nullptr, nullptr, nullptr, &offset);
+            limit = std::min(limit, offset);
+        }
+        clang_disposeDiagnostic(diagnostic);
+    }
+    auto entryAt = [&starts](unsigned int offset) {
+        return qsizetype(std::upper_bound(starts.cbegin(), starts.cend(), offset)
+                         - starts.cbegin()) - 1;
+    };
+    if (limit < unsigned(s_fn.size()))
+        limit = starts.at(std::max<qsizetype>(entryAt(limit), 0));
+
+    QList<Node *> nodes(snippets.size(), nullptr);
+    ClangVisitor visitor(m_qdb, m_allHeaders);
+    visitor.visitFnArgBatch(clang_getTranslationUnitCursor(tu), limit,
+                            [&](unsigned int offset, Node *fnNode) {
+                                const qsizetype entry = entryAt(offset);
+                                if (entry >= 0)
+                                    nodes[entry] = fnNode;
+                            });
+    for (qsizetype i = 0; i < snippets.size(); ++i) {
+        if (nodes.at(i))
+            m_fnArgResults.insert(snippets.at(i), nodes.at(i));
+    }
+    qCDebug(lcQdoc) << __FUNCTION__ << "resolved" << m_fnArgResults.size() << "of"
+                    << snippets.size() << "\\fn signatures in one parse";
+    s_fn.clear();
+}
+
+/*!
+  Parses the contents of s_fn as the dummy \fn source file. The
+  translation unit of the previous \fn command of this module is
+  reused if possible. Returns the translation unit, or \c nullptr
+  if clang could not parse it.
+ */
+CXTranslationUnit ClangCodeParser::parseFnBuffer()
+{
+    auto flags = static_cast<CXTranslationUnit_Flags>(CXTranslationUnit_Incomplete
+                                                      | CXTranslationUnit_SkipFunctionBodies
+                                                      | CXTranslationUnit_KeepGoing);
+
+    const char *dummyFileName = fnDummyFileName;
+    CXUnsavedFile unsavedFile { dummyFileName, s_fn.constData(),
+                                static_cast<unsigned long>(s_fn.size()) };
+
+    /*
+      Reuse the translation unit of the previous \fn command of this
+      module, so that the arguments are processed and the PCH is set
+      up only once. Reparsing it with the new signature is much
+      cheaper than creating a translation unit for each command.
+     */
+    if (m_fnArgTu && m_fnArgPchName != m_pchName)
+        disposeFnArgSession();
+    CXErrorCode err = CXError_Failure;
+    if (m_fnArgTu) {
+        const int result = clang_reparseTranslationUnit(m_fnArgTu, 1, &unsavedFile,
+                                                        clang_defaultReparseOptions(m_fnArgTu));
+        qCDebug(lcQdoc) << __FUNCTION__ << "clang_reparseTranslationUnit(" << dummyFileName
+                        << ") returns" << result;
+        if (result == 0)
+            err = CXError_Success;
+        else
+            disposeFnArgSession();
+    }
+    if (!m_fnArgTu) {
+        m_fnArgIndex = clang_createIndex(1, kClangDontDisplayDiagnostics);
+        std::vector<const char *> args(std::begin(defaultArgs_), std::end(defaultArgs_));
+        // Add the defines from the qdocconf file.
+        for (const auto &p : qAsConst(m_defines))
+            args.push_back(p.constData());
+        if (!m_pchName.isEmpty()) {
+            args.push_back("-w");
+            args.push_back("-include-pch");
+            args.push_back(m_pchName.constData());
+        }
+        m_fnArgPchName = m_pchName;
+        err = clang_parseTranslationUnit2(m_fnArgIndex, dummyFileName, args.data(),
+                                          int(args.size()), &unsavedFile, 1, flags, &m_fnArgTu);
+        qCDebug(lcQdoc) << __FUNCTION__ << "clang_parseTranslationUnit2(" << dummyFileName << args
+                        << ") returns" << err;
+    }
+    CXTranslationUnit tu = m_fnArgTu;
+    printDiagnostics(tu);
+    if (err || !tu) {
+        disposeFnArgSession();
+        return nullptr;
+    }
+    return tu;
+}
+
+/*!
+  Disposes of the translation unit that parseFnArg() reuses for
+  the \fn commands of a module.
+ */
+void ClangCodeParser::disposeFnArgSession()
+{
+    if (m_fnArgTu)
+        clang_disposeTranslationUnit(m_fnArgTu);
+    if (m_fnArgIndex)
+        clang_disposeIndex(m_fnArgIndex);
+    m_fnArgTu = nullptr;
+    m_fnArgIndex = nullptr;
+    m_fnArgPchName.clear();
+}
+
 void ClangCodeParser::printDiagnostics(const CXTranslationUnit &translationUnit) const
 {
     if (!lcQdocClang().isDebugEnabled())
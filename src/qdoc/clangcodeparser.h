@@ -61,7 +61,10 @@ public:
     void parseHeaderFile(const Location &location, const QString &filePath) override;
     void parseSourceFile(const Location &location, const QString &filePath) override;
     void precompileHeaders() override;
+    void prefetchSourceFiles(const QStringList &sourceFiles);
     Node *parseFnArg(const Location &location, const QString &fnSignature, const QString &idTag) override;
+    void prepareFnArgs(const FnArgList &fnArgs) override;
+    void clearFnArgs() override { m_fnArgResults.clear(); }
     static const QByteArray &fn() { return s_fn; }
 
 private:
@@ -69,8 +72,12 @@ private:
     void getMoreArgs(); // FIXME: Clean up API
 
     void buildPCH();
+    QByteArray pchCacheKey(const QByteArray &header, const QByteArray &headerText) const;
+    bool loadCachedPCH(const QByteArray &pchName, CXTranslationUnit *tu);
 
     void printDiagnostics(const CXTranslationUnit &translationUnit) const;
+    CXTranslationUnit parseFnBuffer();
+    void disposeFnArgSession();
 
     QString m_version {};
     QMultiHash<QString, QString> m_allHeaders {}; // file name->path
@@ -81,6 +88,10 @@ private:
     std::vector<const char *> m_args {};
     QList<QByteArray> m_moreArgs {};
     QStringList m_namespaceScope {};
+    void *m_fnArgIndex { nullptr };
+    CXTranslationUnit m_fnArgTu { nullptr };
+    QByteArray m_fnArgPchName {};
+    QHash<QByteArray, Node *> m_fnArgResults {}; // \fn snippet->node found by prepareFnArgs()
     static QByteArray s_fn;
 };
 
@@ -33,6 +33,7 @@
 #include "functionnode.h"
 #include "node.h"
 #include "propertynode.h"
+#include "utilities.h"
 
 #include <QtCore/qobjectdefs.h>
 
@@ -89,11 +90,17 @@ void CodeMarker::initialize()
 
 /*!
   All the code markers in the static list are terminated here.
+  This also drops the markup they cached, which refers to the
+  nodes of the current project.
  */
 void CodeMarker::terminate()
 {
-    for (const auto &marker : qAsConst(s_markers))
+    for (const auto &marker : qAsConst(s_markers)) {
         marker->terminateMarker();
+        marker->m_markedUpCode.clear();
+        marker->m_markedUpSynopses.clear();
+        marker->m_markedUpQmlItems.clear();
+    }
 }
 
 CodeMarker *CodeMarker::markerForCode(const QString &code)
@@ -231,61 +238,14 @@ QString CodeMarker::extraSynopsis(const Node *node, Section::Style style)
     return extraStr;
 }
 
-static const QString samp = QLatin1String("&amp;");
-static const QString slt = QLatin1String("&lt;");
-static const QString sgt = QLatin1String("&gt;");
-static const QString squot = QLatin1String("&quot;");
-
 QString CodeMarker::protect(const QString &str)
 {
-    qsizetype n = str.length();
-    QString marked;
-    marked.reserve(n * 2 + 30);
-    const QChar *data = str.constData();
-    for (int i = 0; i != n; ++i) {
-        switch (data[i].unicode()) {
-        case '&':
-            marked += samp;
-            break;
-        case '<':
-            marked += slt;
-            break;
-        case '>':
-            marked += sgt;
-            break;
-        case '"':
-            marked += squot;
-            break;
-        default:
-            marked += data[i];
-        }
-    }
-    return marked;
+    return Utilities::htmlEscaped(str);
 }
 
 void CodeMarker::appendProtectedString(QString *output, QStringView str)
 {
-    qsizetype n = str.length();
-    output->reserve(output->size() + n * 2 + 30);
-    const QChar *data = str.constData();
-    for (int i = 0; i != n; ++i) {
-        switch (data[i].unicode()) {
-        case '&':
-            *output += samp;
-            break;
-        case '<':
-            *output += slt;
-            break;
-        case '>':
-            *output += sgt;
-            break;
-        case '"':
-            *output += squot;
-            break;
-        default:
-            *output += data[i];
-        }
-    }
+    Utilities::appendHtmlEscaped(output, str);
 }
 
 QString CodeMarker::typified(const QString &string, bool trailingSpace)
@@ -32,6 +32,10 @@
 #include "atom.h"
 #include "sections.h"
 
+#include <QtCore/qhash.h>
+
+#include <utility>
+
 QT_BEGIN_NAMESPACE
 
 class CodeMarker
@@ -84,6 +88,12 @@ protected:
     QString taggedQmlNode(const Node *node);
     QString linkTag(const Node *node, const QString &body);
 
+    // Markup that depends only on its key, shared by all generators
+    // during a run and dropped in terminate().
+    QHash<QString, QString> m_markedUpCode;
+    QHash<std::pair<const Node *, int>, QString> m_markedUpSynopses;
+    QHash<std::pair<const Node *, bool>, QString> m_markedUpQmlItems;
+
 private:
     static QString s_defaultLang;
     static QList<CodeMarker *> s_markers;
@@ -42,6 +42,8 @@ class QDocDatabase;
 class CodeParser
 {
 public:
+    using FnArgList = QList<std::pair<QStringList, QString>>; // namespace scope, \fn signature
+
     CodeParser();
     virtual ~CodeParser();
 
@@ -57,6 +59,8 @@ public:
     {
         return nullptr;
     }
+    virtual void prepareFnArgs(const FnArgList &) {}
+    virtual void clearFnArgs() {}
 
     [[nodiscard]] const QString &currentFile() const { return m_currentFile; }
     [[nodiscard]] const QString &moduleHeader() const { return m_moduleHeader; }
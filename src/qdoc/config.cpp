@@ -27,19 +27,29 @@
 ****************************************************************************/
 
 #include "config.h"
+#include "regexpcache.h"
+#include "tasks.h"
 #include "utilities.h"
 
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdatetime.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qfile.h>
 #include <QtCore/qtemporaryfile.h>
 #include <QtCore/qtextstream.h>
+#include <QtCore/qthread.h>
 #include <QtCore/qvariant.h>
 #include <QtCore/qregularexpression.h>
 
+#include <algorithm>
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 
 QString ConfigStrings::ALIAS = QStringLiteral("alias");
 QString ConfigStrings::AUTOLINKERRORS = QStringLiteral("autolinkerrors");
+QString ConfigStrings::BINARYINDEX = QStringLiteral("binaryindex");
 QString ConfigStrings::BUILDVERSION = QStringLiteral("buildversion");
 QString ConfigStrings::CLANGDEFINES = QStringLiteral("clangdefines");
 QString ConfigStrings::CODEINDENT = QStringLiteral("codeindent");
@@ -59,6 +69,7 @@ QString ConfigStrings::EXCLUDEDIRS = QStringLiteral("excludedirs");
 QString ConfigStrings::EXCLUDEFILES = QStringLiteral("excludefiles");
 QString ConfigStrings::EXTRAIMAGES = QStringLiteral("extraimages");
 QString ConfigStrings::FALSEHOODS = QStringLiteral("falsehoods");
+QString ConfigStrings::FILELISTCACHE = QStringLiteral("filelistcache");
 QString ConfigStrings::FORMATTING = QStringLiteral("formatting");
 QString ConfigStrings::HEADERDIRS = QStringLiteral("headerdirs");
 QString ConfigStrings::HEADERS = QStringLiteral("headers");
@@ -86,10 +97,12 @@ QString ConfigStrings::MODULEHEADER = QStringLiteral("moduleheader");
 QString ConfigStrings::NATURALLANGUAGE = QStringLiteral("naturallanguage");
 QString ConfigStrings::NAVIGATION = QStringLiteral("navigation");
 QString ConfigStrings::NOLINKERRORS = QStringLiteral("nolinkerrors");
+QString ConfigStrings::OUTPUTARCHIVE = QStringLiteral("outputarchive");
 QString ConfigStrings::OUTPUTDIR = QStringLiteral("outputdir");
 QString ConfigStrings::OUTPUTFORMATS = QStringLiteral("outputformats");
 QString ConfigStrings::OUTPUTPREFIXES = QStringLiteral("outputprefixes");
 QString ConfigStrings::OUTPUTSUFFIXES = QStringLiteral("outputsuffixes");
+QString ConfigStrings::PCHCACHEDIR = QStringLiteral("pchcachedir");
 QString ConfigStrings::PROJECT = QStringLiteral("project");
 QString ConfigStrings::REDIRECTDOCUMENTATIONTODEVNULL =
         QStringLiteral("redirectdocumentationtodevnull");
@@ -284,6 +297,51 @@ void Config::clear()
     m_location = m_lastLocation = Location();
     m_configVars.clear();
     m_includeFilesMap.clear();
+    clearValueCache();
+    {
+        QMutexLocker locker(&m_inputFilesMutex);
+        m_inputFiles.clear();
+    }
+    QMutexLocker locker(&m_copiedFilesMutex);
+    m_copiedFiles.clear();
+}
+
+/*!
+  Records  filePath as read for the current project, besides the
+  header and source files: files pulled in by \include, \snippet
+  and the related commands, and the headers that clang includes.
+  May be called from any thread.
+
+  \sa inputFiles()
+ */
+void Config::addInputFile(const QString &filePath)
+{
+    if (filePath.isEmpty())
+        return;
+    QMutexLocker locker(&m_inputFilesMutex);
+    m_inputFiles.insert(filePath);
+}
+
+/*!
+  Returns the files recorded by addInputFile(), sorted.
+ */
+QStringList Config::inputFiles() const
+{
+    QMutexLocker locker(&m_inputFilesMutex);
+    QStringList result(m_inputFiles.cbegin(), m_inputFiles.cend());
+    result.sort();
+    return result;
+}
+
+/*!
+  Discards the values cached by getString() and getStringList().
+  This must be called whenever a config variable changes.
+ */
+void Config::clearValueCache()
+{
+    QMutexLocker locker(&m_valueCacheMutex);
+    m_stringCache.clear();
+    m_stringListCache.clear();
 }
 
 /*!
@@ -383,6 +441,7 @@ void Config::expandVariables()
         }
         configVar.m_expandVars.clear();
      }
+     clearValueCache();
 }
 
 /*!
@@ -391,6 +450,7 @@ void Config::expandVariables()
 void Config::setStringList(const QString &var, const QStringList &values)
 {
     m_configVars.insert(var, ConfigVar(var, values, QDir::currentPath()));
+    clearValueCache();
 }
 
 /*!
@@ -400,6 +460,7 @@ void Config::setStringList(const QString &var, const QStringList &values)
 void Config::insertStringList(const QString &var, const QStringList &values)
 {
     m_configVars[var].append(ConfigVar(var, values, QDir::currentPath()));
+    clearValueCache();
 }
 
 /*!
@@ -425,6 +486,21 @@ void Config::processCommandLineOptions(const QStringList &args)
         overrideOutputFormats.insert(format);
     m_debug = m_parser.isSet(m_parser.debugOption) || qEnvironmentVariableIsSet("QDOC_DEBUG");
     m_atomsDump = m_parser.isSet(m_parser.atomsDumpOption);
+    m_incremental = m_parser.isSet(m_parser.incrementalOption);
+    m_timings = m_parser.isSet(m_parser.timingsOption);
+    if (m_parser.isSet(m_parser.traceOption))
+        m_traceFile = QFileInfo(m_parser.value(m_parser.traceOption)).absoluteFilePath();
+    m_serverName = m_parser.value(m_parser.serverOption);
+    if (m_parser.isSet(m_parser.jobsOption)) {
+        bool ok = false;
+        const int jobs = m_parser.value(m_parser.jobsOption).toInt(&ok);
+        if (!ok || jobs < 0)
+            qCWarning(lcQdoc) << "Ignoring invalid -jobs value:"
+                              << m_parser.value(m_parser.jobsOption);
+        else
+            m_jobs = (jobs == 0) ? qMax(1, QThread::idealThreadCount()) : jobs;
+    }
+    Tasks::setJobCount(m_jobs);
     m_showInternal = m_parser.isSet(m_parser.showInternalOption)
             || qEnvironmentVariableIsSet("QDOC_SHOW_INTERNAL");
 
@@ -552,18 +628,24 @@ QSet<QString> Config::getOutputFormats() const
  */
 QString Config::getString(const QString &var, const QString &defaultString) const
 {
-    const auto &configVar = m_configVars.value(var);
+    const auto configVar = m_configVars.constFind(var);
 
-    if (configVar.m_name.isEmpty())
+    if (configVar == m_configVars.cend() || configVar->m_name.isEmpty())
         return defaultString;
-    updateLocation(configVar);
+    updateLocation(*configVar);
+
+    QMutexLocker locker(&m_valueCacheMutex);
+    const auto cached = m_stringCache.constFind(var);
+    if (cached != m_stringCache.cend())
+        return *cached;
 
     QString result(""); // an empty but non-null string
-    for (const auto &value : configVar.m_values) {
+    for (const auto &value : configVar->m_values) {
         if (!result.isEmpty() && !result.endsWith(QChar('\n')))
             result.append(QChar(' '));
         result.append(value.m_value);
     }
+    m_stringCache.insert(var, result);
     return result;
 }
 
@@ -585,12 +667,20 @@ QSet<QString> Config::getStringSet(const QString &var) const
  */
 QStringList Config::getStringList(const QString &var) const
 {
-    const auto &configVar = m_configVars.value(var);
-    updateLocation(configVar);
+    const auto configVar = m_configVars.constFind(var);
+    if (configVar == m_configVars.cend())
+        return QStringList();
+    updateLocation(*configVar);
+
+    QMutexLocker locker(&m_valueCacheMutex);
+    const auto cached = m_stringListCache.constFind(var);
+    if (cached != m_stringListCache.cend())
+        return *cached;
 
     QStringList result;
-    for (const auto &value : configVar.m_values)
+    for (const auto &value : configVar->m_values)
         result << value.m_value;
+    m_stringListCache.insert(var, result);
     return result;
 }
 
@@ -680,7 +770,7 @@ QRegularExpression Config::getRegExp(const QString &var) const
     }
     if (pattern.isEmpty())
         pattern = QLatin1String("$x"); // cannot match
-    return QRegularExpression(pattern);
+    return RegExpCache::get(pattern);
 }
 
 /*!
@@ -693,7 +783,7 @@ QList<QRegularExpression> Config::getRegExpList(const QString &var) const
     const QStringList strs = getStringList(var);
     QList<QRegularExpression> regExps;
     for (const auto &str : strs)
-        regExps += QRegularExpression(str);
+        regExps += RegExpCache::get(str);
     return regExps;
 }
 
@@ -719,6 +809,28 @@ QSet<QString> Config::subVars(const QString &var) const
     return result;
 }
 
+/*!
+  Returns a hash of the names and values of all configuration
+  variables, together with the directories the values were read
+  relative to. The hash changes whenever the loaded configuration
+  does.
+ */
+QByteArray Config::hash() const
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (auto it = m_configVars.constBegin(); it != m_configVars.constEnd(); ++it) {
+        hash.addData(it.key().toUtf8());
+        for (const auto &value : it.value().m_values) {
+            hash.addData("\0", 1);
+            hash.addData(value.m_value.toUtf8());
+            hash.addData("\0", 1);
+            hash.addData(value.m_path.toUtf8());
+        }
+        hash.addData("\n", 1);
+    }
+    return hash.result().toHex();
+}
+
 /*!
   Searches for a path to \a fileName in 'sources', 'sourcedirs', and
   'exampledirs' config variables and returns a full path to the first
@@ -776,56 +888,6 @@ QStringList Config::getAllFiles(const QString &filesVar, const QString &dirsVar,
     return result;
 }
 
-QStringList Config::getExampleQdocFiles(const QSet<QString> &excludedDirs,
-                                        const QSet<QString> &excludedFiles)
-{
-    QStringList result;
-    const QStringList dirs = getCanonicalPathList("exampledirs");
-    const QString nameFilter = " *.qdoc";
-
-    for (const auto &dir : dirs)
-        result += getFilesHere(dir, nameFilter, location(), excludedDirs, excludedFiles);
-    return result;
-}
-
-QStringList Config::getExampleImageFiles(const QSet<QString> &excludedDirs,
-                                         const QSet<QString> &excludedFiles)
-{
-    QStringList result;
-    const QStringList dirs = getCanonicalPathList("exampledirs");
-    const QString nameFilter = getString(CONFIG_EXAMPLES + dot + CONFIG_IMAGEEXTENSIONS);
-
-    for (const auto &dir : dirs)
-        result += getFilesHere(dir, nameFilter, location(), excludedDirs, excludedFiles);
-    return result;
-}
-
-/*!
-    Returns the path to the project file for \a examplePath, or an empty string
-    if no project file was found.
- */
-QString Config::getExampleProjectFile(const QString &examplePath)
-{
-    QFileInfo fileInfo(examplePath);
-    QStringList validNames;
-    validNames << fileInfo.fileName() + QLatin1String(".pro")
-               << fileInfo.fileName() + QLatin1String(".qmlproject")
-               << fileInfo.fileName() + QLatin1String(".pyproject")
-               << QLatin1String("CMakeLists.txt")
-               << QLatin1String("qbuild.pro"); // legacy
-
-    QString projectFile;
-
-    for (const auto &name : qAsConst(validNames)) {
-        projectFile = Config::findFile(Location(), m_exampleFiles, m_exampleDirs,
-                                       examplePath + QLatin1Char('/') + name);
-        if (!projectFile.isEmpty())
-            return projectFile;
-    }
-
-    return projectFile;
-}
-
 /*!
   \a fileName is the path of the file to find.
 
@@ -911,17 +973,17 @@ QString Config::findFile(const Location &location, const QStringList &files,
   \a userFriendlySourceFilePath. \a location is for identifying
   the file and line number where a qdoc error occurred. The
   constructed output file name is returned.
+
+  If the output file already exists with the size of the source
+  file and is not older than it, or has the same content, it is not
+  written again. A file that was already copied to the same output
+  file for the current project is not looked at again either.
+
+  This function can be called on worker threads.
  */
 QString Config::copyFile(const Location &location, const QString &sourceFilePath,
                          const QString &userFriendlySourceFilePath, const QString &targetDirPath)
 {
-    QFile inFile(sourceFilePath);
-    if (!inFile.open(QFile::ReadOnly)) {
-        location.warning(QStringLiteral("Cannot open input file for copy: '%1': %2")
-                                 .arg(sourceFilePath, inFile.errorString()));
-        return QString();
-    }
-
     QString outFileName = userFriendlySourceFilePath;
     qsizetype slash = outFileName.lastIndexOf(QLatin1Char('/'));
     if (slash != -1)
@@ -930,10 +992,63 @@ QString Config::copyFile(const Location &location, const QString &sourceFilePath
         outFileName = targetDirPath + QLatin1Char('/') + outFileName;
     else
         outFileName = targetDirPath + outFileName;
+
+    Config &config = Config::instance();
+    {
+        QMutexLocker locker(&config.m_copiedFilesMutex);
+        auto copied = config.m_copiedFiles.find(outFileName);
+        while (copied != config.m_copiedFiles.end() && !copied->m_done) {
+            config.m_copiedFileDone.wait(&config.m_copiedFilesMutex);
+            copied = config.m_copiedFiles.find(outFileName);
+        }
+        if (copied != config.m_copiedFiles.end() && copied->m_source == sourceFilePath)
+            return outFileName;
+        config.m_copiedFiles.insert(outFileName, CopiedFile{sourceFilePath, false});
+    }
+    // Records the outcome and wakes up the callers waiting for the same file.
+    const auto finish = [&config, &outFileName](bool ok) {
+        QMutexLocker locker(&config.m_copiedFilesMutex);
+        if (ok)
+            config.m_copiedFiles[outFileName].m_done = true;
+        else
+            config.m_copiedFiles.remove(outFileName);
+        config.m_copiedFileDone.wakeAll();
+    };
+
+    QFile inFile(sourceFilePath);
+    if (!inFile.open(QFile::ReadOnly)) {
+        location.warning(QStringLiteral("Cannot open input file for copy: '%1': %2")
+                                 .arg(sourceFilePath, inFile.errorString()));
+        finish(false);
+        return QString();
+    }
+
+    // Leave a copy from an earlier run alone if the source hasn't changed since.
+    // A source that was only touched is compared with the copy, so that the
+    // copy keeps its modification time.
+    const QFileInfo sourceInfo(sourceFilePath);
+    const QFileInfo targetInfo(outFileName);
+    if (targetInfo.isFile() && targetInfo.size() == sourceInfo.size()) {
+        if (targetInfo.lastModified() >= sourceInfo.lastModified()) {
+            finish(true);
+            return outFileName;
+        }
+        QFile copy(outFileName);
+        if (copy.open(QFile::ReadOnly)) {
+            const QByteArray content = inFile.readAll();
+            if (copy.readAll() == content) {
+                finish(true);
+                return outFileName;
+            }
+            inFile.seek(0);
+        }
+    }
+
     QFile outFile(outFileName);
     if (!outFile.open(QFile::WriteOnly)) {
         location.warning(QStringLiteral("Cannot open output file for copy: '%1': %2")
                                  .arg(outFileName, outFile.errorString()));
+        finish(false);
         return QString();
     }
 
@@ -941,6 +1056,8 @@ QString Config::copyFile(const Location &location, const QString &sourceFilePath
     qsizetype len;
     while ((len = inFile.read(buffer, sizeof(buffer))) > 0)
         outFile.write(buffer, len);
+    outFile.close();
+    finish(true);
     return outFileName;
 }
 
@@ -1000,11 +1117,169 @@ QStringList Config::loadMaster(const QString &fileName)
     return qdocFiles;
 }
 
+/*
+  An include statement or an assignment to one or more config
+  variables, as parsed from a qdoc configuration file. The line
+  and column refer to the included file name or to the key.
+ */
+struct ParsedStatement
+{
+    bool m_include { false };
+    QString m_includeFile {};
+    QStringList m_keys {};
+    QStringList m_values {};
+    QList<ExpandVar> m_expandVars {};
+    bool m_plus { false };
+    int m_lineNo {};
+    int m_columnNo {};
+};
+
+/*
+  The statements of a qdoc configuration file, the modification
+  time and size of the file they were parsed from, and the values
+  of the environment variables that were read while parsing it.
+  A null value means that the variable was not set.
+ */
+struct ParsedFile
+{
+    qint64 m_modified { -1 };
+    qint64 m_size { -1 };
+    QMap<QString, QByteArray> m_environment {};
+    QList<ParsedStatement> m_statements {};
+
+    [[nodiscard]] bool isCurrent(const QFileInfo &fileInfo) const
+    {
+        if (fileInfo.lastModified().toMSecsSinceEpoch() != m_modified
+            || fileInfo.size() != m_size)
+            return false;
+        for (auto it = m_environment.cbegin(); it != m_environment.cend(); ++it) {
+            const QByteArray value = qgetenv(it.key().toLatin1().constData());
+            if (value.isNull() != it->isNull() || value != *it)
+                return false;
+        }
+        return true;
+    }
+};
+
+static const quint32 s_parsedFileCacheMagic = 0x51444343; // "QDCC"
+static const quint32 s_parsedFileCacheVersion = 1;
+
+static QHash<QString, ParsedFile> s_parsedFiles;
+static QString s_parsedFileCacheFile;
+static bool s_parsedFileCacheLoaded = false;
+static bool s_parsedFileCacheDirty = false;
+
+/*
+  Loads the parsed qdoc configuration files stored in the file
+  named by the QDOC_CONFIGCACHE environment variable, once per run.
+ */
+static void loadParsedFileCache()
+{
+    if (s_parsedFileCacheLoaded)
+        return;
+    s_parsedFileCacheLoaded = true;
+    s_parsedFileCacheFile = qEnvironmentVariable("QDOC_CONFIGCACHE");
+    if (s_parsedFileCacheFile.isEmpty())
+        return;
+
+    QFile file(s_parsedFileCacheFile);
+    if (!file.open(QFile::ReadOnly))
+        return;
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != s_parsedFileCacheMagic || version != s_parsedFileCacheVersion)
+        return;
+    qint32 count = 0;
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString filePath;
+        ParsedFile parsed;
+        qint32 statements = 0;
+        in >> filePath >> parsed.m_modified >> parsed.m_size >> parsed.m_environment
+           >> statements;
+        for (qint32 j = 0; j < statements && in.status() == QDataStream::Ok; ++j) {
+            ParsedStatement statement;
+            qint32 expandVars = 0;
+            in >> statement.m_include >> statement.m_includeFile >> statement.m_keys
+               >> statement.m_values >> statement.m_plus >> statement.m_lineNo
+               >> statement.m_columnNo >> expandVars;
+            for (qint32 k = 0; k < expandVars && in.status() == QDataStream::Ok; ++k) {
+                qint32 valueIndex = 0;
+                qint32 index = 0;
+                QString var;
+                QChar delim;
+                in >> valueIndex >> index >> var >> delim;
+                statement.m_expandVars << ExpandVar(valueIndex, index, var, delim);
+            }
+            parsed.m_statements << statement;
+        }
+        s_parsedFiles.insert(filePath, parsed);
+    }
+    if (in.status() != QDataStream::Ok)
+        s_parsedFiles.clear();
+}
+
+/*!
+  Writes the qdoc configuration files parsed by load() to the file
+  named by the \c QDOC_CONFIGCACHE environment variable, if any of
+  them was parsed since the file was loaded.
+ */
+void Config::writeParsedFileCache()
+{
+    if (!s_parsedFileCacheDirty || s_parsedFileCacheFile.isEmpty())
+        return;
+    s_parsedFileCacheDirty = false;
+
+    // Files modified in the last seconds may be modified again
+    // without a visible change of their modification time.
+    const qint64 racy = QDateTime::currentMSecsSinceEpoch() - 2000;
+    QTemporaryFile file(s_parsedFileCacheFile + QLatin1String(".XXXXXX"));
+    if (!file.open())
+        return;
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << s_parsedFileCacheMagic << s_parsedFileCacheVersion;
+    qint32 count = 0;
+    for (const auto &parsed : qAsConst(s_parsedFiles)) {
+        if (parsed.m_modified < racy)
+            ++count;
+    }
+    out << count;
+    for (auto it = s_parsedFiles.cbegin(); it != s_parsedFiles.cend(); ++it) {
+        if (it->m_modified >= racy)
+            continue;
+        out << it.key() << it->m_modified << it->m_size << it->m_environment
+            << qint32(it->m_statements.size());
+        for (const auto &statement : it->m_statements) {
+            out << statement.m_include << statement.m_includeFile << statement.m_keys
+                << statement.m_values << statement.m_plus << statement.m_lineNo
+                << statement.m_columnNo << qint32(statement.m_expandVars.size());
+            for (const auto &expandVar : statement.m_expandVars) {
+                out << qint32(expandVar.m_valueIndex) << qint32(expandVar.m_index)
+                    << expandVar.m_var << expandVar.m_delim;
+            }
+        }
+    }
+    file.close();
+    QFile::remove(s_parsedFileCacheFile);
+    if (file.rename(s_parsedFileCacheFile))
+        file.setAutoRemove(false);
+}
+
 /*!
   Load, parse, and process a qdoc configuration file. This
   function is only called by the other load() function, but
   this one is recursive, i.e., it calls itself when it sees
   an \c{include} statement in the qdoc configuration file.
+
+  The statements of each file are kept for the rest of the run,
+  and are processed again without parsing the file as long as
+  neither the file nor the environment variables it refers to
+  have changed. If the \c QDOC_CONFIGCACHE environment variable
+  names a file, they are also kept between runs.
  */
 void Config::load(Location location, const QString &fileName)
 {
@@ -1045,15 +1320,63 @@ void Config::load(Location location, const QString &fileName)
                     QStringLiteral("Cannot open file '%1': %2").arg(fileName, fin.errorString()));
     }
 
+    location.push(fileName);
+    location.start();
+
+    const auto process = [this, &location](const ParsedStatement &statement) {
+        Location statementLoc = location;
+        statementLoc.setLineNo(statement.m_lineNo);
+        statementLoc.setColumnNo(statement.m_columnNo);
+        if (statement.m_include) {
+            /*
+              Here is the recursive call.
+             */
+            load(statementLoc, statement.m_includeFile);
+            return;
+        }
+        for (const auto &key : statement.m_keys) {
+            ConfigVar configVar(key, statement.m_values, QDir::currentPath(), statementLoc,
+                                statement.m_expandVars);
+            if (statement.m_plus && m_configVars.contains(key)) {
+                m_configVars[key].append(configVar);
+            } else {
+                m_configVars.insert(key, configVar);
+            }
+        }
+        clearValueCache();
+    };
+
+    loadParsedFileCache();
+    const QFileInfo openedFile(fin.fileName());
+    const QString cacheKey = openedFile.absoluteFilePath();
+    const auto cached = s_parsedFiles.constFind(cacheKey);
+    if (cached != s_parsedFiles.cend() && cached->isCurrent(openedFile)) {
+        fin.close();
+        // The include statements may update the cache
+        const QList<ParsedStatement> statements = cached->m_statements;
+        for (const auto &statement : statements)
+            process(statement);
+        popWorkingDir();
+        if (!m_workingDirs.isEmpty())
+            QDir::setCurrent(m_workingDirs.top());
+        return;
+    }
+
+    ParsedFile parsed;
+    parsed.m_modified = openedFile.lastModified().toMSecsSinceEpoch();
+    parsed.m_size = openedFile.size();
+    const auto getEnv = [&parsed](const QString &var) {
+        const QByteArray value = qgetenv(var.toLatin1().constData());
+        parsed.m_environment.insert(var, value);
+        return value;
+    };
+
     QTextStream stream(&fin);
     QString text = stream.readAll();
     text += QLatin1String("\n\n");
     text += QLatin1Char('\0');
     fin.close();
 
-    location.push(fileName);
-    location.start();
-
     int i = 0;
     QChar c = text.at(0);
     uint cc = c.unicode();
@@ -1102,7 +1425,7 @@ void Config::load(Location location, const QString &fileName)
                             SKIP_CHAR();
                         }
                         if (!var.isEmpty()) {
-                            const QByteArray val = qgetenv(var.toLatin1().data());
+                            const QByteArray val = getEnv(var);
                             if (val.isNull()) {
                                 location.fatal(QStringLiteral("Environment variable '%1' undefined")
                                                        .arg(var));
@@ -1123,10 +1446,13 @@ void Config::load(Location location, const QString &fileName)
                 if (cc != '#' && cc != '\n')
                     location.fatal(QStringLiteral("Trailing garbage"));
 
-                /*
-                  Here is the recursive call.
-                 */
-                load(location, QFileInfo(QDir(path), includeFile).filePath());
+                ParsedStatement statement;
+                statement.m_include = true;
+                statement.m_includeFile = QFileInfo(QDir(path), includeFile).filePath();
+                statement.m_lineNo = location.lineNo();
+                statement.m_columnNo = location.columnNo();
+                parsed.m_statements << statement;
+                process(statement);
             } else {
                 /*
                   It wasn't an include statement, so it's something else.
@@ -1209,7 +1535,7 @@ void Config::load(Location location, const QString &fileName)
                                 location.fatal(QStringLiteral("Missing '}'"));
                         }
                         if (!var.isEmpty()) {
-                            const QByteArray val = qgetenv(var.toLatin1().constData());
+                            const QByteArray val = getEnv(var);
                             if (val.isNull()) {
                                 expandVars << ExpandVar(rhsValues.size(), word.size(), var, delim);
                                 needsExpansion = true;
@@ -1230,19 +1556,23 @@ void Config::load(Location location, const QString &fileName)
                 for (const auto &key : keys) {
                     if (!keySyntax.match(key).hasMatch())
                         keyLoc.fatal(QStringLiteral("Invalid key '%1'").arg(key));
-
-                    ConfigVar configVar(key, rhsValues, QDir::currentPath(), keyLoc, expandVars);
-                    if (plus && m_configVars.contains(key)) {
-                        m_configVars[key].append(configVar);
-                    } else {
-                        m_configVars.insert(key, configVar);
-                    }
                 }
+                ParsedStatement statement;
+                statement.m_keys = keys;
+                statement.m_values = rhsValues;
+                statement.m_expandVars = expandVars;
+                statement.m_plus = plus;
+                statement.m_lineNo = keyLoc.lineNo();
+                statement.m_columnNo = keyLoc.columnNo();
+                parsed.m_statements << statement;
+                process(statement);
             }
         } else {
             location.fatal(QStringLiteral("Unexpected character '%1' at beginning of line").arg(c));
         }
     }
+    s_parsedFiles.insert(cacheKey, parsed);
+    s_parsedFileCacheDirty = true;
     popWorkingDir();
     if (!m_workingDirs.isEmpty())
         QDir::setCurrent(m_workingDirs.top());
@@ -1252,7 +1582,8 @@ bool Config::isFileExcluded(const QString &fileName, const QSet<QString> &exclud
 {
     for (const QString &entry : excludedFiles) {
         if (entry.contains(QLatin1Char('*')) || entry.contains(QLatin1Char('?'))) {
-            QRegularExpression re(QRegularExpression::wildcardToRegularExpression(entry));
+            const QRegularExpression re =
+                    RegExpCache::get(QRegularExpression::wildcardToRegularExpression(entry));
             if (re.match(fileName).hasMatch())
                 return true;
         }
@@ -1260,40 +1591,448 @@ bool Config::isFileExcluded(const QString &fileName, const QSet<QString> &exclud
     return excludedFiles.contains(fileName);
 }
 
+/*
+  The names of the files and of the subdirectories of a directory,
+  as read by getFilesHere(), and the modification time of the
+  directory when they were read. Adding, removing or renaming an
+  entry updates the modification time, so the names can be reused
+  for as long as it does not change.
+ */
+struct DirectoryListing
+{
+    qint64 m_modified { -1 };
+    QStringList m_files {};
+    QStringList m_dirs {};
+};
+
+struct DirectoryScan
+{
+    QString m_dir {};
+    bool m_excluded { false };
+    bool m_updated { false };
+    DirectoryListing m_listing {};
+};
+
+static const quint32 s_fileListCacheMagic = 0x51444c43; // "QDLC"
+static const quint32 s_fileListCacheVersion = 1;
+
+static QHash<QString, DirectoryListing> s_directoryListings;
+static QSet<QString> s_checkedDirectories;
+static QString s_fileListCacheFile;
+static bool s_fileListCacheDirty = false;
+
+/*
+  The directory trees below the exampledirs, listed by a single scan
+  that the functions returning example files share. The scan is
+  repeated if the exampledirs or the excluded directories change.
+ */
+struct ExampleTree
+{
+    bool m_scanned { false };
+    QStringList m_roots {};
+    QSet<QString> m_excludedDirs {};
+    QHash<QString, DirectoryScan> m_scans {};
+};
+
+static ExampleTree s_exampleTree;
+
+/*
+  Loads the directory listings stored in the file named by the
+  filelistcache variable, unless they are loaded already.
+ */
+static void loadFileListCache()
+{
+    const QString fileName = Config::instance().getString(CONFIG_FILELISTCACHE);
+    if (fileName == s_fileListCacheFile)
+        return;
+    Config::writeFileListCache();
+    s_fileListCacheFile = fileName;
+    s_directoryListings.clear();
+    s_checkedDirectories.clear();
+    s_exampleTree = ExampleTree();
+    if (fileName.isEmpty())
+        return;
+
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly))
+        return;
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != s_fileListCacheMagic || version != s_fileListCacheVersion)
+        return;
+    qint32 count = 0;
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString dir;
+        DirectoryListing listing;
+        in >> dir >> listing.m_modified >> listing.m_files >> listing.m_dirs;
+        s_directoryListings.insert(dir, listing);
+    }
+    if (in.status() != QDataStream::Ok)
+        s_directoryListings.clear();
+}
+
+/*!
+  Writes the directory listings read by getFilesHere() to the file
+  named by the \c filelistcache variable, if any listing was read
+  from disk since the file was loaded.
+ */
+void Config::writeFileListCache()
+{
+    if (!s_fileListCacheDirty || s_fileListCacheFile.isEmpty())
+        return;
+    s_fileListCacheDirty = false;
+
+    // Directories modified in the last seconds may be modified again
+    // without a visible change of their modification time.
+    const qint64 racy = QDateTime::currentMSecsSinceEpoch() - 2000;
+    QTemporaryFile file(s_fileListCacheFile + QLatin1String(".XXXXXX"));
+    if (!file.open())
+        return;
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << s_fileListCacheMagic << s_fileListCacheVersion;
+    qint32 count = 0;
+    for (const auto &listing : qAsConst(s_directoryListings)) {
+        if (listing.m_modified < racy)
+            ++count;
+    }
+    out << count;
+    for (auto it = s_directoryListings.cbegin(); it != s_directoryListings.cend(); ++it) {
+        if (it->m_modified < racy)
+            out << it.key() << it->m_modified << it->m_files << it->m_dirs;
+    }
+    file.close();
+    QFile::remove(s_fileListCacheFile);
+    if (file.rename(s_fileListCacheFile))
+        file.setAutoRemove(false);
+}
+
+/*
+  Resolves \a uncleanDir the way getFilesHere() does and lists it,
+  unless it is in \a excludedDirs. The listing is taken from the
+  cache if the directory has not been modified since it was read.
+  This runs on worker threads and only reads the cache.
+ */
+static DirectoryScan scanDirectory(const QString &uncleanDir, bool canonical,
+                                   const QSet<QString> &excludedDirs)
+{
+    DirectoryScan scan;
+    scan.m_dir = canonical ? QDir(uncleanDir).canonicalPath() : QDir::cleanPath(uncleanDir);
+    if (excludedDirs.contains(scan.m_dir)) {
+        scan.m_excluded = true;
+        return scan;
+    }
+
+    const auto cached = s_directoryListings.constFind(scan.m_dir);
+    if (cached != s_directoryListings.constEnd() && s_checkedDirectories.contains(scan.m_dir)) {
+        scan.m_listing = *cached;
+        return scan;
+    }
+
+    const qint64 modified = QFileInfo(scan.m_dir).lastModified().toMSecsSinceEpoch();
+    if (cached != s_directoryListings.constEnd() && cached->m_modified == modified) {
+        scan.m_listing = *cached;
+    } else {
+        QDir dirInfo(scan.m_dir);
+        scan.m_listing.m_modified = modified;
+        scan.m_listing.m_files = dirInfo.entryList(QDir::Files, QDir::Name);
+        scan.m_listing.m_dirs = dirInfo.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+    }
+    scan.m_updated = true;
+    return scan;
+}
+
+/*
+  Lists the directory trees below \a uncleanDirs breadth-first. The
+  directories of each level are listed in parallel, on up to as many
+  threads as given by \c -jobs. Returns the scans keyed by the path
+  they were requested with.
+ */
+static QHash<QString, DirectoryScan> scanDirectoryTree(const QStringList &uncleanDirs,
+                                                      bool canonical,
+                                                      const QSet<QString> &excludedDirs)
+{
+    QHash<QString, DirectoryScan> scans;
+    QStringList level = uncleanDirs;
+    level.removeDuplicates();
+
+    while (!level.isEmpty()) {
+        QList<DirectoryScan> results(level.size());
+        Tasks::forEach(level.size(), [&](qsizetype i) {
+            results[i] = scanDirectory(level.at(i), canonical, excludedDirs);
+        });
+
+        // Only update the cache once no worker reads it anymore.
+        QStringList nextLevel;
+        for (qsizetype i = 0; i < level.size(); ++i) {
+            DirectoryScan &scan = results[i];
+            if (scan.m_updated) {
+                if (!s_checkedDirectories.contains(scan.m_dir)) {
+                    auto &stored = s_directoryListings[scan.m_dir];
+                    if (stored.m_modified != scan.m_listing.m_modified
+                        || stored.m_files != scan.m_listing.m_files
+                        || stored.m_dirs != scan.m_listing.m_dirs) {
+                        stored = scan.m_listing;
+                        s_fileListCacheDirty = true;
+                    }
+                    s_checkedDirectories.insert(scan.m_dir);
+                }
+            }
+            if (!scan.m_excluded) {
+                QDir dirInfo(scan.m_dir);
+                for (const auto &subDir : qAsConst(scan.m_listing.m_dirs)) {
+                    const QString path = dirInfo.filePath(subDir);
+                    if (!scans.contains(path))
+                        nextLevel.append(path);
+                }
+            }
+            scans.insert(level.at(i), std::move(scan));
+        }
+        nextLevel.removeDuplicates();
+        level = std::move(nextLevel);
+    }
+    return scans;
+}
+
+/*
+  Returns the expressions for the space-separated wildcards in
+  \a nameFilter.
+ */
+static QList<QRegularExpression> nameFilterExpressions(const QString &nameFilter)
+{
+    QList<QRegularExpression> nameFilters;
+    const QStringList wildcards = nameFilter.split(QLatin1Char(' '));
+    for (const auto &wildcard : wildcards) {
+        const QString pattern = QRegularExpression::wildcardToRegularExpression(wildcard);
+        nameFilters.append(RegExpCache::get(pattern, QRegularExpression::CaseInsensitiveOption));
+    }
+    return nameFilters;
+}
+
+/*
+  Appends the files of the directory \a dirInfo, as listed in \a scan,
+  that match \a nameFilters and are not in \a excludedFiles to \a result.
+ */
+static void appendMatchingFiles(const QDir &dirInfo, const DirectoryScan &scan,
+                                const QList<QRegularExpression> &nameFilters,
+                                const QSet<QString> &excludedFiles, QStringList &result)
+{
+    for (const auto &file : scan.m_listing.m_files) {
+        if (file.startsWith(QLatin1Char('~')))
+            continue;
+        if (std::none_of(nameFilters.cbegin(), nameFilters.cend(),
+                         [&file](const QRegularExpression &re) {
+                             return re.match(file).hasMatch();
+                         }))
+            continue;
+        QString c = QDir::cleanPath(dirInfo.filePath(file));
+        if (!Config::isFileExcluded(c, excludedFiles))
+            result.append(c);
+    }
+}
+
+/*
+  Appends the files of the scanned directory \a uncleanDir that match
+  \a nameFilters, and then those of its subdirectories, to \a result.
+  This is the order in which the recursive walk used to find them.
+ */
+static void collectFiles(const QHash<QString, DirectoryScan> &scans, const QString &uncleanDir,
+                         const QList<QRegularExpression> &nameFilters,
+                         const QSet<QString> &excludedFiles, QStringList &result)
+{
+    const auto it = scans.constFind(uncleanDir);
+    if (it == scans.constEnd() || it->m_excluded)
+        return;
+
+    QDir dirInfo(it->m_dir);
+    appendMatchingFiles(dirInfo, *it, nameFilters, excludedFiles, result);
+
+    for (const auto &subDir : it->m_listing.m_dirs)
+        collectFiles(scans, dirInfo.filePath(subDir), nameFilters, excludedFiles, result);
+}
+
+/*
+  Collects the files below \a uncleanDir from \a scans like collectFiles(),
+  but the way getFilesHere() finds them without resolving canonical paths,
+  and skipping the directories in \a excludedDirs. Returns \c false if the
+  scans cannot tell, because a directory was not scanned, was resolved to
+  another path, or was excluded from the scans but not by \a excludedDirs.
+ */
+static bool collectUncanonicalFiles(const QHash<QString, DirectoryScan> &scans,
+                                    const QString &uncleanDir,
+                                    const QList<QRegularExpression> &nameFilters,
+                                    const QSet<QString> &excludedDirs,
+                                    const QSet<QString> &excludedFiles, QStringList &result)
+{
+    const QString dir = QDir::cleanPath(uncleanDir);
+    if (excludedDirs.contains(dir))
+        return true;
+    const auto it = scans.constFind(uncleanDir);
+    if (it == scans.constEnd() || it->m_excluded || it->m_dir != dir)
+        return false;
+
+    QDir dirInfo(dir);
+    appendMatchingFiles(dirInfo, *it, nameFilters, excludedFiles, result);
+
+    for (const auto &subDir : it->m_listing.m_dirs) {
+        if (!collectUncanonicalFiles(scans, dirInfo.filePath(subDir), nameFilters, excludedDirs,
+                                     excludedFiles, result))
+            return false;
+    }
+    return true;
+}
+
+/*
+  Returns the tree below the canonical exampledirs \a roots, scanning
+  it unless it was already scanned with the same \a excludedDirs.
+ */
+static const ExampleTree &exampleTree(const QStringList &roots, const QSet<QString> &excludedDirs)
+{
+    loadFileListCache();
+    if (!s_exampleTree.m_scanned || s_exampleTree.m_roots != roots
+        || s_exampleTree.m_excludedDirs != excludedDirs) {
+        s_exampleTree.m_scanned = true;
+        s_exampleTree.m_roots = roots;
+        s_exampleTree.m_excludedDirs = excludedDirs;
+        s_exampleTree.m_scans = scanDirectoryTree(roots, true, excludedDirs);
+    }
+    return s_exampleTree;
+}
+
+/*!
+  Returns the files below \a uncleanDir, and in its subdirectories,
+  whose names match one of the space-separated wildcards in
+  \a nameFilter. Directories in \a excludedDirs are skipped, as are
+  the files in \a excludedFiles. If \a location is not empty, the
+  directories are resolved to canonical paths.
+
+  When the \c filelistcache variable is set, the listing of a
+  directory is reused from an earlier run if the modification time
+  of the directory has not changed.
+ */
 QStringList Config::getFilesHere(const QString &uncleanDir, const QString &nameFilter,
                                  const Location &location, const QSet<QString> &excludedDirs,
                                  const QSet<QString> &excludedFiles)
 {
-    QString dir =
-            location.isEmpty() ? QDir::cleanPath(uncleanDir) : QDir(uncleanDir).canonicalPath();
+    loadFileListCache();
+
+    const auto nameFilters = nameFilterExpressions(nameFilter);
+    const auto scans =
+            scanDirectoryTree(QStringList(uncleanDir), !location.isEmpty(), excludedDirs);
     QStringList result;
-    if (excludedDirs.contains(dir))
-        return result;
+    collectFiles(scans, uncleanDir, nameFilters, excludedFiles, result);
+    return result;
+}
 
-    QDir dirInfo(dir);
+/*!
+  Returns the files below the example directory \a uncleanDir that
+  getFilesHere() returns for \a nameFilter, \a excludedDirs and
+  \a excludedFiles without a location.
 
-    dirInfo.setNameFilters(nameFilter.split(QLatin1Char(' ')));
-    dirInfo.setSorting(QDir::Name);
-    dirInfo.setFilter(QDir::Files);
-    QStringList fileNames = dirInfo.entryList();
-    for (const auto &file : qAsConst(fileNames)) {
-        if (!file.startsWith(QLatin1Char('~'))) {
-            QString s = dirInfo.filePath(file);
-            QString c = QDir::cleanPath(s);
-            if (!isFileExcluded(c, excludedFiles))
-                result.append(c);
-        }
+  The files are taken from the scan of the exampledirs made by
+  getExampleQdocFiles() and getExampleImageFiles() where it covers
+  \a uncleanDir, instead of listing the directories again.
+ */
+QStringList Config::getExampleFiles(const QString &uncleanDir, const QString &nameFilter,
+                                    const QSet<QString> &excludedDirs,
+                                    const QSet<QString> &excludedFiles)
+{
+    if (s_exampleTree.m_scanned) {
+        QStringList result;
+        if (collectUncanonicalFiles(s_exampleTree.m_scans, uncleanDir,
+                                    nameFilterExpressions(nameFilter), excludedDirs,
+                                    excludedFiles, result))
+            return result;
     }
+    return getFilesHere(uncleanDir, nameFilter, Location(), excludedDirs, excludedFiles);
+}
+
+/*!
+  Returns the \c{.qdoc} files below the exampledirs, skipping the
+  directories in \a excludedDirs and the files in \a excludedFiles.
+  The exampledirs are only listed once for all example files.
+ */
+QStringList Config::getExampleQdocFiles(const QSet<QString> &excludedDirs,
+                                        const QSet<QString> &excludedFiles)
+{
+    QStringList result;
+    const QStringList dirs = getCanonicalPathList(CONFIG_EXAMPLEDIRS);
+    const auto nameFilters = nameFilterExpressions(QStringLiteral(" *.qdoc"));
+
+    const ExampleTree &tree = exampleTree(dirs, excludedDirs);
+    for (const auto &dir : dirs)
+        collectFiles(tree.m_scans, dir, nameFilters, excludedFiles, result);
+    return result;
+}
 
-    dirInfo.setNameFilters(QStringList(QLatin1String("*")));
-    dirInfo.setFilter(QDir::Dirs | QDir::NoDotAndDotDot);
-    fileNames = dirInfo.entryList();
-    for (const auto &file : fileNames)
-        result += getFilesHere(dirInfo.filePath(file), nameFilter, location, excludedDirs,
-                               excludedFiles);
+/*!
+  Returns the image files below the exampledirs, skipping the
+  directories in \a excludedDirs and the files in \a excludedFiles.
+  The exampledirs are only listed once for all example files.
+ */
+QStringList Config::getExampleImageFiles(const QSet<QString> &excludedDirs,
+                                         const QSet<QString> &excludedFiles)
+{
+    QStringList result;
+    const QStringList dirs = getCanonicalPathList(CONFIG_EXAMPLEDIRS);
+    const auto nameFilters =
+            nameFilterExpressions(getString(CONFIG_EXAMPLES + dot + CONFIG_IMAGEEXTENSIONS));
+
+    const ExampleTree &tree = exampleTree(dirs, excludedDirs);
+    for (const auto &dir : dirs)
+        collectFiles(tree.m_scans, dir, nameFilters, excludedFiles, result);
     return result;
 }
 
+/*!
+    Returns the path to the project file for \a examplePath, or an empty string
+    if no project file was found.
+ */
+QString Config::getExampleProjectFile(const QString &examplePath)
+{
+    QFileInfo fileInfo(examplePath);
+    QStringList validNames;
+    validNames << fileInfo.fileName() + QLatin1String(".pro")
+               << fileInfo.fileName() + QLatin1String(".qmlproject")
+               << fileInfo.fileName() + QLatin1String(".pyproject")
+               << QLatin1String("CMakeLists.txt")
+               << QLatin1String("qbuild.pro"); // legacy
+
+    // Where the scan of the exampledirs lists the example directory,
+    // the project file is looked up in the listing instead of on disk.
+    const bool scanned = s_exampleTree.m_scanned && s_exampleTree.m_roots == m_exampleDirs;
+    QString projectFile;
+
+    for (const auto &name : qAsConst(validNames)) {
+        const QString fileName = examplePath + QLatin1Char('/') + name;
+        if (!scanned) {
+            projectFile = Config::findFile(Location(), m_exampleFiles, m_exampleDirs, fileName);
+            if (!projectFile.isEmpty())
+                return projectFile;
+            continue;
+        }
+
+        projectFile = Config::findFile(Location(), m_exampleFiles, QStringList(), fileName);
+        if (!projectFile.isEmpty())
+            return projectFile;
+        for (const auto &dir : qAsConst(m_exampleDirs)) {
+            const QDir dirInfo(dir);
+            const auto scan = s_exampleTree.m_scans.constFind(dirInfo.filePath(examplePath));
+            const bool found = (scan != s_exampleTree.m_scans.cend() && !scan->m_excluded)
+                    ? scan->m_listing.m_files.contains(name)
+                    : QFileInfo::exists(dirInfo.filePath(fileName));
+            if (found)
+                return dirInfo.filePath(fileName);
+        }
+    }
+
+    return QString();
+}
+
 /*!
   Push \a dir onto the stack of working directories.
  */
@@ -33,11 +33,14 @@
 #include "qdoccommandlineparser.h"
 #include "singleton.h"
 
+#include <QtCore/qhash.h>
 #include <QtCore/qmap.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qpair.h>
 #include <QtCore/qset.h>
 #include <QtCore/qstack.h>
 #include <QtCore/qstringlist.h>
+#include <QtCore/qwaitcondition.h>
 
 #include <utility>
 
@@ -128,6 +131,11 @@ public:
     [[nodiscard]] bool getDebug() const { return m_debug; }
     [[nodiscard]] bool getAtomsDump() const { return m_atomsDump; }
     [[nodiscard]] bool showInternal() const { return m_showInternal; }
+    [[nodiscard]] int jobs() const { return m_jobs; }
+    [[nodiscard]] bool incremental() const { return m_incremental; }
+    [[nodiscard]] bool timings() const { return m_timings; }
+    [[nodiscard]] const QString &traceFile() const { return m_traceFile; }
+    [[nodiscard]] const QString &serverName() const { return m_serverName; }
 
     void clear();
     void reset();
@@ -154,6 +162,7 @@ public:
     [[nodiscard]] QRegularExpression getRegExp(const QString &var) const;
     [[nodiscard]] QList<QRegularExpression> getRegExpList(const QString &var) const;
     [[nodiscard]] QSet<QString> subVars(const QString &var) const;
+    [[nodiscard]] QByteArray hash() const;
     QStringList getAllFiles(const QString &filesVar, const QString &dirsVar,
                             const QSet<QString> &excludedDirs = QSet<QString>(),
                             const QSet<QString> &excludedFiles = QSet<QString>());
@@ -170,6 +179,11 @@ public:
                                     const Location &location = Location(),
                                     const QSet<QString> &excludedDirs = QSet<QString>(),
                                     const QSet<QString> &excludedFiles = QSet<QString>());
+    static QStringList getExampleFiles(const QString &dir, const QString &nameFilter,
+                                       const QSet<QString> &excludedDirs = QSet<QString>(),
+                                       const QSet<QString> &excludedFiles = QSet<QString>());
+    static void writeFileListCache();
+    static void writeParsedFileCache();
     static QString findFile(const Location &location, const QStringList &files,
                             const QStringList &dirs, const QString &fileName,
                             QString *userFriendlyFilePath = nullptr);
@@ -202,6 +216,9 @@ public:
     [[nodiscard]] QString previousCurrentDir() const { return m_previousCurrentDir; }
     void setPreviousCurrentDir(const QString &path) { m_previousCurrentDir = path; }
 
+    void addInputFile(const QString &filePath);
+    [[nodiscard]] QStringList inputFiles() const;
+
     void setQDocPass(const QDocPass &pass) { m_qdocPass = pass; };
     [[nodiscard]] bool preparing() const { return (m_qdocPass == Prepare); }
     [[nodiscard]] bool generating() const { return (m_qdocPass == Generate); }
@@ -211,6 +228,7 @@ private:
     void setIncludePaths();
     void setIndexDirs();
     void expandVariables();
+    void clearValueCache();
     inline void updateLocation(const ConfigVar &cv) const
     {
         if (!cv.m_location.isEmpty())
@@ -227,6 +245,11 @@ private:
     QString m_previousCurrentDir {};
 
     bool m_showInternal { false };
+    int m_jobs { 1 };
+    bool m_incremental { false };
+    bool m_timings { false };
+    QString m_traceFile {};
+    QString m_serverName {};
     static bool m_debug;
 
     // An option that can be set trough a similarly named command-line option.
@@ -243,6 +266,28 @@ private:
     Location m_lastLocation {};
     ConfigVarMap m_configVars {};
 
+    // The values returned by getString() and getStringList(), kept
+    // until the config variables change.
+    mutable QMutex m_valueCacheMutex {};
+    mutable QHash<QString, QString> m_stringCache {};
+    mutable QHash<QString, QStringList> m_stringListCache {};
+
+    // The output files written by copyFile() for the current project,
+    // with their source files. Other callers wait while one is copied.
+    struct CopiedFile
+    {
+        QString m_source {};
+        bool m_done { false };
+    };
+    QHash<QString, CopiedFile> m_copiedFiles {};
+    QMutex m_copiedFilesMutex {};
+    QWaitCondition m_copiedFileDone {};
+
+    // The files read besides the headers and sources, recorded by
+    // addInputFile() for the current project.
+    mutable QMutex m_inputFilesMutex {};
+    QSet<QString> m_inputFiles {};
+
     static QMap<QString, QString> m_extractedDirs;
     static QStack<QString> m_workingDirs;
     static QMap<QString, QStringList> m_includeFilesMap;
@@ -255,6 +300,7 @@ struct ConfigStrings
 {
     static QString ALIAS;
     static QString AUTOLINKERRORS;
+    static QString BINARYINDEX;
     static QString BUILDVERSION;
     static QString CLANGDEFINES;
     static QString CODEINDENT;
@@ -274,6 +320,7 @@ struct ConfigStrings
     static QString EXCLUDEFILES;
     static QString EXTRAIMAGES;
     static QString FALSEHOODS;
+    static QString FILELISTCACHE;
     static QString FORMATTING;
     static QString HEADERDIRS;
     static QString HEADERS;
@@ -301,10 +348,12 @@ struct ConfigStrings
     static QString NATURALLANGUAGE;
     static QString NAVIGATION;
     static QString NOLINKERRORS;
+    static QString OUTPUTARCHIVE;
     static QString OUTPUTDIR;
     static QString OUTPUTFORMATS;
     static QString OUTPUTPREFIXES;
     static QString OUTPUTSUFFIXES;
+    static QString PCHCACHEDIR;
     static QString PROJECT;
     static QString REDIRECTDOCUMENTATIONTODEVNULL;
     static QString QHP;
@@ -335,6 +384,7 @@ struct ConfigStrings
 
 #define CONFIG_ALIAS ConfigStrings::ALIAS
 #define CONFIG_AUTOLINKERRORS ConfigStrings::AUTOLINKERRORS
+#define CONFIG_BINARYINDEX ConfigStrings::BINARYINDEX
 #define CONFIG_BUILDVERSION ConfigStrings::BUILDVERSION
 #define CONFIG_CLANGDEFINES ConfigStrings::CLANGDEFINES
 #define CONFIG_CODEINDENT ConfigStrings::CODEINDENT
@@ -354,6 +404,7 @@ struct ConfigStrings
 #define CONFIG_EXCLUDEFILES ConfigStrings::EXCLUDEFILES
 #define CONFIG_EXTRAIMAGES ConfigStrings::EXTRAIMAGES
 #define CONFIG_FALSEHOODS ConfigStrings::FALSEHOODS
+#define CONFIG_FILELISTCACHE ConfigStrings::FILELISTCACHE
 #define CONFIG_FORMATTING ConfigStrings::FORMATTING
 #define CONFIG_HEADERDIRS ConfigStrings::HEADERDIRS
 #define CONFIG_HEADERS ConfigStrings::HEADERS
@@ -381,10 +432,12 @@ struct ConfigStrings
 #define CONFIG_NATURALLANGUAGE ConfigStrings::NATURALLANGUAGE
 #define CONFIG_NAVIGATION ConfigStrings::NAVIGATION
 #define CONFIG_NOLINKERRORS ConfigStrings::NOLINKERRORS
+#define CONFIG_OUTPUTARCHIVE ConfigStrings::OUTPUTARCHIVE
 #define CONFIG_OUTPUTDIR ConfigStrings::OUTPUTDIR
 #define CONFIG_OUTPUTFORMATS ConfigStrings::OUTPUTFORMATS
 #define CONFIG_OUTPUTPREFIXES ConfigStrings::OUTPUTPREFIXES
 #define CONFIG_OUTPUTSUFFIXES ConfigStrings::OUTPUTSUFFIXES
+#define CONFIG_PCHCACHEDIR ConfigStrings::PCHCACHEDIR
 #define CONFIG_PROJECT ConfigStrings::PROJECT
 #define CONFIG_REDIRECTDOCUMENTATIONTODEVNULL ConfigStrings::REDIRECTDOCUMENTATIONTODEVNULL
 #define CONFIG_QHP ConfigStrings::QHP
@@ -80,14 +80,36 @@ Atom::AtomType CppCodeMarker::atomType() const
     return Atom::Code;
 }
 
+/*!
+  Returns \a code marked up as C++. The markup does not depend
+  on \a relative or \a location, so the result is cached for code
+  that is quoted more than once.
+ */
 QString CppCodeMarker::markedUpCode(const QString &code, const Node *relative,
                                     const Location &location)
 {
-    return addMarkUp(code, relative, location);
+    auto it = m_markedUpCode.constFind(code);
+    if (it == m_markedUpCode.constEnd())
+        it = m_markedUpCode.insert(code, addMarkUp(code, relative, location));
+    return it.value();
 }
 
-QString CppCodeMarker::markedUpSynopsis(const Node *node, const Node * /* relative */,
+/*!
+  Returns the synopsis of \a node in \a style. It is computed once
+  per node and style, and shared by all output formats.
+ */
+QString CppCodeMarker::markedUpSynopsis(const Node *node, const Node *relative,
                                         Section::Style style)
+{
+    const auto key = std::make_pair(node, int(style));
+    auto it = m_markedUpSynopses.constFind(key);
+    if (it == m_markedUpSynopses.constEnd())
+        it = m_markedUpSynopses.insert(key, computeMarkedUpSynopsis(node, relative, style));
+    return it.value();
+}
+
+QString CppCodeMarker::computeMarkedUpSynopsis(const Node *node, const Node * /* relative */,
+                                               Section::Style style)
 {
     const int MaxEnumValues = 6;
     const FunctionNode *func;
@@ -246,8 +268,20 @@ QString CppCodeMarker::markedUpSynopsis(const Node *node, const Node * /* relati
 }
 
 /*!
+  Returns the marked up name of the QML item \a node, linked to its
+  documentation if \a summary is \c true. The result is cached per
+  node and \a summary.
  */
 QString CppCodeMarker::markedUpQmlItem(const Node *node, bool summary)
+{
+    const auto key = std::make_pair(node, summary);
+    auto it = m_markedUpQmlItems.constFind(key);
+    if (it == m_markedUpQmlItems.constEnd())
+        it = m_markedUpQmlItems.insert(key, computeMarkedUpQmlItem(node, summary));
+    return it.value();
+}
+
+QString CppCodeMarker::computeMarkedUpQmlItem(const Node *node, bool summary)
 {
     QString name = taggedQmlNode(node);
     if (summary) {
@@ -358,6 +392,186 @@ QString CppCodeMarker::functionEndRegExp(const QString & /* funcName */)
     return "^\\}$";
 }
 
+namespace {
+
+enum class CppWordKind : unsigned char { Other, Type, Keyword };
+
+struct CppWord
+{
+    const char *word;
+    CppWordKind kind;
+};
+
+// "bool" and "and" are not marked up; they were left out of the sets this
+// table replaces, and the generated documentation should not change.
+constexpr CppWord cppWords[] = {
+    { "char", CppWordKind::Type },       { "double", CppWordKind::Type },
+    { "float", CppWordKind::Type },      { "int", CppWordKind::Type },
+    { "long", CppWordKind::Type },       { "short", CppWordKind::Type },
+    { "signed", CppWordKind::Type },     { "unsigned", CppWordKind::Type },
+    { "uint", CppWordKind::Type },       { "ulong", CppWordKind::Type },
+    { "ushort", CppWordKind::Type },     { "uchar", CppWordKind::Type },
+    { "void", CppWordKind::Type },       { "qlonglong", CppWordKind::Type },
+    { "qulonglong", CppWordKind::Type }, { "qint", CppWordKind::Type },
+    { "qint8", CppWordKind::Type },      { "qint16", CppWordKind::Type },
+    { "qint32", CppWordKind::Type },     { "qint64", CppWordKind::Type },
+    { "quint", CppWordKind::Type },      { "quint8", CppWordKind::Type },
+    { "quint16", CppWordKind::Type },    { "quint32", CppWordKind::Type },
+    { "quint64", CppWordKind::Type },    { "qreal", CppWordKind::Type },
+    { "cond", CppWordKind::Type },
+
+    { "and_eq", CppWordKind::Keyword },       { "asm", CppWordKind::Keyword },
+    { "auto", CppWordKind::Keyword },         { "bitand", CppWordKind::Keyword },
+    { "bitor", CppWordKind::Keyword },        { "break", CppWordKind::Keyword },
+    { "case", CppWordKind::Keyword },         { "catch", CppWordKind::Keyword },
+    { "class", CppWordKind::Keyword },        { "compl", CppWordKind::Keyword },
+    { "const", CppWordKind::Keyword },        { "const_cast", CppWordKind::Keyword },
+    { "continue", CppWordKind::Keyword },     { "default", CppWordKind::Keyword },
+    { "delete", CppWordKind::Keyword },       { "do", CppWordKind::Keyword },
+    { "dynamic_cast", CppWordKind::Keyword }, { "else", CppWordKind::Keyword },
+    { "enum", CppWordKind::Keyword },         { "explicit", CppWordKind::Keyword },
+    { "export", CppWordKind::Keyword },       { "extern", CppWordKind::Keyword },
+    { "false", CppWordKind::Keyword },        { "for", CppWordKind::Keyword },
+    { "friend", CppWordKind::Keyword },       { "goto", CppWordKind::Keyword },
+    { "if", CppWordKind::Keyword },           { "include", CppWordKind::Keyword },
+    { "inline", CppWordKind::Keyword },       { "monitor", CppWordKind::Keyword },
+    { "mutable", CppWordKind::Keyword },      { "namespace", CppWordKind::Keyword },
+    { "new", CppWordKind::Keyword },          { "not", CppWordKind::Keyword },
+    { "not_eq", CppWordKind::Keyword },       { "operator", CppWordKind::Keyword },
+    { "or", CppWordKind::Keyword },           { "or_eq", CppWordKind::Keyword },
+    { "private", CppWordKind::Keyword },      { "protected", CppWordKind::Keyword },
+    { "public", CppWordKind::Keyword },       { "register", CppWordKind::Keyword },
+    { "reinterpret_cast", CppWordKind::Keyword }, { "return", CppWordKind::Keyword },
+    { "sizeof", CppWordKind::Keyword },       { "static", CppWordKind::Keyword },
+    { "static_cast", CppWordKind::Keyword },  { "struct", CppWordKind::Keyword },
+    { "switch", CppWordKind::Keyword },       { "template", CppWordKind::Keyword },
+    { "this", CppWordKind::Keyword },         { "throw", CppWordKind::Keyword },
+    { "true", CppWordKind::Keyword },         { "try", CppWordKind::Keyword },
+    { "typedef", CppWordKind::Keyword },      { "typeid", CppWordKind::Keyword },
+    { "typename", CppWordKind::Keyword },     { "union", CppWordKind::Keyword },
+    { "using", CppWordKind::Keyword },        { "virtual", CppWordKind::Keyword },
+    { "volatile", CppWordKind::Keyword },     { "wchar_t", CppWordKind::Keyword },
+    { "while", CppWordKind::Keyword },        { "xor", CppWordKind::Keyword },
+    { "xor_eq", CppWordKind::Keyword },       { "synchronized", CppWordKind::Keyword },
+    // Qt specific
+    { "signals", CppWordKind::Keyword },      { "slots", CppWordKind::Keyword },
+    { "emit", CppWordKind::Keyword }
+};
+
+constexpr uint cppWordTableSize = 256;
+
+template <typename Char>
+constexpr uint cppWordHash(const Char *word, qsizetype length)
+{
+    uint hash = 2166136261u;
+    for (qsizetype i = 0; i < length; ++i) {
+        hash ^= uint(word[i]);
+        hash *= 16777619u;
+    }
+    return hash & (cppWordTableSize - 1);
+}
+
+// An open-addressing hash table of cppWords, built at compile time.
+struct CppWordTable
+{
+    const char *words[cppWordTableSize] = {};
+    qsizetype lengths[cppWordTableSize] = {};
+    CppWordKind kinds[cppWordTableSize] = {};
+    qsizetype maximumLength = 0;
+};
+
+constexpr CppWordTable makeCppWordTable()
+{
+    CppWordTable table;
+    for (const CppWord &word : cppWords) {
+        qsizetype length = 0;
+        while (word.word[length])
+            ++length;
+        uint slot = cppWordHash(word.word, length);
+        while (table.words[slot])
+            slot = (slot + 1) & (cppWordTableSize - 1);
+        table.words[slot] = word.word;
+        table.lengths[slot] = length;
+        table.kinds[slot] = word.kind;
+        table.maximumLength = qMax(table.maximumLength, length);
+    }
+    return table;
+}
+
+constexpr CppWordTable cppWordTable = makeCppWordTable();
+
+CppWordKind cppWordKind(QStringView word)
+{
+    if (word.size() > cppWordTable.maximumLength)
+        return CppWordKind::Other;
+    for (QChar c : word) {
+        if (c.unicode() >= 0x80)
+            return CppWordKind::Other;
+    }
+    for (uint slot = cppWordHash(word.utf16(), word.size()); cppWordTable.words[slot];
+         slot = (slot + 1) & (cppWordTableSize - 1)) {
+        if (cppWordTable.lengths[slot] == word.size()
+            && QLatin1String(cppWordTable.words[slot], cppWordTable.lengths[slot]) == word) {
+            return cppWordTable.kinds[slot];
+        }
+    }
+    return CppWordKind::Other;
+}
+
+inline bool isAsciiUpper(QChar c)
+{
+    return c >= u'A' && c <= u'Z';
+}
+
+inline bool isAsciiLower(QChar c)
+{
+    return c >= u'a' && c <= u'z';
+}
+
+// Matches the regular expression "Qt?(?:[A-Z3]+[a-z][A-Za-z]*|t)".
+bool isQtClassName(QStringView word)
+{
+    const auto matchesTail = [](QStringView tail) {
+        if (tail.size() == 1 && tail.front() == u't')
+            return true;
+        qsizetype i = 0;
+        while (i < tail.size() && (isAsciiUpper(tail.at(i)) || tail.at(i) == u'3'))
+            ++i;
+        if (i == 0 || i == tail.size() || !isAsciiLower(tail.at(i)))
+            return false;
+        for (++i; i < tail.size(); ++i) {
+            if (!isAsciiUpper(tail.at(i)) && !isAsciiLower(tail.at(i)))
+                return false;
+        }
+        return true;
+    };
+
+    if (word.isEmpty() || word.front() != u'Q')
+        return false;
+    const QStringView tail = word.mid(1);
+    return matchesTail(tail) || (tail.startsWith(u't') && matchesTail(tail.mid(1)));
+}
+
+// Matches the regular expression "q([A-Z][a-z]+)+".
+bool isQtFunctionName(QStringView word)
+{
+    if (word.size() < 3 || word.front() != u'q')
+        return false;
+    qsizetype i = 1;
+    while (i < word.size()) {
+        if (!isAsciiUpper(word.at(i++)))
+            return false;
+        const qsizetype lowerStart = i;
+        while (i < word.size() && isAsciiLower(word.at(i)))
+            ++i;
+        if (i == lowerStart)
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
 /*
     @char
     @class
@@ -371,119 +585,60 @@ QString CppCodeMarker::functionEndRegExp(const QString & /* funcName */)
     @type
 */
 
-QString CppCodeMarker::addMarkUp(const QString &in, const Node * /* relative */,
+QString CppCodeMarker::addMarkUp(const QString &code, const Node * /* relative */,
                                  const Location & /* location */)
 {
-    static QSet<QString> types;
-    static QSet<QString> keywords;
-
-    if (types.isEmpty()) {
-        // initialize statics
-        Q_ASSERT(keywords.isEmpty());
-        static const QString typeTable[] = {
-            QLatin1String("bool"),       QLatin1String("char"),    QLatin1String("double"),
-            QLatin1String("float"),      QLatin1String("int"),     QLatin1String("long"),
-            QLatin1String("short"),      QLatin1String("signed"),  QLatin1String("unsigned"),
-            QLatin1String("uint"),       QLatin1String("ulong"),   QLatin1String("ushort"),
-            QLatin1String("uchar"),      QLatin1String("void"),    QLatin1String("qlonglong"),
-            QLatin1String("qulonglong"), QLatin1String("qint"),    QLatin1String("qint8"),
-            QLatin1String("qint16"),     QLatin1String("qint32"),  QLatin1String("qint64"),
-            QLatin1String("quint"),      QLatin1String("quint8"),  QLatin1String("quint16"),
-            QLatin1String("quint32"),    QLatin1String("quint64"), QLatin1String("qreal"),
-            QLatin1String("cond")
-        };
-
-        static const QString keywordTable[] = {
-            QLatin1String("and"), QLatin1String("and_eq"), QLatin1String("asm"),
-            QLatin1String("auto"), QLatin1String("bitand"), QLatin1String("bitor"),
-            QLatin1String("break"), QLatin1String("case"), QLatin1String("catch"),
-            QLatin1String("class"), QLatin1String("compl"), QLatin1String("const"),
-            QLatin1String("const_cast"), QLatin1String("continue"), QLatin1String("default"),
-            QLatin1String("delete"), QLatin1String("do"), QLatin1String("dynamic_cast"),
-            QLatin1String("else"), QLatin1String("enum"), QLatin1String("explicit"),
-            QLatin1String("export"), QLatin1String("extern"), QLatin1String("false"),
-            QLatin1String("for"), QLatin1String("friend"), QLatin1String("goto"),
-            QLatin1String("if"), QLatin1String("include"), QLatin1String("inline"),
-            QLatin1String("monitor"), QLatin1String("mutable"), QLatin1String("namespace"),
-            QLatin1String("new"), QLatin1String("not"), QLatin1String("not_eq"),
-            QLatin1String("operator"), QLatin1String("or"), QLatin1String("or_eq"),
-            QLatin1String("private"), QLatin1String("protected"), QLatin1String("public"),
-            QLatin1String("register"), QLatin1String("reinterpret_cast"), QLatin1String("return"),
-            QLatin1String("sizeof"), QLatin1String("static"), QLatin1String("static_cast"),
-            QLatin1String("struct"), QLatin1String("switch"), QLatin1String("template"),
-            QLatin1String("this"), QLatin1String("throw"), QLatin1String("true"),
-            QLatin1String("try"), QLatin1String("typedef"), QLatin1String("typeid"),
-            QLatin1String("typename"), QLatin1String("union"), QLatin1String("using"),
-            QLatin1String("virtual"), QLatin1String("volatile"), QLatin1String("wchar_t"),
-            QLatin1String("while"), QLatin1String("xor"), QLatin1String("xor_eq"),
-            QLatin1String("synchronized"),
-            // Qt specific
-            QLatin1String("signals"), QLatin1String("slots"), QLatin1String("emit")
-        };
-
-        types.reserve(sizeof(typeTable) / sizeof(QString));
-        for (int j = sizeof(typeTable) / sizeof(QString) - 1; j; --j)
-            types.insert(typeTable[j]);
-
-        keywords.reserve(sizeof(keywordTable) / sizeof(QString));
-        for (int j = sizeof(keywordTable) / sizeof(QString) - 1; j; --j)
-            keywords.insert(keywordTable[j]);
-    }
-
-    QString code = in;
     QString out;
+    out.reserve(code.size() * 2);
     QStringView text;
-    int braceDepth = 0;
-    int parenDepth = 0;
-    int i = 0;
-    int start = 0;
-    int finish = 0;
+    qsizetype i = 0;
+    qsizetype start = 0;
+    qsizetype finish = 0;
     QChar ch;
-    QRegularExpression classRegExp(QRegularExpression::anchoredPattern("Qt?(?:[A-Z3]+[a-z][A-Za-z]*|t)"));
-    QRegularExpression functionRegExp(QRegularExpression::anchoredPattern("q([A-Z][a-z]+)+"));
-    QRegularExpression findFunctionRegExp(QStringLiteral("^\\s*\\("));
     bool atEOF = false;
 
     auto readChar = [&]() {
          if (i < code.length())
-            ch = code[i++];
+            ch = code.at(i++);
          else
             atEOF = true;
     };
 
     readChar();
     while (!atEOF) {
-        QString tag;
+        QLatin1String tag;
         bool target = false;
 
         if (ch.isLetter() || ch == '_') {
-            QString ident;
             do {
-                ident += ch;
                 finish = i;
                 readChar();
             } while (!atEOF && (ch.isLetterOrNumber() || ch == '_'));
 
-            if (classRegExp.match(ident).hasMatch()) {
-                tag = QStringLiteral("type");
-            } else if (functionRegExp.match(ident).hasMatch()) {
-                tag = QStringLiteral("func");
-                target = true;
-            } else if (types.contains(ident)) {
-                tag = QStringLiteral("type");
-            } else if (keywords.contains(ident)) {
-                tag = QStringLiteral("keyword");
-            } else if (braceDepth == 0 && parenDepth == 0) {
-                if (code.indexOf(findFunctionRegExp, i - 1) == i - 1)
-                    tag = QStringLiteral("func");
+            const QStringView ident = QStringView{code}.mid(start, finish - start);
+            if (isQtClassName(ident)) {
+                tag = QLatin1String("type");
+            } else if (isQtFunctionName(ident)) {
+                tag = QLatin1String("func");
                 target = true;
+            } else {
+                switch (cppWordKind(ident)) {
+                case CppWordKind::Type:
+                    tag = QLatin1String("type");
+                    break;
+                case CppWordKind::Keyword:
+                    tag = QLatin1String("keyword");
+                    break;
+                case CppWordKind::Other:
+                    break;
+                }
             }
         } else if (ch.isDigit()) {
             do {
                 finish = i;
                 readChar();
             } while (!atEOF && (ch.isLetterOrNumber() || ch == '.'));
-            tag = QStringLiteral("number");
+            tag = QLatin1String("number");
         } else {
             switch (ch.unicode()) {
             case '+':
@@ -505,7 +660,7 @@ QString CppCodeMarker::addMarkUp(const QString &in, const Node * /* relative */,
             case '~':
                 finish = i;
                 readChar();
-                tag = QStringLiteral("op");
+                tag = QLatin1String("op");
                 break;
             case '"':
                 finish = i;
@@ -518,7 +673,7 @@ QString CppCodeMarker::addMarkUp(const QString &in, const Node * /* relative */,
                 }
                 finish = i;
                 readChar();
-                tag = QStringLiteral("string");
+                tag = QLatin1String("string");
                 break;
             case '#':
                 finish = i;
@@ -529,7 +684,7 @@ QString CppCodeMarker::addMarkUp(const QString &in, const Node * /* relative */,
                     finish = i;
                     readChar();
                 }
-                tag = QStringLiteral("preprocessor");
+                tag = QLatin1String("preprocessor");
                 break;
             case '\'':
                 finish = i;
@@ -542,17 +697,7 @@ QString CppCodeMarker::addMarkUp(const QString &in, const Node * /* relative */,
                 }
                 finish = i;
                 readChar();
-                tag = QStringLiteral("char");
-                break;
-            case '(':
-                finish = i;
-                readChar();
-                ++parenDepth;
-                break;
-            case ')':
-                finish = i;
-                readChar();
-                --parenDepth;
+                tag = QLatin1String("char");
                 break;
             case ':':
                 finish = i;
@@ -560,7 +705,7 @@ QString CppCodeMarker::addMarkUp(const QString &in, const Node * /* relative */,
                 if (!atEOF && ch == ':') {
                     finish = i;
                     readChar();
-                    tag = QStringLiteral("op");
+                    tag = QLatin1String("op");
                 }
                 break;
             case '/':
@@ -571,7 +716,7 @@ QString CppCodeMarker::addMarkUp(const QString &in, const Node * /* relative */,
                         finish = i;
                         readChar();
                     } while (!atEOF && ch != '\n');
-                    tag = QStringLiteral("comment");
+                    tag = QLatin1String("comment");
                 } else if (ch == '*') {
                     bool metAster = false;
                     bool metAsterSlash = false;
@@ -591,21 +736,11 @@ QString CppCodeMarker::addMarkUp(const QString &in, const Node * /* relative */,
                         finish = i;
                         readChar();
                     }
-                    tag = QStringLiteral("comment");
+                    tag = QLatin1String("comment");
                 } else {
-                    tag = QStringLiteral("op");
+                    tag = QLatin1String("op");
                 }
                 break;
-            case '{':
-                finish = i;
-                readChar();
-                braceDepth++;
-                break;
-            case '}':
-                finish = i;
-                readChar();
-                braceDepth--;
-                break;
             default:
                 finish = i;
                 readChar();
@@ -616,22 +751,22 @@ QString CppCodeMarker::addMarkUp(const QString &in, const Node * /* relative */,
         start = finish;
 
         if (!tag.isEmpty()) {
-            out += QStringLiteral("<@");
+            out += QLatin1String("<@");
             out += tag;
             if (target) {
-                out += QStringLiteral(" target=\"");
+                out += QLatin1String(" target=\"");
                 out += text;
-                out += QStringLiteral("()\"");
+                out += QLatin1String("()\"");
             }
-            out += QStringLiteral(">");
+            out += QLatin1Char('>');
         }
 
         appendProtectedString(&out, text);
 
         if (!tag.isEmpty()) {
-            out += QStringLiteral("</@");
+            out += QLatin1String("</@");
             out += tag;
-            out += QStringLiteral(">");
+            out += QLatin1Char('>');
         }
     }
 
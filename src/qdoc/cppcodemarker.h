@@ -54,6 +54,8 @@ public:
     QString functionEndRegExp(const QString &funcName) override;
 
 private:
+    QString computeMarkedUpSynopsis(const Node *node, const Node *relative, Section::Style style);
+    QString computeMarkedUpQmlItem(const Node *node, bool summary);
     QString addMarkUp(const QString &protectedCode, const Node *relative, const Location &location);
 };
 
@@ -831,13 +831,13 @@ void CppCodeParser::setExampleFileLists(ExampleNode *en)
 
     QDir exampleDir(QFileInfo(fullPath).dir());
 
-    QStringList exampleFiles = Config::getFilesHere(exampleDir.path(), m_exampleNameFilter,
-                                                    Location(), m_excludeDirs, m_excludeFiles);
+    QStringList exampleFiles = Config::getExampleFiles(exampleDir.path(), m_exampleNameFilter,
+                                                       m_excludeDirs, m_excludeFiles);
     // Search for all image files under the example project, excluding doc/images directory.
     QSet<QString> excludeDocDirs(m_excludeDirs);
     excludeDocDirs.insert(exampleDir.path() + QLatin1String("/doc/images"));
-    QStringList imageFiles = Config::getFilesHere(exampleDir.path(), m_exampleImageFilter,
-                                                  Location(), excludeDocDirs, m_excludeFiles);
+    QStringList imageFiles = Config::getExampleFiles(exampleDir.path(), m_exampleImageFilter,
+                                                     excludeDocDirs, m_excludeFiles);
     if (!exampleFiles.isEmpty()) {
         // move main.cpp to the end, if it exists
         QString mainCpp;
@@ -860,7 +860,7 @@ void CppCodeParser::setExampleFileLists(ExampleNode *en)
             exampleFiles.append(mainCpp);
 
         // Add any resource and project files
-        exampleFiles += Config::getFilesHere(exampleDir.path(),
+        exampleFiles += Config::getExampleFiles(exampleDir.path(),
                 QLatin1String("*.qrc *.pro *.qmlproject *.pyproject CMakeLists.txt qmldir"));
     }
 
@@ -975,6 +975,24 @@ void CppCodeParser::processTopicArgs(const Doc &doc, const QString &topic, NodeL
     }
 }
 
+/*!
+  Appends the \fn signatures of \a doc that processTopicArgs() will
+  ask clang to resolve to \a fnArgs, each paired with \a namespaceScope,
+  so they can be parsed together with the others of the same file.
+  Tagged signatures are looked up by tag instead, and are skipped.
+ */
+void CppCodeParser::collectFnArgs(const Doc &doc, const QString &topic,
+                                  const QStringList &namespaceScope, FnArgList &fnArgs)
+{
+    if (topic != COMMAND_FN || (!showInternal() && doc.isInternal()))
+        return;
+    const ArgList args = doc.metaCommandArgs(topic);
+    for (const auto &arg : args) {
+        if (arg.second.isEmpty())
+            fnArgs.append(std::make_pair(namespaceScope, arg.first));
+    }
+}
+
 void CppCodeParser::processMetaCommands(NodeList &nodes, DocList &docs)
 {
     QList<Doc>::Iterator d = docs.begin();
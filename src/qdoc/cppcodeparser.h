@@ -78,6 +78,8 @@ protected:
     void processMetaCommands(const Doc &doc, Node *node);
     void processMetaCommands(NodeList &nodes, DocList &docs);
     void processTopicArgs(const Doc &doc, const QString &topic, NodeList &nodes, DocList &docs);
+    static void collectFnArgs(const Doc &doc, const QString &topic,
+                              const QStringList &namespaceScope, FnArgList &fnArgs);
     [[nodiscard]] bool hasTooManyTopics(const Doc &doc) const;
 
 private:
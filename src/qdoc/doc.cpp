@@ -36,12 +36,19 @@
 #include "generator.h"
 #include "qmltypenode.h"
 #include "quoter.h"
+#include "tasks.h"
 #include "text.h"
 
+#include <optional>
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 DocUtilities &Doc::m_utilities = DocUtilities::instance();
 
+// The untabified contents of the files read by prefetchFiles(), by file path.
+static QHash<QString, QString> s_prefetchedFiles;
+
 /*!
     \typedef ArgList
     \relates Doc
@@ -69,6 +76,22 @@ Doc::Doc(const Location &start_loc, const Location &end_loc, const QString &sour
 {
     m_priv = new DocPrivate(start_loc, end_loc, source);
     DocParser parser;
+
+    // The text of an \internal comment is only needed if the node
+    // it documents is generated. Unless internal documentation is
+    // shown, only scan its metacommands now and parse the text on
+    // first use. Projects in single-exec mode share the trees but
+    // not the macros, so they always parse eagerly.
+    const Config &config = Config::instance();
+    if (!config.showInternal() && !config.getAtomsDump() && !config.singleExec()
+        && source.contains(QLatin1String("\\internal"))
+        && parser.scanMetaCommands(source, m_priv, metaCommandSet, topics)
+        && m_priv->m_metacommandsUsed.contains(QLatin1String("internal"))) {
+        m_priv->deferParse(metaCommandSet, topics);
+        return;
+    }
+    m_priv->m_metacommandsUsed.clear();
+    m_priv->m_metaCommandMap.clear();
     parser.parse(source, m_priv, metaCommandSet, topics);
 
     if (Config::instance().getAtomsDump()) {
@@ -133,7 +156,10 @@ bool Doc::isEmpty() const
 const Text &Doc::body() const
 {
     static const Text dummy;
-    return m_priv == nullptr ? dummy : m_priv->m_text;
+    if (m_priv == nullptr)
+        return dummy;
+    m_priv->ensureParsed();
+    return m_priv->m_text;
 }
 
 Text Doc::briefText(bool inclusive) const
@@ -212,17 +238,26 @@ Text Doc::legaleseText() const
 
 QSet<QString> Doc::parameterNames() const
 {
-    return m_priv == nullptr ? QSet<QString>() : m_priv->m_params;
+    if (m_priv == nullptr)
+        return QSet<QString>();
+    m_priv->ensureParsed();
+    return m_priv->m_params;
 }
 
 QStringList Doc::enumItemNames() const
 {
-    return m_priv == nullptr ? QStringList() : m_priv->m_enumItemList;
+    if (m_priv == nullptr)
+        return QStringList();
+    m_priv->ensureParsed();
+    return m_priv->m_enumItemList;
 }
 
 QStringList Doc::omitEnumItemNames() const
 {
-    return m_priv == nullptr ? QStringList() : m_priv->m_omitEnumItemList;
+    if (m_priv == nullptr)
+        return QStringList();
+    m_priv->ensureParsed();
+    return m_priv->m_omitEnumItemList;
 }
 
 QSet<QString> Doc::metaCommandsUsed() const
@@ -265,7 +300,10 @@ ArgList Doc::metaCommandArgs(const QString &metacommand) const
 
 QList<Text> Doc::alsoList() const
 {
-    return m_priv == nullptr ? QList<Text>() : m_priv->m_alsoList;
+    if (m_priv == nullptr)
+        return QList<Text>();
+    m_priv->ensureParsed();
+    return m_priv->m_alsoList;
 }
 
 bool Doc::hasTableOfContents() const
@@ -379,6 +417,7 @@ void Doc::terminate()
     m_utilities.aliasMap.clear();
     m_utilities.cmdHash.clear();
     m_utilities.macroHash.clear();
+    s_prefetchedFiles.clear();
     DocParser::terminate();
 }
 
@@ -443,6 +482,15 @@ CodeMarker *Doc::quoteFromFile(const Location &location, Quoter &quoter, const Q
 
     QString userFriendlyFilePath;
     const QString filePath = resolveFile(location, fileName, &userFriendlyFilePath);
+    CodeMarker *marker = CodeMarker::markerForFileName(fileName);
+    Config::instance().addInputFile(filePath);
+
+    // Files are quoted from many times, for instance one \snippet at a
+    // time. Read and mark up each file only once.
+    if (!filePath.isEmpty() && quoter.quoteFromCachedFile(filePath))
+        return marker;
+
+    bool cacheable = false;
     if (filePath.isEmpty()) {
         QString details = QLatin1String("Example directories: ")
                 + DocParser::s_exampleDirs.join(QLatin1Char(' '));
@@ -451,6 +499,10 @@ CodeMarker *Doc::quoteFromFile(const Location &location, Quoter &quoter, const Q
                     + DocParser::s_exampleFiles.join(QLatin1Char(' '));
         location.warning(QStringLiteral("Cannot find file to quote from: '%1'").arg(fileName),
                          details);
+    } else if (auto it = s_prefetchedFiles.find(filePath); it != s_prefetchedFiles.end()) {
+        code = std::move(it.value());
+        s_prefetchedFiles.erase(it);
+        cacheable = true;
     } else {
         QFile inFile(filePath);
         if (!inFile.open(QFile::ReadOnly)) {
@@ -459,14 +511,55 @@ CodeMarker *Doc::quoteFromFile(const Location &location, Quoter &quoter, const Q
         } else {
             QTextStream inStream(&inFile);
             code = DocParser::untabifyEtc(inStream.readAll());
+            cacheable = true;
         }
     }
 
-    CodeMarker *marker = CodeMarker::markerForFileName(fileName);
-    quoter.quoteFromFile(userFriendlyFilePath, code, marker->markedUpCode(code, nullptr, location));
+    quoter.quoteFromFile(userFriendlyFilePath, code, marker->markedUpCode(code, nullptr, location),
+                         cacheable ? filePath : QString());
     return marker;
 }
 
+/*!
+  Reads the files named in \a fileNames on worker threads, so that
+  the quoteFromFile() calls that follow for them don't wait on the
+  file system one file at a time. The files are resolved relative to
+  the example directories as for quoteFromFile(), which also reports
+  the ones that can't be found or read. \a location is used for
+  resolving the file names.
+
+  Does nothing unless qdoc runs with more than one job.
+ */
+void Doc::prefetchFiles(const Location &location, const QStringList &fileNames)
+{
+    if (Tasks::jobCount() < 2)
+        return;
+
+    QStringList filePaths;
+    for (const auto &fileName : fileNames) {
+        const QString filePath = resolveFile(location, fileName);
+        if (!filePath.isEmpty() && !Quoter::isCached(filePath)
+            && !s_prefetchedFiles.contains(filePath) && !filePaths.contains(filePath))
+            filePaths.append(filePath);
+    }
+    if (filePaths.size() < 2)
+        return;
+
+    std::vector<std::optional<QString>> contents(filePaths.size());
+    Tasks::forEach(filePaths.size(), [&](qsizetype i) {
+        QFile inFile(filePaths.at(i));
+        if (inFile.open(QFile::ReadOnly)) {
+            QTextStream inStream(&inFile);
+            contents[i] = DocParser::untabifyEtc(inStream.readAll());
+        }
+    });
+
+    for (qsizetype i = 0; i < filePaths.size(); ++i) {
+        if (contents[i])
+            s_prefetchedFiles.insert(filePaths.at(i), std::move(*contents[i]));
+    }
+}
+
 QString Doc::canonicalTitle(const QString &title)
 {
     // The code below is equivalent to the following chunk, but _much_
@@ -513,6 +606,7 @@ void Doc::detach()
     if (m_priv->count == 1)
         return;
 
+    m_priv->ensureParsed();
     --m_priv->count;
 
     auto *newPriv = new DocPrivate(*m_priv);
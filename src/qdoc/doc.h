@@ -104,6 +104,7 @@ public:
                                QString *userFriendlyFilePath = nullptr);
     static CodeMarker *quoteFromFile(const Location &location, Quoter &quoter,
                                      const QString &fileName);
+    static void prefetchFiles(const Location &location, const QStringList &fileNames);
     static QString canonicalTitle(const QString &title);
 
 private:
@@ -56,11 +56,13 @@
 #include <QtCore/qversionnumber.h>
 
 #include <cctype>
+#include <utility>
 
 QT_BEGIN_NAMESPACE
 
-static const char dbNamespace[] = "http://docbook.org/ns/docbook";
-static const char xlinkNamespace[] = "http://www.w3.org/1999/xlink";
+// QXmlStreamWriter takes QStrings; keep these from being converted for every element.
+static const QString dbNamespace = QStringLiteral("http://docbook.org/ns/docbook");
+static const QString xlinkNamespace = QStringLiteral("http://www.w3.org/1999/xlink");
 
 inline void DocBookGenerator::newLine()
 {
@@ -1105,161 +1107,98 @@ void DocBookGenerator::generateCompactList(ListType listType, const Node *relati
     if (nmm.isEmpty())
         return;
 
-    const int NumParagraphs = 37; // '0' to '9', 'A' to 'Z', '_'
-    qsizetype commonPrefixLen = commonPrefix.length();
-
-    /*
-      Divide the data into 37 paragraphs: 0, ..., 9, A, ..., Z,
-      underscore (_). QAccel will fall in paragraph 10 (A) and
-      QXtWidget in paragraph 33 (X). This is the only place where we
-      assume that NumParagraphs is 37. Each paragraph is a NodeMultiMap.
-    */
-    NodeMultiMap paragraph[NumParagraphs + 1];
-    QString paragraphName[NumParagraphs + 1];
-    QSet<char> usedParagraphNames;
-
-    NodeMultiMap::ConstIterator c = nmm.constBegin();
-    while (c != nmm.constEnd()) {
-        QStringList pieces = c.key().split("::");
-        QString key;
-        int idx = commonPrefixLen;
-        if (idx > 0 && !pieces.last().startsWith(commonPrefix, Qt::CaseInsensitive))
-            idx = 0;
-        key = pieces.last().mid(idx).toLower();
-
-        int paragraphNr = NumParagraphs - 1;
-
-        if (key[0].digitValue() != -1)
-            paragraphNr = key[0].digitValue();
-        else if (key[0] >= QLatin1Char('a') && key[0] <= QLatin1Char('z'))
-            paragraphNr = 10 + key[0].unicode() - 'a';
-
-        paragraphName[paragraphNr] = key[0].toUpper();
-        usedParagraphNames.insert(key[0].toLower().cell());
-        paragraph[paragraphNr].insert(c.key(), c.value());
-        ++c;
-    }
-
-    /*
-      Each paragraph j has a size: paragraph[j].count(). In the
-      discussion, we will assume paragraphs 0 to 5 will have sizes
-      3, 1, 4, 1, 5, 9.
-
-      We now want to compute the paragraph offset. Paragraphs 0 to 6
-      start at offsets 0, 3, 4, 8, 9, 14, 23.
-    */
-    int paragraphOffset[NumParagraphs + 1]; // 37 + 1
-    paragraphOffset[0] = 0;
-    for (int i = 0; i < NumParagraphs; i++) // i = 0..36
-        paragraphOffset[i + 1] = paragraphOffset[i] + paragraph[i].count();
+    const CompactList list = compactList(nmm, commonPrefix, false);
 
     // No table of contents in DocBook.
 
     // Actual output.
     m_numTableRows = 0;
 
-    int curParNr = 0;
-    int curParOffset = 0;
     QString previousName;
     bool multipleOccurrences = false;
 
-    for (int i = 0; i < nmm.count(); i++) {
-        while ((curParNr < NumParagraphs) && (curParOffset == paragraph[curParNr].count())) {
-            ++curParNr;
-            curParOffset = 0;
-        }
-
+    for (const auto &paragraph : list.paragraphs) {
         /*
           Starting a new paragraph means starting a new variablelist.
         */
-        if (curParOffset == 0) {
-            if (i > 0) {
-                m_writer->writeEndElement(); // variablelist
-                newLine();
-            }
-
-            m_writer->writeStartElement(dbNamespace, "variablelist");
-            m_writer->writeAttribute("role", selector);
-            newLine();
-            m_writer->writeStartElement(dbNamespace, "varlistentry");
-            newLine();
-
-            m_writer->writeStartElement(dbNamespace, "term");
-            m_writer->writeStartElement(dbNamespace, "emphasis");
-            m_writer->writeAttribute("role", "bold");
-            m_writer->writeCharacters(paragraphName[curParNr]);
-            m_writer->writeEndElement(); // emphasis
-            m_writer->writeEndElement(); // term
+        if (&paragraph != &list.paragraphs.first()) {
+            m_writer->writeEndElement(); // variablelist
             newLine();
         }
 
+        m_writer->writeStartElement(dbNamespace, "variablelist");
+        m_writer->writeAttribute("role", selector);
+        newLine();
+        m_writer->writeStartElement(dbNamespace, "varlistentry");
+        newLine();
+
+        m_writer->writeStartElement(dbNamespace, "term");
+        m_writer->writeStartElement(dbNamespace, "emphasis");
+        m_writer->writeAttribute("role", "bold");
+        m_writer->writeCharacters(paragraph.name);
+        m_writer->writeEndElement(); // emphasis
+        m_writer->writeEndElement(); // term
+        newLine();
+
         /*
-          Output a listitem for the current offset in the current paragraph.
+          Output a listitem for each node in the current paragraph.
          */
-        m_writer->writeStartElement(dbNamespace, "listitem");
-        newLine();
-        m_writer->writeStartElement(dbNamespace, "para");
-        if ((curParNr < NumParagraphs) && !paragraphName[curParNr].isEmpty()) {
-            NodeMultiMap::Iterator it;
-            NodeMultiMap::Iterator next;
-            it = paragraph[curParNr].begin();
-            for (int j = 0; j < curParOffset; j++)
-                ++it;
+        for (qsizetype i = 0; i < paragraph.nodes.size(); ++i) {
+            const Node *node = paragraph.nodes.at(i);
+            m_writer->writeStartElement(dbNamespace, "listitem");
+            newLine();
+            m_writer->writeStartElement(dbNamespace, "para");
 
             if (listType == Generic) {
-                generateFullName(it.value(), relative);
+                generateFullName(node, relative);
                 m_writer->writeStartElement(dbNamespace, "link");
-                m_writer->writeAttribute(xlinkNamespace, "href", fullDocumentLocation(*it));
-                m_writer->writeAttribute("type", targetType(it.value()));
+                m_writer->writeAttribute(xlinkNamespace, "href", fullDocumentLocation(node));
+                m_writer->writeAttribute("type", targetType(node));
             } else if (listType == Obsolete) {
-                QString fn = fileName(it.value(), fileExtension());
+                QString fn = fileName(node, fileExtension());
                 QString link;
                 if (useOutputSubdirs())
-                    link = QString("../" + it.value()->outputSubdirectory() + QLatin1Char('/'));
+                    link = QString("../" + node->outputSubdirectory() + QLatin1Char('/'));
                 link += fn;
 
                 m_writer->writeStartElement(dbNamespace, "link");
                 m_writer->writeAttribute(xlinkNamespace, "href", link);
-                m_writer->writeAttribute("type", targetType(it.value()));
+                m_writer->writeAttribute("type", targetType(node));
             }
 
             QStringList pieces;
-            if (it.value()->isQmlType() || it.value()->isJsType()) {
-                QString name = it.value()->name();
-                next = it;
-                ++next;
+            if (node->isQmlType() || node->isJsType()) {
+                QString name = node->name();
                 if (name != previousName)
                     multipleOccurrences = false;
-                if ((next != paragraph[curParNr].end()) && (name == next.value()->name())) {
+                if (i + 1 < paragraph.nodes.size() && name == paragraph.nodes.at(i + 1)->name()) {
                     multipleOccurrences = true;
                     previousName = name;
                 }
                 if (multipleOccurrences)
-                    name += ": " + it.value()->tree()->camelCaseModuleName();
+                    name += ": " + node->tree()->camelCaseModuleName();
                 pieces << name;
             } else
-                pieces = it.value()->fullName(relative).split("::");
+                pieces = node->fullName(relative).split("::");
 
             m_writer->writeCharacters(pieces.last());
             m_writer->writeEndElement(); // link
 
             if (pieces.size() > 1) {
                 m_writer->writeCharacters(" (");
-                generateFullName(it.value()->parent(), relative);
+                generateFullName(node->parent(), relative);
                 m_writer->writeCharacters(")");
             }
+
+            m_writer->writeEndElement(); // para
+            newLine();
+            m_writer->writeEndElement(); // listitem
+            newLine();
+            m_writer->writeEndElement(); // varlistentry
+            newLine();
         }
-        m_writer->writeEndElement(); // para
-        newLine();
-        m_writer->writeEndElement(); // listitem
-        newLine();
-        m_writer->writeEndElement(); // varlistentry
-        newLine();
-        curParOffset++;
-    }
-    if (nmm.count() > 0) {
-        m_writer->writeEndElement(); // variablelist
     }
+    m_writer->writeEndElement(); // variablelist
 }
 
 void DocBookGenerator::generateFunctionIndex(const Node *relative)
@@ -2264,6 +2203,8 @@ void DocBookGenerator::generateFileList(const ExampleNode *en, bool images)
 
     if (paths.isEmpty())
         return;
+    if (!images)
+        Doc::prefetchFiles(en->doc().location(), paths);
 
     m_writer->writeStartElement(dbNamespace, "para");
     m_writer->writeCharacters(tag);
@@ -2304,8 +2245,11 @@ void DocBookGenerator::generateExampleFilePage(const Node *node, const QString &
 
     const auto en = static_cast<const ExampleNode *>(node);
 
-    // Store current (active) writer
+    // Store current (active) writer and the page it writes to
     QXmlStreamWriter *currentWriter = m_writer;
+    QString currentPageText = std::exchange(m_pageText, QString());
+    const Node *currentPageNode = m_pageNode;
+    QString currentPageFileName = m_pageFileName;
     m_writer = startDocument(en, file);
     generateHeader(en->fullTitle(), en->subtitle(), en);
 
@@ -2321,6 +2265,9 @@ void DocBookGenerator::generateExampleFilePage(const Node *node, const QString &
     endDocument();
     // Restore writer
     m_writer = currentWriter;
+    m_pageText = std::move(currentPageText);
+    m_pageNode = currentPageNode;
+    m_pageFileName = currentPageFileName;
 }
 
 void DocBookGenerator::generateReimplementsClause(const FunctionNode *fn)
@@ -2415,16 +2362,21 @@ void DocBookGenerator::generateMaintainerList(const Aggregate *node)
 }
 
 /*!
-  Open a new file to write XML contents, including the DocBook
-  opening tag.
+  Start a new page to write XML contents, including the DocBook
+  opening tag. The page is streamed into a buffer that is reused
+  from page to page, and written out by endDocument().
  */
 QXmlStreamWriter *DocBookGenerator::startGenericDocument(const Node *node, const QString &fileName)
 {
-    QFile *outFile = openSubPageFile(node, fileName);
-    m_writer = new QXmlStreamWriter(outFile);
+    m_pageNode = node;
+    m_pageFileName = fileName;
+    m_pageText.resize(0);
+    // A writer on a string omits the encoding from the XML declaration,
+    // so write the declaration QXmlStreamWriter would write to a file.
+    m_pageText.append(QLatin1String("<?xml version=\"1.0\" encoding=\"UTF-8\"?>"));
+    m_writer = new QXmlStreamWriter(&m_pageText);
     m_writer->setAutoFormatting(false); // We need a precise handling of line feeds.
 
-    m_writer->writeStartDocument();
     newLine();
     m_writer->writeNamespace(dbNamespace, "db");
     m_writer->writeNamespace(xlinkNamespace, "xlink");
@@ -2456,10 +2408,10 @@ void DocBookGenerator::endDocument()
 {
     m_writer->writeEndElement(); // article
     m_writer->writeEndDocument();
-    m_writer->device()->close();
-    delete m_writer->device();
     delete m_writer;
     m_writer = nullptr;
+    writeSubPageFile(m_pageNode, m_pageFileName, m_pageText);
+    m_pageNode = nullptr;
 }
 
 /*!
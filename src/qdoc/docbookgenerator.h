@@ -165,6 +165,9 @@ private:
     QString m_naturalLanguage {};
     QString m_buildVersion {};
     QXmlStreamWriter *m_writer { nullptr };
+    QString m_pageText {};
+    const Node *m_pageNode { nullptr };
+    QString m_pageFileName {};
 
     Config *m_config { nullptr };
 };
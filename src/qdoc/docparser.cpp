@@ -33,6 +33,7 @@
 #include "editdistance.h"
 #include "macro.h"
 #include "openedlist.h"
+#include "regexpcache.h"
 #include "tokenizer.h"
 
 #include <QtCore/qfile.h>
@@ -265,6 +266,9 @@ QStringList DocParser::s_sourceDirs;
 QStringList DocParser::s_ignoreWords;
 bool DocParser::s_quoting = false;
 
+// The built-in command names, for suggesting one when a command is unknown
+static NameIndex s_commandIndex;
+
 static QString cleanLink(const QString &link)
 {
     qsizetype colonPos = link.indexOf(':');
@@ -287,6 +291,8 @@ void DocParser::initialize(const Config &config)
         cmds[i].alias = new QString(Doc::alias(cmds[i].english));
         s_utilities.cmdHash.insert(*cmds[i].alias, cmds[i].no);
 
+        s_commandIndex.insert(*cmds[i].alias);
+
         if (cmds[i].no != i)
             Location::internalError(QStringLiteral("command %1 missing").arg(i));
         ++i;
@@ -305,6 +311,8 @@ void DocParser::terminate()
     s_exampleDirs.clear();
     s_sourceFiles.clear();
     s_sourceDirs.clear();
+    Quoter::clearCache();
+    s_commandIndex.clear();
 
     int i = 0;
     while (cmds[i].english) {
@@ -1313,6 +1321,150 @@ void DocParser::parse(const QString &source, DocPrivate *docPrivate,
     m_private->m_text.stripFirstAtom();
 }
 
+/*!
+  Scans \a source for the metacommands in \a metaCommandSet and
+  the topics in \a possibleTopics without building the Text of
+  \a docPrivate. The metacommands, their arguments, and the topics
+  are recorded in \a docPrivate exactly as parse() would record them.
+
+  Returns \c false if \a source contains anything that could make
+  the result differ from a full parse, such as macros, conditional
+  blocks, included text, or metacommands that are not at the start
+  of a line. \a docPrivate must then be parsed with parse().
+ */
+bool DocParser::scanMetaCommands(const QString &source, DocPrivate *docPrivate,
+                                 const QSet<QString> &metaCommandSet,
+                                 const QSet<QString> &possibleTopics)
+{
+    m_input = source;
+    m_position = 0;
+    m_inputLength = m_input.length();
+    m_cachedLocation = docPrivate->m_start_loc;
+    m_cachedPosition = 0;
+    m_private = docPrivate;
+    m_private->m_topics.clear();
+
+    int braceDepth = 0;
+    bool atLineStart = true;
+
+    while (m_position < m_inputLength) {
+        const QChar ch = m_input.at(m_position);
+        if (ch == '\n') {
+            atLineStart = true;
+            ++m_position;
+            continue;
+        }
+        if (ch.isSpace()) {
+            ++m_position;
+            continue;
+        }
+        if (ch == '{') {
+            ++braceDepth;
+        } else if (ch == '}') {
+            --braceDepth;
+        } else if (ch == '/' && m_input.mid(m_position, 3) == QLatin1String("//!")) {
+            m_position += 2;
+            getRestOfLine();
+            atLineStart = true;
+            continue;
+        } else if (ch == '\\') {
+            QString cmdStr;
+            ++m_position;
+            while (m_position < m_inputLength && m_input.at(m_position).isLetterOrNumber())
+                cmdStr += m_input.at(m_position++);
+            if (cmdStr.isEmpty()) {
+                ++m_position;
+                atLineStart = false;
+                continue;
+            }
+
+            const int cmd = s_utilities.cmdHash.value(cmdStr, NOT_A_CMD);
+            switch (cmd) {
+            case CMD_BADCODE:
+            case CMD_CODE:
+            case CMD_QML:
+            case CMD_JS:
+            case CMD_OMIT: {
+                // Skipped like parse() does; metacommands in them never apply.
+                const QRegularExpression rx =
+                        RegExpCache::get("\\\\" + cmdName(endCmdFor(cmd)) + "\\b");
+                auto match = rx.match(m_input, m_position);
+                if (!match.hasMatch())
+                    return false;
+                m_position = match.capturedEnd();
+                break;
+            }
+            case CMD_IF:
+            case CMD_ELSE:
+            case CMD_ENDIF:
+            case CMD_INCLUDE:
+            case CMD_INPUT:
+            case CMD_OLDCODE:
+            case CMD_NEWCODE:
+            case CMD_RAW:
+            case CMD_META:
+            case CMD_TARGET:
+            case CMD_KEYWORD:
+            case CMD_LEGALESE:
+            case CMD_SECTION1:
+            case CMD_SECTION2:
+            case CMD_SECTION3:
+            case CMD_SECTION4:
+            case CMD_QUOTEFILE:
+                return false;
+            case CMD_OVERLOAD:
+            case NOT_A_CMD: {
+                if (cmd == NOT_A_CMD && !metaCommandSet.contains(cmdStr)) {
+                    if (s_utilities.macroHash.contains(cmdStr))
+                        return false;
+                    break;
+                }
+                if (!atLineStart || braceDepth > 0)
+                    return false;
+                QString arg;
+                QString bracketedArg;
+                if (cmd == NOT_A_CMD && isLeftBracketAhead())
+                    bracketedArg = getBracketedArgument();
+
+                // The argument must not contain commands or macros, which
+                // only a full parse expands.
+                qsizetype endOfLine = m_input.indexOf(QLatin1Char('\n'), m_position);
+                if (endOfLine == -1)
+                    endOfLine = m_inputLength;
+                if (m_input.mid(m_position, endOfLine - m_position).contains(QLatin1Char('\\')))
+                    return false;
+
+                m_private->m_metacommandsUsed.insert(cmdStr);
+                if (cmd == CMD_OVERLOAD) {
+                    if (!isBlankLine())
+                        arg = getRestOfLine();
+                    if (arg.isEmpty())
+                        arg = getMetaCommandArgument(cmdStr);
+                } else {
+                    if (m_position >= m_inputLength
+                        || (cmdStr != QLatin1String("obsolete")
+                            && cmdStr != QLatin1String("deprecated")))
+                        arg = getMetaCommandArgument(cmdStr);
+                }
+                m_private->m_metaCommandMap[cmdStr].append(ArgPair(arg, bracketedArg));
+                if (possibleTopics.contains(cmdStr)
+                    && !cmdStr.endsWith(QLatin1String("propertygroup")))
+                    m_private->m_topics.append(Topic(cmdStr, arg));
+                atLineStart = m_input.at(m_position - 1) == QLatin1Char('\n');
+                continue;
+            }
+            default:
+                break;
+            }
+            atLineStart = false;
+            continue;
+        }
+        atLineStart = false;
+        ++m_position;
+    }
+    return true;
+}
+
 /*!
   Returns the current location.
  */
@@ -1329,19 +1481,18 @@ Location &DocParser::location()
 
 QString DocParser::detailsUnknownCommand(const QSet<QString> &metaCommandSet, const QString &str)
 {
-    QSet<QString> commandSet = metaCommandSet;
-    int i = 0;
-    while (cmds[i].english != nullptr) {
-        commandSet.insert(*cmds[i].alias);
-        ++i;
-    }
-
     if (s_utilities.aliasMap.contains(str))
         return QStringLiteral("The command '\\%1' was renamed '\\%2' by the configuration"
                               " file. Use the new name.")
                 .arg(str, s_utilities.aliasMap[str]);
 
-    QString best = nearestName(str, commandSet);
+    // The built-in commands are looked up in the index built by initialize().
+    QSet<QString> metaCommands;
+    for (const auto &command : metaCommandSet) {
+        if (!s_utilities.cmdHash.contains(command))
+            metaCommands.insert(command);
+    }
+    QString best = s_commandIndex.nearestName(str, metaCommands);
     if (best.isEmpty())
         return QString();
     return QStringLiteral("Maybe you meant '\\%1'?").arg(best);
@@ -1373,6 +1524,7 @@ void DocParser::include(const QString &fileName, const QString &identifier, cons
     if (filePath.isEmpty()) {
         location().warning(QStringLiteral("Cannot find qdoc include file '%1'").arg(fileName));
     } else {
+        Config::instance().addInputFile(filePath);
         QFile inFile(filePath);
         if (!inFile.open(QFile::ReadOnly)) {
             location().warning(
@@ -1948,7 +2100,7 @@ QString DocParser::expandMacroToString(const QString &name, const QString &def,
         return rawString;
 
     QString result;
-    QRegularExpression re(matchExpr);
+    const QRegularExpression re = RegExpCache::get(matchExpr);
     int capStart = (re.captureCount() > 0) ? 1 : 0;
     qsizetype i = 0;
     QRegularExpressionMatch match;
@@ -2216,7 +2368,7 @@ QString DocParser::getMetaCommandArgument(const QString &cmdStr)
 QString DocParser::getUntilEnd(int cmd)
 {
     int endCmd = endCmdFor(cmd);
-    QRegularExpression rx("\\\\" + cmdName(endCmd) + "\\b");
+    const QRegularExpression rx = RegExpCache::get("\\\\" + cmdName(endCmd) + "\\b");
     QString t;
     auto match = rx.match(m_input, m_position);
 
@@ -2340,8 +2492,9 @@ void DocParser::skipAllSpaces()
 
 void DocParser::skipToNextPreprocessorCommand()
 {
-    QRegularExpression rx("\\\\(?:" + cmdName(CMD_IF) + QLatin1Char('|') + cmdName(CMD_ELSE)
-                          + QLatin1Char('|') + cmdName(CMD_ENDIF) + ")\\b");
+    const QRegularExpression rx =
+            RegExpCache::get("\\\\(?:" + cmdName(CMD_IF) + QLatin1Char('|') + cmdName(CMD_ELSE)
+                             + QLatin1Char('|') + cmdName(CMD_ENDIF) + ")\\b");
     auto match = rx.match(m_input, m_position + 1); // ### + 1 necessary?
 
     if (!match.hasMatch())
@@ -52,6 +52,9 @@ class DocParser
 public:
     void parse(const QString &source, DocPrivate *docPrivate, const QSet<QString> &metaCommandSet,
                const QSet<QString> &possibleTopics);
+    bool scanMetaCommands(const QString &source, DocPrivate *docPrivate,
+                          const QSet<QString> &metaCommandSet,
+                          const QSet<QString> &possibleTopics);
 
     static void initialize(const Config &config);
     static void terminate();
@@ -27,6 +27,7 @@
 ****************************************************************************/
 #include "docprivate.h"
 
+#include "docparser.h"
 #include "text.h"
 
 #include <QtCore/qhash.h>
@@ -52,4 +53,39 @@ void DocPrivate::constructExtra()
         extra = new DocPrivateExtra;
 }
 
+/*!
+  Records that the text of this doc has not been parsed yet.
+  Only the metacommands and topics were scanned. The text is
+  parsed with \a metaCommandSet and \a possibleTopics the first
+  time ensureParsed() is called.
+ */
+void DocPrivate::deferParse(const QSet<QString> &metaCommandSet,
+                            const QSet<QString> &possibleTopics)
+{
+    m_deferredMetaCommands = metaCommandSet;
+    m_deferredTopics = possibleTopics;
+    m_parseState.pending = true;
+}
+
+/*!
+  Parses the text of this doc if its parsing was deferred.
+  The scanned metacommands are discarded and rebuilt by the
+  full parse. Concurrent callers wait until the parse is done.
+ */
+void DocPrivate::ensureParsed()
+{
+    if (!m_parseState.pending.load(std::memory_order_acquire))
+        return;
+    QMutexLocker locker(&m_parseState.mutex);
+    if (!m_parseState.pending.load(std::memory_order_relaxed))
+        return;
+    m_metacommandsUsed.clear();
+    m_metaCommandMap.clear();
+    DocParser parser;
+    parser.parse(m_src, this, m_deferredMetaCommands, m_deferredTopics);
+    m_deferredMetaCommands.clear();
+    m_deferredTopics.clear();
+    m_parseState.pending.store(false, std::memory_order_release);
+}
+
 QT_END_NAMESPACE
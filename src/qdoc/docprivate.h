@@ -45,8 +45,10 @@
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qhash.h>
 #include <QtCore/qmap.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qtextstream.h>
 
+#include <atomic>
 #include <cctype>
 #include <climits>
 #include <utility>
@@ -69,11 +71,14 @@ class DocPrivate
 public:
     explicit DocPrivate(const Location &start = Location(), const Location &end = Location(),
                         QString source = QString())
-        : m_start_loc(start), m_end_loc(end), m_src(std::move(source)), m_hasLegalese(false) {};
+        : m_start_loc(start), m_end_loc(end), m_src(std::move(source)),
+          m_hasLegalese(false) {};
     ~DocPrivate();
 
     void addAlso(const Text &also);
     void constructExtra();
+    void deferParse(const QSet<QString> &metaCommandSet, const QSet<QString> &possibleTopics);
+    void ensureParsed();
     void ref() { ++count; }
     bool deref() { return (--count == 0); }
 
@@ -91,6 +96,25 @@ public:
     CommandMap m_metaCommandMap {};
     DocPrivateExtra *extra { nullptr };
     TopicList m_topics {};
+    QSet<QString> m_deferredMetaCommands {};
+    QSet<QString> m_deferredTopics {};
+
+    // Docs are read from worker threads, so the deferred parse is guarded.
+    // A copy takes over the pending state but not the lock.
+    struct ParseState
+    {
+        ParseState() = default;
+        ParseState(const ParseState &other) : pending(other.pending.load()) {}
+        ParseState &operator=(const ParseState &other)
+        {
+            pending = other.pending.load();
+            return *this;
+        }
+
+        std::atomic<bool> pending { false };
+        QMutex mutex;
+    };
+    ParseState m_parseState {};
 
     bool m_hasLegalese : 1;
 };
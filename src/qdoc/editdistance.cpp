@@ -28,63 +28,187 @@
 
 #include "editdistance.h"
 
+#include <QtCore/qvarlengtharray.h>
+
+#include <algorithm>
+#include <cstdlib>
+
 QT_BEGIN_NAMESPACE
 
 int editDistance(const QString &s, const QString &t)
 {
-#define D(i, j) d[(i)*n + (j)]
-    int i;
-    int j;
-    qsizetype m = s.length() + 1;
-    qsizetype n = t.length() + 1;
-    int *d = new int[m * n];
-    int result;
-
-    for (i = 0; i < m; ++i)
-        D(i, 0) = i;
-    for (j = 0; j < n; ++j)
-        D(0, j) = j;
-    for (i = 1; i < m; ++i) {
-        for (j = 1; j < n; ++j) {
-            if (s[i - 1] == t[j - 1]) {
-                D(i, j) = D(i - 1, j - 1);
-            } else {
-                int x = D(i - 1, j);
-                int y = D(i - 1, j - 1);
-                int z = D(i, j - 1);
-                D(i, j) = 1 + qMin(qMin(x, y), z);
-            }
+    return editDistance(s, t, int(std::max(s.length(), t.length())));
+}
+
+/*
+  Returns the edit distance between \a s and \a t, or
+  \a maxDistance + 1 if it is larger than \a maxDistance. Only two
+  rows of the distance matrix are kept, and the computation stops as
+  soon as a whole row exceeds \a maxDistance.
+ */
+int editDistance(const QString &s, const QString &t, int maxDistance)
+{
+    const qsizetype m = s.length();
+    const qsizetype n = t.length();
+    if (std::abs(m - n) > maxDistance)
+        return maxDistance + 1;
+
+    QVarLengthArray<int, 128> rows(2 * (n + 1));
+    int *previous = rows.data();
+    int *current = previous + n + 1;
+    for (qsizetype j = 0; j <= n; ++j)
+        previous[j] = int(j);
+    for (qsizetype i = 1; i <= m; ++i) {
+        current[0] = int(i);
+        int rowMinimum = current[0];
+        for (qsizetype j = 1; j <= n; ++j) {
+            if (s[i - 1] == t[j - 1])
+                current[j] = previous[j - 1];
+            else
+                current[j] = 1 + std::min({ previous[j], previous[j - 1], current[j - 1] });
+            rowMinimum = std::min(rowMinimum, current[j]);
         }
+        if (rowMinimum > maxDistance)
+            return maxDistance + 1;
+        std::swap(previous, current);
     }
-    result = D(m - 1, n - 1);
-    delete[] d;
-    return result;
-#undef D
+    return std::min(previous[n], maxDistance + 1);
 }
 
+/*
+  The largest edit distance for which a suggestion is made.
+ */
+static constexpr int MaxSuggestionDistance = 2;
+
 QString nearestName(const QString &actual, const QSet<QString> &candidates)
 {
+    QList<std::pair<QString, int>> matches;
+    NameIndex::appendNamesWithin(actual, candidates, MaxSuggestionDistance, matches);
+    return NameIndex::bestMatch(actual, matches);
+}
+
+NameIndex::NameIndex(const QSet<QString> &names)
+{
+    for (const auto &name : names)
+        insert(name);
+}
+
+/*
+  Inserts \a name into the tree of names that begin with the same
+  character.
+ */
+void NameIndex::insert(const QString &name)
+{
+    if (name.isEmpty())
+        return;
+    auto root = m_roots.constFind(name[0]);
+    if (root == m_roots.cend()) {
+        m_roots.insert(name[0], m_nodes.size());
+        m_nodes.append(TreeNode { name, {} });
+        return;
+    }
+
+    qsizetype index = *root;
+    while (true) {
+        const int delta = editDistance(name, m_nodes.at(index).m_name);
+        if (delta == 0)
+            return;
+        const auto &children = m_nodes.at(index).m_children;
+        auto child = std::find_if(children.cbegin(), children.cend(),
+                                  [delta](const auto &c) { return c.first == delta; });
+        if (child == children.cend()) {
+            m_nodes[index].m_children.append(std::make_pair(delta, m_nodes.size()));
+            m_nodes.append(TreeNode { name, {} });
+            return;
+        }
+        index = child->second;
+    }
+}
+
+/*
+  Returns the names that begin with the same character as \a actual
+  and are within \a maxDistance edits of it, with their distances.
+  By the triangle inequality, only the subtrees whose distance to
+  their parent differs by at most \a maxDistance from the distance
+  between \a actual and the parent can contain such names.
+ */
+QList<std::pair<QString, int>> NameIndex::namesWithin(const QString &actual,
+                                                      int maxDistance) const
+{
+    QList<std::pair<QString, int>> matches;
     if (actual.isEmpty())
-        return QString();
+        return matches;
+    auto root = m_roots.constFind(actual[0]);
+    if (root == m_roots.cend())
+        return matches;
 
-    int deltaBest = 10000;
-    int numBest = 0;
-    QString best;
+    QList<qsizetype> stack { *root };
+    while (!stack.isEmpty()) {
+        const TreeNode &node = m_nodes.at(stack.takeLast());
+        const int delta = editDistance(actual, node.m_name);
+        if (delta <= maxDistance)
+            matches.append(std::make_pair(node.m_name, delta));
+        for (const auto &child : node.m_children) {
+            if (std::abs(child.first - delta) <= maxDistance)
+                stack.append(child.second);
+        }
+    }
+    return matches;
+}
 
+/*
+  Appends the names in \a candidates that begin with the same
+  character as \a actual and are within \a maxDistance edits of it
+  to \a matches, comparing \a actual to each of them.
+ */
+void NameIndex::appendNamesWithin(const QString &actual, const QSet<QString> &candidates,
+                                  int maxDistance, QList<std::pair<QString, int>> &matches)
+{
+    if (actual.isEmpty())
+        return;
     for (const auto &candidate : candidates) {
-        if (candidate[0] == actual[0]) {
-            int delta = editDistance(actual, candidate);
-            if (delta < deltaBest) {
-                deltaBest = delta;
-                numBest = 1;
-                best = candidate;
-            } else if (delta == deltaBest) {
-                ++numBest;
-            }
+        if (!candidate.isEmpty() && candidate[0] == actual[0]) {
+            const int delta = editDistance(actual, candidate, maxDistance);
+            if (delta <= maxDistance)
+                matches.append(std::make_pair(candidate, delta));
+        }
+    }
+}
+
+/*
+  Returns the name in the index or in \a otherNames to suggest for
+  the misspelled name \a actual, or an empty string if there is no
+  single best suggestion. \a otherNames should not contain names
+  that are also in the index.
+ */
+QString NameIndex::nearestName(const QString &actual, const QSet<QString> &otherNames) const
+{
+    QList<std::pair<QString, int>> matches = namesWithin(actual, MaxSuggestionDistance);
+    appendNamesWithin(actual, otherNames, MaxSuggestionDistance, matches);
+    return bestMatch(actual, matches);
+}
+
+/*
+  Returns the name in \a matches that is closest to \a actual,
+  provided no other name is as close and suggesting it makes sense.
+  Otherwise returns an empty string.
+ */
+QString NameIndex::bestMatch(const QString &actual, const QList<std::pair<QString, int>> &matches)
+{
+    int deltaBest = MaxSuggestionDistance + 1;
+    int numBest = 0;
+    QString best;
+    for (const auto &match : matches) {
+        if (match.second < deltaBest) {
+            deltaBest = match.second;
+            numBest = 1;
+            best = match.first;
+        } else if (match.second == deltaBest) {
+            ++numBest;
         }
     }
 
-    if (numBest == 1 && deltaBest <= 2 && actual.length() + best.length() >= 5)
+    if (numBest == 1 && actual.length() + best.length() >= 5)
         return best;
 
     return QString();
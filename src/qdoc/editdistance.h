@@ -29,14 +29,55 @@
 #ifndef EDITDISTANCE_H
 #define EDITDISTANCE_H
 
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
 #include <QtCore/qset.h>
 #include <QtCore/qstring.h>
 
+#include <utility>
+
 QT_BEGIN_NAMESPACE
 
 int editDistance(const QString &s, const QString &t);
+int editDistance(const QString &s, const QString &t, int maxDistance);
 QString nearestName(const QString &actual, const QSet<QString> &candidates);
 
+/*
+  A BK-tree over a set of names, for finding the names that are
+  within a small edit distance of a misspelled one without computing
+  the distance to every name. Build it once for a set of names that
+  is queried repeatedly.
+ */
+class NameIndex
+{
+public:
+    NameIndex() = default;
+    explicit NameIndex(const QSet<QString> &names);
+
+    void insert(const QString &name);
+    void clear() { m_nodes.clear(); m_roots.clear(); }
+    [[nodiscard]] bool isEmpty() const { return m_nodes.isEmpty(); }
+    [[nodiscard]] QList<std::pair<QString, int>> namesWithin(const QString &actual,
+                                                             int maxDistance) const;
+    [[nodiscard]] QString nearestName(const QString &actual,
+                                      const QSet<QString> &otherNames = QSet<QString>()) const;
+
+    static void appendNamesWithin(const QString &actual, const QSet<QString> &candidates,
+                                  int maxDistance, QList<std::pair<QString, int>> &matches);
+    static QString bestMatch(const QString &actual,
+                             const QList<std::pair<QString, int>> &matches);
+
+private:
+    struct TreeNode
+    {
+        QString m_name;
+        QList<std::pair<int, qsizetype>> m_children; // distance, index in m_nodes
+    };
+
+    QList<TreeNode> m_nodes;
+    QHash<QChar, qsizetype> m_roots; // one tree per first character
+};
+
 QT_END_NAMESPACE
 
 #endif
@@ -45,15 +45,25 @@
 #include "qdocdatabase.h"
 #include "qmltypenode.h"
 #include "quoter.h"
+#include "sections.h"
 #include "sharedcommentnode.h"
+#include "tasks.h"
+#include "timings.h"
 #include "tokenizer.h"
 #include "typedefnode.h"
 #include "utilities.h"
 
+#include <QtCore/qdatetime.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qregularexpression.h>
 
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <memory>
+
 #ifndef QT_BOOTSTRAPPED
 #    include "QtCore/qurl.h"
 #endif
@@ -82,6 +92,16 @@ bool Generator::s_redirectDocumentationToDevNull = false;
 bool Generator::s_useOutputSubdirs = true;
 QmlTypeNode *Generator::s_qmlTypeContext = nullptr;
 
+struct CompactListCacheEntry
+{
+    NodeMultiMap m_source;
+    QString m_commonPrefix;
+    bool m_sortByLastName;
+    Generator::CompactList m_list;
+};
+
+static QList<CompactListCacheEntry> s_compactLists;
+
 static QRegularExpression tag("</?@[^>]*>");
 static QLatin1String amp("&amp;");
 static QLatin1String gt("&gt;");
@@ -184,6 +204,68 @@ int Generator::appendSortedNames(Text &text, const ClassNode *cn, const QList<Re
     return index;
 }
 
+/*!
+  Divides the nodes in \a nmm into the paragraphs of a compact
+  list: 0 to 9, A to Z and underscore (_), by the first character
+  of the last part of their names after \a commonPrefix. Within
+  a paragraph, the nodes are sorted by the last part of their
+  names, lowercased, if \a sortByLastName is \c true, and by their
+  keys in \a nmm otherwise. Empty paragraphs are left out.
+
+  The overview pages list the same collections from the database
+  on several pages and for each output format, so the result is
+  kept for as long as \a nmm is not modified, until terminate().
+ */
+Generator::CompactList Generator::compactList(const NodeMultiMap &nmm,
+                                              const QString &commonPrefix, bool sortByLastName)
+{
+    for (const auto &entry : qAsConst(s_compactLists)) {
+        if (entry.m_source.isSharedWith(nmm) && entry.m_commonPrefix == commonPrefix
+            && entry.m_sortByLastName == sortByLastName)
+            return entry.m_list;
+    }
+    // Forget the lists of maps that no longer exist elsewhere.
+    s_compactLists.removeIf(
+            [](const CompactListCacheEntry &entry) { return entry.m_source.isDetached(); });
+
+    /*
+      QAccel will fall in paragraph 10 (A) and QXtWidget in
+      paragraph 33 (X). This is the only place where we assume
+      that NumParagraphs is 37.
+    */
+    const int NumParagraphs = 37; // '0' to '9', 'A' to 'Z', '_'
+    const qsizetype commonPrefixLen = commonPrefix.length();
+    NodeMultiMap paragraph[NumParagraphs];
+    QString paragraphName[NumParagraphs];
+    CompactList list;
+
+    for (auto c = nmm.constBegin(); c != nmm.constEnd(); ++c) {
+        const QString lastPiece = c.key().section(QLatin1String("::"), -1);
+        qsizetype idx = commonPrefixLen;
+        if (idx > 0 && !lastPiece.startsWith(commonPrefix, Qt::CaseInsensitive))
+            idx = 0;
+        const QString last = lastPiece.toLower();
+        const QString key = last.mid(idx);
+
+        int paragraphNr = NumParagraphs - 1;
+        if (key[0].digitValue() != -1)
+            paragraphNr = key[0].digitValue();
+        else if (key[0] >= QLatin1Char('a') && key[0] <= QLatin1Char('z'))
+            paragraphNr = 10 + key[0].unicode() - 'a';
+
+        paragraphName[paragraphNr] = key[0].toUpper();
+        list.usedParagraphNames.insert(key[0].toLower().cell());
+        paragraph[paragraphNr].insert(sortByLastName ? last : c.key(), c.value());
+    }
+
+    for (int i = 0; i < NumParagraphs; ++i) {
+        if (!paragraph[i].isEmpty())
+            list.paragraphs.append({ paragraphName[i], paragraph[i].values() });
+    }
+    s_compactLists.append({ nmm, commonPrefix, sortByLastName, list });
+    return list;
+}
+
 int Generator::appendSortedQmlNames(Text &text, const Node *base, const NodeList &subs)
 {
     QMap<QString, Text> classMap;
@@ -215,6 +297,21 @@ int Generator::appendSortedQmlNames(Text &text, const Node *base, const NodeList
   \sa beginFilePage()
  */
 QFile *Generator::openSubPageFile(const Node *node, const QString &fileName)
+{
+    auto outFile = new QFile(subPageFilePath(node, fileName));
+
+    if (!outFile->open(QFile::WriteOnly)) {
+        node->location().fatal(
+                QStringLiteral("Cannot open output file '%1'").arg(outFile->fileName()));
+    }
+    return outFile;
+}
+
+/*!
+  Returns the path of the output file named \a fileName for
+  \a node, and records \a fileName in the list of output files.
+ */
+QString Generator::subPageFilePath(const Node *node, const QString &fileName)
 {
     QString path = outputDir() + QLatin1Char('/');
     if (Generator::useOutputSubdirs() && !node->outputSubdirectory().isEmpty()
@@ -224,19 +321,273 @@ QFile *Generator::openSubPageFile(const Node *node, const QString &fileName)
     path += fileName;
 
     auto outPath = s_redirectDocumentationToDevNull ? QStringLiteral("/dev/null") : path;
-    auto outFile = new QFile(outPath);
 
-    if (!s_redirectDocumentationToDevNull && outFile->exists())
-        qCDebug(lcQdoc) << "Output file already exists; overwriting" << qPrintable(outFile->fileName());
-
-    if (!outFile->open(QFile::WriteOnly)) {
-        node->location().fatal(
-                QStringLiteral("Cannot open output file '%1'").arg(outFile->fileName()));
-    }
+    if (!s_redirectDocumentationToDevNull && QFile::exists(outPath))
+        qCDebug(lcQdoc) << "Output file already exists; overwriting" << qPrintable(outPath);
 
     qCDebug(lcQdoc, "Writing: %s", qPrintable(path));
+    Timings::count(Timings::PagesWritten);
     s_outFileNames << fileName;
-    return outFile;
+    return outPath;
+}
+
+/*
+  Appends a ustar header for an entry named \a name with \a size
+  bytes of content to \a out. Names that don't fit the header are
+  stored in a preceding pax extended header.
+ */
+static void appendTarHeader(QByteArray &out, const QByteArray &name, qint64 size, qint64 mtime,
+                            char type = '0')
+{
+    QByteArray prefix;
+    QByteArray shortName = name;
+    if (name.size() > 100) {
+        qsizetype split = -1;
+        for (qsizetype i = name.lastIndexOf('/'); i > 0; i = name.lastIndexOf('/', i - 1)) {
+            if (i <= 155 && name.size() - i - 1 <= 100) {
+                split = i;
+                break;
+            }
+        }
+        if (split > 0) {
+            prefix = name.left(split);
+            shortName = name.mid(split + 1);
+        } else {
+            QByteArray record = " path=" + name + '\n';
+            qsizetype length = record.size();
+            while (QByteArray::number(length).size() + record.size() != length)
+                length = QByteArray::number(length).size() + record.size();
+            record.prepend(QByteArray::number(length));
+            appendTarHeader(out, "PaxHeader", record.size(), mtime, 'x');
+            out += record;
+            out.append((512 - record.size() % 512) % 512, '\0');
+            shortName = name.right(100);
+        }
+    }
+
+    char header[512] = {};
+    auto field = [&header](int offset, int width, const QByteArray &value) {
+        memcpy(header + offset, value.constData(), size_t(std::min<qsizetype>(width, value.size())));
+    };
+    auto octal = [&field](int offset, int width, qint64 value) {
+        field(offset, width, QByteArray::number(value, 8).rightJustified(width - 1, '0'));
+    };
+    field(0, 100, shortName);
+    octal(100, 8, 0644);
+    octal(108, 8, 0);
+    octal(116, 8, 0);
+    octal(124, 12, size);
+    octal(136, 12, mtime);
+    memset(header + 148, ' ', 8);
+    header[156] = type;
+    field(257, 6, QByteArray("ustar", 6));
+    field(263, 2, "00");
+    field(345, 155, prefix);
+
+    unsigned int checksum = 0;
+    for (char c : header)
+        checksum += uchar(c);
+    field(148, 6, QByteArray::number(checksum, 8).rightJustified(6, '0'));
+    header[154] = '\0';
+    out.append(header, sizeof(header));
+}
+
+/*
+  Writes finished text pages on worker threads when qdoc runs with
+  -jobs, so that encoding and file I/O overlap with generating the
+  next page. Pages are still generated one at a time on the main
+  thread. They are handed to the workers in batches, so that a
+  thread is started per batch rather than per page.
+
+  If the outputarchive variable is set, the pages are appended to
+  a single tar archive instead, one batch at a time and in the
+  order they are generated.
+ */
+class PageWriter
+{
+public:
+    void openArchive(const QString &archivePath, const QString &rootDir, const Location &location)
+    {
+        closeArchive();
+        m_archive = std::make_unique<QFile>(archivePath);
+        if (!m_archive->open(QFile::WriteOnly | QFile::Truncate)) {
+            location.fatal(QStringLiteral("Cannot open output archive '%1'").arg(archivePath));
+            m_archive.reset();
+            return;
+        }
+        m_archiveRoot = rootDir + QLatin1Char('/');
+        m_archiveTime = QDateTime::currentSecsSinceEpoch();
+    }
+
+    void closeArchive()
+    {
+        waitForFinished();
+        if (m_archive) {
+            m_archive->write(QByteArray(1024, '\0'));
+            m_archive.reset();
+        }
+    }
+
+    [[nodiscard]] bool isArchiving() const { return m_archive != nullptr; }
+
+    void write(const QString &path, QString &&text, const Location &location)
+    {
+        // Keep a page that overwrites an earlier one from racing against it.
+        if (!m_archive && isPending(path))
+            waitForFinished();
+        m_batchBytes += text.size();
+        m_batch.m_paths.append(path);
+        m_batch.m_locations.append(location);
+        m_batch.m_texts.append(std::move(text));
+        if (m_batch.m_paths.size() >= MaxBatchPages || m_batchBytes >= MaxBatchBytes)
+            flushBatch();
+    }
+
+    void waitForFinished()
+    {
+        flushBatch();
+        while (!m_pending.empty())
+            finishOldest();
+    }
+
+private:
+    static constexpr qsizetype MaxBatchPages = 32;
+    static constexpr qsizetype MaxBatchBytes = 4 * 1024 * 1024;
+
+    struct Batch
+    {
+        QStringList m_paths;
+        QList<Location> m_locations;
+        QStringList m_texts;
+    };
+
+    struct PendingBatch
+    {
+        QStringList m_paths;
+        QList<Location> m_locations;
+        std::future<QList<qsizetype>> m_failed; // indexes of the pages that couldn't be written
+    };
+
+    [[nodiscard]] bool isPending(const QString &path) const
+    {
+        return std::any_of(m_pending.cbegin(), m_pending.cend(),
+                           [&path](const PendingBatch &batch) {
+                               return batch.m_paths.contains(path);
+                           });
+    }
+
+    void flushBatch()
+    {
+        if (m_batch.m_paths.isEmpty())
+            return;
+        // Archive entries must be appended one batch at a time.
+        const size_t maxPending = m_archive ? 1 : size_t(Config::instance().jobs());
+        while (!m_pending.empty() && m_pending.size() >= maxPending)
+            finishOldest();
+
+        PendingBatch pending { m_batch.m_paths, m_batch.m_locations, {} };
+        if (m_archive) {
+            QByteArrayList names;
+            for (const auto &path : qAsConst(m_batch.m_paths)) {
+                names.append((path.startsWith(m_archiveRoot) ? path.mid(m_archiveRoot.size())
+                                                             : path).toUtf8());
+            }
+            pending.m_failed = Tasks::run([archive = m_archive.get(), names,
+                                           texts = std::move(m_batch.m_texts),
+                                           mtime = m_archiveTime]() {
+                QList<qsizetype> failed;
+                QByteArray out;
+                for (qsizetype i = 0; i < texts.size(); ++i) {
+                    const QByteArray data = texts.at(i).toUtf8();
+                    appendTarHeader(out, names.at(i), data.size(), mtime);
+                    out += data;
+                    out.append((512 - data.size() % 512) % 512, '\0');
+                }
+                if (archive->write(out) != out.size())
+                    failed.append(0);
+                return failed;
+            });
+        } else {
+            pending.m_failed = Tasks::run([paths = m_batch.m_paths,
+                                           texts = std::move(m_batch.m_texts)]() {
+                QList<qsizetype> failed;
+                for (qsizetype i = 0; i < paths.size(); ++i) {
+                    QFile file(paths.at(i));
+                    if (!file.open(QFile::WriteOnly))
+                        failed.append(i);
+                    else
+                        file.write(texts.at(i).toUtf8());
+                }
+                return failed;
+            });
+        }
+        m_pending.push_back(std::move(pending));
+        m_batch = Batch();
+        m_batchBytes = 0;
+    }
+
+    void finishOldest()
+    {
+        PendingBatch batch = std::move(m_pending.front());
+        m_pending.pop_front();
+        const QList<qsizetype> failed = batch.m_failed.get();
+        if (failed.isEmpty())
+            return;
+        const qsizetype first = failed.first();
+        if (m_archive) {
+            batch.m_locations.at(first).fatal(
+                    QStringLiteral("Cannot write to output archive '%1'").arg(m_archive->fileName()));
+        } else {
+            batch.m_locations.at(first).fatal(
+                    QStringLiteral("Cannot open output file '%1'").arg(batch.m_paths.at(first)));
+        }
+    }
+
+    Batch m_batch;
+    qsizetype m_batchBytes { 0 };
+    std::deque<PendingBatch> m_pending;
+    std::unique_ptr<QFile> m_archive;
+    QString m_archiveRoot;
+    qint64 m_archiveTime { 0 };
+};
+
+static PageWriter s_pageWriter;
+
+// The example images being copied in the background, oldest first.
+static std::deque<std::future<void>> s_pendingImageCopies;
+
+/*!
+  Waits until no more than \a maxPending image copies are running.
+ */
+static void waitForImageCopies(size_t maxPending = 0)
+{
+    while (s_pendingImageCopies.size() > maxPending) {
+        s_pendingImageCopies.front().get();
+        s_pendingImageCopies.pop_front();
+    }
+}
+
+/*!
+  Writes \a text as the output file named \a fileName for
+  \a node. When pages are written in the background, \a text is
+  handed over to the page writer and left empty. Otherwise the
+  file is written immediately and \a text is truncated but keeps
+  its capacity, so that the caller can reuse it for the next page.
+ */
+void Generator::writeSubPageFile(const Node *node, const QString &fileName, QString &text)
+{
+    const QString path = subPageFilePath(node, fileName);
+    if (Config::instance().jobs() > 1 || s_pageWriter.isArchiving()) {
+        s_pageWriter.write(path, std::move(text), node->location());
+        text = QString();
+        return;
+    }
+
+    QFile file(path);
+    if (!file.open(QFile::WriteOnly))
+        node->location().fatal(QStringLiteral("Cannot open output file '%1'").arg(path));
+    file.write(text.toUtf8());
+    text.resize(0);
 }
 
 /*!
@@ -249,8 +600,17 @@ QFile *Generator::openSubPageFile(const Node *node, const QString &fileName)
  */
 void Generator::beginFilePage(const Node *node, const QString &fileName)
 {
-    QFile *outFile = openSubPageFile(node, fileName);
-    auto *out = new QTextStream(outFile);
+    QTextStream *out = nullptr;
+    if (Config::instance().jobs() > 1 || s_pageWriter.isArchiving()) {
+        m_outFilePaths.push(subPageFilePath(node, fileName));
+        m_outLocations.push(node->location());
+        out = new QTextStream(new QString, QIODevice::WriteOnly);
+    } else {
+        QFile *outFile = openSubPageFile(node, fileName);
+        m_outFilePaths.push(outFile->fileName());
+        m_outLocations.push(node->location());
+        out = new QTextStream(outFile);
+    }
     outStreamStack.push(out);
 }
 
@@ -278,9 +638,17 @@ void Generator::beginSubPage(const Node *node, const QString &fileName)
  */
 void Generator::endSubPage()
 {
-    outStreamStack.top()->flush();
-    delete outStreamStack.top()->device();
-    delete outStreamStack.pop();
+    QTextStream *out = outStreamStack.pop();
+    const QString path = m_outFilePaths.pop();
+    const Location location = m_outLocations.pop();
+    out->flush();
+    if (QString *text = out->string()) {
+        s_pageWriter.write(path, std::move(*text), location);
+        delete text;
+    } else {
+        delete out->device();
+    }
+    delete out;
 }
 
 /*
@@ -498,6 +866,10 @@ QMap<QString, QString> &Generator::formattingRightMap()
 
 /*!
   Returns the full document location.
+
+  The result only depends on the node and on the output settings
+  of the format, and a node is linked from many pages, so it is
+  computed once per node and format.
  */
 QString Generator::fullDocumentLocation(const Node *node, bool useSubdir)
 {
@@ -505,6 +877,18 @@ QString Generator::fullDocumentLocation(const Node *node, bool useSubdir)
         return QString();
     if (!node->url().isEmpty())
         return node->url();
+    if (currentGenerator() != this)
+        return computeFullDocumentLocation(node, useSubdir);
+
+    auto &locations = m_fullDocumentLocations[useSubdir ? 1 : 0];
+    auto it = locations.constFind(node);
+    if (it == locations.constEnd())
+        it = locations.insert(node, computeFullDocumentLocation(node, useSubdir));
+    return it.value();
+}
+
+QString Generator::computeFullDocumentLocation(const Node *node, bool useSubdir)
+{
 
     QString parentName;
     QString anchorRef;
@@ -961,7 +1345,18 @@ void Generator::addImageToCopy(const ExampleNode *en, const QString &file)
     QString imgOutDir = s_outDir + prefix + userFriendlyFilePath;
     if (!dirInfo.mkpath(imgOutDir))
         en->location().fatal(QStringLiteral("Cannot create output directory '%1'").arg(imgOutDir));
-    Config::copyFile(en->location(), srcPath, file, imgOutDir);
+
+    // With several jobs, copy on a worker thread while the pages are generated.
+    const int jobs = Config::instance().jobs();
+    if (jobs < 2) {
+        Config::copyFile(en->location(), srcPath, file, imgOutDir);
+        return;
+    }
+    waitForImageCopies(size_t(jobs) - 1);
+    s_pendingImageCopies.push_back(
+            Tasks::run([location = en->location(), srcPath, file, imgOutDir]() {
+                Config::copyFile(location, srcPath, file, imgOutDir);
+            }));
 }
 
 /*!
@@ -988,6 +1383,8 @@ void Generator::generateFileList(const ExampleNode *en, CodeMarker *marker, bool
         tag = "Files:";
     }
     std::sort(paths.begin(), paths.end(), Generator::comparePaths);
+    if (!images)
+        Doc::prefetchFiles(en->doc().location(), paths);
 
     text << Atom::ParaLeft << tag << Atom::ParaRight;
     text << Atom(Atom::ListLeft, openedList.styleString());
@@ -1558,6 +1955,8 @@ void Generator::generateDocs()
 {
     s_currentGenerator = this;
     generateDocumentation(m_qdb->primaryTreeRoot());
+    waitForImageCopies();
+    s_pageWriter.waitForFinished();
 }
 
 Generator *Generator::generatorForFormat(const QString &format)
@@ -1689,6 +2088,10 @@ void Generator::initialize()
     s_outDir = config.getOutputDir();
     s_outSubdir = s_outDir.mid(s_outDir.lastIndexOf('/') + 1);
 
+    const QString archivePath = config.getString(CONFIG_OUTPUTARCHIVE);
+    if (!archivePath.isEmpty() && !s_redirectDocumentationToDevNull)
+        s_pageWriter.openArchive(archivePath, s_outDir, config.lastLocation());
+
     s_outputPrefixes.clear();
     QStringList items = config.getStringList(CONFIG_OUTPUTPREFIXES);
     if (!items.isEmpty()) {
@@ -1710,7 +2113,8 @@ void Generator::initialize()
 
 /*!
   Creates template-specific subdirs (e.g. /styles and /scripts for HTML)
-  and copies the files to them.
+  and copies the files to them. With several jobs, the files are copied
+  in parallel.
   */
 void Generator::copyTemplateFiles(const QString &configVar, const QString &subDir)
 {
@@ -1723,10 +2127,12 @@ void Generator::copyTemplateFiles(const QString &configVar, const QString &subDi
             config.lastLocation().fatal(
                     QStringLiteral("Cannot create %1 directory '%2'").arg(subDir, templateDir));
         } else {
-            for (const auto &file : files) {
-                if (!file.isEmpty())
-                    Config::copyFile(config.lastLocation(), file, file, templateDir);
-            }
+            const Location location = config.lastLocation();
+            files.removeAll(QString());
+            files.removeDuplicates();
+            Tasks::forEach(files.size(), [&](qsizetype i) {
+                Config::copyFile(location, files.at(i), files.at(i), templateDir);
+            });
         }
     }
 }
@@ -1739,6 +2145,8 @@ void Generator::copyTemplateFiles(const QString &configVar, const QString &subDi
 void Generator::initializeFormat()
 {
     Config &config = Config::instance();
+    for (auto &locations : m_fullDocumentLocations)
+        locations.clear();
     s_outFileNames.clear();
     s_useOutputSubdirs = true;
     if (config.getBool(format() + Config::dot + "nosubdirs"))
@@ -1757,7 +2165,7 @@ void Generator::initializeFormat()
 
     QDir outputDir(s_outDir);
     if (outputDir.exists()) {
-        if (!config.generating() && Generator::useOutputSubdirs()) {
+        if (!config.generating() && !config.incremental() && Generator::useOutputSubdirs()) {
             if (!outputDir.isEmpty())
                 config.lastLocation().error(
                         QStringLiteral("Output directory '%1' exists but is not empty")
@@ -1825,7 +2233,7 @@ QTextStream &Generator::out()
 
 QString Generator::outFileName()
 {
-    return QFileInfo(static_cast<QFile *>(out().device())->fileName()).fileName();
+    return QFileInfo(m_outFilePaths.top()).fileName();
 }
 
 QString Generator::outputPrefix(const Node *node)
@@ -2032,10 +2440,13 @@ void Generator::supplementAlsoList(const Node *node, QList<Text> &alsoList)
 
 void Generator::terminate()
 {
+    s_pageWriter.closeArchive();
     for (const auto &generator : qAsConst(s_generators)) {
         if (s_outputFormats.contains(generator->format()))
             generator->terminateGenerator();
     }
+    Sections::clearInheritedMembers();
+    s_compactLists.clear();
 
     s_fmtLeftMaps.clear();
     s_fmtRightMaps.clear();
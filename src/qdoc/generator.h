@@ -34,6 +34,7 @@
 
 #include <QtCore/qlist.h>
 #include <QtCore/qmap.h>
+#include <QtCore/qset.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qstringlist.h>
 #include <QtCore/qtextstream.h>
@@ -57,6 +58,18 @@ class Generator
 public:
     enum ListType { Generic, Obsolete };
 
+    struct CompactListParagraph
+    {
+        QString name;
+        NodeList nodes;
+    };
+
+    struct CompactList
+    {
+        QList<CompactListParagraph> paragraphs;
+        QSet<char> usedParagraphNames;
+    };
+
     enum Addendum {
         Invokable,
         PrivateSignal,
@@ -99,7 +112,11 @@ public:
     virtual QString fileBase(const Node *node) const;
 
 protected:
+    static CompactList compactList(const NodeMultiMap &nmm, const QString &commonPrefix,
+                                   bool sortByLastName);
     static QFile *openSubPageFile(const Node *node, const QString &fileName);
+    static QString subPageFilePath(const Node *node, const QString &fileName);
+    static void writeSubPageFile(const Node *node, const QString &fileName, QString &text);
     void beginFilePage(const Node *node, const QString &fileName);
     void endFilePage() { endSubPage(); } // for symmetry
     void beginSubPage(const Node *node, const QString &fileName);
@@ -189,6 +206,8 @@ protected:
     QString naturalLanguage;
     QString tagFile_;
     QStack<QTextStream *> outStreamStack;
+    QStack<QString> m_outFilePaths;
+    QStack<Location> m_outLocations;
 
     void appendFullName(Text &text, const Node *apparentNode, const Node *relative,
                         const Node *actualNode = nullptr);
@@ -226,6 +245,7 @@ private:
     static QmlTypeNode *s_qmlTypeContext;
 
     void generateReimplementsClause(const FunctionNode *fn, CodeMarker *marker);
+    QString computeFullDocumentLocation(const Node *node, bool useSubdir);
     static void copyTemplateFiles(const QString &configVar, const QString &subDir);
 
 protected:
@@ -240,6 +260,9 @@ protected:
     int m_numTableRows { 0 };
     QString m_link {};
     QString m_sectionNumber {};
+
+private:
+    QHash<const Node *, QString> m_fullDocumentLocations[2] {};
 };
 
 QT_END_NAMESPACE
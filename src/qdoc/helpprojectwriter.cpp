@@ -189,10 +189,11 @@ void HelpProjectWriter::addExtraFile(const QString &file)
         project.m_extraFiles.insert(file);
 }
 
-Keyword HelpProjectWriter::keywordDetails(const Node *node) const
+/*!
+  Returns the keyword for \a node, which is documented at \a ref.
+ */
+Keyword HelpProjectWriter::keywordDetails(const Node *node, const QString &ref) const
 {
-    QString ref = m_gen->fullDocumentLocation(node, false);
-
     if (node->parent() && !node->parent()->name().isEmpty()) {
         QString name = (node->isEnumType() || node->isTypedef())
                 ? node->parent()->name()+"::"+node->name()
@@ -238,19 +239,20 @@ bool HelpProjectWriter::generateSection(HelpProject &project, QXmlStreamWriter &
     if (!docPath.isEmpty() && project.m_excluded.contains(docPath))
         return false;
 
-    QString objName = node->isTextPageNode() ? node->fullTitle() : node->fullDocumentName();
     // Only add nodes to the set for each subproject if they match a selector.
     // Those that match will be listed in the table of contents.
+    QString objName;
+    if (!project.m_subprojects.isEmpty())
+        objName = node->isTextPageNode() ? node->fullTitle() : node->fullDocumentName();
 
-    for (int i = 0; i < project.m_subprojects.length(); i++) {
-        SubProject subproject = project.m_subprojects[i];
+    for (auto &subproject : project.m_subprojects) {
         // No selectors: accept all nodes.
         if (subproject.m_selectors.isEmpty()) {
-            project.m_subprojects[i].m_nodes[objName] = node;
+            subproject.m_nodes[objName] = node;
         } else if (subproject.m_selectors.contains(node->nodeType())) {
             // Add all group members for '[group|module|qmlmodule]:name' selector
             if (node->isCollectionNode()) {
-                if (project.m_subprojects[i].m_groups.contains(node->name().toLower())) {
+                if (subproject.m_groups.contains(node->name().toLower())) {
                     const auto *cn = static_cast<const CollectionNode *>(node);
                     const auto members = cn->members();
                     for (const Node *m : members) {
@@ -258,26 +260,29 @@ bool HelpProjectWriter::generateSection(HelpProject &project, QXmlStreamWriter &
                             continue;
                         QString memberName =
                                 m->isTextPageNode() ? m->fullTitle() : m->fullDocumentName();
-                        project.m_subprojects[i].m_nodes[memberName] = m;
+                        subproject.m_nodes[memberName] = m;
                     }
                     continue;
-                } else if (!project.m_subprojects[i].m_groups.isEmpty()) {
+                } else if (!subproject.m_groups.isEmpty()) {
                     continue; // Node does not represent specified group(s)
                 }
             } else if (node->isTextPageNode()) {
                 if (node->isExternalPage() || node->fullTitle().isEmpty())
                     continue;
             }
-            project.m_subprojects[i].m_nodes[objName] = node;
+            subproject.m_nodes[objName] = node;
         }
     }
 
+    // All keywords of the node refer to the same location.
+    const QString ref = m_gen->fullDocumentLocation(node, false);
+
     switch (node->nodeType()) {
 
     case Node::Class:
     case Node::Struct:
     case Node::Union:
-        project.m_keywords.append(keywordDetails(node));
+        project.m_keywords.append(keywordDetails(node, ref));
         break;
     case Node::QmlType:
     case Node::QmlValueType:
@@ -287,40 +292,32 @@ bool HelpProjectWriter::generateSection(HelpProject &project, QXmlStreamWriter &
             const auto keywords = node->doc().keywords();
             for (const Atom *keyword : keywords) {
                 if (!keyword->string().isEmpty()) {
-                    project.m_keywords.append(Keyword(keyword->string(), keyword->string(),
-                                                      m_gen->fullDocumentLocation(node, false)));
+                    project.m_keywords.append(Keyword(keyword->string(), keyword->string(), ref));
                 }
                 else
                     node->doc().location().warning(
-                            QStringLiteral("Bad keyword in %1")
-                                    .arg(m_gen->fullDocumentLocation(node, false)));
+                            QStringLiteral("Bad keyword in %1").arg(ref));
             }
         }
-        project.m_keywords.append(keywordDetails(node));
+        project.m_keywords.append(keywordDetails(node, ref));
         break;
 
     case Node::Namespace:
-        project.m_keywords.append(keywordDetails(node));
+        project.m_keywords.append(keywordDetails(node, ref));
         break;
 
     case Node::Enum:
-        project.m_keywords.append(keywordDetails(node));
+        project.m_keywords.append(keywordDetails(node, ref));
         {
             const auto *enumNode = static_cast<const EnumNode *>(node);
             const auto items = enumNode->items();
+            const QString &scope = node->parent()->name();
             for (const auto &item : items) {
                 if (enumNode->itemAccess(item.name()) == Access::Private)
                     continue;
 
-                QString name;
-                QString id;
-                if (!node->parent()->name().isEmpty()) {
-                    name = id = node->parent()->name() + "::" + item.name();
-                } else {
-                    name = id = item.name();
-                }
-                QString ref = m_gen->fullDocumentLocation(node, false);
-                project.m_keywords.append(Keyword(name, id, ref));
+                const QString name = scope.isEmpty() ? item.name() : scope + "::" + item.name();
+                project.m_keywords.append(Keyword(name, name, ref));
             }
         }
         break;
@@ -336,22 +333,20 @@ bool HelpProjectWriter::generateSection(HelpProject &project, QXmlStreamWriter &
                 for (const Atom *keyword : keywords) {
                     if (!keyword->string().isEmpty()) {
                         project.m_keywords.append(
-                                Keyword(keyword->string(), keyword->string(),
-                                        m_gen->fullDocumentLocation(node, false)));
+                                Keyword(keyword->string(), keyword->string(), ref));
                     } else
                         cn->doc().location().warning(
-                                QStringLiteral("Bad keyword in %1")
-                                        .arg(m_gen->fullDocumentLocation(node, false)));
+                                QStringLiteral("Bad keyword in %1").arg(ref));
                 }
             }
-            project.m_keywords.append(keywordDetails(node));
+            project.m_keywords.append(keywordDetails(node, ref));
         }
     } break;
 
     case Node::Property:
     case Node::QmlProperty:
     case Node::JsProperty:
-        project.m_keywords.append(keywordDetails(node));
+        project.m_keywords.append(keywordDetails(node, ref));
         break;
 
     case Node::Function: {
@@ -365,14 +360,14 @@ bool HelpProjectWriter::generateSection(HelpProject &project, QXmlStreamWriter &
           because we already know it is NodeType::Function.
          */
         if (funcNode->isQmlNode() || funcNode->isJsNode()) {
-            project.m_keywords.append(keywordDetails(node));
+            project.m_keywords.append(keywordDetails(node, ref));
             break;
         }
         // Only insert keywords for non-constructors. Constructors are covered
         // by the classes themselves.
 
         if (!funcNode->isSomeCtor())
-            project.m_keywords.append(keywordDetails(node));
+            project.m_keywords.append(keywordDetails(node, ref));
 
         // Insert member status flags into the entries for the parent
         // node of the function, or the node it is related to.
@@ -386,7 +381,7 @@ bool HelpProjectWriter::generateSection(HelpProject &project, QXmlStreamWriter &
     case Node::TypeAlias:
     case Node::Typedef: {
         const auto *typedefNode = static_cast<const TypedefNode *>(node);
-        Keyword typedefDetails = keywordDetails(node);
+        Keyword typedefDetails = keywordDetails(node, ref);
         const EnumNode *enumNode = typedefNode->associatedEnum();
         // Use the location of any associated enum node in preference
         // to that of the typedef.
@@ -397,7 +392,7 @@ bool HelpProjectWriter::generateSection(HelpProject &project, QXmlStreamWriter &
     } break;
 
     case Node::Variable: {
-        project.m_keywords.append(keywordDetails(node));
+        project.m_keywords.append(keywordDetails(node, ref));
     } break;
 
         // Page nodes (such as manual pages) contain subtypes, titles and other
@@ -410,15 +405,13 @@ bool HelpProjectWriter::generateSection(HelpProject &project, QXmlStreamWriter &
                 for (const Atom *keyword : keywords) {
                     if (!keyword->string().isEmpty()) {
                         project.m_keywords.append(
-                                Keyword(keyword->string(), keyword->string(),
-                                        m_gen->fullDocumentLocation(node, false)));
+                                Keyword(keyword->string(), keyword->string(), ref));
                     } else {
-                        QString loc = m_gen->fullDocumentLocation(node, false);
-                        pn->doc().location().warning(QStringLiteral("Bad keyword in %1").arg(loc));
+                        pn->doc().location().warning(QStringLiteral("Bad keyword in %1").arg(ref));
                     }
                 }
             }
-            project.m_keywords.append(keywordDetails(node));
+            project.m_keywords.append(keywordDetails(node, ref));
         }
         break;
     }
@@ -454,26 +447,28 @@ void HelpProjectWriter::generateSections(HelpProject &project, QXmlStreamWriter
     if (node->isAggregate()) {
         const auto *aggregate = static_cast<const Aggregate *>(node);
 
-        // Ensure that we don't visit nodes more than once.
-        QSet<const Node *> childSet;
-        const NodeList &children = aggregate->childNodes();
-        for (const auto *child : children) {
+        // Collect the children before visiting them, so that the member status of
+        // this node is complete when its functions are visited. Owned children are
+        // unique, so none of them is visited more than once.
+        NodeList children;
+        HelpProject::NodeStatusSet *memberStatus = nullptr;
+        for (auto *child : aggregate->childNodes()) {
             // Skip related non-members adopted by some other aggregate
             if (child->parent() != aggregate)
                 continue;
             if (child->isIndexNode() || child->isPrivate())
                 continue;
-            if (child->isTextPageNode()) {
-                childSet << child;
-            } else {
+            if (!child->isTextPageNode()) {
                 // Store member status of children
-                project.m_memberStatus[node].insert(child->status());
+                if (!memberStatus)
+                    memberStatus = &project.m_memberStatus[node];
+                memberStatus->insert(child->status());
                 if (child->isFunction() && static_cast<const FunctionNode *>(child)->isOverload())
                     continue;
-                childSet << child;
             }
+            children.append(child);
         }
-        for (const auto *child : qAsConst(childSet))
+        for (const auto *child : qAsConst(children))
             generateSections(project, writer, child);
     }
 }
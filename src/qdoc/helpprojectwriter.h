@@ -113,7 +113,7 @@ private:
     void generateProject(HelpProject &project);
     void generateSections(HelpProject &project, QXmlStreamWriter &writer, const Node *node);
     bool generateSection(HelpProject &project, QXmlStreamWriter &writer, const Node *node);
-    Keyword keywordDetails(const Node *node) const;
+    Keyword keywordDetails(const Node *node, const QString &ref) const;
     void writeHashFile(QFile &file);
     void writeNode(HelpProject &project, QXmlStreamWriter &writer, const Node *node);
     void readSelectors(SubProject &subproject, const QStringList &selectors);
@@ -45,6 +45,7 @@
 #include "qmlpropertynode.h"
 #include "sharedcommentnode.h"
 #include "tagfilewriter.h"
+#include "timings.h"
 #include "tree.h"
 #include "quoter.h"
 
@@ -261,6 +262,7 @@ void HtmlGenerator::generateDocs()
     if (!config->generating()) {
         QString fileBase =
                 m_project.toLower().simplified().replace(QLatin1Char(' '), QLatin1Char('-'));
+        Timings::Scope timing("write index");
         m_qdb->generateIndex(outputDir() + QLatin1Char('/') + fileBase + ".index", m_projectUrl,
                              m_projectDescription, this);
     }
@@ -2615,52 +2617,7 @@ void HtmlGenerator::generateCompactList(ListType listType, const Node *relative,
     if (nmm.isEmpty())
         return;
 
-    const int NumParagraphs = 37; // '0' to '9', 'A' to 'Z', '_'
-    qsizetype commonPrefixLen = commonPrefix.length();
-
-    /*
-      Divide the data into 37 paragraphs: 0, ..., 9, A, ..., Z,
-      underscore (_). QAccel will fall in paragraph 10 (A) and
-      QXtWidget in paragraph 33 (X). This is the only place where we
-      assume that NumParagraphs is 37. Each paragraph is a NodeMultiMap.
-    */
-    NodeMultiMap paragraph[NumParagraphs + 1];
-    QString paragraphName[NumParagraphs + 1];
-    QSet<char> usedParagraphNames;
-
-    for (auto c = nmm.constBegin(); c != nmm.constEnd(); ++c) {
-        QStringList pieces = c.key().split("::");
-        int idx = commonPrefixLen;
-        if (idx > 0 && !pieces.last().startsWith(commonPrefix, Qt::CaseInsensitive))
-            idx = 0;
-        QString last = pieces.last().toLower();
-        QString key = last.mid(idx);
-
-        int paragraphNr = NumParagraphs - 1;
-
-        if (key[0].digitValue() != -1) {
-            paragraphNr = key[0].digitValue();
-        } else if (key[0] >= QLatin1Char('a') && key[0] <= QLatin1Char('z')) {
-            paragraphNr = 10 + key[0].unicode() - 'a';
-        }
-
-        paragraphName[paragraphNr] = key[0].toUpper();
-        usedParagraphNames.insert(key[0].toLower().cell());
-        paragraph[paragraphNr].insert(last, c.value());
-    }
-
-    /*
-      Each paragraph j has a size: paragraph[j].count(). In the
-      discussion, we will assume paragraphs 0 to 5 will have sizes
-      3, 1, 4, 1, 5, 9.
-
-      We now want to compute the paragraph offset. Paragraphs 0 to 6
-      start at offsets 0, 3, 4, 8, 9, 14, 23.
-    */
-    qsizetype paragraphOffset[NumParagraphs + 1]; // 37 + 1
-    paragraphOffset[0] = 0;
-    for (int i = 0; i < NumParagraphs; i++) // i = 0..36
-        paragraphOffset[i + 1] = paragraphOffset[i] + paragraph[i].count();
+    const CompactList list = compactList(nmm, commonPrefix, true);
 
     /*
       Output the alphabet as a row of links.
@@ -2669,7 +2626,7 @@ void HtmlGenerator::generateCompactList(ListType listType, const Node *relative,
         out() << "<p  class=\"centerAlign functionIndex\"><b>";
         for (int i = 0; i < 26; i++) {
             QChar ch('a' + i);
-            if (usedParagraphNames.contains(char('a' + i)))
+            if (list.usedParagraphNames.contains(char('a' + i)))
                 out() << QString("<a href=\"#%1\">%2</a>&nbsp;").arg(ch).arg(ch.toUpper());
         }
         out() << "</b></p>\n";
@@ -2681,89 +2638,69 @@ void HtmlGenerator::generateCompactList(ListType listType, const Node *relative,
     out() << "<div class=\"flowListDiv\">\n";
     m_numTableRows = 0;
 
-    int curParNr = 0;
-    int curParOffset = 0;
     QString previousName;
     bool multipleOccurrences = false;
 
-    for (int i = 0; i < nmm.count(); i++) {
-        while ((curParNr < NumParagraphs) && (curParOffset == paragraph[curParNr].count())) {
-            ++curParNr;
-            curParOffset = 0;
-        }
-
+    for (const auto &paragraph : list.paragraphs) {
         /*
           Starting a new paragraph means starting a new <dl>.
         */
-        if (curParOffset == 0) {
-            if (i > 0)
-                out() << "</dl>\n";
-            if (++m_numTableRows % 2 == 1)
-                out() << "<dl class=\"flowList odd\">";
-            else
-                out() << "<dl class=\"flowList even\">";
-            out() << "<dt class=\"alphaChar\"";
-            if (includeAlphabet)
-                out() << QString(" id=\"%1\"").arg(paragraphName[curParNr][0].toLower());
-            out() << "><b>" << paragraphName[curParNr] << "</b></dt>\n";
-        }
+        if (++m_numTableRows % 2 == 1)
+            out() << "<dl class=\"flowList odd\">";
+        else
+            out() << "<dl class=\"flowList even\">";
+        out() << "<dt class=\"alphaChar\"";
+        if (includeAlphabet)
+            out() << QString(" id=\"%1\"").arg(paragraph.name[0].toLower());
+        out() << "><b>" << paragraph.name << "</b></dt>\n";
 
         /*
-          Output a <dd> for the current offset in the current paragraph.
+          Output a <dd> for each node in the current paragraph.
          */
-        out() << "<dd>";
-        if ((curParNr < NumParagraphs) && !paragraphName[curParNr].isEmpty()) {
-            NodeMultiMap::Iterator it;
-            NodeMultiMap::Iterator next;
-            it = paragraph[curParNr].begin();
-            for (int j = 0; j < curParOffset; j++)
-                ++it;
-
+        for (qsizetype i = 0; i < paragraph.nodes.size(); ++i) {
+            const Node *node = paragraph.nodes.at(i);
+            out() << "<dd>";
             if (listType == Generic) {
                 /*
                   Previously, we used generateFullName() for this, but we
                   require some special formatting.
                 */
-                out() << "<a href=\"" << linkForNode(it.value(), relative) << "\">";
+                out() << "<a href=\"" << linkForNode(node, relative) << "\">";
             } else if (listType == Obsolete) {
-                QString fileName = fileBase(it.value()) + "-obsolete." + fileExtension();
+                QString fileName = fileBase(node) + "-obsolete." + fileExtension();
                 QString link;
                 if (useOutputSubdirs()) {
-                    link = QString("../" + it.value()->outputSubdirectory() + QLatin1Char('/'));
+                    link = QString("../" + node->outputSubdirectory() + QLatin1Char('/'));
                 }
                 link += fileName;
                 out() << "<a href=\"" << link << "\">";
             }
 
             QStringList pieces;
-            if (it.value()->isQmlType() || it.value()->isJsType()) {
-                QString name = it.value()->name();
-                next = it;
-                ++next;
+            if (node->isQmlType() || node->isJsType()) {
+                QString name = node->name();
                 if (name != previousName)
                     multipleOccurrences = false;
-                if ((next != paragraph[curParNr].end()) && (name == next.value()->name())) {
+                if (i + 1 < paragraph.nodes.size() && name == paragraph.nodes.at(i + 1)->name()) {
                     multipleOccurrences = true;
                     previousName = name;
                 }
                 if (multipleOccurrences)
-                    name += ": " + it.value()->tree()->camelCaseModuleName();
+                    name += ": " + node->tree()->camelCaseModuleName();
                 pieces << name;
             } else
-                pieces = it.value()->fullName(relative).split("::");
+                pieces = node->fullName(relative).split("::");
             out() << protectEnc(pieces.last());
             out() << "</a>";
             if (pieces.size() > 1) {
                 out() << " (";
-                generateFullName(it.value()->parent(), relative);
+                generateFullName(node->parent(), relative);
                 out() << ')';
             }
+            out() << "</dd>\n";
         }
-        out() << "</dd>\n";
-        curParOffset++;
-    }
-    if (nmm.count() > 0)
         out() << "</dl>\n";
+    }
 
     out() << "</div>\n";
 }
@@ -3281,44 +3218,29 @@ QString HtmlGenerator::protectEnc(const QString &string)
 
 QString HtmlGenerator::protect(const QString &string)
 {
-#define APPEND(x)                                                                                  \
-    if (html.isEmpty()) {                                                                          \
-        html = string;                                                                             \
-        html.truncate(i);                                                                          \
-    }                                                                                              \
-    html += (x);
-
-    QString html;
-    qsizetype n = string.length();
-
-    for (int i = 0; i < n; ++i) {
-        QChar ch = string.at(i);
-
-        if (ch == QLatin1Char('&')) {
-            APPEND("&amp;");
-        } else if (ch == QLatin1Char('<')) {
-            APPEND("&lt;");
-        } else if (ch == QLatin1Char('>')) {
-            APPEND("&gt;");
-        } else if (ch == QLatin1Char('"')) {
-            APPEND("&quot;");
-        } else if ((ch == QLatin1Char('*') && i + 1 < n && string.at(i) == QLatin1Char('/'))
-                   || (ch == QLatin1Char('.') && i > 2 && string.at(i - 2) == QLatin1Char('.'))) {
-            // we escape '*/' and the last dot in 'e.g.' and 'i.e.' for the Javadoc generator
-            APPEND("&#x");
-            html += QString::number(ch.unicode(), 16);
-            html += QLatin1Char(';');
-        } else {
-            if (!html.isEmpty())
-                html += ch;
-        }
-    }
+    // we escape the last dot in 'e.g.' and 'i.e.' for the Javadoc generator
+    const auto nextEscapedDot = [&string](qsizetype from) {
+        qsizetype dot = string.indexOf(QLatin1Char('.'), qMax(from, qsizetype(3)));
+        while (dot != -1 && string.at(dot - 2) != QLatin1Char('.'))
+            dot = string.indexOf(QLatin1Char('.'), dot + 1);
+        return dot;
+    };
 
-    if (!html.isEmpty())
-        return html;
-    return string;
+    qsizetype dot = nextEscapedDot(0);
+    if (dot == -1)
+        return Utilities::htmlEscaped(string);
 
-#undef APPEND
+    QString html;
+    html.reserve(string.size() + 30);
+    qsizetype start = 0;
+    while (dot != -1) {
+        Utilities::appendHtmlEscaped(&html, QStringView{string}.sliced(start, dot - start));
+        html += QLatin1String("&#x2e;");
+        start = dot + 1;
+        dot = nextEscapedDot(start);
+    }
+    Utilities::appendHtmlEscaped(&html, QStringView{string}.sliced(start));
+    return html;
 }
 
 QString HtmlGenerator::fileBase(const Node *node) const
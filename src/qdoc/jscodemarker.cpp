@@ -88,14 +88,26 @@ Atom::AtomType JsCodeMarker::atomType() const
     return Atom::JavaScript;
 }
 
+/*!
+  Returns \a code marked up as JavaScript. Like for QML, code that
+  could be parsed and analyzed without warnings is cached.
+ */
 QString JsCodeMarker::markedUpCode(const QString &code, const Node *relative,
                                    const Location &location)
 {
-    return addMarkUp(code, relative, location);
+    auto it = m_markedUpCode.constFind(code);
+    if (it != m_markedUpCode.constEnd())
+        return it.value();
+
+    bool complete = false;
+    const QString output = addMarkUp(code, relative, location, &complete);
+    if (complete)
+        m_markedUpCode.insert(code, output);
+    return output;
 }
 
 QString JsCodeMarker::addMarkUp(const QString &code, const Node * /* relative */,
-                                const Location &location)
+                                const Location &location, bool *complete)
 {
 #ifndef QT_NO_DECLARATIVE
     QQmlJS::Engine engine;
@@ -118,6 +130,8 @@ QString JsCodeMarker::addMarkUp(const QString &code, const Node * /* relative */
             location.warning(
                     location.fileName()
                     + QStringLiteral("Unable to analyze JavaScript. The output is incomplete."));
+        } else if (complete) {
+            *complete = true;
         }
         output = visitor.markedUpCode();
     } else {
@@ -132,6 +146,7 @@ QString JsCodeMarker::addMarkUp(const QString &code, const Node * /* relative */
     return output;
 #else
     Q_UNUSED(code);
+    Q_UNUSED(complete);
     location.warning("QtDeclarative not installed; cannot parse QML or JS.");
     return QString();
 #endif
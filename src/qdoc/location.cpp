@@ -32,21 +32,72 @@
 
 #include <QtCore/qdebug.h>
 #include <QtCore/qdir.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qregularexpression.h>
 
+#include <algorithm>
 #include <climits>
 #include <cstdio>
 #include <cstdlib>
+#include <memory>
+#include <tuple>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
 int Location::s_tabSize;
 int Location::s_warningCount = 0;
 int Location::s_warningLimit = -1;
+bool Location::s_bufferMessages = false;
 QString Location::s_programName;
 QString Location::s_project;
 QRegularExpression *Location::s_spuriousRegExp = nullptr;
 
+/*
+  A message formatted when it was emitted, along with the position
+  it is sorted by. The text already includes the location, so that
+  the location stack does not need to be kept.
+ */
+struct Location::BufferedMessage
+{
+    [[nodiscard]] auto key() const { return std::tie(m_filePath, m_lineNo, m_text); }
+
+    QString m_filePath;
+    int m_lineNo;
+    MessageType m_type;
+    QString m_text;
+};
+
+struct Location::MessageBuffer
+{
+    QMutex m_mutex;
+    QList<BufferedMessage> m_messages;
+
+    static QMutex s_registryMutex;
+    static std::vector<std::shared_ptr<MessageBuffer>> s_buffers;
+};
+
+QMutex Location::MessageBuffer::s_registryMutex;
+std::vector<std::shared_ptr<Location::MessageBuffer>> Location::MessageBuffer::s_buffers;
+
+static QMutex s_outputMutex;
+static QtMessageHandler s_previousMessageHandler = nullptr;
+
+/*
+  Writes out the buffered messages before a qFatal() aborts qdoc,
+  so that they are not lost.
+ */
+static void flushingMessageHandler(QtMsgType type, const QMessageLogContext &context,
+                                   const QString &message)
+{
+    if (type == QtFatalMsg)
+        Location::flushMessages();
+    if (s_previousMessageHandler)
+        s_previousMessageHandler(type, context, message);
+    else
+        qt_message_output(type, context, message);
+}
+
 /*!
   \class Location
 
@@ -141,6 +192,26 @@ void Location::advance(QChar ch)
     }
 }
 
+/*!
+  Advances the current file position over the \a n Latin-1
+  characters at \a chars, as calling advance() for each of them
+  would.
+ */
+void Location::advance(const char *chars, qsizetype n)
+{
+    const char *end = chars + n;
+    for (const char *p = chars; p != end; ++p) {
+        if (*p == '\n') {
+            m_stkTop->m_lineNo++;
+            m_stkTop->m_columnNo = 1;
+        } else if (*p == '\t') {
+            m_stkTop->m_columnNo = 1 + s_tabSize * (m_stkTop->m_columnNo + s_tabSize - 1) / s_tabSize;
+        } else {
+            m_stkTop->m_columnNo++;
+        }
+    }
+}
+
 /*!
   Pushes \a filePath onto the file position stack. The current
   file position becomes (\a filePath, 1, 1).
@@ -264,6 +335,7 @@ void Location::error(const QString &message, const QString &details) const
  */
 int Location::exitCode()
 {
+    flushMessages();
     if (s_warningLimit < 0 || s_warningCount <= s_warningLimit)
         return EXIT_SUCCESS;
 
@@ -283,7 +355,8 @@ int Location::exitCode()
  */
 void Location::fatal(const QString &message, const QString &details) const
 {
-    emitMessage(Error, message, details);
+    flushMessages();
+    printMessage(Error, formatMessage(Error, message, details));
     information(message);
     information(details);
     information("Aborting");
@@ -316,6 +389,9 @@ void Location::initialize()
     if (qEnvironmentVariableIsSet("QDOC_ENABLE_WARNINGLIMIT")
         || config.getBool(CONFIG_WARNINGLIMIT + Config::dot + "enabled"))
         s_warningLimit = config.getInt(CONFIG_WARNINGLIMIT);
+    s_bufferMessages = !config.getDebug();
+    if (s_bufferMessages && !s_previousMessageHandler)
+        s_previousMessageHandler = qInstallMessageHandler(flushingMessageHandler);
 
     QRegularExpression regExp = config.getRegExp(CONFIG_SPURIOUS);
     if (regExp.isValid()) {
@@ -327,16 +403,76 @@ void Location::initialize()
 }
 
 /*!
-  Apparently, all this does is delete the regular expression
-  used for intercepting certain error messages that should
-  not be emitted by emitMessage().
+  Writes out the buffered warnings and errors, then deletes
+  the regular expression used for intercepting certain error
+  messages that should not be emitted by emitMessage().
  */
 void Location::terminate()
 {
+    flushMessages();
+    s_bufferMessages = false;
     delete s_spuriousRegExp;
     s_spuriousRegExp = nullptr;
 }
 
+/*!
+  Writes the warnings and errors collected by emitMessage() to
+  \c stderr, sorted by location, and empties the buffers. A
+  message reported more than once for the same location is
+  written, and counted against the warning limit, only once.
+
+  Called at the end of each phase of a run (parsing, resolving,
+  and generating each output format), so that messages appear
+  as the run progresses and are de-duplicated within a phase.
+ */
+void Location::flushMessages()
+{
+    QList<BufferedMessage> messages;
+    {
+        QMutexLocker locker(&MessageBuffer::s_registryMutex);
+        auto &buffers = MessageBuffer::s_buffers;
+        for (const auto &buffer : buffers) {
+            QMutexLocker bufferLocker(&buffer->m_mutex);
+            messages.append(std::move(buffer->m_messages));
+            buffer->m_messages.clear();
+        }
+        // Drop the buffers of threads that have finished.
+        buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                                     [](const auto &buffer) { return buffer.use_count() == 1; }),
+                      buffers.end());
+    }
+    if (messages.isEmpty())
+        return;
+
+    std::stable_sort(messages.begin(), messages.end(),
+                     [](const BufferedMessage &a, const BufferedMessage &b) {
+                         return a.key() < b.key();
+                     });
+    auto end = std::unique(messages.begin(), messages.end(),
+                           [](const BufferedMessage &a, const BufferedMessage &b) {
+                               return a.key() == b.key();
+                           });
+    for (auto it = messages.begin(); it != end; ++it)
+        printMessage(it->m_type, it->m_text);
+}
+
+/*!
+  Returns the message buffer of the calling thread, creating
+  it on first use. The buffers are shared with a registry that
+  outlives the threads, so that flushMessages() can collect the
+  messages of worker threads that have already finished.
+ */
+Location::MessageBuffer *Location::threadMessageBuffer()
+{
+    thread_local std::shared_ptr<MessageBuffer> buffer;
+    if (!buffer) {
+        buffer = std::make_shared<MessageBuffer>();
+        QMutexLocker locker(&MessageBuffer::s_registryMutex);
+        MessageBuffer::s_buffers.push_back(buffer);
+    }
+    return buffer.get();
+}
+
 /*!
   Prints \a message to \c stdout followed by a \c{'\n'}.
  */
@@ -358,9 +494,11 @@ void Location::internalError(const QString &hint)
 }
 
 /*!
-  Formats \a message and \a details into a single string
-  and outputs that string to \c stderr. \a type specifies
-  whether the \a message is an error or a warning.
+  Outputs \a message and \a details as a message of the given
+  \a type. Warnings and errors are collected in the calling
+  thread's buffer and written by flushMessages(), unless qdoc
+  runs in debug mode, where they are written immediately so
+  that they stay next to the debug output.
  */
 void Location::emitMessage(MessageType type, const QString &message, const QString &details) const
 {
@@ -371,6 +509,25 @@ void Location::emitMessage(MessageType type, const QString &message, const QStri
             return;
     }
 
+    if (type != Report && s_bufferMessages) {
+        BufferedMessage buffered{ isEmpty() ? QString() : filePath(), isEmpty() ? 0 : lineNo(),
+                                  type, formatMessage(type, message, details) };
+        MessageBuffer *buffer = threadMessageBuffer();
+        QMutexLocker locker(&buffer->m_mutex);
+        buffer->m_messages.append(std::move(buffered));
+        return;
+    }
+    printMessage(type, formatMessage(type, message, details));
+}
+
+/*!
+  Formats \a message and \a details into a single string,
+  prefixed with the location. \a type specifies whether the
+  \a message is an error or a warning.
+ */
+QString Location::formatMessage(MessageType type, const QString &message,
+                                const QString &details) const
+{
     QString result = message;
     if (!details.isEmpty())
         result += "\n[" + details + QLatin1Char(']');
@@ -378,21 +535,29 @@ void Location::emitMessage(MessageType type, const QString &message, const QStri
     if (isEmpty()) {
         if (type == Error)
             result.prepend(QStringLiteral(": error: "));
-        else if (type == Warning) {
+        else if (type == Warning)
             result.prepend(QStringLiteral(": warning: "));
-            ++s_warningCount;
-        }
     } else {
         if (type == Error)
             result.prepend(QStringLiteral(": (qdoc) error: "));
-        else if (type == Warning) {
+        else if (type == Warning)
             result.prepend(QStringLiteral(": (qdoc) warning: "));
-            ++s_warningCount;
-        }
     }
     if (type != Report)
         result.prepend(toString());
-    fprintf(stderr, "%s\n", result.toLatin1().data());
+    return result;
+}
+
+/*!
+  Outputs the formatted message \a text to \c stderr, counting
+  it against the warning limit if \a type is a warning.
+ */
+void Location::printMessage(MessageType type, const QString &text)
+{
+    QMutexLocker locker(&s_outputMutex);
+    if (type == Warning)
+        ++s_warningCount;
+    fprintf(stderr, "%s\n", text.toLatin1().data());
     fflush(stderr);
 }
 
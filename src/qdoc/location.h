@@ -48,6 +48,7 @@ public:
 
     void start();
     void advance(QChar ch);
+    void advance(const char *chars, qsizetype n);
     void advanceLines(int n)
     {
         m_stkTop->m_lineNo += n;
@@ -77,6 +78,7 @@ public:
     static void initialize();
 
     static void terminate();
+    static void flushMessages();
     static void information(const QString &message);
     static void internalError(const QString &hint);
     static int exitCode();
@@ -92,8 +94,15 @@ private:
     };
     friend class QTypeInfo<StackEntry>;
 
+    struct BufferedMessage;
+    struct MessageBuffer;
+
     void emitMessage(MessageType type, const QString &message, const QString &details) const;
+    [[nodiscard]] QString formatMessage(MessageType type, const QString &message,
+                                        const QString &details) const;
+    static void printMessage(MessageType type, const QString &text);
     [[nodiscard]] QString top() const;
+    static MessageBuffer *threadMessageBuffer();
 
 private:
     StackEntry m_stkBottom {};
@@ -105,6 +114,7 @@ private:
     static int s_tabSize;
     static int s_warningCount;
     static int s_warningLimit;
+    static bool s_bufferMessages;
     static QString s_programName;
     static QString s_project;
     static QRegularExpression *s_spuriousRegExp;
@@ -42,10 +42,13 @@
 #include "qmlcodeparser.h"
 #include "utilities.h"
 #include "qtranslator.h"
+#include "tasks.h"
+#include "timings.h"
 #include "tokenizer.h"
 #include "tree.h"
 #include "webxmlgenerator.h"
 
+#include <QtCore/qcryptographichash.h>
 #include <QtCore/qdatetime.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qglobal.h>
@@ -55,8 +58,12 @@
 #    include <QtCore/qcoreapplication.h>
 #endif
 
+#include <QtNetwork/qlocalserver.h>
+#include <QtNetwork/qlocalsocket.h>
+
 #include <algorithm>
 #include <cstdlib>
+#include <memory>
 
 QT_BEGIN_NAMESPACE
 
@@ -71,6 +78,7 @@ static QList<Translator> translators;
 #endif
 
 static ClangCodeParser *clangParser_ = nullptr;
+static QmlCodeParser *qmlParser_ = nullptr;
 
 /*!
   Read some XML indexes containing definitions from other
@@ -222,6 +230,113 @@ static void loadIndexFiles(const QSet<QString> &formats)
     qdb->readIndexes(indexFiles);
 }
 
+/*!
+    \internal
+    Returns the path of the stamp file that is stored next to the
+    index file written for \a project in the prepare phase.
+ */
+static QString indexStampFilePath(const QString &project)
+{
+    const QString fileBase =
+            project.toLower().simplified().replace(QLatin1Char(' '), QLatin1Char('-'));
+    return Config::instance().getOutputDir() + QLatin1Char('/') + fileBase
+            + QLatin1String(".index.stamp");
+}
+
+/*!
+    \internal
+    Adds the name, size and modification time of \a file to \a hash.
+ */
+static void addFileToHash(QCryptographicHash &hash, const QString &file)
+{
+    const QFileInfo fi(file);
+    hash.addData(QStringLiteral("\n%1 %2 %3")
+                         .arg(file)
+                         .arg(fi.size())
+                         .arg(fi.lastModified().toMSecsSinceEpoch())
+                         .toUtf8());
+}
+
+/*!
+    \internal
+    Returns a hash of what the prepare phase is known to read up front:
+    the qdoc binary and version, the command line, the loaded
+    configuration, and the size and modification time of each of the
+    \a inputFiles.
+ */
+static QByteArray prepareInputsHash(const QStringList &inputFiles)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QT_VERSION_STR);
+    addFileToHash(hash, QCoreApplication::applicationFilePath());
+    hash.addData(QCoreApplication::arguments().join(QLatin1Char('\n')).toUtf8());
+    hash.addData(Config::instance().hash());
+    for (const auto &file : inputFiles)
+        addFileToHash(hash, file);
+    return hash.result().toHex();
+}
+
+/*!
+    \internal
+    Returns \a inputsHash combined with the size and modification
+    time of \a dependencies, the files found to be read only while
+    parsing.
+ */
+static QByteArray stampHash(const QByteArray &inputsHash, const QStringList &dependencies)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(inputsHash);
+    for (const auto &file : dependencies)
+        addFileToHash(hash, file);
+    return hash.result().toHex();
+}
+
+/*!
+    \internal
+    Returns \c true if the index file belonging to \a stampFile
+    exists and was written from inputs hashing to \a inputsHash,
+    and none of the dependencies listed in the stamp has changed.
+ */
+static bool isPrepareUpToDate(const QString &stampFile, const QByteArray &inputsHash)
+{
+    QString indexFile = stampFile;
+    indexFile.chop(qsizetype(QLatin1String(".stamp").size()));
+    if (!QFileInfo::exists(indexFile))
+        return false;
+    QFile stamp(stampFile);
+    if (!stamp.open(QIODevice::ReadOnly | QIODevice::Text))
+        return false;
+    const QByteArray hash = stamp.readLine().trimmed();
+    QStringList dependencies;
+    while (!stamp.atEnd()) {
+        QByteArray line = stamp.readLine();
+        if (line.endsWith('\n'))
+            line.chop(1);
+        if (!line.isEmpty())
+            dependencies.append(QString::fromUtf8(line));
+    }
+    return hash == stampHash(inputsHash, dependencies);
+}
+
+/*!
+    \internal
+    Records \a inputsHash in \a stampFile after the prepare phase,
+    together with the files recorded by Config::addInputFile(), which
+    later runs check as well.
+ */
+static void writePrepareStamp(const QString &stampFile, const QByteArray &inputsHash)
+{
+    const QStringList dependencies = Config::instance().inputFiles();
+    QFile stamp(stampFile);
+    if (stamp.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        stamp.write(stampHash(inputsHash, dependencies) + '\n');
+        for (const auto &file : dependencies)
+            stamp.write(file.toUtf8() + '\n');
+    } else {
+        qCWarning(lcQdoc) << "Cannot write" << stampFile;
+    }
+}
+
 /*!
     \internal
     Prints to stderr the name of the project that QDoc is running for,
@@ -263,7 +378,10 @@ static void processQdocconfFile(const QString &fileName)
       purposes.
      */
     Location::initialize();
-    config.load(fileName);
+    {
+        Timings::Scope timing("load config", fileName);
+        config.load(fileName);
+    }
     QString project = config.getString(CONFIG_PROJECT);
     if (project.isEmpty()) {
         qCCritical(lcQdoc) << QLatin1String("qdoc can't run; no project set in qdocconf file");
@@ -355,6 +473,7 @@ static void processQdocconfFile(const QString &fileName)
     if (!config.singleExec()) {
         if (!config.preparing()) {
             qCDebug(lcQdoc, "  loading index files");
+            Timings::Scope timing("load index files");
             loadIndexFiles(outputFormats);
             qCDebug(lcQdoc, "  done loading index files");
         }
@@ -403,6 +522,17 @@ static void processQdocconfFile(const QString &fileName)
     }
     Generator::augmentImageDirs(exampleImageDirs);
 
+    /*
+      In incremental mode, the prepare phase is skipped altogether
+      if none of its inputs changed since the index file was written.
+     */
+    QString prepareStampFile;
+    QByteArray prepareHash;
+    bool upToDate = false;
+    if (config.incremental() && config.preparing() && !config.singleExec()
+        && outputFormats.contains(QLatin1String("HTML")))
+        prepareStampFile = indexStampFilePath(project);
+
     if (config.dualExec() || config.preparing()) {
         QStringList headerList;
         QStringList sourceList;
@@ -449,63 +579,96 @@ static void processQdocconfFile(const QString &fileName)
                 sourceFileNames.insert(t, t);
             }
         }
-        /*
-          Parse each header file in the set using the appropriate parser and add it
-          to the big tree.
-        */
+        if (!prepareStampFile.isEmpty()) {
+            prepareHash = prepareInputsHash(headers.keys() + sources.keys());
+            upToDate = isPrepareUpToDate(prepareStampFile, prepareHash);
+        }
+        if (upToDate) {
+            qCInfo(lcQdoc) << "Inputs unchanged, keeping the index file for" << project;
+        } else {
+            /*
+              Parse each header file in the set using the appropriate parser and add it
+              to the big tree.
+            */
 
-        qCDebug(lcQdoc, "Parsing header files");
-        int parsed = 0;
-        for (auto it = headers.constBegin(); it != headers.constEnd(); ++it) {
-            CodeParser *codeParser = CodeParser::parserForHeaderFile(it.key());
-            if (codeParser) {
-                ++parsed;
-                qCDebug(lcQdoc, "Parsing %s", qPrintable(it.key()));
-                codeParser->parseHeaderFile(config.location(), it.key());
+            qCDebug(lcQdoc, "Parsing header files");
+            int parsed = 0;
+            {
+                Timings::Scope timing("parse headers");
+                for (auto it = headers.constBegin(); it != headers.constEnd(); ++it) {
+                    CodeParser *codeParser = CodeParser::parserForHeaderFile(it.key());
+                    if (codeParser) {
+                        ++parsed;
+                        qCDebug(lcQdoc, "Parsing %s", qPrintable(it.key()));
+                        codeParser->parseHeaderFile(config.location(), it.key());
+                    }
+                }
             }
-        }
+            Location::flushMessages();
 
-        clangParser_->precompileHeaders();
+            {
+                Timings::Scope timing("precompile headers");
+                clangParser_->precompileHeaders();
+            }
+            clangParser_->prefetchSourceFiles(sources.keys());
+            qmlParser_->prefetchSourceFiles(sources.keys());
 
-        /*
-          Parse each source text file in the set using the appropriate parser and
-          add it to the big tree.
-        */
-        parsed = 0;
-        qCInfo(lcQdoc) << "Parse source files for" << project;
-        for (const auto &key : sources.keys()) {
-            auto *codeParser = CodeParser::parserForSourceFile(key);
-            if (codeParser) {
-                ++parsed;
-                qCDebug(lcQdoc, "Parsing %s", qPrintable(key));
-                codeParser->parseSourceFile(config.location(), key);
+            /*
+              Parse each source text file in the set using the appropriate parser and
+              add it to the big tree.
+            */
+            parsed = 0;
+            qCInfo(lcQdoc) << "Parse source files for" << project;
+            {
+                Timings::Scope timing("parse sources");
+                for (const auto &key : sources.keys()) {
+                    auto *codeParser = CodeParser::parserForSourceFile(key);
+                    if (codeParser) {
+                        ++parsed;
+                        qCDebug(lcQdoc, "Parsing %s", qPrintable(key));
+                        codeParser->parseSourceFile(config.location(), key);
+                    }
+                }
             }
+            Location::flushMessages();
+            qCInfo(lcQdoc) << "Source files parsed for" << project;
         }
-        qCInfo(lcQdoc) << "Source files parsed for" << project;
     }
     /*
       Now the primary tree has been built from all the header and
       source files. Resolve all the class names, function names,
       targets, URLs, links, and other stuff that needs resolving.
     */
-    qCDebug(lcQdoc, "Resolving stuff prior to generating docs");
-    qdb->resolveStuff();
+    if (!upToDate) {
+        qCDebug(lcQdoc, "Resolving stuff prior to generating docs");
+        {
+            Timings::Scope timing("resolve");
+            qdb->resolveStuff();
+        }
+        Location::flushMessages();
 
-    /*
-      The primary tree is built and all the stuff that needed
-      resolving has been resolved. Now traverse the tree and
-      generate the documentation output. More than one output
-      format can be requested. The tree is traversed for each
-      one.
-     */
-    qCDebug(lcQdoc, "Generating docs");
-    for (const auto &format : outputFormats) {
-        auto *generator = Generator::generatorForFormat(format);
-        if (generator == nullptr)
-            outputFormatsLocation.fatal(
-                    QCoreApplication::translate("QDoc", "Unknown output format '%1'").arg(format));
-        generator->initializeFormat();
-        generator->generateDocs();
+        /*
+          The primary tree is built and all the stuff that needed
+          resolving has been resolved. Now traverse the tree and
+          generate the documentation output. More than one output
+          format can be requested. The tree is traversed for each
+          one.
+         */
+        qCDebug(lcQdoc, "Generating docs");
+        for (const auto &format : outputFormats) {
+            auto *generator = Generator::generatorForFormat(format);
+            if (generator == nullptr)
+                outputFormatsLocation.fatal(QCoreApplication::translate(
+                        "QDoc", "Unknown output format '%1'").arg(format));
+            generator->initializeFormat();
+            {
+                Timings::Scope timing("generate", format);
+                generator->generateDocs();
+            }
+            Location::flushMessages();
+        }
+        if (!prepareStampFile.isEmpty())
+            writePrepareStamp(prepareStampFile, prepareHash);
     }
 
     qCDebug(lcQdoc, "Terminating qdoc classes");
@@ -513,6 +676,9 @@ static void processQdocconfFile(const QString &fileName)
         Utilities::stopDebugging(project);
 
     logStartEndMessage(QLatin1String("End"), config);
+    Timings::report(project);
+    Config::writeFileListCache();
+    Config::writeParsedFileCache();
     QDocDatabase::qdocDB()->setVersion(QString());
     Generator::terminate();
     CodeParser::terminate();
@@ -525,6 +691,68 @@ static void processQdocconfFile(const QString &fileName)
     qCDebug(lcQdoc, "qdoc classes terminated");
 }
 
+/*!
+  Documents the module described by the qdocconf file \a fileName
+  for the documentation server and returns the exit code. Only the
+  primary tree is deleted afterwards; the index trees stay loaded,
+  so that modules documented later don't read them again.
+ */
+static int serveQdocconfFile(const QString &fileName)
+{
+    if (!QFileInfo(fileName).isFile()) {
+        qCWarning(lcQdoc).noquote() << "Cannot find qdocconf file" << fileName;
+        return EXIT_FAILURE;
+    }
+    Config::instance().dependModules().clear();
+    processQdocconfFile(fileName);
+    const int exitCode = Location::exitCode();
+    QDocDatabase::qdocDB()->discardPrimaryTree();
+    return exitCode;
+}
+
+/*!
+  Runs qdoc as a documentation server on the local socket
+  \a serverName. A client connects, writes the path of a
+  qdocconf file followed by a newline, and reads back the
+  exit code of documenting it, also followed by a newline.
+  Relative paths are resolved against the directory qdoc was
+  started in. The request \c quit stops the server.
+
+  The requests are handled one at a time, in the phase given
+  on the command line. A fatal error in a request terminates
+  the server.
+ */
+static int runServer(const QString &serverName)
+{
+    QLocalServer server;
+    QLocalServer::removeServer(serverName);
+    if (!server.listen(serverName)) {
+        qCCritical(lcQdoc).noquote()
+                << "qdoc can't listen on" << serverName << ":" << server.errorString();
+        return EXIT_FAILURE;
+    }
+    qCInfo(lcQdoc).noquote() << "Waiting for requests on" << server.fullServerName();
+
+    const QDir startDir = QDir::current();
+    while (server.waitForNewConnection(-1)) {
+        std::unique_ptr<QLocalSocket> socket(server.nextPendingConnection());
+        while (!socket->canReadLine() && socket->waitForReadyRead(30000)) { }
+        const QString request = QString::fromUtf8(socket->readLine()).trimmed();
+        if (request.isEmpty())
+            continue;
+
+        const bool quit = request == QLatin1String("quit");
+        const int exitCode = quit ? EXIT_SUCCESS
+                                  : serveQdocconfFile(startDir.absoluteFilePath(request));
+        socket->write(QByteArray::number(exitCode) + '\n');
+        socket->waitForBytesWritten();
+        socket->disconnectFromServer();
+        if (quit)
+            break;
+    }
+    return EXIT_SUCCESS;
+}
+
 QT_END_NAMESPACE
 
 int main(int argc, char **argv)
@@ -546,6 +774,7 @@ int main(int argc, char **argv)
     ClangCodeParser clangParser;
     clangParser_ = &clangParser;
     QmlCodeParser qmlParser;
+    qmlParser_ = &qmlParser;
     PureDocParser docParser;
 
     /*
@@ -569,16 +798,29 @@ int main(int argc, char **argv)
 
     Config::instance().init(QCoreApplication::translate("QDoc", "qdoc"), app.arguments());
     Config &config = Config::instance();
+    Timings::initialize(config.timings(), config.traceFile());
 
     // Get the list of files to act on:
     QStringList qdocFiles = config.qdocFiles();
-    if (qdocFiles.isEmpty())
+    const bool server = !config.serverName().isEmpty();
+    if (qdocFiles.isEmpty() && !server)
         config.showHelp();
 
+    if (server && config.singleExec()) {
+        qCCritical(lcQdoc) << "qdoc can't run as a server in single-exec mode";
+        return EXIT_FAILURE;
+    }
+
     if (config.singleExec())
         qdocFiles = Config::loadMaster(qdocFiles.at(0));
 
-    if (config.singleExec()) {
+    int serverExitCode = EXIT_SUCCESS;
+    if (server) {
+        // one qdoc process documenting modules on request
+        for (const auto &file : qAsConst(qdocFiles))
+            serveQdocconfFile(QFileInfo(file).absoluteFilePath());
+        serverExitCode = runServer(config.serverName());
+    } else if (config.singleExec()) {
         // single qdoc process for prepare and generate phases
         config.setQDocPass(Config::Prepare);
         for (const auto &file : qAsConst(qdocFiles)) {
@@ -616,6 +858,8 @@ int main(int argc, char **argv)
 #ifdef DEBUG_SHUTDOWN_CRASH
     qDebug() << "main(): qdoc database deleted";
 #endif
+    Tasks::terminate();
+    Timings::terminate();
 
-    return Location::exitCode();
+    return server ? serverExitCode : Location::exitCode();
 }
@@ -1038,7 +1038,7 @@ void Node::setSince(const QString &since)
     if (!cutoff.isNull() && QVersionNumber::fromString(parts.last()).normalized() < cutoff)
         return;
 
-    m_since = parts.join(QLatin1Char(' '));
+    m_since = Utilities::intern(parts.join(QLatin1Char(' ')));
 }
 
 /*!
@@ -1273,7 +1273,7 @@ void Node::setDeprecatedSince(const QString &sinceVersion)
                                      "Setting deprecated since version for %1 to %2 even though it "
                                      "was already set to %3. This is very unexpected.")
                                      .arg(this->m_name, sinceVersion, this->m_deprecatedSince);
-    m_deprecatedSince = sinceVersion;
+    m_deprecatedSince = Utilities::intern(sinceVersion);
 }
 
 /*! \fn Node *Node::clone(Aggregate *parent)
@@ -36,6 +36,7 @@
 #include "parameters.h"
 #include "relatedclass.h"
 #include "usingclause.h"
+#include "utilities.h"
 
 #include <QtCore/qdir.h>
 #include <QtCore/qlist.h>
@@ -253,9 +254,12 @@ public:
     void setStatus(Status t);
     void setThreadSafeness(ThreadSafeness t) { m_safeness = t; }
     void setSince(const QString &since);
-    void setPhysicalModuleName(const QString &name) { m_physicalModuleName = name; }
+    void setPhysicalModuleName(const QString &name)
+    {
+        m_physicalModuleName = Utilities::intern(name);
+    }
     void setUrl(const QString &url) { m_url = url; }
-    void setTemplateDecl(const QString &t) { m_templateDecl = t; }
+    void setTemplateDecl(const QString &t) { m_templateDecl = Utilities::intern(t); }
     void setReconstitutedBrief(const QString &t) { m_reconstitutedBrief = t; }
     void setParent(Aggregate *n) { m_parent = n; }
     void setIndexNodeFlag(bool isIndexNode = true) { m_indexNodeFlag = isIndexNode; }
@@ -354,7 +358,7 @@ public:
     QmlTypeNode *qmlTypeNode();
     ClassNode *declarativeCppNode();
     [[nodiscard]] const QString &outputSubdirectory() const { return m_outSubDir; }
-    virtual void setOutputSubdirectory(const QString &t) { m_outSubDir = t; }
+    virtual void setOutputSubdirectory(const QString &t) { m_outSubDir = Utilities::intern(t); }
     [[nodiscard]] QString fullDocumentName() const;
     QString qualifyCppName();
     QString qualifyQmlName();
@@ -88,6 +88,8 @@ void PureDocParser::parseSourceFile(const Location &location, const QString &fil
 bool PureDocParser::processQdocComments()
 {
     const QSet<QString> &commands = topicCommands() + metaCommands();
+    QList<std::pair<Doc, QString>> comments;
+    FnArgList fnArgs;
 
     while (m_token != Tok_Eoi) {
         if (m_token == Tok_Doc) {
@@ -110,16 +112,29 @@ bool PureDocParser::processQdocComments()
             if (hasTooManyTopics(doc))
                 continue;
 
-            DocList docs;
-            NodeList nodes;
             QString topic = topics[0].m_topic;
-
-            processTopicArgs(doc, topic, nodes, docs);
-            processMetaCommands(nodes, docs);
+            collectFnArgs(doc, topic, QStringList(), fnArgs);
+            comments.append(std::make_pair(doc, topic));
         } else {
             m_token = m_tokenizer->getToken();
         }
     }
+
+    /*
+      Let clang resolve all the \fn signatures of the file in one
+      parse before the topics are processed in order.
+     */
+    CodeParser *clangParser = parserForLanguage("Clang");
+    if (clangParser)
+        clangParser->prepareFnArgs(fnArgs);
+    for (const auto &comment : qAsConst(comments)) {
+        DocList docs;
+        NodeList nodes;
+        processTopicArgs(comment.first, comment.second, nodes, docs);
+        processMetaCommands(nodes, docs);
+    }
+    if (clangParser)
+        clangParser->clearFnArgs();
     return true;
 }
 
@@ -60,7 +60,12 @@ QDocCommandLineParser::QDocCommandLineParser()
       frameworkOption("F", "Add macOS framework to the include path for header files.",
                       "framework"),
       timestampsOption(QStringList() << QStringLiteral("timestamps")),
-      useDocBookExtensions(QStringList() << QStringLiteral("docbook-extensions"))
+      useDocBookExtensions(QStringList() << QStringLiteral("docbook-extensions")),
+      jobsOption(QStringList() << QStringLiteral("jobs")),
+      incrementalOption(QStringList() << QStringLiteral("incremental")),
+      timingsOption(QStringList() << QStringLiteral("timings")),
+      traceOption(QStringList() << QStringLiteral("trace")),
+      serverOption(QStringList() << QStringLiteral("server"))
 {
     setApplicationDescription(QCoreApplication::translate("qdoc", "Qt documentation generator"));
     addHelpOption();
@@ -165,6 +170,34 @@ QDocCommandLineParser::QDocCommandLineParser()
     useDocBookExtensions.setDescription(QCoreApplication::translate(
             "qdoc", "Use the DocBook Library extensions for metadata."));
     addOption(useDocBookExtensions);
+
+    jobsOption.setDescription(QCoreApplication::translate(
+            "qdoc",
+            "Parse up to N C++ source files and write up to N output pages in "
+            "parallel. 0 uses one job per CPU core."));
+    jobsOption.setValueName(QStringLiteral("N"));
+    addOption(jobsOption);
+
+    incrementalOption.setDescription(QCoreApplication::translate(
+            "qdoc",
+            "In the prepare phase, keep the existing index file if no input has changed."));
+    addOption(incrementalOption);
+
+    timingsOption.setDescription(QCoreApplication::translate(
+            "qdoc", "Print the time spent in each phase and some statistics."));
+    addOption(timingsOption);
+
+    traceOption.setDescription(QCoreApplication::translate(
+            "qdoc", "Write a Chrome trace event file of qdoc's phases to <file>."));
+    traceOption.setValueName(QStringLiteral("file"));
+    addOption(traceOption);
+
+    serverOption.setDescription(QCoreApplication::translate(
+            "qdoc",
+            "Keep running and document the qdocconf files sent to the local socket <name>, "
+            "reusing the index files loaded for earlier requests."));
+    serverOption.setValueName(QStringLiteral("name"));
+    addOption(serverOption);
 }
 
 /*!
@@ -45,7 +45,8 @@ struct QDocCommandLineParser : public QCommandLineParser
     QCommandLineOption noLinkErrorsOption, autoLinkErrorsOption, debugOption, atomsDumpOption;
     QCommandLineOption prepareOption, generateOption, logProgressOption, singleExecOption;
     QCommandLineOption includePathOption, includePathSystemOption, frameworkOption;
-    QCommandLineOption timestampsOption, useDocBookExtensions;
+    QCommandLineOption timestampsOption, useDocBookExtensions, jobsOption;
+    QCommandLineOption incrementalOption, timingsOption, traceOption, serverOption;
 };
 
 QT_END_NAMESPACE
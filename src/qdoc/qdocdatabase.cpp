@@ -33,10 +33,15 @@
 #include "functionnode.h"
 #include "generator.h"
 #include "qdocindexfiles.h"
+#include "qmltypenode.h"
+#include "tasks.h"
+#include "timings.h"
 #include "tree.h"
 
 #include <QtCore/qregularexpression.h>
+
 #include <stack>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -151,6 +156,7 @@ void QDocForest::setPrimaryTree(const QString &t)
     QString T = t.toLower();
     m_primaryTree = findTree(T);
     m_forest.remove(T);
+    clearQmlTypeTables();
     if (m_primaryTree == nullptr)
         qDebug() << "ERROR: Could not set primary tree to:" << t;
 }
@@ -212,6 +218,7 @@ void QDocForest::setSearchOrder(const QStringList &t)
             m_forest.insert(m_moduleNames.at(i), m_searchOrder.at(i));
         }
     }
+    clearQmlTypeTables();
 }
 
 /*!
@@ -268,6 +275,69 @@ const QList<Tree *> &QDocForest::indexSearchOrder()
     return m_indexSearchOrder;
 }
 
+/*!
+  Builds the forest-wide QML type tables from the QML type maps
+  of the trees in the search order. A key that appears in more
+  than one tree maps to the type from the first tree in the
+  search order, which is what lookupQmlType() would find by
+  searching the trees one at a time.
+
+  The tables stay valid until the search order, the primary tree,
+  or the set of trees changes, at which point clearQmlTypeTables()
+  discards them and the lookups fall back to searching the trees.
+ */
+void QDocForest::buildQmlTypeTables()
+{
+    clearQmlTypeTables();
+    for (const auto *tree : searchOrder()) {
+        const QmlTypeMap &types = tree->m_qmlTypeMap;
+        for (auto it = types.cbegin(); it != types.cend(); ++it) {
+            if (m_qmlTypes.contains(it.key()))
+                continue;
+            m_qmlTypes.insert(it.key(), it.value());
+            qsizetype separator = it.key().indexOf(QLatin1String("::"));
+            if (separator >= 0)
+                m_moduleQmlTypes.insert({ it.key().left(separator), it.key().mid(separator + 2) },
+                                        it.value());
+        }
+    }
+    m_qmlTypeTablesBuilt = true;
+}
+
+/*!
+  Returns the QML type with the name \a name in the QML module
+  with the id \a qmid, or \nullptr if there is none. When the
+  QML type tables are built, this is a single hash lookup that
+  does not construct the qualified key.
+ */
+QmlTypeNode *QDocForest::lookupQmlType(const QString &qmid, const QString &name)
+{
+    if (m_qmlTypeTablesBuilt)
+        return m_moduleQmlTypes.value({ qmid, name });
+    return lookupQmlType(qmid + "::" + name);
+}
+
+/*!
+  Searches the forest for a QML type, or a QML basic type if
+  \a basicType is \c true, with the unqualified name \a name.
+  While the QML type tables are built, the result of each search,
+  including a failed one, is remembered for later calls.
+ */
+Node *QDocForest::findUnqualifiedQmlType(const QString &name, bool basicType)
+{
+    const auto isMatch = basicType ? &Node::isQmlBasicType : &Node::isQmlType;
+    if (!m_qmlTypeTablesBuilt)
+        return findNodeByNameAndType(QStringList(name), isMatch);
+
+    auto &cache = basicType ? m_unqualifiedQmlBasicTypes : m_unqualifiedQmlTypes;
+    auto it = cache.constFind(name);
+    if (it != cache.constEnd())
+        return it.value();
+    Node *n = findNodeByNameAndType(QStringList(name), isMatch);
+    cache.insert(name, n);
+    return n;
+}
+
 /*!
   Create a new Tree for the index file for the specified
   \a module and add it to the forest. Return the pointer
@@ -277,6 +347,10 @@ NamespaceNode *QDocForest::newIndexTree(const QString &module)
 {
     m_primaryTree = new Tree(module, m_qdb);
     m_forest.insert(module.toLower(), m_primaryTree);
+    m_targetCache.clear();
+    m_linkCache.clear();
+    m_targetCacheEnabled = false;
+    clearQmlTypeTables();
     return m_primaryTree->root();
 }
 
@@ -287,6 +361,41 @@ NamespaceNode *QDocForest::newIndexTree(const QString &module)
 void QDocForest::newPrimaryTree(const QString &module)
 {
     m_primaryTree = new Tree(module, m_qdb);
+    clearQmlTypeTables();
+}
+
+/*!
+  Removes the primary tree from the forest and deletes it,
+  keeping the index trees loaded for the next module. The
+  links from the index trees into the primary tree are
+  dropped first.
+
+  If setSearchOrder() displaced the index tree of the primary
+  module from the forest, that index tree is put back.
+ */
+void QDocForest::discardPrimaryTree()
+{
+    Tree *primary = m_primaryTree;
+    if (primary == nullptr)
+        return;
+
+    clearSearchOrder();
+    m_moduleNames.clear();
+    m_primaryTree = nullptr;
+    m_indexSearchOrder.removeAll(primary);
+    for (auto it = m_forest.begin(); it != m_forest.end();) {
+        if (it.value() == primary)
+            it = m_forest.erase(it);
+        else
+            ++it;
+    }
+    for (auto *tree : qAsConst(m_indexSearchOrder)) {
+        if (!m_forest.contains(tree->physicalModuleName()))
+            m_forest.insert(tree->physicalModuleName(), tree);
+        tree->detachFrom(primary);
+    }
+    QmlTypeNode::removeInheritedBy(primary);
+    delete primary;
 }
 
 /*!
@@ -303,6 +412,7 @@ const Node *QDocForest::findNodeForTarget(QStringList &targetPath, const Node *r
                                           Node::Genus genus, QString &ref)
 {
     int flags = SearchBaseClasses | SearchEnumValues;
+    Timings::count(Timings::LinkLookups);
 
     QString entity = targetPath.takeFirst();
     QStringList entityPath = entity.split("::");
@@ -311,12 +421,42 @@ const Node *QDocForest::findNodeForTarget(QStringList &targetPath, const Node *r
     if (!targetPath.isEmpty())
         target = targetPath.takeFirst();
 
+    /*
+      The index trees do not change once the documentation has been
+      resolved, so the result of searching them (including a failed
+      search) is remembered for the rest of the run. The primary tree
+      is always searched first, as the result depends on \a relative.
+     */
+    QString cacheKey;
     for (const auto *tree : searchOrder()) {
+        if (m_targetCacheEnabled && tree != searchOrder().constFirst()) {
+            cacheKey = entity + QLatin1Char('#') + target + QLatin1Char('#')
+                    + QString::number(genus);
+            auto it = m_targetCache.constFind(cacheKey);
+            if (it != m_targetCache.constEnd()) {
+                if (it->first)
+                    ref = it->second;
+                return it->first;
+            }
+            break;
+        }
         const Node *n = tree->findNodeForTarget(entityPath, target, relative, flags, genus, ref);
         if (n)
             return n;
         relative = nullptr;
     }
+    if (cacheKey.isEmpty())
+        return nullptr;
+
+    for (qsizetype i = 1; i < searchOrder().size(); ++i) {
+        const Node *n = searchOrder().at(i)->findNodeForTarget(entityPath, target, nullptr,
+                                                                flags, genus, ref);
+        if (n) {
+            m_targetCache.insert(cacheKey, { n, ref });
+            return n;
+        }
+    }
+    m_targetCache.insert(cacheKey, { nullptr, QString() });
     return nullptr;
 }
 
@@ -408,6 +548,34 @@ void QDocDatabase::destroyQdocDB()
     }
 }
 
+/*!
+  Deletes the primary tree and everything that was collected
+  from the forest while documenting it, but keeps the index
+  trees, so that the next module can be documented without
+  reading the index files again.
+
+  \sa QDocForest::discardPrimaryTree()
+ */
+void QDocDatabase::discardPrimaryTree()
+{
+    s_obsoleteClasses.clear();
+    s_classesWithObsoleteMembers.clear();
+    s_obsoleteQmlTypes.clear();
+    s_qmlTypesWithObsoleteMembers.clear();
+    s_cppClasses.clear();
+    s_qmlBasicTypes.clear();
+    s_qmlTypes.clear();
+    s_examples.clear();
+    s_newClassMaps.clear();
+    s_newQmlTypeMaps.clear();
+    s_newSinceMaps.clear();
+    m_namespaceIndex.clear();
+    m_attributions.clear();
+    m_functionIndex.clear();
+    m_legaleseTexts.clear();
+    m_forest.discardPrimaryTree();
+}
+
 /*!
   Initialize data structures in the singleton qdoc database.
 
@@ -705,14 +873,12 @@ QmlTypeNode *QDocDatabase::findQmlType(const QString &name)
 QmlTypeNode *QDocDatabase::findQmlType(const QString &qmid, const QString &name)
 {
     if (!qmid.isEmpty()) {
-        QString t = qmid + "::" + name;
-        QmlTypeNode *qcn = m_forest.lookupQmlType(t);
+        QmlTypeNode *qcn = m_forest.lookupQmlType(qmid, name);
         if (qcn)
             return qcn;
     }
 
-    QStringList path(name);
-    Node *n = m_forest.findNodeByNameAndType(path, &Node::isQmlType);
+    Node *n = m_forest.findUnqualifiedQmlType(name, false);
     if (n && (n->isQmlType() || n->isJsType()))
         return static_cast<QmlTypeNode *>(n);
     return nullptr;
@@ -729,14 +895,12 @@ QmlTypeNode *QDocDatabase::findQmlType(const QString &qmid, const QString &name)
 Aggregate *QDocDatabase::findQmlBasicType(const QString &qmid, const QString &name)
 {
     if (!qmid.isEmpty()) {
-        QString t = qmid + "::" + name;
-        Aggregate *a = m_forest.lookupQmlBasicType(t);
+        Aggregate *a = m_forest.lookupQmlType(qmid, name);
         if (a)
             return a;
     }
 
-    QStringList path(name);
-    Node *n = m_forest.findNodeByNameAndType(path, &Node::isQmlBasicType);
+    Node *n = m_forest.findUnqualifiedQmlType(name, true);
     if (n && n->isQmlBasicType())
         return static_cast<Aggregate *>(n);
     return nullptr;
@@ -759,8 +923,7 @@ QmlTypeNode *QDocDatabase::findQmlType(const ImportRec &import, const QString &n
         else
             qmName = import.m_importUri;
         for (const auto &namePart : dotSplit) {
-            QString qualifiedName = qmName + "::" + namePart;
-            QmlTypeNode *qcn = m_forest.lookupQmlType(qualifiedName);
+            QmlTypeNode *qcn = m_forest.lookupQmlType(qmName, namePart);
             if (qcn)
                 return qcn;
         }
@@ -1027,6 +1190,7 @@ const NodeMultiMap &QDocDatabase::getSinceMap(const QString &key)
 void QDocDatabase::resolveStuff()
 {
     const auto &config = Config::instance();
+    m_forest.buildQmlTypeTables();
     if (config.dualExec() || config.preparing()) {
         // order matters
         primaryTree()->resolveBaseClasses(primaryTreeRoot());
@@ -1056,6 +1220,7 @@ void QDocDatabase::resolveStuff()
     }
     if (config.dualExec())
         QDocIndexFiles::destroyQDocIndexFiles();
+    m_forest.enableTargetCache();
 }
 
 void QDocDatabase::resolveBaseClasses()
@@ -1086,6 +1251,9 @@ NodeMultiMap &QDocDatabase::getNamespaces()
   a multimap. Then it combines all the namespace nodes that
   have the same name into a single namespace node of that
   name and inserts that combined namespace node into an index.
+
+  The trees are searched concurrently when qdoc runs with more
+  than one job, each into its own multimap.
  */
 void QDocDatabase::resolveNamespaces()
 {
@@ -1093,11 +1261,22 @@ void QDocDatabase::resolveNamespaces()
         return;
 
     bool linkErrors = !Config::instance().getBool(CONFIG_NOLINKERRORS);
+    std::vector<Tree *> trees;
+    for (Tree *t = m_forest.firstTree(); t; t = m_forest.nextTree())
+        trees.push_back(t);
+
+    std::vector<NodeMultiMap> treeNamespaces(trees.size());
+    Tasks::forEach(qsizetype(trees.size()), [&](qsizetype i) {
+        trees[i]->root()->findAllNamespaces(treeNamespaces[i]);
+    });
+
+    // A multimap lists the values of a key from the most recently inserted
+    // one on. Appending the maps from the last tree to the first one gives
+    // the same order as inserting from all trees in turn.
     NodeMultiMap namespaceMultimap;
-    Tree *t = m_forest.firstTree();
-    while (t) {
-        t->root()->findAllNamespaces(namespaceMultimap);
-        t = m_forest.nextTree();
+    for (auto it = treeNamespaces.crbegin(); it != treeNamespaces.crend(); ++it) {
+        for (auto ns = it->cbegin(); ns != it->cend(); ++ns)
+            namespaceMultimap.insert(namespaceMultimap.cend(), ns.key(), ns.value());
     }
     const QList<QString> keys = namespaceMultimap.uniqueKeys();
     for (const QString &key : keys) {
@@ -1453,6 +1632,35 @@ void QDocDatabase::mergeCollections(CollectionNode *c)
  */
 const Node *QDocDatabase::findNodeForAtom(const Atom *a, const Node *relative, QString &ref,
                                           Node::Genus genus)
+{
+    /*
+      Once the documentation has been resolved, the result of a link
+      depends only on its text, its square bracket parameters and the
+      relative node. Each output format resolves the same links again,
+      so the result is remembered for the remaining formats.
+     */
+    if (!m_forest.m_targetCacheEnabled || !ref.isEmpty())
+        return findNodeForAtomUncached(a, relative, ref, genus);
+
+    Atom *atom = const_cast<Atom *>(a);
+    QString key = atom->string() + QLatin1Char('\0') + QString::number(genus)
+            + QLatin1Char('\0') + QString::number(reinterpret_cast<quintptr>(relative), 16);
+    if (atom->isLinkAtom()) {
+        key += QLatin1Char('\0') + QString::number(atom->genus()) + QLatin1Char('\0')
+                + QString::number(reinterpret_cast<quintptr>(atom->domain()), 16);
+    }
+    auto it = m_forest.m_linkCache.constFind(key);
+    if (it != m_forest.m_linkCache.constEnd()) {
+        ref = it->second;
+        return it->first;
+    }
+    const Node *node = findNodeForAtomUncached(a, relative, ref, genus);
+    m_forest.m_linkCache.insert(key, { node, node ? ref : QString() });
+    return node;
+}
+
+const Node *QDocDatabase::findNodeForAtomUncached(const Atom *a, const Node *relative,
+                                                  QString &ref, Node::Genus genus)
 {
     const Node *node = nullptr;
 
@@ -36,6 +36,7 @@
 #include "tree.h"
 
 #include <QtCore/qdebug.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qmap.h>
 #include <QtCore/qstring.h>
 
@@ -165,6 +166,8 @@ private:
 
     QmlTypeNode *lookupQmlType(const QString &name)
     {
+        if (m_qmlTypeTablesBuilt)
+            return m_qmlTypes.value(name);
         for (const auto *tree : searchOrder()) {
             QmlTypeNode *qcn = tree->lookupQmlType(name);
             if (qcn)
@@ -175,6 +178,8 @@ private:
 
     Aggregate *lookupQmlBasicType(const QString &name)
     {
+        if (m_qmlTypeTablesBuilt)
+            return m_qmlTypes.value(name);
         for (const auto *tree : searchOrder()) {
             Aggregate *a = tree->lookupQmlBasicType(name);
             if (a)
@@ -182,8 +187,33 @@ private:
         }
         return nullptr;
     }
-    void clearSearchOrder() { m_searchOrder.clear(); }
+    QmlTypeNode *lookupQmlType(const QString &qmid, const QString &name);
+    Node *findUnqualifiedQmlType(const QString &name, bool basicType);
+    void buildQmlTypeTables();
+    void clearQmlTypeTables()
+    {
+        m_qmlTypes.clear();
+        m_moduleQmlTypes.clear();
+        m_unqualifiedQmlTypes.clear();
+        m_unqualifiedQmlBasicTypes.clear();
+        m_qmlTypeTablesBuilt = false;
+    }
+    void clearSearchOrder()
+    {
+        m_searchOrder.clear();
+        m_targetCache.clear();
+        m_linkCache.clear();
+        m_targetCacheEnabled = false;
+        clearQmlTypeTables();
+    }
+    void enableTargetCache()
+    {
+        m_targetCache.clear();
+        m_linkCache.clear();
+        m_targetCacheEnabled = true;
+    }
     void newPrimaryTree(const QString &module);
+    void discardPrimaryTree();
     void setPrimaryTree(const QString &t);
     NamespaceNode *newIndexTree(const QString &module);
 
@@ -195,6 +225,14 @@ private:
     QList<Tree *> m_searchOrder;
     QList<Tree *> m_indexSearchOrder;
     QList<QString> m_moduleNames;
+    QHash<QString, std::pair<const Node *, QString>> m_targetCache;
+    QHash<QString, std::pair<const Node *, QString>> m_linkCache;
+    bool m_targetCacheEnabled { false };
+    QHash<QString, QmlTypeNode *> m_qmlTypes;
+    QHash<std::pair<QString, QString>, QmlTypeNode *> m_moduleQmlTypes;
+    QHash<QString, Node *> m_unqualifiedQmlTypes;
+    QHash<QString, Node *> m_unqualifiedQmlBasicTypes;
+    bool m_qmlTypeTablesBuilt { false };
 };
 
 class QDocDatabase
@@ -372,6 +410,7 @@ public:
     QDocForest &forest() { return m_forest; }
     NamespaceNode *primaryTreeRoot() { return m_forest.primaryTreeRoot(); }
     void newPrimaryTree(const QString &module) { m_forest.newPrimaryTree(module); }
+    void discardPrimaryTree();
     void setPrimaryTree(const QString &t) { m_forest.setPrimaryTree(t); }
     NamespaceNode *newIndexTree(const QString &module) { return m_forest.newIndexTree(module); }
     const QList<Tree *> &searchOrder() { return m_forest.searchOrder(); }
@@ -396,6 +435,8 @@ private:
         return m_forest.findNode(path, relative, findFlags, genus);
     }
     void processForest(void (QDocDatabase::*)(Aggregate *));
+    const Node *findNodeForAtomUncached(const Atom *atom, const Node *relative, QString &ref,
+                                        Node::Genus genus);
     bool isLoaded(const QString &t) { return m_forest.isLoaded(t); }
     static void initializeDB();
 
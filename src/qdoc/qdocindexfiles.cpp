@@ -30,6 +30,7 @@
 
 #include "access.h"
 #include "atom.h"
+#include "binaryindex.h"
 #include "classnode.h"
 #include "collectionnode.h"
 #include "config.h"
@@ -44,12 +45,15 @@
 #include "propertynode.h"
 #include "qdocdatabase.h"
 #include "qmlpropertynode.h"
+#include "tasks.h"
 #include "typedefnode.h"
 #include "variablenode.h"
 
 #include <QtCore/qxmlstream.h>
 
 #include <algorithm>
+#include <deque>
+#include <future>
 
 QT_BEGIN_NAMESPACE
 
@@ -113,22 +117,91 @@ void QDocIndexFiles::destroyQDocIndexFiles()
     }
 }
 
+/*!
+  Returns the path of the binary index written next to the index
+  file at \a indexPath, or an empty string if there is none or it is
+  older than the index file.
+ */
+static QString upToDateBinaryIndex(const QString &indexPath)
+{
+    const QFileInfo binaryInfo(BinaryIndex::pathForIndex(indexPath));
+    if (binaryInfo.exists() && binaryInfo.lastModified() >= QFileInfo(indexPath).lastModified())
+        return binaryInfo.filePath();
+    return QString();
+}
+
 /*!
   Reads and parses the list of index files in \a indexFiles.
+
+  When qdoc runs with more than one job, the files are read and
+  decoded into the binary index format on worker threads, ahead of
+  the calling thread. The nodes are still created on the calling
+  thread, in the order of \a indexFiles, since that modifies the
+  database and the resolution of base classes depends on it.
  */
 void QDocIndexFiles::readIndexes(const QStringList &indexFiles)
 {
+    const int jobs = Config::instance().jobs();
+    if (jobs < 2 || indexFiles.size() < 2) {
+        for (const QString &file : indexFiles) {
+            qCDebug(lcQdoc) << "Loading index file: " << file;
+            readIndexFile(file);
+        }
+        return;
+    }
+
+    auto decode = [](const QString &path) {
+        const QString binaryPath = upToDateBinaryIndex(path);
+        if (!binaryPath.isEmpty()) {
+            QFile binaryFile(binaryPath);
+            if (binaryFile.open(QFile::ReadOnly))
+                return binaryFile.readAll();
+        }
+        QFile file(path);
+        if (!file.open(QFile::ReadOnly))
+            return QByteArray();
+        return BinaryIndex::encode(&file);
+    };
+
+    std::deque<std::future<QByteArray>> decoded;
+    qsizetype next = 0;
     for (const QString &file : indexFiles) {
+        while (next < indexFiles.size() && qsizetype(decoded.size()) < jobs)
+            decoded.push_back(Tasks::run([decode, path = indexFiles.at(next++)]() { return decode(path); }));
+        const QByteArray data = decoded.front().get();
+        decoded.pop_front();
+
         qCDebug(lcQdoc) << "Loading index file: " << file;
-        readIndexFile(file);
+        BinaryIndexReader reader(data);
+        if (reader.isValid())
+            readIndex(reader, file);
+        else
+            readIndexFile(file);
     }
 }
 
 /*!
   Reads and parses the index file at \a path.
+
+  If a binary index written by BinaryIndex::write() exists next to
+  the file and is not older than it, the binary index is read instead.
  */
 void QDocIndexFiles::readIndexFile(const QString &path)
 {
+    const QString binaryPath = upToDateBinaryIndex(path);
+    if (!binaryPath.isEmpty()) {
+        QFile binaryFile(binaryPath);
+        if (binaryFile.open(QFile::ReadOnly)) {
+            BinaryIndexReader reader(&binaryFile);
+            if (reader.isValid()) {
+                qCDebug(lcQdoc) << "Reading binary index file: " << binaryPath;
+                readIndex(reader, path);
+                return;
+            }
+        }
+        qCDebug(lcQdoc) << "Ignoring invalid binary index file: " << binaryPath;
+    }
+
     QFile file(path);
     if (!file.open(QFile::ReadOnly)) {
         qWarning() << "Could not read index file" << path;
@@ -137,7 +210,16 @@ void QDocIndexFiles::readIndexFile(const QString &path)
 
     QXmlStreamReader reader(&file);
     reader.setNamespaceProcessing(false);
+    readIndex(reader, path);
+}
 
+/*!
+  Reads the index file at \a path from \a reader, which is either
+  a QXmlStreamReader or a BinaryIndexReader.
+ */
+template<typename Reader>
+void QDocIndexFiles::readIndex(Reader &reader, const QString &path)
+{
     if (!reader.readNextStartElement())
         return;
 
@@ -186,8 +268,8 @@ void QDocIndexFiles::readIndexFile(const QString &path)
   Read a <section> element from the index file and create the
   appropriate node(s).
  */
-void QDocIndexFiles::readIndexSection(QXmlStreamReader &reader, Node *current,
-                                      const QString &indexUrl)
+template<typename Reader>
+void QDocIndexFiles::readIndexSection(Reader &reader, Node *current, const QString &indexUrl)
 {
     QXmlStreamAttributes attributes = reader.attributes();
     QStringView elementName = reader.name();
@@ -656,7 +738,7 @@ void QDocIndexFiles::readIndexSection(QXmlStreamReader &reader, Node *current,
 
         // Create some content for the node.
         QSet<QString> emptySet;
-        Location t(filePath);
+        Location t(Utilities::intern(filePath));
         if (!filePath.isEmpty()) {
             t.setLineNo(lineNo);
             node->setLocation(t);
@@ -1470,9 +1552,17 @@ void QDocIndexFiles::generateIndexSections(QXmlStreamWriter &writer, Node *node,
             auto *aggregate = static_cast<Aggregate *>(node);
             // First write the function children, then write the nonfunction children.
             generateFunctionSections(writer, aggregate);
-            const auto &nonFunctionList = aggregate->nonfunctionList();
-            for (auto *node : nonFunctionList)
-                generateIndexSections(writer, node, post);
+
+            // Sort the children into a list owned by this depth, so that
+            // only the lists along the current path are alive and their
+            // storage is reused by the siblings that follow.
+            const qsizetype depth = m_sectionDepth++;
+            if (m_childLists.size() <= depth)
+                m_childLists.resize(depth + 1);
+            aggregate->fillNonfunctionList(m_childLists[depth]);
+            for (qsizetype i = 0; i < m_childLists.at(depth).size(); ++i)
+                generateIndexSections(writer, m_childLists.at(depth).at(i), post);
+            --m_sectionDepth;
         }
 
         if (node == root_) {
@@ -1538,6 +1628,7 @@ void QDocIndexFiles::generateIndex(const QString &fileName, const QString &url,
 
     m_gen = g;
     m_relatedNodes.clear();
+    m_sectionDepth = 0;
     QXmlStreamWriter writer(&file);
     writer.setAutoFormatting(true);
     writer.writeStartDocument();
@@ -1559,6 +1650,14 @@ void QDocIndexFiles::generateIndex(const QString &fileName, const QString &url,
     writer.writeEndElement(); // QDOCINDEX
     writer.writeEndDocument();
     file.close();
+    m_childLists.clear();
+
+    if (Config::instance().getBool(CONFIG_BINARYINDEX)) {
+        const QString binaryFileName = BinaryIndex::pathForIndex(fileName);
+        qCDebug(lcQdoc) << "Writing binary index file:" << binaryFileName;
+        if (!BinaryIndex::write(fileName, binaryFileName))
+            qCWarning(lcQdoc) << "Could not write binary index file" << binaryFileName;
+    }
 }
 
 QT_END_NAMESPACE
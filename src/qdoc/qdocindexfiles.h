@@ -65,7 +65,10 @@ private:
 
     void readIndexes(const QStringList &indexFiles);
     void readIndexFile(const QString &path);
-    void readIndexSection(QXmlStreamReader &reader, Node *current, const QString &indexUrl);
+    template<typename Reader>
+    void readIndex(Reader &reader, const QString &path);
+    template<typename Reader>
+    void readIndexSection(Reader &reader, Node *current, const QString &indexUrl);
     void insertTarget(TargetRec::TargetType type, const QXmlStreamAttributes &attributes,
                       Node *node);
     void resolveIndex();
@@ -88,6 +91,8 @@ private:
     QString m_project;
     QList<QPair<ClassNode *, QString>> m_basesList;
     NodeList m_relatedNodes;
+    QList<NodeList> m_childLists;
+    qsizetype m_sectionDepth { 0 };
     bool m_storeLocationInfo;
 };
 
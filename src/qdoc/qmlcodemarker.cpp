@@ -92,10 +92,23 @@ Atom::AtomType QmlCodeMarker::atomType() const
     return Atom::Qml;
 }
 
+/*!
+  Returns \a code marked up as QML. Code that could be parsed and
+  analyzed without warnings is cached, so that quoting it again
+  does not parse it again.
+ */
 QString QmlCodeMarker::markedUpCode(const QString &code, const Node *relative,
                                     const Location &location)
 {
-    return addMarkUp(code, relative, location);
+    auto it = m_markedUpCode.constFind(code);
+    if (it != m_markedUpCode.constEnd())
+        return it.value();
+
+    bool complete = false;
+    const QString output = addMarkUp(code, relative, location, &complete);
+    if (complete)
+        m_markedUpCode.insert(code, output);
+    return output;
 }
 
 /*!
@@ -133,7 +146,7 @@ QString QmlCodeMarker::functionEndRegExp(const QString & /* funcName */)
 }
 
 QString QmlCodeMarker::addMarkUp(const QString &code, const Node * /* relative */,
-                                 const Location &location)
+                                 const Location &location, bool *complete)
 {
 #ifndef QT_NO_DECLARATIVE
     QQmlJS::Engine engine;
@@ -156,6 +169,8 @@ QString QmlCodeMarker::addMarkUp(const QString &code, const Node * /* relative *
             location.warning(
                     location.fileName()
                     + QStringLiteral("Unable to analyze QML snippet. The output is incomplete."));
+        } else if (complete) {
+            *complete = true;
         }
         output = visitor.markedUpCode();
     } else {
@@ -169,6 +184,7 @@ QString QmlCodeMarker::addMarkUp(const QString &code, const Node * /* relative *
     return output;
 #else
     Q_UNUSED(code);
+    Q_UNUSED(complete);
     location.warning("QtDeclarative not installed; cannot parse QML or JS.");
     return QString();
 #endif
@@ -61,7 +61,8 @@ public:
 #endif
 
 private:
-    QString addMarkUp(const QString &code, const Node *relative, const Location &location);
+    QString addMarkUp(const QString &code, const Node *relative, const Location &location,
+                      bool *complete = nullptr);
 };
 
 QT_END_NAMESPACE
@@ -28,16 +28,122 @@
 
 #include "qmlcodeparser.h"
 
+#include "config.h"
 #include "node.h"
 #include "qmlvisitor.h"
+#include "tasks.h"
+#include "timings.h"
+#include "utilities.h"
 
 #ifndef QT_NO_DECLARATIVE
 #    include <private/qqmljsast_p.h>
 #endif
 #include <qdebug.h>
 
+#include <future>
+#include <map>
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
+#ifndef QT_NO_DECLARATIVE
+/*
+  A QML file parsed ahead of QmlCodeParser::parseSourceFile(). The
+  AST is allocated in the memory pool of \c engine, so each file
+  has its own engine, lexer and parser.
+ */
+struct PrefetchedQmlFile
+{
+    bool opened { false };
+    bool parsed { false };
+    QString code {};
+    std::unique_ptr<QQmlJS::Engine> engine {};
+    std::unique_ptr<QQmlJS::Lexer> lexer {};
+    std::unique_ptr<QQmlJS::Parser> parser {};
+};
+
+/*
+  Reads and parses a list of QML files on worker threads, ahead of
+  QmlCodeParser::parseSourceFile(). Only building the AST runs in
+  parallel; visiting it creates nodes in the database and still
+  happens in parseSourceFile(), in the order the files are consumed,
+  so the output does not depend on the number of jobs.
+
+  At most \c jobs files are being parsed or waiting to be consumed
+  at any time.
+ */
+class QmlFilePrefetcher
+{
+public:
+    ~QmlFilePrefetcher() { clear(); }
+
+    void start(const QStringList &filePaths, int jobs)
+    {
+        clear();
+        m_pending = filePaths;
+        m_jobs = jobs;
+        while (int(m_inFlight.size()) < m_jobs && !m_pending.isEmpty())
+            scheduleNext();
+    }
+
+    /*
+      Hands out the parsed file for \a filePath in \a file and
+      schedules the next pending file. Returns \c false if
+      \a filePath was not prefetched; the caller then has to parse
+      it itself.
+     */
+    bool take(const QString &filePath, PrefetchedQmlFile *file)
+    {
+        auto it = m_inFlight.find(filePath);
+        if (it == m_inFlight.end()) {
+            m_pending.removeOne(filePath);
+            return false;
+        }
+        *file = it->second.get();
+        m_inFlight.erase(it);
+        if (!m_pending.isEmpty())
+            scheduleNext();
+        return true;
+    }
+
+    void clear()
+    {
+        m_pending.clear();
+        for (auto &entry : m_inFlight)
+            entry.second.wait();
+        m_inFlight.clear();
+    }
+
+private:
+    void scheduleNext()
+    {
+        const QString filePath = m_pending.takeFirst();
+        m_inFlight.emplace(filePath, Tasks::run([filePath]() {
+            PrefetchedQmlFile file;
+            QFile in(filePath);
+            if (!in.open(QIODevice::ReadOnly))
+                return file;
+            file.opened = true;
+            Timings::Scope timing("qml parse", filePath);
+            file.code = in.readAll();
+            QmlCodeParser::extractPragmas(file.code);
+            file.engine = std::make_unique<QQmlJS::Engine>();
+            file.lexer = std::make_unique<QQmlJS::Lexer>(file.engine.get());
+            file.parser = std::make_unique<QQmlJS::Parser>(file.engine.get());
+            file.lexer->setCode(file.code, 1);
+            file.parsed = file.parser->parse();
+            return file;
+        }));
+    }
+
+    QStringList m_pending {};
+    std::map<QString, std::future<PrefetchedQmlFile>> m_inFlight {};
+    int m_jobs { 1 };
+};
+
+static QmlFilePrefetcher prefetcher_;
+#endif
+
 /*!
   Constructs the QML code parser.
  */
@@ -69,6 +175,7 @@ void QmlCodeParser::initializeParser()
 void QmlCodeParser::terminateParser()
 {
 #ifndef QT_NO_DECLARATIVE
+    prefetcher_.clear();
     delete m_lexer;
     delete m_parser;
 #endif
@@ -91,6 +198,35 @@ QStringList QmlCodeParser::sourceFileNameFilter()
     return QStringList() << "*.qml";
 }
 
+/*!
+  Starts parsing the QML files among \a sourceFiles on worker
+  threads, as many at a time as requested with the \c -jobs command
+  line option. parseSourceFile() then picks up the parsed files
+  instead of parsing them itself. The files should be passed in the
+  order they are going to be parsed in.
+ */
+void QmlCodeParser::prefetchSourceFiles(const QStringList &sourceFiles)
+{
+#ifndef QT_NO_DECLARATIVE
+    const int jobs = Config::instance().jobs();
+    if (jobs < 2)
+        return;
+
+    QStringList filePaths;
+    for (const auto &file : sourceFiles) {
+        if (CodeParser::parserForSourceFile(file) == this)
+            filePaths << file;
+    }
+    if (filePaths.size() < 2)
+        return;
+
+    qCDebug(lcQdoc) << "Parsing" << filePaths.size() << "QML files with" << jobs << "jobs";
+    prefetcher_.start(filePaths, jobs);
+#else
+    Q_UNUSED(sourceFiles);
+#endif
+}
+
 /*!
   Parses the source file at \a filePath and inserts the contents
   into the database. The \a location is used for error reporting.
@@ -100,6 +236,25 @@ QStringList QmlCodeParser::sourceFileNameFilter()
  */
 void QmlCodeParser::parseSourceFile(const Location &location, const QString &filePath)
 {
+#ifndef QT_NO_DECLARATIVE
+    PrefetchedQmlFile prefetched;
+    if (prefetcher_.take(filePath, &prefetched) && prefetched.opened) {
+        m_currentFile = filePath;
+        // The visitor looks up comments in the engine it is given, and the
+        // serial engine keeps the comments of all files parsed before. Append
+        // the comments of this file to it, as its lexer would have done, so
+        // that the visitor sees the same comments with any number of jobs.
+        for (const auto &comment : prefetched.engine->comments()) {
+            m_engine.addComment(comment.offset, comment.length, comment.startLine,
+                                comment.startColumn);
+        }
+        visitProgram(filePath, prefetched.code, &m_engine, prefetched.parser.get(),
+                     prefetched.parsed);
+        m_currentFile.clear();
+        return;
+    }
+#endif
+
     QFile in(filePath);
     m_currentFile = filePath;
     if (!in.open(QIODevice::ReadOnly)) {
@@ -112,15 +267,29 @@ void QmlCodeParser::parseSourceFile(const Location &location, const QString &fil
     QString document = in.readAll();
     in.close();
 
-    Location fileLocation(filePath);
-
     QString newCode = document;
     extractPragmas(newCode);
     m_lexer->setCode(newCode, 1);
 
-    if (m_parser->parse()) {
-        QQmlJS::AST::UiProgram *ast = m_parser->ast();
-        QmlDocVisitor visitor(filePath, newCode, &m_engine, topicCommands() + commonMetaCommands(),
+    visitProgram(filePath, newCode, &m_engine, m_parser, m_parser->parse());
+    m_currentFile.clear();
+#else
+    location.warning("QtDeclarative not installed; cannot parse QML or JS.");
+#endif
+}
+
+#ifndef QT_NO_DECLARATIVE
+/*!
+  Visits the AST that \a parser built from \a code, the contents of
+  \a filePath, and reports the syntax errors. \a parsed is the result
+  of the parse. The comments are looked up in \a engine.
+ */
+void QmlCodeParser::visitProgram(const QString &filePath, const QString &code,
+                                 QQmlJS::Engine *engine, QQmlJS::Parser *parser, bool parsed)
+{
+    if (parsed) {
+        QQmlJS::AST::UiProgram *ast = parser->ast();
+        QmlDocVisitor visitor(filePath, code, engine, topicCommands() + commonMetaCommands(),
                               topicCommands());
         QQmlJS::AST::Node::accept(ast, &visitor);
         if (visitor.hasError()) {
@@ -128,18 +297,15 @@ void QmlCodeParser::parseSourceFile(const Location &location, const QString &fil
                                << "The output is incomplete.";
         }
     }
-    const auto &messages = m_parser->diagnosticMessages();
+    const auto &messages = parser->diagnosticMessages();
     for (const auto &msg : messages) {
         qDebug().nospace() << qPrintable(filePath) << ':'
                            << msg.loc.startLine << ": QML syntax error at col "
                            << msg.loc.startColumn
                            << ": " << qPrintable(msg.message);
     }
-    m_currentFile.clear();
-#else
-    location.warning("QtDeclarative not installed; cannot parse QML or JS.");
-#endif
 }
+#endif
 
 static QSet<QString> topicCommands_;
 /*!
@@ -55,10 +55,11 @@ public:
     QString language() override;
     QStringList sourceFileNameFilter() override;
     void parseSourceFile(const Location &location, const QString &filePath) override;
+    void prefetchSourceFiles(const QStringList &sourceFiles);
 
 #ifndef QT_NO_DECLARATIVE
     /* Copied from src/declarative/qml/qdeclarativescriptparser.cpp */
-    void extractPragmas(QString &script);
+    static void extractPragmas(QString &script);
 #endif
 
 protected:
@@ -66,6 +67,9 @@ protected:
 
 private:
 #ifndef QT_NO_DECLARATIVE
+    void visitProgram(const QString &filePath, const QString &code, QQmlJS::Engine *engine,
+                      QQmlJS::Parser *parser, bool parsed);
+
     QQmlJS::Engine m_engine {};
     QQmlJS::Lexer *m_lexer { nullptr };
     QQmlJS::Parser *m_parser { nullptr };
@@ -80,6 +80,20 @@ void QmlTypeNode::subclasses(const Node *base, NodeList &subs)
     }
 }
 
+/*!
+  Removes the records of inheritance that involve a QML type
+  in \a tree, either as the base or as the subclass.
+ */
+void QmlTypeNode::removeInheritedBy(const Tree *tree)
+{
+    for (auto it = s_inheritedBy.begin(); it != s_inheritedBy.end();) {
+        if (it.key()->tree() == tree || it.value()->tree() == tree)
+            it = s_inheritedBy.erase(it);
+        else
+            ++it;
+    }
+}
+
 /*!
   If this QML type node has a base type node,
   return the fully qualified name of that QML
@@ -73,9 +73,11 @@ public:
     void setQmlBaseName(const QString &name) { m_qmlBaseName = name; }
     [[nodiscard]] QmlTypeNode *qmlBaseNode() const override { return m_qmlBaseNode; }
     void resolveInheritance(NodeMap &previousSearches);
+    void resetQmlBaseNode() { m_qmlBaseNode = nullptr; }
     [[nodiscard]] bool cppClassRequired() const { return m_classNodeRequired; }
     static void addInheritedBy(const Node *base, Node *sub);
     static void subclasses(const Node *base, NodeList &subs);
+    static void removeInheritedBy(const Tree *tree);
     static void terminate();
     bool inherits(Aggregate *type);
 
@@ -28,13 +28,18 @@
 
 #include "quoter.h"
 
+#include "regexpcache.h"
+
 #include <QtCore/qdebug.h>
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qregularexpression.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 QHash<QString, QString> Quoter::s_commentHash;
+QHash<QString, std::shared_ptr<const Quoter::QuotedFile>> Quoter::s_fileCache;
 
 static void replaceMultipleNewlines(QString &s)
 {
@@ -131,16 +136,22 @@ Quoter::Quoter() : m_silent(false)
 void Quoter::reset()
 {
     m_silent = false;
-    m_plainLines.clear();
-    m_markedLines.clear();
+    m_file.reset();
+    m_cursor = 0;
     m_codeLocation = Location();
 }
 
+/*!
+  Prepares quoting from the code of a file, given as \a plainCode
+  and as \a markedCode. \a userFriendlyFilePath is used in warnings.
+
+  If \a cacheKey is not empty, the split lines and the snippet index
+  are kept under that key until clearCache() is called, and later quotes
+  from the same file can use quoteFromCachedFile() instead.
+ */
 void Quoter::quoteFromFile(const QString &userFriendlyFilePath, const QString &plainCode,
-                           const QString &markedCode)
+                           const QString &markedCode, const QString &cacheKey)
 {
-    m_silent = false;
-
     /*
       Split the source code into logical lines. Empty lines are
       treated specially. Before:
@@ -162,28 +173,132 @@ void Quoter::quoteFromFile(const QString &userFriendlyFilePath, const QString &p
 
       Newlines are preserved because they affect codeLocation.
     */
-    m_codeLocation = Location(userFriendlyFilePath);
-
-    m_plainLines = splitLines(plainCode);
-    m_markedLines = splitLines(markedCode);
-    if (m_markedLines.count() != m_plainLines.count()) {
-        m_codeLocation.warning(
-                QStringLiteral("Something is wrong with qdoc's handling of marked code"));
-        m_markedLines = m_plainLines;
+    auto file = std::make_shared<QuotedFile>();
+    file->m_userFriendlyFilePath = userFriendlyFilePath;
+    file->m_plainLines = splitLines(plainCode);
+    file->m_markedLines = splitLines(markedCode);
+    if (file->m_markedLines.count() != file->m_plainLines.count()) {
+        Location(userFriendlyFilePath)
+                .warning(QStringLiteral("Something is wrong with qdoc's handling of marked code"));
+        file->m_markedLines = file->m_plainLines;
     }
 
     /*
-      Squeeze blanks (cat -s).
+      Squeeze blanks (cat -s), and record on which line of the
+      file each logical line starts.
     */
-    for (auto &line : m_markedLines)
+    file->m_lineStarts.reserve(file->m_markedLines.size() + 1);
+    int lineNo = 0;
+    for (auto &line : file->m_markedLines) {
         replaceMultipleNewlines(line);
+        file->m_lineStarts.append(lineNo);
+        lineNo += int(line.count(QLatin1Char('\n'))) + 1;
+    }
+    file->m_lineStarts.append(lineNo);
+
+    /*
+      Index the snippet markers. A marker matches a \snippet
+      identifier when the whitespace-trimmed line contains the
+      trimmed "<comment>[<identifier>]", which is what match()
+      tests when quoteSnippet() searches for the delimiter.
+    */
+    QString prefix = commentForFile(QFileInfo(userFriendlyFilePath).fileName())
+            + QLatin1Char('[');
+    trimWhiteSpace(prefix);
+    for (qsizetype i = 0; i < file->m_plainLines.size(); ++i) {
+        if (!file->m_plainLines.at(i).contains(QLatin1Char('[')))
+            continue;
+        QString str = file->m_plainLines.at(i);
+        while (str.endsWith(QLatin1Char('\n')))
+            str.truncate(str.length() - 1);
+        trimWhiteSpace(str);
+        qsizetype from = 0;
+        while ((from = str.indexOf(prefix, from)) != -1) {
+            from += prefix.size();
+            const qsizetype end = str.indexOf(QLatin1Char(']'), from);
+            if (end == -1)
+                break;
+            QList<qsizetype> &lines = file->m_snippetLines[str.mid(from, end - from)];
+            if (lines.isEmpty() || lines.constLast() != i)
+                lines.append(i);
+        }
+    }
+
+    if (!cacheKey.isEmpty())
+        s_fileCache.insert(cacheKey, file);
+    load(std::move(file));
+}
+
+/*!
+  Prepares quoting from the file stored under \a cacheKey by an
+  earlier call to quoteFromFile(). Returns \c false if no such
+  file is cached.
+ */
+bool Quoter::quoteFromCachedFile(const QString &cacheKey)
+{
+    auto file = s_fileCache.value(cacheKey);
+    if (!file)
+        return false;
+    load(std::move(file));
+    return true;
+}
+
+/*!
+  Drops the files cached by quoteFromFile(). The marked-up code
+  depends on the configuration, which changes between projects.
+ */
+void Quoter::clearCache()
+{
+    s_fileCache.clear();
+}
+
+void Quoter::load(std::shared_ptr<const QuotedFile> file)
+{
+    m_silent = false;
+    m_file = std::move(file);
+    m_cursor = 0;
+    m_codeLocation = Location(m_file->m_userFriendlyFilePath);
     m_codeLocation.start();
 }
 
+bool Quoter::atEnd() const
+{
+    return !m_file || m_cursor >= m_file->m_plainLines.size();
+}
+
+const QString &Quoter::currentPlainLine() const
+{
+    return m_file->m_plainLines.at(m_cursor);
+}
+
+/*!
+  Skips the lines before the next line that carries the snippet
+  marker for \a identifier, or all remaining lines if there is no
+  such line.
+ */
+void Quoter::skipToSnippet(const QString &identifier)
+{
+    if (atEnd())
+        return;
+
+    QString key = identifier;
+    trimWhiteSpace(key);
+    const auto it = m_file->m_snippetLines.constFind(key);
+    qsizetype target = m_file->m_plainLines.size();
+    if (it != m_file->m_snippetLines.constEnd()) {
+        auto next = std::lower_bound(it->constBegin(), it->constEnd(), m_cursor);
+        if (next != it->constEnd())
+            target = *next;
+    }
+    m_codeLocation.advanceLines(m_file->m_lineStarts.at(target)
+                                - m_file->m_lineStarts.at(m_cursor));
+    m_cursor = target;
+}
+
 QString Quoter::quoteLine(const Location &docLocation, const QString &command,
                           const QString &pattern)
 {
-    if (m_plainLines.isEmpty()) {
+    if (atEnd()) {
         failedAtEnd(docLocation, command);
         return QString();
     }
@@ -193,7 +308,7 @@ QString Quoter::quoteLine(const Location &docLocation, const QString &command,
         return QString();
     }
 
-    if (match(docLocation, pattern, m_plainLines.first()))
+    if (match(docLocation, pattern, currentPlainLine()))
         return getLine();
 
     if (!m_silent) {
@@ -211,8 +326,12 @@ QString Quoter::quoteSnippet(const Location &docLocation, const QString &identif
     QString t;
     int indent = 0;
 
-    while (!m_plainLines.isEmpty()) {
-        if (match(docLocation, delimiter, m_plainLines.first())) {
+    // The snippet index cannot represent identifiers containing ']'.
+    if (!identifier.contains(QLatin1Char(']')))
+        skipToSnippet(identifier);
+
+    while (!atEnd()) {
+        if (match(docLocation, delimiter, currentPlainLine())) {
             QString startLine = getLine();
             while (indent < startLine.length() && startLine[indent] == QLatin1Char(' '))
                 indent++;
@@ -220,8 +339,8 @@ QString Quoter::quoteSnippet(const Location &docLocation, const QString &identif
         }
         getLine();
     }
-    while (!m_plainLines.isEmpty()) {
-        QString line = m_plainLines.first();
+    while (!atEnd()) {
+        QString line = currentPlainLine();
         if (match(docLocation, delimiter, line)) {
             QString lastLine = getLine(indent);
             qsizetype dIndex = lastLine.indexOf(delimiter);
@@ -252,13 +371,13 @@ QString Quoter::quoteTo(const Location &docLocation, const QString &command, con
     QString comment = commentForCode();
 
     if (pattern.isEmpty()) {
-        while (!m_plainLines.isEmpty()) {
-            QString line = m_plainLines.first();
+        while (!atEnd()) {
+            QString line = currentPlainLine();
             t += removeSpecialLines(line, comment);
         }
     } else {
-        while (!m_plainLines.isEmpty()) {
-            if (match(docLocation, pattern, m_plainLines.first())) {
+        while (!atEnd()) {
+            if (match(docLocation, pattern, currentPlainLine())) {
                 return t;
             }
             t += getLine();
@@ -278,12 +397,10 @@ QString Quoter::quoteUntil(const Location &docLocation, const QString &command,
 
 QString Quoter::getLine(int unindent)
 {
-    if (m_plainLines.isEmpty())
+    if (atEnd())
         return QString();
 
-    m_plainLines.removeFirst();
-
-    QString t = m_markedLines.takeFirst();
+    QString t = m_file->m_markedLines.at(m_cursor++);
     int i = 0;
     while (i < unindent && i < t.length() && t[i] == QLatin1Char(' '))
         i++;
@@ -303,7 +420,7 @@ bool Quoter::match(const Location &docLocation, const QString &pattern0, const Q
     QString pattern = pattern0;
     if (pattern.startsWith(QLatin1Char('/')) && pattern.endsWith(QLatin1Char('/'))
         && pattern.length() > 2) {
-        QRegularExpression rx(pattern.mid(1, pattern.length() - 2));
+        const QRegularExpression rx = RegExpCache::get(pattern.mid(1, pattern.length() - 2));
         if (!m_silent && !rx.isValid()) {
             docLocation.warning(
                     QStringLiteral("Invalid regular expression '%1'").arg(rx.pattern()));
@@ -331,7 +448,12 @@ void Quoter::failedAtEnd(const Location &docLocation, const QString &command)
 
 QString Quoter::commentForCode() const
 {
-    QFileInfo fi = QFileInfo(m_codeLocation.fileName());
+    return commentForFile(m_codeLocation.fileName());
+}
+
+QString Quoter::commentForFile(const QString &fileName)
+{
+    QFileInfo fi = QFileInfo(fileName);
     if (fi.fileName() == "CMakeLists.txt")
         return "#!";
     return s_commentHash.value(fi.suffix(), "//!");
@@ -34,6 +34,8 @@
 #include <QtCore/qhash.h>
 #include <QtCore/qstringlist.h>
 
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 class Quoter
@@ -43,26 +45,44 @@ public:
 
     void reset();
     void quoteFromFile(const QString &userFriendlyFileName, const QString &plainCode,
-                       const QString &markedCode);
+                       const QString &markedCode, const QString &cacheKey = QString());
+    bool quoteFromCachedFile(const QString &cacheKey);
     QString quoteLine(const Location &docLocation, const QString &command, const QString &pattern);
     QString quoteTo(const Location &docLocation, const QString &command, const QString &pattern);
     QString quoteUntil(const Location &docLocation, const QString &command, const QString &pattern);
     QString quoteSnippet(const Location &docLocation, const QString &identifier);
 
     static QStringList splitLines(const QString &line);
+    static bool isCached(const QString &cacheKey) { return s_fileCache.contains(cacheKey); }
+    static void clearCache();
 
 private:
+    struct QuotedFile
+    {
+        QString m_userFriendlyFilePath {};
+        QStringList m_plainLines {};
+        QStringList m_markedLines {};
+        QList<int> m_lineStarts {};
+        QHash<QString, QList<qsizetype>> m_snippetLines {};
+    };
+
+    void load(std::shared_ptr<const QuotedFile> file);
+    [[nodiscard]] bool atEnd() const;
+    [[nodiscard]] const QString &currentPlainLine() const;
+    void skipToSnippet(const QString &identifier);
     QString getLine(int unindent = 0);
     void failedAtEnd(const Location &docLocation, const QString &command);
     bool match(const Location &docLocation, const QString &pattern, const QString &line);
     [[nodiscard]] QString commentForCode() const;
+    static QString commentForFile(const QString &fileName);
     QString removeSpecialLines(const QString &line, const QString &comment, int unindent = 0);
 
     bool m_silent {};
-    QStringList m_plainLines {};
-    QStringList m_markedLines {};
+    std::shared_ptr<const QuotedFile> m_file {};
+    qsizetype m_cursor {};
     Location m_codeLocation {};
     static QHash<QString, QString> s_commentHash;
+    static QHash<QString, std::shared_ptr<const QuotedFile>> s_fileCache;
 };
 
 QT_END_NAMESPACE
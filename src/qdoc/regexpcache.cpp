@@ -0,0 +1,80 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "regexpcache.h"
+
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \namespace RegExpCache
+    \internal
+    \brief Compiles each regular expression pattern only once.
+
+    Many patterns, such as the \c match expressions of macros or the
+    patterns of configuration variables, are used once per function,
+    macro expansion, or line of code. Constructing a QRegularExpression
+    for each use compiles the pattern again the first time it is
+    matched. RegExpCache hands out copies of a single, already
+    optimized instance per pattern instead. Copies share the compiled
+    pattern.
+*/
+
+namespace RegExpCache {
+
+using Key = std::pair<QString, int>;
+
+static QMutex s_mutex;
+static QHash<Key, QRegularExpression> s_regExps;
+
+/*!
+    Returns a compiled and JIT-optimized regular expression for
+    \a pattern and \a options. Invalid patterns are returned as
+    they are, so that callers can report the error.
+*/
+QRegularExpression get(const QString &pattern, QRegularExpression::PatternOptions options)
+{
+    const Key key(pattern, int(options));
+    QMutexLocker locker(&s_mutex);
+    auto it = s_regExps.constFind(key);
+    if (it != s_regExps.constEnd())
+        return *it;
+
+    QRegularExpression regExp(pattern, options);
+    regExp.optimize();
+    s_regExps.insert(key, regExp);
+    return regExp;
+}
+
+} // namespace RegExpCache
+
+QT_END_NAMESPACE
@@ -57,6 +57,9 @@ QList<Section> Sections::s_sinceSections(15, Section(Section::Details, Section::
 QList<Section> Sections::s_allMembers(1, Section(Section::AllMembers, Section::Active));
 QList<Section> Sections::s_stdQmlTypeSummarySections(7, Section(Section::Summary, Section::Active));
 QList<Section> Sections::s_stdQmlTypeDetailsSections(7, Section(Section::Details, Section::Active));
+QHash<const ClassNode *, QList<QList<ClassNode *>>> Sections::s_baseClassLevels;
+QHash<const ClassNode *, NodeList> Sections::s_ownMembers;
+QHash<const ClassNode *, NodeList> Sections::s_inheritedMembers;
 
 /*!
   \class Section
@@ -922,13 +925,94 @@ void Sections::distributeQmlNodeInSummaryVector(SectionVector &sv, Node *n, bool
     }
 }
 
-static void pushBaseClasses(QStack<ClassNode *> &stack, ClassNode *cn)
+/*!
+  Returns \c true if \a n belongs in the all-members section of a
+  class page.
+ */
+static bool isAllMembersCandidate(const Node *n)
+{
+    return !n->isPrivate() && !n->isProperty() && !n->isRelatedNonmember()
+            && !n->isSharedCommentNode();
+}
+
+/*!
+  Returns the classes in the hierarchy of \a cn, one list per
+  level of inheritance, in breadth-first order. The first level
+  contains \a cn itself and the second its direct base classes.
+  A class inherited more than once appears once for each path.
+
+  The levels of a class are those of its base classes, shifted
+  down one level and concatenated in the order of the bases, so
+  they are computed bottom-up and memoized per class. Derived
+  classes then reuse what was computed for their bases instead of
+  walking the hierarchy again.
+ */
+QList<QList<ClassNode *>> Sections::baseClassLevels(ClassNode *cn)
 {
-    const QList<RelatedClass> baseClasses = cn->baseClasses();
-    for (const auto &cls : baseClasses) {
-        if (cls.m_node)
-            stack.prepend(cls.m_node);
+    static QSet<const ClassNode *> inProgress;
+    auto it = s_baseClassLevels.constFind(cn);
+    if (it != s_baseClassLevels.cend())
+        return *it;
+
+    QList<QList<ClassNode *>> levels { { cn } };
+    if (!inProgress.contains(cn)) { // Guard against circular inheritance
+        inProgress.insert(cn);
+        const QList<RelatedClass> baseClasses = cn->baseClasses();
+        for (const auto &cls : baseClasses) {
+            if (!cls.m_node)
+                continue;
+            const QList<QList<ClassNode *>> baseLevels = baseClassLevels(cls.m_node);
+            if (levels.size() < baseLevels.size() + 1)
+                levels.resize(baseLevels.size() + 1);
+            for (qsizetype i = 0; i < baseLevels.size(); ++i)
+                levels[i + 1] += baseLevels.at(i);
+        }
+        inProgress.remove(cn);
     }
+    s_baseClassLevels.insert(cn, levels);
+    return levels;
+}
+
+/*!
+  Returns the members of the base classes of \a cn that go into
+  its all-members section, in the order they are inserted. The
+  list is memoized per class, so it is reused by every generator.
+ */
+NodeList Sections::inheritedMembers(ClassNode *cn)
+{
+    auto it = s_inheritedMembers.constFind(cn);
+    if (it != s_inheritedMembers.cend())
+        return *it;
+
+    NodeList members;
+    const QList<QList<ClassNode *>> levels = baseClassLevels(cn);
+    for (qsizetype i = 1; i < levels.size(); ++i) {
+        for (ClassNode *base : levels.at(i)) {
+            auto own = s_ownMembers.constFind(base);
+            if (own == s_ownMembers.cend()) {
+                NodeList candidates;
+                for (auto child = base->constBegin(); child != base->constEnd(); ++child) {
+                    if (isAllMembersCandidate(*child))
+                        candidates.append(*child);
+                }
+                own = s_ownMembers.insert(base, candidates);
+            }
+            members += *own;
+        }
+    }
+    s_inheritedMembers.insert(cn, members);
+    return members;
+}
+
+/*!
+  Clears the memoized class hierarchies and inherited members.
+  This must be called before the nodes they refer to are deleted.
+ */
+void Sections::clearInheritedMembers()
+{
+    s_baseClassLevels.clear();
+    s_ownMembers.clear();
+    s_inheritedMembers.clear();
 }
 
 /*!
@@ -945,8 +1029,7 @@ void Sections::buildStdCppClassRefPageSections()
         documentAll = false;
     for (auto it = m_aggregate->constBegin(); it != m_aggregate->constEnd(); ++it) {
         Node *n = *it;
-        if (!n->isPrivate() && !n->isProperty() && !n->isRelatedNonmember()
-            && !n->isSharedCommentNode())
+        if (isAllMembersCandidate(n))
             allMembers.insert(n);
         if (!documentAll && !n->hasDoc())
             continue;
@@ -960,21 +1043,9 @@ void Sections::buildStdCppClassRefPageSections()
             distributeNodeInSummaryVector(summarySections, node);
     }
 
-    QStack<ClassNode *> stack;
-    auto *cn = static_cast<ClassNode *>(m_aggregate);
-    pushBaseClasses(stack, cn);
-    while (!stack.isEmpty()) {
-        ClassNode *cn = stack.pop();
-        for (auto it = cn->constBegin(); it != cn->constEnd(); ++it) {
-            Node *n = *it;
-            if (!n->isPrivate() && !n->isProperty() && !n->isRelatedNonmember()
-                && !n->isSharedCommentNode())
-                allMembers.insert(n);
-            if (!documentAll && !n->hasDoc())
-                continue;
-        }
-        pushBaseClasses(stack, cn);
-    }
+    const NodeList inherited = inheritedMembers(static_cast<ClassNode *>(m_aggregate));
+    for (Node *n : inherited)
+        allMembers.insert(n);
     reduce(summarySections);
     reduce(detailsSections);
     allMembers.reduce();
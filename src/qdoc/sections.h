@@ -249,6 +249,8 @@ public:
 
     [[nodiscard]] Aggregate *aggregate() const { return m_aggregate; }
 
+    static void clearInheritedMembers();
+
 private:
     void stdRefPageSwitch(SectionVector &v, Node *n, Node *t = nullptr);
     void distributeNodeInSummaryVector(SectionVector &sv, Node *n);
@@ -256,6 +258,8 @@ private:
     void distributeQmlNodeInDetailsVector(SectionVector &dv, Node *n);
     void distributeQmlNodeInSummaryVector(SectionVector &sv, Node *n, bool sharing = false);
     void initAggregate(SectionVector &v, Aggregate *aggregate);
+    static QList<QList<ClassNode *>> baseClassLevels(ClassNode *cn);
+    static NodeList inheritedMembers(ClassNode *cn);
 
 private:
     Aggregate *m_aggregate { nullptr };
@@ -268,6 +272,9 @@ private:
     static SectionVector s_stdQmlTypeDetailsSections;
     static SectionVector s_sinceSections;
     static SectionVector s_allMembers;
+    static QHash<const ClassNode *, QList<QList<ClassNode *>>> s_baseClassLevels;
+    static QHash<const ClassNode *, NodeList> s_ownMembers;
+    static QHash<const ClassNode *, NodeList> s_inheritedMembers;
 };
 
 QT_END_NAMESPACE
@@ -61,7 +61,8 @@ TagFileWriter::TagFileWriter() : m_qdb(QDocDatabase::qdocDB()) { }
  */
 void TagFileWriter::generateTagFileCompounds(QXmlStreamWriter &writer, const Aggregate *parent)
 {
-    const auto &nonFunctionList = const_cast<Aggregate *>(parent)->nonfunctionList();
+    NodeList nonFunctionList;
+    parent->fillNonfunctionList(nonFunctionList);
     for (const auto *node : nonFunctionList) {
         if (!node->url().isNull() || node->isPrivate())
             continue;
@@ -83,14 +84,8 @@ void TagFileWriter::generateTagFileCompounds(QXmlStreamWriter &writer, const Agg
         }
         const auto *aggregate = static_cast<const Aggregate *>(node);
 
-        QString access = "public";
-        if (node->isProtected())
-            access = "protected";
-
-        QString objName = node->name();
-
         // Special case: only the root node should have an empty name.
-        if (objName.isEmpty() && node != m_qdb->primaryTreeRoot())
+        if (node->name().isEmpty() && node != m_qdb->primaryTreeRoot())
             continue;
 
         // *** Write the starting tag for the element here. ***
@@ -141,46 +136,46 @@ void TagFileWriter::generateTagFileMembers(QXmlStreamWriter &writer, const Aggre
         if (!node->url().isNull())
             continue;
 
-        QString nodeName;
-        QString kind;
+        QLatin1String nodeName;
+        QLatin1String kind;
         switch (node->nodeType()) {
         case Node::Enum:
-            nodeName = "member";
-            kind = "enumeration";
+            nodeName = QLatin1String("member");
+            kind = QLatin1String("enumeration");
             break;
         case Node::TypeAlias: // Treated as typedef
         case Node::Typedef:
-            nodeName = "member";
-            kind = "typedef";
+            nodeName = QLatin1String("member");
+            kind = QLatin1String("typedef");
             break;
         case Node::Property:
-            nodeName = "member";
-            kind = "property";
+            nodeName = QLatin1String("member");
+            kind = QLatin1String("property");
             break;
         case Node::Function:
-            nodeName = "member";
-            kind = "function";
+            nodeName = QLatin1String("member");
+            kind = QLatin1String("function");
             break;
         case Node::Namespace:
-            nodeName = "namespace";
+            nodeName = QLatin1String("namespace");
             break;
         case Node::Class:
         case Node::Struct:
         case Node::Union:
-            nodeName = "class";
+            nodeName = QLatin1String("class");
             break;
         case Node::Variable:
         default:
             continue;
         }
 
-        QString access;
+        QLatin1String access;
         switch (node->access()) {
         case Access::Public:
-            access = "public";
+            access = QLatin1String("public");
             break;
         case Access::Protected:
-            access = "protected";
+            access = QLatin1String("protected");
             break;
         case Access::Private:
         default:
@@ -193,6 +188,19 @@ void TagFileWriter::generateTagFileMembers(QXmlStreamWriter &writer, const Aggre
         if (objName.isEmpty() && node != m_qdb->primaryTreeRoot())
             continue;
 
+        // Members are written with their anchor file and anchor, which
+        // are the two halves of the document location of the node.
+        QString anchorFile;
+        QString anchor;
+        if (nodeName == QLatin1String("member")) {
+            anchorFile = m_generator->fullDocumentLocation(node, false);
+            const qsizetype hash = anchorFile.indexOf(QLatin1Char('#'));
+            if (hash >= 0) {
+                anchor = anchorFile.mid(hash + 1);
+                anchorFile.truncate(hash);
+            }
+        }
+
         // *** Write the starting tag for the element here. ***
         writer.writeStartElement(nodeName);
         if (!kind.isEmpty())
@@ -226,10 +234,8 @@ void TagFileWriter::generateTagFileMembers(QXmlStreamWriter &writer, const Aggre
                 writer.writeTextElement("type", "virtual " + functionNode->returnType());
 
             writer.writeTextElement("name", objName);
-            const QStringList pieces =
-                    m_generator->fullDocumentLocation(node, false).split(QLatin1Char('#'));
-            writer.writeTextElement("anchorfile", pieces[0]);
-            writer.writeTextElement("anchor", pieces[1]);
+            writer.writeTextElement("anchorfile", anchorFile);
+            writer.writeTextElement("anchor", anchor);
             QString signature = functionNode->signature(false, false);
             signature = signature.mid(signature.indexOf(QChar('('))).trimmed();
             if (functionNode->isConst())
@@ -248,10 +254,8 @@ void TagFileWriter::generateTagFileMembers(QXmlStreamWriter &writer, const Aggre
             const auto *propertyNode = static_cast<const PropertyNode *>(node);
             writer.writeAttribute("type", propertyNode->dataType());
             writer.writeTextElement("name", objName);
-            const QStringList pieces =
-                    m_generator->fullDocumentLocation(node, false).split(QLatin1Char('#'));
-            writer.writeTextElement("anchorfile", pieces[0]);
-            writer.writeTextElement("anchor", pieces[1]);
+            writer.writeTextElement("anchorfile", anchorFile);
+            writer.writeTextElement("anchor", anchor);
             writer.writeTextElement("arglist", QString());
         }
             writer.writeEndElement(); // member
@@ -259,18 +263,16 @@ void TagFileWriter::generateTagFileMembers(QXmlStreamWriter &writer, const Aggre
         case Node::Enum: {
             const auto *enumNode = static_cast<const EnumNode *>(node);
             writer.writeTextElement("name", objName);
-            const QStringList pieces =
-                    m_generator->fullDocumentLocation(node, false).split(QLatin1Char('#'));
-            writer.writeTextElement("anchorfile", pieces[0]);
-            writer.writeTextElement("anchor", pieces[1]);
+            writer.writeTextElement("anchorfile", anchorFile);
+            writer.writeTextElement("anchor", anchor);
             writer.writeEndElement(); // member
 
             for (const auto &item : enumNode->items()) {
                 writer.writeStartElement("member");
                 writer.writeAttribute("kind", "enumvalue");
                 writer.writeTextElement("name", item.name());
-                writer.writeTextElement("anchorfile", pieces[0]);
-                writer.writeTextElement("anchor", pieces[1]);
+                writer.writeTextElement("anchorfile", anchorFile);
+                writer.writeTextElement("anchor", anchor);
                 writer.writeTextElement("arglist", QString());
                 writer.writeEndElement(); // member
             }
@@ -283,10 +285,8 @@ void TagFileWriter::generateTagFileMembers(QXmlStreamWriter &writer, const Aggre
             else
                 writer.writeAttribute("type", QString());
             writer.writeTextElement("name", objName);
-            const QStringList pieces =
-                    m_generator->fullDocumentLocation(node, false).split(QLatin1Char('#'));
-            writer.writeTextElement("anchorfile", pieces[0]);
-            writer.writeTextElement("anchor", pieces[1]);
+            writer.writeTextElement("anchorfile", anchorFile);
+            writer.writeTextElement("anchor", anchor);
             writer.writeTextElement("arglist", QString());
         }
             writer.writeEndElement(); // member
@@ -304,6 +304,7 @@ void TagFileWriter::generateTagFileMembers(QXmlStreamWriter &writer, const Aggre
  */
 void TagFileWriter::generateTagFile(const QString &fileName, Generator *g)
 {
+    m_generator = g;
     QFile file(fileName);
     QFileInfo fileInfo(fileName);
 
@@ -317,7 +318,6 @@ void TagFileWriter::generateTagFile(const QString &fileName, Generator *g)
         return;
     }
 
-    m_generator = g;
     QXmlStreamWriter writer(&file);
     writer.setAutoFormatting(true);
     writer.writeStartDocument();
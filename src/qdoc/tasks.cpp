@@ -0,0 +1,172 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "tasks.h"
+
+#include <QtCore/qthreadpool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \namespace Tasks
+    \internal
+    \brief Runs qdoc's concurrent work on one shared QThreadPool.
+
+    The phases that can use more than one thread, from scanning the
+    source directories and parsing to resolving and writing pages,
+    hand their work to the same pool instead of starting threads of
+    their own. The pool is sized by \c -jobs; Config passes the job
+    count on with setJobCount().
+
+    The pool only runs the tasks. Each caller decides what a task may
+    touch: the code run by tasks reads the database and the
+    configuration, which don't change while tasks run, and collects
+    its results per task, to be merged by the caller. State that is
+    shared regardless, like the warnings reported through Location,
+    is locked where it is updated.
+ */
+namespace Tasks {
+
+static std::atomic<int> s_jobs { 1 };
+
+/*
+    The pool is never destroyed: qdoc may exit() from a task on a
+    fatal error, and waiting for the workers from a static destructor
+    would then wait for the exiting thread itself.
+ */
+static QThreadPool &pool()
+{
+    static QThreadPool *instance = [] {
+        auto *pool = new QThreadPool;
+        // Keep at least one worker, so that queued tasks always run.
+        pool->setMaxThreadCount(1);
+        return pool;
+    }();
+    return *instance;
+}
+
+/*!
+    Sets the number of jobs that may run at the same time to \a jobs,
+    counting the thread that waits for them.
+ */
+void setJobCount(int jobs)
+{
+    s_jobs = std::max(jobs, 1);
+    pool().setMaxThreadCount(std::max(s_jobs.load(), 2) - 1);
+}
+
+/*!
+    Returns the number of jobs that may run at the same time. A value
+    of 1 means that qdoc does all of its work on the calling thread.
+ */
+int jobCount()
+{
+    return s_jobs;
+}
+
+/*!
+    Waits for the queued tasks to finish. The worker threads are
+    left to expire.
+ */
+void terminate()
+{
+    pool().waitForDone();
+}
+
+/*!
+    Queues \a task to run on a worker thread of the pool.
+
+    \sa run()
+ */
+void enqueue(std::function<void()> task)
+{
+    pool().start(std::move(task));
+}
+
+/*!
+    Calls \a task with each index from 0 to \a count - 1, on up to
+    jobCount() threads, and returns when all calls have returned. The
+    calling thread takes part in the work, so forEach() can be used
+    from a task without waiting for workers that are busy elsewhere.
+
+    With one job, or fewer than two indexes, the calls are made in
+    order on the calling thread.
+ */
+void forEach(qsizetype count, const std::function<void(qsizetype)> &task)
+{
+    const int jobs = jobCount();
+    if (jobs < 2 || count < 2) {
+        for (qsizetype i = 0; i < count; ++i)
+            task(i);
+        return;
+    }
+
+    struct State
+    {
+        std::atomic<qsizetype> m_next { 0 };
+        std::mutex m_mutex;
+        std::condition_variable m_done;
+        int m_active { 0 };
+        bool m_closed { false };
+    };
+    auto state = std::make_shared<State>();
+    auto drain = [state, &task, count]() {
+        for (qsizetype i = state->m_next++; i < count; i = state->m_next++)
+            task(i);
+    };
+
+    const qsizetype helpers = std::min<qsizetype>(jobs, count) - 1;
+    for (qsizetype i = 0; i < helpers; ++i) {
+        pool().start([state, drain]() {
+            {
+                // A helper that starts after the caller is done must not touch the task.
+                std::lock_guard<std::mutex> lock(state->m_mutex);
+                if (state->m_closed)
+                    return;
+                ++state->m_active;
+            }
+            drain();
+            std::lock_guard<std::mutex> lock(state->m_mutex);
+            if (--state->m_active == 0)
+                state->m_done.notify_all();
+        });
+    }
+    drain();
+
+    std::unique_lock<std::mutex> lock(state->m_mutex);
+    state->m_closed = true;
+    state->m_done.wait(lock, [&state]() { return state->m_active == 0; });
+}
+}
+
+QT_END_NAMESPACE
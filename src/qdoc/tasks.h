@@ -0,0 +1,67 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef TASKS_H
+#define TASKS_H
+
+#include <QtCore/qglobal.h>
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+
+QT_BEGIN_NAMESPACE
+
+namespace Tasks {
+void setJobCount(int jobs);
+int jobCount();
+void terminate();
+
+void enqueue(std::function<void()> task);
+void forEach(qsizetype count, const std::function<void(qsizetype)> &task);
+
+/*!
+    Runs \a function on a worker thread of the shared pool and
+    returns a future for its result.
+ */
+template <typename Function>
+auto run(Function &&function) -> std::future<std::invoke_result_t<std::decay_t<Function>>>
+{
+    using Result = std::invoke_result_t<std::decay_t<Function>>;
+    // std::function needs a copyable callable; a packaged_task is move-only.
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Function>(function));
+    auto future = task->get_future();
+    enqueue([task]() { (*task)(); });
+    return future;
+}
+}
+
+QT_END_NAMESPACE
+
+#endif // TASKS_H
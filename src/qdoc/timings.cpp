@@ -0,0 +1,270 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "timings.h"
+
+#include "utilities.h"
+
+#include <QtCore/qfile.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qthread.h>
+
+#if defined(Q_OS_UNIX)
+#    include <sys/resource.h>
+#endif
+
+#include <atomic>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \namespace Timings
+    \internal
+    \brief Records where qdoc spends its time.
+
+    When qdoc runs with \c -timings or \c {-trace <file>}, each
+    Timings::Scope measures the wall time of the code it encloses.
+    \c -timings prints a summary table of the phases and counters
+    at the end of each qdocconf file. \c -trace writes every scope,
+    including the worker threads, as a Chrome trace event file that
+    can be loaded in \c {chrome://tracing} or Perfetto.
+
+    When neither option is given, a scope costs one branch.
+ */
+namespace Timings {
+
+struct Event
+{
+    const char *m_name;
+    QString m_detail;
+    qint64 m_start;
+    qint64 m_duration;
+    int m_thread;
+};
+
+struct PhaseTotal
+{
+    qint64 m_duration { 0 };
+    int m_calls { 0 };
+    qint64 m_peakRss { 0 };
+};
+
+static bool s_enabled = false;
+static bool s_summary = false;
+static QString s_traceFile;
+static QElapsedTimer s_clock;
+static QMutex s_mutex;
+static QList<Event> s_events;
+static QList<QByteArray> s_phaseOrder;
+static QHash<QByteArray, PhaseTotal> s_phases;
+static QHash<Qt::HANDLE, int> s_threads;
+static std::atomic<qint64> s_counters[CounterCount];
+
+static const char *counterName(Counter counter)
+{
+    switch (counter) {
+    case LinkLookups:
+        return "link target lookups";
+    case PagesWritten:
+        return "pages written";
+    case ClangParses:
+        return "clang translation units";
+    case CounterCount:
+        break;
+    }
+    return "";
+}
+
+/*!
+    Returns the peak resident set size of the process in kilobytes,
+    or 0 where it cannot be determined.
+ */
+static qint64 peakRss()
+{
+#if defined(Q_OS_UNIX)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#    if defined(Q_OS_DARWIN)
+    return usage.ru_maxrss / 1024;
+#    else
+    return usage.ru_maxrss;
+#    endif
+#else
+    return 0;
+#endif
+}
+
+/*!
+    Enables the instrumentation. If \a summary is \c true, a
+    summary is printed by report(). If \a traceFile is not empty,
+    terminate() writes the recorded scopes to it.
+ */
+void initialize(bool summary, const QString &traceFile)
+{
+    s_summary = summary;
+    s_traceFile = traceFile;
+    s_enabled = summary || !traceFile.isEmpty();
+    if (s_enabled)
+        s_clock.start();
+}
+
+/*!
+    Writes the trace file, if one was requested.
+ */
+void terminate()
+{
+    if (!s_enabled || s_traceFile.isEmpty())
+        return;
+
+    QMutexLocker locker(&s_mutex);
+    QJsonArray events;
+    for (const auto &event : qAsConst(s_events)) {
+        QJsonObject object;
+        object.insert(QLatin1String("name"), QLatin1String(event.m_name));
+        object.insert(QLatin1String("cat"), QLatin1String("qdoc"));
+        object.insert(QLatin1String("ph"), QLatin1String("X"));
+        object.insert(QLatin1String("ts"), event.m_start);
+        object.insert(QLatin1String("dur"), event.m_duration);
+        object.insert(QLatin1String("pid"), 1);
+        object.insert(QLatin1String("tid"), event.m_thread);
+        if (!event.m_detail.isEmpty()) {
+            QJsonObject args;
+            args.insert(QLatin1String("detail"), event.m_detail);
+            object.insert(QLatin1String("args"), args);
+        }
+        events.append(object);
+    }
+    s_events.clear();
+
+    QFile file(s_traceFile);
+    if (!file.open(QFile::WriteOnly)) {
+        qCWarning(lcQdoc) << "Cannot write trace file" << s_traceFile << file.errorString();
+        return;
+    }
+    file.write(QJsonDocument(events).toJson(QJsonDocument::Compact));
+}
+
+bool enabled()
+{
+    return s_enabled;
+}
+
+/*!
+    Increments \a counter. This function is thread-safe.
+ */
+void count(Counter counter)
+{
+    if (s_enabled)
+        s_counters[counter].fetch_add(1, std::memory_order_relaxed);
+}
+
+/*!
+    Prints the phase totals and counters recorded since the previous
+    report, labelled with \a project, and resets them.
+ */
+void report(const QString &project)
+{
+    if (!s_summary)
+        return;
+
+    QMutexLocker locker(&s_mutex);
+    qCInfo(lcQdoc).noquote() << "Timings for" << project;
+    for (const auto &name : qAsConst(s_phaseOrder)) {
+        const PhaseTotal &total = s_phases.value(name);
+        qCInfo(lcQdoc).noquote() << QStringLiteral("  %1 %2 ms %3 calls, peak RSS %4 MB")
+                                            .arg(QString::fromLatin1(name), -28)
+                                            .arg(total.m_duration / 1000, 8)
+                                            .arg(total.m_calls, 6)
+                                            .arg(total.m_peakRss / 1024);
+    }
+    for (int i = 0; i < CounterCount; ++i) {
+        qCInfo(lcQdoc).noquote() << QStringLiteral("  %1 %2")
+                                            .arg(QString::fromLatin1(
+                                                         counterName(static_cast<Counter>(i))),
+                                                 -28)
+                                            .arg(s_counters[i].exchange(0), 8);
+    }
+    s_phaseOrder.clear();
+    s_phases.clear();
+}
+
+/*!
+    \class Timings::Scope
+    \internal
+    \brief Measures the wall time from its construction to its destruction.
+
+    The \a name must be a string literal; it names the phase in the
+    summary and the trace. \a detail, for example a file name, only
+    appears in the trace.
+ */
+Scope::Scope(const char *name, const QString &detail) : m_name(name)
+{
+    if (!s_enabled)
+        return;
+    if (!s_traceFile.isEmpty())
+        m_detail = detail;
+    m_start = s_clock.nsecsElapsed() / 1000;
+}
+
+Scope::~Scope()
+{
+    if (m_start < 0)
+        return;
+
+    const qint64 duration = s_clock.nsecsElapsed() / 1000 - m_start;
+    const qint64 rss = peakRss();
+
+    QMutexLocker locker(&s_mutex);
+    const QByteArray name(m_name);
+    auto it = s_phases.find(name);
+    if (it == s_phases.end()) {
+        s_phaseOrder.append(name);
+        it = s_phases.insert(name, PhaseTotal());
+    }
+    it->m_duration += duration;
+    ++it->m_calls;
+    it->m_peakRss = qMax(it->m_peakRss, rss);
+
+    if (!s_traceFile.isEmpty()) {
+        const Qt::HANDLE thread = QThread::currentThreadId();
+        auto threadIt = s_threads.constFind(thread);
+        if (threadIt == s_threads.constEnd())
+            threadIt = s_threads.insert(thread, s_threads.size() + 1);
+        s_events.append({ m_name, m_detail, m_start, duration, threadIt.value() });
+    }
+}
+
+} // namespace Timings
+
+QT_END_NAMESPACE
@@ -37,6 +37,7 @@
 #include <QtCore/qstring.h>
 #include <QtCore/qstringconverter.h>
 
+#include <algorithm>
 #include <cctype>
 #include <cstring>
 #include <utility>
@@ -109,6 +110,7 @@ static const char *kwords[] = { "char",
 
 static const int KwordHashTableSize = 4096;
 static int kwordHashTable[KwordHashTableSize];
+static size_t maxKwordLength = 0;
 
 static QHash<QByteArray, bool> *ignoredTokensAndDirectives = nullptr;
 
@@ -118,6 +120,7 @@ static QRegularExpression *definedX = nullptr;
 
 static QRegularExpression *defines = nullptr;
 static QRegularExpression *falsehoods = nullptr;
+static QHash<QString, bool> *conditionResults = nullptr;
 
 static QStringDecoder sourceDecoder;
 
@@ -133,7 +136,9 @@ static int hashKword(const char *s, int len)
 
 static void insertKwordIntoHash(const char *s, int number)
 {
-    int k = hashKword(s, int(strlen(s)));
+    const size_t len = strlen(s);
+    maxKwordLength = std::max(maxKwordLength, len);
+    int k = hashKword(s, int(len));
     while (kwordHashTable[k]) {
         if (++k == KwordHashTableSize)
             k = 0;
@@ -143,8 +148,8 @@ static void insertKwordIntoHash(const char *s, int number)
 
 Tokenizer::Tokenizer(const Location &loc, QFile &in)
 {
-    init();
     m_in = in.readAll();
+    init();
     m_pos = 0;
     start(loc);
 }
@@ -175,13 +180,19 @@ int Tokenizer::getToken()
         m_lexLen = 0;
 
         if (isspace(m_ch)) {
-            do {
-                m_ch = getChar();
-            } while (isspace(m_ch));
+            qsizetype end = m_pos;
+            while (end < m_in.size() && isspace(uchar(m_in.at(end))))
+                ++end;
+            getCharsUntil(end);
         } else if (isalpha(m_ch) || m_ch == '_') {
-            do {
-                m_ch = getChar();
-            } while (isalnum(m_ch) || m_ch == '_');
+            qsizetype end = m_pos;
+            while (end < m_in.size() && (isalnum(uchar(m_in.at(end))) || m_in.at(end) == '_'))
+                ++end;
+            getCharsUntil(end);
+
+            // No keyword, ignored token or directive is this long.
+            if (m_lexLen > maxKwordLength)
+                return Tok_Ident;
 
             int k = hashKword(m_lex, int(m_lexLen));
             for (;;) {
@@ -354,35 +365,34 @@ int Tokenizer::getToken()
             case '/':
                 m_ch = getChar();
                 if (m_ch == '/') {
-                    do {
-                        m_ch = getChar();
-                    } while (m_ch != EOF && m_ch != '\n');
+                    qsizetype end = m_in.indexOf('\n', m_pos - 1);
+                    getCharsUntil(end == -1 ? m_in.size() : end);
                 } else if (m_ch == '*') {
                     bool metDoc = false; // empty doc is no doc
                     bool metSlashAsterBang = false;
-                    bool metAster = false;
-                    bool metAsterSlash = false;
 
                     m_ch = getChar();
                     if (m_ch == '!')
                         metSlashAsterBang = true;
 
-                    while (!metAsterSlash) {
-                        if (m_ch == EOF) {
-                            m_tokLoc.warning(QStringLiteral("Unterminated C++ comment"));
-                            break;
-                        } else {
-                            if (m_ch == '*') {
-                                metAster = true;
-                            } else if (metAster && m_ch == '/') {
-                                metAsterSlash = true;
-                            } else {
-                                metAster = false;
-                                if (isgraph(m_ch))
-                                    metDoc = true;
-                            }
+                    if (m_ch == EOF) {
+                        m_tokLoc.warning(QStringLiteral("Unterminated C++ comment"));
+                    } else {
+                        /*
+                          Find the end of the comment in one search
+                          instead of stepping through it.
+                         */
+                        const qsizetype begin = m_pos - 1;
+                        const qsizetype close = m_in.indexOf("*/", begin);
+                        const qsizetype end = close == -1 ? m_in.size() : close;
+                        for (qsizetype i = begin; i < end && !metDoc; ++i) {
+                            const char c = m_in.at(i);
+                            if (c != '*' && isgraph(uchar(c)))
+                                metDoc = true;
                         }
-                        m_ch = getChar();
+                        getCharsUntil(close == -1 ? end : end + 2);
+                        if (close == -1)
+                            m_tokLoc.warning(QStringLiteral("Unterminated C++ comment"));
                     }
                     if (metSlashAsterBang && metDoc)
                         return Tok_Doc;
@@ -530,10 +540,13 @@ void Tokenizer::initialize()
     defines = new QRegularExpression(QRegularExpression::anchoredPattern(d.join('|')));
     falsehoods = new QRegularExpression(QRegularExpression::anchoredPattern(config.getStringList(CONFIG_FALSEHOODS).join('|')));
 
+    conditionResults = new QHash<QString, bool>;
+
     /*
       The keyword hash table is always cleared before any words are inserted.
      */
     memset(kwordHashTable, 0, sizeof(kwordHashTable));
+    maxKwordLength = 0;
     for (int i = 0; i < Tok_LastKeyword - Tok_FirstKeyword + 1; i++)
         insertKwordIntoHash(kwords[i], i + 1);
 
@@ -573,14 +586,21 @@ void Tokenizer::terminate()
     defines = nullptr;
     delete falsehoods;
     falsehoods = nullptr;
+    delete conditionResults;
+    conditionResults = nullptr;
     delete ignoredTokensAndDirectives;
     ignoredTokensAndDirectives = nullptr;
 }
 
 void Tokenizer::init()
 {
-    m_lexBuf1 = new char[(int)yyLexBufSize];
-    m_lexBuf2 = new char[(int)yyLexBufSize];
+    /*
+      A token can't be longer than the input, so don't allocate the
+      full buffers for small inputs like function signatures.
+     */
+    m_lexBufSize = std::min(size_t(yyLexBufSize), size_t(m_in.size()) + 32);
+    m_lexBuf1 = new char[m_lexBufSize];
+    m_lexBuf2 = new char[m_lexBufSize];
     m_prevLex = m_lexBuf1;
     m_prevLex[0] = '\0';
     m_lex = m_lexBuf2;
@@ -610,6 +630,41 @@ void Tokenizer::start(const Location &loc)
     m_ch = getChar();
 }
 
+/*
+  Makes the character at \a end in the input the current one, as
+  calling getChar() until then would, but appends the characters in
+  between to the lexeme and advances the location over them in one go.
+*/
+void Tokenizer::getCharsUntil(qsizetype end)
+{
+    if (m_ch == EOF)
+        return;
+    const qsizetype begin = m_pos - 1;
+    const qsizetype n = end - begin;
+    const qsizetype room = qsizetype(m_lexBufSize - 1 - m_lexLen);
+    const qsizetype copied = std::min(n, room);
+    memcpy(m_lex + m_lexLen, m_in.constData() + begin, size_t(copied));
+    m_lexLen += size_t(copied);
+    m_lex[m_lexLen] = '\0';
+    if (copied < n && !token_too_long_warning_was_issued)
+        warnTokenTooLong();
+    m_curLoc.advance(m_in.constData() + begin, n);
+    m_pos = int(end);
+    const int ch = getch();
+    m_ch = ch == EOF ? EOF : int(uint(uchar(ch)));
+}
+
+void Tokenizer::warnTokenTooLong()
+{
+    location().warning(
+        u"The content is too long.\n"_qs,
+        u"The maximum amount of characters for this content is %1.\n"_qs.arg(m_lexBufSize) +
+        "Consider splitting it or reducing its size."
+    );
+
+    token_too_long_warning_was_issued = true;
+}
+
 /*
   Returns the next token, if # was met.  This function interprets the
   preprocessor directive, skips over any #ifdef'd out tokens, and returns the
@@ -740,8 +795,23 @@ bool Tokenizer::popSkipping()
   condition is represented by a string.  Unsophisticated parsing techniques are
   used.  The preprocessing method could be named StriNg-Oriented PreProcessing,
   as SNOBOL stands for StriNg-Oriented symBOlic Language.
+
+  The result only depends on the defines and falsehoods of the
+  configuration, so it is cached per condition until terminate().
 */
 bool Tokenizer::isTrue(const QString &condition)
+{
+    if (!conditionResults)
+        return evaluateCondition(condition);
+    auto it = conditionResults->constFind(condition);
+    if (it != conditionResults->cend())
+        return *it;
+    const bool result = evaluateCondition(condition);
+    conditionResults->insert(condition, result);
+    return result;
+}
+
+bool Tokenizer::evaluateCondition(const QString &condition)
 {
     int firstOr = -1;
     int firstAnd = -1;
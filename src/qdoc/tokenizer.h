@@ -124,6 +124,7 @@ public:
     static bool isTrue(const QString &condition);
 
 private:
+    static bool evaluateCondition(const QString &condition);
     void init();
     void start(const Location &loc);
     /*
@@ -142,17 +143,11 @@ private:
     {
         if (m_ch == EOF)
             return EOF;
-        if (m_lexLen < yyLexBufSize - 1) {
+        if (m_lexLen < m_lexBufSize - 1) {
             m_lex[m_lexLen++] = (char)m_ch;
             m_lex[m_lexLen] = '\0';
         } else if (!token_too_long_warning_was_issued) {
-            location().warning(
-                u"The content is too long.\n"_qs,
-                u"The maximum amount of characters for this content is %1.\n"_qs.arg(yyLexBufSize) +
-                "Consider splitting it or reducing its size."
-            );
-
-            token_too_long_warning_was_issued = true;
+            warnTokenTooLong();
         }
         m_curLoc.advance(QChar(m_ch));
         int ch = getch();
@@ -164,6 +159,8 @@ private:
         return int(uint(uchar(ch)));
     }
 
+    void getCharsUntil(qsizetype end);
+    void warnTokenTooLong();
     int getTokenAfterPreprocessor();
     void pushSkipping(bool skip);
     bool popSkipping();
@@ -175,6 +172,7 @@ private:
     char *m_prevLex { nullptr };
     char *m_lex { nullptr };
     size_t m_lexLen {};
+    size_t m_lexBufSize {};
     QStack<bool> m_preprocessorSkipping;
     int m_numPreprocessorSkipping {};
     int m_braceDepth {};
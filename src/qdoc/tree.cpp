@@ -37,6 +37,7 @@
 #include "location.h"
 #include "node.h"
 #include "qdocdatabase.h"
+#include "qmltypenode.h"
 #include "text.h"
 #include "typedefnode.h"
 #include "usingclause.h"
@@ -308,6 +309,38 @@ void Tree::resolveCppToQmlLinks()
     }
 }
 
+/*!
+  Drops the links that the nodes in this tree, starting at
+  \a parent, hold to nodes in the \a other tree. If \a parent
+  is \nullptr, the root of this tree is used.
+
+  This is called for each index tree before the primary tree
+  \a other is deleted, so that the index trees can be reused
+  for documenting another module. QML base types that pointed
+  into \a other are resolved again by name when needed.
+ */
+void Tree::detachFrom(const Tree *other, Aggregate *parent)
+{
+    if (!parent)
+        parent = &m_root;
+    for (auto *child : parent->childNodes()) {
+        if (child->isClassNode()) {
+            auto *cn = static_cast<ClassNode *>(child);
+            cn->derivedClasses().removeIf([other](const RelatedClass &rc) {
+                return rc.m_node && rc.m_node->tree() == other;
+            });
+            if (cn->qmlElement() && cn->qmlElement()->tree() == other)
+                cn->setQmlElement(nullptr);
+        } else if (child->isQmlType() || child->isJsType()) {
+            auto *qcn = static_cast<QmlTypeNode *>(child);
+            if (qcn->qmlBaseNode() && qcn->qmlBaseNode()->tree() == other)
+                qcn->resetQmlBaseNode();
+        }
+        if (child->isAggregate())
+            detachFrom(other, static_cast<Aggregate *>(child));
+    }
+}
+
 /*!
   For each C++ class node, resolve any \c using clauses
   that appeared in the class declaration.
@@ -36,6 +36,7 @@
 #include "proxynode.h"
 #include "qmltypenode.h"
 
+#include <QtCore/qhash.h>
 #include <QtCore/qstack.h>
 
 #include <utility>
@@ -74,7 +75,7 @@ public:
     TargetLoc() = default;
 };
 
-typedef QMultiMap<QString, TargetRec *> TargetMap;
+typedef QMultiHash<QString, TargetRec *> TargetMap;
 typedef QMultiMap<QString, PageNode *> PageNodeMultiMap;
 typedef QMap<QString, QmlTypeNode *> QmlTypeMap;
 typedef QMultiMap<QString, const ExampleNode *> ExampleNodeMap;
@@ -138,6 +139,7 @@ private: // The rest of the class is private.
     void resolvePropertyOverriddenFromPtrs(Aggregate *n);
     void resolveProperties();
     void resolveCppToQmlLinks();
+    void detachFrom(const Tree *other, Aggregate *parent = nullptr);
     void resolveUsingClauses(Aggregate *parent = nullptr);
     void removePrivateAndInternalBases(NamespaceNode *rootNode);
     NamespaceNode *root() { return &m_root; }
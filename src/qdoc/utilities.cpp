@@ -29,6 +29,9 @@
 #include <QtCore/qprocess.h>
 #include "utilities.h"
 
+#include <QtCore/qmutex.h>
+#include <QtCore/qset.h>
+
 QT_BEGIN_NAMESPACE
 
 Q_LOGGING_CATEGORY(lcQdoc, "qt.qdoc")
@@ -103,6 +106,101 @@ QString comma(qsizetype wordPosition, qsizetype numberOfWords)
     return QStringLiteral(", and ");
 }
 
+/*!
+    \internal
+    Returns the character reference that replaces \a c in HTML
+    output, or \nullptr if \a c can be written as is.
+
+    Only \c &, \c <, \c > and \c {"} are replaced. They are all
+    below 64, so one shift and mask tell most characters apart.
+ */
+static inline const char *htmlEntity(char16_t c)
+{
+    constexpr quint64 specials = (quint64(1) << '&') | (quint64(1) << '<')
+            | (quint64(1) << '>') | (quint64(1) << '"');
+    if (c >= 64 || !(specials & (quint64(1) << c)))
+        return nullptr;
+    switch (c) {
+    case '&':
+        return "&amp;";
+    case '<':
+        return "&lt;";
+    case '>':
+        return "&gt;";
+    default:
+        return "&quot;";
+    }
+}
+
+/*!
+    \internal
+    Appends \a string to \a output with the characters that are
+    special in HTML replaced by character references. The runs of
+    characters between them are appended in one piece.
+ */
+void appendHtmlEscaped(QString *output, QStringView string)
+{
+    const char16_t *data = string.utf16();
+    const qsizetype n = string.size();
+    output->reserve(output->size() + n + 30);
+    qsizetype start = 0;
+    for (qsizetype i = 0; i < n; ++i) {
+        if (const char *entity = htmlEntity(data[i])) {
+            output->append(QStringView(data + start, i - start));
+            output->append(QLatin1String(entity));
+            start = i + 1;
+        }
+    }
+    output->append(QStringView(data + start, n - start));
+}
+
+/*!
+    \internal
+    Returns \a string with the characters that are special in HTML
+    replaced by character references. If there are none, \a string
+    itself is returned, without copying its data.
+ */
+QString htmlEscaped(const QString &string)
+{
+    const QStringView view(string);
+    qsizetype i = 0;
+    while (i < view.size() && !htmlEntity(view[i].unicode()))
+        ++i;
+    if (i == view.size())
+        return string;
+
+    QString escaped;
+    escaped.reserve(view.size() + 30);
+    escaped.append(view.first(i));
+    appendHtmlEscaped(&escaped, view.sliced(i));
+    return escaped;
+}
+
+/*!
+    \internal
+    Returns a string equal to \a string that shares its data with all
+    other strings interned this way.
+
+    Nodes store many strings that repeat across thousands of nodes,
+    such as module names, versions and file paths. Strings read from
+    index files or built by concatenation each have their own copy of
+    the data. Interning them keeps a single copy per distinct value.
+    The pool lives until qdoc exits.
+ */
+QString intern(const QString &string)
+{
+    if (string.isEmpty())
+        return string;
+
+    static QMutex mutex;
+    static QSet<QString> pool;
+    QMutexLocker locker(&mutex);
+    auto it = pool.constFind(string);
+    if (it == pool.constEnd())
+        it = pool.insert(string);
+    return *it;
+}
+
 /*!
     \internal
 */
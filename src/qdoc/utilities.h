@@ -44,6 +44,9 @@ bool debugging();
 
 QString separator(qsizetype wordPosition, qsizetype numberOfWords);
 QString comma(qsizetype wordPosition, qsizetype numberOfWords);
+QString intern(const QString &string);
+void appendHtmlEscaped(QString *output, QStringView string);
+QString htmlEscaped(const QString &string);
 QStringList getInternalIncludePaths(const QString &compiler);
 }
 
@@ -29,11 +29,76 @@
 #include <QWidget>
 #include <QApplication>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QMetaEnum>
+#include <QTextStream>
 #include <qevent.h>
 
+#include <memory>
+#include <vector>
+
 QT_USE_NAMESPACE
 
 QIODevice *qout;
+bool tracing = false;
+
+// Records the events of all objects into a preallocated ring buffer and
+// prints them when the application quits. Unlike the default output, no
+// formatting or I/O happens while events arrive, which keeps the timing
+// intact when analyzing input latency.
+class EventTracer : public QObject
+{
+public:
+    explicit EventTracer(qsizetype capacity) : m_records(capacity) { m_timer.start(); }
+
+    bool eventFilter(QObject *o, QEvent *e) override
+    {
+        Record &record = m_records[m_count % m_records.size()];
+        record.elapsed = m_timer.nsecsElapsed();
+        record.timestamp = e->isInputEvent() ? static_cast<QInputEvent *>(e)->timestamp() : 0;
+        record.target = o->metaObject();
+        record.type = e->type();
+        ++m_count;
+        return false;
+    }
+
+    void dump(QIODevice *out) const;
+
+private:
+    struct Record
+    {
+        qint64 elapsed; // ns since tracing started
+        quint64 timestamp; // of input events, in ms
+        const QMetaObject *target;
+        QEvent::Type type;
+    };
+
+    QElapsedTimer m_timer;
+    std::vector<Record> m_records;
+    quint64 m_count = 0;
+};
+
+void EventTracer::dump(QIODevice *out) const
+{
+    QTextStream str(out);
+    const QMetaEnum types = QMetaEnum::fromType<QEvent::Type>();
+    const quint64 size = m_records.size();
+    const quint64 first = m_count > size ? m_count - size : 0;
+    str << "# " << m_count << " events, " << first << " overwritten\n"
+        << "# elapsed(us) event target input-timestamp(ms)\n";
+    for (quint64 i = first; i < m_count; ++i) {
+        const Record &record = m_records[i % size];
+        str << (record.elapsed / 1000) << ' ';
+        if (const char *name = types.valueToKey(record.type))
+            str << name;
+        else
+            str << int(record.type);
+        str << ' ' << record.target->className();
+        if (record.timestamp)
+            str << ' ' << record.timestamp;
+        str << '\n';
+    }
+}
 
 class Widget : public QWidget
 {
@@ -43,7 +108,8 @@ public:
     bool event(QEvent *e) {
         if (e->type() == QEvent::ContextMenu)
             return false;
-        QDebug(qout) << e << Qt::endl;
+        if (!tracing)
+            QDebug(qout) << e << Qt::endl;
         return QWidget::event(e);
     }
 };
@@ -57,6 +123,24 @@ int main(int argc, char **argv)
     fout.open(stdout, QIODevice::WriteOnly);
     qout = &fout;
 
+    // -trace [count]: record the last count events instead of printing them
+    std::unique_ptr<EventTracer> tracer;
+    const QStringList arguments = QCoreApplication::arguments();
+    const qsizetype traceIndex = arguments.indexOf(QLatin1String("-trace"));
+    if (traceIndex > 0) {
+        bool ok = false;
+        qsizetype capacity = arguments.value(traceIndex + 1).toLongLong(&ok);
+        if (!ok || capacity <= 0)
+            capacity = 1 << 16;
+        tracer.reset(new EventTracer(capacity));
+        app.installEventFilter(tracer.get());
+        tracing = true;
+        QObject::connect(&app, &QCoreApplication::aboutToQuit, [&tracer] {
+            qApp->removeEventFilter(tracer.get());
+            tracer->dump(qout);
+        });
+    }
+
     Widget w;
     w.show();
     return app.exec();
@@ -73,6 +73,10 @@ int main(int argc, char *argv[])
     QCommandLineOption outputOption({ QStringLiteral("o"), QStringLiteral("output") },
                                     tr("Write generated data to <file>."),
                                     QStringLiteral("file"));
+    QCommandLineOption cacheOption(QStringLiteral("cache"),
+                                   tr("Store the scan results in <file> and reuse them in later "
+                                      "runs for directories and files that did not change."),
+                                   QStringLiteral("file"));
     QCommandLineOption verboseOption(QStringLiteral("verbose"),
                                      tr("Verbose output."));
     QCommandLineOption silentOption({ QStringLiteral("s"), QStringLiteral("silent") },
@@ -83,6 +87,7 @@ int main(int argc, char *argv[])
     parser.addOption(filterOption);
     parser.addOption(baseDirOption);
     parser.addOption(outputOption);
+    parser.addOption(cacheOption);
     parser.addOption(verboseOption);
     parser.addOption(silentOption);
 
@@ -124,7 +129,7 @@ int main(int argc, char *argv[])
         if (logLevel == VerboseLog)
             std::cerr << qPrintable(tr("Recursively scanning %1 for attribution files...").arg(
                                         QDir::toNativeSeparators(path))) << std::endl;
-        packages = Scanner::scanDirectory(path, formats, logLevel);
+        packages = Scanner::scanDirectory(path, formats, logLevel, parser.value(cacheOption));
     } else if (pathInfo.isFile()) {
         packages = Scanner::readFile(path, logLevel);
     } else {
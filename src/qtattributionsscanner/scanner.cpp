@@ -29,22 +29,60 @@
 #include "scanner.h"
 #include "logging.h"
 
+#include <QtCore/qdatastream.h>
 #include <QtCore/qdir.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qjsonarray.h>
 #include <QtCore/qjsondocument.h>
 #include <QtCore/qjsonobject.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qsemaphore.h>
 #include <QtCore/qtextstream.h>
+#include <QtCore/qthreadpool.h>
 #include <QtCore/qvariant.h>
+#include <QtCore/qwaitcondition.h>
 
+#include <cstring>
+#include <deque>
 #include <iostream>
 #include <optional>
+#include <vector>
+
+static QDataStream &operator<<(QDataStream &stream, const Package &p)
+{
+    return stream << p.id << p.path << p.files << p.name << p.qdocModule << p.qtUsage
+                  << p.qtParts << p.description << p.homepage << p.version
+                  << p.downloadLocation << p.license << p.licenseId << p.licenseFiles
+                  << p.copyright << p.copyrightFile << p.packageComment;
+}
+
+static QDataStream &operator>>(QDataStream &stream, Package &p)
+{
+    return stream >> p.id >> p.path >> p.files >> p.name >> p.qdocModule >> p.qtUsage
+                  >> p.qtParts >> p.description >> p.homepage >> p.version
+                  >> p.downloadLocation >> p.license >> p.licenseId >> p.licenseFiles
+                  >> p.copyright >> p.copyrightFile >> p.packageComment;
+}
 
 namespace Scanner {
 
+// Set while files are read on worker threads, so that their messages can be
+// printed in scan order afterwards
+static thread_local QStringList *messageBuffer = nullptr;
+
+static void printMessage(const QString &message)
+{
+    if (messageBuffer)
+        messageBuffer->append(message);
+    else
+        std::cerr << qPrintable(message) << std::endl;
+}
+
 static void missingPropertyWarning(const QString &filePath, const QString &property)
 {
-    std::cerr << qPrintable(tr("File %1: Missing mandatory property '%2'.").arg(
-                                QDir::toNativeSeparators(filePath), property)) << std::endl;
+    printMessage(tr("File %1: Missing mandatory property '%2'.").arg(
+                     QDir::toNativeSeparators(filePath), property));
 }
 
 static void validatePackage(Package &p, const QString &filePath, LogLevel logLevel)
@@ -66,10 +104,9 @@ static void validatePackage(Package &p, const QString &filePath, LogLevel logLev
             missingPropertyWarning(filePath, QStringLiteral("License"));
 
         if (!p.copyright.isEmpty() && !p.copyrightFile.isEmpty()) {
-            std::cerr << qPrintable(tr("File %1: Properties 'Copyright' and 'CopyrightFile' are "
-                                       "mutually exclusive.")
-                                            .arg(QDir::toNativeSeparators(filePath)))
-                      << std::endl;
+            printMessage(tr("File %1: Properties 'Copyright' and 'CopyrightFile' are "
+                            "mutually exclusive.")
+                                 .arg(QDir::toNativeSeparators(filePath)));
         }
 
         for (const QString &part : qAsConst(p.qtParts)) {
@@ -78,11 +115,10 @@ static void validatePackage(Package &p, const QString &filePath, LogLevel logLev
                     && part != QLatin1String("tools")
                     && part != QLatin1String("libs")
                     && logLevel != SilentLog) {
-                std::cerr << qPrintable(tr("File %1: Property 'QtPart' contains unknown element "
-                                           "'%2'. Valid entries are 'examples', 'tests', 'tools' "
-                                           "and 'libs'.").arg(
-                                            QDir::toNativeSeparators(filePath), part))
-                          << std::endl;
+                printMessage(tr("File %1: Property 'QtPart' contains unknown element "
+                                "'%2'. Valid entries are 'examples', 'tests', 'tools' "
+                                "and 'libs'.").arg(
+                                     QDir::toNativeSeparators(filePath), part));
             }
         }
     }
@@ -114,8 +150,8 @@ static Package readPackage(const QJsonObject &object, const QString &filePath, L
         if (!iter.value().isString() && key != QLatin1String("QtParts")
             && key != QLatin1String("LicenseFiles")) {
             if (logLevel != SilentLog)
-                std::cerr << qPrintable(tr("File %1: Expected JSON string as value of %2.").arg(
-                                            QDir::toNativeSeparators(filePath), key)) << std::endl;
+                printMessage(tr("File %1: Expected JSON string as value of %2.").arg(
+                                 QDir::toNativeSeparators(filePath), key));
             continue;
         }
         const QString value = iter.value().toString();
@@ -142,9 +178,8 @@ static Package readPackage(const QJsonObject &object, const QString &filePath, L
         } else if (key == QLatin1String("LicenseFiles")) {
             auto strings = toStringList(iter.value());
             if (!strings && (logLevel != SilentLog))
-                std::cerr << qPrintable(tr("File %1: Expected JSON array of strings in %2.")
-                                                .arg(QDir::toNativeSeparators(filePath), key))
-                          << std::endl;
+                printMessage(tr("File %1: Expected JSON array of strings in %2.")
+                                     .arg(QDir::toNativeSeparators(filePath), key));
             const QDir dir(directory);
             for (auto iter : strings.value())
                 p.licenseFiles.push_back(dir.absoluteFilePath(iter));
@@ -163,14 +198,13 @@ static Package readPackage(const QJsonObject &object, const QString &filePath, L
         } else if (key == QLatin1String("QtParts")) {
             auto parts = toStringList(iter.value());
             if (!parts && (logLevel != SilentLog))
-                std::cerr << qPrintable(tr("File %1: Expected JSON array of strings in %2.")
-                                                .arg(QDir::toNativeSeparators(filePath), key))
-                          << std::endl;
+                printMessage(tr("File %1: Expected JSON array of strings in %2.")
+                                     .arg(QDir::toNativeSeparators(filePath), key));
             p.qtParts = parts.value();
         } else {
             if (logLevel != SilentLog)
-                std::cerr << qPrintable(tr("File %1: Unknown key %2.").arg(
-                                            QDir::toNativeSeparators(filePath), key)) << std::endl;
+                printMessage(tr("File %1: Unknown key %2.").arg(
+                                 QDir::toNativeSeparators(filePath), key));
         }
     }
 
@@ -259,14 +293,14 @@ QList<Package> readFile(const QString &filePath, LogLevel logLevel)
     QList<Package> packages;
 
     if (logLevel == VerboseLog) {
-        std::cerr << qPrintable(tr("Reading file %1...").arg(
-                                    QDir::toNativeSeparators(filePath))) << std::endl;
+        printMessage(tr("Reading file %1...").arg(
+                         QDir::toNativeSeparators(filePath)));
     }
     QFile file(filePath);
     if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
         if (logLevel != SilentLog)
-            std::cerr << qPrintable(tr("Could not open file %1.").arg(
-                                        QDir::toNativeSeparators(file.fileName()))) << std::endl;
+            printMessage(tr("Could not open file %1.").arg(
+                             QDir::toNativeSeparators(file.fileName())));
         return QList<Package>();
     }
 
@@ -275,10 +309,9 @@ QList<Package> readFile(const QString &filePath, LogLevel logLevel)
         const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &jsonParseError);
         if (document.isNull()) {
             if (logLevel != SilentLog)
-                std::cerr << qPrintable(tr("Could not parse file %1: %2").arg(
-                                            QDir::toNativeSeparators(file.fileName()),
-                                            jsonParseError.errorString()))
-                          << std::endl;
+                printMessage(tr("Could not parse file %1: %2").arg(
+                                 QDir::toNativeSeparators(file.fileName()),
+                                 jsonParseError.errorString()));
             return QList<Package>();
         }
 
@@ -292,15 +325,14 @@ QList<Package> readFile(const QString &filePath, LogLevel logLevel)
                     packages << readPackage(value.toObject(), file.fileName(), logLevel);
                 } else {
                     if (logLevel != SilentLog)
-                        std::cerr << qPrintable(tr("File %1: Expecting JSON object in array.")
-                                        .arg(QDir::toNativeSeparators(file.fileName())))
-                                  << std::endl;
+                        printMessage(tr("File %1: Expecting JSON object in array.")
+                                             .arg(QDir::toNativeSeparators(file.fileName())));
                 }
             }
         } else {
             if (logLevel != SilentLog)
-                std::cerr << qPrintable(tr("File %1: Expecting JSON object in array.").arg(
-                                            QDir::toNativeSeparators(file.fileName()))) << std::endl;
+                printMessage(tr("File %1: Expecting JSON object in array.").arg(
+                                 QDir::toNativeSeparators(file.fileName())));
         }
     } else if (filePath.endsWith(QLatin1String(".chromium"))) {
         Package chromiumPackage = parseChromiumFile(file, filePath, logLevel);
@@ -308,19 +340,15 @@ QList<Package> readFile(const QString &filePath, LogLevel logLevel)
             packages << chromiumPackage;
     } else {
         if (logLevel != SilentLog)
-            std::cerr << qPrintable(tr("File %1: Unsupported file type.")
-                            .arg(QDir::toNativeSeparators(file.fileName())))
-                      << std::endl;
+            printMessage(tr("File %1: Unsupported file type.")
+                                 .arg(QDir::toNativeSeparators(file.fileName())));
     }
 
     return packages;
 }
 
-QList<Package> scanDirectory(const QString &directory, InputFormats inputFormats, LogLevel logLevel)
+static QStringList nameFiltersFor(InputFormats inputFormats)
 {
-    QDir dir(directory);
-    QList<Package> packages;
-
     QStringList nameFilters = QStringList();
     if (inputFormats & InputFormat::QtAttributions)
         nameFilters << QStringLiteral("qt_attribution.json");
@@ -331,17 +359,284 @@ QList<Package> scanDirectory(const QString &directory, InputFormats inputFormats
                 << QStringLiteral("qt_attribution_test.json")
                 << QStringLiteral("README_test.chromium");
     }
+    return nameFilters;
+}
+
+namespace {
+
+// A scanned directory. Entries refer to either subdirectories or attribution
+// files, in the order QDir lists them.
+struct DirectoryNode
+{
+    struct Entry
+    {
+        bool isDirectory;
+        size_t index;
+    };
+
+    QString path;
+    qint64 lastModified = 0;
+    std::vector<Entry> entries;
+};
+
+struct DirectoryTree
+{
+    std::deque<DirectoryNode> directories;
+    std::vector<QString> files;
+};
+
+// Results of an earlier run. A directory listing is reused while the
+// directory's modification time is unchanged, which is the case as long as
+// no entries are added, removed or renamed in it. A file's packages and
+// messages are reused while its modification time and size are unchanged.
+struct ScanCache
+{
+    struct Directory
+    {
+        qint64 lastModified = 0;
+        QList<QPair<QString, bool>> entries; // name, is directory
+    };
+
+    struct File
+    {
+        qint64 lastModified = 0;
+        qint64 size = 0;
+        QList<Package> packages;
+        QStringList messages;
+    };
+
+    QHash<QString, Directory> directories;
+    QHash<QString, File> files;
+};
+
+QDataStream &operator<<(QDataStream &stream, const ScanCache::Directory &d)
+{
+    return stream << d.lastModified << d.entries;
+}
+
+QDataStream &operator>>(QDataStream &stream, ScanCache::Directory &d)
+{
+    return stream >> d.lastModified >> d.entries;
+}
+
+QDataStream &operator<<(QDataStream &stream, const ScanCache::File &f)
+{
+    return stream << f.lastModified << f.size << f.packages << f.messages;
+}
+
+QDataStream &operator>>(QDataStream &stream, ScanCache::File &f)
+{
+    return stream >> f.lastModified >> f.size >> f.packages >> f.messages;
+}
+
+} // unnamed namespace
+
+// Bump this whenever the format of the cache file changes
+static const quint32 cacheFormatVersion = 1;
+static const char cacheMagic[] = { 'Q', 'T', 'A', 'S' };
+
+// The listings depend on the name filters and the stored messages on the log
+// level, so a cache written with different settings is not used.
+static QByteArray cacheSettingsKey(const QStringList &nameFilters, LogLevel logLevel)
+{
+    return nameFilters.join(QLatin1Char(';')).toUtf8() + '|' + QByteArray::number(logLevel);
+}
+
+static ScanCache loadCache(const QString &cacheFile, const QByteArray &settingsKey)
+{
+    ScanCache cache;
+    QFile file(cacheFile);
+    if (!file.open(QIODevice::ReadOnly))
+        return cache;
+
+    char magic[sizeof(cacheMagic)];
+    if (file.read(magic, sizeof(magic)) != sizeof(magic) || memcmp(magic, cacheMagic, sizeof(magic)))
+        return cache;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    quint32 formatVersion;
+    quint32 qtVersion;
+    QByteArray key;
+    stream >> formatVersion >> qtVersion >> key;
+    if (formatVersion != cacheFormatVersion || qtVersion != QT_VERSION || key != settingsKey)
+        return cache;
+
+    stream >> cache.directories >> cache.files;
+    if (stream.status() != QDataStream::Ok)
+        return ScanCache();
+    return cache;
+}
+
+static void saveCache(const QString &cacheFile, const QByteArray &settingsKey, const ScanCache &cache)
+{
+    // The cache is only an optimization, so failures are silently ignored.
+    // QSaveFile ensures that concurrent processes never see partial files.
+    QSaveFile file(cacheFile);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+    file.write(cacheMagic, sizeof(cacheMagic));
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << cacheFormatVersion << quint32(QT_VERSION) << settingsKey
+           << cache.directories << cache.files;
+    file.commit();
+}
 
-    dir.setNameFilters(nameFilters);
-    dir.setFilter(QDir::AllDirs | QDir::NoDotAndDotDot | QDir::Files);
+static qint64 lastModified(const QFileInfo &info)
+{
+    return info.lastModified().toMSecsSinceEpoch();
+}
+
+// Lists the directories with a shared work queue, so that large trees are
+// walked by several threads
+static void walkDirectories(DirectoryTree &tree, const QStringList &nameFilters,
+                            const ScanCache &cache, int threadCount)
+{
+    QMutex mutex;
+    QWaitCondition changed;
+    std::deque<size_t> pending = { 0 };
+    int busy = 0;
+
+    auto walk = [&]() {
+        QMutexLocker locker(&mutex);
+        for (;;) {
+            while (pending.empty() && busy > 0)
+                changed.wait(&mutex);
+            if (pending.empty())
+                break;
+
+            const size_t index = pending.front();
+            pending.pop_front();
+            ++busy;
+            const QString path = tree.directories[index].path;
+            locker.unlock();
+
+            const qint64 modified = lastModified(QFileInfo(path));
+            QList<QPair<QString, bool>> entries;
+            const auto cached = cache.directories.constFind(path);
+            if (cached != cache.directories.constEnd() && cached->lastModified == modified) {
+                entries = cached->entries;
+            } else {
+                QDir dir(path);
+                dir.setNameFilters(nameFilters);
+                dir.setFilter(QDir::AllDirs | QDir::NoDotAndDotDot | QDir::Files);
+                const QFileInfoList infos = dir.entryInfoList();
+                entries.reserve(infos.size());
+                for (const QFileInfo &info : infos)
+                    entries.append({ info.fileName(), info.isDir() });
+            }
+
+            locker.relock();
+            tree.directories[index].lastModified = modified;
+            for (const QPair<QString, bool> &entry : qAsConst(entries)) {
+                const QString entryPath = path.endsWith(QLatin1Char('/'))
+                        ? path + entry.first : path + QLatin1Char('/') + entry.first;
+                if (entry.second) {
+                    tree.directories.push_back({ entryPath, 0, {} });
+                    tree.directories[index].entries.push_back({ true, tree.directories.size() - 1 });
+                    pending.push_back(tree.directories.size() - 1);
+                } else {
+                    tree.files.push_back(entryPath);
+                    tree.directories[index].entries.push_back({ false, tree.files.size() - 1 });
+                }
+            }
+            --busy;
+            changed.wakeAll();
+        }
+    };
+
+    // Helpers that start late find nothing pending and return immediately
+    QSemaphore done;
+    for (int w = 0; w < threadCount - 1; ++w) {
+        QThreadPool::globalInstance()->start([&walk, &done] {
+            walk();
+            done.release();
+        });
+    }
+    walk();
+    done.acquire(threadCount - 1);
+}
 
-    const QFileInfoList entries = dir.entryInfoList();
-    for (const QFileInfo &info : entries) {
-        if (info.isDir()) {
-            packages += scanDirectory(info.filePath(), inputFormats, logLevel);
+static void collectPackages(const DirectoryTree &tree, size_t index,
+                            const std::vector<ScanCache::File> &files,
+                            QList<Package> &packages)
+{
+    for (const DirectoryNode::Entry &entry : tree.directories[index].entries) {
+        if (entry.isDirectory) {
+            collectPackages(tree, entry.index, files, packages);
         } else {
-            packages += readFile(info.filePath(), logLevel);
+            for (const QString &message : files[entry.index].messages)
+                printMessage(message);
+            packages += files[entry.index].packages;
+        }
+    }
+}
+
+QList<Package> scanDirectory(const QString &directory, InputFormats inputFormats, LogLevel logLevel,
+                             const QString &cacheFile)
+{
+    const int threadCount = qMax(1, QThreadPool::globalInstance()->maxThreadCount());
+    const QStringList nameFilters = nameFiltersFor(inputFormats);
+    const QByteArray settingsKey = cacheSettingsKey(nameFilters, logLevel);
+    const ScanCache cache = cacheFile.isEmpty() ? ScanCache() : loadCache(cacheFile, settingsKey);
+
+    DirectoryTree tree;
+    tree.directories.push_back({ QDir(directory).path(), 0, {} });
+    walkDirectories(tree, nameFilters, cache, threadCount);
+
+    // Parse the changed attribution files concurrently
+    std::vector<ScanCache::File> files(tree.files.size());
+    auto read = [&](size_t i) {
+        const QString &filePath = tree.files[i];
+        const QFileInfo info(filePath);
+        ScanCache::File &file = files[i];
+        file.lastModified = lastModified(info);
+        file.size = info.size();
+
+        const auto cached = cache.files.constFind(filePath);
+        if (cached != cache.files.constEnd() && cached->lastModified == file.lastModified
+                && cached->size == file.size) {
+            file = cached.value();
+            return;
+        }
+
+        messageBuffer = &file.messages;
+        file.packages = readFile(filePath, logLevel);
+        messageBuffer = nullptr;
+    };
+    QSemaphore done;
+    for (size_t i = 0; i < tree.files.size(); ++i) {
+        QThreadPool::globalInstance()->start([&read, &done, i] {
+            read(i);
+            done.release();
+        });
+    }
+    done.acquire(int(tree.files.size()));
+
+    // Assemble the result in the order of a sequential depth-first scan, so
+    // that the output does not depend on the scheduling
+    QList<Package> packages;
+    collectPackages(tree, 0, files, packages);
+
+    if (!cacheFile.isEmpty()) {
+        // Only store what was seen in this run, so that removed directories
+        // and files do not accumulate
+        ScanCache newCache;
+        newCache.directories.reserve(tree.directories.size());
+        for (const DirectoryNode &node : tree.directories) {
+            ScanCache::Directory &entry = newCache.directories[node.path];
+            entry.lastModified = node.lastModified;
+            for (const DirectoryNode::Entry &child : node.entries) {
+                const QString &childPath = child.isDirectory ? tree.directories[child.index].path
+                                                             : tree.files[child.index];
+                entry.entries.append({ QFileInfo(childPath).fileName(), child.isDirectory });
+            }
         }
+        newCache.files.reserve(tree.files.size());
+        for (size_t i = 0; i < tree.files.size(); ++i)
+            newCache.files.insert(tree.files[i], files[i]);
+        saveCache(cacheFile, settingsKey, newCache);
     }
 
     return packages;
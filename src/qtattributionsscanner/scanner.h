@@ -45,7 +45,10 @@ Q_DECLARE_FLAGS(InputFormats, InputFormat)
 Q_DECLARE_OPERATORS_FOR_FLAGS(InputFormats)
 
 QList<Package> readFile(const QString &filePath, LogLevel logLevel);
-QList<Package> scanDirectory(const QString &directory, InputFormats inputFormats, LogLevel logLevel);
+// If cacheFile is given, the results of the previous scan are read from it
+// for unchanged directories and files, and the new results are written to it.
+QList<Package> scanDirectory(const QString &directory, InputFormats inputFormats, LogLevel logLevel,
+                             const QString &cacheFile = QString());
 
 }
 
@@ -51,12 +51,23 @@ int main(int argc, char **argv)
     const QCommandLineOption fontOption(QStringLiteral("fonts"), QStringLiteral("Output list of fonts"));
     const QCommandLineOption noVkOption(QStringLiteral("no-vulkan"), QStringLiteral("Do not output Vulkan information"));
     const QCommandLineOption noRhiOption(QStringLiteral("no-rhi"), QStringLiteral("Do not output RHI information"));
+    const QCommandLineOption jsonOption(QStringLiteral("json"), QStringLiteral("Output a single line of JSON"));
+    const QCommandLineOption probeTimeoutOption(QStringLiteral("probe-timeout"),
+                                                QStringLiteral("Run the GL, Vulkan and RHI probes in parallel processes and "
+                                                               "stop them after <seconds> (default: 30, 0: run them in-process)"),
+                                                QStringLiteral("seconds"), QStringLiteral("30"));
+    QCommandLineOption probeOption(QStringLiteral("probe"), QStringLiteral("Run a single probe"),
+                                   QStringLiteral("name"));
+    probeOption.setFlags(QCommandLineOption::HiddenFromHelp);
     commandLineParser.setApplicationDescription(QStringLiteral("Prints diagnostic output about the Qt library."));
     commandLineParser.addOption(noGlOption);
     commandLineParser.addOption(glExtensionOption);
     commandLineParser.addOption(fontOption);
     commandLineParser.addOption(noVkOption);
     commandLineParser.addOption(noRhiOption);
+    commandLineParser.addOption(jsonOption);
+    commandLineParser.addOption(probeTimeoutOption);
+    commandLineParser.addOption(probeOption);
     commandLineParser.addHelpOption();
     commandLineParser.process(app);
     unsigned flags = commandLineParser.isSet(noGlOption) ? 0u : unsigned(QtDiagGl);
@@ -68,8 +79,29 @@ int main(int argc, char **argv)
         flags |= QtDiagVk;
     if (!commandLineParser.isSet(noRhiOption))
         flags |= QtDiagRhi;
+    if (commandLineParser.isSet(jsonOption))
+        flags |= QtDiagJson;
 
-    std::wcout << qtDiag(flags).toStdWString();
+    if (commandLineParser.isSet(probeOption)) {
+        QString output;
+        if (!qtDiagProbe(commandLineParser.value(probeOption), flags, &output)) {
+            std::cerr << "Unknown probe: " << qPrintable(commandLineParser.value(probeOption)) << '\n';
+            return 1;
+        }
+        const QByteArray utf8 = output.toUtf8();
+        std::cout.write(utf8.constData(), utf8.size());
+        std::cout.flush();
+        return 0;
+    }
+
+    bool ok;
+    const int probeTimeout = commandLineParser.value(probeTimeoutOption).toInt(&ok);
+    if (!ok || probeTimeout < 0) {
+        std::cerr << "Invalid probe timeout: " << qPrintable(commandLineParser.value(probeTimeoutOption)) << '\n';
+        return 1;
+    }
+
+    std::wcout << qtDiag(flags, probeTimeout * 1000).toStdWString();
     std::wcout.flush();
     return 0;
 }
@@ -66,6 +66,15 @@
 #include <QtCore/QFileSelector>
 #include <QtCore/QDebug>
 #include <QtCore/QVersionNumber>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QEventLoop>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTimer>
+#if QT_CONFIG(process)
+#  include <QtCore/QProcess>
+#endif
 
 #include <private/qsimd_p.h>
 #include <private/qguiapplication_p.h>
@@ -96,6 +105,8 @@
 #endif
 
 #include <algorithm>
+#include <memory>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -407,43 +418,212 @@ void dumpRhiBackendInfo(QTextStream &str, const char *name, QRhi::Implementation
     }
 }
 
-void dumpRhiInfo(QTextStream &str)
-{
-    str << "Qt Rendering Hardware Interface supported backends:\n";
-
 #if QT_CONFIG(opengl)
-    {
-        QRhiGles2InitParams params;
-        params.fallbackSurface = QRhiGles2InitParams::newFallbackSurface();
-        dumpRhiBackendInfo(str, "OpenGL (with default QSurfaceFormat)", QRhi::OpenGLES2, &params);
-        delete params.fallbackSurface;
-    }
+void dumpRhiGlInfo(QTextStream &str)
+{
+    QRhiGles2InitParams params;
+    params.fallbackSurface = QRhiGles2InitParams::newFallbackSurface();
+    dumpRhiBackendInfo(str, "OpenGL (with default QSurfaceFormat)", QRhi::OpenGLES2, &params);
+    delete params.fallbackSurface;
+}
 #endif
 
 #if QT_CONFIG(vulkan)
-    {
-        QVulkanInstance vulkanInstance;
-        vulkanInstance.create();
-        QRhiVulkanInitParams params;
-        params.inst = &vulkanInstance;
-        dumpRhiBackendInfo(str, "Vulkan", QRhi::Vulkan, &params);
-        vulkanInstance.destroy();
-    }
+void dumpRhiVkInfo(QTextStream &str)
+{
+    QVulkanInstance vulkanInstance;
+    vulkanInstance.create();
+    QRhiVulkanInitParams params;
+    params.inst = &vulkanInstance;
+    dumpRhiBackendInfo(str, "Vulkan", QRhi::Vulkan, &params);
+    vulkanInstance.destroy();
+}
 #endif
 
 #ifdef Q_OS_WIN
-    {
-        QRhiD3D11InitParams params;
-        dumpRhiBackendInfo(str, "Direct3D 11", QRhi::D3D11, &params);
-    }
+void dumpRhiD3D11Info(QTextStream &str)
+{
+    QRhiD3D11InitParams params;
+    dumpRhiBackendInfo(str, "Direct3D 11", QRhi::D3D11, &params);
+}
+#endif
+
+#if defined(Q_OS_MACOS) || defined(Q_OS_IOS)
+void dumpRhiMetalInfo(QTextStream &str)
+{
+    QRhiMetalInitParams params;
+    dumpRhiBackendInfo(str, "Metal", QRhi::Metal, &params);
+}
 #endif
 
+// The probes creating graphics contexts, instances or devices. Each of them
+// can be run on its own, by default in a child process ("qtdiag --probe
+// <name>"), so that they run concurrently and a hanging driver can be killed.
+struct DiagProbe
+{
+    const char *name;
+    const char *title;
+    void (*dump)(QTextStream &str, unsigned flags);
+};
+
+static QList<DiagProbe> diagProbes(unsigned flags)
+{
+    QList<DiagProbe> probes;
+#ifndef QT_NO_OPENGL
+    if (flags & QtDiagGl) {
+        probes.append({ "gl", "OpenGL", [](QTextStream &str, unsigned probeFlags) {
+            dumpGlInfo(str, probeFlags & QtDiagGlExtensions);
+        } });
+    }
+#endif // !QT_NO_OPENGL
+#if QT_CONFIG(vulkan)
+    if (flags & QtDiagVk)
+        probes.append({ "vulkan", "Vulkan", [](QTextStream &str, unsigned) { dumpVkInfo(str); } });
+#endif // vulkan
+    if (flags & QtDiagRhi) {
+#if QT_CONFIG(opengl)
+        probes.append({ "rhi-opengl", "RHI OpenGL", [](QTextStream &str, unsigned) { dumpRhiGlInfo(str); } });
+#endif
+#if QT_CONFIG(vulkan)
+        probes.append({ "rhi-vulkan", "RHI Vulkan", [](QTextStream &str, unsigned) { dumpRhiVkInfo(str); } });
+#endif
+#ifdef Q_OS_WIN
+        probes.append({ "rhi-d3d11", "RHI Direct3D 11", [](QTextStream &str, unsigned) { dumpRhiD3D11Info(str); } });
+#endif
 #if defined(Q_OS_MACOS) || defined(Q_OS_IOS)
-    {
-        QRhiMetalInitParams params;
-        dumpRhiBackendInfo(str, "Metal", QRhi::Metal, &params);
+        probes.append({ "rhi-metal", "RHI Metal", [](QTextStream &str, unsigned) { dumpRhiMetalInfo(str); } });
+#endif
+    }
+    return probes;
+}
+
+static QString runDiagProbe(const DiagProbe &probe, unsigned flags)
+{
+    QString result;
+    QTextStream str(&result);
+    probe.dump(str, flags);
+    str.flush();
+    return result;
+}
+
+struct DiagProbeResult
+{
+    enum Status { Ok, Failed, TimedOut };
+
+    Status status = Failed;
+    qint64 elapsed = 0;
+    QString output;
+};
+
+static const char *probeStatusName(DiagProbeResult::Status status)
+{
+    switch (status) {
+    case DiagProbeResult::Ok:
+        return "ok";
+    case DiagProbeResult::Failed:
+        return "failed";
+    case DiagProbeResult::TimedOut:
+        return "timeout";
+    }
+    return "failed";
+}
+
+#if QT_CONFIG(process)
+// Starts all probes as child processes at once and collects their output.
+// Probes still running when \a timeout milliseconds have passed are killed.
+static QList<DiagProbeResult> runDiagProbeProcesses(const QList<DiagProbe> &probes,
+                                                    unsigned flags, int timeout)
+{
+    QList<DiagProbeResult> results(probes.size());
+    std::vector<std::unique_ptr<QProcess>> processes;
+    QList<QElapsedTimer> timers(probes.size());
+    qsizetype running = probes.size();
+    QEventLoop loop;
+
+    for (qsizetype i = 0; i < probes.size(); ++i) {
+        auto process = std::make_unique<QProcess>();
+        process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+        QObject::connect(process.get(), &QProcess::finished, &loop,
+                         [&, i](int exitCode, QProcess::ExitStatus exitStatus) {
+            DiagProbeResult &result = results[i];
+            result.elapsed = timers.at(i).elapsed();
+            result.output = QString::fromUtf8(processes.at(i)->readAllStandardOutput());
+            result.status = exitStatus == QProcess::NormalExit && exitCode == 0
+                ? DiagProbeResult::Ok : DiagProbeResult::Failed;
+            if (--running == 0)
+                loop.quit();
+        });
+        QObject::connect(process.get(), &QProcess::errorOccurred, &loop,
+                         [&, i](QProcess::ProcessError error) {
+            if (error != QProcess::FailedToStart)
+                return;
+            results[i].output = processes.at(i)->errorString() + u'\n';
+            if (--running == 0)
+                loop.quit();
+        });
+        processes.push_back(std::move(process));
+    }
+
+    for (qsizetype i = 0; i < probes.size(); ++i) {
+        QStringList arguments{ QStringLiteral("--probe"), QString::fromLatin1(probes.at(i).name) };
+        if (flags & QtDiagGlExtensions)
+            arguments.append(QStringLiteral("--gl-extensions"));
+        timers[i].start();
+        processes.at(i)->start(QCoreApplication::applicationFilePath(), arguments);
     }
+
+    if (running > 0) {
+        QTimer::singleShot(timeout, &loop, &QEventLoop::quit);
+        loop.exec();
+    }
+
+    for (qsizetype i = 0; i < probes.size(); ++i) {
+        QProcess *process = processes.at(i).get();
+        if (process->state() == QProcess::NotRunning)
+            continue;
+        QObject::disconnect(process, nullptr, &loop, nullptr);
+        process->kill();
+        process->waitForFinished();
+        results[i].status = DiagProbeResult::TimedOut;
+        results[i].elapsed = timers.at(i).elapsed();
+        results[i].output = QString::fromUtf8(process->readAllStandardOutput());
+    }
+    return results;
+}
+#endif // QT_CONFIG(process)
+
+static QList<DiagProbeResult> runDiagProbes(const QList<DiagProbe> &probes, unsigned flags,
+                                            int timeout)
+{
+#if QT_CONFIG(process)
+    if (timeout > 0 && !probes.isEmpty())
+        return runDiagProbeProcesses(probes, flags, timeout);
+#else
+    Q_UNUSED(timeout);
 #endif
+    QList<DiagProbeResult> results;
+    for (const DiagProbe &probe : probes) {
+        QElapsedTimer timer;
+        timer.start();
+        DiagProbeResult result;
+        result.output = runDiagProbe(probe, flags);
+        result.elapsed = timer.elapsed();
+        result.status = DiagProbeResult::Ok;
+        results.append(result);
+    }
+    return results;
+}
+
+bool qtDiagProbe(const QString &name, unsigned flags, QString *output)
+{
+    const QList<DiagProbe> probes = diagProbes(QtDiagGl | QtDiagVk | QtDiagRhi);
+    for (const DiagProbe &probe : probes) {
+        if (name == QLatin1String(probe.name)) {
+            *output = runDiagProbe(probe, flags);
+            return true;
+        }
+    }
+    return false;
 }
 
 #define DUMP_CAPABILITY(str, integration, capability) \
@@ -576,7 +756,7 @@ static inline QByteArrayList qtFeatures()
     return result;
 }
 
-QString qtDiag(unsigned flags)
+QString qtDiag(unsigned flags, int probeTimeout)
 {
     QString result;
     QTextStream str(&result);
@@ -864,22 +1044,6 @@ QString qtDiag(unsigned flags)
         str << "\n\n";
     }
 
-#ifndef QT_NO_OPENGL
-    if (flags & QtDiagGl) {
-        dumpGlInfo(str, flags & QtDiagGlExtensions);
-        str << "\n";
-    }
-#else
-    Q_UNUSED(flags);
-#endif // !QT_NO_OPENGL
-
-#if QT_CONFIG(vulkan)
-    if (flags & QtDiagVk) {
-        dumpVkInfo(str);
-        str << "\n\n";
-    }
-#endif // vulkan
-
 #ifdef Q_OS_WIN
     // On Windows, this will provide addition GPU info similar to the output of dxdiag.
     using QWindowsApplication = QNativeInterface::Private::QWindowsApplication;
@@ -898,8 +1062,61 @@ QString qtDiag(unsigned flags)
     }
 #endif // Q_OS_WIN
 
-    if (flags & QtDiagRhi) {
-        dumpRhiInfo(str);
+    const QList<DiagProbe> probes = diagProbes(flags);
+    const QList<DiagProbeResult> probeResults = runDiagProbes(probes, flags, probeTimeout);
+
+    if (flags & QtDiagJson) {
+        str.flush();
+        QJsonArray probeArray;
+        for (qsizetype i = 0; i < probes.size(); ++i) {
+            const DiagProbeResult &probeResult = probeResults.at(i);
+            probeArray.append(QJsonObject{
+                { QStringLiteral("name"), QLatin1String(probes.at(i).name) },
+                { QStringLiteral("status"), QLatin1String(probeStatusName(probeResult.status)) },
+                { QStringLiteral("elapsedMs"), probeResult.elapsed },
+                { QStringLiteral("output"), probeResult.output }
+            });
+        }
+        const QJsonObject root{
+            { QStringLiteral("qtVersion"), QLatin1String(qVersion()) },
+            { QStringLiteral("build"), QLatin1String(QLibraryInfo::build()) },
+            { QStringLiteral("platform"), QGuiApplication::platformName() },
+            { QStringLiteral("os"), QSysInfo::prettyProductName() },
+            { QStringLiteral("kernelType"), QSysInfo::kernelType() },
+            { QStringLiteral("kernelVersion"), QSysInfo::kernelVersion() },
+            { QStringLiteral("architecture"), QSysInfo::currentCpuArchitecture() },
+            { QStringLiteral("report"), result },
+            { QStringLiteral("probes"), probeArray }
+        };
+        return QString::fromUtf8(QJsonDocument(root).toJson(QJsonDocument::Compact)) + u'\n';
+    }
+
+    bool rhiHeaderWritten = false;
+    for (qsizetype i = 0; i < probes.size(); ++i) {
+        const DiagProbe &probe = probes.at(i);
+        const DiagProbeResult &probeResult = probeResults.at(i);
+        const bool isRhiProbe = qstrncmp(probe.name, "rhi-", 4) == 0;
+        if (isRhiProbe && !rhiHeaderWritten) {
+            str << "Qt Rendering Hardware Interface supported backends:\n";
+            rhiHeaderWritten = true;
+        }
+        str << probeResult.output;
+        if (probeResult.status == DiagProbeResult::TimedOut)
+            str << probe.title << " probe timed out after " << probeResult.elapsed << " ms.\n";
+        else if (probeResult.status == DiagProbeResult::Failed)
+            str << probe.title << " probe failed.\n";
+        if (!isRhiProbe)
+            str << (qstrcmp(probe.name, "vulkan") == 0 ? "\n\n" : "\n");
+    }
+    if (rhiHeaderWritten)
+        str << "\n";
+
+    if (!probes.isEmpty()) {
+        str << "Probe timings:\n";
+        for (qsizetype i = 0; i < probes.size(); ++i) {
+            str << "  " << probes.at(i).name << ": " << probeResults.at(i).elapsed << " ms ("
+                << probeStatusName(probeResults.at(i).status) << ")\n";
+        }
         str << "\n";
     }
 
@@ -38,10 +38,12 @@ enum QtDiagFlags {
     QtDiagGlExtensions = 0x2,
     QtDiagFonts = 0x4,
     QtDiagVk = 0x8,
-    QtDiagRhi = 0x10
+    QtDiagRhi = 0x10,
+    QtDiagJson = 0x20
 };
 
-QString qtDiag(unsigned flags = 0);
+QString qtDiag(unsigned flags = 0, int probeTimeout = 0);
+bool qtDiagProbe(const QString &name, unsigned flags, QString *output);
 
 QT_END_NAMESPACE
 
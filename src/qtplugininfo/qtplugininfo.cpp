@@ -30,14 +30,19 @@
 #include <QCommandLineParser>
 #include <QCoreApplication>
 #include <QDir>
+#include <QDirIterator>
 #include <QFile>
+#include <QFileInfo>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QLibrary>
 #include <QPluginLoader>
+#include <QSemaphore>
 #include <QStringList>
+#include <QThreadPool>
 
 #include <iostream>
+#include <vector>
 
 enum PrintOption {
     PrintIID = 0x01,
@@ -48,6 +53,70 @@ enum PrintOption {
 Q_DECLARE_FLAGS(PrintOptions, PrintOption)
 Q_DECLARE_OPERATORS_FOR_FLAGS(PrintOptions)
 
+struct PluginMetaData
+{
+    QString fileName;
+    QJsonObject metaData;
+    QString errorString;
+};
+
+// Expands directories to the libraries they contain and wildcards in the
+// file name to the matching files, so that whole installations can be
+// inspected with one invocation (shells on Windows do not expand them).
+static QStringList expandPluginArguments(const QStringList &arguments)
+{
+    QStringList result;
+    for (const QString &argument : arguments) {
+        const QFileInfo fi(argument);
+        if (fi.isDir()) {
+            QStringList libraries;
+            QDirIterator it(argument, QDir::Files, QDirIterator::Subdirectories);
+            while (it.hasNext()) {
+                const QString fileName = it.next();
+                if (QLibrary::isLibrary(fileName))
+                    libraries.append(fileName);
+            }
+            libraries.sort();
+            result += libraries;
+        } else if (!fi.exists() && (fi.fileName().contains(QLatin1Char('*'))
+                                    || fi.fileName().contains(QLatin1Char('?')))) {
+            const QDir dir = fi.dir();
+            const QStringList entries = dir.entryList(QStringList(fi.fileName()), QDir::Files, QDir::Name);
+            if (entries.isEmpty())
+                result.append(argument); // reported as missing
+            for (const QString &entry : entries)
+                result.append(dir.filePath(entry));
+        } else {
+            result.append(argument);
+        }
+    }
+    return result;
+}
+
+// QPluginLoader reads the meta data from the binary's meta data section
+// without loading the library. Reading many plugins is dominated by file
+// I/O, so do it on several threads; the results keep the input order.
+static std::vector<PluginMetaData> readPluginMetaData(const QStringList &plugins)
+{
+    std::vector<PluginMetaData> result(plugins.size());
+    QSemaphore done;
+    for (qsizetype i = 0; i < plugins.size(); ++i) {
+        QThreadPool::globalInstance()->start([&plugins, &result, &done, i] {
+            PluginMetaData &data = result[i];
+            data.fileName = plugins.at(i);
+            if (QFile::exists(data.fileName) && QLibrary::isLibrary(data.fileName)) {
+                QPluginLoader loader(data.fileName);
+                data.metaData = loader.metaData();
+                if (data.metaData.isEmpty())
+                    data.errorString = loader.errorString();
+            }
+            done.release();
+        });
+    }
+    done.acquire(plugins.size());
+    return result;
+}
+
 int main(int argc, char** argv)
 {
     QCoreApplication app(argc, argv);
@@ -60,23 +129,27 @@ int main(int argc, char** argv)
                                         QStringLiteral("Print JSON data as: indented, compact"), QStringLiteral("format"));
     QCommandLineOption fullJsonOption("full-json",
                                       QStringLiteral("Print the plugin metadata in JSON format"));
+    QCommandLineOption aggregateJsonOption("aggregate-json",
+                                           QStringLiteral("Print the metadata of all plugins as one JSON object, keyed by file name"));
     QCommandLineOption printOption(QStringList() << "p" << QStringLiteral("print"),
                                    QStringLiteral("Print detail (iid, classname, qtinfo, userdata)"), QStringLiteral("detail"));
     jsonFormatOption.setDefaultValue(QStringLiteral("indented"));
     printOption.setDefaultValues(QStringList() << QStringLiteral("iid") << QStringLiteral("qtinfo") << QStringLiteral("userdata"));
 
     parser.addOption(fullJsonOption);
+    parser.addOption(aggregateJsonOption);
     parser.addOption(jsonFormatOption);
     parser.addOption(printOption);
     parser.addHelpOption();
     parser.addVersionOption();
-    parser.addPositionalArgument(QStringLiteral("plugin"), QStringLiteral("Plug-in of which to read the meta data."), QStringLiteral("<plugin>"));
+    parser.addPositionalArgument(QStringLiteral("plugin"), QStringLiteral("Plug-in of which to read the meta data, or a directory of plug-ins."), QStringLiteral("<plugin>"));
     parser.process(app);
 
     if (parser.positionalArguments().isEmpty())
         parser.showHelp(1);
 
     bool fullJson = parser.isSet(fullJsonOption);
+    const bool aggregateJson = parser.isSet(aggregateJsonOption);
     QJsonDocument::JsonFormat jsonFormat = parser.value(jsonFormatOption) == "indented" ? QJsonDocument::Indented : QJsonDocument::Compact;
     QStringList printOptionList = parser.values(printOption);
     PrintOptions print;
@@ -90,8 +163,11 @@ int main(int argc, char** argv)
         print |= PrintUserData;
 
     int retval = 0;
-    const QStringList positionalArguments = parser.positionalArguments();
-    for (const QString &plugin : positionalArguments) {
+    const QStringList plugins = expandPluginArguments(parser.positionalArguments());
+    const std::vector<PluginMetaData> pluginMetaData = readPluginMetaData(plugins);
+    QJsonObject aggregate;
+    for (const PluginMetaData &data : pluginMetaData) {
+        const QString &plugin = data.fileName;
         QByteArray pluginNativeName = QFile::encodeName(QDir::toNativeSeparators(plugin));
         if (!QFile::exists(plugin)) {
             std::cerr << "qtplugininfo: " << pluginNativeName.constData() << ": No such file or directory." << std::endl;
@@ -104,11 +180,10 @@ int main(int argc, char** argv)
             continue;
         }
 
-        QPluginLoader loader(plugin);
-        QJsonObject metaData = loader.metaData();
+        const QJsonObject &metaData = data.metaData;
         if (metaData.isEmpty()) {
             std::cerr << "qtplugininfo: " << pluginNativeName.constData() << ": No plug-in meta-data found: "
-                      << qPrintable(loader.errorString()) << std::endl;
+                      << qPrintable(data.errorString) << std::endl;
             retval = 1;
             continue;
         }
@@ -139,7 +214,12 @@ int main(int argc, char** argv)
             continue;
         }
 
-        if (parser.positionalArguments().size() != 1)
+        if (aggregateJson) {
+            aggregate.insert(QDir::fromNativeSeparators(plugin), metaData);
+            continue;
+        }
+
+        if (plugins.size() != 1)
             std::cout << pluginNativeName.constData() << ": ";
         if (fullJson) {
             std::cout << QJsonDocument(metaData).toJson(jsonFormat).constData();
@@ -165,5 +245,11 @@ int main(int argc, char** argv)
         }
     }
 
+    if (aggregateJson) {
+        std::cout << QJsonDocument(aggregate).toJson(jsonFormat).constData();
+        if (jsonFormat == QJsonDocument::Compact)
+            std::cout << std::endl;
+    }
+
     return retval;
 }
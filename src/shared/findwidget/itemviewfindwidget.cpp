@@ -97,6 +97,7 @@ ItemViewFindWidget::ItemViewFindWidget(FindFlags flags, QWidget *parent)
  */
 void ItemViewFindWidget::setItemView(QAbstractItemView *itemView)
 {
+    forgetUnmatchedText();
     if (m_itemView)
         m_itemView->removeEventFilter(this);
 
@@ -169,6 +170,50 @@ static bool indexLessThan(const QModelIndex &a, const QModelIndex &b)
     return aa.parent().column() > ba.parent().column();
 }
 
+// While typing, each search extends the text of the previous one. If that
+// text was not found anywhere in the model, a longer one cannot be found
+// either, so the walk over the whole model is skipped until the model
+// changes. This does not hold for whole words.
+bool ItemViewFindWidget::isKnownUnmatched(const QString &textToFind) const
+{
+    if (m_unmatchedText.isEmpty() || m_unmatchedModel != m_itemView->model()
+        || wholeWords() || caseSensitive() != m_unmatchedCaseSensitive) {
+        return false;
+    }
+    const Qt::CaseSensitivity cs = caseSensitive() ? Qt::CaseSensitive : Qt::CaseInsensitive;
+    return textToFind.startsWith(m_unmatchedText, cs);
+}
+
+void ItemViewFindWidget::setUnmatchedText(const QString &textToFind)
+{
+    forgetUnmatchedText();
+    if (wholeWords())
+        return;
+    const QAbstractItemModel *model = m_itemView->model();
+    auto forget = [this] { forgetUnmatchedText(); };
+    m_modelConnections = {
+        connect(model, &QAbstractItemModel::dataChanged, this, forget),
+        connect(model, &QAbstractItemModel::rowsInserted, this, forget),
+        connect(model, &QAbstractItemModel::columnsInserted, this, forget),
+        connect(model, &QAbstractItemModel::rowsMoved, this, forget),
+        connect(model, &QAbstractItemModel::layoutChanged, this, forget),
+        connect(model, &QAbstractItemModel::modelReset, this, forget),
+        connect(model, &QObject::destroyed, this, forget)
+    };
+    m_unmatchedText = textToFind;
+    m_unmatchedModel = model;
+    m_unmatchedCaseSensitive = caseSensitive();
+}
+
+void ItemViewFindWidget::forgetUnmatchedText()
+{
+    for (const QMetaObject::Connection &connection : qAsConst(m_modelConnections))
+        disconnect(connection);
+    m_modelConnections.clear();
+    m_unmatchedText.clear();
+    m_unmatchedModel = nullptr;
+}
+
 /*!
     \reimp
  */
@@ -189,23 +234,34 @@ void ItemViewFindWidget::find(const QString &ttf, bool skipCurrent, bool backwar
     *found = true;
     QModelIndex newIdx = idx;
 
-    if (!ttf.isEmpty()) {
+    if (!ttf.isEmpty() && isKnownUnmatched(ttf)) {
+        *found = false;
+    } else if (!ttf.isEmpty()) {
+        // Compile the pattern once for the whole search.
+        QRegularExpression wordPattern;
+        if (wholeWords()) {
+            wordPattern.setPattern(QLatin1String("\\b") + QRegularExpression::escape(ttf)
+                                   + QLatin1String("\\b"));
+            if (!caseSensitive())
+                wordPattern.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+        }
         if (newIdx.isValid()) {
             int column = newIdx.column();
             if (skipCurrent)
                 if (QTreeView *tv = qobject_cast<QTreeView *>(m_itemView))
                     if (tv->allColumnsShowFocus())
                         column = backward ? 0 : m_itemView->model()->columnCount(newIdx.parent()) - 1;
-            newIdx = findHelper(ttf, skipCurrent, backward,
+            newIdx = findHelper(ttf, wordPattern, skipCurrent, backward,
                                 newIdx.parent(), newIdx.row(), column);
         }
         if (!newIdx.isValid()) {
             int row = backward ? m_itemView->model()->rowCount() : 0;
             int column = backward ? 0 : -1;
-            newIdx = findHelper(ttf, true, backward, m_itemView->rootIndex(), row, column);
+            newIdx = findHelper(ttf, wordPattern, true, backward, m_itemView->rootIndex(), row, column);
             if (!newIdx.isValid()) {
                 *found = false;
                 newIdx = idx;
+                setUnmatchedText(ttf);
             } else {
                 *wrapped = true;
             }
@@ -282,10 +338,12 @@ static inline bool skipBackward(const QAbstractItemModel *model, QModelIndex &pa
 // set of indices in traversal order (to find the start and end of the selection).
 // Consequently, we do everything by ourselves to be consistent. Of course, this puts
 // constraints on the allowable visualizations.
-QModelIndex ItemViewFindWidget::findHelper(const QString &textToFind, bool skipCurrent, bool backward,
-    QModelIndex parent, int row, int column)
+QModelIndex ItemViewFindWidget::findHelper(const QString &textToFind, const QRegularExpression &wordPattern,
+    bool skipCurrent, bool backward, QModelIndex parent, int row, int column)
 {
     const QAbstractItemModel *model = m_itemView->model();
+    const Qt::CaseSensitivity cs = caseSensitive() ? Qt::CaseSensitive : Qt::CaseInsensitive;
+    const bool matchWords = wholeWords();
     forever {
         if (skipCurrent) {
             if (backward) {
@@ -299,15 +357,8 @@ QModelIndex ItemViewFindWidget::findHelper(const QString &textToFind, bool skipC
 
         QModelIndex idx = model->index(row, column, parent);
         if (idx.isValid()) {
-            Qt::CaseSensitivity cs = caseSensitive() ? Qt::CaseSensitive : Qt::CaseInsensitive;
-
-            if (wholeWords()) {
-                QString rx = QLatin1String("\\b") + QRegularExpression::escape(textToFind)
-                             + QLatin1String("\\b");
-                QRegularExpression re(rx);
-                if (cs == Qt::CaseInsensitive)
-                    re.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
-                if (idx.data().toString().indexOf(re) >= 0)
+            if (matchWords) {
+                if (idx.data().toString().indexOf(wordPattern) >= 0)
                     return idx;
             } else {
                 if (idx.data().toString().indexOf(textToFind, 0, cs) >= 0)
@@ -43,10 +43,13 @@
 #include "abstractfindwidget.h"
 
 #include <QModelIndex>
+#include <QList>
 
 QT_BEGIN_NAMESPACE
 
+class QAbstractItemModel;
 class QAbstractItemView;
+class QRegularExpression;
 
 class ItemViewFindWidget : public AbstractFindWidget
 {
@@ -66,10 +69,18 @@ protected:
               bool backward, bool *found, bool *wrapped) override;
 
 private:
-    QModelIndex findHelper(const QString &textToFind, bool skipCurrent, bool backward,
-        QModelIndex parent, int row, int column);
+    QModelIndex findHelper(const QString &textToFind, const QRegularExpression &wordPattern,
+        bool skipCurrent, bool backward, QModelIndex parent, int row, int column);
+    bool isKnownUnmatched(const QString &textToFind) const;
+    void setUnmatchedText(const QString &textToFind);
+    void forgetUnmatchedText();
 
     QAbstractItemView *m_itemView;
+    // Text last searched for in the whole model without a match.
+    QString m_unmatchedText;
+    const QAbstractItemModel *m_unmatchedModel = nullptr;
+    bool m_unmatchedCaseSensitive = false;
+    QList<QMetaObject::Connection> m_modelConnections;
 };
 
 QT_END_NAMESPACE
@@ -46,9 +46,69 @@
 #include <QtWidgets/QFontComboBox>
 #include <QtCore/QTimer>
 #include <QtWidgets/QLineEdit>
+#include <QtGui/QGuiApplication>
+#include <QtCore/QHash>
+#include <QtCore/QPair>
 
 QT_BEGIN_NAMESPACE
 
+// Styles and point sizes queried from QFontDatabase, shared by all font
+// panels. Changing the selected family or style repeatedly is common
+// while browsing fonts, and the font database is slow to answer with
+// many fonts installed. The cache is dropped when fonts are added or
+// removed, for example by the application font dialog of Designer.
+namespace {
+class FontDatabaseCache
+{
+public:
+    static FontDatabaseCache &instance();
+
+    const QStringList &styles(const QString &family);
+    const QList<int> &pointSizes(const QString &family, const QString &style);
+
+private:
+    FontDatabaseCache();
+
+    QHash<QString, QStringList> m_styles;
+    QHash<QPair<QString, QString>, QList<int>> m_pointSizes;
+};
+
+FontDatabaseCache::FontDatabaseCache()
+{
+    QObject::connect(qApp, &QGuiApplication::fontDatabaseChanged, qApp, [this] {
+        m_styles.clear();
+        m_pointSizes.clear();
+    });
+}
+
+FontDatabaseCache &FontDatabaseCache::instance()
+{
+    static FontDatabaseCache cache;
+    return cache;
+}
+
+const QStringList &FontDatabaseCache::styles(const QString &family)
+{
+    auto it = m_styles.find(family);
+    if (it == m_styles.end())
+        it = m_styles.insert(family, QFontDatabase::styles(family));
+    return it.value();
+}
+
+const QList<int> &FontDatabaseCache::pointSizes(const QString &family, const QString &style)
+{
+    const QPair<QString, QString> key(family, style);
+    auto it = m_pointSizes.find(key);
+    if (it == m_pointSizes.end()) {
+        QList<int> pointSizes = QFontDatabase::pointSizes(family, style);
+        if (pointSizes.isEmpty())
+            pointSizes = QFontDatabase::standardSizes();
+        it = m_pointSizes.insert(key, pointSizes);
+    }
+    return it.value();
+}
+} // anonymous namespace
+
 FontPanel::FontPanel(QWidget *parentWidget) :
     QGroupBox(parentWidget),
     m_previewLineEdit(new QLineEdit),
@@ -194,7 +254,10 @@ void FontPanel::updateWritingSystem(QFontDatabase::WritingSystem ws)
 {
 
     m_previewLineEdit->setText(QFontDatabase::writingSystemSample(ws));
-    m_familyComboBox->setWritingSystem (ws);
+    // Refilling the family combo walks all installed fonts; setWritingSystem()
+    // reaches here both from the combo signal and directly.
+    if (m_familyComboBox->writingSystem() != ws)
+        m_familyComboBox->setWritingSystem(ws);
     // Current font not in WS ... set index 0.
     if (m_familyComboBox->currentIndex() < 0) {
         m_familyComboBox->setCurrentIndex(0);
@@ -208,7 +271,7 @@ void FontPanel::updateFamily(const QString &family)
     // Try to maintain selection or select normal
     const QString &oldStyleString = styleString();
 
-    const QStringList &styles = QFontDatabase::styles(family);
+    const QStringList styles = FontDatabaseCache::instance().styles(family);
     const bool hasStyles = !styles.isEmpty();
 
     m_styleComboBox->setCurrentIndex(-1);
@@ -265,9 +328,7 @@ void FontPanel::updatePointSizes(const QString &family, const QString &styleStri
 {
     const int oldPointSize = pointSize();
 
-    auto pointSizes =  QFontDatabase::pointSizes(family, styleString);
-    if (pointSizes.isEmpty())
-        pointSizes = QFontDatabase::standardSizes();
+    const QList<int> pointSizes = FontDatabaseCache::instance().pointSizes(family, styleString);
 
     const bool hasSizes = !pointSizes.isEmpty();
     m_pointSizeComboBox->clear();
@@ -39,6 +39,7 @@
 
 #include "qttreepropertybrowser.h"
 #include <QtCore/QSet>
+#include <QtCore/QTimer>
 #include <QtGui/QIcon>
 #include <QtWidgets/QTreeWidget>
 #include <QtWidgets/QItemDelegate>
@@ -95,6 +96,13 @@ public:
 
 private:
     void updateItem(QTreeWidgetItem *item);
+    void updatePendingItems();
+    bool isInCollapsedBranch(const QTreeWidgetItem *item) const;
+
+    // Items changed since the last update, and items in collapsed branches
+    // that are updated when they are expanded
+    QSet<QTreeWidgetItem *> m_pendingItems;
+    QSet<QTreeWidgetItem *> m_collapsedPendingItems;
 
     QMap<QtBrowserItem *, QTreeWidgetItem *> m_indexToItem;
     QMap<QTreeWidgetItem *, QtBrowserItem *> m_itemToIndex;
@@ -565,16 +573,47 @@ void QtTreePropertyBrowserPrivate::propertyRemoved(QtBrowserItem *index)
 
     delete item;
 
+    m_pendingItems.remove(item);
+    m_collapsedPendingItems.remove(item);
     m_indexToItem.remove(index);
     m_itemToIndex.remove(item);
     m_indexToBackgroundColor.remove(index);
 }
 
+// Property changes often come in bursts, for example when the values of all
+// properties are set for a newly selected object. Coalesce them into one
+// update when returning to the event loop.
 void QtTreePropertyBrowserPrivate::propertyChanged(QtBrowserItem *index)
 {
     QTreeWidgetItem *item = m_indexToItem.value(index);
+    if (!item)
+        return;
+
+    if (m_pendingItems.isEmpty())
+        QTimer::singleShot(0, q_ptr, [this] { updatePendingItems(); });
+    m_pendingItems.insert(item);
+}
+
+bool QtTreePropertyBrowserPrivate::isInCollapsedBranch(const QTreeWidgetItem *item) const
+{
+    for (const QTreeWidgetItem *parent = item->parent(); parent; parent = parent->parent()) {
+        if (!parent->isExpanded())
+            return true;
+    }
+    return false;
+}
 
-    updateItem(item);
+void QtTreePropertyBrowserPrivate::updatePendingItems()
+{
+    const QSet<QTreeWidgetItem *> items = m_pendingItems;
+    m_pendingItems.clear();
+    for (QTreeWidgetItem *item : items) {
+        // Items that cannot be seen are updated when their branch is expanded
+        if (isInCollapsedBranch(item))
+            m_collapsedPendingItems.insert(item);
+        else
+            updateItem(item);
+    }
 }
 
 void QtTreePropertyBrowserPrivate::updateItem(QTreeWidgetItem *item)
@@ -642,6 +681,14 @@ void QtTreePropertyBrowserPrivate::slotCollapsed(const QModelIndex &index)
 void QtTreePropertyBrowserPrivate::slotExpanded(const QModelIndex &index)
 {
     QTreeWidgetItem *item = indexToItem(index);
+    for (auto it = m_collapsedPendingItems.begin(); it != m_collapsedPendingItems.end(); ) {
+        if (isInCollapsedBranch(*it)) {
+            ++it;
+        } else {
+            updateItem(*it);
+            it = m_collapsedPendingItems.erase(it);
+        }
+    }
     QtBrowserItem *idx = m_itemToIndex.value(item);
     if (item)
         emit q_ptr->expanded(idx);
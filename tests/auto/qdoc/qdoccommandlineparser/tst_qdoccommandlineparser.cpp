@@ -119,6 +119,9 @@ void tst_QDocCommandLineParser::process()
     QVERIFY(!parser.isSet(parser.logProgressOption));
     QVERIFY(!parser.isSet(parser.singleExecOption));
     QVERIFY(!parser.isSet(parser.frameworkOption));
+    QVERIFY(!parser.isSet(parser.jobsOption));
+    QVERIFY(!parser.isSet(parser.timingsOption));
+    QVERIFY(!parser.isSet(parser.traceOption));
 
     const QStringList expectedPositionalArgument = {
         QStringLiteral("/src/qt5/qtgamepad/src/gamepad/doc/qtgamepad.qdocconf")
@@ -45,6 +45,9 @@ private slots:
     void callCommaForOneWord();
     void callCommaForTwoWords();
     void callCommaForThreeWords();
+    void htmlEscaped_data();
+    void htmlEscaped();
+    void appendHtmlEscaped();
 };
 
 void tst_Utilities::loggingCategoryName()
@@ -154,6 +157,36 @@ void tst_Utilities::callCommaForThreeWords()
     QCOMPARE(result, expected);
 }
 
+void tst_Utilities::htmlEscaped_data()
+{
+    QTest::addColumn<QString>("input");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("empty") << QString() << QString();
+    QTest::newRow("plain") << "QString::size()" << "QString::size()";
+    QTest::newRow("all") << "&<>\"" << "&amp;&lt;&gt;&quot;";
+    QTest::newRow("template") << "QList<QPair<int, QString>> &list"
+                              << "QList&lt;QPair&lt;int, QString&gt;&gt; &amp;list";
+    QTest::newRow("attribute") << "a href=\"x.html\"" << "a href=&quot;x.html&quot;";
+    QTest::newRow("non-ascii") << u"\u00e9t\u00e9 & \u2192"_qs << u"\u00e9t\u00e9 &amp; \u2192"_qs;
+    QTest::newRow("no other entities") << "' ; # @ ? \\" << "' ; # @ ? \\";
+}
+
+void tst_Utilities::htmlEscaped()
+{
+    QFETCH(QString, input);
+    QFETCH(QString, expected);
+
+    QCOMPARE(Utilities::htmlEscaped(input), expected);
+}
+
+void tst_Utilities::appendHtmlEscaped()
+{
+    QString result = QStringLiteral("<b>");
+    Utilities::appendHtmlEscaped(&result, u"a < b && c > d");
+    QCOMPARE(result, QStringLiteral("<b>a &lt; b &amp;&amp; c &gt; d"));
+}
+
 QTEST_APPLESS_MAIN(tst_Utilities)
 
 #include "tst_utilities.moc"
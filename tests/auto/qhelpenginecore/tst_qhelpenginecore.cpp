@@ -30,6 +30,7 @@
 #include <QtCore/QUrl>
 #include <QtCore/QFileInfo>
 #include <QtCore/QScopeGuard>
+#include <QtCore/QThread>
 #include <QtSql/QSqlDatabase>
 #include <QtSql/QSqlQuery>
 
@@ -63,6 +64,7 @@ private slots:
     void filterAttributeSets();
     void files();
     void fileData();
+    void fileDataFromThreads();
 
     void customValue();
     void setCustomValue();
@@ -380,6 +382,36 @@ void tst_QHelpEngineCore::fileData()
     QCOMPARE(s.readAll(), ts.readAll());
 }
 
+void tst_QHelpEngineCore::fileDataFromThreads()
+{
+    QHelpEngineCore help(m_colFile, 0);
+    help.setUsesFilterEngine(true);
+    QCOMPARE(help.setupData(), true);
+    help.setFileDataCacheLimit(0);
+
+    const QUrl url("qthelp://trolltech.com.1.0.0.test/testFolder/test.html");
+    const QByteArray expected = help.fileData(url);
+    QVERIFY(!expected.isEmpty());
+
+    QList<QThread *> threads;
+    QAtomicInt mismatches = 0;
+    for (int i = 0; i < 4; ++i) {
+        threads.append(QThread::create([&] {
+            for (int j = 0; j < 20; ++j) {
+                if (help.fileData(url) != expected)
+                    mismatches.ref();
+            }
+        }));
+    }
+    for (QThread *thread : threads)
+        thread->start();
+    for (QThread *thread : threads) {
+        QVERIFY(thread->wait());
+        delete thread;
+    }
+    QCOMPARE(mismatches.loadRelaxed(), 0);
+}
+
 void tst_QHelpEngineCore::customValue()
 {
     QHelpEngineCore help(m_colFile, 0);
@@ -33,6 +33,7 @@
 #include <QtCore/qjsondocument.h>
 #include <QtCore/qlibraryinfo.h>
 #include <QtCore/qprocess.h>
+#include <QtCore/qtemporarydir.h>
 
 #include <QtTest/qtest.h>
 
@@ -45,9 +46,12 @@ public:
 private slots:
     void test_data();
     void test();
+    void cache_data();
+    void cache();
 
 private:
     void readExpectedFile(const QString &baseDir, const QString &fileName, QByteArray *content);
+    void runScanner(const QStringList &arguments, QByteArray *stdOut, QByteArray *stdErr);
 
     QString m_cmd;
     QString m_basePath;
@@ -97,18 +101,10 @@ void tst_qtattributionsscanner::readExpectedFile(const QString &baseDir, const Q
     content->replace("%{PWD}", baseDir.toUtf8());
 }
 
-void tst_qtattributionsscanner::test()
+void tst_qtattributionsscanner::runScanner(const QStringList &arguments, QByteArray *stdOut,
+                                           QByteArray *stdErr)
 {
-    QFETCH(QString, input);
-    QFETCH(QString, stdout_file);
-    QFETCH(QString, stderr_file);
-
-    QString dir = QDir(m_basePath).absoluteFilePath(input);
-    if (QFileInfo(dir).isFile())
-        dir = QFileInfo(dir).absolutePath();
-
     QProcess proc;
-    const QStringList arguments{dir, "--output-format", "json"};
     QString command = m_cmd + ' ' + arguments.join(' ');
     QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
     env.insert("QT_ATTRIBUTIONSSCANNER_TEST", "1");
@@ -124,10 +120,28 @@ void tst_qtattributionsscanner::test()
              "\"qtattributionsscanner " + m_cmd.toLatin1() + "\" exited with code " +
              QByteArray::number(proc.exitCode()));
 
-    { // compare error output
-        QByteArray stdErr = proc.readAllStandardError();
-        stdErr.replace(QDir::separator().toLatin1(), "/");
+    *stdOut = proc.readAllStandardOutput();
+    *stdErr = proc.readAllStandardError();
+    stdErr->replace(QDir::separator().toLatin1(), "/");
+}
 
+void tst_qtattributionsscanner::test()
+{
+    QFETCH(QString, input);
+    QFETCH(QString, stdout_file);
+    QFETCH(QString, stderr_file);
+
+    QString dir = QDir(m_basePath).absoluteFilePath(input);
+    if (QFileInfo(dir).isFile())
+        dir = QFileInfo(dir).absolutePath();
+
+    QByteArray stdOut;
+    QByteArray stdErr;
+    runScanner({dir, "--output-format", "json"}, &stdOut, &stdErr);
+    if (QTest::currentTestFailed())
+        return;
+
+    { // compare error output
         QByteArray expectedErrorOutput;
         readExpectedFile(dir, stderr_file, &expectedErrorOutput);
 
@@ -135,8 +149,6 @@ void tst_qtattributionsscanner::test()
     }
 
     { // compare json output
-        QByteArray stdOut = proc.readAllStandardOutput();
-
         QJsonParseError jsonError;
         QJsonDocument actualJson = QJsonDocument::fromJson(stdOut, &jsonError);
         QVERIFY2(!actualJson.isNull(), "Invalid output: " + jsonError.errorString().toLatin1());
@@ -153,5 +165,55 @@ void tst_qtattributionsscanner::test()
     }
 }
 
+void tst_qtattributionsscanner::cache_data()
+{
+    QTest::addColumn<QString>("input");
+    QTest::addColumn<QString>("stdout_file");
+    QTest::addColumn<QString>("stderr_file");
+
+    QTest::newRow("good")
+            << QStringLiteral("good")
+            << QStringLiteral("good/expected.json")
+            << QStringLiteral("good/expected.error");
+    QTest::newRow("warnings (unknown attribute)")
+            << QStringLiteral("warnings/unknown")
+            << QStringLiteral("warnings/unknown/expected.json")
+            << QStringLiteral("warnings/unknown/expected.error");
+}
+
+// A run that reuses the cache has to produce the same output as the first one
+void tst_qtattributionsscanner::cache()
+{
+    QFETCH(QString, input);
+    QFETCH(QString, stdout_file);
+    QFETCH(QString, stderr_file);
+
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    const QString cacheFile = cacheDir.filePath(QStringLiteral("scan.cache"));
+
+    const QString dir = QDir(m_basePath).absoluteFilePath(input);
+    const QStringList arguments{dir, "--output-format", "json", "--cache", cacheFile};
+
+    QByteArray expectedErrorOutput;
+    readExpectedFile(dir, stderr_file, &expectedErrorOutput);
+    QByteArray expectedOutput;
+    readExpectedFile(dir, stdout_file, &expectedOutput);
+    const QJsonDocument expectedJson = QJsonDocument::fromJson(expectedOutput);
+
+    for (int run = 0; run < 2; ++run) {
+        QByteArray stdOut;
+        QByteArray stdErr;
+        runScanner(arguments, &stdOut, &stdErr);
+        if (QTest::currentTestFailed())
+            return;
+        if (run == 0)
+            QVERIFY(QFileInfo::exists(cacheFile));
+
+        QCOMPARE(stdErr, expectedErrorOutput);
+        QCOMPARE(QJsonDocument::fromJson(stdOut), expectedJson);
+    }
+}
+
 QTEST_MAIN(tst_qtattributionsscanner)
 #include "tst_qtattributionsscanner.moc"
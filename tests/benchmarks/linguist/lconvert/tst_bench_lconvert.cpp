@@ -0,0 +1,101 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QProcess>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include "tsfixture.h"
+
+/*
+  Runs lconvert over a generated TS file with many messages, which
+  measures the TS reader and the writers of the output formats.
+ */
+class tst_bench_lconvert : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void convert_data();
+    void convert();
+
+private:
+    QString m_lconvert;
+    QTemporaryDir m_dir;
+    QString m_tsFile;
+};
+
+void tst_bench_lconvert::initTestCase()
+{
+    const auto binpath = QLibraryInfo::path(QLibraryInfo::BinariesPath);
+    const auto extension = QSysInfo::productType() == "windows" ? ".exe" : "";
+    m_lconvert = binpath + QLatin1String("/lconvert") + extension;
+
+    QVERIFY(m_dir.isValid());
+    m_tsFile = m_dir.filePath("large.ts");
+    QVERIFY(TsFixture::write(m_tsFile, 1000, 100, TsFixture::RichMessages));
+}
+
+void tst_bench_lconvert::cleanupTestCase()
+{
+    m_dir.remove();
+}
+
+void tst_bench_lconvert::convert_data()
+{
+    QTest::addColumn<QString>("outputFormat");
+
+    QTest::newRow("ts") << "ts";
+    QTest::newRow("xlf") << "xlf";
+    QTest::newRow("po") << "po";
+    QTest::newRow("qm") << "qm";
+}
+
+void tst_bench_lconvert::convert()
+{
+    QFETCH(QString, outputFormat);
+
+    const QString outputFile = m_dir.filePath("output." + outputFormat);
+    const QStringList args = { "-i", m_tsFile, "-of", outputFormat, "-o", outputFile };
+
+    QBENCHMARK {
+        QFile::remove(outputFile);
+        QProcess lconvert;
+        lconvert.start(m_lconvert, args);
+        QVERIFY(lconvert.waitForFinished(-1));
+        QCOMPARE(lconvert.exitStatus(), QProcess::NormalExit);
+        QCOMPARE(lconvert.exitCode(), 0);
+    }
+}
+
+QTEST_MAIN(tst_bench_lconvert)
+
+#include "tst_bench_lconvert.moc"
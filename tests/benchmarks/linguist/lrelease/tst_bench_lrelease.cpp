@@ -0,0 +1,104 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QProcess>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include "tsfixture.h"
+
+/*
+  Runs lrelease over generated TS files with many messages, which
+  is dominated by building the QM hash tables in Releaser::squeeze().
+ */
+class tst_bench_lrelease : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void release_data();
+    void release();
+
+private:
+    QString m_lrelease;
+};
+
+void tst_bench_lrelease::initTestCase()
+{
+    const auto binpath = QLibraryInfo::path(QLibraryInfo::BinariesPath);
+    const auto extension = QSysInfo::productType() == "windows" ? ".exe" : "";
+    m_lrelease = binpath + QLatin1String("/lrelease") + extension;
+}
+
+void tst_bench_lrelease::release_data()
+{
+    QTest::addColumn<int>("contextCount");
+    QTest::addColumn<int>("messageCount");
+    QTest::addColumn<bool>("compress");
+
+    QTest::newRow("10k messages") << 100 << 100 << false;
+    QTest::newRow("100k messages") << 1000 << 100 << false;
+    QTest::newRow("100k messages, compressed") << 1000 << 100 << true;
+    QTest::newRow("100k messages, 20k contexts") << 20000 << 5 << true;
+}
+
+void tst_bench_lrelease::release()
+{
+    QFETCH(int, contextCount);
+    QFETCH(int, messageCount);
+    QFETCH(bool, compress);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString tsFile = dir.filePath("large.ts");
+    const QString qmFile = dir.filePath("large.qm");
+    QVERIFY(TsFixture::write(tsFile, contextCount, messageCount, TsFixture::SharedSourceTexts));
+
+    QStringList args;
+    args << "-silent";
+    if (compress)
+        args << "-compress";
+    args << tsFile << "-qm" << qmFile;
+
+    QBENCHMARK {
+        // lrelease does not rewrite unchanged QM files; remove it so every
+        // iteration measures a full release.
+        QFile::remove(qmFile);
+        QProcess lrelease;
+        lrelease.start(m_lrelease, args);
+        QVERIFY(lrelease.waitForFinished(-1));
+        QCOMPARE(lrelease.exitStatus(), QProcess::NormalExit);
+        QCOMPARE(lrelease.exitCode(), 0);
+    }
+}
+
+QTEST_MAIN(tst_bench_lrelease)
+
+#include "tst_bench_lrelease.moc"
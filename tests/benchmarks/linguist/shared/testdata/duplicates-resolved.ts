@@ -0,0 +1,40 @@
+<?xml version="1.0" encoding="utf-8"?>
+<!DOCTYPE TS>
+<TS version="2.1" language="de" sourcelanguage="en">
+<context>
+    <name>Dialog</name>
+    <message id="open">
+        <source>Open</source>
+        <translation type="unfinished">Öffnen</translation>
+    </message>
+    <message id="close">
+        <source>Close</source>
+        <translation>Schließen</translation>
+    </message>
+    <message id="save">
+        <source>Save</source>
+        <translation>Speichern</translation>
+    </message>
+    <message id="store">
+        <source>Save</source>
+        <translation>Sichern</translation>
+    </message>
+    <message>
+        <source>Save</source>
+        <comment>menu</comment>
+        <translation>Sichern</translation>
+    </message>
+    <message>
+        <source></source>
+        <comment>The main dialog</comment>
+        <translation></translation>
+    </message>
+</context>
+<context>
+    <name>Other</name>
+    <message>
+        <source>Close</source>
+        <translation>Zu</translation>
+    </message>
+</context>
+</TS>
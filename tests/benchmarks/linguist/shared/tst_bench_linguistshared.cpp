@@ -0,0 +1,310 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "lupdate.h"
+#include "translator.h"
+
+#include <QTemporaryDir>
+#include <QtTest>
+
+/*
+  Exercises the code shared by the Linguist tools in-process, so that
+  the TS reader and writer, lupdate's merge() and the QM writer and
+  reader can be measured separately on catalogs of realistic shape:
+  plural forms, comments, references and obsolete entries.
+ */
+class tst_bench_linguistshared : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void loadTs_data() { addRows(); }
+    void loadTs();
+    void saveTs_data() { addRows(); }
+    void saveTs();
+    void merge_data() { addRows(); }
+    void merge();
+    void saveQm_data() { addRows(); }
+    void saveQm();
+    void loadQm_data() { addRows(); }
+    void loadQm();
+    void resolveDuplicates_data() { addDuplicateRows(); }
+    void resolveDuplicates();
+    void resolveDuplicatesResult();
+
+private:
+    QTemporaryDir m_dir;
+
+    static void addRows();
+    static void addDuplicateRows();
+    static Translator createCatalog(int contextCount, int messageCount, bool translated);
+    static Translator createCatalogWithDuplicates(int contextCount, int messageCount,
+                                                  int duplicateEvery);
+};
+
+void tst_bench_linguistshared::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+void tst_bench_linguistshared::addRows()
+{
+    QTest::addColumn<int>("contextCount");
+    QTest::addColumn<int>("messageCount");
+
+    QTest::newRow("10k messages") << 100 << 100;
+    QTest::newRow("100k messages") << 1000 << 100;
+    QTest::newRow("100k messages, 20k contexts") << 20000 << 5;
+    QTest::newRow("500k messages") << 5000 << 100;
+}
+
+void tst_bench_linguistshared::addDuplicateRows()
+{
+    QTest::addColumn<int>("contextCount");
+    QTest::addColumn<int>("messageCount");
+    QTest::addColumn<int>("duplicateEvery");
+
+    QTest::newRow("100k messages, no duplicates") << 1000 << 100 << 0;
+    QTest::newRow("100k messages, 10% duplicates") << 1000 << 100 << 10;
+    QTest::newRow("100k messages, 50% duplicates") << 1000 << 100 << 2;
+    QTest::newRow("100k messages, 20k contexts, 10% duplicates") << 20000 << 5 << 10;
+}
+
+/*
+  Every tenth message is a plural, every seventh carries a disambiguation
+  and every fifth an extra comment. A translated catalog additionally
+  has translator comments and marks every twentieth message obsolete;
+  an untranslated one renames every twentieth source text, as if the
+  code had changed since the last lupdate run.
+ */
+Translator tst_bench_linguistshared::createCatalog(int contextCount, int messageCount,
+                                                  bool translated)
+{
+    Translator tor;
+    tor.setLanguageCode(QStringLiteral("de"));
+    tor.setSourceLanguageCode(QStringLiteral("en"));
+    for (int c = 0; c < contextCount; ++c) {
+        const QString context = QStringLiteral("Context%1").arg(c);
+        const QString fileName = QStringLiteral("src/file%1.cpp").arg(c);
+        for (int m = 0; m < messageCount; ++m) {
+            const bool plural = m % 10 == 0;
+            QString source = plural
+                    ? QStringLiteral("Found %n file(s) in folder %1").arg(m)
+                    : QStringLiteral("Message number %1 in context %2").arg(m).arg(c);
+            if (!translated && m % 20 == 19)
+                source += QStringLiteral(" (changed)");
+            const QString comment = m % 7 == 0 ? QStringLiteral("disambiguation %1").arg(m)
+                                               : QString();
+            TranslatorMessage msg(context, source, comment, QString(), fileName, 10 + m);
+            msg.setPlural(plural);
+            if (m % 5 == 0)
+                msg.setExtraComment(QStringLiteral("Shown in the status bar"));
+            if (translated) {
+                QStringList translations;
+                if (plural) {
+                    translations << QStringLiteral("%n Datei in Ordner %1 gefunden").arg(m)
+                                 << QStringLiteral("%n Dateien in Ordner %1 gefunden").arg(m);
+                } else {
+                    translations << QStringLiteral("Nachricht Nummer %1 in Kontext %2")
+                                            .arg(m).arg(c);
+                }
+                msg.setTranslations(translations);
+                if (m % 20 == 19)
+                    msg.setType(TranslatorMessage::Obsolete);
+                else
+                    msg.setType(m % 3 ? TranslatorMessage::Finished
+                                      : TranslatorMessage::Unfinished);
+                if (m % 11 == 0)
+                    msg.setTranslatorComment(QStringLiteral("Checked against the glossary"));
+            }
+            tor.append(msg);
+        }
+    }
+    return tor;
+}
+
+/*
+  Takes a translated catalog, gives every other message an ID and appends
+  a copy of every duplicateEvery-th message: copies of messages with an ID
+  are ID duplicates, the others content duplicates.
+ */
+Translator tst_bench_linguistshared::createCatalogWithDuplicates(int contextCount,
+                                                                int messageCount,
+                                                                int duplicateEvery)
+{
+    const Translator catalog = createCatalog(contextCount, messageCount, true);
+    Translator tor;
+    tor.setLanguageCode(catalog.languageCode());
+    tor.setSourceLanguageCode(catalog.sourceLanguageCode());
+    const QList<TranslatorMessage> &messages = catalog.messages();
+    for (int i = 0; i < messages.size(); ++i) {
+        TranslatorMessage msg = messages.at(i);
+        if (i % 2 == 0)
+            msg.setId(QStringLiteral("msg_%1").arg(i));
+        tor.append(msg);
+    }
+    if (duplicateEvery > 0) {
+        for (int i = 0; i < messages.size(); i += duplicateEvery) {
+            const TranslatorMessage msg = tor.message(i);
+            tor.append(msg);
+        }
+    }
+    return tor;
+}
+
+void tst_bench_linguistshared::loadTs()
+{
+    QFETCH(int, contextCount);
+    QFETCH(int, messageCount);
+
+    const QString fileName = m_dir.filePath(QStringLiteral("load.ts"));
+    ConversionData cd;
+    QVERIFY(createCatalog(contextCount, messageCount, true)
+                    .save(fileName, cd, QStringLiteral("ts")));
+
+    QBENCHMARK {
+        Translator tor;
+        QVERIFY(tor.load(fileName, cd, QStringLiteral("ts")));
+        QCOMPARE(tor.messageCount(), contextCount * messageCount);
+    }
+}
+
+void tst_bench_linguistshared::saveTs()
+{
+    QFETCH(int, contextCount);
+    QFETCH(int, messageCount);
+
+    const QString fileName = m_dir.filePath(QStringLiteral("save.ts"));
+    const Translator tor = createCatalog(contextCount, messageCount, true);
+    ConversionData cd;
+
+    QBENCHMARK {
+        QVERIFY(tor.save(fileName, cd, QStringLiteral("ts")));
+    }
+}
+
+void tst_bench_linguistshared::merge()
+{
+    QFETCH(int, contextCount);
+    QFETCH(int, messageCount);
+
+    const Translator tor = createCatalog(contextCount, messageCount, true);
+    const Translator virginTor = createCatalog(contextCount, messageCount, false);
+    // HeuristicSimilarText compares every new message with every obsolete
+    // one of its context, which dominates everything else at these sizes.
+    const UpdateOptions options = HeuristicSameText | HeuristicNumber;
+
+    QBENCHMARK {
+        QString err;
+        const Translator out =
+                QT_PREPEND_NAMESPACE(merge)(tor, virginTor, QList<Translator>(), options, err);
+        QVERIFY(out.messageCount() >= contextCount * messageCount);
+    }
+}
+
+void tst_bench_linguistshared::saveQm()
+{
+    QFETCH(int, contextCount);
+    QFETCH(int, messageCount);
+
+    const QString fileName = m_dir.filePath(QStringLiteral("save.qm"));
+    const Translator tor = createCatalog(contextCount, messageCount, true);
+    ConversionData cd;
+
+    QBENCHMARK {
+        QVERIFY(tor.save(fileName, cd, QStringLiteral("qm")));
+    }
+}
+
+void tst_bench_linguistshared::loadQm()
+{
+    QFETCH(int, contextCount);
+    QFETCH(int, messageCount);
+
+    const QString fileName = m_dir.filePath(QStringLiteral("load.qm"));
+    ConversionData cd;
+    QVERIFY(createCatalog(contextCount, messageCount, true)
+                    .save(fileName, cd, QStringLiteral("qm")));
+
+    QBENCHMARK {
+        Translator tor;
+        QVERIFY(tor.load(fileName, cd, QStringLiteral("qm")));
+        QVERIFY(tor.messageCount() > 0);
+    }
+}
+
+void tst_bench_linguistshared::resolveDuplicates()
+{
+    QFETCH(int, contextCount);
+    QFETCH(int, messageCount);
+    QFETCH(int, duplicateEvery);
+
+    const Translator tor = createCatalogWithDuplicates(contextCount, messageCount, duplicateEvery);
+
+    QBENCHMARK {
+        Translator copy = tor;
+        copy.resolveDuplicates();
+        QCOMPARE(copy.messageCount(), contextCount * messageCount);
+    }
+}
+
+/*
+  Checks resolveDuplicates() against the hand-checked result in
+  testdata/duplicates-resolved.ts: ID duplicates, content duplicates
+  that adopt the ID and the translation of the duplicate, messages
+  with the same contents but distinct IDs and context comments.
+ */
+void tst_bench_linguistshared::resolveDuplicatesResult()
+{
+    ConversionData cd;
+    Translator tor;
+    QVERIFY(tor.load(QFINDTESTDATA("testdata/duplicates.ts"), cd, QStringLiteral("ts")));
+    Translator expected;
+    QVERIFY(expected.load(QFINDTESTDATA("testdata/duplicates-resolved.ts"), cd,
+                          QStringLiteral("ts")));
+
+    tor.resolveDuplicates();
+
+    QCOMPARE(tor.messageCount(), expected.messageCount());
+    for (int i = 0; i < tor.messageCount(); ++i) {
+        const TranslatorMessage &msg = tor.message(i);
+        const TranslatorMessage &expectedMsg = expected.message(i);
+        QCOMPARE(msg.context(), expectedMsg.context());
+        QCOMPARE(msg.sourceText(), expectedMsg.sourceText());
+        QCOMPARE(msg.comment(), expectedMsg.comment());
+        QCOMPARE(msg.id(), expectedMsg.id());
+        QCOMPARE(msg.translations(), expectedMsg.translations());
+        QCOMPARE(msg.type(), expectedMsg.type());
+    }
+}
+
+QTEST_MAIN(tst_bench_linguistshared)
+
+#include "tst_bench_linguistshared.moc"
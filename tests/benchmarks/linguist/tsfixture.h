@@ -0,0 +1,112 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef TSFIXTURE_H
+#define TSFIXTURE_H
+
+#include <QtCore/qfile.h>
+#include <QtCore/qflags.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qtextstream.h>
+
+/*
+  Generates the large TS files that the linguist benchmarks run the
+  tools over.
+ */
+namespace TsFixture {
+
+enum Option {
+    // Every tenth message shares its source text with the message in
+    // the same position in the other contexts, so that the QM file
+    // needs context prefixes.
+    SharedSourceTexts = 0x1,
+    // The messages have locations, plural forms, unfinished
+    // translations and characters that need escaping.
+    RichMessages = 0x2
+};
+Q_DECLARE_FLAGS(Options, Option)
+Q_DECLARE_OPERATORS_FOR_FLAGS(Options)
+
+/*
+  Writes a TS file named \a fileName with \a contextCount contexts of
+  \a messageCount messages each, every seventh of which has a comment.
+  Returns false if the file cannot be written.
+ */
+inline bool write(const QString &fileName, int contextCount, int messageCount, Options options)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::WriteOnly | QFile::Text))
+        return false;
+
+    QTextStream ts(&file);
+    ts << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+       << "<!DOCTYPE TS>\n"
+       << "<TS version=\"2.1\" language=\"de\">\n";
+    for (int c = 0; c < contextCount; ++c) {
+        ts << "<context>\n    <name>Context" << c << "</name>\n";
+        for (int m = 0; m < messageCount; ++m) {
+            const int text = (options & SharedSourceTexts) && m % 10 != 0 ? c * messageCount + m : m;
+            const bool rich = options & RichMessages;
+            const bool plural = rich && m % 13 == 0;
+            ts << (plural ? "    <message numerus=\"yes\">\n" : "    <message>\n");
+            if (rich) {
+                ts << "        <location filename=\"src/file" << c << ".cpp\" line=\"" << 10 * m
+                   << "\"/>\n"
+                   << "        <source>Source &lt;text&gt; number " << text
+                   << " &amp; more</source>\n";
+            } else {
+                ts << "        <source>Source text number " << text << "</source>\n";
+            }
+            if (m % 7 == 0)
+                ts << "        <comment>Comment " << m << "</comment>\n";
+            if (plural) {
+                ts << "        <translation>\n"
+                   << "            <numerusform>%n Nachricht " << text << "</numerusform>\n"
+                   << "            <numerusform>%n Nachrichten " << text << "</numerusform>\n"
+                   << "        </translation>\n";
+            } else if (rich && m % 5 == 0) {
+                ts << "        <translation type=\"unfinished\"></translation>\n";
+            } else if (rich) {
+                ts << "        <translation>&#xdc;bersetzter &quot;Text&quot; " << text
+                   << "</translation>\n";
+            } else {
+                ts << "        <translation>Translated text number " << text
+                   << "</translation>\n";
+            }
+            ts << "    </message>\n";
+        }
+        ts << "</context>\n";
+    }
+    ts << "</TS>\n";
+    return ts.status() == QTextStream::Ok;
+}
+
+} // namespace TsFixture
+
+#endif // TSFIXTURE_H
@@ -0,0 +1,234 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QElapsedTimer>
+#include <QProcess>
+#include <QRegularExpression>
+#include <QTemporaryDir>
+#include <QtTest>
+
+/*
+  Runs qdoc over the generatedoutput test fixtures and over a generated
+  module with many classes and links, and reports throughput based on
+  the counters that qdoc prints with -timings.
+ */
+class tst_bench_qdoc : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void fixtures_data();
+    void fixtures();
+    void largeModule_data();
+    void largeModule();
+
+private:
+    QString m_qdoc;
+    QString m_extraParams;
+
+    void runQDoc(const QStringList &arguments);
+    void reportThroughput(const QString &timings, qint64 elapsed);
+    static void writeLargeModule(const QString &dir, int classCount, int functionCount);
+};
+
+void tst_bench_qdoc::initTestCase()
+{
+    const auto binpath = QLibraryInfo::path(QLibraryInfo::BinariesPath);
+    const auto extension = QSysInfo::productType() == "windows" ? ".exe" : "";
+    m_qdoc = binpath + QLatin1String("/qdoc") + extension;
+
+    m_extraParams = QFileInfo(QTest::currentAppName()).dir().filePath("qdocincludepaths.inc");
+    if (!QFileInfo::exists(m_extraParams))
+        m_extraParams.clear();
+    else
+        m_extraParams.insert(0, '@');
+}
+
+void tst_bench_qdoc::runQDoc(const QStringList &arguments)
+{
+    QStringList args = arguments;
+    args << "-timings";
+    if (!m_extraParams.isEmpty())
+        args << m_extraParams;
+
+    QElapsedTimer timer;
+    QProcess qdocProcess;
+    qdocProcess.setProgram(m_qdoc);
+    qdocProcess.setArguments(args);
+    timer.start();
+    qdocProcess.start();
+    qdocProcess.waitForFinished(-1);
+    const qint64 elapsed = timer.elapsed();
+
+    const QString errors = QString::fromUtf8(qdocProcess.readAllStandardError());
+    if (qdocProcess.exitStatus() != QProcess::NormalExit || qdocProcess.exitCode() != 0) {
+        qInfo().nospace() << "Received errors:\n" << qUtf8Printable(errors);
+        QFAIL("Running QDoc failed. See output above.");
+    }
+    reportThroughput(errors, elapsed);
+}
+
+/*
+  Sums the counters named in the -timings summary of every
+  qdocconf file in \a timings and prints them per second of
+  \a elapsed wall time.
+ */
+void tst_bench_qdoc::reportThroughput(const QString &timings, qint64 elapsed)
+{
+    static const QRegularExpression counter(
+            QStringLiteral("^\\s*(pages written|link target lookups)\\s+(\\d+)\\s*$"),
+            QRegularExpression::MultilineOption);
+    static const QRegularExpression rss(QStringLiteral("peak RSS (\\d+) MB"));
+
+    qint64 pages = 0;
+    qint64 lookups = 0;
+    for (const auto &match : counter.globalMatch(timings)) {
+        if (match.captured(1) == QLatin1String("pages written"))
+            pages += match.captured(2).toLongLong();
+        else
+            lookups += match.captured(2).toLongLong();
+    }
+    qint64 peakRss = 0;
+    for (const auto &match : rss.globalMatch(timings))
+        peakRss = qMax(peakRss, match.captured(1).toLongLong());
+
+    const double seconds = qMax<qint64>(elapsed, 1) / 1000.0;
+    qInfo("%lld ms, %lld pages (%.0f pages/s), %lld link lookups (%.0f lookups/s), "
+          "peak RSS %lld MB",
+          elapsed, pages, pages / seconds, lookups, lookups / seconds, peakRss);
+}
+
+void tst_bench_qdoc::fixtures_data()
+{
+    QTest::addColumn<QString>("qdocconf");
+
+    QTest::newRow("qdoc files") << "testdata/configs/test.qdocconf";
+    QTest::newRow("cpp") << "testdata/configs/testcpp.qdocconf";
+    QTest::newRow("qml") << "testdata/configs/testqml.qdocconf";
+    QTest::newRow("webxml cpp") << "testdata/configs/webxml_testcpp.qdocconf";
+    QTest::newRow("docbook cpp") << "testdata/configs/docbook_testcpp.qdocconf";
+}
+
+void tst_bench_qdoc::fixtures()
+{
+    QFETCH(QString, qdocconf);
+    const QString config =
+            QFINDTESTDATA(QStringLiteral("../../auto/qdoc/generatedoutput/") + qdocconf);
+    QVERIFY(!config.isEmpty());
+
+    QBENCHMARK {
+        QTemporaryDir outputDir;
+        QVERIFY(outputDir.isValid());
+        runQDoc({ "-outputdir", outputDir.path(), config });
+    }
+}
+
+void tst_bench_qdoc::largeModule_data()
+{
+    QTest::addColumn<int>("classCount");
+    QTest::addColumn<int>("functionCount");
+
+    QTest::newRow("100 classes") << 100 << 10;
+    QTest::newRow("1000 classes") << 1000 << 10;
+    QTest::newRow("3000 classes") << 3000 << 5;
+}
+
+void tst_bench_qdoc::largeModule()
+{
+    QFETCH(int, classCount);
+    QFETCH(int, functionCount);
+
+    QTemporaryDir sourceDir;
+    QVERIFY(sourceDir.isValid());
+    writeLargeModule(sourceDir.path(), classCount, functionCount);
+    const QString config = sourceDir.filePath("largemodule.qdocconf");
+
+    QBENCHMARK {
+        QTemporaryDir outputDir;
+        QVERIFY(outputDir.isValid());
+        runQDoc({ "-outputdir", outputDir.path(), config });
+    }
+}
+
+/*
+  Writes a module with \a classCount documented classes of
+  \a functionCount member functions each into \a dir. Every
+  function links to a function of the next class, and every
+  class links to its neighbors and to an unresolvable target.
+ */
+void tst_bench_qdoc::writeLargeModule(const QString &dir, int classCount, int functionCount)
+{
+    QFile header(dir + "/largemodule.h");
+    QFile source(dir + "/largemodule.cpp");
+    QFile config(dir + "/largemodule.qdocconf");
+    QVERIFY(header.open(QFile::WriteOnly | QFile::Text));
+    QVERIFY(source.open(QFile::WriteOnly | QFile::Text));
+    QVERIFY(config.open(QFile::WriteOnly | QFile::Text));
+
+    QTextStream h(&header);
+    QTextStream cpp(&source);
+    h << "#pragma once\n\nnamespace Large {\n";
+    cpp << "#include \"largemodule.h\"\n\n"
+        << "/*!\n    \\module LargeModule\n    \\title Large Module\n*/\n\n"
+        << "/*!\n    \\namespace Large\n    \\inmodule LargeModule\n"
+        << "    \\brief A generated namespace.\n*/\n\n";
+
+    for (int c = 0; c < classCount; ++c) {
+        const QString name = QStringLiteral("Class%1").arg(c);
+        const QString next = QStringLiteral("Class%1").arg((c + 1) % classCount);
+        const QString previous = QStringLiteral("Class%1").arg((c + classCount - 1) % classCount);
+
+        h << "class " << name << "\n{\npublic:\n";
+        cpp << "/*!\n    \\class Large::" << name << "\n    \\inmodule LargeModule\n"
+            << "    \\brief The " << name << " class is generated.\n\n"
+            << "    See \\l {Large::" << next << "}{" << next << "}, \\l {Large::" << previous
+            << "}{" << previous << "}, \\l {Large Module} and \\l {Missing" << c << "}.\n*/\n\n";
+
+        for (int f = 0; f < functionCount; ++f) {
+            h << "    int function" << f << "(int value) const;\n";
+            cpp << "/*!\n    Returns \\a value. See also \\l {Large::" << next << "::function" << f
+                << "()}.\n*/\n"
+                << "int Large::" << name << "::function" << f << "(int value) const\n"
+                << "{\n    return value;\n}\n\n";
+        }
+        h << "};\n\n";
+    }
+    h << "} // namespace Large\n";
+
+    QTextStream qdocconf(&config);
+    qdocconf << "project = LargeModule\n"
+             << "headers = largemodule.h\n"
+             << "sources = largemodule.cpp\n"
+             << "outputformats = HTML\n"
+             << "locationinfo = false\n";
+}
+
+QTEST_MAIN(tst_bench_qdoc)
+
+#include "tst_bench_qdoc.moc"
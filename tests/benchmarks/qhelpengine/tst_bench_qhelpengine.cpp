@@ -0,0 +1,385 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "../../../src/assistant/qhelpgenerator/helpgenerator.h"
+#include "../../../src/assistant/qhelpgenerator/qhelpprojectdata_p.h"
+
+#include <QtHelp/QHelpContentModel>
+#include <QtHelp/QHelpEngine>
+#include <QtHelp/QHelpIndexModel>
+#include <QtHelp/QHelpSearchEngine>
+
+#include <QTemporaryDir>
+#include <QtTest>
+
+/*
+  Measures the help engine on synthetic documentation: a number of
+  .qch files, each with the given number of pages, two keywords per
+  page and a table of contents with a chapter for every ten pages.
+  The files are generated in-process once per row and shared by all
+  functions. Where a function runs SQL queries through the engine,
+  their number per iteration is printed as well.
+ */
+class tst_bench_qhelpengine : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void registerDocumentation_data() { addRows(); }
+    void registerDocumentation();
+    void fileDataCold_data() { addRows(); }
+    void fileDataCold();
+    void fileDataWarm_data() { addRows(); }
+    void fileDataWarm();
+    void indexFilter_data() { addRows(); }
+    void indexFilter();
+    void contentTree_data() { addRows(); }
+    void contentTree();
+    void searchQuery_data() { addRows(); }
+    void searchQuery();
+
+private:
+    QTemporaryDir m_dir;
+    QHash<QString, QStringList> m_documentations;
+    QHash<QString, QString> m_collections;
+    int m_collectionCount = 0;
+
+    static void addRows();
+    static QString rowName(int docCount, int pageCount);
+    QStringList documentations(int docCount, int pageCount);
+    QString createCollection(int docCount, int pageCount);
+    QString registeredCollection(int docCount, int pageCount);
+    QList<QUrl> pageUrls(const QHelpEngineCore &engine) const;
+    static void reportQueries(const QHelpEngineCore &engine, int iterations);
+};
+
+void tst_bench_qhelpengine::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+void tst_bench_qhelpengine::addRows()
+{
+    QTest::addColumn<int>("docCount");
+    QTest::addColumn<int>("pageCount");
+
+    QTest::newRow("1 x 1000 pages") << 1 << 1000;
+    QTest::newRow("10 x 500 pages") << 10 << 500;
+    QTest::newRow("50 x 200 pages") << 50 << 200;
+}
+
+QString tst_bench_qhelpengine::rowName(int docCount, int pageCount)
+{
+    return QStringLiteral("%1x%2").arg(docCount).arg(pageCount);
+}
+
+/*
+  Every page mentions its chapter, every seventh page additionally the
+  word "layout", which searchQuery() looks for.
+ */
+static QByteArray pageHtml(int doc, int page)
+{
+    QByteArray html = "<html><head><title>Class" + QByteArray::number(page)
+            + " in Module" + QByteArray::number(doc) + "</title></head><body><h1>Class"
+            + QByteArray::number(page) + "</h1>";
+    for (int p = 0; p < 20; ++p) {
+        html += "<p>The class provides paragraph " + QByteArray::number(p)
+                + " of the reference for chapter " + QByteArray::number(page / 10)
+                + (page % 7 == 0 ? " and explains the layout handling" : "")
+                + ". See <a href=\"page" + QByteArray::number((page + p) % 100)
+                + ".html\">related</a> for details.</p>";
+    }
+    html += "</body></html>";
+    return html;
+}
+
+QStringList tst_bench_qhelpengine::documentations(int docCount, int pageCount)
+{
+    const QString row = rowName(docCount, pageCount);
+    auto it = m_documentations.constFind(row);
+    if (it != m_documentations.constEnd())
+        return it.value();
+
+    QStringList files;
+    for (int doc = 0; doc < docCount; ++doc) {
+        const QString dir = m_dir.filePath(QStringLiteral("%1/doc%2").arg(row).arg(doc));
+        if (!QDir().mkpath(dir))
+            return QStringList();
+
+        QByteArray toc;
+        QByteArray keywords;
+        for (int page = 0; page < pageCount; ++page) {
+            const QByteArray index = QByteArray::number(page);
+            QFile file(dir + QStringLiteral("/page%1.html").arg(page));
+            if (!file.open(QIODevice::WriteOnly) || file.write(pageHtml(doc, page)) < 0)
+                return QStringList();
+
+            if (page % 10 == 0) {
+                if (page)
+                    toc += "</section>\n";
+                toc += "<section title=\"Chapter " + QByteArray::number(page / 10)
+                        + "\" ref=\"page" + index + ".html\">\n";
+            }
+            toc += "<section title=\"Class" + index + "\" ref=\"page" + index + ".html\"/>\n";
+            keywords += "<keyword name=\"Class" + index + "\" id=\"Module"
+                    + QByteArray::number(doc) + "::Class" + index + "\" ref=\"page"
+                    + index + ".html\"/>\n"
+                    "<keyword name=\"function" + index + "()\" ref=\"page" + index
+                    + ".html#function\"/>\n";
+        }
+        if (pageCount)
+            toc += "</section>\n";
+
+        const QByteArray project =
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                "<QtHelpProject version=\"1.0\">\n"
+                "<namespace>org.qt-project.bench.doc" + QByteArray::number(doc) + "</namespace>\n"
+                "<virtualFolder>doc" + QByteArray::number(doc) + "</virtualFolder>\n"
+                "<filterSection>\n"
+                "<filterAttribute>bench</filterAttribute>\n"
+                "<toc>\n<section title=\"Module" + QByteArray::number(doc)
+                + "\" ref=\"page0.html\">\n" + toc + "</section>\n</toc>\n"
+                "<keywords>\n" + keywords + "</keywords>\n"
+                "<files>\n<file>*.html</file>\n</files>\n"
+                "</filterSection>\n"
+                "</QtHelpProject>\n";
+        const QString projectFile = dir + QStringLiteral("/doc.qhp");
+        QFile file(projectFile);
+        if (!file.open(QIODevice::WriteOnly) || file.write(project) < 0)
+            return QStringList();
+        file.close();
+
+        QHelpProjectData data;
+        if (!data.readData(projectFile))
+            return QStringList();
+        const QString outputFile = dir + QStringLiteral(".qch");
+        HelpGenerator generator(true);
+        if (!generator.generate(&data, outputFile))
+            return QStringList();
+        files.append(outputFile);
+    }
+
+    m_documentations.insert(row, files);
+    return files;
+}
+
+QString tst_bench_qhelpengine::createCollection(int docCount, int pageCount)
+{
+    return m_dir.filePath(QStringLiteral("%1-%2.qhc")
+                          .arg(rowName(docCount, pageCount)).arg(++m_collectionCount));
+}
+
+QString tst_bench_qhelpengine::registeredCollection(int docCount, int pageCount)
+{
+    const QString row = rowName(docCount, pageCount);
+    auto it = m_collections.constFind(row);
+    if (it != m_collections.constEnd())
+        return it.value();
+
+    const QStringList files = documentations(docCount, pageCount);
+    if (files.isEmpty())
+        return QString();
+
+    const QString collectionFile = createCollection(docCount, pageCount);
+    QHelpEngineCore engine(collectionFile);
+    engine.setReadOnly(false);
+    if (!engine.setupData() || !engine.registerDocumentations(files))
+        return QString();
+
+    m_collections.insert(row, collectionFile);
+    return collectionFile;
+}
+
+QList<QUrl> tst_bench_qhelpengine::pageUrls(const QHelpEngineCore &engine) const
+{
+    QList<QUrl> urls;
+    const QStringList namespaces = engine.registeredDocumentations();
+    for (const QString &namespaceName : namespaces)
+        urls += engine.files(namespaceName, QString(), QStringLiteral("html"));
+    return urls;
+}
+
+void tst_bench_qhelpengine::reportQueries(const QHelpEngineCore &engine, int iterations)
+{
+    if (iterations <= 0)
+        return;
+    qDebug("%lld SQL queries per iteration, %.3f ms",
+           engine.queryCount() / iterations,
+           engine.queryTime() / 1e6 / iterations);
+}
+
+void tst_bench_qhelpengine::registerDocumentation()
+{
+    QFETCH(int, docCount);
+    QFETCH(int, pageCount);
+
+    const QStringList files = documentations(docCount, pageCount);
+    QCOMPARE(files.size(), docCount);
+
+    QBENCHMARK {
+        QHelpEngineCore engine(createCollection(docCount, pageCount));
+        engine.setReadOnly(false);
+        QVERIFY(engine.setupData());
+        QVERIFY(engine.registerDocumentations(files));
+    }
+}
+
+/*
+  Every page is read from its .qch file and decompressed again; only the
+  documentation readers themselves stay open between the calls.
+ */
+void tst_bench_qhelpengine::fileDataCold()
+{
+    QFETCH(int, docCount);
+    QFETCH(int, pageCount);
+
+    const QString collectionFile = registeredCollection(docCount, pageCount);
+    QVERIFY(!collectionFile.isEmpty());
+
+    QHelpEngineCore engine(collectionFile);
+    QVERIFY(engine.setupData());
+    engine.setFileDataCacheLimit(0);
+    const QList<QUrl> urls = pageUrls(engine);
+    QCOMPARE(urls.size(), docCount * pageCount);
+
+    int iterations = 0;
+    engine.resetQueryStatistics();
+    QBENCHMARK {
+        for (const QUrl &url : urls)
+            QVERIFY(!engine.fileData(url).isEmpty());
+        ++iterations;
+    }
+    reportQueries(engine, iterations * urls.size());
+}
+
+void tst_bench_qhelpengine::fileDataWarm()
+{
+    QFETCH(int, docCount);
+    QFETCH(int, pageCount);
+
+    const QString collectionFile = registeredCollection(docCount, pageCount);
+    QVERIFY(!collectionFile.isEmpty());
+
+    QHelpEngineCore engine(collectionFile);
+    QVERIFY(engine.setupData());
+    engine.setFileDataCacheLimit(qint64(1) << 30);
+    const QList<QUrl> urls = pageUrls(engine);
+    for (const QUrl &url : urls)
+        QVERIFY(!engine.fileData(url).isEmpty());
+
+    QBENCHMARK {
+        for (const QUrl &url : urls)
+            QVERIFY(!engine.fileData(url).isEmpty());
+    }
+    QVERIFY(engine.fileDataCacheHits() > 0);
+}
+
+/*
+  Types "Class123" into the index one character at a time and then
+  deletes it again, as a user searching the index would.
+ */
+void tst_bench_qhelpengine::indexFilter()
+{
+    QFETCH(int, docCount);
+    QFETCH(int, pageCount);
+
+    const QString collectionFile = registeredCollection(docCount, pageCount);
+    QVERIFY(!collectionFile.isEmpty());
+
+    QHelpEngine engine(collectionFile);
+    QHelpIndexModel *model = engine.indexModel();
+    QSignalSpy spy(model, &QHelpIndexModel::indexCreated);
+    QVERIFY(engine.setupData());
+    QVERIFY(spy.wait(60000));
+    QVERIFY(model->rowCount() > 0);
+
+    const QString input = QStringLiteral("Class123");
+    QStringList keystrokes;
+    for (int i = 1; i <= input.size(); ++i)
+        keystrokes.append(input.left(i));
+    for (int i = input.size() - 1; i > 0; --i)
+        keystrokes.append(input.left(i));
+
+    QBENCHMARK {
+        for (const QString &keystroke : qAsConst(keystrokes))
+            model->filter(keystroke);
+    }
+}
+
+/*
+  Builds the content tree for a collection the engine has not seen
+  before, so that neither the in-memory trees nor the snapshots on disk
+  are used.
+ */
+void tst_bench_qhelpengine::contentTree()
+{
+    QFETCH(int, docCount);
+    QFETCH(int, pageCount);
+
+    const QString collectionFile = registeredCollection(docCount, pageCount);
+    QVERIFY(!collectionFile.isEmpty());
+
+    QBENCHMARK {
+        const QString copy = createCollection(docCount, pageCount);
+        QVERIFY(QFile::copy(collectionFile, copy));
+        QHelpEngine engine(copy);
+        QSignalSpy spy(engine.contentModel(), &QHelpContentModel::contentsCreated);
+        QVERIFY(engine.setupData());
+        QVERIFY(spy.wait(60000));
+        QVERIFY(engine.contentModel()->rowCount() > 0);
+    }
+}
+
+void tst_bench_qhelpengine::searchQuery()
+{
+    QFETCH(int, docCount);
+    QFETCH(int, pageCount);
+
+    const QString collectionFile = registeredCollection(docCount, pageCount);
+    QVERIFY(!collectionFile.isEmpty());
+
+    QHelpEngine engine(collectionFile);
+    QVERIFY(engine.setupData());
+    QHelpSearchEngine *searchEngine = engine.searchEngine();
+    QSignalSpy indexingSpy(searchEngine, &QHelpSearchEngine::indexingFinished);
+    searchEngine->reindexDocumentation();
+    QVERIFY(indexingSpy.wait(600000));
+
+    QSignalSpy searchingSpy(searchEngine, &QHelpSearchEngine::searchingFinished);
+    QBENCHMARK {
+        searchEngine->search(QStringLiteral("layout"));
+        QVERIFY(searchingSpy.wait(60000));
+    }
+    QVERIFY(searchEngine->searchResultCount() > 0);
+}
+
+QTEST_MAIN(tst_bench_qhelpengine)
+
+#include "tst_bench_qhelpengine.moc"